@@ -3,6 +3,7 @@
 #include "astronomy/orbit_ground_track.hpp"
 
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "geometry/grassmann.hpp"
@@ -30,31 +31,46 @@ using namespace principia::quantities::_si;
 // J2000).
 template<typename PrimaryCentred>
 Angle CelestialLongitude(Position<PrimaryCentred> const& q) {
-  // TODO(egg): |ToSpherical| is wasteful, as we discard the latitude.
-  return (q - PrimaryCentred::origin).coordinates().ToSpherical().longitude;
+  auto const coordinates = (q - PrimaryCentred::origin).coordinates();
+  return ArcTan(coordinates.y, coordinates.x);
 }
 
-// The resulting angles are neither normalized nor unwound.
-template<typename PrimaryCentred, typename Inertial>
-std::vector<Angle> PlanetocentricLongitudes(
-    DiscreteTrajectory<PrimaryCentred> const& nodes,
-    RotatingBody<Inertial> const& primary) {
+// The celestial longitudes of all the |nodes|, computed in a single pass so
+// that they may be shared by |PlanetocentricLongitudes| and
+// |MeanSolarTimesOfNodes|.
+template<typename PrimaryCentred>
+std::vector<Angle> CelestialLongitudes(
+    DiscreteTrajectory<PrimaryCentred> const& nodes) {
   std::vector<Angle> longitudes;
   longitudes.reserve(nodes.size());
   for (auto const& [time, degrees_of_freedom] : nodes) {
-    longitudes.push_back(
-        CelestialLongitude(degrees_of_freedom.position()) -
-        primary.AngleAt(time) - π / 2 * Radian);
+    longitudes.push_back(CelestialLongitude(degrees_of_freedom.position()));
   }
   return longitudes;
 }
 
+// The resulting angles are neither normalized nor unwound.  The celestial
+// longitudes are updated in place.
+template<typename PrimaryCentred, typename Inertial>
+std::vector<Angle> PlanetocentricLongitudes(
+    DiscreteTrajectory<PrimaryCentred> const& nodes,
+    std::vector<Angle> celestial_longitudes,
+    RotatingBody<Inertial> const& primary) {
+  int i = 0;
+  for (auto const& node : nodes) {
+    celestial_longitudes[i] = celestial_longitudes[i] -
+                              primary.AngleAt(node.time) - π / 2 * Radian;
+    ++i;
+  }
+  return celestial_longitudes;
+}
+
 // The resulting angle is not normalized.
-template<typename Iterator>
-Angle MeanSolarTime(Iterator const& it,
-                    OrbitGroundTrack::MeanSun const& mean_sun) {
-  Time const t = it->time - mean_sun.epoch;
-  return π * Radian + CelestialLongitude(it->degrees_of_freedom.position()) -
+inline Angle MeanSolarTime(Instant const& time,
+                           Angle const& celestial_longitude,
+                           OrbitGroundTrack::MeanSun const& mean_sun) {
+  Time const t = time - mean_sun.epoch;
+  return π * Radian + celestial_longitude -
          (mean_sun.mean_longitude_at_epoch +
           (2 * π * Radian * t / mean_sun.year));
 }
@@ -62,17 +78,21 @@ Angle MeanSolarTime(Iterator const& it,
 template<typename PrimaryCentred>
 Interval<Angle> MeanSolarTimesOfNodes(
     DiscreteTrajectory<PrimaryCentred> const& nodes,
+    std::vector<Angle> const& celestial_longitudes,
     OrbitGroundTrack::MeanSun const& mean_sun) {
   Interval<Angle> mean_solar_times;
   std::optional<Angle> mean_solar_time;
-  for (auto node = nodes.begin(); node != nodes.end(); ++node) {
+  int i = 0;
+  for (auto const& node : nodes) {
+    Angle const node_mean_solar_time =
+        MeanSolarTime(node.time, celestial_longitudes[i], mean_sun);
     if (mean_solar_time.has_value()) {
-      mean_solar_time =
-          UnwindFrom(*mean_solar_time, MeanSolarTime(node, mean_sun));
+      mean_solar_time = UnwindFrom(*mean_solar_time, node_mean_solar_time);
     } else {
-      mean_solar_time = ReduceAngle<0, 2 * π>(MeanSolarTime(node, mean_sun));
+      mean_solar_time = ReduceAngle<0, 2 * π>(node_mean_solar_time);
     }
     mean_solar_times.Include(*mean_solar_time);
+    ++i;
   }
   return mean_solar_times;
 }
@@ -139,20 +159,32 @@ absl::StatusOr<OrbitGroundTrack> OrbitGroundTrack::ForTrajectory(
                                /*max_points=*/std::numeric_limits<int>::max(),
                                ascending_nodes,
                                descending_nodes));
+  // The nodes found by |ComputeNodes| are processed in bulk: their celestial
+  // longitudes are computed once and shared by the mean solar times and the
+  // planetocentric longitudes.
+  std::vector<Angle> ascending_celestial_longitudes =
+      CelestialLongitudes(ascending_nodes);
+  std::vector<Angle> descending_celestial_longitudes =
+      CelestialLongitudes(descending_nodes);
   if (mean_sun.has_value()) {
     if (!ascending_nodes.empty()) {
-      ground_track.mean_solar_times_of_ascending_nodes_ =
-          MeanSolarTimesOfNodes(ascending_nodes, *mean_sun);
+      ground_track.mean_solar_times_of_ascending_nodes_ = MeanSolarTimesOfNodes(
+          ascending_nodes, ascending_celestial_longitudes, *mean_sun);
     }
     if (!descending_nodes.empty()) {
       ground_track.mean_solar_times_of_descending_nodes_ =
-          MeanSolarTimesOfNodes(descending_nodes, *mean_sun);
+          MeanSolarTimesOfNodes(
+              descending_nodes, descending_celestial_longitudes, *mean_sun);
     }
   }
   ground_track.longitudes_of_equator_crossings_of_ascending_passes_ =
-      PlanetocentricLongitudes(ascending_nodes, primary);
+      PlanetocentricLongitudes(ascending_nodes,
+                               std::move(ascending_celestial_longitudes),
+                               primary);
   ground_track.longitudes_of_equator_crossings_of_descending_passes_ =
-      PlanetocentricLongitudes(descending_nodes, primary);
+      PlanetocentricLongitudes(descending_nodes,
+                               std::move(descending_celestial_longitudes),
+                               primary);
   ground_track.first_descending_pass_before_first_ascending_pass_ =
       !ascending_nodes.empty() && !descending_nodes.empty() &&
       descending_nodes.front().time < ascending_nodes.front().time;
@@ -48,6 +48,10 @@ class OrbitRecurrence final {
   // characteristics, limiting the value of |Cᴛₒ|.
   // The Nᴛₒ / Cᴛₒ of the result is the last convergent of the κ obtained from
   // the given arguments whose denominator is less than |max_abs_Cᴛₒ|.
+  // The search takes O(|max_abs_Cᴛₒ|) floating-point operations, which is
+  // negligible compared to the computation of the elements it derives from, so
+  // clients need not cache candidate tables; they should instead keep the
+  // result for as long as the elements are unchanged.
   template<typename Frame>
   static OrbitRecurrence ClosestRecurrence(
       Time const& nodal_period,
@@ -172,19 +172,25 @@ class OrbitalElements {
       Instant const& t_min,
       Instant const& t_max);
 
-  // |osculating| must contain at least 2 elements.
-  // The resulting elements are averaged over one period, centred on
-  // their |EquinoctialElements::t|.
+  // The resulting elements are averaged over one period, centred on their
+  // |EquinoctialElements::t|.  They are passed to |AppendMeanElements| as they
+  // are produced by the integration.
   template<typename EquinoctialElementsComputation>
-  static absl::StatusOr<std::vector<EquinoctialElements>>
-  MeanEquinoctialElements(
+  absl::Status MeanEquinoctialElements(
       EquinoctialElementsComputation const& equinoctial_elements,
       Instant const& t_min,
       Instant const& t_max,
       Time const& period);
 
-  static absl::StatusOr<std::vector<ClassicalElements>> ToClassicalElements(
-      std::vector<EquinoctialElements> const& equinoctial_elements);
+  // Appends |mean_equinoctial_elements|, which must be later than all the
+  // elements appended so far, to |mean_equinoctial_elements_|.  Also appends
+  // the corresponding classical elements to |mean_classical_elements_|, and
+  // updates the |mean_*_interval_|, in constant time.
+  void AppendMeanElements(EquinoctialElements const& mean_equinoctial_elements);
+
+  static ClassicalElements ToClassicalElements(
+      EquinoctialElements const& equinoctial_elements,
+      ClassicalElements const* previous_classical_elements);
 
   // |mean_classical_elements_| must have been computed; sets
   // |anomalistic_period_|, |nodal_period_|, and |nodal_precession_|
@@ -192,10 +198,6 @@ class OrbitalElements {
   // element computation is based on it, so it gets computed earlier).
   absl::Status ComputePeriodsAndPrecession();
 
-  // The |mean_classical_elements_| must have been computed; sets
-  // |mean_*_interval_| accordingly.
-  absl::Status ComputeIntervals();
-
   std::vector<EquinoctialElements> osculating_equinoctial_elements_;
   Time sidereal_period_;
   std::vector<EquinoctialElements> mean_equinoctial_elements_;
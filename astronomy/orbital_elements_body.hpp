@@ -3,12 +3,17 @@
 #include "astronomy/orbital_elements.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "base/jthread.hpp"
 #include "base/status_utilities.hpp"  // 🧙 For RETURN_IF_ERROR.
+#include "base/thread_pool.hpp"
 #include "integrators/embedded_explicit_runge_kutta_integrator.hpp"
 #include "integrators/integrators.hpp"
 #include "integrators/methods.hpp"
@@ -26,6 +31,7 @@ namespace _orbital_elements {
 namespace internal {
 
 using namespace principia::base::_jthread;
+using namespace principia::base::_thread_pool;
 using namespace principia::integrators::_embedded_explicit_runge_kutta_integrator;  // NOLINT
 using namespace principia::integrators::_integrators;
 using namespace principia::integrators::_methods;
@@ -240,13 +246,10 @@ absl::StatusOr<OrbitalElements> OrbitalElements::ForRelativeDegreesOfFreedom(
         "sidereal period is " + DebugString(orbital_elements.sidereal_period_));
   }
 
-  auto mean_equinoctial_elements =
-      MeanEquinoctialElements(osculating_equinoctial_elements,
-                              t_min, t_max,
-                              orbital_elements.sidereal_period_);
-  RETURN_IF_ERROR(mean_equinoctial_elements);
-  orbital_elements.mean_equinoctial_elements_ =
-      std::move(mean_equinoctial_elements).value();
+  RETURN_IF_ERROR(orbital_elements.MeanEquinoctialElements(
+      osculating_equinoctial_elements,
+      t_min, t_max,
+      orbital_elements.sidereal_period_));
 
   if (fill_osculating_equinoctial_elements) {
     for (Instant t = t_min;
@@ -265,13 +268,7 @@ absl::StatusOr<OrbitalElements> OrbitalElements::ForRelativeDegreesOfFreedom(
         DebugString(t_max - t_min));
   }
 
-  auto mean_classical_elements =
-      ToClassicalElements(orbital_elements.mean_equinoctial_elements_);
-  RETURN_IF_ERROR(mean_classical_elements);
-  orbital_elements.mean_classical_elements_ =
-      std::move(mean_classical_elements).value();
   RETURN_IF_ERROR(orbital_elements.ComputePeriodsAndPrecession());
-  RETURN_IF_ERROR(orbital_elements.ComputeIntervals());
   return orbital_elements;
 }
 
@@ -296,8 +293,7 @@ absl::StatusOr<Time> OrbitalElements::SiderealPeriod(
 }
 
 template<typename EquinoctialElementsComputation>
-absl::StatusOr<std::vector<OrbitalElements::EquinoctialElements>>
-OrbitalElements::MeanEquinoctialElements(
+absl::Status OrbitalElements::MeanEquinoctialElements(
     EquinoctialElementsComputation const& equinoctial_elements,
     Instant const& t_min,
     Instant const& t_max,
@@ -341,19 +337,18 @@ OrbitalElements::MeanEquinoctialElements(
         return absl::OkStatus();
       }};
 
-  std::vector<EquinoctialElements> mean_elements;
-  auto const append_state = [&mean_elements](ODE::State const& state) {
+  auto const append_state = [this](ODE::State const& state) {
     Instant const& t = state.s.value;
     auto const& [a, h, k, λ, p, q, pʹ, qʹ] = state.y;
-    mean_elements.push_back(EquinoctialElements{.t = t,
-                                                .a = a.value,
-                                                .h = h.value,
-                                                .k = k.value,
-                                                .λ = λ.value,
-                                                .p = p.value,
-                                                .q = q.value,
-                                                .pʹ = pʹ.value,
-                                                .qʹ = qʹ.value});
+    AppendMeanElements(EquinoctialElements{.t = t,
+                                           .a = a.value,
+                                           .h = h.value,
+                                           .k = k.value,
+                                           .λ = λ.value,
+                                           .p = p.value,
+                                           .q = q.value,
+                                           .pʹ = pʹ.value,
+                                           .qʹ = qʹ.value});
   };
 
   auto const tolerance_to_error_ratio =
@@ -394,18 +389,39 @@ OrbitalElements::MeanEquinoctialElements(
   // Ensure that Clenshaw-Curtis will not go out of the bounds of the
   // trajectory.
   if (t_max < t_min + period) {
-    return mean_elements;
+    return absl::OkStatus();
   }
 
-  ODE::DependentVariables const initial_mean_elements{
-      initial_integration(&EquinoctialElements::a),
-      initial_integration(&EquinoctialElements::h),
-      initial_integration(&EquinoctialElements::k),
-      initial_integration(&EquinoctialElements::λ),
-      initial_integration(&EquinoctialElements::p),
-      initial_integration(&EquinoctialElements::q),
-      initial_integration(&EquinoctialElements::pʹ),
-      initial_integration(&EquinoctialElements::qʹ)};
+  // The initial integrations of the elements are independent of each other and
+  // each of them evaluates the trajectory many times, so they are run in
+  // parallel.  Each result is written to its own slot, so the output does not
+  // depend on the scheduling.
+  ODE::DependentVariables initial_mean_elements;
+  {
+    ThreadPool<void> pool(std::min<std::int64_t>(
+        std::tuple_size_v<ODE::DependentVariables>,
+        std::max(1u, std::thread::hardware_concurrency())));
+    std::vector<std::future<void>> futures;
+    auto const integrate_in_parallel =
+        [&futures, &initial_integration, &pool](auto& result,
+                                                auto const element) {
+          futures.push_back(pool.Add([&initial_integration, &result, element]() {
+            result = initial_integration(element);
+          }));
+        };
+    auto& [a, h, k, λ, p, q, pʹ, qʹ] = initial_mean_elements;
+    integrate_in_parallel(a, &EquinoctialElements::a);
+    integrate_in_parallel(h, &EquinoctialElements::h);
+    integrate_in_parallel(k, &EquinoctialElements::k);
+    integrate_in_parallel(λ, &EquinoctialElements::λ);
+    integrate_in_parallel(p, &EquinoctialElements::p);
+    integrate_in_parallel(q, &EquinoctialElements::q);
+    integrate_in_parallel(pʹ, &EquinoctialElements::pʹ);
+    integrate_in_parallel(qʹ, &EquinoctialElements::qʹ);
+    for (auto& future : futures) {
+      future.wait();
+    }
+  }
 
   // Compute bounds that make sure that the ODE integrator never evaluate the
   // trajectory outside of its bounds.
@@ -428,7 +444,7 @@ OrbitalElements::MeanEquinoctialElements(
     first_step = NextDown(first_step);
   }
   if (first_step <= Time{}) {
-    return mean_elements;
+    return absl::OkStatus();
   }
 
   auto const instance =
@@ -443,46 +459,58 @@ OrbitalElements::MeanEquinoctialElements(
                            /*safety_factor=*/0.9));
   RETURN_IF_ERROR(instance->Solve(t₂));
 
-  return mean_elements;
+  return absl::OkStatus();
 }
 
-inline absl::StatusOr<std::vector<OrbitalElements::ClassicalElements>>
-OrbitalElements::ToClassicalElements(
-    std::vector<EquinoctialElements> const& equinoctial_elements) {
-  std::vector<ClassicalElements> classical_elements;
-  classical_elements.reserve(equinoctial_elements.size());
-  for (auto const& equinoctial : equinoctial_elements) {
-    RETURN_IF_STOPPED;
-    double const tg_iⳆ2 = Sqrt(Pow<2>(equinoctial.p) + Pow<2>(equinoctial.q));
-    double const cotg_iⳆ2 =
-        Sqrt(Pow<2>(equinoctial.pʹ) + Pow<2>(equinoctial.qʹ));
-    Angle const i =
-        cotg_iⳆ2 > tg_iⳆ2 ? 2 * ArcTan(tg_iⳆ2) : 2 * ArcTan(1 / cotg_iⳆ2);
-    Angle const Ω = cotg_iⳆ2 > tg_iⳆ2 ? ArcTan(equinoctial.p, equinoctial.q)
-                                    : ArcTan(equinoctial.pʹ, equinoctial.qʹ);
-    double const e = Sqrt(Pow<2>(equinoctial.h) + Pow<2>(equinoctial.k));
-    Angle const ϖ = ArcTan(equinoctial.h, equinoctial.k);
-    Angle const ω = ϖ - Ω;
-    Angle const M = equinoctial.λ - ϖ;
-    classical_elements.push_back(
-        {.time = equinoctial.t,
-         .semimajor_axis = equinoctial.a,
-         .eccentricity = e,
-         .inclination = i,
-         .longitude_of_ascending_node = classical_elements.empty()
-             ? ReduceAngle<0, 2 * π>(Ω)
-             : UnwindFrom(classical_elements.back().longitude_of_ascending_node,
-                          Ω),
-         .argument_of_periapsis = classical_elements.empty()
-             ? ReduceAngle<0, 2 * π>(ω)
-             : UnwindFrom(classical_elements.back().argument_of_periapsis, ω),
-         .mean_anomaly = classical_elements.empty()
-             ? ReduceAngle<0, 2 * π>(M)
-             : UnwindFrom(classical_elements.back().mean_anomaly, M),
-         .periapsis_distance = (1 - e) * equinoctial.a,
-         .apoapsis_distance = (1 + e) * equinoctial.a});
-  }
-  return classical_elements;
+inline void OrbitalElements::AppendMeanElements(
+    EquinoctialElements const& mean_equinoctial_elements) {
+  mean_equinoctial_elements_.push_back(mean_equinoctial_elements);
+  ClassicalElements const& elements = mean_classical_elements_.emplace_back(
+      ToClassicalElements(mean_equinoctial_elements,
+                          mean_classical_elements_.empty()
+                              ? nullptr
+                              : &mean_classical_elements_.back()));
+  mean_semimajor_axis_interval_.Include(elements.semimajor_axis);
+  mean_eccentricity_interval_.Include(elements.eccentricity);
+  mean_inclination_interval_.Include(elements.inclination);
+  mean_longitude_of_ascending_node_interval_.Include(
+      elements.longitude_of_ascending_node);
+  mean_argument_of_periapsis_interval_.Include(elements.argument_of_periapsis);
+  mean_periapsis_distance_interval_.Include(elements.periapsis_distance);
+  mean_apoapsis_distance_interval_.Include(elements.apoapsis_distance);
+}
+
+inline OrbitalElements::ClassicalElements OrbitalElements::ToClassicalElements(
+    EquinoctialElements const& equinoctial,
+    ClassicalElements const* const previous) {
+  double const tg_iⳆ2 = Sqrt(Pow<2>(equinoctial.p) + Pow<2>(equinoctial.q));
+  double const cotg_iⳆ2 =
+      Sqrt(Pow<2>(equinoctial.pʹ) + Pow<2>(equinoctial.qʹ));
+  Angle const i =
+      cotg_iⳆ2 > tg_iⳆ2 ? 2 * ArcTan(tg_iⳆ2) : 2 * ArcTan(1 / cotg_iⳆ2);
+  Angle const Ω = cotg_iⳆ2 > tg_iⳆ2 ? ArcTan(equinoctial.p, equinoctial.q)
+                                  : ArcTan(equinoctial.pʹ, equinoctial.qʹ);
+  double const e = Sqrt(Pow<2>(equinoctial.h) + Pow<2>(equinoctial.k));
+  Angle const ϖ = ArcTan(equinoctial.h, equinoctial.k);
+  Angle const ω = ϖ - Ω;
+  Angle const M = equinoctial.λ - ϖ;
+  return {.time = equinoctial.t,
+          .semimajor_axis = equinoctial.a,
+          .eccentricity = e,
+          .inclination = i,
+          .longitude_of_ascending_node =
+              previous == nullptr
+                  ? ReduceAngle<0, 2 * π>(Ω)
+                  : UnwindFrom(previous->longitude_of_ascending_node, Ω),
+          .argument_of_periapsis =
+              previous == nullptr
+                  ? ReduceAngle<0, 2 * π>(ω)
+                  : UnwindFrom(previous->argument_of_periapsis, ω),
+          .mean_anomaly = previous == nullptr
+                              ? ReduceAngle<0, 2 * π>(M)
+                              : UnwindFrom(previous->mean_anomaly, M),
+          .periapsis_distance = (1 - e) * equinoctial.a,
+          .apoapsis_distance = (1 + e) * equinoctial.a};
 }
 
 inline absl::Status OrbitalElements::ComputePeriodsAndPrecession() {
@@ -573,22 +601,6 @@ inline absl::Status OrbitalElements::ComputePeriodsAndPrecession() {
   return absl::OkStatus();
 }
 
-inline absl::Status OrbitalElements::ComputeIntervals() {
-  for (auto const& elements : mean_classical_elements_) {
-    RETURN_IF_STOPPED;
-    mean_semimajor_axis_interval_.Include(elements.semimajor_axis);
-    mean_eccentricity_interval_.Include(elements.eccentricity);
-    mean_inclination_interval_.Include(elements.inclination);
-    mean_longitude_of_ascending_node_interval_.Include(
-        elements.longitude_of_ascending_node);
-    mean_argument_of_periapsis_interval_.Include(
-        elements.argument_of_periapsis);
-    mean_periapsis_distance_interval_.Include(elements.periapsis_distance);
-    mean_apoapsis_distance_interval_.Include(elements.apoapsis_distance);
-  }
-  return absl::OkStatus();
-}
-
 
 }  // namespace internal
 }  // namespace _orbital_elements
@@ -547,15 +547,16 @@ TEST(MarsTest, Phobos) {
           "sol_initial_state_jd_2451545_000000000.proto.txt");
   // NOTE(phl): Keep these parameters aligned with
   // sol_numerics_blueprint.proto.txt.
-  auto const ephemeris = solar_system_at_j2000.MakeEphemeris(
+  auto const ephemeris = SolarSystemFactory::MakeCachedEphemeris(
+      solar_system_at_j2000,
       /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
                                /*geopotential_tolerance=*/0x1p-24},
       Ephemeris<ICRS>::FixedStepParameters(
           SymmetricLinearMultistepIntegrator<
               QuinlanTremaine1990Order12,
               Ephemeris<ICRS>::NewtonianMotionEquation>(),
-          /*step=*/10 * Minute));
-  EXPECT_OK(ephemeris->Prolong(J2000 + 1 * JulianYear));
+          /*step=*/10 * Minute),
+      /*t_max=*/J2000 + 1 * JulianYear);
 
   ContinuousTrajectory<ICRS> const& mars_trajectory =
       solar_system_at_j2000.trajectory(*ephemeris, "Mars");
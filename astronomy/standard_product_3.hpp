@@ -106,8 +106,18 @@ class StandardProduct3 {
     std::optional<Velocity<ITRS>> velocity;
   };
 
+  struct File {
+    std::filesystem::path filename;
+    Dialect dialect;
+  };
+
   StandardProduct3(std::filesystem::path const& filename, Dialect dialect);
 
+  // Parses the given |files| in parallel.  The result is in the order of
+  // |files|.
+  static std::vector<not_null<std::unique_ptr<StandardProduct3 const>>>
+  ReadFiles(std::vector<File> const& files);
+
   // The satellite identifiers in the order in which they appear in the file
   // (that order is the same in the satellite ID records and within each epoch).
   std::vector<SatelliteIdentifier> const& satellites() const;
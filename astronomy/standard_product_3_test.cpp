@@ -32,6 +32,7 @@ namespace astronomy {
 using ::testing::AllOf;
 using ::testing::Each;
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::Eq;
 using ::testing::Field;
 using ::testing::Lt;
@@ -238,6 +239,37 @@ TEST_F(StandardProduct3Test, Dialects) {
                                  StandardProduct3::SatelliteGroup::ГЛОНАСС))));
 }
 
+TEST_F(StandardProduct3Test, ReadFiles) {
+  std::vector<StandardProduct3::File> const files = {
+      {SOLUTION_DIR / "astronomy" / "standard_product_3" / "esa11802.eph",
+       StandardProduct3::Dialect::Standard},
+      {SOLUTION_DIR / "astronomy" / "standard_product_3" / "nga20342.eph",
+       StandardProduct3::Dialect::Standard},
+      {SOLUTION_DIR / "astronomy" / "standard_product_3" /
+           "ilrsb.orb.lageos2.160319.v35.sp3",
+       StandardProduct3::Dialect::ILRSB}};
+  auto const products = StandardProduct3::ReadFiles(files);
+  ASSERT_THAT(products, SizeIs(files.size()));
+  for (int i = 0; i < files.size(); ++i) {
+    StandardProduct3 const expected(files[i].filename, files[i].dialect);
+    auto const& actual = *products[i];
+    EXPECT_THAT(actual.version(), Eq(expected.version()));
+    EXPECT_THAT(actual.file_has_velocities(),
+                Eq(expected.file_has_velocities()));
+    EXPECT_THAT(actual.satellites(), ElementsAreArray(expected.satellites()));
+    for (auto const& id : expected.satellites()) {
+      auto const& expected_orbit = expected.orbit(id);
+      auto const& actual_orbit = actual.orbit(id);
+      ASSERT_THAT(actual_orbit, SizeIs(expected_orbit.size()));
+      for (int j = 0; j < expected_orbit.size(); ++j) {
+        EXPECT_THAT(actual_orbit[j]->size(), Eq(expected_orbit[j]->size()));
+        EXPECT_THAT(actual_orbit[j]->back().degrees_of_freedom,
+                    Eq(expected_orbit[j]->back().degrees_of_freedom));
+      }
+    }
+  }
+}
+
 #if !defined(_DEBUG)
 
 struct StandardProduct3Args {
@@ -26,6 +26,22 @@ using namespace principia::quantities::_quantities;
 
 constexpr Angle EarthRotationAngle(Instant tt);
 
+struct EOPC04Entry;
+
+// Computes the same values as |EarthRotationAngle|, but remembers the interval
+// of the Earth orientation parameters used by the last call, so that no search
+// is needed when the times are close to one another, e.g., when they form a
+// monotonic sequence.  Not thread-safe.
+class EarthRotationAngleCache {
+ public:
+  Angle At(Instant const& tt);
+
+ private:
+  EOPC04Entry const* low_ = nullptr;
+  Instant low_tt_;
+  Instant high_tt_;
+};
+
 // Astronomical time scales:
 // — Temps Atomique International;
 // — Temps Terrestre;
@@ -91,6 +107,7 @@ constexpr Instant DateTimeAsTT(DateTime const& tt);
 
 using internal::DateTimeAsTT;
 using internal::EarthRotationAngle;
+using internal::EarthRotationAngleCache;
 using internal::Parse北斗Time;
 using internal::ParseGPSTime;
 using internal::ParseTAI;
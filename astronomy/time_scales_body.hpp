@@ -134,21 +134,26 @@ constexpr int LeapSecond(int const year, int const month) {
   }
 }
 
+// UTC - TAI in seconds during each half-year since 1972, i.e., the entry at
+// index 2 * (year - 1972) applies from January to June of |year| and the one at
+// index 2 * (year - 1972) + 1 from July to December.  This is an index over
+// |leap_seconds| that avoids summing the leaps on each conversion.
+constexpr std::array<int, (2023 - 1972) * 2 + 1> modern_utc_minus_tai = []() {
+  std::array<int, (2023 - 1972) * 2 + 1> result{};
+  result[0] = -10;
+  for (int i = 0; i < leap_seconds.size(); ++i) {
+    result[i + 1] = result[i] - leap_seconds[i];
+  }
+  return result;
+}();
+
 // Returns UTC - TAI on the given UTC day (similar to Bulletin C).
 constexpr Time ModernUTCMinusTAI(Date const& utc_date) {
-  if (utc_date.month() == 1 && utc_date.day() == 1) {
-    if (utc_date.year() == 1972) {
-      return -10 * Second;
-    } else {
-      return -LeapSecond(utc_date.year() - 1, 6) * Second +
-             -LeapSecond(utc_date.year() - 1, 12) * Second +
-             ModernUTCMinusTAI(Date::Calendar(utc_date.year() - 1, 1, 1));
-    }
-  } else {
-    return (utc_date.month() > 6 ? -LeapSecond(utc_date.year(), 6) * Second
-                                 : 0 * Second) +
-           ModernUTCMinusTAI(Date::Calendar(utc_date.year(), 1, 1));
-  }
+  int const index =
+      (utc_date.year() - 1972) * 2 + (utc_date.month() > 6 ? 1 : 0);
+  CONSTEXPR_CHECK(index >= 0);
+  CONSTEXPR_CHECK(index < modern_utc_minus_tai.size());
+  return modern_utc_minus_tai[index] * Second;
 }
 
 constexpr bool IsValidModernUTC(DateTime const& date_time) {
@@ -435,13 +440,13 @@ constexpr Instant FromUT1(Time const ut1) {
   }
 }
 
-constexpr Angle EarthRotationAngle(Instant const tt) {
-  CONSTEXPR_CHECK(tt >= eop_c04.front().tt())
-      << "EarthRotationAngle is not implemented before 1962.";
-
+// The Earth rotation angle at |tt|, obtained by interpolation on the interval
+// of EOP C04 starting at |low|.
+constexpr Angle EarthRotationAngle(EOPC04Entry const* const low,
+                                   Instant const& tt) {
   int ut1_julian_day_number_minus_2451545{};
   double const ut1_julian_day_fraction = InterpolatedEOPC04JulianDayFraction(
-      LookupInEOPC04(tt), tt, ut1_julian_day_number_minus_2451545);
+      low, tt, ut1_julian_day_number_minus_2451545);
   double const Tu =
       ut1_julian_day_number_minus_2451545 + ut1_julian_day_fraction;
   // IERS Conventions (2010), equation (5.15).
@@ -451,6 +456,33 @@ constexpr Angle EarthRotationAngle(Instant const tt) {
           0.00273781191135448 * Tu);
 }
 
+constexpr Angle EarthRotationAngle(Instant const tt) {
+  CONSTEXPR_CHECK(tt >= eop_c04.front().tt())
+      << "EarthRotationAngle is not implemented before 1962.";
+  return EarthRotationAngle(LookupInEOPC04(tt), tt);
+}
+
+inline Angle EarthRotationAngleCache::At(Instant const& tt) {
+  CHECK_GE(tt, eop_c04.front().tt())
+      << "EarthRotationAngle is not implemented before 1962.";
+  if (low_ == nullptr || tt < low_tt_ || tt >= high_tt_) {
+    // Try the next interval before searching, as the times are often
+    // increasing slowly.
+    EOPC04Entry const* const end = eop_c04.data() + eop_c04.size();
+    if (low_ != nullptr && tt >= high_tt_ && low_ + 2 < end &&
+        tt < (low_ + 2)->tt()) {
+      ++low_;
+    } else {
+      low_ = LookupInEOPC04(tt);
+    }
+    CHECK_LT(low_ + 1, end) << "EarthRotationAngle is not implemented after "
+                            << eop_c04.back().utc();
+    low_tt_ = low_->tt();
+    high_tt_ = (low_ + 1)->tt();
+  }
+  return EarthRotationAngle(low_, tt);
+}
+
 // Conversions from |DateTime| and |JulianDate| to |Instant|.
 
 constexpr Instant DateTimeAsTT(DateTime const& tt) {
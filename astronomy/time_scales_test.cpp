@@ -460,6 +460,22 @@ TEST_F(TimeScalesTest, EarthRotationAngle) {
               IsNear(-0.0000137_(1) * Degree / Day));
 }
 
+TEST_F(TimeScalesTest, EarthRotationAngleCache) {
+  EarthRotationAngleCache cache;
+  // A monotonic sequence crossing many intervals of the series, followed by
+  // jumps backward and forward.
+  for (Instant t = "2000-01-01T00:00:00"_TT; t < "2000-03-01T00:00:00"_TT;
+       t += 7 * Hour) {
+    EXPECT_THAT(cache.At(t), Eq(EarthRotationAngle(t))) << t;
+  }
+  for (Instant const t : {"1980-06-01T12:00:00"_TT,
+                          "1980-06-01T12:00:01"_TT,
+                          "2010-01-01T01:00:00"_TT,
+                          "1990-01-01T01:00:00"_TT}) {
+    EXPECT_THAT(cache.At(t), Eq(EarthRotationAngle(t))) << t;
+  }
+}
+
 TEST_F(TimeScalesTest, GNSS) {
   // BeiDou Navigation Satellite System
   // Signal In Space Interface Control Document
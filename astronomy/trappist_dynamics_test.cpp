@@ -967,20 +967,32 @@ MeasuredTransitsByPlanet const observations = {
                      {"JD2457962.86271"_TT, 0.00083 * Day}}}};
 
 class TrappistDynamicsTest : public ::testing::Test {
+ public:
+  // The ephemeris is shared by the tests of this suite, so that the
+  // century-long integration that they need is done once per process, or once
+  // per shard when the tests are sharded.
+  static void SetUpTestCase() {
+    system_ = new SolarSystem<Sky>(
+        SOLUTION_DIR / "astronomy" / "trappist_gravity_model.proto.txt",
+        SOLUTION_DIR / "astronomy" /
+            "trappist_initial_state_jd_2457000_000000000.proto.txt");
+    ephemeris_ = system_->MakeEphemeris(
+        Ephemeris<Sky>::AccuracyParameters(
+            /*fitting_tolerance=*/1 * Milli(Metre),
+            /*geopotential_tolerance=*/0x1.0p-24),
+        Ephemeris<Sky>::FixedStepParameters(
+            SymmetricLinearMultistepIntegrator<
+                Quinlan1999Order8A,
+                Ephemeris<Sky>::NewtonianMotionEquation>(),
+            /*step=*/30 * Minute)).release();
+  }
+
+  static void TearDownTestCase() {
+    delete ephemeris_;
+    delete system_;
+  }
+
  protected:
-  TrappistDynamicsTest()
-      : system_(SOLUTION_DIR / "astronomy" / "trappist_gravity_model.proto.txt",
-                SOLUTION_DIR / "astronomy" /
-                    "trappist_initial_state_jd_2457000_000000000.proto.txt"),
-        ephemeris_(system_.MakeEphemeris(
-            Ephemeris<Sky>::AccuracyParameters(
-                /*fitting_tolerance=*/1 * Milli(Metre),
-                /*geopotential_tolerance=*/0x1.0p-24),
-            Ephemeris<Sky>::FixedStepParameters(
-                SymmetricLinearMultistepIntegrator<
-                    Quinlan1999Order8A,
-                    Ephemeris<Sky>::NewtonianMotionEquation>(),
-                /*step=*/30 * Minute))) {}
 
   static Transits ComputeTransits(Ephemeris<Sky> const& ephemeris,
                                   not_null<MassiveBody const*> const star,
@@ -1130,19 +1142,21 @@ class TrappistDynamicsTest : public ::testing::Test {
 
   constexpr static char home_name[] = "Trappist-1e";
   constexpr static char star_name[] = "Trappist-1";
-  SolarSystem<Sky> const system_;
-  not_null<std::unique_ptr<Ephemeris<Sky>>> ephemeris_;
+  static SolarSystem<Sky> const* system_;
+  static Ephemeris<Sky>* ephemeris_;
 };
 
 constexpr char TrappistDynamicsTest::home_name[];
 constexpr char TrappistDynamicsTest::star_name[];
+SolarSystem<Sky> const* TrappistDynamicsTest::system_ = nullptr;
+Ephemeris<Sky>* TrappistDynamicsTest::ephemeris_ = nullptr;
 
 #if !defined(_DEBUG)
 TEST_F(TrappistDynamicsTest, MathematicaPeriods) {
-  Instant const a_century_later = system_.epoch() + 100 * JulianYear;
+  Instant const a_century_later = system_->epoch() + 100 * JulianYear;
   EXPECT_OK(ephemeris_->Prolong(a_century_later));
 
-  auto const& star = system_.massive_body(*ephemeris_, star_name);
+  auto const& star = system_->massive_body(*ephemeris_, star_name);
   auto const& star_trajectory = ephemeris_->trajectory(star);
 
   Logger logger(TEMP_DIR / "trappist_periods.generated.wl",
@@ -1175,7 +1189,7 @@ TEST_F(TrappistDynamicsTest, DISABLED_MathematicaTransits) {
                              /*make_unique=*/false);
   int index = 0;
   for (auto const& ephemeris :
-       {system_.MakeEphemeris(
+       {system_->MakeEphemeris(
             /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
                                      /*geopotential_tolerance=*/0x1p-24},
             Ephemeris<Sky>::FixedStepParameters(
@@ -1183,7 +1197,7 @@ TEST_F(TrappistDynamicsTest, DISABLED_MathematicaTransits) {
                     Quinlan1999Order8A,
                     Ephemeris<Sky>::NewtonianMotionEquation>(),
                 /*step=*/30 * Minute)),
-        system_.MakeEphemeris(
+        system_->MakeEphemeris(
             /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Centi(Metre),
                                      /*geopotential_tolerance=*/1.0e-7},
             Ephemeris<Sky>::FixedStepParameters(
@@ -1191,12 +1205,12 @@ TEST_F(TrappistDynamicsTest, DISABLED_MathematicaTransits) {
                     BlanesMoan2002SRKN11B,
                     Ephemeris<Sky>::NewtonianMotionEquation>(),
                 /*step=*/45 * Minute))}) {
-    Instant const a_century_later = system_.epoch() + 100 * JulianYear;
+    Instant const a_century_later = system_->epoch() + 100 * JulianYear;
     EXPECT_OK(ephemeris->Prolong(a_century_later));
 
     TransitsByPlanet computations;
 
-    auto const& star = system_.massive_body(*ephemeris, star_name);
+    auto const& star = system_->massive_body(*ephemeris, star_name);
     auto const bodies = ephemeris->bodies();
     for (auto const& planet : bodies) {
       if (planet != star) {
@@ -1217,15 +1231,15 @@ TEST_F(TrappistDynamicsTest, DISABLED_MathematicaTransits) {
 }
 
 TEST_F(TrappistDynamicsTest, MathematicaAlignments) {
-  Instant const a_century_later = system_.epoch() + 100 * JulianYear;
+  Instant const a_century_later = system_->epoch() + 100 * JulianYear;
   EXPECT_OK(ephemeris_->Prolong(a_century_later));
 
   Logger logger(TEMP_DIR / "trappist_alignments.generated.wl",
                 /*make_unique=*/false);
 
-  auto const& star = system_.massive_body(*ephemeris_, star_name);
+  auto const& star = system_->massive_body(*ephemeris_, star_name);
   auto const& star_trajectory = ephemeris_->trajectory(star);
-  auto const& home = system_.rotating_body(*ephemeris_, home_name);
+  auto const& home = system_->rotating_body(*ephemeris_, home_name);
   auto const& home_trajectory = ephemeris_->trajectory(home);
 
   auto const bodies = ephemeris_->bodies();
@@ -1250,16 +1264,16 @@ TEST_F(TrappistDynamicsTest, MathematicaAlignments) {
 }
 
 TEST_F(TrappistDynamicsTest, PlanetBPlanetDAlignment) {
-  Instant const a_century_later = system_.epoch() + 100 * JulianYear;
+  Instant const a_century_later = system_->epoch() + 100 * JulianYear;
   EXPECT_OK(ephemeris_->Prolong(a_century_later));
 
-  auto const& star = system_.massive_body(*ephemeris_, star_name);
+  auto const& star = system_->massive_body(*ephemeris_, star_name);
   auto const& star_trajectory = ephemeris_->trajectory(star);
-  auto const& home = system_.rotating_body(*ephemeris_, home_name);
+  auto const& home = system_->rotating_body(*ephemeris_, home_name);
   auto const& home_trajectory = ephemeris_->trajectory(home);
-  auto const& planet_b = system_.massive_body(*ephemeris_, "Trappist-1b");
+  auto const& planet_b = system_->massive_body(*ephemeris_, "Trappist-1b");
   auto const& planet_b_trajectory = ephemeris_->trajectory(planet_b);
-  auto const& planet_d = system_.massive_body(*ephemeris_, "Trappist-1d");
+  auto const& planet_d = system_->massive_body(*ephemeris_, "Trappist-1d");
   auto const& planet_d_trajectory = ephemeris_->trajectory(planet_d);
 
   Angle min_angle = 1 * Radian;
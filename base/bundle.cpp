@@ -33,8 +33,11 @@ absl::Status Bundle::JoinWithin(std::chrono::steady_clock::duration Δt) {
   joining_ = true;
   if (number_of_active_workers_ > 0 &&
       !all_done_.WaitForNotificationWithTimeout(absl::FromChrono(Δt))) {
-    absl::MutexLock l(&status_lock_);
-    status_ = absl::DeadlineExceededError("Bundle deadline exceeded");
+    {
+      absl::MutexLock l(&status_lock_);
+      status_ = absl::DeadlineExceededError("Bundle deadline exceeded");
+    }
+    stoppable_task_.request_stop();
   }
   JoinAll();
   absl::ReaderMutexLock status_lock(&status_lock_);
@@ -45,8 +48,11 @@ absl::Status Bundle::JoinBefore(std::chrono::system_clock::time_point t) {
   joining_ = true;
   if (number_of_active_workers_ > 0 &&
       !all_done_.WaitForNotificationWithDeadline(absl::FromChrono(t))) {
-    absl::MutexLock l(&status_lock_);
-    status_ = absl::DeadlineExceededError("bundle deadline exceeded");
+    {
+      absl::MutexLock l(&status_lock_);
+      status_ = absl::DeadlineExceededError("bundle deadline exceeded");
+    }
+    stoppable_task_.request_stop();
   }
   JoinAll();
   absl::ReaderMutexLock status_lock(&status_lock_);
@@ -54,12 +60,17 @@ absl::Status Bundle::JoinBefore(std::chrono::system_clock::time_point t) {
 }
 
 void Bundle::Toil(Task const& task) {
-  absl::Status const status = task();
+  absl::Status const status = stoppable_task_.Run(task);
 
   // Avoid locking if the task succeeded: it cannot affect the overall status.
   if (!status.ok()) {
-    absl::MutexLock l(&status_lock_);
-    status_.Update(status);
+    {
+      absl::MutexLock l(&status_lock_);
+      status_.Update(status);
+    }
+    // The overall status is now an error, there is no point in letting the
+    // other tasks run to completion.
+    stoppable_task_.request_stop();
   }
 
   // No locking, so as to avoid contention during joining.  Note that if
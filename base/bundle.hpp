@@ -10,16 +10,22 @@
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/synchronization/notification.h"
+#include "base/jthread.hpp"
 
 namespace principia {
 namespace base {
 namespace _bundle {
 namespace internal {
 
+using namespace principia::base::_jthread;
+
 // A bundle manages a number of threads that execute independently.  A thread is
 // created for each call to |Add|.  When one of the |Join*| is called, no more
 // calls to |Add| are allowed, and |Join*| returns the first error status (if
 // any) produced by the tasks.
+// The tasks are cancelled cooperatively: when a task fails, or when the
+// deadline of a |Join*| expires, a stop is requested, and the tasks that use
+// |RETURN_IF_STOPPED| (directly or through the integrators) return early.
 class Bundle final {
  public:
   using Task = std::function<absl::Status()>;
@@ -45,6 +51,9 @@ class Bundle final {
 
   void JoinAll() LOCKS_EXCLUDED(lock_);
 
+  // Shared by all the tasks, so that a single stop request cancels them all.
+  StoppableTask const stoppable_task_;
+
   absl::Mutex status_lock_;
   absl::Status status_ GUARDED_BY(status_lock_);
 
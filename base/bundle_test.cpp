@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "absl/status/status.h"
+#include "base/jthread.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "testing_utilities/matchers.hpp"
@@ -89,5 +90,38 @@ TEST_F(BundleTest, Deadline) {
   EXPECT_THAT(status.message(), Eq("Bundle deadline exceeded"));
 }
 
+TEST_F(BundleTest, FailureCancelsOtherTasks) {
+  for (int i = 0; i < workers; ++i) {
+    bundle_.Add([]() -> absl::Status {
+      for (;;) {
+        RETURN_IF_STOPPED;
+        std::this_thread::sleep_for(1ms);
+      }
+    });
+  }
+  bundle_.Add([]() {
+    std::this_thread::sleep_for(10ms);
+    return absl::InternalError("Failed");
+  });
+  // The first error is returned, not the cancellations that it caused.
+  auto const status = bundle_.Join();
+  EXPECT_THAT(status, StatusIs(absl::StatusCode::kInternal));
+  EXPECT_THAT(status.message(), Eq("Failed"));
+}
+
+TEST_F(BundleTest, DeadlineCancelsTasks) {
+  for (int i = 0; i < workers; ++i) {
+    bundle_.Add([]() -> absl::Status {
+      for (;;) {
+        RETURN_IF_STOPPED;
+        std::this_thread::sleep_for(1ms);
+      }
+    });
+  }
+  // Without the cancellation, this would never return.
+  EXPECT_THAT(bundle_.JoinWithin(10ms),
+              StatusIs(absl::StatusCode::kDeadlineExceeded));
+}
+
 }  // namespace base
 }  // namespace principia
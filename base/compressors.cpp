@@ -0,0 +1,296 @@
+#include "base/compressors.hpp"
+
+#include "glog/logging.h"
+#include "lz4.h"
+#include "zdict.h"
+
+namespace principia {
+namespace base {
+namespace _compressors {
+namespace internal {
+
+namespace {
+
+// Returns all the bytes available in |source|, without skipping them.  If
+// |source| doesn't return them contiguously, they are copied to |buffer|.
+Array<std::uint8_t const> PeekAll(Source& source, std::string& buffer) {
+  size_t const available = source.Available();
+  size_t length;
+  char const* data = source.Peek(&length);
+  if (length >= available) {
+    return Array<std::uint8_t const>(
+        reinterpret_cast<std::uint8_t const*>(data), available);
+  }
+  buffer.reserve(available);
+  while (buffer.size() < available) {
+    data = source.Peek(&length);
+    buffer.append(data, length);
+    source.Skip(length);
+  }
+  return Array<std::uint8_t const>(
+      reinterpret_cast<std::uint8_t const*>(buffer.data()), buffer.size());
+}
+
+// Returns a buffer of |size| bytes where the data to append to |sink| should be
+// written.  |scratch| is used if |sink| cannot provide such a buffer.
+Array<std::uint8_t> GetAppendBuffer(Sink& sink,
+                                    size_t const size,
+                                    std::string& scratch) {
+  scratch.resize(size);
+  size_t allocated_size;
+  char* const buffer = sink.GetAppendBuffer(/*min_size=*/size,
+                                            /*desired_size_hint=*/size,
+                                            scratch.data(),
+                                            scratch.size(),
+                                            &allocated_size);
+  return Array<std::uint8_t>(
+      reinterpret_cast<std::uint8_t*>(allocated_size >= size ? buffer
+                                                             : scratch.data()),
+      size);
+}
+
+}  // namespace
+
+size_t BlockCompressor::Compress(std::string const& input,
+                                 std::string* const output) {
+  output->resize(MaxCompressedLength(input.size()));
+  std::int64_t const size = CompressBlock(
+      Array<std::uint8_t const>(
+          reinterpret_cast<std::uint8_t const*>(input.data()), input.size()),
+      Array<std::uint8_t>(reinterpret_cast<std::uint8_t*>(output->data()),
+                          output->size()));
+  output->resize(size);
+  return size;
+}
+
+bool BlockCompressor::GetUncompressedLength(std::string const& compressed,
+                                            size_t* const result) {
+  auto const length = UncompressedLength(Array<std::uint8_t const>(
+      reinterpret_cast<std::uint8_t const*>(compressed.data()),
+      compressed.size()));
+  if (!length.has_value()) {
+    return false;
+  }
+  *result = *length;
+  return true;
+}
+
+bool BlockCompressor::Uncompress(std::string const& compressed,
+                                 std::string* const uncompressed) {
+  Array<std::uint8_t const> const input(
+      reinterpret_cast<std::uint8_t const*>(compressed.data()),
+      compressed.size());
+  auto const length = UncompressedLength(input);
+  if (!length.has_value()) {
+    return false;
+  }
+  uncompressed->resize(*length);
+  return UncompressBlock(
+      input,
+      Array<std::uint8_t>(reinterpret_cast<std::uint8_t*>(uncompressed->data()),
+                          uncompressed->size()));
+}
+
+size_t BlockCompressor::CompressStream(Source* const source, Sink* const sink) {
+  std::string input_buffer;
+  std::string output_buffer;
+  Array<std::uint8_t const> const input = PeekAll(*source, input_buffer);
+  Array<std::uint8_t> const output =
+      GetAppendBuffer(*sink, MaxCompressedLength(input.size), output_buffer);
+  std::int64_t const size = CompressBlock(input, output);
+  source->Skip(source->Available());
+  sink->Append(reinterpret_cast<char const*>(output.data), size);
+  return size;
+}
+
+bool BlockCompressor::GetUncompressedLengthStream(Source* const compressed,
+                                                  size_t* const result) {
+  size_t length;
+  char const* const data = compressed->Peek(&length);
+  auto const uncompressed_length = UncompressedLength(Array<std::uint8_t const>(
+      reinterpret_cast<std::uint8_t const*>(data), length));
+  if (!uncompressed_length.has_value()) {
+    return false;
+  }
+  *result = *uncompressed_length;
+  return true;
+}
+
+bool BlockCompressor::UncompressStream(Source* const source, Sink* const sink) {
+  std::string input_buffer;
+  std::string output_buffer;
+  Array<std::uint8_t const> const input = PeekAll(*source, input_buffer);
+  auto const length = UncompressedLength(input);
+  if (!length.has_value()) {
+    return false;
+  }
+  Array<std::uint8_t> const output =
+      GetAppendBuffer(*sink, *length, output_buffer);
+  if (!UncompressBlock(input, output)) {
+    return false;
+  }
+  source->Skip(source->Available());
+  sink->Append(reinterpret_cast<char const*>(output.data), output.size);
+  return true;
+}
+
+ZstdCompressor::ZstdCompressor(int const level,
+                               std::string_view const dictionary)
+    : level_(level),
+      compression_context_(ZSTD_createCCtx()),
+      uncompression_context_(ZSTD_createDCtx()),
+      compression_dictionary_(
+          dictionary.empty()
+              ? nullptr
+              : ZSTD_createCDict(dictionary.data(), dictionary.size(), level)),
+      uncompression_dictionary_(
+          dictionary.empty()
+              ? nullptr
+              : ZSTD_createDDict(dictionary.data(), dictionary.size())) {
+  CHECK_LE(ZSTD_minCLevel(), level_);
+  CHECK_LE(level_, ZSTD_maxCLevel());
+  CHECK(compression_context_ != nullptr);
+  CHECK(uncompression_context_ != nullptr);
+  if (!dictionary.empty()) {
+    CHECK(compression_dictionary_ != nullptr);
+    CHECK(uncompression_dictionary_ != nullptr);
+  }
+}
+
+size_t ZstdCompressor::MaxCompressedLength(size_t const nbytes) {
+  return ZSTD_compressBound(nbytes);
+}
+
+std::string ZstdCompressor::TrainDictionary(
+    std::vector<std::string> const& samples,
+    std::int64_t const capacity) {
+  std::string concatenated_samples;
+  std::vector<size_t> sample_sizes;
+  for (auto const& sample : samples) {
+    concatenated_samples += sample;
+    sample_sizes.push_back(sample.size());
+  }
+  std::string dictionary(capacity, '\0');
+  size_t const size = ZDICT_trainFromBuffer(dictionary.data(),
+                                            dictionary.size(),
+                                            concatenated_samples.data(),
+                                            sample_sizes.data(),
+                                            sample_sizes.size());
+  CHECK(!ZDICT_isError(size)) << ZDICT_getErrorName(size);
+  dictionary.resize(size);
+  return dictionary;
+}
+
+std::int64_t ZstdCompressor::CompressBlock(
+    Array<std::uint8_t const> const input,
+    Array<std::uint8_t> const output) {
+  size_t const size =
+      compression_dictionary_ == nullptr
+          ? ZSTD_compressCCtx(compression_context_.get(),
+                              output.data, output.size,
+                              input.data, input.size,
+                              level_)
+          : ZSTD_compress_usingCDict(compression_context_.get(),
+                                     output.data, output.size,
+                                     input.data, input.size,
+                                     compression_dictionary_.get());
+  CHECK(!ZSTD_isError(size)) << ZSTD_getErrorName(size);
+  return size;
+}
+
+std::optional<std::int64_t> ZstdCompressor::UncompressedLength(
+    Array<std::uint8_t const> const input) {
+  unsigned long long const length =  // NOLINT(runtime/int)
+      ZSTD_getFrameContentSize(input.data, input.size);
+  if (length == ZSTD_CONTENTSIZE_UNKNOWN || length == ZSTD_CONTENTSIZE_ERROR) {
+    return std::nullopt;
+  }
+  return length;
+}
+
+bool ZstdCompressor::UncompressBlock(Array<std::uint8_t const> const input,
+                                     Array<std::uint8_t> const output) {
+  size_t const size =
+      uncompression_dictionary_ == nullptr
+          ? ZSTD_decompressDCtx(uncompression_context_.get(),
+                                output.data, output.size,
+                                input.data, input.size)
+          : ZSTD_decompress_usingDDict(uncompression_context_.get(),
+                                       output.data, output.size,
+                                       input.data, input.size,
+                                       uncompression_dictionary_.get());
+  return !ZSTD_isError(size) && size == output.size;
+}
+
+void ZstdCompressor::Deleter::operator()(ZSTD_CCtx* const context) const {
+  ZSTD_freeCCtx(context);
+}
+
+void ZstdCompressor::Deleter::operator()(ZSTD_DCtx* const context) const {
+  ZSTD_freeDCtx(context);
+}
+
+void ZstdCompressor::Deleter::operator()(ZSTD_CDict* const dictionary) const {
+  ZSTD_freeCDict(dictionary);
+}
+
+void ZstdCompressor::Deleter::operator()(ZSTD_DDict* const dictionary) const {
+  ZSTD_freeDDict(dictionary);
+}
+
+Lz4Compressor::Lz4Compressor(int const acceleration)
+    : acceleration_(acceleration) {
+  CHECK_LE(1, acceleration_);
+}
+
+size_t Lz4Compressor::MaxCompressedLength(size_t const nbytes) {
+  CHECK_LE(nbytes, LZ4_MAX_INPUT_SIZE);
+  return header_size + LZ4_compressBound(static_cast<int>(nbytes));
+}
+
+std::int64_t Lz4Compressor::CompressBlock(
+    Array<std::uint8_t const> const input,
+    Array<std::uint8_t> const output) {
+  CHECK_LE(input.size, LZ4_MAX_INPUT_SIZE);
+  for (int i = 0; i < header_size; ++i) {
+    output.data[i] = static_cast<std::uint8_t>(input.size >> (8 * i));
+  }
+  int const size = LZ4_compress_fast(
+      reinterpret_cast<char const*>(input.data),
+      reinterpret_cast<char*>(output.data + header_size),
+      static_cast<int>(input.size),
+      static_cast<int>(output.size - header_size),
+      acceleration_);
+  CHECK_LT(0, size);
+  return header_size + size;
+}
+
+std::optional<std::int64_t> Lz4Compressor::UncompressedLength(
+    Array<std::uint8_t const> const input) {
+  if (input.size < header_size) {
+    return std::nullopt;
+  }
+  std::int64_t length = 0;
+  for (int i = 0; i < header_size; ++i) {
+    length |= static_cast<std::int64_t>(input.data[i]) << (8 * i);
+  }
+  if (length > LZ4_MAX_INPUT_SIZE) {
+    return std::nullopt;
+  }
+  return length;
+}
+
+bool Lz4Compressor::UncompressBlock(Array<std::uint8_t const> const input,
+                                    Array<std::uint8_t> const output) {
+  int const size = LZ4_decompress_safe(
+      reinterpret_cast<char const*>(input.data + header_size),
+      reinterpret_cast<char*>(output.data),
+      static_cast<int>(input.size - header_size),
+      static_cast<int>(output.size));
+  return size == output.size;
+}
+
+}  // namespace internal
+}  // namespace _compressors
+}  // namespace base
+}  // namespace principia
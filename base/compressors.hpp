@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/array.hpp"
+#include "gipfeli/compression.h"
+#include "zstd.h"
+
+namespace principia {
+namespace base {
+namespace _compressors {
+namespace internal {
+
+using namespace principia::base::_array;
+
+using ::google::compression::Compressor;
+using ::google::compression::Sink;
+using ::google::compression::Source;
+
+// A |Compressor| that compresses its entire input as a single block.  This is
+// how the |PullSerializer| and the |PushDeserializer| use compressors: each
+// chunk is compressed independently.  Subclasses only have to implement the
+// compression and uncompression of a block held in memory.
+class BlockCompressor : public Compressor {
+ public:
+  size_t Compress(std::string const& input, std::string* output) override;
+  bool GetUncompressedLength(std::string const& compressed,
+                             size_t* result) override;
+  bool Uncompress(std::string const& compressed,
+                  std::string* uncompressed) override;
+  size_t CompressStream(Source* source, Sink* sink) override;
+  bool GetUncompressedLengthStream(Source* compressed, size_t* result) override;
+  bool UncompressStream(Source* source, Sink* sink) override;
+
+ protected:
+  // Compresses |input| into |output|, which has at least
+  // |MaxCompressedLength(input.size)| bytes, and returns the size of the
+  // compressed data.
+  virtual std::int64_t CompressBlock(Array<std::uint8_t const> input,
+                                     Array<std::uint8_t> output) = 0;
+
+  // Returns the size of the data compressed in |input|, or nullopt if |input|
+  // is corrupted.
+  virtual std::optional<std::int64_t> UncompressedLength(
+      Array<std::uint8_t const> input) = 0;
+
+  // Uncompresses |input| into |output|, which has the size returned by
+  // |UncompressedLength|.  Returns false if |input| is corrupted.
+  virtual bool UncompressBlock(Array<std::uint8_t const> input,
+                               Array<std::uint8_t> output) = 0;
+};
+
+// A |Compressor| using Zstandard, which is slower than Gipfeli at compression
+// but compresses much better and uncompresses faster.  The compressed data may
+// depend on a dictionary, which helps with small chunks.
+class ZstdCompressor final : public BlockCompressor {
+ public:
+  static constexpr int default_level = 3;
+
+  // |level| is a Zstandard compression level, from |ZSTD_minCLevel()| to
+  // |ZSTD_maxCLevel()|; higher levels compress better and slower.  If
+  // |dictionary| is not empty, it is used for compression and uncompression,
+  // and data compressed with a dictionary can only be uncompressed with the
+  // same dictionary.
+  explicit ZstdCompressor(int level = default_level,
+                          std::string_view dictionary = {});
+
+  size_t MaxCompressedLength(size_t nbytes) override;
+
+  // Returns a dictionary of at most |capacity| bytes trained on |samples|,
+  // which should be representative of the chunks to compress, e.g., chunks of
+  // serialized messages of the type to compress.
+  static std::string TrainDictionary(std::vector<std::string> const& samples,
+                                     std::int64_t capacity);
+
+ protected:
+  std::int64_t CompressBlock(Array<std::uint8_t const> input,
+                             Array<std::uint8_t> output) override;
+  std::optional<std::int64_t> UncompressedLength(
+      Array<std::uint8_t const> input) override;
+  bool UncompressBlock(Array<std::uint8_t const> input,
+                       Array<std::uint8_t> output) override;
+
+ private:
+  struct Deleter {
+    void operator()(ZSTD_CCtx* context) const;
+    void operator()(ZSTD_DCtx* context) const;
+    void operator()(ZSTD_CDict* dictionary) const;
+    void operator()(ZSTD_DDict* dictionary) const;
+  };
+
+  int const level_;
+  // The contexts are reused across blocks to avoid reallocating them, which is
+  // why a compressor must not be used concurrently by multiple threads.
+  std::unique_ptr<ZSTD_CCtx, Deleter> const compression_context_;
+  std::unique_ptr<ZSTD_DCtx, Deleter> const uncompression_context_;
+  // Null if there is no dictionary.
+  std::unique_ptr<ZSTD_CDict, Deleter> const compression_dictionary_;
+  std::unique_ptr<ZSTD_DDict, Deleter> const uncompression_dictionary_;
+};
+
+// A |Compressor| using LZ4, which compresses less than Gipfeli but is faster,
+// especially at uncompression.
+class Lz4Compressor final : public BlockCompressor {
+ public:
+  // |acceleration| trades compression ratio for speed; 1 gives the best
+  // compression.
+  explicit Lz4Compressor(int acceleration = 1);
+
+  size_t MaxCompressedLength(size_t nbytes) override;
+
+ protected:
+  std::int64_t CompressBlock(Array<std::uint8_t const> input,
+                             Array<std::uint8_t> output) override;
+  std::optional<std::int64_t> UncompressedLength(
+      Array<std::uint8_t const> input) override;
+  bool UncompressBlock(Array<std::uint8_t const> input,
+                       Array<std::uint8_t> output) override;
+
+ private:
+  // LZ4 blocks don't record their uncompressed size, so we write it in a
+  // little-endian header before the block.
+  static constexpr std::int64_t header_size = 4;
+
+  int const acceleration_;
+};
+
+}  // namespace internal
+
+using internal::BlockCompressor;
+using internal::Lz4Compressor;
+using internal::ZstdCompressor;
+
+}  // namespace _compressors
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,132 @@
+#include "base/compressors.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "base/array.hpp"
+#include "base/sink_source.hpp"
+#include "gipfeli/compression.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using namespace principia::base::_array;
+using namespace principia::base::_compressors;
+using namespace principia::base::_sink_source;
+
+using ::google::compression::Compressor;
+
+class CompressorsTest : public ::testing::Test {
+ protected:
+  // A chunk of text that is somewhat compressible, and whose chunks for
+  // different |seed|s have a lot in common, like the chunks of a serialized
+  // message.
+  static std::string MakeChunk(int const seed) {
+    std::string result;
+    for (int i = 0; i < 20; ++i) {
+      absl::StrAppend(&result,
+                      "timeline { instant { scalar { dimensions: 3 magnitude: ",
+                      seed * 20 + i,
+                      " } } degrees_of_freedom { t1 { point { magnitude: ",
+                      (seed * 7919 + i * 104729) % 1000003,
+                      " } } } }\n");
+    }
+    return result;
+  }
+
+  static void TestRoundTrip(Compressor& compressor, std::string const& input) {
+    // String API.
+    std::string compressed;
+    std::string uncompressed;
+    EXPECT_EQ(compressed.size(), compressor.Compress(input, &compressed));
+    EXPECT_LE(compressed.size(), compressor.MaxCompressedLength(input.size()));
+    size_t length;
+    EXPECT_TRUE(compressor.GetUncompressedLength(compressed, &length));
+    EXPECT_EQ(input.size(), length);
+    EXPECT_TRUE(compressor.Uncompress(compressed, &uncompressed));
+    EXPECT_EQ(input, uncompressed);
+
+    // Stream API, as used by the serializer and the deserializer.
+    std::vector<std::uint8_t> compressed_buffer(
+        compressor.MaxCompressedLength(input.size()));
+    std::vector<std::uint8_t> uncompressed_buffer(input.size());
+    ArraySource<std::uint8_t const> source(Array<std::uint8_t const>(
+        reinterpret_cast<std::uint8_t const*>(input.data()), input.size()));
+    ArraySink<std::uint8_t> sink{Array<std::uint8_t>(compressed_buffer)};
+    EXPECT_EQ(compressed.size(), compressor.CompressStream(&source, &sink));
+    EXPECT_EQ(0, source.Available());
+    ArraySource<std::uint8_t> compressed_source(sink.array());
+    ArraySink<std::uint8_t> uncompressed_sink{
+        Array<std::uint8_t>(uncompressed_buffer)};
+    EXPECT_TRUE(
+        compressor.UncompressStream(&compressed_source, &uncompressed_sink));
+    EXPECT_EQ(std::string(uncompressed_buffer.begin(),
+                          uncompressed_buffer.end()),
+              input);
+  }
+};
+
+TEST_F(CompressorsTest, Zstd) {
+  std::string const input = MakeChunk(0);
+  ZstdCompressor compressor;
+  TestRoundTrip(compressor, input);
+  TestRoundTrip(compressor, "");
+  ZstdCompressor high_compressor(/*level=*/19);
+  TestRoundTrip(high_compressor, input);
+
+  std::string compressed;
+  compressor.Compress(input, &compressed);
+  EXPECT_LT(compressed.size(), input.size() / 2);
+  compressed.resize(compressed.size() - 1);
+  std::string uncompressed;
+  EXPECT_FALSE(compressor.Uncompress(compressed, &uncompressed));
+}
+
+TEST_F(CompressorsTest, ZstdDictionary) {
+  std::vector<std::string> samples;
+  for (int seed = 1; seed <= 1000; ++seed) {
+    samples.push_back(MakeChunk(seed));
+  }
+  std::string const dictionary =
+      ZstdCompressor::TrainDictionary(samples, /*capacity=*/4096);
+  EXPECT_LT(0, dictionary.size());
+  EXPECT_GE(4096, dictionary.size());
+
+  std::string const input = MakeChunk(0);
+  ZstdCompressor compressor;
+  ZstdCompressor dictionary_compressor(ZstdCompressor::default_level,
+                                       dictionary);
+  TestRoundTrip(dictionary_compressor, input);
+
+  std::string compressed;
+  std::string dictionary_compressed;
+  compressor.Compress(input, &compressed);
+  dictionary_compressor.Compress(input, &dictionary_compressed);
+  EXPECT_LT(dictionary_compressed.size(), compressed.size());
+
+  // The dictionary is needed for uncompression.
+  std::string uncompressed;
+  EXPECT_FALSE(compressor.Uncompress(dictionary_compressed, &uncompressed));
+}
+
+TEST_F(CompressorsTest, Lz4) {
+  std::string const input = MakeChunk(0);
+  Lz4Compressor compressor;
+  TestRoundTrip(compressor, input);
+  TestRoundTrip(compressor, "");
+  Lz4Compressor fast_compressor(/*acceleration=*/8);
+  TestRoundTrip(fast_compressor, input);
+
+  std::string compressed;
+  compressor.Compress(input, &compressed);
+  EXPECT_LT(compressed.size(), input.size() / 2);
+  compressed.resize(compressed.size() - 1);
+  std::string uncompressed;
+  EXPECT_FALSE(compressor.Uncompress(compressed, &uncompressed));
+}
+
+}  // namespace base
+}  // namespace principia
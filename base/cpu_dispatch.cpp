@@ -0,0 +1,75 @@
+#include "base/cpu_dispatch.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "base/cpuid.hpp"
+#include "base/flags.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _cpu_dispatch {
+namespace internal {
+
+using namespace principia::base::_cpuid;
+using namespace principia::base::_flags;
+
+std::string_view InstructionSetName(InstructionSet const instruction_set) {
+  switch (instruction_set) {
+    case InstructionSet::SSE2:
+      return "sse2";
+    case InstructionSet::AVX_FMA:
+      return "avx_fma";
+    case InstructionSet::AVX2:
+      return "avx2";
+    case InstructionSet::AVX512F:
+      return "avx512f";
+  }
+  LOG(FATAL) << "Unexpected instruction set "
+             << static_cast<int>(instruction_set);
+}
+
+InstructionSet SupportedInstructionSet() {
+  if (!HasCPUFeatures(CPUFeatureFlags::AVX | CPUFeatureFlags::FMA)) {
+    return InstructionSet::SSE2;
+  } else if (!HasCPUFeatures(CPUExtendedFeatureFlags::AVX2)) {
+    return InstructionSet::AVX_FMA;
+  } else if (!HasCPUFeatures(CPUExtendedFeatureFlags::AVX512F)) {
+    return InstructionSet::AVX2;
+  } else {
+    return InstructionSet::AVX512F;
+  }
+}
+
+InstructionSet DispatchedInstructionSet() {
+  static InstructionSet const dispatched_instruction_set = []() {
+    InstructionSet result = SupportedInstructionSet();
+    std::string_view const name = "max_instruction_set";
+    if (Flags::IsPresent(name)) {
+      auto const values = Flags::Values(name);
+      CHECK_EQ(values.size(), 1);
+      std::string const& value = *values.begin();
+      bool found = false;
+      for (int i = 0; i < number_of_instruction_sets; ++i) {
+        auto const instruction_set = static_cast<InstructionSet>(i);
+        if (value == InstructionSetName(instruction_set)) {
+          result = std::min(result, instruction_set);
+          found = true;
+          break;
+        }
+      }
+      LOG_IF(FATAL, !found) << "Unknown instruction set " << value;
+    }
+    LOG(INFO) << "Dispatching kernels for " << InstructionSetName(result)
+              << " (processor supports "
+              << InstructionSetName(SupportedInstructionSet()) << ")";
+    return result;
+  }();
+  return dispatched_instruction_set;
+}
+
+}  // namespace internal
+}  // namespace _cpu_dispatch
+}  // namespace base
+}  // namespace principia
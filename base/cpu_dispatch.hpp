@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+namespace principia {
+namespace base {
+namespace _cpu_dispatch {
+namespace internal {
+
+// The instruction sets for which a kernel may have a dedicated variant, in
+// increasing order of capability.  Each one implies the previous ones.
+enum class InstructionSet : int {
+  SSE2 = 0,     // The baseline on x86-64.
+  AVX_FMA = 1,  // AVX and FMA3.
+  AVX2 = 2,     // AVX2, AVX and FMA3.
+  AVX512F = 3,  // AVX-512 Foundation, AVX2, AVX and FMA3.
+};
+
+constexpr int number_of_instruction_sets = 4;
+
+std::string_view InstructionSetName(InstructionSet instruction_set);
+
+// The most capable instruction set supported by this processor.
+InstructionSet SupportedInstructionSet();
+
+// The instruction set used to select the variants of the kernels.  This is the
+// supported instruction set, capped by the flag |max_instruction_set| if it is
+// present, e.g.:
+//   principia_flags {
+//     max_instruction_set = sse2
+//   }
+// This is resolved once, on the first call, so the flags must have been set by
+// then.  Capping the instruction set is useful to check that the results do
+// not depend on the processor.
+InstructionSet DispatchedInstructionSet();
+
+// A family of variants of a kernel, for different instruction sets.  The
+// variants must be interchangeable, even though their results may differ in
+// the last bits.
+template<typename Function>
+class KernelVariants final {
+ public:
+  // |generic| is used when no more capable variant may be used, so it must not
+  // require anything beyond SSE2.
+  explicit KernelVariants(Function* generic);
+
+  // Registers |variant| for |instruction_set|.  Must only be called if the
+  // compiler is able to emit the instructions of |instruction_set|.
+  KernelVariants& Add(InstructionSet instruction_set, Function* variant);
+
+  // Returns the variant for the most capable instruction set that doesn't
+  // exceed |instruction_set|.  The second overload uses the result of
+  // |DispatchedInstructionSet|.
+  Function* Select(InstructionSet instruction_set) const;
+  Function* Select() const;
+
+ private:
+  std::array<Function*, number_of_instruction_sets> variants_{};
+};
+
+}  // namespace internal
+
+using internal::DispatchedInstructionSet;
+using internal::InstructionSet;
+using internal::InstructionSetName;
+using internal::KernelVariants;
+using internal::number_of_instruction_sets;
+using internal::SupportedInstructionSet;
+
+}  // namespace _cpu_dispatch
+}  // namespace base
+}  // namespace principia
+
+#include "base/cpu_dispatch_body.hpp"
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "base/cpu_dispatch.hpp"
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _cpu_dispatch {
+namespace internal {
+
+template<typename Function>
+KernelVariants<Function>::KernelVariants(Function* const generic) {
+  CHECK_NOTNULL(generic);
+  variants_[static_cast<int>(InstructionSet::SSE2)] = generic;
+}
+
+template<typename Function>
+KernelVariants<Function>& KernelVariants<Function>::Add(
+    InstructionSet const instruction_set,
+    Function* const variant) {
+  CHECK_NOTNULL(variant);
+  variants_[static_cast<int>(instruction_set)] = variant;
+  return *this;
+}
+
+template<typename Function>
+Function* KernelVariants<Function>::Select(
+    InstructionSet const instruction_set) const {
+  for (int i = static_cast<int>(instruction_set);; --i) {
+    if (variants_[i] != nullptr) {
+      return variants_[i];
+    }
+  }
+}
+
+template<typename Function>
+Function* KernelVariants<Function>::Select() const {
+  return Select(DispatchedInstructionSet());
+}
+
+}  // namespace internal
+}  // namespace _cpu_dispatch
+}  // namespace base
+}  // namespace principia
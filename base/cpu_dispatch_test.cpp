@@ -0,0 +1,52 @@
+#include "base/cpu_dispatch.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::Eq;
+using ::testing::Le;
+using namespace principia::base::_cpu_dispatch;
+
+namespace {
+
+int Generic() {
+  return 0;
+}
+
+int AVX2() {
+  return 2;
+}
+
+}  // namespace
+
+TEST(CPUDispatchTest, Supported) {
+  // We require Prescott or later, and the dispatched instruction set never
+  // exceeds the supported one.
+  EXPECT_THAT(static_cast<int>(SupportedInstructionSet()),
+              Le(number_of_instruction_sets - 1));
+  EXPECT_THAT(DispatchedInstructionSet(), Le(SupportedInstructionSet()));
+}
+
+TEST(CPUDispatchTest, Select) {
+  KernelVariants<int()> variants(&Generic);
+  EXPECT_THAT(variants.Select(InstructionSet::AVX512F)(), Eq(0));
+  variants.Add(InstructionSet::AVX2, &AVX2);
+  EXPECT_THAT(variants.Select(InstructionSet::SSE2)(), Eq(0));
+  EXPECT_THAT(variants.Select(InstructionSet::AVX_FMA)(), Eq(0));
+  EXPECT_THAT(variants.Select(InstructionSet::AVX2)(), Eq(2));
+  EXPECT_THAT(variants.Select(InstructionSet::AVX512F)(), Eq(2));
+  auto* const expected =
+      DispatchedInstructionSet() >= InstructionSet::AVX2 ? &AVX2 : &Generic;
+  EXPECT_THAT(variants.Select(), Eq(expected));
+}
+
+TEST(CPUDispatchTest, Names) {
+  EXPECT_THAT(InstructionSetName(InstructionSet::SSE2), Eq("sse2"));
+  EXPECT_THAT(InstructionSetName(InstructionSet::AVX512F), Eq("avx512f"));
+}
+
+}  // namespace base
+}  // namespace principia
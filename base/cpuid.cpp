@@ -51,6 +51,12 @@ CPUFeatureFlags operator|(CPUFeatureFlags const left,
                                       static_cast<std::uint64_t>(right));
 }
 
+CPUExtendedFeatureFlags operator|(CPUExtendedFeatureFlags const left,
+                                  CPUExtendedFeatureFlags const right) {
+  return static_cast<CPUExtendedFeatureFlags>(
+      static_cast<std::uint32_t>(left) | static_cast<std::uint32_t>(right));
+}
+
 bool HasCPUFeatures(CPUFeatureFlags const flags) {
   auto const leaf_1 = CPUID(1, 0);
   return static_cast<CPUFeatureFlags>(
@@ -58,6 +64,17 @@ bool HasCPUFeatures(CPUFeatureFlags const flags) {
              static_cast<std::uint64_t>(flags)) == flags;
 }
 
+bool HasCPUFeatures(CPUExtendedFeatureFlags const flags) {
+  // Leaf 7 may not exist on old processors, in which case CPUID returns the
+  // data of the highest basic leaf.
+  if (CPUID(0, 0).eax < 7) {
+    return false;
+  }
+  auto const leaf_7 = CPUID(7, 0);
+  return static_cast<CPUExtendedFeatureFlags>(
+             leaf_7.ebx & static_cast<std::uint32_t>(flags)) == flags;
+}
+
 }  // namespace internal
 }  // namespace _cpuid
 }  // namespace base
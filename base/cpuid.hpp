@@ -31,15 +31,27 @@ enum class CPUFeatureFlags : std::uint64_t {
   AVX = ecx_bit << 28,     // Advanced Vector eXtensions.
 };
 
+// Leaf 7, subleaf 0.
+// We represent extended feature flags as EBX.
+enum class CPUExtendedFeatureFlags : std::uint32_t {
+  // Table 3-8.
+  AVX2 = 1 << 5,      // Advanced Vector eXtensions 2.
+  AVX512F = 1 << 16,  // AVX-512 Foundation.
+};
+
 // Bitwise or of feature flags; the result represents the union of all features
 // in |left| and |right|.
 CPUFeatureFlags operator|(CPUFeatureFlags left, CPUFeatureFlags right);
+CPUExtendedFeatureFlags operator|(CPUExtendedFeatureFlags left,
+                                  CPUExtendedFeatureFlags right);
 
 // Whether the CPU has all features listed in |flags|.
 bool HasCPUFeatures(CPUFeatureFlags flags);
+bool HasCPUFeatures(CPUExtendedFeatureFlags flags);
 
 }  // namespace internal
 
+using internal::CPUExtendedFeatureFlags;
 using internal::CPUFeatureFlags;
 using internal::CPUVendorIdentificationString;
 using internal::HasCPUFeatures;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 
@@ -12,14 +13,27 @@ namespace internal {
 
 using namespace principia::base::_thread_pool;
 
+// Destroys objects asynchronously on a pool of gravediggers, so that large
+// objects (e.g., trajectories) are not freed on the thread of the client.
 class Graveyard {
  public:
-  explicit Graveyard(std::int64_t number_of_threads);
+  // At most |max_outstanding_burials| objects may be waiting for a gravedigger
+  // or being destroyed.  Past that limit, |Bury| destroys the object on the
+  // calling thread, so that the memory held by the graveyard remains bounded
+  // when objects are buried faster than they can be destroyed.
+  explicit Graveyard(std::int64_t number_of_threads,
+                     std::int64_t max_outstanding_burials = 1000);
 
   template<typename T>
   void Bury(std::unique_ptr<T> t);
 
+  // The number of objects buried but not yet destroyed.
+  std::int64_t outstanding_burials() const;
+
  private:
+  std::int64_t const max_outstanding_burials_;
+  std::atomic<std::int64_t> outstanding_burials_ = 0;
+  // Must come last, its destructor joins the threads that use the above.
   ThreadPool<void> gravedigger_;
 };
 
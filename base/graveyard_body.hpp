@@ -3,24 +3,48 @@
 #include "base/graveyard.hpp"
 
 #include <memory>
+#include <utility>
+
+#include "base/tracing.hpp"
 
 namespace principia {
 namespace base {
 namespace _graveyard {
 namespace internal {
 
-inline Graveyard::Graveyard(std::int64_t const number_of_threads)
-    : gravedigger_(number_of_threads) {}
+using namespace principia::base::_tracing;
+
+inline Graveyard::Graveyard(std::int64_t const number_of_threads,
+                            std::int64_t const max_outstanding_burials)
+    : max_outstanding_burials_(max_outstanding_burials),
+      gravedigger_(number_of_threads) {}
 
 template<typename T>
 void Graveyard::Bury(std::unique_ptr<T> t) {
-  // TODO(egg): Investigate the possibility of a mutable lambda with
-  // std::packaged_task in the ThreadPool instead of std::function.
-  gravedigger_.Add([coffin = t.release()]() {
-    delete coffin;
+  if (outstanding_burials_.fetch_add(1, std::memory_order_relaxed) >=
+      max_outstanding_burials_) {
+    // The gravediggers are not keeping up, destroy the object here rather than
+    // letting the queue grow.
+    {
+      TracingScope tracing_scope("Graveyard::BuryOnCaller");
+      t.reset();
+    }
+    outstanding_burials_.fetch_sub(1, std::memory_order_relaxed);
+    return;
+  }
+  gravedigger_.Add([this, coffin = std::move(t)]() mutable {
+    {
+      TracingScope tracing_scope("Graveyard::Dig");
+      coffin.reset();
+    }
+    outstanding_burials_.fetch_sub(1, std::memory_order_relaxed);
   });
 }
 
+inline std::int64_t Graveyard::outstanding_burials() const {
+  return outstanding_burials_.load(std::memory_order_relaxed);
+}
+
 }  // namespace internal
 }  // namespace _graveyard
 }  // namespace base
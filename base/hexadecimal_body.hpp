@@ -2,6 +2,8 @@
 
 #include "base/hexadecimal.hpp"
 
+#include <emmintrin.h>
+
 #include <cstdint>
 #include <cstring>
 
@@ -38,6 +40,75 @@ constexpr std::uint8_t hexadecimal_digits_to_nibble[256] = {
 #undef SKIP_48
 #endif
 
+// The number of bytes of binary data processed at once by the vectorized
+// loops.  SSE2 is the baseline on x86-64, so there is no need to dispatch.
+constexpr std::int64_t bytes_per_block = 16;
+
+// Encodes the |bytes_per_block| bytes at |input| into the 2 * |bytes_per_block|
+// upper-case digits at |output|.  The input is read before the output is
+// written, so the two may overlap.
+inline void EncodeBlock(std::uint8_t const* const input, char* const output) {
+  __m128i const bytes =
+      _mm_loadu_si128(reinterpret_cast<__m128i const*>(input));
+  __m128i const low_nibble_mask = _mm_set1_epi8(0x0F);
+  __m128i const high_nibbles =
+      _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble_mask);
+  __m128i const low_nibbles = _mm_and_si128(bytes, low_nibble_mask);
+  // Maps each nibble n to '0' + n, plus 'A' - '9' - 1 if n > 9.
+  auto const digits = [](__m128i const nibbles) {
+    __m128i const letter_offset =
+        _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)),
+                      _mm_set1_epi8('A' - '9' - 1));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+                        letter_offset);
+  };
+  __m128i const high_digits = digits(high_nibbles);
+  __m128i const low_digits = digits(low_nibbles);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                   _mm_unpacklo_epi8(high_digits, low_digits));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(output + bytes_per_block),
+                   _mm_unpackhi_epi8(high_digits, low_digits));
+}
+
+// Decodes the 2 * |bytes_per_block| digits at |input| into the
+// |bytes_per_block| bytes at |output|, with the same semantics as
+// |hexadecimal_digits_to_nibble|.  The input is read before the output is
+// written, so the two may overlap.
+inline void DecodeBlock(char const* const input, std::uint8_t* const output) {
+  // Maps the digits of |characters| to their value, and anything else to 0.
+  // The comparisons are signed, so the characters above 0x7F are less than '0'
+  // and map to 0.
+  auto const nibbles = [](__m128i const characters) {
+    auto const in_range = [&characters](char const first, char const last) {
+      return _mm_andnot_si128(
+          _mm_cmplt_epi8(characters, _mm_set1_epi8(first)),
+          _mm_cmplt_epi8(characters, _mm_set1_epi8(last + 1)));
+    };
+    return _mm_or_si128(
+        _mm_or_si128(
+            _mm_and_si128(in_range('0', '9'),
+                          _mm_sub_epi8(characters, _mm_set1_epi8('0'))),
+            _mm_and_si128(in_range('A', 'F'),
+                          _mm_sub_epi8(characters, _mm_set1_epi8('A' - 10)))),
+        _mm_and_si128(in_range('a', 'f'),
+                      _mm_sub_epi8(characters, _mm_set1_epi8('a' - 10))));
+  };
+  // In each 16-bit lane, the low byte is the high nibble and the high byte is
+  // the low nibble.  Combine them into a byte value in the low byte.
+  auto const bytes = [](__m128i const lanes) {
+    return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(lanes,
+                                                     _mm_set1_epi16(0x00FF)),
+                                       4),
+                        _mm_srli_epi16(lanes, 8));
+  };
+  __m128i const first = bytes(nibbles(
+      _mm_loadu_si128(reinterpret_cast<__m128i const*>(input))));
+  __m128i const second = bytes(nibbles(_mm_loadu_si128(
+      reinterpret_cast<__m128i const*>(input + bytes_per_block))));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                   _mm_packus_epi16(first, second));
+}
+
 template<bool null_terminated>
 void HexadecimalEncoder<null_terminated>::Encode(
     Array<std::uint8_t const> input,
@@ -54,16 +125,19 @@ void HexadecimalEncoder<null_terminated>::Encode(
         static_cast<void*>(&output.data[input.size << 1]) <= input.data)
       << "bad overlap";
   CHECK_GE(output.size, EncodedLength(input)) << "output too small";
-  // We want the result to start at |output.data[0]|.
-  output.data += ((input.size - 1) << 1);
   if constexpr (null_terminated) {
-    output.data[2] = 0;
+    output.data[input.size << 1] = 0;
   }
-  input.data += input.size - 1;
-  for (std::uint8_t const* const input_rend = input.data - input.size;
-       input.data != input_rend;
-       --input.data, output.data -= 2) {
-    std::memcpy(output.data, &byte_to_hexadecimal_digits[*input.data << 1], 2);
+  // The bytes after the last whole block are encoded first, one at a time.
+  std::int64_t const blocks_size = input.size & ~(bytes_per_block - 1);
+  for (std::int64_t i = input.size - 1; i >= blocks_size; --i) {
+    std::memcpy(&output.data[i << 1],
+                &byte_to_hexadecimal_digits[input.data[i] << 1],
+                2);
+  }
+  for (std::int64_t i = blocks_size - bytes_per_block; i >= 0;
+       i -= bytes_per_block) {
+    EncodeBlock(&input.data[i], &output.data[i << 1]);
   }
 }
 
@@ -102,8 +176,14 @@ void HexadecimalEncoder<null_terminated>::Decode(Array<char const> input,
         &input.data[input.size] <= static_cast<void*>(output.data))
       << "bad overlap";
   CHECK_GE(output.size, input.size / 2) << "output too small";
-  for (char const* const input_end = input.data + input.size;
-       input.data != input_end;
+  char const* const input_end = input.data + input.size;
+  for (char const* const blocks_end =
+           input.data + (input.size & ~(2 * bytes_per_block - 1));
+       input.data != blocks_end;
+       input.data += 2 * bytes_per_block, output.data += bytes_per_block) {
+    DecodeBlock(input.data, output.data);
+  }
+  for (; input.data != input_end;
        input.data += 2, ++output.data) {
     *output.data = (hexadecimal_digits_to_nibble[*input.data] << 4) |
                    hexadecimal_digits_to_nibble[*(input.data + 1)];
@@ -168,5 +168,61 @@ TEST_F(HexadecimalTest, Invalid) {
   EXPECT_THAT(bytes, ElementsAre('\x0A', '\x0C', '\xDE'));
 }
 
+// Long enough to exercise the vectorized loops and their remainders.
+TEST_F(HexadecimalTest, Blocks) {
+  std::int64_t const size = 256 + 5;
+  std::vector<std::uint8_t> bytes(size);
+  std::vector<char> uppercase_digits;
+  std::vector<char> lowercase_digits;
+  for (int i = 0; i < size; ++i) {
+    bytes[i] = i % 256;
+    for (int const nibble : {bytes[i] >> 4, bytes[i] & 0xF}) {
+      uppercase_digits.push_back("0123456789ABCDEF"[nibble]);
+      lowercase_digits.push_back("0123456789abcdef"[nibble]);
+    }
+  }
+
+  std::vector<char> digits(2 * size);
+  encoder_.Encode(bytes, digits);
+  EXPECT_EQ(uppercase_digits, digits);
+  std::vector<std::uint8_t> decoded_bytes(size);
+  encoder_.Decode(uppercase_digits, decoded_bytes);
+  EXPECT_EQ(bytes, decoded_bytes);
+  encoder_.Decode(lowercase_digits, decoded_bytes);
+  EXPECT_EQ(bytes, decoded_bytes);
+
+  // In place, with the output starting one byte before the input.
+  std::vector<std::uint8_t> buffer(2 * size + 1);
+  auto const buffer_characters = reinterpret_cast<char*>(buffer.data());
+  std::memcpy(&buffer[1], bytes.data(), size);
+  encoder_.Encode({&buffer[1], size}, {&buffer_characters[0], 2 * size});
+  EXPECT_EQ(Array<char const>(uppercase_digits),
+            Array<char>(&buffer_characters[0], 2 * size));
+  encoder_.Decode({&buffer_characters[0], 2 * size}, {&buffer[1], size});
+  EXPECT_EQ(Array<std::uint8_t const>(bytes),
+            Array<std::uint8_t>(&buffer[1], size));
+
+  // All the characters, valid or not, as high and low nibbles.
+  std::vector<char> all_digits;
+  std::vector<std::uint8_t> expected_bytes;
+  for (int c = 0; c < 256; ++c) {
+    char const character = static_cast<char>(c);
+    std::uint8_t nibble = 0;
+    if ('0' <= character && character <= '9') {
+      nibble = character - '0';
+    } else if ('A' <= character && character <= 'F') {
+      nibble = character - 'A' + 10;
+    } else if ('a' <= character && character <= 'f') {
+      nibble = character - 'a' + 10;
+    }
+    all_digits.insert(all_digits.end(), {character, '1', '2', character});
+    expected_bytes.push_back(nibble << 4 | 0x1);
+    expected_bytes.push_back(0x20 | nibble);
+  }
+  std::vector<std::uint8_t> all_bytes(expected_bytes.size());
+  encoder_.Decode(all_digits, all_bytes);
+  EXPECT_EQ(expected_bytes, all_bytes);
+}
+
 }  // namespace base
 }  // namespace principia
@@ -4,6 +4,7 @@
 #include <memory>
 #include <set>
 #include <thread>
+#include <type_traits>
 
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
@@ -40,6 +41,7 @@ class stop_token {
   friend class jthread;
   friend class stop_callback;
   friend class stop_source;
+  friend class StoppableTask;
 };
 
 // Provides the means to issue a stop request. A stop request made for one
@@ -125,6 +127,28 @@ class this_stoppable_thread {
 
   template<typename Function, typename... Args>
   friend jthread MakeStoppableThread(Function&& f, Args&&... args);
+  friend class StoppableTask;
+};
+
+// A unit of work that may be stopped but that doesn't own a thread, e.g.,
+// because it is executed by a pool of threads.  While |Run| executes, the stop
+// token of the current thread is that of this object, so |RETURN_IF_STOPPED|
+// observes the calls to |request_stop|.  A stop request cannot be undone, so
+// a new object must be constructed for each execution.
+class StoppableTask final {
+ public:
+  StoppableTask();
+
+  bool request_stop();
+
+  stop_token get_stop_token() const;
+
+  // Executes |f| on the current thread and returns its result.
+  template<typename Function>
+  std::invoke_result_t<Function> Run(Function&& f) const;
+
+ private:
+  not_null<std::unique_ptr<StopState>> const stop_state_;
 };
 
 #define RETURN_IF_STOPPED                                                    \
@@ -138,6 +162,7 @@ class this_stoppable_thread {
 }  // namespace internal
 
 using internal::MakeStoppableThread;
+using internal::StoppableTask;
 using internal::jthread;
 using internal::stop_callback;
 using internal::stop_source;
@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <set>
+#include <type_traits>
 #include <utility>
 
 namespace principia {
@@ -179,6 +180,33 @@ inline stop_token this_stoppable_thread::get_stop_token() {
   return stop_token_;
 }
 
+inline StoppableTask::StoppableTask()
+    : stop_state_(make_not_null_unique<StopState>()) {}
+
+inline bool StoppableTask::request_stop() {
+  return stop_state_->request_stop();
+}
+
+inline stop_token StoppableTask::get_stop_token() const {
+  return stop_token(stop_state_.get());
+}
+
+template<typename Function>
+std::invoke_result_t<Function> StoppableTask::Run(Function&& f) const {
+  // The token of the thread is restored when done, as the thread may itself
+  // be stoppable.
+  stop_token const previous_stop_token = this_stoppable_thread::stop_token_;
+  this_stoppable_thread::stop_token_ = get_stop_token();
+  if constexpr (std::is_void_v<std::invoke_result_t<Function>>) {
+    std::forward<Function>(f)();
+    this_stoppable_thread::stop_token_ = previous_stop_token;
+  } else {
+    auto result = std::forward<Function>(f)();
+    this_stoppable_thread::stop_token_ = previous_stop_token;
+    return result;
+  }
+}
+
 }  // namespace internal
 }  // namespace _jthread
 }  // namespace base
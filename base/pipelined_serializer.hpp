@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "base/array.hpp"
+#include "base/encoder.hpp"
+#include "base/jthread.hpp"
+#include "base/not_null.hpp"
+#include "base/pull_serializer.hpp"
+#include "gipfeli/compression.h"
+#include "google/protobuf/message.h"
+
+namespace principia {
+namespace base {
+namespace _pipelined_serializer {
+namespace internal {
+
+using namespace principia::base::_array;
+using namespace principia::base::_encoder;
+using namespace principia::base::_jthread;
+using namespace principia::base::_not_null;
+using namespace principia::base::_pull_serializer;
+
+using ::google::compression::Compressor;
+
+// A serializer that produces the same chunks as a |PullSerializer|, but where
+// the generation of the serialized bytes, their compression and their encoding
+// run as separate stages on different threads, connected by bounded queues.
+// Like for |PullSerializer|, the client calls |Start| and then repeatedly calls
+// |Pull| until it returns an empty chunk.
+class PipelinedSerializer final {
+ public:
+  using CharEncoder = Encoder<char, /*null_terminated=*/true>;
+
+  // |chunk_size| and |number_of_chunks| are passed to the underlying
+  // |PullSerializer|, and at most |number_of_chunks| chunks are held in the
+  // queue following each stage.  If |compressor| is null the chunks are not
+  // compressed.  If |encoder| is null the chunks are not encoded, and the
+  // encoding stage is skipped altogether.  No transfer of ownership of
+  // |encoder|.
+  PipelinedSerializer(int chunk_size,
+                      int number_of_chunks,
+                      std::unique_ptr<Compressor> compressor,
+                      CharEncoder* encoder);
+  // Same as above, but the chunks are compressed concurrently by the workers of
+  // the underlying |PullSerializer|, one per element of |compressors|, and the
+  // compression stage merely hands them over to the encoding stage.  If
+  // |compressors| is empty the chunks are not compressed.
+  PipelinedSerializer(int chunk_size,
+                      int number_of_chunks,
+                      std::vector<std::unique_ptr<Compressor>> compressors,
+                      CharEncoder* encoder);
+
+  // Drains the stages if the client didn't pull all the chunks.
+  ~PipelinedSerializer();
+
+  // Starts the serializer, which will proceed to serialize |message|.  This
+  // method must be called at most once for each serializer object.
+  void Start(not_null<google::protobuf::Message const*> message);
+
+  // Obtains the next chunk from the serializer.  Blocks if no chunk is
+  // available.  Returns an object of |size| 0 at the end of the serialization.
+  // If there is an encoder, the chunk is the null-terminated encoded form of
+  // the compressed bytes.  Otherwise, the chunk is made of the compressed bytes
+  // themselves, and its boundaries must be preserved when feeding it back to
+  // the |PushDeserializer|.
+  UniqueArray<char> Pull();
+
+ private:
+  // A queue connecting two stages.  |Push| blocks while the queue is full and
+  // |Pop| blocks while it is empty.  An object of |size| 0 marks the end of the
+  // stream.
+  class BoundedQueue final {
+   public:
+    explicit BoundedQueue(int capacity);
+
+    void Push(UniqueArray<char> chunk);
+    UniqueArray<char> Pop();
+
+   private:
+    int const capacity_;
+    absl::Mutex lock_;
+    std::queue<UniqueArray<char>> queue_ GUARDED_BY(lock_);
+  };
+
+  // The loops of the |compressor_thread_| and of the |encoder_thread_|.
+  void Compress();
+  void Encode();
+
+  // The queue from which |Pull| obtains its chunks.
+  BoundedQueue& output();
+
+  // Null if the chunks are not compressed, or if they are compressed by the
+  // |pull_serializer_|.
+  std::unique_ptr<Compressor> const compressor_;
+  CharEncoder* const encoder_;
+
+  PullSerializer pull_serializer_;
+  BoundedQueue compressed_;
+  BoundedQueue encoded_;
+
+  // Set by |Pull| once it has returned the end of the stream.
+  bool done_ = false;
+
+  jthread compressor_thread_;
+  jthread encoder_thread_;
+};
+
+}  // namespace internal
+
+using internal::PipelinedSerializer;
+
+}  // namespace _pipelined_serializer
+}  // namespace base
+}  // namespace principia
+
+#include "base/pipelined_serializer_body.hpp"
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "base/pipelined_serializer.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/sink_source.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _pipelined_serializer {
+namespace internal {
+
+using namespace principia::base::_sink_source;
+
+inline PipelinedSerializer::BoundedQueue::BoundedQueue(int const capacity)
+    : capacity_(capacity) {
+  CHECK_LT(0, capacity_);
+}
+
+inline void PipelinedSerializer::BoundedQueue::Push(UniqueArray<char> chunk) {
+  absl::MutexLock l(&lock_);
+  auto const queue_has_room = [this]() {
+    lock_.AssertReaderHeld();
+    return queue_.size() < static_cast<std::size_t>(capacity_);
+  };
+  lock_.Await(absl::Condition(&queue_has_room));
+  queue_.push(std::move(chunk));
+}
+
+inline UniqueArray<char> PipelinedSerializer::BoundedQueue::Pop() {
+  absl::MutexLock l(&lock_);
+  auto const queue_has_elements = [this]() {
+    lock_.AssertReaderHeld();
+    return !queue_.empty();
+  };
+  lock_.Await(absl::Condition(&queue_has_elements));
+  UniqueArray<char> result = std::move(queue_.front());
+  queue_.pop();
+  return result;
+}
+
+inline PipelinedSerializer::PipelinedSerializer(
+    int const chunk_size,
+    int const number_of_chunks,
+    std::unique_ptr<Compressor> compressor,
+    CharEncoder* const encoder)
+    : compressor_(std::move(compressor)),
+      encoder_(encoder),
+      pull_serializer_(chunk_size, number_of_chunks, /*compressor=*/nullptr),
+      compressed_(number_of_chunks),
+      encoded_(number_of_chunks) {}
+
+inline PipelinedSerializer::PipelinedSerializer(
+    int const chunk_size,
+    int const number_of_chunks,
+    std::vector<std::unique_ptr<Compressor>> compressors,
+    CharEncoder* const encoder)
+    : encoder_(encoder),
+      pull_serializer_(chunk_size, number_of_chunks, std::move(compressors)),
+      compressed_(number_of_chunks),
+      encoded_(number_of_chunks) {}
+
+inline PipelinedSerializer::~PipelinedSerializer() {
+  if (compressor_thread_.joinable()) {
+    while (!done_) {
+      Pull();
+    }
+  }
+}
+
+inline void PipelinedSerializer::Start(
+    not_null<google::protobuf::Message const*> const message) {
+  CHECK(!compressor_thread_.joinable());
+  pull_serializer_.Start(message);
+  compressor_thread_ = MakeStoppableThread([this]() { Compress(); });
+  if (encoder_ != nullptr) {
+    encoder_thread_ = MakeStoppableThread([this]() { Encode(); });
+  }
+}
+
+inline UniqueArray<char> PipelinedSerializer::Pull() {
+  if (done_) {
+    return UniqueArray<char>();
+  }
+  UniqueArray<char> result = output().Pop();
+  done_ = result.size == 0;
+  return result;
+}
+
+inline void PipelinedSerializer::Compress() {
+  for (;;) {
+    // The array returned by |Pull| stays valid until the next call, so it must
+    // be copied or compressed before pulling again.
+    Array<std::uint8_t> const bytes = pull_serializer_.Pull();
+    if (bytes.size == 0) {
+      compressed_.Push(UniqueArray<char>());
+      return;
+    }
+    if (compressor_ == nullptr) {
+      UniqueArray<char> chunk(bytes.size);
+      std::copy(bytes.data, bytes.data + bytes.size, chunk.data.get());
+      compressed_.Push(std::move(chunk));
+    } else {
+      UniqueArray<char> chunk(compressor_->MaxCompressedLength(bytes.size));
+      ArraySource<std::uint8_t> source(bytes);
+      ArraySink<char> sink(chunk.get());
+      compressor_->CompressStream(&source, &sink);
+      chunk.size = sink.array().size;
+      compressed_.Push(std::move(chunk));
+    }
+  }
+}
+
+inline void PipelinedSerializer::Encode() {
+  for (;;) {
+    UniqueArray<char> const chunk = compressed_.Pop();
+    if (chunk.size == 0) {
+      encoded_.Push(UniqueArray<char>());
+      return;
+    }
+    encoded_.Push(encoder_->Encode(Array<std::uint8_t const>(
+        reinterpret_cast<std::uint8_t const*>(chunk.data.get()), chunk.size)));
+  }
+}
+
+inline PipelinedSerializer::BoundedQueue& PipelinedSerializer::output() {
+  return encoder_ == nullptr ? compressed_ : encoded_;
+}
+
+}  // namespace internal
+}  // namespace _pipelined_serializer
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,166 @@
+#include "base/pipelined_serializer.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/array.hpp"
+#include "base/hexadecimal.hpp"
+#include "base/not_null.hpp"
+#include "base/pull_serializer.hpp"
+#include "gipfeli/gipfeli.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "serialization/geometry.pb.h"
+#include "serialization/physics.pb.h"
+#include "serialization/quantities.pb.h"
+
+namespace principia {
+namespace base {
+
+using serialization::DiscreteTrajectory;
+using serialization::Pair;
+using serialization::Point;
+using serialization::Quantity;
+using ::testing::ElementsAreArray;
+using namespace principia::base::_array;
+using namespace principia::base::_hexadecimal;
+using namespace principia::base::_not_null;
+using namespace principia::base::_pipelined_serializer;
+using namespace principia::base::_pull_serializer;
+
+namespace {
+int const chunk_size = 99;
+int const number_of_chunks = 3;
+}  // namespace
+
+class PipelinedSerializerTest : public ::testing::Test {
+ protected:
+  static not_null<std::unique_ptr<DiscreteTrajectory const>> BuildTrajectory() {
+    not_null<std::unique_ptr<DiscreteTrajectory>> result =
+        make_not_null_unique<DiscreteTrajectory>();
+    // Build a biggish protobuf for serialization.
+    for (int i = 0; i < 100; ++i) {
+      auto* const idof = result->add_timeline();
+      Point* instant = idof->mutable_instant();
+      Quantity* scalar = instant->mutable_scalar();
+      scalar->set_dimensions(3);
+      scalar->set_magnitude(3 * i);
+      Pair* dof = idof->mutable_degrees_of_freedom();
+      Pair::Element* t1 = dof->mutable_t1();
+      Point* point1 = t1->mutable_point();
+      Quantity* scalar1 = point1->mutable_scalar();
+      scalar1->set_dimensions(1);
+      scalar1->set_magnitude(i);
+      Pair::Element* t2 = dof->mutable_t2();
+      Point* point2 = t2->mutable_point();
+      Quantity* scalar2 = point2->mutable_scalar();
+      scalar2->set_dimensions(2);
+      scalar2->set_magnitude(2 * i);
+    }
+    return std::move(result);
+  }
+
+  // The chunks produced by a |PullSerializer| for the same message.
+  static std::vector<std::string> PullSerializerChunks(
+      DiscreteTrajectory const& trajectory) {
+    std::vector<std::string> result;
+    // With compression, a |PullSerializer| needs at least 4 chunks.
+    PullSerializer pull_serializer(chunk_size,
+                                   /*number_of_chunks=*/4,
+                                   google::compression::NewGipfeliCompressor());
+    pull_serializer.Start(&trajectory);
+    for (;;) {
+      Array<std::uint8_t> const bytes = pull_serializer.Pull();
+      if (bytes.size == 0) {
+        break;
+      }
+      result.emplace_back(reinterpret_cast<char const*>(bytes.data),
+                          bytes.size);
+    }
+    return result;
+  }
+
+  static std::vector<std::string> PipelinedSerializerChunks(
+      DiscreteTrajectory const& trajectory,
+      PipelinedSerializer::CharEncoder* const encoder) {
+    std::vector<std::string> result;
+    PipelinedSerializer pipelined_serializer(
+        chunk_size,
+        number_of_chunks,
+        google::compression::NewGipfeliCompressor(),
+        encoder);
+    pipelined_serializer.Start(&trajectory);
+    for (;;) {
+      UniqueArray<char> const chunk = pipelined_serializer.Pull();
+      if (chunk.size == 0) {
+        break;
+      }
+      result.emplace_back(chunk.data.get(), chunk.size);
+    }
+    EXPECT_EQ(0, pipelined_serializer.Pull().size);
+    return result;
+  }
+};
+
+TEST_F(PipelinedSerializerTest, Unencoded) {
+  auto const trajectory = BuildTrajectory();
+  auto const expected_chunks = PullSerializerChunks(*trajectory);
+  EXPECT_LT(1, expected_chunks.size());
+  EXPECT_THAT(PipelinedSerializerChunks(*trajectory, /*encoder=*/nullptr),
+              ElementsAreArray(expected_chunks));
+}
+
+TEST_F(PipelinedSerializerTest, Encoded) {
+  HexadecimalEncoder</*null_terminated=*/true> encoder;
+  auto const trajectory = BuildTrajectory();
+  std::vector<std::string> expected_chunks;
+  for (auto const& chunk : PullSerializerChunks(*trajectory)) {
+    auto const encoded = encoder.Encode(Array<std::uint8_t const>(
+        reinterpret_cast<std::uint8_t const*>(chunk.data()), chunk.size()));
+    expected_chunks.emplace_back(encoded.data.get(), encoded.size);
+  }
+  EXPECT_THAT(PipelinedSerializerChunks(*trajectory, &encoder),
+              ElementsAreArray(expected_chunks));
+}
+
+TEST_F(PipelinedSerializerTest, SeveralCompressors) {
+  auto const trajectory = BuildTrajectory();
+  auto const expected_chunks = PullSerializerChunks(*trajectory);
+  std::vector<std::unique_ptr<google::compression::Compressor>> compressors;
+  for (int i = 0; i < 3; ++i) {
+    compressors.push_back(google::compression::NewGipfeliCompressor());
+  }
+  PipelinedSerializer pipelined_serializer(chunk_size,
+                                           /*number_of_chunks=*/8,
+                                           std::move(compressors),
+                                           /*encoder=*/nullptr);
+  pipelined_serializer.Start(trajectory.get());
+  std::vector<std::string> actual_chunks;
+  for (;;) {
+    UniqueArray<char> const chunk = pipelined_serializer.Pull();
+    if (chunk.size == 0) {
+      break;
+    }
+    actual_chunks.emplace_back(chunk.data.get(), chunk.size);
+  }
+  EXPECT_THAT(actual_chunks, ElementsAreArray(expected_chunks));
+}
+
+TEST_F(PipelinedSerializerTest, EarlyDestruction) {
+  HexadecimalEncoder</*null_terminated=*/true> encoder;
+  auto const trajectory = BuildTrajectory();
+  PipelinedSerializer pipelined_serializer(
+      chunk_size,
+      number_of_chunks,
+      google::compression::NewGipfeliCompressor(),
+      &encoder);
+  pipelined_serializer.Start(trajectory.get());
+  EXPECT_LT(0, pipelined_serializer.Pull().size);
+  // The destructor must not block even though the serialization is not
+  // complete.
+}
+
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,144 @@
+#include "base/pooling_allocator.hpp"
+
+#include <array>
+#include <vector>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _pooling_allocator {
+namespace internal {
+
+constexpr std::size_t number_of_pools =
+    BlockPool::max_block_size / BlockPool::block_size_granularity;
+static_assert(BlockPool::max_block_size %
+                  BlockPool::block_size_granularity == 0);
+
+// The number of blocks that a thread may keep for itself in each pool, and the
+// number of blocks that it exchanges with the pool when it runs out or
+// overflows.
+constexpr std::size_t max_thread_cached_blocks = 64;
+constexpr std::size_t thread_cache_transfer = max_thread_cached_blocks / 2;
+
+// The blocks cached by a thread, by pool.  Allocations and deallocations first
+// go to this cache, so that the lock of the pool is only taken once every
+// |thread_cache_transfer| operations.  The blocks return to the pools when the
+// thread exits.
+struct ThreadCache {
+  ~ThreadCache();
+
+  std::array<std::vector<void*>, number_of_pools> free_blocks;
+};
+
+// Set when the cache of this thread has been destroyed.  Objects with static
+// storage duration may still allocate or deallocate after that, and then go
+// directly to the pools.
+thread_local bool thread_cache_destroyed = false;
+
+ThreadCache::~ThreadCache() {
+  thread_cache_destroyed = true;
+  for (int i = 0; i < number_of_pools; ++i) {
+    BlockPool::ForSize((i + 1) * BlockPool::block_size_granularity)
+        .TakeBlocks(free_blocks[i], free_blocks[i].size());
+  }
+}
+
+thread_local ThreadCache thread_cache;
+
+BlockPool& BlockPool::ForSize(std::size_t const size) {
+  CHECK_LT(0, size);
+  CHECK_LE(size, max_block_size);
+  // Never destroyed, to avoid problems with the order of static destructions:
+  // containers with static storage duration may use the pools.
+  static auto* const pools = [] {
+    auto* const pools = new std::array<BlockPool*, number_of_pools>;
+    for (int i = 0; i < number_of_pools; ++i) {
+      (*pools)[i] = new BlockPool((i + 1) * block_size_granularity);
+    }
+    return pools;
+  }();
+  return *(*pools)[(size - 1) / block_size_granularity];
+}
+
+void* BlockPool::Allocate() {
+  if (thread_cache_destroyed) {
+    absl::MutexLock l(&lock_);
+    if (!free_blocks_.empty()) {
+      void* const block = free_blocks_.back();
+      free_blocks_.pop_back();
+      return block;
+    }
+    return ::operator new(block_size_);
+  }
+  auto& cached_blocks = thread_cache.free_blocks[index_];
+  if (cached_blocks.empty()) {
+    GiveBlocks(cached_blocks, thread_cache_transfer);
+    if (cached_blocks.empty()) {
+      return ::operator new(block_size_);
+    }
+  }
+  void* const block = cached_blocks.back();
+  cached_blocks.pop_back();
+  return block;
+}
+
+void BlockPool::Deallocate(void* const block) {
+  if (thread_cache_destroyed) {
+    std::vector<void*> blocks{block};
+    TakeBlocks(blocks, /*count=*/1);
+    return;
+  }
+  auto& cached_blocks = thread_cache.free_blocks[index_];
+  cached_blocks.push_back(block);
+  if (cached_blocks.size() > max_thread_cached_blocks) {
+    TakeBlocks(cached_blocks, thread_cache_transfer);
+  }
+}
+
+void BlockPool::GiveBlocks(std::vector<void*>& blocks,
+                           std::size_t const count) {
+  absl::MutexLock l(&lock_);
+  for (std::size_t i = 0; i < count && !free_blocks_.empty(); ++i) {
+    blocks.push_back(free_blocks_.back());
+    free_blocks_.pop_back();
+  }
+}
+
+void BlockPool::TakeBlocks(std::vector<void*>& blocks,
+                           std::size_t const count) {
+  CHECK_LE(count, blocks.size());
+  std::size_t const remaining_size = blocks.size() - count;
+  {
+    absl::MutexLock l(&lock_);
+    while (blocks.size() > remaining_size &&
+           free_blocks_.size() < max_pooled_blocks_) {
+      free_blocks_.push_back(blocks.back());
+      blocks.pop_back();
+    }
+  }
+  // The pool is full, the other blocks go back to the heap.
+  while (blocks.size() > remaining_size) {
+    ::operator delete(blocks.back());
+    blocks.pop_back();
+  }
+}
+
+std::size_t BlockPool::block_size() const {
+  return block_size_;
+}
+
+std::int64_t BlockPool::number_of_pooled_blocks() const {
+  absl::MutexLock l(&lock_);
+  return free_blocks_.size();
+}
+
+BlockPool::BlockPool(std::size_t const block_size)
+    : block_size_(block_size),
+      index_(block_size / block_size_granularity - 1),
+      max_pooled_blocks_(max_pooled_bytes / block_size) {}
+
+}  // namespace internal
+}  // namespace _pooling_allocator
+}  // namespace base
+}  // namespace principia
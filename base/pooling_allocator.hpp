@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace principia {
+namespace base {
+namespace _pooling_allocator {
+namespace internal {
+
+// A process-wide pool of memory blocks of a given size.  The blocks returned to
+// the pool are kept for reuse instead of going back to the heap, up to
+// |max_pooled_bytes| per pool.  Each thread also keeps a few blocks of each
+// pool for itself, so that most allocations and deallocations don't lock the
+// pool.  This is useful for containers that are repeatedly built and
+// destroyed, such as the timelines of the predictions: the blocks freed when a
+// prediction is replaced serve to build the next one without contending with
+// the rest of the process for the heap.
+class BlockPool final {
+ public:
+  // Blocks larger than this are not pooled.
+  static constexpr std::size_t max_block_size = 4096;
+  // The granularity of the sizes of the pools.
+  static constexpr std::size_t block_size_granularity = 64;
+  static constexpr std::size_t max_pooled_bytes = 64 << 20;
+
+  // Returns the pool for blocks of at least |size| bytes, which must be
+  // positive and at most |max_block_size|.
+  static BlockPool& ForSize(std::size_t size);
+
+  void* Allocate() LOCKS_EXCLUDED(lock_);
+  void Deallocate(void* block) LOCKS_EXCLUDED(lock_);
+
+  std::size_t block_size() const;
+  // The number of blocks held by the pool, excluding those cached by the
+  // threads.
+  std::int64_t number_of_pooled_blocks() const LOCKS_EXCLUDED(lock_);
+
+ private:
+  explicit BlockPool(std::size_t block_size);
+
+  // Moves at most |count| blocks from this pool to the back of |blocks|.
+  void GiveBlocks(std::vector<void*>& blocks, std::size_t count)
+      LOCKS_EXCLUDED(lock_);
+  // Moves |count| blocks from the back of |blocks| to this pool, or to the heap
+  // if the pool is full.
+  void TakeBlocks(std::vector<void*>& blocks, std::size_t count)
+      LOCKS_EXCLUDED(lock_);
+
+  std::size_t const block_size_;
+  // The index of this pool among the pools, which is also its index in the
+  // caches of the threads.
+  int const index_;
+  std::int64_t const max_pooled_blocks_;
+  mutable absl::Mutex lock_;
+  std::vector<void*> free_blocks_ GUARDED_BY(lock_);
+
+  friend struct ThreadCache;
+};
+
+// A stateless allocator (for use with containers such as `absl::btree_set`)
+// that takes its memory from the |BlockPool|s.  Allocations that are too large
+// or too aligned for the pools go to global new and delete.
+template<typename T>
+class PoolingAllocator {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // Constructors.  This is a stateless class so these don't do anything (but
+  // they are required by some containers).
+  PoolingAllocator() = default;
+  PoolingAllocator(PoolingAllocator const& other) = default;
+  template<typename U>
+  PoolingAllocator(PoolingAllocator<U> const& other) {}
+
+  T* allocate(std::size_t n);
+  void deallocate(T* p, std::size_t n);
+
+ private:
+  static bool is_pooled(std::size_t n);
+};
+
+// PoolingAllocators are equal regardless of type.
+template<typename T1, typename T2>
+constexpr bool operator==(PoolingAllocator<T1> const&,
+                          PoolingAllocator<T2> const&) {
+  return true;
+}
+
+template<typename T1, typename T2>
+constexpr bool operator!=(PoolingAllocator<T1> const&,
+                          PoolingAllocator<T2> const&) {
+  return false;
+}
+
+}  // namespace internal
+
+using internal::BlockPool;
+using internal::PoolingAllocator;
+using internal::operator!=;
+using internal::operator==;
+
+}  // namespace _pooling_allocator
+}  // namespace base
+}  // namespace principia
+
+#include "base/pooling_allocator_body.hpp"
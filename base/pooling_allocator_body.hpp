@@ -0,0 +1,37 @@
+#pragma once
+
+#include "base/pooling_allocator.hpp"
+
+namespace principia {
+namespace base {
+namespace _pooling_allocator {
+namespace internal {
+
+template<typename T>
+T* PoolingAllocator<T>::allocate(std::size_t const n) {
+  if (is_pooled(n)) {
+    return static_cast<T*>(BlockPool::ForSize(n * sizeof(T)).Allocate());
+  }
+  return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+template<typename T>
+void PoolingAllocator<T>::deallocate(T* const p, std::size_t const n) {
+  if (is_pooled(n)) {
+    BlockPool::ForSize(n * sizeof(T)).Deallocate(p);
+  } else {
+    ::operator delete(p);
+  }
+}
+
+template<typename T>
+bool PoolingAllocator<T>::is_pooled(std::size_t const n) {
+  return alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ &&
+         n > 0 &&
+         n <= BlockPool::max_block_size / sizeof(T);
+}
+
+}  // namespace internal
+}  // namespace _pooling_allocator
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,93 @@
+#include "base/pooling_allocator.hpp"
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "absl/container/btree_set.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::ElementsAreArray;
+using ::testing::Eq;
+using ::testing::Ge;
+using ::testing::IsNull;
+using ::testing::Not;
+using namespace principia::base::_pooling_allocator;
+
+TEST(PoolingAllocatorTest, RoundTrip) {
+  PoolingAllocator<double> allocator;
+  double* const p = allocator.allocate(10);
+  EXPECT_THAT(p, Not(IsNull()));
+  p[9] = 123;
+  allocator.deallocate(p, 10);
+
+  // The block is reused by an allocation in the same size class.
+  double* const q = allocator.allocate(9);
+  EXPECT_THAT(q, Eq(p));
+  allocator.deallocate(q, 9);
+}
+
+TEST(PoolingAllocatorTest, Large) {
+  PoolingAllocator<double> allocator;
+  auto& pool = BlockPool::ForSize(BlockPool::max_block_size);
+  std::int64_t const pooled_blocks = pool.number_of_pooled_blocks();
+  double* const p = allocator.allocate(BlockPool::max_block_size);
+  p[BlockPool::max_block_size - 1] = 123;
+  allocator.deallocate(p, BlockPool::max_block_size);
+  EXPECT_THAT(pool.number_of_pooled_blocks(), Eq(pooled_blocks));
+}
+
+TEST(PoolingAllocatorTest, SizeClasses) {
+  EXPECT_THAT(BlockPool::ForSize(1).block_size(), Eq(64));
+  EXPECT_THAT(BlockPool::ForSize(64).block_size(), Eq(64));
+  EXPECT_THAT(BlockPool::ForSize(65).block_size(), Eq(128));
+  EXPECT_THAT(&BlockPool::ForSize(100), Eq(&BlockPool::ForSize(128)));
+  EXPECT_THAT(BlockPool::ForSize(BlockPool::max_block_size).block_size(),
+              Eq(BlockPool::max_block_size));
+}
+
+TEST(PoolingAllocatorTest, Conversion) {
+  // This is required by some containers.
+  PoolingAllocator<int> foo;
+  PoolingAllocator<float> bar(foo);
+  EXPECT_TRUE(foo == bar);
+}
+
+TEST(PoolingAllocatorTest, BTree) {
+  using Set = absl::btree_set<int, std::less<int>, PoolingAllocator<int>>;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([]() {
+      std::vector<int> expected;
+      for (int j = 0; j < 10; ++j) {
+        Set set;
+        expected.clear();
+        for (int k = 0; k < 10'000; ++k) {
+          set.insert(k);
+          expected.push_back(k);
+        }
+        EXPECT_THAT(set, ElementsAreArray(expected));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Destroying the sets returned their nodes to the pools.
+  std::int64_t number_of_pooled_blocks = 0;
+  for (std::size_t size = BlockPool::block_size_granularity;
+       size <= BlockPool::max_block_size;
+       size += BlockPool::block_size_granularity) {
+    number_of_pooled_blocks +=
+        BlockPool::ForSize(size).number_of_pooled_blocks();
+  }
+  EXPECT_THAT(number_of_pooled_blocks, Ge(10'000 / 256));
+}
+
+}  // namespace base
+}  // namespace principia
@@ -1,15 +1,18 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "base/array.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "gipfeli/compression.h"
 #include "google/protobuf/io/zero_copy_stream.h"
 #include "google/protobuf/message.h"
@@ -21,6 +24,7 @@ namespace internal {
 
 using namespace principia::base::_array;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 
 using ::google::compression::Compressor;
 
@@ -71,6 +75,15 @@ class PullSerializer final {
   PullSerializer(int chunk_size,
                  int number_of_chunks,
                  std::unique_ptr<Compressor> compressor);
+  // Same as above, but the chunks are compressed concurrently by
+  // |compressors.size()| workers, each using its own element of |compressors|.
+  // The chunks are still returned by |Pull| in order.  If |compressors| is
+  // empty the chunks are not compressed.  The memory bound above holds
+  // irrespective of the number of workers, but at most
+  // |(number_of_chunks - 2) / 2| chunks may be compressed concurrently.
+  PullSerializer(int chunk_size,
+                 int number_of_chunks,
+                 std::vector<std::unique_ptr<Compressor>> compressors);
   ~PullSerializer();
 
   // Starts the serializer, which will proceed to serialize |message|.  This
@@ -96,12 +109,24 @@ class PullSerializer final {
   // underlying |DelegatingArrayOutputStream|.
   Array<std::uint8_t> Push(Array<std::uint8_t> bytes);
 
+  // A chunk held in the |queue_|.  |bytes| may only be returned by |Pull| once
+  // |ready| is true, i.e., once its compression has completed.
+  struct Chunk {
+    Array<std::uint8_t> bytes;
+    bool ready;
+  };
+
+  static std::vector<std::unique_ptr<Compressor>> MakeCompressors(
+      std::unique_ptr<Compressor> compressor);
+
   // |owned_message_| is null if this object doesn't own the message.
   // |message_| is non-null after Start.
   std::unique_ptr<google::protobuf::Message const> owned_message_;
   google::protobuf::Message const* message_ = nullptr;
 
-  std::unique_ptr<Compressor> const compressor_;
+  // The compressors passed at construction, empty in the absence of
+  // compression.
+  std::vector<std::unique_ptr<Compressor>> const compressors_;
 
   // The chunk size passed at construction.  The stream outputs chunks of that
   // size.
@@ -115,10 +140,6 @@ class PullSerializer final {
   // The number of chunks passed at construction, used to size |data_|.
   int const number_of_chunks_;
 
-  // How many of the |number_of_chunks_| chunks in |data_| are reserved for
-  // compression.
-  int const number_of_compression_chunks_;
-
   // The array supporting the stream and the stream itself.
   std::unique_ptr<std::uint8_t[]> data_;
   DelegatingArrayOutputStream stream_;
@@ -128,17 +149,30 @@ class PullSerializer final {
 
   absl::Mutex lock_;
 
-  // The |queue_| contains the |Array<std::uint8_t>| objects filled by |Push|
-  // and not yet consumed by |Pull|.  If a |Array<std::uint8_t>| object has been
+  // The |queue_| contains the |Chunk| objects filled by |Push| and not yet
+  // consumed by |Pull|, in the order of the stream.  If a |Chunk| has been
   // handed over to the caller by |Pull| it stays in the queue until the next
   // call to |Pull|, to make sure that the pointer is not reused while the
-  // caller processes it.
-  std::queue<Array<std::uint8_t>> queue_ GUARDED_BY(lock_);
+  // caller processes it.  This is a deque because the compression workers hold
+  // references to their |Chunk|, which must not be invalidated by the
+  // insertion of further chunks.
+  std::deque<Chunk> queue_ GUARDED_BY(lock_);
 
   // The |free_| queue contains the start addresses of chunks that are not yet
   // ready to be returned by |Pull|.  That includes the chunk currently being
-  // filled by the stream.
+  // filled by the stream, but not the chunks being compressed.
   std::queue<not_null<std::uint8_t*>> free_ GUARDED_BY(lock_);
+
+  // The number of chunks whose uncompressed bytes are being read by a
+  // compression worker.  These chunks are neither in |queue_| nor in |free_|.
+  int compressing_ GUARDED_BY(lock_) = 0;
+
+  // The elements of |compressors_| that are not used by a compression worker.
+  std::vector<not_null<Compressor*>> idle_compressors_ GUARDED_BY(lock_);
+
+  // The compression workers, null if there are fewer than two compressors, in
+  // which case the compression happens on the serialization thread.
+  std::unique_ptr<ThreadPool<void>> compression_pool_;
 };
 
 }  // namespace internal
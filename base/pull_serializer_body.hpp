@@ -68,20 +68,37 @@ inline std::int64_t DelegatingArrayOutputStream::ByteCount() const {
 inline PullSerializer::PullSerializer(int const chunk_size,
                                       int const number_of_chunks,
                                       std::unique_ptr<Compressor> compressor)
-    : compressor_(std::move(compressor)),
+    : PullSerializer(chunk_size,
+                     number_of_chunks,
+                     MakeCompressors(std::move(compressor))) {}
+
+inline PullSerializer::PullSerializer(
+    int const chunk_size,
+    int const number_of_chunks,
+    std::vector<std::unique_ptr<Compressor>> compressors)
+    : compressors_(std::move(compressors)),
       chunk_size_(chunk_size),
       compressed_chunk_size_(
-          compressor_ == nullptr
+          compressors_.empty()
               ? chunk_size_
-              : compressor_->MaxCompressedLength(chunk_size_)),
+              : compressors_.front()->MaxCompressedLength(chunk_size_)),
       number_of_chunks_(number_of_chunks),
-      number_of_compression_chunks_(compressor_ == nullptr ? 0 : 1),
       data_(std::make_unique<std::uint8_t[]>(compressed_chunk_size_ *
                                              number_of_chunks_)),
       stream_(Array<std::uint8_t>(data_.get(), chunk_size_),
-              std::bind(&PullSerializer::Push, this, _1)) {
-  // Check the compatibility of the wait conditions in Push and Pull.
-  CHECK_GT(number_of_chunks_ - number_of_compression_chunks_ - 1, 1);
+              std::bind(&PullSerializer::Push, this, _1)),
+      compression_pool_(compressors_.size() > 1
+                            ? std::make_unique<ThreadPool<void>>(
+                                  compressors_.size())
+                            : nullptr) {
+  // Check the compatibility of the wait conditions in Push and Pull.  In the
+  // presence of compression, one chunk is needed to hold the compressed bytes.
+  int const number_of_compression_chunks = compressors_.empty() ? 0 : 1;
+  CHECK_GT(number_of_chunks_ - number_of_compression_chunks - 1, 1);
+  for (auto const& compressor : compressors_) {
+    CHECK(compressor != nullptr);
+    idle_compressors_.push_back(compressor.get());
+  }
 
   // Mark all the chunks as free except the last one which is a sentinel for the
   // |queue_|.  The 0th chunk has been passed to the stream, but it's still free
@@ -91,14 +108,21 @@ inline PullSerializer::PullSerializer(int const chunk_size,
   for (int i = 0; i < number_of_chunks_ - 1; ++i) {
     free_.push(data_.get() + i * compressed_chunk_size_);
   }
-  queue_.push(Array<std::uint8_t>(
-      data_.get() + (number_of_chunks_ - 1) * compressed_chunk_size_, 0));
+  queue_.push_back(
+      {.bytes = Array<std::uint8_t>(
+           data_.get() + (number_of_chunks_ - 1) * compressed_chunk_size_, 0),
+       .ready = true});
 }
 
 inline PullSerializer::~PullSerializer() {
   if (thread_ != nullptr) {
     thread_->join();
   }
+  // The compression workers may still be running if the client didn't pull all
+  // the chunks.
+  absl::MutexLock l(&lock_);
+  auto const compression_done = [this]() { return compressing_ == 0; };
+  lock_.Await(absl::Condition(&compression_done));
 }
 
 inline void PullSerializer::Start(
@@ -131,15 +155,18 @@ inline Array<std::uint8_t> PullSerializer::Pull() {
     absl::MutexLock l(&lock_);
 
     // The element at the front of the queue is the one that was last returned
-    // by |Pull| and must be dropped and freed.
-    auto const queue_has_elements = [this]() { return queue_.size() > 1; };
-    lock_.Await(absl::Condition(&queue_has_elements));
+    // by |Pull| and must be dropped and freed.  The next one may still be
+    // being compressed.
+    auto const next_chunk_is_ready = [this]() {
+      return queue_.size() > 1 && queue_[1].ready;
+    };
+    lock_.Await(absl::Condition(&next_chunk_is_ready));
 
     CHECK_LE(2, queue_.size());
-    free_.push(queue_.front().data);
-    queue_.pop();
-    result = queue_.front();
-    CHECK_EQ(number_of_chunks_, queue_.size() + free_.size());
+    free_.push(queue_.front().bytes.data);
+    queue_.pop_front();
+    result = queue_.front().bytes;
+    CHECK_EQ(number_of_chunks_, queue_.size() + free_.size() + compressing_);
   }
   return result;
 }
@@ -147,48 +174,82 @@ inline Array<std::uint8_t> PullSerializer::Pull() {
 inline Array<std::uint8_t> PullSerializer::Push(Array<std::uint8_t> bytes) {
   Array<std::uint8_t> result;
   CHECK_GE(chunk_size_, bytes.size);
-  if (bytes.size > 0 && compressor_ != nullptr) {
+  if (bytes.size > 0 && !compressors_.empty()) {
     Array<std::uint8_t> compressed_bytes;
+    Chunk* compressed_chunk;
+    Compressor* compressor;
     {
       absl::MutexLock l(&lock_);
-      CHECK_LE(1 + number_of_compression_chunks_, free_.size());
+
+      // In addition to |bytes|, we need a free chunk to hold the compressed
+      // bytes and another one to be filled next.
+      auto const can_compress = [this]() {
+        return free_.size() >= 3 && !idle_compressors_.empty();
+      };
+      lock_.Await(absl::Condition(&can_compress));
+
+      // We maintain the invariant that the chunk being filled is at the front
+      // of the |free_| queue.  While it is being compressed, it belongs to
+      // neither queue.
+      CHECK_EQ(free_.front(), bytes.data);
       free_.pop();
+      ++compressing_;
       compressed_bytes =
           Array<std::uint8_t>(free_.front(), compressed_chunk_size_);
-      free_.push(bytes.data);
+      free_.pop();
+      compressed_chunk = &queue_.emplace_back(
+          Chunk{.bytes = Array<std::uint8_t>(compressed_bytes.data, 0),
+                .ready = false});
+      compressor = idle_compressors_.back();
+      idle_compressors_.pop_back();
+      result = Array<std::uint8_t>(free_.front(), chunk_size_);
+      CHECK_EQ(number_of_chunks_,
+               queue_.size() + free_.size() + compressing_);
     }
-    // We maintain the invariant that the chunk being filled is at the front of
-    // the |free_| queue.
-    ArraySource<std::uint8_t> source(bytes);
-    ArraySink<std::uint8_t> sink(compressed_bytes);
-    compressor_->CompressStream(&source, &sink);
-    {
-      absl::MutexLock l(&lock_);
-      bytes = sink.array();
+    auto compress = [this, bytes, compressed_bytes, compressed_chunk,
+                     compressor]() {
+      ArraySource<std::uint8_t> source(bytes);
+      ArraySink<std::uint8_t> sink(compressed_bytes);
+      compressor->CompressStream(&source, &sink);
+      {
+        absl::MutexLock l(&lock_);
+        compressed_chunk->bytes = sink.array();
+        compressed_chunk->ready = true;
+        free_.push(bytes.data);
+        --compressing_;
+        idle_compressors_.push_back(compressor);
+      }
+    };
+    if (compression_pool_ == nullptr) {
+      compress();
+    } else {
+      compression_pool_->Add(std::move(compress));
     }
-  }
-  {
+  } else {
     absl::MutexLock l(&lock_);
 
-    auto const queue_has_room = [this]() {
-      // -1 here is because we want to ensure that there is an entry in the
-      // free list, in addition to |result| and to
-      // |number_of_compression_chunks_| (if present).
-      return queue_.size() < static_cast<std::size_t>(number_of_chunks_) -
-                                 number_of_compression_chunks_ - 1;
-    };
-    lock_.Await(absl::Condition(&queue_has_room));
+    // In addition to |bytes|, we need a free chunk to be filled next.
+    auto const has_free_chunk = [this]() { return free_.size() >= 2; };
+    lock_.Await(absl::Condition(&has_free_chunk));
 
-    queue_.emplace(bytes.data, bytes.size);
-    CHECK_LE(2 + number_of_compression_chunks_, free_.size());
     CHECK_EQ(free_.front(), bytes.data);
     free_.pop();
+    queue_.push_back({.bytes = bytes, .ready = true});
     result = Array<std::uint8_t>(free_.front(), chunk_size_);
-    CHECK_EQ(number_of_chunks_, queue_.size() + free_.size());
+    CHECK_EQ(number_of_chunks_, queue_.size() + free_.size() + compressing_);
   }
   return result;
 }
 
+inline std::vector<std::unique_ptr<Compressor>>
+PullSerializer::MakeCompressors(std::unique_ptr<Compressor> compressor) {
+  std::vector<std::unique_ptr<Compressor>> compressors;
+  if (compressor != nullptr) {
+    compressors.push_back(std::move(compressor));
+  }
+  return compressors;
+}
+
 }  // namespace internal
 }  // namespace _pull_serializer
 }  // namespace base
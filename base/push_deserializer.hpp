@@ -1,16 +1,19 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <ostream>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "base/array.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "gipfeli/compression.h"
 #include "google/protobuf/io/zero_copy_stream.h"
 #include "google/protobuf/message.h"
@@ -22,6 +25,7 @@ namespace internal {
 
 using namespace principia::base::_array;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 
 using ::google::compression::Compressor;
 
@@ -73,6 +77,15 @@ class PushDeserializer final {
   PushDeserializer(int chunk_size,
                    int number_of_chunks,
                    std::unique_ptr<Compressor> compressor);
+  // Same as above, but the chunks are uncompressed concurrently by
+  // |compressors.size()| workers, each using its own element of |compressors|,
+  // as soon as they are pushed.  The stream still consumes them in order.  If
+  // |compressors| is empty the chunks are not uncompressed.  This class then
+  // uses an additional |compressors.size() * chunk_size| bytes to hold the
+  // uncompressed chunks.
+  PushDeserializer(int chunk_size,
+                   int number_of_chunks,
+                   std::vector<std::unique_ptr<Compressor>> compressors);
   ~PushDeserializer();
 
   // Starts the deserializer, which will proceed to deserialize data into
@@ -103,12 +116,25 @@ class PushDeserializer final {
   // |DelegatingArrayOutputStream|.
   Array<std::uint8_t> Pull();
 
+  // A chunk held in the |queue_|.  |bytes| may only be consumed by |Pull| once
+  // |ready| is true.  With an |uncompression_pool_|, that happens once a worker
+  // has uncompressed them into |uncompressed_data_|.
+  struct Chunk {
+    Array<std::uint8_t> bytes;
+    bool ready;
+  };
+
+  static std::vector<std::unique_ptr<Compressor>> MakeCompressors(
+      std::unique_ptr<Compressor> compressor);
+
   // |owned_message_| is null if this object doesn't own the message.
   // |message_| is non-null after Start.
   std::unique_ptr<google::protobuf::Message> owned_message_;
   google::protobuf::Message* message_ = nullptr;
 
-  std::unique_ptr<Compressor> const compressor_;
+  // The compressors passed at construction, empty in the absence of
+  // compression.
+  std::vector<std::unique_ptr<Compressor>> const compressors_;
 
   // The chunk size passed at construction.  The stream consumes chunks of that
   // size.
@@ -122,6 +148,11 @@ class PushDeserializer final {
   // The number of chunks passed at construction, used to size |data_|.
   int const number_of_chunks_;
 
+  // Without an |uncompression_pool_|, a single chunk where |Pull| uncompresses
+  // the data.  With an |uncompression_pool_|, |compressors_.size() + 1| chunks
+  // where the workers uncompress the data: one for each chunk being
+  // uncompressed or waiting in |queue_|, and one for the chunk being consumed
+  // by the stream.
   UniqueArray<std::uint8_t> uncompressed_data_;
 
   DelegatingArrayInputStream stream_;
@@ -129,13 +160,29 @@ class PushDeserializer final {
 
   absl::Mutex lock_;
 
-  // The |queue_| contains the |Array<std::uint8_t>| object filled by |Push| and
-  // not yet consumed by |Pull|.  The |done_| queue contains the callbacks.  The
-  // two queues are out of step: an element is removed from |queue_| by |Pull|
-  // when it returns a chunk to the stream, but the corresponding callback is
-  // removed from |done_| (and executed) when |Pull| returns.
-  std::queue<Array<std::uint8_t>> queue_ GUARDED_BY(lock_);
+  // The |queue_| contains the |Chunk| objects filled by |Push| and not yet
+  // consumed by |Pull|.  The |done_| queue contains the callbacks.  The two
+  // queues are out of step: an element is removed from |queue_| by |Pull| when
+  // it returns a chunk to the stream, but the corresponding callback is removed
+  // from |done_| (and executed) when |Pull| returns.  |queue_| is a deque
+  // because the uncompression workers hold references to their |Chunk|, which
+  // must not be invalidated by the insertion of further chunks.
+  std::deque<Chunk> queue_ GUARDED_BY(lock_);
   std::queue<std::function<void()>> done_ GUARDED_BY(lock_);
+
+  // The start addresses of the chunks of |uncompressed_data_| that are not
+  // used, only relevant with an |uncompression_pool_|.  The chunk last returned
+  // by |Pull|, if any, is |consumed_|; it is freed by the next call to |Pull|.
+  std::vector<not_null<std::uint8_t*>> free_ GUARDED_BY(lock_);
+  std::uint8_t* consumed_ GUARDED_BY(lock_) = nullptr;
+
+  // The elements of |compressors_| that are not used by an uncompression
+  // worker.
+  std::vector<not_null<Compressor*>> idle_compressors_ GUARDED_BY(lock_);
+
+  // The uncompression workers, null if there are fewer than two compressors,
+  // in which case the uncompression happens in |Pull|.
+  std::unique_ptr<ThreadPool<void>> uncompression_pool_;
 };
 
 }  // namespace internal
@@ -110,17 +110,41 @@ inline PushDeserializer::PushDeserializer(
     int const chunk_size,
     int const number_of_chunks,
     std::unique_ptr<Compressor> compressor)
-    : compressor_(std::move(compressor)),
+    : PushDeserializer(chunk_size,
+                       number_of_chunks,
+                       MakeCompressors(std::move(compressor))) {}
+
+inline PushDeserializer::PushDeserializer(
+    int const chunk_size,
+    int const number_of_chunks,
+    std::vector<std::unique_ptr<Compressor>> compressors)
+    : compressors_(std::move(compressors)),
       chunk_size_(chunk_size),
       compressed_chunk_size_(
-          compressor_ == nullptr
+          compressors_.empty()
               ? chunk_size_
-              : compressor_->MaxCompressedLength(chunk_size_)),
+              : compressors_.front()->MaxCompressedLength(chunk_size_)),
       number_of_chunks_(number_of_chunks),
-      uncompressed_data_(chunk_size_),
-      stream_(std::bind(&PushDeserializer::Pull, this)) {
+      uncompressed_data_(
+          compressors_.size() > 1 ? (compressors_.size() + 1) * chunk_size_
+                                  : chunk_size_),
+      stream_(std::bind(&PushDeserializer::Pull, this)),
+      uncompression_pool_(compressors_.size() > 1
+                              ? std::make_unique<ThreadPool<void>>(
+                                    compressors_.size())
+                              : nullptr) {
   // This sentinel ensures that the two queues are correctly out of step.
   done_.push(nullptr);
+  for (auto const& compressor : compressors_) {
+    CHECK(compressor != nullptr);
+    idle_compressors_.push_back(compressor.get());
+  }
+  if (uncompression_pool_ != nullptr) {
+    std::int64_t const number_of_buffers = compressors_.size() + 1;
+    for (std::int64_t i = 0; i < number_of_buffers; ++i) {
+      free_.push_back(uncompressed_data_.data.get() + i * chunk_size_);
+    }
+  }
 }
 
 inline PushDeserializer::~PushDeserializer() {
@@ -180,7 +204,7 @@ inline void PushDeserializer::Push(Array<std::uint8_t> const bytes,
   // absence of compression we have a stream so we can cut into as many chunks
   // as we like.
   int queued_chunk_size;
-  if (compressor_ == nullptr) {
+  if (compressors_.empty()) {
     queued_chunk_size = chunk_size_;
   } else {
     CHECK_LE(bytes.size, compressed_chunk_size_);
@@ -189,8 +213,11 @@ inline void PushDeserializer::Push(Array<std::uint8_t> const bytes,
 
   bool is_last;
   do {
-    {
-      is_last = current.size <= queued_chunk_size;
+    is_last = current.size <= queued_chunk_size;
+    Array<std::uint8_t> const chunk(
+        current.data,
+        std::min(current.size, static_cast<std::int64_t>(queued_chunk_size)));
+    if (uncompression_pool_ == nullptr || chunk.size == 0) {
       absl::MutexLock l(&lock_);
 
       auto const queue_has_room = [this]() {
@@ -198,10 +225,46 @@ inline void PushDeserializer::Push(Array<std::uint8_t> const bytes,
       };
       lock_.Await(absl::Condition(&queue_has_room));
 
-      queue_.emplace(current.data,
-                     std::min(current.size,
-                              static_cast<std::int64_t>(queued_chunk_size)));
+      queue_.push_back({.bytes = chunk, .ready = true});
       done_.emplace(is_last ? std::move(done) : nullptr);
+    } else {
+      // Hand the chunk over to a worker, which uncompresses it into a free
+      // chunk of |uncompressed_data_|.
+      Array<std::uint8_t> uncompressed_bytes;
+      Chunk* uncompressed_chunk;
+      Compressor* compressor;
+      {
+        absl::MutexLock l(&lock_);
+
+        auto const can_uncompress = [this]() {
+          return queue_.size() < static_cast<std::size_t>(number_of_chunks_) &&
+                 !free_.empty() && !idle_compressors_.empty();
+        };
+        lock_.Await(absl::Condition(&can_uncompress));
+
+        uncompressed_bytes = Array<std::uint8_t>(free_.back(), chunk_size_);
+        free_.pop_back();
+        uncompressed_chunk =
+            &queue_.emplace_back(Chunk{.bytes = chunk, .ready = false});
+        done_.emplace(is_last ? std::move(done) : nullptr);
+        compressor = idle_compressors_.back();
+        idle_compressors_.pop_back();
+      }
+      uncompression_pool_->Add([this,
+                                chunk,
+                                uncompressed_bytes,
+                                uncompressed_chunk,
+                                compressor]() {
+        ArraySource<std::uint8_t> source(chunk);
+        ArraySink<std::uint8_t> sink(uncompressed_bytes);
+        CHECK(compressor->UncompressStream(&source, &sink));
+        {
+          absl::MutexLock l(&lock_);
+          uncompressed_chunk->bytes = sink.array();
+          uncompressed_chunk->ready = true;
+          idle_compressors_.push_back(compressor);
+        }
+      });
     }
     current.data = &current.data[queued_chunk_size];
     current.size -= queued_chunk_size;
@@ -220,33 +283,52 @@ inline Array<std::uint8_t> PushDeserializer::Pull() {
   {
     absl::MutexLock l(&lock_);
 
-    auto const queue_has_elements =  [this]() { return !queue_.empty(); };
-    lock_.Await(absl::Condition(&queue_has_elements));
+    auto const front_is_ready = [this]() {
+      return !queue_.empty() && queue_.front().ready;
+    };
+    lock_.Await(absl::Condition(&front_is_ready));
 
     // The front of |done_| is the callback for the |Array<std::uint8_t>| object
-    // that was just processed.  Run it now.
+    // that was just processed.  Run it now, and free the chunk where it was
+    // uncompressed, if any.
     CHECK(!done_.empty());
     auto const done = done_.front();
     if (done != nullptr) {
       done();
     }
     done_.pop();
+    if (consumed_ != nullptr) {
+      free_.push_back(consumed_);
+      consumed_ = nullptr;
+    }
     // Get the next |Array<std::uint8_t>| object to process and remove it from
     // |queue_|.  Uncompress it if needed.
-    auto const& front = queue_.front();
-    if (front.size == 0 || compressor_ == nullptr) {
+    auto const& front = queue_.front().bytes;
+    if (front.size == 0 || compressors_.empty()) {
       result = front;
-    } else {
+    } else if (uncompression_pool_ == nullptr) {
       ArraySource<std::uint8_t> source(front);
       ArraySink<std::uint8_t> sink(uncompressed_data_.get());
-      CHECK(compressor_->UncompressStream(&source, &sink));
+      CHECK(compressors_.front()->UncompressStream(&source, &sink));
       result = sink.array();
+    } else {
+      result = front;
+      consumed_ = front.data;
     }
-    queue_.pop();
+    queue_.pop_front();
   }
   return result;
 }
 
+inline std::vector<std::unique_ptr<Compressor>>
+PushDeserializer::MakeCompressors(std::unique_ptr<Compressor> compressor) {
+  std::vector<std::unique_ptr<Compressor>> compressors;
+  if (compressor != nullptr) {
+    compressors.push_back(std::move(compressor));
+  }
+  return compressors;
+}
+
 }  // namespace internal
 }  // namespace _push_deserializer
 }  // namespace base
@@ -118,6 +118,50 @@ class PushDeserializerTest : public ::testing::Test {
   void TestSerializationDeserialization(
       std::unique_ptr<Compressor> serializer_compressor,
       std::unique_ptr<Compressor> deserializer_compressor) {
+    RunSerializationDeserialization(
+        [&serializer_compressor]() {
+          return std::make_unique<PullSerializer>(
+              serializer_chunk_size,
+              /*number_of_chunks=*/4,
+              std::move(serializer_compressor));
+        },
+        [&deserializer_compressor]() {
+          return std::make_unique<PushDeserializer>(
+              deserializer_chunk_size,
+              number_of_chunks,
+              std::move(deserializer_compressor));
+        });
+  }
+
+  // Same as above, but with the given number of compression workers on each
+  // side.
+  void TestParallelSerializationDeserialization(
+      int const number_of_compressors) {
+    auto const compressors = [number_of_compressors]() {
+      std::vector<std::unique_ptr<Compressor>> result;
+      for (int i = 0; i < number_of_compressors; ++i) {
+        result.push_back(google::compression::NewGipfeliCompressor());
+      }
+      return result;
+    };
+    RunSerializationDeserialization(
+        [&compressors]() {
+          return std::make_unique<PullSerializer>(serializer_chunk_size,
+                                                  /*number_of_chunks=*/8,
+                                                  compressors());
+        },
+        [&compressors]() {
+          return std::make_unique<PushDeserializer>(deserializer_chunk_size,
+                                                    number_of_chunks,
+                                                    compressors());
+        });
+  }
+
+  void RunSerializationDeserialization(
+      std::function<std::unique_ptr<PullSerializer>()> const&
+          make_pull_serializer,
+      std::function<std::unique_ptr<PushDeserializer>()> const&
+          make_push_deserializer) {
     auto const trajectory = BuildTrajectory();
     int const byte_size = trajectory->ByteSize();
     for (int i = 0; i < runs_per_test; ++i) {
@@ -126,15 +170,8 @@ class PushDeserializerTest : public ::testing::Test {
       auto storage = std::make_unique<std::uint8_t[]>(byte_size);
       std::uint8_t* data = &storage[0];
 
-      pull_serializer_ =
-          std::make_unique<PullSerializer>(serializer_chunk_size,
-                                           /*number_of_chunks=*/4,
-                                           std::move(serializer_compressor));
-      push_deserializer_ =
-          std::make_unique<PushDeserializer>(
-              deserializer_chunk_size,
-              number_of_chunks,
-              std::move(deserializer_compressor));
+      pull_serializer_ = make_pull_serializer();
+      push_deserializer_ = make_push_deserializer();
 
       pull_serializer_->Start(std::move(written_trajectory));
       push_deserializer_->Start(std::move(read_trajectory),
@@ -313,6 +350,11 @@ TEST_F(PushDeserializerTest, SerializationDeserialization) {
       /*deserializer_compressor=*/google::compression::NewGipfeliCompressor());
 }
 
+TEST_F(PushDeserializerTest, ParallelCompression) {
+  TestParallelSerializationDeserialization(/*number_of_compressors=*/1);
+  TestParallelSerializationDeserialization(/*number_of_compressors=*/3);
+}
+
 // Check that deserialization fails if we stomp on one extra byte.
 TEST_F(PushDeserializerDeathTest, Stomp) {
   EXPECT_DEATH({
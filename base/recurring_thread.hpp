@@ -2,13 +2,17 @@
 
 #include <chrono>
 #include <functional>
+#include <list>
+#include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
 #include "base/jthread.hpp"
+#include "base/not_null.hpp"
 
 namespace principia {
 namespace base {
@@ -16,6 +20,80 @@ namespace _recurring_thread {
 namespace internal {
 
 using namespace principia::base::_jthread;
+using namespace principia::base::_not_null;
+
+class BaseRecurringThread;
+
+// A bounded set of worker threads shared by many recurring threads.  Instead of
+// running on a thread of its own, a recurring thread constructed with a
+// scheduler is executed as a task by one of the workers whenever it has input.
+// The tasks are picked in decreasing order of priority and, for the same
+// priority, in the order in which they became eligible for execution.  The
+// number of workers that execute Background tasks may be capped, so that an
+// Interactive task doesn't wait for long Background tasks to complete.  The
+// scheduler must outlive the recurring threads that use it.  This class is
+// thread-safe.
+class RecurringThreadScheduler final {
+ public:
+  enum class Priority {
+    // For work that may be deferred, e.g., reanimation.
+    Background = 0,
+    // For work whose result is awaited by the user, e.g., prognostication.
+    Interactive = 1,
+  };
+
+  // Constructs a scheduler with the given number of workers, at most
+  // |max_background_workers| of which execute Background tasks at any time.
+  RecurringThreadScheduler(int workers, int max_background_workers);
+
+  // Constructs a scheduler with the given number of workers, all of which may
+  // execute Background tasks.
+  explicit RecurringThreadScheduler(int workers);
+
+  ~RecurringThreadScheduler();
+
+ private:
+  struct Task {
+    not_null<BaseRecurringThread*> thread;
+    Priority priority;
+    // The task may not run again before this time, to honour the period of the
+    // recurring thread.
+    std::chrono::steady_clock::time_point earliest_run;
+    // Set iff the task is executing on a worker.
+    std::unique_ptr<StoppableTask> execution;
+  };
+
+  // Adds the |thread| to the tasks of this scheduler; idempotent.
+  void Register(not_null<BaseRecurringThread*> thread, Priority priority);
+  // Removes the |thread| from the tasks of this scheduler, stopping and
+  // awaiting its execution if needed; idempotent.
+  void Unregister(not_null<BaseRecurringThread*> thread);
+  // Changes the priority of the |thread| if it is registered.  An execution
+  // that is in progress is not affected.
+  void SetPriority(not_null<BaseRecurringThread*> thread, Priority priority);
+  // Wakes up a worker because the input of a thread changed.
+  void Notify();
+
+  // The loop executed by each worker.
+  void Work();
+
+  // The maximum time a worker sleeps when there is no task to execute, chosen
+  // to match the period of the recurring threads of the plugin.
+  static constexpr std::chrono::milliseconds max_idle_time_{20};
+
+  int const max_background_workers_;
+
+  absl::Mutex lock_;
+  bool notified_ GUARDED_BY(lock_) = false;
+  bool shutdown_ GUARDED_BY(lock_) = false;
+  std::list<Task> tasks_ GUARDED_BY(lock_);
+  // The number of workers currently executing a Background task.
+  int background_workers_ GUARDED_BY(lock_) = 0;
+
+  std::vector<jthread> workers_;
+
+  friend class BaseRecurringThread;
+};
 
 // A stoppable thread that supports cyclical execution of an action.  It is
 // connected to two monodirectional channels that can (optionally) hold a value
@@ -25,7 +103,9 @@ using namespace principia::base::_jthread;
 // the various template specializations and should not be used directly.
 class BaseRecurringThread {
  public:
-  virtual ~BaseRecurringThread() = default;
+  using Priority = RecurringThreadScheduler::Priority;
+
+  virtual ~BaseRecurringThread();
 
   // Starts or stops the thread.  These functions are idempotent.  Note that the
   // thread is also stopped by the destruction of this object.
@@ -35,23 +115,49 @@ class BaseRecurringThread {
   // Stop followed by Start, atomically.
   void Restart();
 
+  // Changes the priority with which the action is executed by the scheduler.
+  // Has no effect if this object doesn't use a scheduler.
+  void SetPriority(Priority priority);
+
  protected:
   // Constructs a stoppable thread that runs no more frequently than at the
-  // specified |period| (and less frequently if no input was provided).  At
-  // construction the thread is in the stopped state.
-  explicit BaseRecurringThread(std::chrono::milliseconds period);
+  // specified |period| (and less frequently if no input was provided).  The
+  // thread sleeps while it has no input, and is woken up by |InputAvailable|.  If
+  // |scheduler| is not null, the action is executed by the workers of the
+  // |scheduler| with the given |priority| instead of on a thread owned by this
+  // object.  At construction the thread is in the stopped state.
+  BaseRecurringThread(std::chrono::milliseconds period,
+                      RecurringThreadScheduler* scheduler,
+                      Priority priority);
 
   // Repeatedly calls RunAction no more frequently than at the specified period.
   absl::Status RepeatedlyRunAction();
 
+  // Called by subclasses when input is put in the input channel.
+  void InputAvailable();
+
   // Overidden by subclasses to actually run the action.
   virtual absl::Status RunAction() = 0;
 
+  // Overidden by subclasses to indicate whether the input channel holds a
+  // value.
+  virtual bool HasInput() = 0;
+
  private:
   std::chrono::milliseconds const period_;
+  RecurringThreadScheduler* const scheduler_;
+
+  // Used by the thread owned by this object to sleep until it has input or
+  // is asked to stop.
+  absl::Mutex wake_up_lock_;
+  bool input_available_ GUARDED_BY(wake_up_lock_) = false;
+  bool stop_requested_ GUARDED_BY(wake_up_lock_) = false;
 
   absl::Mutex jthread_lock_;
+  Priority priority_ GUARDED_BY(jthread_lock_);
   jthread jthread_ GUARDED_BY(jthread_lock_);
+
+  friend class RecurringThreadScheduler;
 };
 
 // A template for an action that returns a value.
@@ -63,9 +169,14 @@ class RecurringThread : public BaseRecurringThread {
 
   // Constructs a stoppable thread that executes the given |action| no more
   // frequently than at the specified |period| (and less frequently if no input
-  // was provided).  At construction the thread is in the stopped state.
+  // was provided).  If |scheduler| is not null, the |action| is executed by its
+  // workers.  At construction the thread is in the stopped state.
   RecurringThread(Action action,
-                  std::chrono::milliseconds period);
+                  std::chrono::milliseconds period,
+                  RecurringThreadScheduler* scheduler = nullptr,
+                  Priority priority = Priority::Background);
+
+  ~RecurringThread() override;
 
   // Overwrites the contents of the input channel.  The |input| data will be
   // either picked by the next execution of |action|, or overwritten by the next
@@ -77,6 +188,7 @@ class RecurringThread : public BaseRecurringThread {
 
  private:
   absl::Status RunAction() override;
+  bool HasInput() override;
 
   Action const action_;
 
@@ -93,9 +205,14 @@ class RecurringThread<Input, void> : public BaseRecurringThread {
 
   // Constructs a stoppable thread that executes the given |action| no more
   // frequently than at the specified |period| (and less frequently if no input
-  // was provided).  At construction the thread is in the stopped state.
+  // was provided).  If |scheduler| is not null, the |action| is executed by its
+  // workers.  At construction the thread is in the stopped state.
   RecurringThread(Action action,
-                  std::chrono::milliseconds period);
+                  std::chrono::milliseconds period,
+                  RecurringThreadScheduler* scheduler = nullptr,
+                  Priority priority = Priority::Background);
+
+  ~RecurringThread() override;
 
   // Overwrites the contents of the input channel.  The |input| data will be
   // either picked by the next execution of |action|, or overwritten by the next
@@ -104,6 +221,7 @@ class RecurringThread<Input, void> : public BaseRecurringThread {
 
  private:
   absl::Status RunAction() override;
+  bool HasInput() override;
 
   Action const action_;
 
@@ -114,6 +232,7 @@ class RecurringThread<Input, void> : public BaseRecurringThread {
 }  // namespace internal
 
 using internal::RecurringThread;
+using internal::RecurringThreadScheduler;
 
 }  // namespace _recurring_thread
 }  // namespace base
@@ -3,16 +3,167 @@
 #include "base/recurring_thread.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <memory>
 #include <utility>
 
+#include "absl/time/time.h"
+#include "glog/logging.h"
+
 namespace principia {
 namespace base {
 namespace _recurring_thread {
 namespace internal {
 
+inline RecurringThreadScheduler::RecurringThreadScheduler(
+    int const workers,
+    int const max_background_workers)
+    : max_background_workers_(max_background_workers) {
+  CHECK_LT(0, max_background_workers);
+  CHECK_LE(max_background_workers, workers);
+  for (int i = 0; i < workers; ++i) {
+    workers_.push_back(MakeStoppableThread([this]() { Work(); }));
+  }
+}
+
+inline RecurringThreadScheduler::RecurringThreadScheduler(int const workers)
+    : RecurringThreadScheduler(workers, /*max_background_workers=*/workers) {}
+
+inline RecurringThreadScheduler::~RecurringThreadScheduler() {
+  {
+    absl::MutexLock l(&lock_);
+    CHECK(tasks_.empty()) << tasks_.size()
+                          << " recurring threads still use this scheduler";
+    shutdown_ = true;
+  }
+  // Joins the workers.
+  workers_.clear();
+}
+
+inline void RecurringThreadScheduler::Register(
+    not_null<BaseRecurringThread*> const thread,
+    Priority const priority) {
+  absl::MutexLock l(&lock_);
+  for (auto const& task : tasks_) {
+    if (task.thread == thread) {
+      return;
+    }
+  }
+  tasks_.push_back({.thread = thread,
+                    .priority = priority,
+                    .earliest_run = std::chrono::steady_clock::now()});
+  notified_ = true;
+}
+
+inline void RecurringThreadScheduler::Unregister(
+    not_null<BaseRecurringThread*> const thread) {
+  absl::MutexLock l(&lock_);
+  auto const it = std::find_if(
+      tasks_.begin(), tasks_.end(), [thread](Task const& task) {
+        return task.thread == thread;
+      });
+  if (it == tasks_.end()) {
+    return;
+  }
+  if (it->execution != nullptr) {
+    it->execution->request_stop();
+    auto const idle = [&task = *it]() { return task.execution == nullptr; };
+    lock_.Await(absl::Condition(&idle));
+  }
+  tasks_.erase(it);
+}
+
+inline void RecurringThreadScheduler::SetPriority(
+    not_null<BaseRecurringThread*> const thread,
+    Priority const priority) {
+  absl::MutexLock l(&lock_);
+  for (auto& task : tasks_) {
+    if (task.thread == thread) {
+      task.priority = priority;
+      return;
+    }
+  }
+}
+
+inline void RecurringThreadScheduler::Notify() {
+  absl::MutexLock l(&lock_);
+  notified_ = true;
+}
+
+inline void RecurringThreadScheduler::Work() {
+  auto const notified_or_shutdown = [this]() {
+    lock_.AssertReaderHeld();
+    return notified_ || shutdown_;
+  };
+  for (;;) {
+    Task* selected = nullptr;
+    Priority selected_priority;
+    {
+      absl::MutexLock l(&lock_);
+      for (;;) {
+        if (shutdown_) {
+          return;
+        }
+        auto const now = std::chrono::steady_clock::now();
+        auto wakeup_time = now + max_idle_time_;
+        bool const background_allowed =
+            background_workers_ < max_background_workers_;
+        for (auto& task : tasks_) {
+          if (task.execution != nullptr || !task.thread->HasInput() ||
+              (task.priority == Priority::Background && !background_allowed)) {
+            continue;
+          }
+          if (task.earliest_run > now) {
+            wakeup_time = std::min(wakeup_time, task.earliest_run);
+          } else if (selected == nullptr ||
+                     task.priority > selected->priority ||
+                     (task.priority == selected->priority &&
+                      task.earliest_run < selected->earliest_run)) {
+            selected = &task;
+          }
+        }
+        if (selected != nullptr) {
+          break;
+        }
+        notified_ = false;
+        lock_.AwaitWithTimeout(absl::Condition(&notified_or_shutdown),
+                               absl::FromChrono(wakeup_time - now));
+      }
+      selected_priority = selected->priority;
+      if (selected_priority == Priority::Background) {
+        ++background_workers_;
+      }
+      selected->execution = std::make_unique<StoppableTask>();
+      selected->earliest_run =
+          std::chrono::steady_clock::now() + selected->thread->period_;
+    }
+
+    // The |selected| task cannot be unregistered while it executes, so it is
+    // safe to use it without holding the lock.
+    selected->execution->Run([thread = selected->thread]() {
+      return thread->RunAction();
+    }).IgnoreError();
+
+    absl::MutexLock l(&lock_);
+    if (selected_priority == Priority::Background) {
+      --background_workers_;
+    }
+    selected->execution.reset();
+    // Another worker may want to pick this task if its input changed while it
+    // was executing.
+    notified_ = true;
+  }
+}
+
+inline BaseRecurringThread::~BaseRecurringThread() {
+  Stop();
+}
+
 inline void BaseRecurringThread::Start() {
   absl::MutexLock l(&jthread_lock_);
-  if (!jthread_.joinable()) {
+  if (scheduler_ != nullptr) {
+    scheduler_->Register(this, priority_);
+  } else if (!jthread_.joinable()) {
     jthread_ = MakeStoppableThread(
         [this]() { absl::Status const status = RepeatedlyRunAction(); });
   }
@@ -20,43 +171,112 @@ inline void BaseRecurringThread::Start() {
 
 inline void BaseRecurringThread::Stop() {
   absl::MutexLock l(&jthread_lock_);
-  jthread_ = jthread();
+  if (scheduler_ != nullptr) {
+    scheduler_->Unregister(this);
+  } else {
+    jthread_ = jthread();
+  }
 }
 
 inline void BaseRecurringThread::Restart() {
   absl::MutexLock l(&jthread_lock_);
-  jthread_ = jthread();
-  jthread_ = MakeStoppableThread(
-      [this]() { absl::Status const status = RepeatedlyRunAction(); });
+  if (scheduler_ != nullptr) {
+    scheduler_->Unregister(this);
+    scheduler_->Register(this, priority_);
+  } else {
+    jthread_ = jthread();
+    jthread_ = MakeStoppableThread(
+        [this]() { absl::Status const status = RepeatedlyRunAction(); });
+  }
+}
+
+inline void BaseRecurringThread::SetPriority(Priority const priority) {
+  absl::MutexLock l(&jthread_lock_);
+  priority_ = priority;
+  if (scheduler_ != nullptr) {
+    scheduler_->SetPriority(this, priority_);
+  }
 }
 
 inline BaseRecurringThread::BaseRecurringThread(
-    std::chrono::milliseconds const period)
-    : period_(period) {}
+    std::chrono::milliseconds const period,
+    RecurringThreadScheduler* const scheduler,
+    Priority const priority)
+    : period_(period),
+      scheduler_(scheduler),
+      priority_(priority) {}
 
 inline absl::Status BaseRecurringThread::RepeatedlyRunAction() {
-  for (std::chrono::steady_clock::time_point wakeup_time;;
-       std::this_thread::sleep_until(wakeup_time)) {
-    wakeup_time = std::chrono::steady_clock::now() + period_;
+  {
+    absl::MutexLock l(&wake_up_lock_);
+    stop_requested_ = false;
+  }
+  // Wake up this thread when it is asked to stop, so that |Stop| doesn't have
+  // to wait for the end of a period.
+  stop_callback const wake_up_on_stop(
+      this_stoppable_thread::get_stop_token(), [this]() {
+        absl::MutexLock l(&wake_up_lock_);
+        stop_requested_ = true;
+      });
+  auto const stop_requested = [this]() {
+    wake_up_lock_.AssertReaderHeld();
+    return stop_requested_;
+  };
+  auto const input_available_or_stop_requested = [this]() {
+    wake_up_lock_.AssertReaderHeld();
+    return input_available_ || stop_requested_;
+  };
+
+  for (;;) {
+    auto const earliest_next_run = std::chrono::steady_clock::now() + period_;
     RETURN_IF_STOPPED;
 
     RunAction().IgnoreError();
 
     RETURN_IF_STOPPED;
+
+    // Honour the period, and then sleep until new input is available, instead
+    // of polling for it: the action runs as soon as both conditions are met.
+    absl::MutexLock l(&wake_up_lock_);
+    wake_up_lock_.AwaitWithTimeout(
+        absl::Condition(&stop_requested),
+        absl::FromChrono(earliest_next_run - std::chrono::steady_clock::now()));
+    wake_up_lock_.Await(absl::Condition(&input_available_or_stop_requested));
+    input_available_ = false;
+  }
+}
+
+inline void BaseRecurringThread::InputAvailable() {
+  if (scheduler_ != nullptr) {
+    scheduler_->Notify();
+  } else {
+    absl::MutexLock l(&wake_up_lock_);
+    input_available_ = true;
   }
 }
 
 template<typename Input, typename Output>
 RecurringThread<Input, Output>::RecurringThread(
     Action action,
-    std::chrono::milliseconds const period)
-    : BaseRecurringThread(period),
+    std::chrono::milliseconds const period,
+    RecurringThreadScheduler* const scheduler,
+    Priority const priority)
+    : BaseRecurringThread(period, scheduler, priority),
       action_(std::move(action)) {}
 
+template<typename Input, typename Output>
+RecurringThread<Input, Output>::~RecurringThread() {
+  // Stop before the destruction of the |action_|, which might be executing.
+  Stop();
+}
+
 template<typename Input, typename Output>
 void RecurringThread<Input, Output>::Put(Input input) {
-  absl::MutexLock l(&input_output_lock_);
-  input_ = std::move(input);
+  {
+    absl::MutexLock l(&input_output_lock_);
+    input_ = std::move(input);
+  }
+  InputAvailable();
 }
 
 template<typename Input, typename Output>
@@ -93,17 +313,34 @@ absl::Status RecurringThread<Input, Output>::RunAction() {
   return status_or_output.status();
 }
 
+template<typename Input, typename Output>
+bool RecurringThread<Input, Output>::HasInput() {
+  absl::MutexLock l(&input_output_lock_);
+  return input_.has_value();
+}
+
 template<typename Input>
 RecurringThread<Input, void>::RecurringThread(
     Action action,
-    std::chrono::milliseconds const period)
-    : BaseRecurringThread(period),
+    std::chrono::milliseconds const period,
+    RecurringThreadScheduler* const scheduler,
+    Priority const priority)
+    : BaseRecurringThread(period, scheduler, priority),
       action_(std::move(action)) {}
 
+template<typename Input>
+RecurringThread<Input, void>::~RecurringThread() {
+  // Stop before the destruction of the |action_|, which might be executing.
+  Stop();
+}
+
 template<typename Input>
 void RecurringThread<Input, void>::Put(Input input) {
-  absl::MutexLock l(&input_lock_);
-  input_ = std::move(input);
+  {
+    absl::MutexLock l(&input_lock_);
+    input_ = std::move(input);
+  }
+  InputAvailable();
 }
 
 template<typename Input>
@@ -122,6 +359,12 @@ absl::Status RecurringThread<Input, void>::RunAction() {
   return action_(input.value());
 }
 
+template<typename Input>
+bool RecurringThread<Input, void>::HasInput() {
+  absl::MutexLock l(&input_lock_);
+  return input_.has_value();
+}
+
 }  // namespace internal
 }  // namespace _recurring_thread
 }  // namespace base
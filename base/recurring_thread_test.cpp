@@ -1,11 +1,13 @@
 #include "base/recurring_thread.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <optional>
 #include <thread>
 #include <utility>
 
 #include "absl/status/status.h"
+#include "base/jthread.hpp"  // 🧙 For RETURN_IF_STOPPED.
 #include "gtest/gtest.h"
 
 namespace principia {
@@ -69,5 +71,172 @@ TEST_F(RecurringThreadTest, NoResult) {
   } while (value != 3.5);
 }
 
+TEST_F(RecurringThreadTest, StopDuringLongPeriod) {
+  auto add_one_half = [](int const input) {
+    return static_cast<double>(input) + 0.5;
+  };
+
+  ToyRecurringThread2 thread(std::move(add_one_half), 1h);
+  thread.Start();
+
+  thread.Put(3);
+  EXPECT_EQ(3.5, PollingGet(thread));
+
+  // Returns without waiting for the end of the period.
+  thread.Stop();
+}
+
+TEST_F(RecurringThreadTest, Scheduled) {
+  RecurringThreadScheduler scheduler(/*workers=*/1);
+  auto add_one_half = [](int const input) {
+    return static_cast<double>(input) + 0.5;
+  };
+  auto add_one_quarter = [](int const input) {
+    return static_cast<double>(input) + 0.25;
+  };
+
+  ToyRecurringThread2 thread1(std::move(add_one_half),
+                              1ms,
+                              &scheduler,
+                              RecurringThreadScheduler::Priority::Interactive);
+  ToyRecurringThread2 thread2(std::move(add_one_quarter),
+                              1ms,
+                              &scheduler,
+                              RecurringThreadScheduler::Priority::Background);
+  thread1.Start();
+  thread2.Start();
+
+  thread1.Put(3);
+  thread2.Put(3);
+  EXPECT_EQ(3.5, PollingGet(thread1));
+  EXPECT_EQ(3.25, PollingGet(thread2));
+
+  // The input is overwritten if it has not been picked yet.
+  thread2.Stop();
+  thread2.Put(4);
+  thread2.Put(5);
+  thread2.Start();
+  EXPECT_EQ(5.25, PollingGet(thread2));
+  EXPECT_FALSE(thread2.Get().has_value());
+}
+
+TEST_F(RecurringThreadTest, SetPriority) {
+  RecurringThreadScheduler scheduler(/*workers=*/1);
+  std::atomic<bool> started = false;
+  std::atomic<bool> released = false;
+  auto block = [&started, &released](int const input) -> absl::Status {
+    started = true;
+    while (!released) {
+      std::this_thread::sleep_for(50us);
+    }
+    return absl::OkStatus();
+  };
+  // Records the input of the first action to run.
+  std::atomic<int> first = 0;
+  auto record = [&first](int const input) -> absl::Status {
+    int expected = 0;
+    first.compare_exchange_strong(expected, input);
+    return absl::OkStatus();
+  };
+
+  ToyRecurringThread1 blocker(std::move(block), 1ms, &scheduler);
+  ToyRecurringThread1 thread1(record,
+                              1ms,
+                              &scheduler,
+                              RecurringThreadScheduler::Priority::Interactive);
+  ToyRecurringThread1 thread2(record,
+                              1ms,
+                              &scheduler,
+                              RecurringThreadScheduler::Priority::Background);
+  blocker.Start();
+  thread1.Start();
+  thread2.Start();
+
+  // Occupy the worker while the priorities are swapped.
+  blocker.Put(0);
+  do {
+    std::this_thread::sleep_for(50us);
+  } while (!started);
+  thread1.Put(1);
+  thread2.Put(2);
+  thread1.SetPriority(RecurringThreadScheduler::Priority::Background);
+  thread2.SetPriority(RecurringThreadScheduler::Priority::Interactive);
+  released = true;
+
+  do {
+    std::this_thread::sleep_for(50us);
+  } while (first == 0);
+  EXPECT_EQ(2, first);
+}
+
+TEST_F(RecurringThreadTest, MaxBackgroundWorkers) {
+  RecurringThreadScheduler scheduler(/*workers=*/2,
+                                     /*max_background_workers=*/1);
+  std::atomic<int> started = 0;
+  std::atomic<bool> released = false;
+  auto block = [&started, &released](int const input) -> absl::Status {
+    ++started;
+    while (!released) {
+      std::this_thread::sleep_for(50us);
+    }
+    return absl::OkStatus();
+  };
+  auto add_one_half = [](int const input) {
+    return static_cast<double>(input) + 0.5;
+  };
+
+  ToyRecurringThread1 background1(block, 1ms, &scheduler);
+  ToyRecurringThread1 background2(block, 1ms, &scheduler);
+  ToyRecurringThread2 interactive(
+      std::move(add_one_half),
+      1ms,
+      &scheduler,
+      RecurringThreadScheduler::Priority::Interactive);
+  background1.Start();
+  background2.Start();
+  interactive.Start();
+
+  // Only one of the background tasks runs, the other one is queued.
+  background1.Put(1);
+  background2.Put(2);
+  do {
+    std::this_thread::sleep_for(50us);
+  } while (started == 0);
+  std::this_thread::sleep_for(10ms);
+  EXPECT_EQ(1, started);
+
+  // The interactive task runs on the reserved worker.
+  interactive.Put(3);
+  EXPECT_EQ(3.5, PollingGet(interactive));
+  EXPECT_EQ(1, started);
+
+  // The queued background task runs once the worker is released.
+  released = true;
+  do {
+    std::this_thread::sleep_for(50us);
+  } while (started < 2);
+}
+
+TEST_F(RecurringThreadTest, ScheduledStop) {
+  RecurringThreadScheduler scheduler(/*workers=*/2);
+  std::atomic<bool> started = false;
+  auto run_until_stopped = [&started](int const input) -> absl::Status {
+    started = true;
+    for (;;) {
+      RETURN_IF_STOPPED;
+      std::this_thread::sleep_for(50us);
+    }
+  };
+
+  ToyRecurringThread1 thread(std::move(run_until_stopped), 1ms, &scheduler);
+  thread.Start();
+  thread.Put(3);
+  do {
+    std::this_thread::sleep_for(50us);
+  } while (!started);
+  // Returns once the action has observed the stop request.
+  thread.Stop();
+}
+
 }  // namespace base
 }  // namespace principia
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <future>
 #include <list>
+#include <memory>
+#include <optional>
 #include <thread>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
@@ -15,10 +21,20 @@ namespace _thread_pool {
 namespace internal {
 
 // A pool of threads that are created at construction and to which functions can
-// be added for asynchronous execution.  This class is thread-safe.
+// be added for asynchronous execution.  Each thread has its own queue of calls,
+// to which it adds the calls made from that thread, and it steals calls from
+// the queues of the other threads when its own queue is empty.  Calls added
+// from outside of the pool are distributed among the queues.  A call with high
+// priority is executed before any call with normal priority that has not
+// started.  This class is thread-safe.
 template<typename T>
 class ThreadPool final {
  public:
+  enum class Priority {
+    Normal = 0,
+    High = 1,
+  };
+
   // Constructs a pool with the given number of threads.
   explicit ThreadPool(std::int64_t pool_size);
 
@@ -26,26 +42,47 @@ class ThreadPool final {
 
   // Adds a call to the execution queue, and returns a future that the client
   // may use to wait until execution of |function| has completed and to extract
-  // the result.
-  std::future<T> Add(std::function<T()> function);
+  // the result.  |function| may be move-only and mutable.
+  template<typename Function>
+  std::future<T> Add(Function&& function,
+                     Priority priority = Priority::Normal);
 
  private:
-  // The queue element contains a |function| to execute and a |promise| used to
-  // communicate the result to the caller.
-  struct Call {
-    std::function<T()> function;
-    std::promise<T> promise;
+  using Call = std::packaged_task<T()>;
+
+  // The calls that are waiting to be executed, one lane per priority.
+  struct Queue {
+    absl::Mutex lock;
+    std::array<std::deque<Call>, 2> lanes GUARDED_BY(lock);
   };
 
-  // The loop executed on each thread to extract an element from the queue,
-  // execute it, and set its result in the promise.
-  void DequeueCallAndExecute();
+  // Returns a call of the given |priority|, taken from the queue of the thread
+  // with the given |index| or stolen from another queue, if there is one.
+  std::optional<Call> Dequeue(std::int64_t index, Priority priority);
 
-  absl::Mutex lock_;
-  bool shutdown_ GUARDED_BY(lock_) = false;
-  std::deque<Call> calls_ GUARDED_BY(lock_);
+  // The loop executed on the thread with the given |index| to extract calls
+  // from the queues and execute them.
+  void DequeueCallAndExecute(std::int64_t index);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  // The index of the queue that receives the next call from outside of the
+  // pool.
+  std::atomic<std::int64_t> next_queue_ = 0;
+  // The number of calls in the queues.
+  std::atomic<std::int64_t> pending_calls_ = 0;
+
+  // Used by the threads that find no call to execute to wait for one.
+  absl::Mutex sleep_lock_;
+  absl::CondVar wake_up_;
+  std::atomic<std::int64_t> sleepers_ = 0;
+  bool shutdown_ GUARDED_BY(sleep_lock_) = false;
 
   std::list<std::thread> threads_;
+
+  // The pool to which the current thread belongs, if any, and the index of the
+  // thread in that pool.
+  inline static thread_local ThreadPool const* current_pool_ = nullptr;
+  inline static thread_local std::int64_t current_index_ = 0;
 };
 
 }  // namespace internal
@@ -2,6 +2,7 @@
 
 #include "base/thread_pool.hpp"
 
+#include <memory>
 #include <utility>
 
 namespace principia {
@@ -9,33 +10,22 @@ namespace base {
 namespace _thread_pool {
 namespace internal {
 
-// A helper function that is specialized for void because void is not really a
-// type.
-template<typename T>
-void ExecuteAndSetValue(std::function<T()> const& function,
-                        std::promise<T>& promise) {
-  promise.set_value(function());
-}
-
-template<>
-inline void ExecuteAndSetValue<void>(std::function<void()> const& function,
-                                     std::promise<void>& promise) {
-  function();
-  promise.set_value();
-}
-
 template<typename T>
 ThreadPool<T>::ThreadPool(std::int64_t const pool_size) {
   for (std::int64_t i = 0; i < pool_size; ++i) {
-    threads_.emplace_back(std::bind(&ThreadPool::DequeueCallAndExecute, this));
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (std::int64_t i = 0; i < pool_size; ++i) {
+    threads_.emplace_back(&ThreadPool::DequeueCallAndExecute, this, i);
   }
 }
 
 template<typename T>
 ThreadPool<T>::~ThreadPool() {
   {
-    absl::MutexLock l(&lock_);
+    absl::MutexLock l(&sleep_lock_);
     shutdown_ = true;
+    wake_up_.SignalAll();
   }
   for (auto& thread : threads_) {
     thread.join();
@@ -43,41 +33,89 @@ ThreadPool<T>::~ThreadPool() {
 }
 
 template<typename T>
-std::future<T> ThreadPool<T>::Add(std::function<T()> function) {
-  std::future<T> result;
+template<typename Function>
+std::future<T> ThreadPool<T>::Add(Function&& function,
+                                  Priority const priority) {
+  Call call(std::forward<Function>(function));
+  std::future<T> result = call.get_future();
+
+  // A call made from a thread of this pool goes to the queue of that thread,
+  // where it is likely to be executed soon by that thread.
+  std::int64_t const index =
+      current_pool_ == this ? current_index_
+                            : next_queue_.fetch_add(1) % queues_.size();
   {
-    absl::MutexLock l(&lock_);
-    calls_.push_back({std::move(function), std::promise<T>()});
-    result = calls_.back().promise.get_future();
+    auto& queue = *queues_[index];
+    absl::MutexLock l(&queue.lock);
+    queue.lanes[static_cast<int>(priority)].push_back(std::move(call));
+  }
+
+  // The increment of |pending_calls_| must precede the read of |sleepers_|,
+  // and a sleeping thread increments |sleepers_| before reading
+  // |pending_calls_|, so either it sees the call or it gets signalled.
+  pending_calls_.fetch_add(1);
+  if (sleepers_.load() > 0) {
+    absl::MutexLock l(&sleep_lock_);
+    wake_up_.Signal();
   }
   return result;
 }
 
 template<typename T>
-void ThreadPool<T>::DequeueCallAndExecute() {
-  for (;;) {
-    Call this_call;
-
-    // Wait until either the queue contains an element or this class is shutting
-    // down.
-    {
-      absl::MutexLock l(&lock_);
+auto ThreadPool<T>::Dequeue(std::int64_t const index,
+                            Priority const priority) -> std::optional<Call> {
+  int const lane = static_cast<int>(priority);
+  // Our own queue is looked at first, and then those of the other threads, in
+  // an order that depends on |index| to avoid having all the thieves contend
+  // for the same queue.
+  for (std::int64_t i = 0; i < queues_.size(); ++i) {
+    auto& queue = *queues_[(index + i) % queues_.size()];
+    absl::MutexLock l(&queue.lock);
+    auto& calls = queue.lanes[lane];
+    if (!calls.empty()) {
+      // The owner takes the oldest calls and the thieves the most recent ones.
+      std::optional<Call> call;
+      if (i == 0) {
+        call = std::move(calls.front());
+        calls.pop_front();
+      } else {
+        call = std::move(calls.back());
+        calls.pop_back();
+      }
+      return call;
+    }
+  }
+  return std::nullopt;
+}
 
-      auto const has_calls_or_shutdown = [this] {
-        return shutdown_ || !calls_.empty();
-      };
-      lock_.Await(absl::Condition(&has_calls_or_shutdown));
+template<typename T>
+void ThreadPool<T>::DequeueCallAndExecute(std::int64_t const index) {
+  current_pool_ = this;
+  current_index_ = index;
+  for (;;) {
+    std::optional<Call> call = Dequeue(index, Priority::High);
+    if (!call.has_value()) {
+      call = Dequeue(index, Priority::Normal);
+    }
 
-      if (shutdown_) {
-        break;
-      }
-      this_call = std::move(calls_.front());
-      calls_.pop_front();
+    if (call.has_value()) {
+      pending_calls_.fetch_sub(1);
+      // Execute the function without holding any lock as it might take some
+      // time.
+      (*call)();
+      continue;
     }
 
-    // Execute the function without holding the |lock_| as it might take some
-    // time.
-    ExecuteAndSetValue(this_call.function, this_call.promise);
+    // Wait until either a call is added or this class is shutting down.
+    absl::MutexLock l(&sleep_lock_);
+    sleepers_.fetch_add(1);
+    while (!shutdown_ && pending_calls_.load() <= 0) {
+      wake_up_.Wait(&sleep_lock_);
+    }
+    sleepers_.fetch_sub(1);
+    if (shutdown_) {
+      break;
+    }
   }
 }
 
@@ -2,16 +2,20 @@
 
 #include <cstdint>
 #include <future>
+#include <memory>
 #include <thread>
 #include <vector>
 
 #include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
 #include "glog/logging.h"
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 namespace principia {
 namespace base {
 
+using ::testing::ElementsAre;
 using namespace principia::base::_thread_pool;
 
 class ThreadPoolTest : public ::testing::Test {
@@ -55,5 +59,69 @@ TEST_F(ThreadPoolTest, ParallelExecution) {
   EXPECT_FALSE(monotonically_increasing);
 }
 
+// Check that the calls that have high priority overtake those that have normal
+// priority.
+TEST_F(ThreadPoolTest, Priority) {
+  ThreadPool<int> pool(/*pool_size=*/1);
+
+  // Block the only thread until all the calls have been added.
+  absl::Notification all_added;
+  auto blocker = pool.Add([&all_added]() {
+    all_added.WaitForNotification();
+    return 0;
+  });
+
+  absl::Mutex lock;
+  std::vector<int> order;
+  std::vector<std::future<int>> futures;
+  for (int i = 1; i <= 3; ++i) {
+    futures.push_back(pool.Add([i, &lock, &order]() {
+      absl::MutexLock l(&lock);
+      order.push_back(i);
+      return i;
+    }));
+  }
+  futures.push_back(pool.Add(
+      [&lock, &order]() {
+        absl::MutexLock l(&lock);
+        order.push_back(4);
+        return 4;
+      },
+      ThreadPool<int>::Priority::High));
+  all_added.Notify();
+
+  EXPECT_EQ(0, blocker.get());
+  for (int i = 0; i < futures.size(); ++i) {
+    EXPECT_EQ(i + 1, futures[i].get());
+  }
+  EXPECT_THAT(order, ElementsAre(4, 1, 2, 3));
+}
+
+// Check that calls may be added from the threads of the pool, and that they are
+// executed even if the thread that added them is busy.
+TEST_F(ThreadPoolTest, NestedCalls) {
+  ThreadPool<std::int64_t> pool(/*pool_size=*/4);
+  auto outer = pool.Add([&pool]() {
+    std::vector<std::future<std::int64_t>> futures;
+    for (std::int64_t i = 0; i < 100; ++i) {
+      futures.push_back(pool.Add([i]() { return i; }));
+    }
+    std::int64_t sum = 0;
+    for (auto& future : futures) {
+      sum += future.get();
+    }
+    return sum;
+  });
+  EXPECT_EQ(4950, outer.get());
+}
+
+TEST_F(ThreadPoolTest, MoveOnly) {
+  auto value = std::make_unique<int>(42);
+  auto future = pool_.Add([value = std::move(value)]() mutable {
+    value.reset();
+  });
+  future.wait();
+}
+
 }  // namespace base
 }  // namespace principia
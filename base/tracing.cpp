@@ -0,0 +1,218 @@
+#include "base/tracing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _tracing {
+namespace internal {
+
+namespace {
+
+// The number of events kept per thread.  Older events are overwritten.
+constexpr std::size_t ring_buffer_size = 1 << 16;
+constexpr int histogram_buckets = 64;
+
+struct Event {
+  char const* name;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::duration duration;
+};
+
+using Histogram = std::array<std::int64_t, histogram_buckets>;
+
+// The events and histograms of a thread.  The lock is only contended when the
+// trace is being written or cleared.
+struct ThreadBuffer {
+  explicit ThreadBuffer(int thread_index);
+
+  int const thread_index;
+  absl::Mutex lock;
+  std::vector<Event> events GUARDED_BY(lock);
+  // The total number of events recorded in |events|, including those that have
+  // been overwritten.
+  std::int64_t recorded GUARDED_BY(lock) = 0;
+  absl::flat_hash_map<char const*, Histogram> histograms GUARDED_BY(lock);
+};
+
+ThreadBuffer::ThreadBuffer(int const thread_index)
+    : thread_index(thread_index) {}
+
+// The buffers of all the threads that have recorded events.  They are never
+// destroyed, so that the events of threads that have exited are not lost.
+struct Registry {
+  absl::Mutex lock;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers GUARDED_BY(lock);
+};
+
+std::atomic<bool> tracing_enabled = false;
+
+Registry& registry() {
+  static Registry* const registry = new Registry;
+  return *registry;
+}
+
+std::chrono::steady_clock::time_point const& epoch() {
+  static std::chrono::steady_clock::time_point const epoch =
+      std::chrono::steady_clock::now();
+  return epoch;
+}
+
+ThreadBuffer& this_thread_buffer() {
+  thread_local std::shared_ptr<ThreadBuffer> const buffer = []() {
+    auto& r = registry();
+    absl::MutexLock l(&r.lock);
+    auto result = std::make_shared<ThreadBuffer>(r.buffers.size());
+    r.buffers.push_back(result);
+    return result;
+  }();
+  return *buffer;
+}
+
+int HistogramBucket(std::chrono::steady_clock::duration const duration) {
+  auto const μs = std::chrono::duration_cast<std::chrono::microseconds>(
+                      duration).count();
+  return std::max<int>(
+      0, std::bit_width(static_cast<std::uint64_t>(std::max<std::int64_t>(
+             μs, 0))) - 1);
+}
+
+double Microseconds(std::chrono::steady_clock::duration const duration) {
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+std::string EscapedForJSON(char const* const name) {
+  std::string result;
+  for (char const* c = name; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      result += '\\';
+    }
+    result += *c;
+  }
+  return result;
+}
+
+}  // namespace
+
+void EnableTracing(bool const enabled) {
+  // Make sure that the epoch precedes all the events.
+  epoch();
+  tracing_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool TracingEnabled() {
+  return tracing_enabled.load(std::memory_order_relaxed);
+}
+
+void ClearTracing() {
+  auto& r = registry();
+  absl::MutexLock l(&r.lock);
+  for (auto const& buffer : r.buffers) {
+    absl::MutexLock buffer_lock(&buffer->lock);
+    buffer->events.clear();
+    buffer->recorded = 0;
+    buffer->histograms.clear();
+  }
+}
+
+absl::Status WriteChromeTrace(std::filesystem::path const& filename) {
+  std::ofstream file(filename);
+  if (!file.good()) {
+    return absl::UnavailableError(
+        absl::StrCat("Cannot open ", filename.string()));
+  }
+  file << "{\"traceEvents\":[";
+  bool first = true;
+  auto& r = registry();
+  absl::MutexLock l(&r.lock);
+  for (auto const& buffer : r.buffers) {
+    absl::MutexLock buffer_lock(&buffer->lock);
+    for (Event const& event : buffer->events) {
+      file << (first ? "\n" : ",\n") << "{\"name\":\""
+           << EscapedForJSON(event.name) << "\",\"ph\":\"X\",\"pid\":0,"
+           << "\"tid\":" << buffer->thread_index
+           << ",\"ts\":" << Microseconds(event.start - epoch())
+           << ",\"dur\":" << Microseconds(event.duration) << "}";
+      first = false;
+    }
+  }
+  file << "\n]}\n";
+  file.close();
+  if (!file.good()) {
+    return absl::DataLossError(
+        absl::StrCat("Error writing ", filename.string()));
+  }
+  return absl::OkStatus();
+}
+
+void LogTracingHistograms() {
+  // Merge the histograms of all the threads, by name since the same literal
+  // may have different addresses in different translation units.
+  std::map<std::string, Histogram> histograms;
+  {
+    auto& r = registry();
+    absl::MutexLock l(&r.lock);
+    for (auto const& buffer : r.buffers) {
+      absl::MutexLock buffer_lock(&buffer->lock);
+      for (auto const& [name, histogram] : buffer->histograms) {
+        auto& merged_histogram = histograms.try_emplace(name).first->second;
+        for (int i = 0; i < histogram_buckets; ++i) {
+          merged_histogram[i] += histogram[i];
+        }
+      }
+    }
+  }
+  for (auto const& [name, histogram] : histograms) {
+    std::string line = absl::StrCat("[Tracing: ", name, "]");
+    for (int i = 0; i < histogram_buckets; ++i) {
+      if (histogram[i] != 0) {
+        absl::StrAppend(&line, " ", std::int64_t{1} << i, " μs: ",
+                        histogram[i]);
+      }
+    }
+    LOG(INFO) << line;
+  }
+}
+
+TracingScope::TracingScope(char const* const name)
+    : name_(name), enabled_(TracingEnabled()) {
+  if (enabled_) {
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+TracingScope::~TracingScope() {
+  if (!enabled_) {
+    return;
+  }
+  auto const duration = std::chrono::steady_clock::now() - start_;
+  auto& buffer = this_thread_buffer();
+  absl::MutexLock l(&buffer.lock);
+  Event const event{.name = name_, .start = start_, .duration = duration};
+  if (buffer.events.size() < ring_buffer_size) {
+    buffer.events.push_back(event);
+  } else {
+    buffer.events[buffer.recorded % ring_buffer_size] = event;
+  }
+  ++buffer.recorded;
+  ++buffer.histograms[name_][HistogramBucket(duration)];
+}
+
+}  // namespace internal
+}  // namespace _tracing
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+#include "absl/status/status.h"
+
+namespace principia {
+namespace base {
+namespace _tracing {
+namespace internal {
+
+// A low-overhead tracer for the hot paths of the plugin.  Like the interface
+// monitors, it is not journaled and has no side effects other than logging
+// and writing the trace when asked to.  When tracing is disabled, which is the
+// default, a |TracingScope| costs a relaxed atomic load.  When it is enabled,
+// each scope records an event in a ring buffer owned by its thread, and adds
+// its duration to a histogram with a logarithmic scale.
+
+// Enables or disables the recording of |TracingScope|s.  Disabling tracing
+// doesn't discard the events already recorded.
+void EnableTracing(bool enabled);
+bool TracingEnabled();
+
+// Discards all the events and histograms recorded so far.
+void ClearTracing();
+
+// Writes the events currently held in the ring buffers to |filename| in the
+// Chrome trace event format (a JSON file that can be opened with
+// chrome://tracing or Perfetto).  Nested scopes appear nested in the trace.
+absl::Status WriteChromeTrace(std::filesystem::path const& filename);
+
+// Logs, for each scope name, the number of scopes whose duration falls in
+// [2ⁿ μs, 2ⁿ⁺¹ μs[.
+void LogTracingHistograms();
+
+// Records the time spent between the construction and the destruction of this
+// object under |name|, which must have static storage duration (typically a
+// string literal).  Whether the scope is recorded is decided at construction.
+class TracingScope final {
+ public:
+  explicit TracingScope(char const* name);
+  ~TracingScope();
+
+  TracingScope(TracingScope const&) = delete;
+  TracingScope& operator=(TracingScope const&) = delete;
+
+ private:
+  char const* const name_;
+  bool const enabled_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace internal
+
+using internal::ClearTracing;
+using internal::EnableTracing;
+using internal::LogTracingHistograms;
+using internal::TracingEnabled;
+using internal::TracingScope;
+using internal::WriteChromeTrace;
+
+}  // namespace _tracing
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,78 @@
+#include "base/tracing.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "base/status_utilities.hpp"  // 🧙 For CHECK_OK.
+#include "gmock/gmock.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+using namespace principia::base::_tracing;
+
+class TracingTest : public ::testing::Test {
+ protected:
+  TracingTest() {
+    ClearTracing();
+  }
+
+  ~TracingTest() override {
+    EnableTracing(false);
+    ClearTracing();
+  }
+
+  static std::string ChromeTrace() {
+    auto const filename = TEMP_DIR / "tracing_test.json";
+    CHECK_OK(WriteChromeTrace(filename));
+    std::stringstream contents;
+    contents << std::ifstream(filename).rdbuf();
+    return contents.str();
+  }
+};
+
+TEST_F(TracingTest, Disabled) {
+  EXPECT_FALSE(TracingEnabled());
+  {
+    TracingScope scope("TracingTest::Disabled");
+  }
+  EXPECT_THAT(ChromeTrace(), Not(HasSubstr("TracingTest::Disabled")));
+}
+
+TEST_F(TracingTest, NestedScopes) {
+  EnableTracing(true);
+  {
+    TracingScope outer("TracingTest::Outer");
+    {
+      TracingScope inner("TracingTest::Inner");
+    }
+    std::thread([]() { TracingScope other("TracingTest::Other"); }).join();
+  }
+  // A scope that starts after tracing is disabled is not recorded.
+  EnableTracing(false);
+  {
+    TracingScope scope("TracingTest::Late");
+  }
+  std::string const trace = ChromeTrace();
+  EXPECT_THAT(trace, HasSubstr("{\"traceEvents\":["));
+  EXPECT_THAT(trace,
+              HasSubstr("{\"name\":\"TracingTest::Outer\",\"ph\":\"X\""));
+  EXPECT_THAT(trace,
+              HasSubstr("{\"name\":\"TracingTest::Inner\",\"ph\":\"X\""));
+  EXPECT_THAT(trace,
+              HasSubstr("{\"name\":\"TracingTest::Other\",\"ph\":\"X\""));
+  EXPECT_THAT(trace, Not(HasSubstr("TracingTest::Late")));
+  LogTracingHistograms();
+
+  ClearTracing();
+  EXPECT_THAT(ChromeTrace(), Not(HasSubstr("TracingTest::Outer")));
+}
+
+}  // namespace base
+}  // namespace principia
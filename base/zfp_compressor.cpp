@@ -1,8 +1,10 @@
 #include "base/zfp_compressor.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "base/array.hpp"
@@ -22,6 +24,13 @@ static constexpr uint header_mask = ZFP_HEADER_MODE | ZFP_HEADER_MAGIC;
 
 ZfpCompressor::ZfpCompressor(double const accuracy) : accuracy_(accuracy) {}
 
+ThreadPool<void>& ZfpCompressor::thread_pool() {
+  // Never destroyed, to avoid problems with the order of static destructions.
+  static auto* const pool = new ThreadPool<void>(
+      std::max<std::int64_t>(1, std::thread::hardware_concurrency()));
+  return *pool;
+}
+
 void ZfpCompressor::WriteToMessage(const zfp_field* const field,
                                    not_null<std::string*> message) const {
   std::unique_ptr<zfp_stream, std::function<void(zfp_stream*)>> const zfp(
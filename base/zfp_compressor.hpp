@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "zfp/zfp.h"
 
 namespace principia {
@@ -13,6 +14,7 @@ namespace _zfp_compressor {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 
 // Helper class for ZFP compression.  This class compresses doubles, not
 // quantities, because we don't want to depend on the layout of Quantity in
@@ -46,6 +48,21 @@ class ZfpCompressor {
   void ReadFromMessageMultidimensional(std::vector<double>& v,
                                        std::string_view& message) const;
 
+  // A vector of doubles to compress with a specific compressor.
+  struct Column {
+    not_null<ZfpCompressor const*> compressor;
+    not_null<std::vector<double>*> values;
+  };
+
+  // Equivalent to calling |WriteToMessageMultidimensional| successively on
+  // each of the |columns|, but the columns are compressed in parallel if they
+  // are large enough.  The |message| is the same as for the successive calls,
+  // in particular it doesn't depend on the scheduling of the threads.
+  template<int D>
+  static void WriteToMessageMultidimensionalInParallel(
+      std::vector<Column> const& columns,
+      not_null<std::string*> message);
+
   // Low-level API: serialization/deserialization of a field (allocated and
   // owned by the caller) into a message (which is expected to by a bytes field
   // of a proto).  When reading, the |message| parameter is updated to reflect
@@ -56,6 +73,12 @@ class ZfpCompressor {
                        std::string_view& message) const;
 
  private:
+  // Columns smaller than this are not worth the overhead of a thread.
+  static constexpr std::int64_t min_parallel_column_size = 1 << 12;
+
+  // The pool used for parallel compression, shared by all the compressors.
+  static ThreadPool<void>& thread_pool();
+
   std::optional<double> const accuracy_;
 };
 
@@ -2,7 +2,9 @@
 
 #include "base/zfp_compressor.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <utility>
@@ -109,6 +111,40 @@ void ZfpCompressor::WriteToMessageMultidimensional(
   WriteToMessage(field.get(), message);
 }
 
+template<int D>
+void ZfpCompressor::WriteToMessageMultidimensionalInParallel(
+    std::vector<Column> const& columns,
+    not_null<std::string*> const message) {
+  bool const parallel =
+      columns.size() > 1 &&
+      std::all_of(columns.begin(), columns.end(), [](Column const& column) {
+        return column.values->size() >= min_parallel_column_size;
+      });
+  if (!parallel) {
+    for (auto const& [compressor, values] : columns) {
+      compressor->template WriteToMessageMultidimensional<D>(*values, message);
+    }
+    return;
+  }
+
+  // Each column is compressed into its own string, and the strings are
+  // appended in order, to make the result deterministic.
+  std::vector<std::string> compressed(columns.size());
+  std::vector<std::future<void>> futures;
+  futures.reserve(columns.size());
+  for (std::int64_t i = 0; i < columns.size(); ++i) {
+    futures.push_back(thread_pool().Add([&column = columns[i],
+                                         &compressed = compressed[i]]() {
+      column.compressor->template WriteToMessageMultidimensional<D>(
+          *column.values, &compressed);
+    }));
+  }
+  for (std::int64_t i = 0; i < columns.size(); ++i) {
+    futures[i].wait();
+    message->append(compressed[i]);
+  }
+}
+
 template<int D>
 void ZfpCompressor::ReadFromMessageMultidimensional(
     std::vector<double>& v,
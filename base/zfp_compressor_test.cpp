@@ -0,0 +1,76 @@
+#include "base/zfp_compressor.hpp"
+
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::ElementsAreArray;
+using ::testing::Eq;
+using namespace principia::base::_zfp_compressor;
+
+class ZfpCompressorTest : public ::testing::Test {
+ protected:
+  static std::vector<double> MakeColumn(int const size, double const ω) {
+    std::vector<double> column;
+    for (int i = 0; i < size; ++i) {
+      column.push_back(std::sin(ω * i));
+    }
+    return column;
+  }
+};
+
+TEST_F(ZfpCompressorTest, Parallel) {
+  // Large enough to be compressed in parallel.
+  constexpr int size = 10'000;
+  ZfpCompressor const exact_compressor(0);
+  ZfpCompressor const lossy_compressor(1e-6);
+  std::vector<std::vector<double>> const columns{MakeColumn(size, 0.1),
+                                                 MakeColumn(size, 0.2),
+                                                 MakeColumn(size, 0.3)};
+
+  std::string serial;
+  {
+    auto copy = columns;
+    exact_compressor.WriteToMessageMultidimensional<2>(copy[0], &serial);
+    lossy_compressor.WriteToMessageMultidimensional<2>(copy[1], &serial);
+    lossy_compressor.WriteToMessageMultidimensional<2>(copy[2], &serial);
+  }
+
+  std::string parallel;
+  {
+    auto copy = columns;
+    ZfpCompressor::WriteToMessageMultidimensionalInParallel<2>(
+        {{&exact_compressor, &copy[0]},
+         {&lossy_compressor, &copy[1]},
+         {&lossy_compressor, &copy[2]}},
+        &parallel);
+  }
+  EXPECT_THAT(parallel, Eq(serial));
+
+  // The result may be decompressed column by column.
+  ZfpCompressor const decompressor;
+  std::string_view message = parallel;
+  for (int i = 0; i < columns.size(); ++i) {
+    std::vector<double> column(size);
+    decompressor.ReadFromMessageMultidimensional<2>(column, message);
+    column.resize(size);
+    if (i == 0) {
+      EXPECT_THAT(column, ElementsAreArray(columns[i]));
+    } else {
+      for (int j = 0; j < size; ++j) {
+        EXPECT_NEAR(columns[i][j], column[j], 1e-6);
+      }
+    }
+  }
+  EXPECT_TRUE(message.empty());
+}
+
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,168 @@
+#include "batch_flow/batch_flow_driver.hpp"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "base/status_utilities.hpp"  // 🧙 For RETURN_IF_ERROR.
+#include "geometry/instant.hpp"
+#include "glog/logging.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/util/delimited_message_util.h"
+#include "ksp_plugin/flight_plan.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+
+namespace principia {
+namespace batch_flow {
+namespace _batch_flow_driver {
+namespace internal {
+
+using namespace principia::geometry::_instant;
+using namespace principia::ksp_plugin::_flight_plan;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory;
+
+BatchFlowDriver::BatchFlowDriver(
+    not_null<Ephemeris<Barycentric>*> const ephemeris,
+    std::int64_t const pool_size)
+    : ephemeris_(ephemeris),
+      pool_(pool_size) {}
+
+void BatchFlowDriver::Run(
+    serialization::BatchFlowRequest const& request,
+    std::function<void(serialization::BatchFlowResult const&)> const& emit) {
+  // Prolong the ephemeris once for the entire batch, so that the jobs don't
+  // contend for its lock to prolong it bit by bit.
+  Instant t_max = ephemeris_->t_max();
+  for (auto const& job : request.job()) {
+    if (job.has_flight_plan()) {
+      t_max = std::max(t_max,
+                       Instant::ReadFromMessage(
+                           job.flight_plan().desired_final_time()));
+    } else if (job.has_free_fall()) {
+      t_max = std::max(t_max,
+                       Instant::ReadFromMessage(job.free_fall().final_time()));
+    }
+  }
+  absl::Status const status = ephemeris_->Prolong(t_max);
+  LOG_IF(WARNING, !status.ok())
+      << "Cannot prolong the ephemeris to " << t_max << ": " << status;
+
+  std::vector<std::future<serialization::BatchFlowResult>> results;
+  results.reserve(request.job_size());
+  for (auto const& job : request.job()) {
+    results.push_back(pool_.Add([this, &job]() { return RunJob(job); }));
+  }
+  for (auto& result : results) {
+    emit(result.get());
+  }
+}
+
+absl::Status BatchFlowDriver::Serve(std::istream& input,
+                                    std::ostream& output) {
+  google::protobuf::io::IstreamInputStream input_stream(&input);
+  for (;;) {
+    serialization::BatchFlowRequest request;
+    bool clean_eof;
+    if (!google::protobuf::util::ParseDelimitedFromZeroCopyStream(
+            &request, &input_stream, &clean_eof)) {
+      if (clean_eof) {
+        return absl::OkStatus();
+      }
+      return absl::InvalidArgumentError("Malformed batch flow request");
+    }
+    Run(request, [&output](serialization::BatchFlowResult const& result) {
+      google::protobuf::util::SerializeDelimitedToOstream(result, &output);
+      output.flush();
+    });
+    if (!output.good()) {
+      return absl::UnavailableError("Cannot write batch flow results");
+    }
+  }
+}
+
+serialization::BatchFlowResult BatchFlowDriver::RunJob(
+    serialization::BatchFlowJob const& job) const {
+  serialization::BatchFlowResult result;
+  result.set_id(job.id());
+  absl::Status status;
+  switch (job.job_case()) {
+    case serialization::BatchFlowJob::kFlightPlan: {
+      auto const flight_plan =
+          FlightPlan::ReadFromMessage(job.flight_plan(), ephemeris_);
+      if (flight_plan == nullptr) {
+        status = absl::InvalidArgumentError(
+            absl::StrCat("Job ", job.id(), " has an anomalous flight plan"));
+        break;
+      }
+      status = flight_plan->anomalous_status();
+      auto const& trajectory = flight_plan->GetAllSegments();
+      std::vector<DiscreteTrajectory<Barycentric>::SegmentIterator> tracked;
+      for (auto it = trajectory.segments().begin();
+           it != trajectory.segments().end();
+           ++it) {
+        tracked.push_back(it);
+      }
+      trajectory.WriteToMessage(result.mutable_trajectory(),
+                                tracked,
+                                /*exact=*/{});
+      break;
+    }
+    case serialization::BatchFlowJob::kFreeFall:
+      status = FlowFreeFall(job.free_fall(), result.mutable_trajectory());
+      break;
+    case serialization::BatchFlowJob::JOB_NOT_SET:
+      status = absl::InvalidArgumentError(
+          absl::StrCat("Job ", job.id(), " is empty"));
+      break;
+  }
+  result.set_error(static_cast<int>(status.code()));
+  if (!status.ok()) {
+    result.set_message(std::string(status.message()));
+  }
+  return result;
+}
+
+absl::Status BatchFlowDriver::FlowFreeFall(
+    serialization::BatchFlowJob::FreeFall const& free_fall,
+    not_null<serialization::DiscreteTrajectory*> const trajectory) const {
+  Instant const initial_time =
+      Instant::ReadFromMessage(free_fall.initial_time());
+  Instant const final_time = Instant::ReadFromMessage(free_fall.final_time());
+  if (final_time < initial_time) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Final time ", DebugString(final_time),
+                     " is before initial time ", DebugString(initial_time)));
+  }
+  if (initial_time < ephemeris_->t_min()) {
+    return absl::OutOfRangeError(
+        absl::StrCat("Initial time ", DebugString(initial_time),
+                     " is before the beginning of the ephemeris ",
+                     DebugString(ephemeris_->t_min())));
+  }
+  RETURN_IF_ERROR(ephemeris_->Prolong(initial_time));
+  DiscreteTrajectory<Barycentric> free_fall_trajectory;
+  RETURN_IF_ERROR(free_fall_trajectory.Append(
+      initial_time,
+      DegreesOfFreedom<Barycentric>::ReadFromMessage(
+          free_fall.initial_degrees_of_freedom())));
+  absl::Status const status = ephemeris_->FlowWithAdaptiveStep(
+      &free_fall_trajectory,
+      Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+      final_time,
+      Ephemeris<Barycentric>::AdaptiveStepParameters::ReadFromMessage(
+          free_fall.adaptive_step_parameters()));
+  // Write the trajectory even if the integration failed: the part that was
+  // integrated is still meaningful.
+  free_fall_trajectory.WriteToMessage(trajectory, /*tracked=*/{}, /*exact=*/{});
+  return status;
+}
+
+}  // namespace internal
+}  // namespace _batch_flow_driver
+}  // namespace batch_flow
+}  // namespace principia
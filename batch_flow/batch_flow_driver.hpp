@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+
+#include "absl/status/status.h"
+#include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "physics/ephemeris.hpp"
+#include "serialization/ksp_plugin.pb.h"
+
+namespace principia {
+namespace batch_flow {
+namespace _batch_flow_driver {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::physics::_ephemeris;
+
+// Runs batches of flight plans and free falls against a single ephemeris,
+// which is loaded once and shared by all the jobs.  The jobs of a batch are run
+// in parallel.
+class BatchFlowDriver {
+ public:
+  // The jobs are run on a pool of |pool_size| threads.
+  BatchFlowDriver(not_null<Ephemeris<Barycentric>*> ephemeris,
+                  std::int64_t pool_size);
+
+  // Runs all the jobs of |request| and calls |emit| with their results, in the
+  // order of the jobs, as soon as they are available.  |emit| is called on the
+  // thread that called |Run|.
+  void Run(serialization::BatchFlowRequest const& request,
+           std::function<void(serialization::BatchFlowResult const&)> const&
+               emit);
+
+  // Reads requests from |input| until it is exhausted, and writes the results
+  // to |output|.  The messages are delimited by their size, see
+  // |serialization::BatchFlowJob|.  Returns an error if |input| is malformed.
+  absl::Status Serve(std::istream& input, std::ostream& output);
+
+ private:
+  serialization::BatchFlowResult RunJob(
+      serialization::BatchFlowJob const& job) const;
+
+  absl::Status FlowFreeFall(
+      serialization::BatchFlowJob::FreeFall const& free_fall,
+      not_null<serialization::DiscreteTrajectory*> trajectory) const;
+
+  not_null<Ephemeris<Barycentric>*> const ephemeris_;
+  ThreadPool<serialization::BatchFlowResult> pool_;
+};
+
+}  // namespace internal
+
+using internal::BatchFlowDriver;
+
+}  // namespace _batch_flow_driver
+}  // namespace batch_flow
+}  // namespace principia
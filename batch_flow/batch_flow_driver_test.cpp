@@ -0,0 +1,254 @@
+#include "batch_flow/batch_flow_driver.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "astronomy/epoch.hpp"
+#include "base/not_null.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "gmock/gmock.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/util/delimited_message_util.h"
+#include "gtest/gtest.h"
+#include "integrators/methods.hpp"
+#include "integrators/symmetric_linear_multistep_integrator.hpp"
+#include "ksp_plugin/flight_plan.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/integrators.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/ephemeris.hpp"
+#include "physics/massive_body.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/numbers.hpp"  // 🧙 For π.
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "serialization/ksp_plugin.pb.h"
+#include "testing_utilities/matchers.hpp"  // 🧙 For EXPECT_OK.
+
+namespace principia {
+namespace batch_flow {
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Ge;
+using ::testing::Lt;
+using namespace principia::astronomy::_epoch;
+using namespace principia::base::_not_null;
+using namespace principia::batch_flow::_batch_flow_driver;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::integrators::_methods;
+using namespace principia::integrators::_symmetric_linear_multistep_integrator;
+using namespace principia::ksp_plugin::_flight_plan;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::ksp_plugin::_integrators;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_ephemeris;
+using namespace principia::physics::_massive_body;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+
+class BatchFlowDriverTest : public testing::Test {
+ protected:
+  BatchFlowDriverTest() {
+    // A single body with a circular orbit of period 2π s at 1 m.
+    std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+    bodies.emplace_back(make_not_null_unique<MassiveBody>(
+        MassiveBody::Parameters(1 * Pow<3>(Metre) / Pow<2>(Second))));
+    std::vector<DegreesOfFreedom<Barycentric>> initial_state{
+        {Barycentric::origin, Barycentric::unmoving}};
+    ephemeris_ = std::make_unique<Ephemeris<Barycentric>>(
+        std::move(bodies),
+        initial_state,
+        /*initial_time=*/t0_,
+        Ephemeris<Barycentric>::AccuracyParameters(
+            /*fitting_tolerance=*/1 * Milli(Metre),
+            /*geopotential_tolerance=*/0x1p-24),
+        Ephemeris<Barycentric>::FixedStepParameters(
+            SymmetricLinearMultistepIntegrator<
+                QuinlanTremaine1990Order12,
+                Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+            /*step=*/10 * Minute));
+    EXPECT_OK(ephemeris_->Prolong(t0_));
+  }
+
+  // Returns the position on the circular orbit at time |t|.
+  Position<Barycentric> CircularPosition(Instant const& t) const {
+    Angle const θ = (t - t0_) * Radian / Second;
+    return Barycentric::origin +
+           Displacement<Barycentric>({Cos(θ) * Metre,
+                                      Sin(θ) * Metre,
+                                      0 * Metre});
+  }
+
+  serialization::BatchFlowJob MakeFreeFallJob(std::int64_t const id,
+                                              Instant const& final_time) {
+    serialization::BatchFlowJob job;
+    job.set_id(id);
+    auto* const free_fall = job.mutable_free_fall();
+    t0_.WriteToMessage(free_fall->mutable_initial_time());
+    initial_degrees_of_freedom_.WriteToMessage(
+        free_fall->mutable_initial_degrees_of_freedom());
+    final_time.WriteToMessage(free_fall->mutable_final_time());
+    DefaultPredictionParameters().WriteToMessage(
+        free_fall->mutable_adaptive_step_parameters());
+    return job;
+  }
+
+  serialization::BatchFlowJob MakeFlightPlanJob(std::int64_t const id,
+                                                Instant const& final_time) {
+    serialization::BatchFlowJob job;
+    job.set_id(id);
+    FlightPlan const flight_plan(/*initial_mass=*/1 * Kilogram,
+                                 /*initial_time=*/t0_,
+                                 initial_degrees_of_freedom_,
+                                 /*desired_final_time=*/final_time,
+                                 ephemeris_.get(),
+                                 DefaultPredictionParameters(),
+                                 DefaultBurnParameters());
+    flight_plan.WriteToMessage(job.mutable_flight_plan());
+    return job;
+  }
+
+  Instant const t0_ = J2000;
+  DegreesOfFreedom<Barycentric> const initial_degrees_of_freedom_ = {
+      CircularPosition(t0_),
+      Velocity<Barycentric>({0 * Metre / Second,
+                             1 * Metre / Second,
+                             0 * Metre / Second})};
+  std::unique_ptr<Ephemeris<Barycentric>> ephemeris_;
+};
+
+TEST_F(BatchFlowDriverTest, Run) {
+  Instant const t_final = t0_ + π * Second;
+  serialization::BatchFlowRequest request;
+  *request.add_job() = MakeFreeFallJob(/*id=*/3, t_final);
+  *request.add_job() = MakeFlightPlanJob(/*id=*/1, t_final);
+  request.add_job()->set_id(2);
+
+  BatchFlowDriver driver(ephemeris_.get(), /*pool_size=*/2);
+  std::vector<serialization::BatchFlowResult> results;
+  driver.Run(request,
+             [&results](serialization::BatchFlowResult const& result) {
+               results.push_back(result);
+             });
+
+  // The results are in the order of the jobs.
+  ASSERT_THAT(results.size(), Eq(3));
+  EXPECT_THAT(results[0].id(), Eq(3));
+  EXPECT_THAT(results[1].id(), Eq(1));
+  EXPECT_THAT(results[2].id(), Eq(2));
+  EXPECT_THAT(ephemeris_->t_max(), Ge(t_final));
+
+  // The free fall follows the circular orbit.
+  {
+    auto const& result = results[0];
+    EXPECT_THAT(static_cast<absl::StatusCode>(result.error()),
+                Eq(absl::StatusCode::kOk));
+    EXPECT_FALSE(result.has_message());
+    ASSERT_TRUE(result.has_trajectory());
+    auto const trajectory =
+        DiscreteTrajectory<Barycentric>::ReadFromMessage(result.trajectory(),
+                                                         /*tracked=*/{});
+    EXPECT_THAT(trajectory.front().time, Eq(t0_));
+    EXPECT_THAT(trajectory.back().time, Eq(t_final));
+    for (auto const& [time, degrees_of_freedom] : trajectory) {
+      EXPECT_THAT((degrees_of_freedom.position() - CircularPosition(time))
+                      .Norm(),
+                  Lt(1 * Centi(Metre))) << time;
+    }
+  }
+
+  // The flight plan, which has no manœuvres, is a single coast along the same
+  // orbit, and its segments are tracked.
+  {
+    auto const& result = results[1];
+    EXPECT_THAT(static_cast<absl::StatusCode>(result.error()),
+                Eq(absl::StatusCode::kOk));
+    ASSERT_TRUE(result.has_trajectory());
+    DiscreteTrajectory<Barycentric>::SegmentIterator coast;
+    auto const trajectory =
+        DiscreteTrajectory<Barycentric>::ReadFromMessage(result.trajectory(),
+                                                         /*tracked=*/{&coast});
+    EXPECT_THAT(trajectory.segments().size(), Eq(1));
+    EXPECT_THAT(coast->front().time, Eq(t0_));
+    EXPECT_THAT(coast->back().time, Eq(t_final));
+    EXPECT_THAT((coast->back().degrees_of_freedom.position() -
+                 CircularPosition(t_final)).Norm(),
+                Lt(1 * Centi(Metre)));
+  }
+
+  // The empty job is reported as an error, without a trajectory.
+  {
+    auto const& result = results[2];
+    EXPECT_THAT(static_cast<absl::StatusCode>(result.error()),
+                Eq(absl::StatusCode::kInvalidArgument));
+    EXPECT_THAT(result.message(), Eq("Job 2 is empty"));
+    EXPECT_FALSE(result.has_trajectory());
+  }
+}
+
+TEST_F(BatchFlowDriverTest, Serve) {
+  Instant const t_final = t0_ + 1 * Second;
+  std::stringstream input;
+  {
+    serialization::BatchFlowRequest request;
+    *request.add_job() = MakeFreeFallJob(/*id=*/1, t_final);
+    request.add_job()->set_id(2);
+    EXPECT_TRUE(
+        google::protobuf::util::SerializeDelimitedToOstream(request, &input));
+  }
+  {
+    serialization::BatchFlowRequest request;
+    // A free fall that ends before it starts.
+    *request.add_job() = MakeFreeFallJob(/*id=*/3, t0_ - 1 * Second);
+    EXPECT_TRUE(
+        google::protobuf::util::SerializeDelimitedToOstream(request, &input));
+  }
+
+  BatchFlowDriver driver(ephemeris_.get(), /*pool_size=*/1);
+  std::stringstream output;
+  EXPECT_OK(driver.Serve(input, output));
+
+  // One result per job, in the order of the requests.
+  google::protobuf::io::IstreamInputStream output_stream(&output);
+  std::vector<std::int64_t> ids;
+  std::vector<absl::StatusCode> errors;
+  for (;;) {
+    serialization::BatchFlowResult result;
+    bool clean_eof;
+    if (!google::protobuf::util::ParseDelimitedFromZeroCopyStream(
+            &result, &output_stream, &clean_eof)) {
+      EXPECT_TRUE(clean_eof);
+      break;
+    }
+    ids.push_back(result.id());
+    errors.push_back(static_cast<absl::StatusCode>(result.error()));
+  }
+  EXPECT_THAT(ids, ElementsAre(1, 2, 3));
+  EXPECT_THAT(errors,
+              ElementsAre(absl::StatusCode::kOk,
+                          absl::StatusCode::kInvalidArgument,
+                          absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(BatchFlowDriverTest, MalformedRequest) {
+  std::stringstream input("\x05garbage");
+  std::stringstream output;
+  BatchFlowDriver driver(ephemeris_.get(), /*pool_size=*/1);
+  EXPECT_THAT(driver.Serve(input, output).code(),
+              Eq(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace batch_flow
+}  // namespace principia
@@ -0,0 +1,72 @@
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "base/macros.hpp"  // 🧙 For OS_WIN.
+#include "batch_flow/batch_flow_driver.hpp"
+#include "geometry/instant.hpp"
+#include "glog/logging.h"
+#include "ksp_plugin/frames.hpp"
+#include "physics/ephemeris.hpp"
+#include "serialization/physics.pb.h"
+
+#if OS_WIN
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+using namespace principia::batch_flow::_batch_flow_driver;
+using namespace principia::geometry::_instant;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::physics::_ephemeris;
+
+// Reads a serialized |serialization::Ephemeris| from the given file, then
+// serves batches of flow jobs on the standard input and output, see
+// |serialization::BatchFlowJob|.  The standard streams may be connected to a
+// socket by the caller (e.g., using inetd or socat) to distribute the jobs over
+// multiple machines, each running a copy of this program.
+int __cdecl main(int argc, char const* argv[]) {
+  google::SetLogFilenameExtension(".log");
+  google::InitGoogleLogging(argv[0]);
+  google::LogToStderr();
+  if (argc != 2 && argc != 3) {
+    // batch_flow.exe ephemeris.bin 8 < jobs.bin > results.bin
+    std::cerr << "Usage: " << argv[0] << " "
+              << "ephemeris_file "
+              << "[pool_size]\n";
+    return 1;
+  }
+  std::string const ephemeris_file = argv[1];
+  std::int64_t const pool_size =
+      argc == 3 ? std::stoll(argv[2]) : std::thread::hardware_concurrency();
+
+  principia::serialization::Ephemeris message;
+  {
+    std::ifstream input(ephemeris_file, std::ios::binary);
+    if (!input.good() || !message.ParseFromIstream(&input)) {
+      std::cerr << "Cannot read an ephemeris from " << ephemeris_file << "\n";
+      return 2;
+    }
+  }
+  // Keep all the checkpoints: the jobs may start at any time covered by the
+  // ephemeris.
+  auto const ephemeris =
+      Ephemeris<Barycentric>::ReadFromMessage(InfinitePast, message);
+  LOG(INFO) << "Loaded an ephemeris from " << ephemeris->t_min() << " to "
+            << ephemeris->t_max();
+
+#if OS_WIN
+  // The messages are binary, don't let the runtime translate the line endings.
+  _setmode(_fileno(stdin), _O_BINARY);
+  _setmode(_fileno(stdout), _O_BINARY);
+#endif
+  BatchFlowDriver driver(ephemeris.get(), pool_size);
+  auto const status = driver.Serve(std::cin, std::cout);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 3;
+  }
+  return 0;
+}
@@ -0,0 +1,139 @@
+#include "benchmarks/allocation_counters.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "base/macros.hpp"  // 🧙 For OS_MACOSX, OS_WIN.
+#include "glog/logging.h"
+
+#if OS_MACOSX
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+namespace principia {
+namespace benchmarks {
+namespace _allocation_counters {
+namespace internal {
+
+namespace {
+
+std::atomic<bool> counting = false;
+std::atomic<std::int64_t> allocations = 0;
+std::atomic<std::int64_t> allocated_bytes = 0;
+// The live bytes are counted from the construction of the
+// |AllocationCounters|, so they may be negative if memory allocated earlier is
+// freed.
+std::atomic<std::int64_t> live_bytes = 0;
+std::atomic<std::int64_t> peak_bytes = 0;
+
+std::int64_t UsableSize(void* const p) {
+#if OS_WIN
+  return _msize(p);
+#elif OS_MACOSX
+  return malloc_size(p);
+#else
+  return malloc_usable_size(p);
+#endif
+}
+
+void* Allocate(std::size_t const size) noexcept {
+  void* const p = std::malloc(size == 0 ? 1 : size);
+  if (p != nullptr && counting.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    std::int64_t const usable_size = UsableSize(p);
+    std::int64_t const live =
+        live_bytes.fetch_add(usable_size, std::memory_order_relaxed) +
+        usable_size;
+    std::int64_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !peak_bytes.compare_exchange_weak(
+               peak, live, std::memory_order_relaxed)) {}
+  }
+  return p;
+}
+
+void Deallocate(void* const p) noexcept {
+  if (p != nullptr && counting.load(std::memory_order_relaxed)) {
+    live_bytes.fetch_sub(UsableSize(p), std::memory_order_relaxed);
+  }
+  std::free(p);
+}
+
+}  // namespace
+
+AllocationCounters::AllocationCounters(benchmark::State& state)
+    : state_(state) {
+  CHECK(!counting.load());
+  allocations = 0;
+  allocated_bytes = 0;
+  live_bytes = 0;
+  peak_bytes = 0;
+  counting = true;
+}
+
+AllocationCounters::~AllocationCounters() {
+  counting = false;
+  state_.counters["allocations"] = benchmark::Counter(
+      allocations.load(), benchmark::Counter::kAvgIterations);
+  state_.counters["allocated_bytes"] = benchmark::Counter(
+      allocated_bytes.load(), benchmark::Counter::kAvgIterations);
+  state_.counters["peak_bytes"] = benchmark::Counter(peak_bytes.load());
+}
+
+}  // namespace internal
+}  // namespace _allocation_counters
+}  // namespace benchmarks
+}  // namespace principia
+
+// The replacements of the global allocation functions for the benchmarks
+// binary.  The aligned overloads are not replaced; their default
+// implementations don't go through these functions.
+
+void* operator new(std::size_t const size) {
+  void* const p =
+      principia::benchmarks::_allocation_counters::internal::Allocate(size);
+  if (p == nullptr) {
+    std::abort();
+  }
+  return p;
+}
+
+void* operator new[](std::size_t const size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t const size, std::nothrow_t const&) noexcept {
+  return principia::benchmarks::_allocation_counters::internal::Allocate(size);
+}
+
+void* operator new[](std::size_t const size, std::nothrow_t const&) noexcept {
+  return principia::benchmarks::_allocation_counters::internal::Allocate(size);
+}
+
+void operator delete(void* const p) noexcept {
+  principia::benchmarks::_allocation_counters::internal::Deallocate(p);
+}
+
+void operator delete[](void* const p) noexcept {
+  principia::benchmarks::_allocation_counters::internal::Deallocate(p);
+}
+
+void operator delete(void* const p, std::size_t) noexcept {
+  principia::benchmarks::_allocation_counters::internal::Deallocate(p);
+}
+
+void operator delete[](void* const p, std::size_t) noexcept {
+  principia::benchmarks::_allocation_counters::internal::Deallocate(p);
+}
+
+void operator delete(void* const p, std::nothrow_t const&) noexcept {
+  principia::benchmarks::_allocation_counters::internal::Deallocate(p);
+}
+
+void operator delete[](void* const p, std::nothrow_t const&) noexcept {
+  principia::benchmarks::_allocation_counters::internal::Deallocate(p);
+}
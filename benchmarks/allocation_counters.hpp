@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+
+namespace principia {
+namespace benchmarks {
+namespace _allocation_counters {
+namespace internal {
+
+// Counts the allocations made through the global |operator new|, which is
+// replaced in the benchmarks binary, during the lifetime of this object, and
+// attaches the following counters to |state| at destruction:
+//   allocations: the number of allocations per iteration;
+//   allocated_bytes: the number of bytes allocated per iteration;
+//   peak_bytes: the maximum number of bytes live at any time since
+//     construction, in excess of those live at construction.
+// The allocations made by all threads are counted, so that work offloaded to
+// a thread pool is accounted for, and so are those made while the timing is
+// paused.  When no |AllocationCounters| object is alive, the replaced
+// |operator new| costs a relaxed atomic load.  Usage:
+//   AllocationCounters allocation_counters(state);
+//   for (auto _ : state) { ... }
+// Only one object may be alive at a time.
+class AllocationCounters final {
+ public:
+  explicit AllocationCounters(benchmark::State& state);
+  ~AllocationCounters();
+
+  AllocationCounters(AllocationCounters const&) = delete;
+  AllocationCounters& operator=(AllocationCounters const&) = delete;
+
+ private:
+  benchmark::State& state_;
+};
+
+}  // namespace internal
+
+using internal::AllocationCounters;
+
+}  // namespace _allocation_counters
+}  // namespace benchmarks
+}  // namespace principia
@@ -1,5 +1,7 @@
 // .\Release\x64\benchmarks.exe --benchmark_filter=Checkpointer --benchmark_repetitions=5  // NOLINT(whitespace/line_length)
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 
 #include "absl/status/status.h"
@@ -7,6 +9,7 @@
 #include "benchmark/benchmark.h"
 #include "geometry/instant.hpp"
 #include "physics/checkpointer.hpp"
+#include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
 #include "serialization/geometry.pb.h"
 #include "serialization/integrators.pb.h"
@@ -24,6 +27,7 @@ using serialization::State;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_instant;
 using namespace principia::physics::_checkpointer;
+using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
 // Stub writer for checkpointer. Adds some data to the checkpoint.
@@ -135,6 +139,36 @@ void BM_CheckpointerAllCheckpointsBetween(benchmark::State& state) {
   }
 }
 
+// Thins a checkpointer of the specified size, with a dense span given by the
+// second argument, in seconds.  The counters show the memory saved and the
+// longest interval that a reanimation would have to integrate.
+void BM_CheckpointerThinning(benchmark::State& state) {
+  int const size = state.range(0);
+  Checkpointer<Ephemeris>::RetentionPolicy const policy{
+      .dense_span = state.range(1) * Second,
+      .spacing = 1 * Second};
+  Instant const t = Instant() + (size - 1) * Second;
+  std::unique_ptr<Checkpointer<Ephemeris>> checkpointer;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    checkpointer = NewCheckpointerWithSize(size);
+    state.ResumeTiming();
+    checkpointer->RemoveCheckpoints(
+        checkpointer->ThinnableCheckpoints(t, policy));
+  }
+
+  auto const checkpoints = checkpointer->all_checkpoints();
+  Time longest_interval;
+  for (auto it = checkpoints.begin(); std::next(it) != checkpoints.end();
+       ++it) {
+    longest_interval = std::max(longest_interval, *std::next(it) - *it);
+  }
+  state.counters["checkpoints"] = checkpoints.size();
+  state.counters["bytes"] = checkpointer->MemoryFootprint();
+  state.counters["longest_interval"] = longest_interval / Second;
+}
+
 BENCHMARK(BM_CheckpointerOldestCheckpoint)->Range(1, 512);
 BENCHMARK(BM_CheckpointerNewestCheckpoint)->Range(1, 512);
 BENCHMARK(BM_CheckpointerCheckpointAtOrAfter)->Range(1, 512);
@@ -142,6 +176,11 @@ BENCHMARK(BM_CheckpointerCheckpointAtOrBefore)->Range(1, 512);
 BENCHMARK(BM_CheckpointerAllCheckpoints)->Range(1, 512);
 BENCHMARK(BM_CheckpointerAllCheckpointsAtOrBefore)->Range(1, 512);
 BENCHMARK(BM_CheckpointerAllCheckpointsBetween)->Range(1, 512);
+BENCHMARK(BM_CheckpointerThinning)
+    ->ArgPair(512, 512)
+    ->ArgPair(512, 128)
+    ->ArgPair(512, 32)
+    ->ArgPair(512, 8);
 
 }  // namespace physics
 }  // namespace principia
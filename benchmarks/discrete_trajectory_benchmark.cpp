@@ -5,6 +5,7 @@
 
 #include "base/status_utilities.hpp"  // 🧙 For CHECK_OK.
 #include "benchmark/benchmark.h"
+#include "benchmarks/allocation_counters.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/instant.hpp"
@@ -21,6 +22,7 @@
 namespace principia {
 namespace physics {
 
+using namespace principia::benchmarks::_allocation_counters;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_instant;
@@ -286,6 +288,7 @@ void BM_DiscreteTrajectoryCreateDestroy(benchmark::State& state) {
                                       /*Δt=*/1 * Second,
                                       /*t1=*/t0,
                                       /*t2=*/t0 + steps * Second);
+  AllocationCounters allocation_counters(state);
   for (auto _ : state) {
     MakeTrajectory(timeline, {0.5, 0.75});
   }
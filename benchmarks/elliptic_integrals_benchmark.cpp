@@ -107,8 +107,65 @@ void BM_FukushimaEllipticBDJ(benchmark::State& state) {
   }
 }
 
+void BM_EllipticFBatch(benchmark::State& state) {
+  constexpr int size = 20;
+
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution_φ(0.0, π / 2);
+  std::uniform_real_distribution<> distribution_mc(0.0, 1.0);
+  std::vector<Angle> φs;
+  std::vector<double> mcs;
+  for (int i = 0; i < size; ++i) {
+    φs.push_back(distribution_φ(random) * Radian);
+    mcs.push_back(distribution_mc(random));
+  }
+
+  while (state.KeepRunningBatch(size * size)) {
+    Angle f;
+    for (double const mc : mcs) {
+      for (Angle const& f_φǀm : EllipticF(φs, mc)) {
+        f += f_φǀm;
+      }
+    }
+    benchmark::DoNotOptimize(f);
+  }
+}
+
+void BM_EllipticFEΠBatch(benchmark::State& state) {
+  constexpr int size = 20;
+
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution_φ(0.0, π / 2);
+  std::uniform_real_distribution<> distribution_n(0.0, 1.0);
+  std::uniform_real_distribution<> distribution_mc(0.0, 1.0);
+  std::vector<Angle> φs;
+  std::vector<double> ns;
+  std::vector<double> mcs;
+  for (int i = 0; i < size; ++i) {
+    φs.push_back(distribution_φ(random) * Radian);
+    ns.push_back(distribution_n(random));
+    mcs.push_back(distribution_mc(random));
+  }
+
+  std::vector<Angle> es;
+  std::vector<Angle> fs;
+  std::vector<Angle> ᴨs;
+  while (state.KeepRunningBatch(size * size * size)) {
+    for (double const n : ns) {
+      for (double const mc : mcs) {
+        EllipticFEΠ(φs, n, mc, fs, es, ᴨs);
+      }
+    }
+    benchmark::DoNotOptimize(es);
+    benchmark::DoNotOptimize(fs);
+    benchmark::DoNotOptimize(ᴨs);
+  }
+}
+
 BENCHMARK(BM_EllipticF);
+BENCHMARK(BM_EllipticFBatch);
 BENCHMARK(BM_EllipticFEΠ);
+BENCHMARK(BM_EllipticFEΠBatch);
 BENCHMARK(BM_FukushimaEllipticBDJ);
 
 }  // namespace numerics
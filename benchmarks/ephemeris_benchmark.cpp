@@ -6,6 +6,7 @@
 #include <limits>
 #include <list>
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -15,6 +16,7 @@
 #include "base/status_utilities.hpp"  // 🧙 For CHECK_OK.
 #include "base/thread_pool.hpp"
 #include "benchmark/benchmark.h"
+#include "benchmarks/allocation_counters.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/identity.hpp"
@@ -32,7 +34,10 @@
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/kepler_orbit.hpp"
+#include "physics/massive_body.hpp"
 #include "physics/massless_body.hpp"
+#include "physics/oblate_body.hpp"
+#include "physics/rotating_body.hpp"
 #include "physics/solar_system.hpp"
 #include "quantities/astronomy.hpp"
 #include "quantities/bipm.hpp"
@@ -49,6 +54,7 @@ using namespace principia::astronomy::_frames;
 using namespace principia::astronomy::_stabilize_ksp;
 using namespace principia::base::_not_null;
 using namespace principia::base::_thread_pool;
+using namespace principia::benchmarks::_allocation_counters;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_identity;
@@ -66,7 +72,10 @@ using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_kepler_orbit;
+using namespace principia::physics::_massive_body;
 using namespace principia::physics::_massless_body;
+using namespace principia::physics::_oblate_body;
+using namespace principia::physics::_rotating_body;
 using namespace principia::physics::_solar_system;
 using namespace principia::quantities::_astronomy;
 using namespace principia::quantities::_bipm;
@@ -106,8 +115,86 @@ not_null<std::unique_ptr<SolarSystem<Barycentric>>> SolarSystemAtСпутник1
   return at_спутник_1_launch;
 }
 
+// Returns an ephemeris for a system of |number_of_bodies| massive bodies, used
+// to assess how the ephemeris scales with large, modded systems.  The first
+// bodies are those of the solar system, in decreasing order of mass, some of
+// which are oblate.  The rest are synthetic asteroids on circular orbits around
+// the Sun, one in four of which is oblate.  If |minimize_polynomial_storage|
+// is true, the trajectories use the lowest possible degree for each polynomial.
+not_null<std::unique_ptr<Ephemeris<Barycentric>>> MakeSyntheticEphemeris(
+    int const number_of_bodies,
+    bool const minimize_polynomial_storage = false) {
+  auto const at_спутник_1_launch = SolarSystemAtСпутник1Launch(
+      SolarSystemFactory::Accuracy::AllBodiesAndDampedOblateness);
+  Instant const epoch = at_спутник_1_launch->epoch();
+
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<Barycentric>> initial_state;
+  for (int i = 0;
+       i <= SolarSystemFactory::LastBody && bodies.size() < number_of_bodies;
+       ++i) {
+    std::string const& name = SolarSystemFactory::name(i);
+    bodies.push_back(SolarSystem<Barycentric>::MakeMassiveBody(
+        at_спутник_1_launch->gravity_model_message(name)));
+    initial_state.push_back(at_спутник_1_launch->degrees_of_freedom(name));
+  }
+
+  std::string const& sun_name =
+      SolarSystemFactory::name(SolarSystemFactory::Sun);
+  GravitationalParameter const sun_gravitational_parameter =
+      at_спутник_1_launch->gravitational_parameter(sun_name);
+  DegreesOfFreedom<Barycentric> const sun_degrees_of_freedom =
+      at_спутник_1_launch->degrees_of_freedom(sun_name);
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> radius_distribution(2.1, 3.3);
+  std::uniform_real_distribution<> angle_distribution(0, 2 * π);
+  std::uniform_real_distribution<> gravitational_parameter_distribution(1, 20);
+  for (int i = 0; bodies.size() < number_of_bodies; ++i) {
+    Length const r = radius_distribution(random) * AstronomicalUnit;
+    Angle const θ = angle_distribution(random) * Radian;
+    Speed const v = Sqrt(sun_gravitational_parameter / r);
+    MassiveBody::Parameters const massive_body_parameters(
+        "Asteroid" + std::to_string(i),
+        gravitational_parameter_distribution(random) *
+            Pow<3>(Kilo(Metre)) / Pow<2>(Second));
+    if (i % 4 == 0) {
+      bodies.push_back(make_not_null_unique<OblateBody<Barycentric>>(
+          massive_body_parameters,
+          RotatingBody<Barycentric>::Parameters(
+              /*mean_radius=*/200 * Kilo(Metre),
+              /*reference_angle=*/0 * Radian,
+              /*reference_instant=*/epoch,
+              /*angular_frequency=*/2 * π * Radian / (5 * Hour),
+              /*right_ascension_of_pole=*/0 * Degree,
+              /*declination_of_pole=*/90 * Degree),
+          OblateBody<Barycentric>::Parameters(/*j2=*/0.05,
+                                              200 * Kilo(Metre))));
+    } else {
+      bodies.push_back(
+          make_not_null_unique<MassiveBody>(massive_body_parameters));
+    }
+    initial_state.push_back(
+        sun_degrees_of_freedom +
+        RelativeDegreesOfFreedom<Barycentric>(
+            Displacement<Barycentric>({r * Cos(θ), r * Sin(θ), 0 * Metre}),
+            Velocity<Barycentric>(
+                {-v * Sin(θ), v * Cos(θ), 0 * Metre / Second})));
+  }
+
+  return make_not_null_unique<Ephemeris<Barycentric>>(
+      std::move(bodies),
+      initial_state,
+      epoch,
+      /*accuracy_parameters=*/Ephemeris<Barycentric>::AccuracyParameters(
+          /*fitting_tolerance=*/1 * Milli(Metre),
+          /*geopotential_tolerance=*/0x1p-24,
+          minimize_polynomial_storage),
+      EphemerisParameters());
+}
+
 void BM_EphemerisKSPSystem(benchmark::State& state) {
   Length error;
+  AllocationCounters allocation_counters(state);
   for (auto _ : state) {
     state.PauseTiming();
 
@@ -146,6 +233,7 @@ void BM_EphemerisKSPSystem(benchmark::State& state) {
 template<SolarSystemFactory::Accuracy accuracy>
 void BM_EphemerisSolarSystem(benchmark::State& state) {
   Length error;
+  AllocationCounters allocation_counters(state);
   for (auto _ : state) {
     state.PauseTiming();
 
@@ -193,6 +281,7 @@ void BM_EphemerisLEOProbe(benchmark::State& state) {
 
   CHECK_OK(ephemeris->Prolong(final_time));
 
+  AllocationCounters allocation_counters(state);
   for (auto _ : state) {
     state.PauseTiming();
     // A probe in low earth orbit.
@@ -262,6 +351,7 @@ void BM_EphemerisTranslunarSpaceProbe(benchmark::State& state) {
 
   CHECK_OK(ephemeris->Prolong(final_time));
 
+  AllocationCounters allocation_counters(state);
   for (auto _ : state) {
     state.PauseTiming();
     // A probe orbiting the Earth beyond the orbit of the Moon.
@@ -353,6 +443,7 @@ void BM_EphemerisMultithreadingBenchmark(benchmark::State& state) {
   static constexpr Frequency refresh_frequency = 50 * Hertz;
   static constexpr Time step = warp_factor / refresh_frequency;
   Instant final_time = epoch;
+  AllocationCounters allocation_counters(state);
   for (auto _ : state) {
     state.PauseTiming();
     std::vector<not_null<std::unique_ptr<Integrator<Ephemeris<
@@ -393,6 +484,102 @@ void BM_EphemerisMultithreadingBenchmark(benchmark::State& state) {
   state.SetLabel(ss.str());
 }
 
+// Prolongs a synthetic system of |state.range(0)| bodies over one year, using
+// |state.range(1)| threads for the accelerations between the bodies (0 for the
+// sequential computation).  Reports the time per step of the ephemeris, and the
+// size of the serialized ephemeris, which is dominated by the polynomials of
+// the trajectories.
+void BM_EphemerisSyntheticSystem(benchmark::State& state) {
+  int const number_of_bodies = state.range(0);
+  int const pool_size = state.range(1);
+  std::int64_t steps;
+  std::int64_t bytes;
+  AllocationCounters allocation_counters(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto const ephemeris = MakeSyntheticEphemeris(number_of_bodies);
+    if (pool_size > 0) {
+      ephemeris->EnableParallelMassiveBodiesIntegration(pool_size);
+    }
+    Instant const initial_time = ephemeris->t_max();
+    Instant const final_time = initial_time + 1 * JulianYear;
+
+    state.ResumeTiming();
+    CHECK_OK(ephemeris->Prolong(final_time));
+    state.PauseTiming();
+
+    steps = std::floor((ephemeris->t_max() - initial_time) /
+                       EphemerisParameters().step());
+    serialization::Ephemeris message;
+    ephemeris->WriteToMessage(&message);
+    bytes = message.ByteSizeLong();
+    state.ResumeTiming();
+  }
+  state.counters["s/step"] = benchmark::Counter(
+      steps,
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+  state.counters["bytes/year"] = bytes;
+}
+
+// Serializes a synthetic system of |state.range(0)| bodies prolonged over one
+// year, which is the cost of writing it to a save.
+void BM_EphemerisSyntheticSystemWriteToMessage(benchmark::State& state) {
+  auto const ephemeris = MakeSyntheticEphemeris(state.range(0));
+  CHECK_OK(ephemeris->Prolong(ephemeris->t_max() + 1 * JulianYear));
+  std::int64_t bytes;
+  AllocationCounters allocation_counters(state);
+  for (auto _ : state) {
+    serialization::Ephemeris message;
+    ephemeris->WriteToMessage(&message);
+    bytes = message.ByteSizeLong();
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// Prolongs a synthetic system of |state.range(0)| bodies over one year, with
+// the degree of the polynomials minimized if |state.range(1)| is nonzero.
+// Reports the time per step, the average degree of the polynomials, and the
+// number of bytes of coefficients per year of trajectory.
+void BM_EphemerisSyntheticSystemPolynomialStorage(benchmark::State& state) {
+  int const number_of_bodies = state.range(0);
+  bool const minimize_polynomial_storage = state.range(1) != 0;
+  std::int64_t steps;
+  double average_degree;
+  double bytes_per_year;
+  AllocationCounters allocation_counters(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto const ephemeris =
+        MakeSyntheticEphemeris(number_of_bodies, minimize_polynomial_storage);
+    Instant const initial_time = ephemeris->t_max();
+    Instant const final_time = initial_time + 1 * JulianYear;
+
+    state.ResumeTiming();
+    CHECK_OK(ephemeris->Prolong(final_time));
+    state.PauseTiming();
+
+    steps = std::floor((ephemeris->t_max() - initial_time) /
+                       EphemerisParameters().step());
+    average_degree = 0;
+    bytes_per_year = 0;
+    for (auto const& body : ephemeris->bodies()) {
+      auto const trajectory = ephemeris->trajectory(body);
+      average_degree += trajectory->average_degree();
+      bytes_per_year += trajectory->coefficients_per_unit_time() * JulianYear *
+                        sizeof(Position<Barycentric>);
+    }
+    average_degree /= ephemeris->bodies().size();
+    state.ResumeTiming();
+  }
+  state.counters["s/step"] = benchmark::Counter(
+      steps,
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+  state.counters["average_degree"] = average_degree;
+  state.counters["bytes/year"] = bytes_per_year;
+}
+
 template<SolarSystemFactory::Accuracy accuracy, Flow* flow>
 void EphemerisL4ProbeBenchmark(Time const integration_duration,
                                benchmark::State& state) {
@@ -467,6 +654,7 @@ void EphemerisL4ProbeBenchmark(Time const integration_duration,
     total_degree += ephemeris->trajectory(body)->average_degree();
   }
 
+  AllocationCounters allocation_counters(state);
   for (auto _ : state) {
     not_null<std::unique_ptr<DiscreteTrajectory<Barycentric>>> trajectory =
         make_l4_probe_trajectory();
@@ -583,6 +771,22 @@ BENCHMARK(BM_EphemerisMultithreadingBenchmark)
     ->ArgPair(3, 4)
     ->ArgPair(3, 5)
     ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_EphemerisSyntheticSystem)
+    ->ArgPair(10, 0)
+    ->ArgPair(50, 0)
+    ->ArgPair(200, 0)
+    ->ArgPair(50, 4)
+    ->ArgPair(200, 4)
+    ->Unit(benchmark::kSecond);
+BENCHMARK(BM_EphemerisSyntheticSystemPolynomialStorage)
+    ->ArgPair(50, 0)
+    ->ArgPair(50, 1)
+    ->Unit(benchmark::kSecond);
+BENCHMARK(BM_EphemerisSyntheticSystemWriteToMessage)
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(200)
+    ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_EphemerisKSPSystem)->Arg(-3)->Unit(benchmark::kSecond);
 BENCHMARK_TEMPLATE(BM_EphemerisSolarSystem,
                    SolarSystemFactory::Accuracy::MajorBodiesOnly)
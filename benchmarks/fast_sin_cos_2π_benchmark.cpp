@@ -84,9 +84,27 @@ void BM_FastSinCos2πThroughput(benchmark::State& state) {
   }
 }
 
+void BM_FastSinCos2πVectorThroughput(benchmark::State& state) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1.0, 1.0);
+  std::vector<double> input;
+  for (int i = 0; i < 1e3; ++i) {
+    input.push_back(distribution(random));
+  }
+
+  std::vector<double> sin;
+  std::vector<double> cos;
+  for (auto _ : state) {
+    FastSinCos2π(input, sin, cos);
+    benchmark::DoNotOptimize(sin);
+    benchmark::DoNotOptimize(cos);
+  }
+}
+
 BENCHMARK(BM_FastSinCos2πPoorlyPredictedLatency)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_FastSinCos2πWellPredictedLatency)->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_FastSinCos2πThroughput)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FastSinCos2πVectorThroughput)->Unit(benchmark::kMicrosecond);
 
 }  // namespace numerics
 }  // namespace principia
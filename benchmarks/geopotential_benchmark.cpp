@@ -142,6 +142,45 @@ void BM_ComputeGeopotentialCpp(benchmark::State& state) {
   }
 }
 
+void BM_ComputeGeopotentialCppBatched(benchmark::State& state) {
+  int const max_degree = state.range(0);
+
+  SolarSystem<ICRS> solar_system_2000(
+            SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+            SOLUTION_DIR / "astronomy" /
+                "sol_initial_state_jd_2451545_000000000.proto.txt");
+
+  auto const earth = MakeEarthBody(solar_system_2000, max_degree);
+  Geopotential<ICRS> const geopotential(&earth, /*tolerance=*/0);
+
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1e7, 1e7);
+  std::vector<Displacement<ICRS>> displacements;
+  std::vector<Length> norms;
+  std::vector<Square<Length>> norms²;
+  std::vector<Exponentiation<Length, -3>> one_over_norms³;
+  for (int i = 0; i < 1e3; ++i) {
+    displacements.push_back(earth.FromSurfaceFrame<ITRS>(Instant())(
+        Displacement<ITRS>({distribution(random) * Metre,
+                            distribution(random) * Metre,
+                            distribution(random) * Metre})));
+    norms².push_back(displacements.back().Norm²());
+    norms.push_back(Sqrt(norms².back()));
+    one_over_norms³.push_back(norms.back() / (norms².back() * norms².back()));
+  }
+
+  std::vector<Vector<Exponentiation<Length, -2>, ICRS>> accelerations;
+  for (auto _ : state) {
+    geopotential.GeneralSphericalHarmonicsAccelerations(Instant(),
+                                                        displacements,
+                                                        norms,
+                                                        norms²,
+                                                        one_over_norms³,
+                                                        accelerations);
+    benchmark::DoNotOptimize(accelerations);
+  }
+}
+
 void BM_ComputeGeopotentialDistance(benchmark::State& state) {
   // Check the performance around this distance.  May be used to tell apart the
   // various contributions.
@@ -248,6 +287,12 @@ BENCHMARK(BM_ComputeGeopotentialCpp)
     ->Arg(5)
     ->Arg(10)
     ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ComputeGeopotentialCppBatched)
+    ->Arg(2)
+    ->Arg(3)
+    ->Arg(5)
+    ->Arg(10)
+    ->Unit(benchmark::kMicrosecond);
 BENCHMARK(BM_ComputeGeopotentialF90)
     ->Arg(2)
     ->Arg(3)
@@ -1,8 +1,10 @@
 // .\Release\x64\benchmarks.exe --benchmark_filter=MLSL --benchmark_repetitions=1  // NOLINT(whitespace/line_length)
 
 #include <cstdint>
+#include <memory>
 
 #include "absl/strings/str_cat.h"
+#include "base/thread_pool.hpp"
 #include "benchmark/benchmark.h"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
@@ -16,6 +18,7 @@
 namespace principia {
 namespace numerics {
 
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_space;
@@ -27,9 +30,16 @@ using namespace principia::testing_utilities::_optimization_test_functions;
 
 using World = Frame<struct WorldTag>;
 
+// Returns a pool with the given number of threads, or null if |threads| is 0,
+// in which case the local searches are sequential.
+std::unique_ptr<ThreadPool<void>> MakePool(std::int64_t const threads) {
+  return threads == 0 ? nullptr : std::make_unique<ThreadPool<void>>(threads);
+}
+
 void BM_MLSLBranin(benchmark::State& state) {
   std::int64_t const points_per_round = state.range(0);
   std::int64_t const number_of_rounds = state.range(1);
+  auto const pool = MakePool(/*threads=*/state.range(2));
 
   using Optimizer =
       MultiLevelSingleLinkage<double, Displacement<World>, /*dimensions=*/2>;
@@ -64,7 +74,8 @@ void BM_MLSLBranin(benchmark::State& state) {
   for (auto _ : state) {
     total_minima +=
         optimizer.FindGlobalMinima(points_per_round,
-                                   number_of_rounds, tolerance).size();
+                                   number_of_rounds, tolerance,
+                                   pool.get()).size();
   }
   state.SetLabel(
       absl::StrCat("number of minima: ",
@@ -74,6 +85,7 @@ void BM_MLSLBranin(benchmark::State& state) {
 void BM_MLSLGoldsteinPrice(benchmark::State& state) {
   std::int64_t const points_per_round = state.range(0);
   std::int64_t const number_of_rounds = state.range(1);
+  auto const pool = MakePool(/*threads=*/state.range(2));
 
   using Optimizer =
       MultiLevelSingleLinkage<double, Displacement<World>, /*dimensions=*/2>;
@@ -108,7 +120,8 @@ void BM_MLSLGoldsteinPrice(benchmark::State& state) {
   for (auto _ : state) {
     total_minima +=
         optimizer.FindGlobalMinima(points_per_round,
-                                   number_of_rounds, tolerance).size();
+                                   number_of_rounds, tolerance,
+                                   pool.get()).size();
   }
   state.SetLabel(
       absl::StrCat("number of minima: ",
@@ -118,6 +131,7 @@ void BM_MLSLGoldsteinPrice(benchmark::State& state) {
 void BM_MLSLHartmann3(benchmark::State& state) {
   std::int64_t const points_per_round = state.range(0);
   std::int64_t const number_of_rounds = state.range(1);
+  auto const pool = MakePool(/*threads=*/state.range(2));
 
   using Optimizer =
       MultiLevelSingleLinkage<double, Displacement<World>, /*dimensions=*/3>;
@@ -154,16 +168,25 @@ void BM_MLSLHartmann3(benchmark::State& state) {
   for (auto _ : state) {
     total_minima +=
         optimizer.FindGlobalMinima(points_per_round,
-                                   number_of_rounds, tolerance).size();
+                                   number_of_rounds, tolerance,
+                                   pool.get()).size();
   }
   state.SetLabel(
       absl::StrCat("number of minima: ",
                    static_cast<double>(total_minima) / state.iterations()));
 }
 
-BENCHMARK(BM_MLSLBranin)->ArgsProduct({{10, 20, 50}, {10, 20, 50}});
-BENCHMARK(BM_MLSLGoldsteinPrice)->ArgsProduct({{10, 20, 50}, {10, 20, 50}});
-BENCHMARK(BM_MLSLHartmann3)->ArgsProduct({{10, 20, 50}, {10, 20, 50}});
+// The third argument is the number of threads used for the local searches, 0
+// meaning that they are sequential.
+BENCHMARK(BM_MLSLBranin)
+    ->ArgsProduct({{10, 20, 50}, {10, 20, 50}, {0}})
+    ->ArgsProduct({{50}, {50}, {1, 2, 4, 8}});
+BENCHMARK(BM_MLSLGoldsteinPrice)
+    ->ArgsProduct({{10, 20, 50}, {10, 20, 50}, {0}})
+    ->ArgsProduct({{50}, {50}, {1, 2, 4, 8}});
+BENCHMARK(BM_MLSLHartmann3)
+    ->ArgsProduct({{10, 20, 50}, {10, 20, 50}, {0}})
+    ->ArgsProduct({{50}, {50}, {1, 2, 4, 8}});
 
 }  // namespace numerics
 }  // namespace principia
@@ -1,9 +1,98 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/status_utilities.hpp"  // 🧙 For CHECK_OK.
 #include "benchmark/benchmark.h"
+#include "benchmarks/regression_harness.hpp"
 #include "glog/logging.h"
 
+using namespace principia::benchmarks::_regression_harness;
+
+namespace {
+
+// The flags of the regression harness, see regression_harness.hpp.  They are
+// removed from the command line before it is passed to Google Benchmark.
+struct HarnessFlags {
+  std::string set;
+  std::string out = "benchmark_results.json";
+  std::string baseline;
+  int cpu = -1;
+  int repetitions = 10;
+  double α = 0.05;
+  double tolerance = 0.05;
+};
+
+bool ParseHarnessFlag(std::string_view const argument, HarnessFlags& flags) {
+  auto const value_of = [argument](std::string_view const name,
+                                   std::string& value) {
+    std::string const prefix = "--harness_" + std::string(name) + "=";
+    if (argument.starts_with(prefix)) {
+      value = argument.substr(prefix.size());
+      return true;
+    }
+    return false;
+  };
+  std::string value;
+  if (value_of("set", flags.set) || value_of("out", flags.out) ||
+      value_of("baseline", flags.baseline)) {
+    return true;
+  } else if (value_of("cpu", value)) {
+    flags.cpu = std::stoi(value);
+    return true;
+  } else if (value_of("repetitions", value)) {
+    flags.repetitions = std::stoi(value);
+    return true;
+  } else if (value_of("alpha", value)) {
+    flags.α = std::stod(value);
+    return true;
+  } else if (value_of("tolerance", value)) {
+    flags.tolerance = std::stod(value);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 int __cdecl main(int argc, char* argv[]) {
   google::SetLogFilenameExtension(".log");
   google::InitGoogleLogging(argv[0]);
-  benchmark::Initialize(&argc, argv);
+
+  HarnessFlags flags;
+  std::vector<std::string> arguments;
+  for (int i = 0; i < argc; ++i) {
+    if (i == 0 || !ParseHarnessFlag(argv[i], flags)) {
+      arguments.emplace_back(argv[i]);
+    }
+  }
+  if (!flags.set.empty()) {
+    auto const filter = BenchmarkSetFilter(flags.set);
+    CHECK_OK(filter.status());
+    arguments.push_back("--benchmark_filter=" + *filter);
+    arguments.push_back("--benchmark_repetitions=" +
+                        std::to_string(flags.repetitions));
+    arguments.push_back("--benchmark_out=" + flags.out);
+    arguments.push_back("--benchmark_out_format=json");
+    AddHardwareContext();
+  }
+  if (flags.cpu >= 0) {
+    CHECK_OK(PinToCPU(flags.cpu));
+  }
+
+  std::vector<char*> benchmark_argv;
+  for (auto& argument : arguments) {
+    benchmark_argv.push_back(argument.data());
+  }
+  int benchmark_argc = benchmark_argv.size();
+  benchmark::Initialize(&benchmark_argc, benchmark_argv.data());
   benchmark::RunSpecifiedBenchmarks();
+
+  if (!flags.set.empty() && !flags.baseline.empty()) {
+    auto const regressions = CompareWithBaseline(
+        flags.out, flags.baseline, flags.α, flags.tolerance);
+    CHECK_OK(regressions.status());
+    LOG(INFO) << *regressions << " benchmarks have regressed";
+    return *regressions == 0 ? 0 : 1;
+  }
 }
@@ -203,6 +203,67 @@ void BM_VisibleSegmentsOrbitMultipleSpheres(benchmark::State& state) {
                                 static_cast<double>(visible_segments_count)));
 }
 
+void BM_VisibleSegmentsOrbitMultipleSpheresBatch(benchmark::State& state) {
+  // The camera is slightly above the x-y plane and looks towards the positive
+  // x-axis.
+  Position<World> const camera_origin(
+      World::origin +
+      Displacement<World>({-100 * Metre, 1 * Metre, 0 * Metre}));
+  RigidTransformation<World, Camera> const world_to_camera_transformation(
+      camera_origin,
+      Camera::origin,
+      OrthogonalMap<World, Camera>::Identity());
+  Perspective<World, Camera> const perspective(
+      world_to_camera_transformation.Forget<Similarity>(),
+      /*focal=*/1 * Metre);
+
+  // The first sphere is at the origin and has unit radius.
+  std::vector<Sphere<World>> spheres;
+  spheres.emplace_back(World::origin, /*radius=*/1 * Metre);
+
+  // A bunch of other spheres scattered around.
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-10.0, 10.0);
+  for (int i = 0; i < state.range(1); ++i) {
+    spheres.emplace_back(
+        World::origin + Displacement<World>({distribution(random) * Metre,
+                                             distribution(random) * Metre,
+                                             distribution(random) * Metre}),
+        /*radius=*/1 * Metre);
+  }
+
+  // A circular orbit in the x-y plane.
+  int const count = state.range(0);
+  std::vector<Segment<World>> segments;
+  for (int i = 0; i < count; ++i) {
+    Angle θ1 = 2 * π * i * Radian / static_cast<double>(count);
+    Angle θ2 = 2 * π * (i + 1) * Radian / static_cast<double>(count);
+    segments.emplace_back(
+        Position<World>(
+            World::origin +
+            Displacement<World>({10 * Cos(θ1) * Metre,
+                                 10 * Sin(θ1) * Metre,
+                                 0 * Metre})),
+        Position<World>(
+            World::origin +
+            Displacement<World>({10 * Cos(θ2) * Metre,
+                                 10 * Sin(θ2) * Metre,
+                                 0 * Metre})));
+  }
+
+  int visible_segments_size = 0;
+  for (auto _ : state) {
+    auto const visible_segments =
+        perspective.VisibleSegments(segments, spheres);
+    visible_segments_size += visible_segments.size();
+  }
+
+  state.SetLabel("average visible segments: " +
+                 std::to_string(static_cast<double>(visible_segments_size) /
+                                static_cast<double>(state.iterations() *
+                                                    count)));
+}
+
 void BM_VisibleSegmentsRandomEverywhere(benchmark::State& state) {
   // Generate random segments in the cube [-10, 10[³.
   std::uniform_real_distribution<> distribution(-10.0, 10.0);
@@ -224,6 +285,7 @@ BENCHMARK(BM_VisibleSegmentsOrbit)->Arg(10)->Arg(100)->Arg(1000);
 BENCHMARK(BM_VisibleSegmentsRandomEverywhere)->Arg(1000);
 BENCHMARK(BM_VisibleSegmentsRandomNoIntersection)->Arg(1000);
 BENCHMARK(BM_VisibleSegmentsOrbitMultipleSpheres)->Args({1000, 20});
+BENCHMARK(BM_VisibleSegmentsOrbitMultipleSpheresBatch)->Args({1000, 20});
 
 }  // namespace geometry
 }  // namespace principia
@@ -0,0 +1,125 @@
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=PiecewisePoissonSeries  // NOLINT(whitespace/line_length)
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "geometry/instant.hpp"
+#include "numerics/piecewise_poisson_series.hpp"
+#include "numerics/poisson_series.hpp"
+#include "numerics/polynomial_evaluators.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace numerics {
+
+using namespace principia::geometry::_instant;
+using namespace principia::numerics::_piecewise_poisson_series;
+using namespace principia::numerics::_poisson_series;
+using namespace principia::numerics::_polynomial_evaluators;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+
+namespace {
+
+constexpr int evaluations_per_iteration = 1000;
+constexpr int frequencies = 10;
+
+using Piecewise = PiecewisePoissonSeries<double, 0, 0, HornerEvaluator>;
+using Series = Piecewise::Series;
+
+// A piecewise Poisson series with |pieces| pieces of 1 s each, starting at
+// |t0|, each with |frequencies| periodic terms.
+Piecewise MakeSeries(Instant const& t0, int const pieces) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> coefficient_distribution(-10.0, 10.0);
+  std::uniform_real_distribution<> frequency_distribution(1.0, 100.0);
+
+  auto make_piece = [&]() {
+    Series::PolynomialsByAngularFrequency periodic;
+    for (int i = 0; i < frequencies; ++i) {
+      periodic.emplace_back(
+          frequency_distribution(random) * Radian / Second,
+          Series::Polynomials{
+              .sin = Series::PeriodicPolynomial(
+                  {coefficient_distribution(random)}, t0),
+              .cos = Series::PeriodicPolynomial(
+                  {coefficient_distribution(random)}, t0)});
+    }
+    return Series(
+        Series::AperiodicPolynomial({coefficient_distribution(random)}, t0),
+        periodic);
+  };
+
+  Piecewise series({t0, t0 + 1 * Second}, make_piece());
+  for (int i = 1; i < pieces; ++i) {
+    series.Append({t0 + i * Second, t0 + (i + 1) * Second}, make_piece());
+  }
+  return series;
+}
+
+std::vector<Instant> MakeTimes(Instant const& t0, int const pieces) {
+  std::vector<Instant> times;
+  for (int i = 0; i < evaluations_per_iteration; ++i) {
+    times.push_back(t0 + i * pieces * Second / evaluations_per_iteration);
+  }
+  return times;
+}
+
+}  // namespace
+
+void BM_EvaluatePiecewisePoissonSeriesPointwise(benchmark::State& state) {
+  int const pieces = state.range(0);
+  Instant const t0;
+  Piecewise const series = MakeSeries(t0, pieces);
+  std::vector<Instant> const times = MakeTimes(t0, pieces);
+
+  double result = 0.0;
+  for (auto _ : state) {
+    for (Instant const& t : times) {
+      result += series(t);
+    }
+  }
+
+  // This weird call to |SetLabel| has no effect except that it uses |result|
+  // and therefore prevents the loop from being optimized away.
+  state.SetLabel(std::to_string(result).substr(0, 0));
+}
+
+void BM_EvaluatePiecewisePoissonSeriesBatch(benchmark::State& state) {
+  int const pieces = state.range(0);
+  Instant const t0;
+  Piecewise const series = MakeSeries(t0, pieces);
+  std::vector<Instant> const times = MakeTimes(t0, pieces);
+
+  double result = 0.0;
+  for (auto _ : state) {
+    for (double const value : series.Evaluate(times)) {
+      result += value;
+    }
+  }
+
+  // This weird call to |SetLabel| has no effect except that it uses |result|
+  // and therefore prevents the loop from being optimized away.
+  state.SetLabel(std::to_string(result).substr(0, 0));
+}
+
+BENCHMARK(BM_EvaluatePiecewisePoissonSeriesPointwise)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_EvaluatePiecewisePoissonSeriesBatch)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace numerics
+}  // namespace principia
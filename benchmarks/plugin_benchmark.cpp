@@ -0,0 +1,350 @@
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=PluginFrame  // NOLINT(whitespace/line_length)
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "astronomy/frames.hpp"
+#include "base/not_null.hpp"
+#include "benchmark/benchmark.h"
+#include "benchmarks/allocation_counters.hpp"
+#include "geometry/orthogonal_map.hpp"
+#include "geometry/perspective.hpp"
+#include "geometry/space.hpp"
+#include "geometry/space_transformations.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/identification.hpp"
+#include "ksp_plugin/part.hpp"
+#include "ksp_plugin/planetarium.hpp"
+#include "ksp_plugin/plugin.hpp"
+#include "ksp_plugin/vessel.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/rigid_motion.hpp"
+#include "physics/solar_system.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/solar_system_factory.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+
+using namespace principia::astronomy::_frames;
+using namespace principia::base::_not_null;
+using namespace principia::benchmarks::_allocation_counters;
+using namespace principia::geometry::_orthogonal_map;
+using namespace principia::geometry::_perspective;
+using namespace principia::geometry::_space;
+using namespace principia::geometry::_space_transformations;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::ksp_plugin::_identification;
+using namespace principia::ksp_plugin::_part;
+using namespace principia::ksp_plugin::_planetarium;
+using namespace principia::ksp_plugin::_plugin;
+using namespace principia::ksp_plugin::_vessel;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_rigid_motion;
+using namespace principia::physics::_solar_system;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_solar_system_factory;
+
+namespace {
+
+// The duration of a physics step of the game.
+constexpr Time Δt = 20 * Milli(Second);
+// One unloaded vessel in |flight_plan_period| has a flight plan.
+constexpr int flight_plan_period = 4;
+constexpr Mass part_mass = 1 * Tonne;
+constexpr int max_points = 10'000;
+
+// Accumulates the wall-clock time spent in each phase of a frame, and attaches
+// it to |state| at destruction as a counter named |<phase>_us|, in
+// microseconds per iteration.
+class PhaseTimers final {
+ public:
+  explicit PhaseTimers(benchmark::State& state) : state_(state) {}
+
+  ~PhaseTimers() {
+    for (auto const& [phase, duration] : durations_) {
+      state_.counters[phase + "_us"] = benchmark::Counter(
+          std::chrono::duration<double, std::micro>(duration).count(),
+          benchmark::Counter::kAvgIterations);
+    }
+  }
+
+  template<typename Run>
+  void Time(std::string const& phase, Run const& run) {
+    auto const start = std::chrono::steady_clock::now();
+    run();
+    durations_[phase] += std::chrono::steady_clock::now() - start;
+  }
+
+ private:
+  benchmark::State& state_;
+  std::map<std::string, std::chrono::steady_clock::duration> durations_;
+};
+
+// A plugin for the solar system at the launch of Спутник 1 with a fleet of
+// synthetic vessels, each made of a single part, on low orbits around the
+// Earth.  The first loaded vessel, or the first vessel if none is loaded, is
+// the active vessel.  The predictions are computed synchronously (the vessels
+// are not made asynchronous as in the game), so their cost is attributed to
+// the frame that requests them.
+class Fleet {
+ public:
+  Fleet(int const unloaded_vessels, int const loaded_vessels)
+      : solar_system_(SolarSystemFactory::AtСпутник1Launch(
+            SolarSystemFactory::Accuracy::MajorBodiesOnly)),
+        plugin_(make_not_null_unique<Plugin>(solar_system_->epoch_literal(),
+                                             solar_system_->epoch_literal(),
+                                             planetarium_rotation_)),
+        unloaded_vessels_(unloaded_vessels),
+        loaded_vessels_(loaded_vessels) {
+    for (int index = SolarSystemFactory::Sun;
+         index <= SolarSystemFactory::LastMajorBody;
+         ++index) {
+      std::optional<Index> parent_index =
+          index == SolarSystemFactory::Sun
+              ? std::nullopt
+              : std::make_optional(SolarSystemFactory::parent(index));
+      plugin_->InsertCelestialAbsoluteCartesian(
+          index,
+          parent_index,
+          solar_system_->gravity_model_message(
+              SolarSystemFactory::name(index)),
+          solar_system_->cartesian_initial_state_message(
+              SolarSystemFactory::name(index)));
+    }
+    plugin_->EndInitialization();
+    plugin_->SetMainBody(SolarSystemFactory::Earth);
+    plugin_->renderer().SetPlottingFrame(
+        plugin_->NewBodyCentredNonRotatingNavigationFrame(
+            SolarSystemFactory::Earth));
+
+    for (int i = 0; i < unloaded_vessels_ + loaded_vessels_; ++i) {
+      guids_.push_back(VesselGUID(i));
+    }
+    // The active vessel comes first.
+    if (loaded_vessels_ > 0) {
+      std::rotate(guids_.begin(),
+                  guids_.begin() + unloaded_vessels_,
+                  guids_.end());
+    }
+
+    // A first frame inserts the vessels and computes their predictions, which
+    // are needed for the flight plans.
+    RunFrame(/*timers=*/nullptr);
+    for (int i = 0; i < unloaded_vessels_; i += flight_plan_period) {
+      plugin_->CreateFlightPlan(VesselGUID(i),
+                                plugin_->CurrentTime() + 1 * Day,
+                                part_mass);
+    }
+  }
+
+  // Runs a game frame.  If |timers| is not null, the phases of the frame are
+  // timed.
+  void RunFrame(PhaseTimers* const timers) {
+    auto const time = [timers](std::string const& phase, auto const& run) {
+      if (timers == nullptr) {
+        run();
+      } else {
+        timers->Time(phase, run);
+      }
+    };
+    time("keep", [this]() { KeepVessels(); });
+    time("advance_time", [this]() {
+      plugin_->AdvanceTime(plugin_->CurrentTime() + Δt, planetarium_rotation_);
+    });
+    time("catch_up", [this]() {
+      VesselSet collided_vessels;
+      plugin_->CatchUpLaggingVessels(collided_vessels);
+    });
+    time("prediction", [this]() { plugin_->UpdatePrediction(guids_); });
+    time("planetarium", [this]() { Plot(); });
+  }
+
+ private:
+  GUID VesselGUID(int const i) const {
+    return "vessel " + std::to_string(i);
+  }
+
+  // The degrees of freedom of the |i|th vessel with respect to the Earth, on a
+  // circular orbit whose radius, phase and inclination depend on |i|.
+  template<typename Frame>
+  RelativeDegreesOfFreedom<Frame> InitialDegreesOfFreedom(int const i) const {
+    Length const r = 6'700 * Kilo(Metre) + i * 10 * Kilo(Metre);
+    Angle const φ = i * Radian;
+    Angle const ι = i * 10 * Degree;
+    Speed const v = Sqrt(solar_system_->gravitational_parameter(
+                             SolarSystemFactory::name(
+                                 SolarSystemFactory::Earth)) /
+                         r);
+    return RelativeDegreesOfFreedom<Frame>(
+        Displacement<Frame>({r * Cos(φ), r * Sin(φ), 0 * Metre}),
+        Velocity<Frame>({-v * Sin(φ) * Cos(ι),
+                         v * Cos(φ) * Cos(ι),
+                         v * Sin(ι)}));
+  }
+
+  // Does what the game does at the beginning of each frame: keeps all the
+  // vessels and the parts of the loaded ones, inserting them on the first
+  // frame, and collects the pile-ups.
+  void KeepVessels() {
+    bool inserted;
+    for (int i = 0; i < unloaded_vessels_; ++i) {
+      GUID const guid = VesselGUID(i);
+      plugin_->InsertOrKeepVessel(guid,
+                                  guid,
+                                  SolarSystemFactory::Earth,
+                                  /*loaded=*/false,
+                                  inserted);
+      if (inserted) {
+        plugin_->InsertUnloadedPart(
+            i, guid, guid, InitialDegreesOfFreedom<AliceSun>(i));
+      }
+    }
+    // The Earth is at the origin of |World|; the rotation of |World| is
+    // neglected when setting up the orbits, this only needs to be plausible.
+    DegreesOfFreedom<World> const earth_degrees_of_freedom(World::origin,
+                                                           World::unmoving);
+    for (int i = unloaded_vessels_;
+         i < unloaded_vessels_ + loaded_vessels_;
+         ++i) {
+      GUID const guid = VesselGUID(i);
+      plugin_->InsertOrKeepVessel(guid,
+                                  guid,
+                                  SolarSystemFactory::Earth,
+                                  /*loaded=*/true,
+                                  inserted);
+      auto const from_earth = InitialDegreesOfFreedom<World>(i);
+      RigidMotion<EccentricPart, World> const part_rigid_motion(
+          RigidTransformation<EccentricPart, World>(
+              EccentricPart::origin,
+              World::origin + from_earth.displacement(),
+              OrthogonalMap<EccentricPart, World>::Identity()),
+          World::nonrotating,
+          World::unmoving + from_earth.velocity());
+      plugin_->InsertOrKeepLoadedPart(i,
+                                      guid,
+                                      part_mass,
+                                      EccentricPart::origin,
+                                      MakeWaterSphereInertiaTensor(part_mass),
+                                      /*is_solid_rocket_motor=*/false,
+                                      guid,
+                                      SolarSystemFactory::Earth,
+                                      earth_degrees_of_freedom,
+                                      part_rigid_motion,
+                                      Δt);
+    }
+    plugin_->PrepareToReportCollisions();
+    plugin_->FreeVesselsAndPartsAndCollectPileUps(Δt);
+  }
+
+  // Does what the adapter does to render the map view: constructs a
+  // planetarium looking at the Earth from afar, and plots the predictions and
+  // flight plans of all the vessels.
+  void Plot() {
+    PartId const reference_part_id = loaded_vessels_ > 0 ? unloaded_vessels_
+                                                         : 0;
+    RigidMotion<Barycentric, World> const barycentric_to_world =
+        plugin_->BarycentricToWorld(/*reference_part_is_unmoving=*/false,
+                                    reference_part_id,
+                                    /*main_body_centre=*/World::origin);
+    Position<World> const sun_world_position =
+        plugin_
+            ->CelestialWorldDegreesOfFreedom(SolarSystemFactory::Sun,
+                                             barycentric_to_world,
+                                             plugin_->CurrentTime())
+            .position();
+    RigidTransformation<Camera, World> const camera_to_world(
+        Camera::origin,
+        World::origin + Displacement<World>({0 * Metre,
+                                             0 * Metre,
+                                             -100'000 * Kilo(Metre)}),
+        OrthogonalMap<Camera, World>::Identity());
+    Similarity<World, Navigation> const world_to_plotting =
+        plugin_->renderer().WorldToPlotting(plugin_->CurrentTime(),
+                                            sun_world_position,
+                                            plugin_->PlanetariumRotation());
+    auto const planetarium = plugin_->NewPlanetarium(
+        Planetarium::Parameters(/*sphere_radius_multiplier=*/1.0,
+                                /*angular_resolution=*/0.4 * ArcMinute,
+                                /*field_of_view=*/60 * Degree),
+        Perspective<Navigation, Camera>(
+            world_to_plotting * camera_to_world.Forget<Similarity>(),
+            /*focal=*/1 * Metre),
+        [plotting_to_world = world_to_plotting.Inverse()](
+            Position<Navigation> const& plotted_point) {
+          return ScaledSpacePoint::FromCoordinates(
+              ((plotting_to_world(plotted_point) - World::origin) /
+               (6000 * Metre)).coordinates());
+        });
+
+    for (auto const& guid : guids_) {
+      Vessel const& vessel = *plugin_->GetVessel(guid);
+      auto const prediction = vessel.prediction();
+      planetarium->PlotMethod3(*prediction,
+                               prediction->begin(),
+                               prediction->end(),
+                               plugin_->CurrentTime(),
+                               /*reverse=*/false,
+                               vertices_.data(),
+                               max_points,
+                               /*cache_samples=*/true);
+      if (vessel.has_flight_plan()) {
+        auto const& flight_plan = vessel.flight_plan();
+        for (int i = 0; i < flight_plan.number_of_segments(); ++i) {
+          auto const segment = flight_plan.GetSegment(i);
+          planetarium->PlotMethod3(*segment,
+                                   segment->begin(),
+                                   segment->end(),
+                                   plugin_->CurrentTime(),
+                                   /*reverse=*/false,
+                                   vertices_.data(),
+                                   max_points,
+                                   /*cache_samples=*/true);
+        }
+      }
+    }
+  }
+
+  Angle const planetarium_rotation_ = 1 * Radian;
+  not_null<std::unique_ptr<SolarSystem<ICRS>>> const solar_system_;
+  not_null<std::unique_ptr<Plugin>> const plugin_;
+  int const unloaded_vessels_;
+  int const loaded_vessels_;
+  // The GUIDs of all the vessels, the active vessel first.
+  std::vector<GUID> guids_;
+  std::vector<ScaledSpacePoint> vertices_ =
+      std::vector<ScaledSpacePoint>(max_points);
+};
+
+}  // namespace
+
+void BM_PluginFrame(benchmark::State& state) {
+  Fleet fleet(/*unloaded_vessels=*/state.range(0),
+              /*loaded_vessels=*/state.range(1));
+  AllocationCounters allocation_counters(state);
+  PhaseTimers timers(state);
+  for (auto _ : state) {
+    fleet.RunFrame(&timers);
+  }
+}
+
+BENCHMARK(BM_PluginFrame)
+    ->ArgNames({"unloaded", "loaded"})
+    ->Args({10, 1})
+    ->Args({100, 1})
+    ->Args({100, 4})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -1,5 +1,6 @@
 // .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=EvaluatePolynomial  // NOLINT(whitespace/line_length)
 
+#include <array>
 #include <random>
 #include <tuple>
 
@@ -106,6 +107,43 @@ void EvaluatePolynomialInMonomialBasis(benchmark::State& state) {
   state.SetLabel(ss.str().substr(0, 0));
 }
 
+// Same as above, but evaluates the polynomial at |size| arguments at a time.
+template<typename Value, typename Argument, int degree, std::size_t size,
+         template<typename, typename, int> class Evaluator>
+void EvaluateManyPolynomialInMonomialBasis(benchmark::State& state) {
+  using P = PolynomialInMonomialBasis<Value, Argument, degree, Evaluator>;
+  std::mt19937_64 random(42);
+  typename P::Coefficients coefficients;
+  RandomTupleGenerator<typename P::Coefficients, 0>::Fill(coefficients, random);
+  P const p(coefficients);
+
+  auto const min = ValueGenerator<Argument>::Get(random);
+  auto const max = ValueGenerator<Argument>::Get(random);
+  auto const Δargument = (max - min) * 1e-9;
+  std::array<Argument, size> arguments;
+  for (int i = 0; i < size; ++i) {
+    arguments[i] = min + i * Δargument;
+  }
+  auto result = Value{};
+
+  for (auto _ : state) {
+    for (int i = 0; i < evaluations_per_iteration; i += size) {
+      for (auto const& value : p.EvaluateMany(arguments)) {
+        result += value;
+      }
+      for (auto& argument : arguments) {
+        argument += static_cast<int>(size) * Δargument;
+      }
+    }
+  }
+
+  // This weird call to |SetLabel| has no effect except that it uses |result|
+  // and therefore prevents the loop from being optimized away.
+  std::stringstream ss;
+  ss << result;
+  state.SetLabel(ss.str().substr(0, 0));
+}
+
 template<template<typename, typename, int> class Evaluator>
 void BM_EvaluatePolynomialInMonomialBasisDouble(benchmark::State& state) {
   int const degree = state.range(0);
@@ -218,6 +256,59 @@ void BM_EvaluatePolynomialInMonomialBasisDisplacement(benchmark::State& state) {
   }
 }
 
+template<std::size_t size>
+void BM_EvaluateManyPolynomialInMonomialBasisDouble(benchmark::State& state) {
+  int const degree = state.range(0);
+  switch (degree) {
+    case 4:
+      EvaluateManyPolynomialInMonomialBasis<double, Time, 4, size,
+                                            HornerEvaluator>(state);
+      break;
+    case 8:
+      EvaluateManyPolynomialInMonomialBasis<double, Time, 8, size,
+                                            HornerEvaluator>(state);
+      break;
+    case 12:
+      EvaluateManyPolynomialInMonomialBasis<double, Time, 12, size,
+                                            HornerEvaluator>(state);
+      break;
+    case 16:
+      EvaluateManyPolynomialInMonomialBasis<double, Time, 16, size,
+                                            HornerEvaluator>(state);
+      break;
+    default:
+      LOG(FATAL) << "Degree " << degree
+                 << " in BM_EvaluateManyPolynomialInMonomialBasisDouble";
+  }
+}
+
+template<std::size_t size>
+void BM_EvaluateManyPolynomialInMonomialBasisDisplacement(
+    benchmark::State& state) {
+  int const degree = state.range(0);
+  switch (degree) {
+    case 4:
+      EvaluateManyPolynomialInMonomialBasis<Displacement<ICRS>, Time, 4, size,
+                                            HornerEvaluator>(state);
+      break;
+    case 8:
+      EvaluateManyPolynomialInMonomialBasis<Displacement<ICRS>, Time, 8, size,
+                                            HornerEvaluator>(state);
+      break;
+    case 12:
+      EvaluateManyPolynomialInMonomialBasis<Displacement<ICRS>, Time, 12, size,
+                                            HornerEvaluator>(state);
+      break;
+    case 16:
+      EvaluateManyPolynomialInMonomialBasis<Displacement<ICRS>, Time, 16, size,
+                                            HornerEvaluator>(state);
+      break;
+    default:
+      LOG(FATAL) << "Degree " << degree
+                 << " in BM_EvaluateManyPolynomialInMonomialBasisDisplacement";
+  }
+}
+
 BENCHMARK_TEMPLATE1(BM_EvaluatePolynomialInMonomialBasisDouble,
                     EstrinEvaluator)
     ->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMicrosecond);
@@ -243,5 +334,14 @@ BENCHMARK_TEMPLATE1(BM_EvaluatePolynomialInMonomialBasisDisplacement,
                     HornerEvaluator)
     ->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_TEMPLATE1(BM_EvaluateManyPolynomialInMonomialBasisDouble, 4)
+    ->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE1(BM_EvaluateManyPolynomialInMonomialBasisDouble, 8)
+    ->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE1(BM_EvaluateManyPolynomialInMonomialBasisDisplacement, 4)
+    ->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE1(BM_EvaluateManyPolynomialInMonomialBasisDisplacement, 8)
+    ->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMicrosecond);
+
 }  // namespace numerics
 }  // namespace principia
@@ -0,0 +1,220 @@
+#include "benchmarks/regression_harness.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "base/cpu_dispatch.hpp"
+#include "base/cpuid.hpp"
+#include "base/macros.hpp"  // 🧙 For OS_LINUX, OS_WIN.
+#include "base/version.hpp"
+#include "benchmark/benchmark.h"
+#include "glog/logging.h"
+#include "google/protobuf/struct.pb.h"
+#include "google/protobuf/util/json_util.h"
+
+#if OS_WIN
+#include <windows.h>
+#elif OS_LINUX
+#include <sched.h>
+#endif
+
+namespace principia {
+namespace benchmarks {
+namespace _regression_harness {
+namespace internal {
+
+using namespace principia::base::_cpu_dispatch;
+using namespace principia::base::_cpuid;
+using namespace principia::base::_version;
+
+namespace {
+
+// The real times of the repetitions of each benchmark, in nanoseconds.
+using Samples = std::map<std::string, std::vector<double>>;
+
+absl::StatusOr<Samples> ReadSamples(std::filesystem::path const& path) {
+  std::ifstream file(path);
+  if (!file.good()) {
+    return absl::NotFoundError(absl::StrCat("Cannot open ", path.string()));
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  google::protobuf::Struct json;
+  if (!google::protobuf::util::JsonStringToMessage(contents.str(), &json)
+           .ok()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Cannot parse ", path.string()));
+  }
+
+  static std::map<std::string, double> const nanoseconds_per_unit = {
+      {"ns", 1}, {"us", 1e3}, {"ms", 1e6}, {"s", 1e9}};
+  Samples result;
+  for (auto const& benchmark :
+       json.fields().at("benchmarks").list_value().values()) {
+    auto const& fields = benchmark.struct_value().fields();
+    // Skip the aggregates (mean, median, etc.), we compute our own statistics.
+    if (fields.count("run_type") > 0 &&
+        fields.at("run_type").string_value() != "iteration") {
+      continue;
+    }
+    std::string const& name = fields.count("run_name") > 0
+                                  ? fields.at("run_name").string_value()
+                                  : fields.at("name").string_value();
+    result[name].push_back(
+        fields.at("real_time").number_value() *
+        nanoseconds_per_unit.at(fields.at("time_unit").string_value()));
+  }
+  return result;
+}
+
+double Median(std::vector<double> samples) {
+  CHECK(!samples.empty());
+  auto const middle = samples.begin() + samples.size() / 2;
+  std::nth_element(samples.begin(), middle, samples.end());
+  if (samples.size() % 2 == 1) {
+    return *middle;
+  } else {
+    return (*middle + *std::max_element(samples.begin(), middle)) / 2;
+  }
+}
+
+// The two-sided p-value of the Mann-Whitney U test for the hypothesis that |x|
+// and |y| are drawn from the same distribution, using the normal approximation.
+double MannWhitneyPValue(std::vector<double> const& x,
+                         std::vector<double> const& y) {
+  std::vector<std::pair<double, int>> all;
+  for (double const value : x) {
+    all.emplace_back(value, 0);
+  }
+  for (double const value : y) {
+    all.emplace_back(value, 1);
+  }
+  std::sort(all.begin(), all.end());
+
+  // Sum of the ranks of |x|, with the ties given their average rank.
+  double x_rank_sum = 0;
+  for (int i = 0; i < all.size();) {
+    int j = i;
+    while (j < all.size() && all[j].first == all[i].first) {
+      ++j;
+    }
+    double const average_rank = (i + 1 + j) / 2.0;
+    for (int k = i; k < j; ++k) {
+      if (all[k].second == 0) {
+        x_rank_sum += average_rank;
+      }
+    }
+    i = j;
+  }
+
+  double const n_x = x.size();
+  double const n_y = y.size();
+  double const u = x_rank_sum - n_x * (n_x + 1) / 2;
+  double const μ = n_x * n_y / 2;
+  double const σ = std::sqrt(n_x * n_y * (n_x + n_y + 1) / 12);
+  double const z = (u - μ) / σ;
+  return std::erfc(std::abs(z) / std::sqrt(2.0));
+}
+
+}  // namespace
+
+absl::StatusOr<std::string> BenchmarkSetFilter(std::string_view const name) {
+  static std::map<std::string, std::string, std::less<>> const sets = {
+      {"ephemeris", "BM_(Ephemeris|ComputeGeopotential)"},
+      {"frames",
+       "BM_(BarycentricRotating|BodyCentredNonRotating)ReferenceFrame"},
+      {"plugin", "BM_(Planetarium|PluginFrame|VisibleSegments)"},
+      {"trajectories", "BM_(DiscreteTrajectory|Checkpointer)"},
+      {"regression",
+       "BM_(Ephemeris|ComputeGeopotential|BarycentricRotatingReferenceFrame|"
+       "BodyCentredNonRotatingReferenceFrame|Planetarium|VisibleSegments|"
+       "DiscreteTrajectory|Checkpointer)"},
+  };
+  auto const it = sets.find(name);
+  if (it == sets.end()) {
+    return absl::NotFoundError(absl::StrCat("No benchmark set ", name));
+  }
+  return it->second;
+}
+
+absl::Status PinToCPU(int const cpu) {
+#if OS_WIN
+  if (SetProcessAffinityMask(GetCurrentProcess(),
+                             DWORD_PTR{1} << cpu) == 0) {
+    return absl::InternalError(
+        absl::StrCat("SetProcessAffinityMask failed: ", GetLastError()));
+  }
+  return absl::OkStatus();
+#elif OS_LINUX
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  if (sched_setaffinity(/*pid=*/0, sizeof(cpu_set), &cpu_set) != 0) {
+    return absl::InternalError(
+        absl::StrCat("sched_setaffinity failed: ", errno));
+  }
+  return absl::OkStatus();
+#else
+  return absl::UnimplementedError("Cannot pin to a CPU on this platform");
+#endif
+}
+
+void AddHardwareContext() {
+  benchmark::AddCustomContext("principia_version", Version);
+  benchmark::AddCustomContext("principia_build_date", BuildDate);
+  benchmark::AddCustomContext("cpu_vendor", CPUVendorIdentificationString());
+  benchmark::AddCustomContext(
+      "cpu_instruction_set",
+      std::string(InstructionSetName(SupportedInstructionSet())));
+}
+
+absl::StatusOr<int> CompareWithBaseline(std::filesystem::path const& results,
+                                        std::filesystem::path const& baseline,
+                                        double const α,
+                                        double const tolerance) {
+  auto const new_samples = ReadSamples(results);
+  if (!new_samples.ok()) {
+    return new_samples.status();
+  }
+  auto const old_samples = ReadSamples(baseline);
+  if (!old_samples.ok()) {
+    return old_samples.status();
+  }
+
+  int regressions = 0;
+  for (auto const& [name, new_times] : *new_samples) {
+    auto const it = old_samples->find(name);
+    if (it == old_samples->end()) {
+      LOG(INFO) << name << ": not in the baseline";
+      continue;
+    }
+    auto const& old_times = it->second;
+    double const old_median = Median(old_times);
+    double const new_median = Median(new_times);
+    double const p = MannWhitneyPValue(old_times, new_times);
+    double const change = new_median / old_median - 1;
+    bool const regressed = p < α && change > tolerance;
+    if (regressed) {
+      ++regressions;
+    }
+    LOG(INFO) << (regressed ? "REGRESSION " : "") << name << ": "
+              << old_median << " ns -> " << new_median << " ns ("
+              << std::showpos << 100 * change << std::noshowpos
+              << " %, p = " << p << ")";
+  }
+  return regressions;
+}
+
+}  // namespace internal
+}  // namespace _regression_harness
+}  // namespace benchmarks
+}  // namespace principia
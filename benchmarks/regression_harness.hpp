@@ -0,0 +1,54 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+namespace principia {
+namespace benchmarks {
+namespace _regression_harness {
+namespace internal {
+
+// A harness to detect performance regressions.  It runs a named set of
+// benchmarks with repetitions, on a pinned CPU, writes the results in the JSON
+// format of Google Benchmark together with a fingerprint of the hardware, and
+// compares them with a baseline produced by an earlier run.  Usage:
+//   benchmarks --harness_set=regression --harness_cpu=2
+//              --harness_out=results.json --harness_baseline=baseline.json
+
+// Returns the benchmark filter for the set with the given |name|.
+absl::StatusOr<std::string> BenchmarkSetFilter(std::string_view name);
+
+// Restricts the current process to run on the given |cpu|, to reduce the noise
+// caused by migrations between cores.
+absl::Status PinToCPU(int cpu);
+
+// Adds the identification of the processor, its supported instruction set and
+// the version of Principia to the context written with the results.
+void AddHardwareContext();
+
+// Compares the results in |results| with those in |baseline|, both JSON files
+// written by Google Benchmark with repetitions.  For each benchmark present in
+// both, the distributions of the real times of the repetitions are compared
+// using a Mann-Whitney U test.  A benchmark has regressed if the difference is
+// significant at the level |α| and if the median has increased by more than
+// |tolerance| (a fraction).  Logs a summary and returns the number of
+// benchmarks that have regressed.
+absl::StatusOr<int> CompareWithBaseline(std::filesystem::path const& results,
+                                        std::filesystem::path const& baseline,
+                                        double α,
+                                        double tolerance);
+
+}  // namespace internal
+
+using internal::AddHardwareContext;
+using internal::BenchmarkSetFilter;
+using internal::CompareWithBaseline;
+using internal::PinToCPU;
+
+}  // namespace _regression_harness
+}  // namespace benchmarks
+}  // namespace principia
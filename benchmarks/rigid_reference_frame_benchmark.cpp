@@ -1,4 +1,5 @@
 // .\Release\x64\benchmarks.exe --benchmark_filter=RigidReferenceFrame --benchmark_repetitions=5  // NOLINT(whitespace/line_length)
+// .\Release\x64\benchmarks.exe --benchmark_filter=Rotation --benchmark_repetitions=5  // NOLINT(whitespace/line_length)
 
 #include <utility>
 #include <vector>
@@ -7,7 +8,12 @@
 #include "base/status_utilities.hpp"  // 🧙 For CHECK_OK.
 #include "benchmark/benchmark.h"
 #include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
+#include "geometry/quaternion.hpp"
+#include "geometry/r3_element.hpp"
+#include "geometry/r3x3_matrix.hpp"
+#include "geometry/rotation.hpp"
 #include "geometry/space.hpp"
 #include "integrators/methods.hpp"
 #include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
@@ -32,7 +38,12 @@ namespace physics {
 
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
+using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
+using namespace principia::geometry::_quaternion;
+using namespace principia::geometry::_r3_element;
+using namespace principia::geometry::_r3x3_matrix;
+using namespace principia::geometry::_rotation;
 using namespace principia::geometry::_space;
 using namespace principia::integrators::_methods;
 using namespace principia::integrators::_symplectic_runge_kutta_nyström_integrator;  // NOLINT
@@ -211,6 +222,52 @@ void BM_BarycentricRotatingReferenceFrame(benchmark::State& state) {
   }
 }
 
+std::vector<Displacement<Barycentric>> Displacements(int const size) {
+  std::vector<Displacement<Barycentric>> result;
+  result.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    result.push_back(Displacement<Barycentric>(
+        {i * Metre, (size - i) * Metre, (i % 7) * Metre}));
+  }
+  return result;
+}
+
+Rotation<Barycentric, Rendering> const rotation(
+    Quaternion(0.5, R3Element<double>(0.5, -0.5, 0.5)));
+
+// Applies a |Rotation| to many vectors, the way |Rotation::operator()| does,
+// from its quaternion.
+void BM_RotationByQuaternion(benchmark::State& state) {
+  auto const displacements = Displacements(state.range(0));
+  std::vector<Displacement<Rendering>> rotated(displacements.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < displacements.size(); ++i) {
+      rotated[i] = rotation(displacements[i]);
+    }
+    benchmark::DoNotOptimize(rotated.data());
+  }
+}
+
+// Applies the same rotation through a matrix computed once, to measure what
+// caching a matrix in |Rotation| would save.
+void BM_RotationByMatrix(benchmark::State& state) {
+  auto const displacements = Displacements(state.range(0));
+  std::vector<Displacement<Rendering>> rotated(displacements.size());
+  R3x3Matrix<double> const matrix =
+      R3x3Matrix<double>(
+          rotation(Vector<double, Barycentric>(BasisVector(0))).coordinates(),
+          rotation(Vector<double, Barycentric>(BasisVector(1))).coordinates(),
+          rotation(Vector<double, Barycentric>(BasisVector(2))).coordinates())
+          .Transpose();
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < displacements.size(); ++i) {
+      rotated[i] =
+          Displacement<Rendering>(matrix * displacements[i].coordinates());
+    }
+    benchmark::DoNotOptimize(rotated.data());
+  }
+}
+
 int const iterations = (1000 << 10) + 1;
 
 BENCHMARK(BM_BodyCentredNonRotatingReferenceFrame)
@@ -219,6 +276,8 @@ BENCHMARK(BM_BodyCentredNonRotatingReferenceFrame)
 BENCHMARK(BM_BarycentricRotatingReferenceFrame)
     ->Arg(iterations)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RotationByQuaternion)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_RotationByMatrix)->Arg(1 << 10)->Arg(1 << 16);
 
 }  // namespace physics
 }  // namespace principia
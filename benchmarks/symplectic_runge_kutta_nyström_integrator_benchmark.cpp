@@ -3,11 +3,15 @@
 #define GLOG_NO_ABBREVIATED_SEVERITIES
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
+#include <new>
 #include <vector>
 
 #include "base/status_utilities.hpp"  // 🧙 For CHECK_OK.
 #include "benchmark/benchmark.h"
+#include "benchmarks/allocation_counters.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
@@ -21,12 +25,41 @@
 #include "quantities/si.hpp"
 #include "testing_utilities/integration.hpp"
 
+// In debug builds, count the heap allocations so that we can check that the
+// integrator doesn't allocate as it steps.
+#if !defined(PRINCIPIA_COUNT_ALLOCATIONS) && defined(_DEBUG)
+#define PRINCIPIA_COUNT_ALLOCATIONS 1
+#endif
+
+#if PRINCIPIA_COUNT_ALLOCATIONS
+namespace {
+thread_local std::int64_t number_of_allocations = 0;
+}  // namespace
+
+void* operator new(std::size_t const size) {
+  ++number_of_allocations;
+  if (void* const p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* const p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* const p, std::size_t) noexcept {
+  std::free(p);
+}
+#endif
+
 namespace principia {
 namespace integrators {
 
 using ::std::placeholders::_1;
 using ::std::placeholders::_2;
 using ::std::placeholders::_3;
+using namespace principia::benchmarks::_allocation_counters;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
@@ -74,15 +107,34 @@ void SolveHarmonicOscillatorAndComputeError1D(benchmark::State& state,
   InitialValueProblem<ODE1D> problem;
   problem.equation = harmonic_oscillator;
   problem.initial_state = {t_initial, {q_initial}, {v_initial}};
+#if PRINCIPIA_COUNT_ALLOCATIONS
+  // The allocations made by |append_state| are not the integrator's.
+  std::int64_t append_state_allocations = 0;
+  auto const append_state = [&append_state_allocations,
+                             &solution](ODE1D::State const& state) {
+    std::int64_t const allocations_before = number_of_allocations;
+    solution.emplace_back(state);
+    append_state_allocations += number_of_allocations - allocations_before;
+  };
+#else
   auto const append_state = [&solution](ODE1D::State const& state) {
     solution.emplace_back(state);
   };
+#endif
 
   auto const instance = integrator.NewInstance(problem, append_state, step);
 
+#if PRINCIPIA_COUNT_ALLOCATIONS
+  std::int64_t const allocations_before = number_of_allocations;
+#endif
   state.ResumeTiming();
   CHECK_OK(instance->Solve(t_final));
   state.PauseTiming();
+#if PRINCIPIA_COUNT_ALLOCATIONS
+  CHECK_EQ(0,
+           number_of_allocations - allocations_before -
+               append_state_allocations);
+#endif
 
   q_error = Length();
   v_error = Speed();
@@ -126,15 +178,34 @@ void SolveHarmonicOscillatorAndComputeError3D(benchmark::State& state,
   InitialValueProblem<ODE3D> problem;
   problem.equation = harmonic_oscillator;
   problem.initial_state = {t_initial, {World::origin + q_initial}, {v_initial}};
+#if PRINCIPIA_COUNT_ALLOCATIONS
+  // The allocations made by |append_state| are not the integrator's.
+  std::int64_t append_state_allocations = 0;
+  auto const append_state = [&append_state_allocations,
+                             &solution](ODE3D::State const& state) {
+    std::int64_t const allocations_before = number_of_allocations;
+    solution.emplace_back(state);
+    append_state_allocations += number_of_allocations - allocations_before;
+  };
+#else
   auto const append_state = [&solution](ODE3D::State const& state) {
     solution.emplace_back(state);
   };
+#endif
 
   auto const instance = integrator.NewInstance(problem, append_state, step);
 
+#if PRINCIPIA_COUNT_ALLOCATIONS
+  std::int64_t const allocations_before = number_of_allocations;
+#endif
   state.ResumeTiming();
   CHECK_OK(instance->Solve(t_final));
   state.PauseTiming();
+#if PRINCIPIA_COUNT_ALLOCATIONS
+  CHECK_EQ(0,
+           number_of_allocations - allocations_before -
+               append_state_allocations);
+#endif
 
   q_error = Length();
   v_error = Speed();
@@ -158,6 +229,7 @@ void BM_SymplecticRungeKuttaNyströmIntegratorSolveHarmonicOscillator1D(
     benchmark::State& state) {
   Length q_error;
   Speed v_error;
+  AllocationCounters allocation_counters(state);
   for (auto _ : state) {
     SolveHarmonicOscillatorAndComputeError1D(
         state,
@@ -175,6 +247,7 @@ void BM_SymplecticRungeKuttaNyströmIntegratorSolveHarmonicOscillator3D(
     benchmark::State& state) {
   Length q_error;
   Speed v_error;
+  AllocationCounters allocation_counters(state);
   for (auto _ : state) {
     SolveHarmonicOscillatorAndComputeError3D(
         state,
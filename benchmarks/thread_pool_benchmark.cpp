@@ -100,6 +100,23 @@ void BM_ThreadPoolExclusiveLock(benchmark::State& state) {
   }
 }
 
+// Small calls, for which the cost of the pool dominates.
+void BM_ThreadPoolSmallCalls(benchmark::State& state) {
+  ThreadPool<void> pool(/*pool_size=*/state.range(0));
+  for (auto _ : state) {
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 1000; ++i) {
+      futures.push_back(pool.Add([]() {
+        double const result = ComsumeCpuNoLock(10);
+        benchmark::DoNotOptimize(result);
+      }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+}
+
 BENCHMARK(BM_ThreadPoolNoLock)
     ->Arg(1)
     ->Arg(2)
@@ -130,6 +147,16 @@ BENCHMARK(BM_ThreadPoolExclusiveLock)
     ->Arg(7)
     ->Arg(8)
     ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ThreadPoolSmallCalls)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(3)
+    ->Arg(4)
+    ->Arg(5)
+    ->Arg(6)
+    ->Arg(7)
+    ->Arg(8)
+    ->Unit(benchmark::kMicrosecond);
 
 }  // namespace base
 }  // namespace principia
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "base/array.hpp"
+#include "geometry/grassmann.hpp"
 #include "geometry/rp2_point.hpp"
 #include "geometry/space.hpp"
 #include "geometry/space_transformations.hpp"
@@ -18,6 +19,7 @@ namespace _perspective {
 namespace internal {
 
 using namespace principia::base::_array;
+using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_rp2_point;
 using namespace principia::geometry::_space;
 using namespace principia::geometry::_space_transformations;
@@ -66,6 +68,19 @@ class Perspective final {
   bool IsHiddenBySphere(Position<FromFrame> const& point,
                         Sphere<FromFrame> const& sphere) const;
 
+  // Returns true if all the points of the |hidden| sphere are hidden by the
+  // |hiding| sphere in this perspective.  May return false for a sphere that
+  // is hidden, e.g., if the camera is within either sphere.
+  bool IsHiddenBySphere(Sphere<FromFrame> const& hidden,
+                        Sphere<FromFrame> const& hiding) const;
+
+  // Returns true if all the points of |sphere| are in front of the focal plane
+  // or outside of the cone of half-angle atan(|tan_field_of_view|) around the
+  // optical axis.  May return false for a sphere that is barely outside of the
+  // field of view.
+  bool IsOutsideFieldOfView(Sphere<FromFrame> const& sphere,
+                            double tan_field_of_view) const;
+
   // Returns sin² α where α is the half angle under which the |sphere| is seen.
   double SphereSin²HalfAngle(Sphere<FromFrame> const& sphere) const;
 
@@ -82,7 +97,37 @@ class Perspective final {
       Segment<FromFrame> const& segment,
       std::vector<Sphere<FromFrame>> const& spheres) const;
 
+  // Same as above, but for a batch of |segments|, typically the consecutive
+  // segments of a polyline.  The segments are processed in chunks, and a
+  // sphere is only considered for the segments of a chunk if its visual cone
+  // intersects the visual cone of a bounding sphere of the chunk.  The result
+  // is the concatenation of the results for the individual segments.
+  Segments<FromFrame> VisibleSegments(
+      Segments<FromFrame> const& segments,
+      std::vector<Sphere<FromFrame>> const& spheres) const;
+
  private:
+  // The cone with apex at the camera that is tangent to a sphere.
+  struct VisualCone {
+    // True if the camera is inside the sphere.  The other fields are not
+    // meaningful in that case.
+    bool contains_camera;
+    Vector<double, FromFrame> axis;
+    double cos_half_angle;
+    double sin_half_angle;
+  };
+
+  // The number of segments that share a bounding sphere in the batched
+  // |VisibleSegments|.
+  static constexpr int segments_per_chunk_ = 16;
+
+  VisualCone MakeVisualCone(Position<FromFrame> const& centre,
+                            Square<Length> const& radius²) const;
+
+  // Returns false if the cones are disjoint.  May return true for cones that
+  // are disjoint but very close to each other.
+  static bool Intersect(VisualCone const& cone1, VisualCone const& cone2);
+
   Similarity<ToFrame, FromFrame> const from_camera_;
   Similarity<FromFrame, ToFrame> const to_camera_;
   Position<FromFrame> const camera_;
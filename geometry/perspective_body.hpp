@@ -3,12 +3,12 @@
 #include "geometry/perspective.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <utility>
 #include <vector>
 
 #include "geometry/barycentre_calculator.hpp"
-#include "geometry/grassmann.hpp"
 #include "geometry/r3_element.hpp"
 #include "numerics/root_finders.hpp"
 #include "quantities/elementary_functions.hpp"
@@ -19,7 +19,6 @@ namespace _perspective {
 namespace internal {
 
 using namespace principia::geometry::_barycentre_calculator;
-using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_r3_element;
 using namespace principia::numerics::_root_finders;
 using namespace principia::quantities::_elementary_functions;
@@ -150,6 +149,66 @@ bool Perspective<FromFrame, ToFrame>::IsHiddenBySphere(
   return !is_in_front_of_horizon;
 }
 
+template<typename FromFrame, typename ToFrame>
+bool Perspective<FromFrame, ToFrame>::IsHiddenBySphere(
+    Sphere<FromFrame> const& hidden,
+    Sphere<FromFrame> const& hiding) const {
+  VisualCone const hidden_cone =
+      MakeVisualCone(hidden.centre(), hidden.radius²());
+  VisualCone const hiding_cone =
+      MakeVisualCone(hiding.centre(), hiding.radius²());
+  if (hidden_cone.contains_camera || hiding_cone.contains_camera) {
+    return false;
+  }
+
+  // The |hidden| cone must be within the |hiding| cone, i.e., the angle between
+  // their axes plus the half-angle of the |hidden| cone must be at most the
+  // half-angle of the |hiding| cone.
+  if (hidden_cone.sin_half_angle > hiding_cone.sin_half_angle) {
+    return false;
+  }
+  double const cos_difference_of_half_angles =
+      hiding_cone.cos_half_angle * hidden_cone.cos_half_angle +
+      hiding_cone.sin_half_angle * hidden_cone.sin_half_angle;
+  if (InnerProduct(hidden_cone.axis, hiding_cone.axis) <
+      cos_difference_of_half_angles) {
+    return false;
+  }
+
+  // The |hidden| sphere must be entirely beyond the plane of the horizon of the
+  // |hiding| sphere.  See |IsHiddenBySphere| for a point.
+  Displacement<FromFrame> const camera_to_centre = hiding.centre() - camera_;
+  auto const camera_to_centre² = camera_to_centre.Norm²();
+  Length const camera_to_horizon_plane =
+      (camera_to_centre² - hiding.radius²()) / Sqrt(camera_to_centre²);
+  return InnerProduct(hidden.centre() - camera_, hiding_cone.axis) -
+             hidden.radius() >=
+         camera_to_horizon_plane;
+}
+
+template<typename FromFrame, typename ToFrame>
+bool Perspective<FromFrame, ToFrame>::IsOutsideFieldOfView(
+    Sphere<FromFrame> const& sphere,
+    double const tan_field_of_view) const {
+  Vector<double, FromFrame> const z =
+      from_camera_.linear_map()(Vector<double, ToFrame>({0.0, 0.0, 1.0}));
+  // The same criterion as |SegmentBehindFocalPlane|, applied to the point of
+  // the sphere that is the farthest from the camera along the optical axis.
+  if (InnerProduct(sphere.centre() - camera_, z) + sphere.radius() * z.Norm() <
+      focal_) {
+    return true;
+  }
+  VisualCone const sphere_cone =
+      MakeVisualCone(sphere.centre(), sphere.radius²());
+  double const cos_field_of_view = 1 / Sqrt(1 + Pow<2>(tan_field_of_view));
+  VisualCone const field_of_view_cone{
+      .contains_camera = false,
+      .axis = z / z.Norm(),
+      .cos_half_angle = cos_field_of_view,
+      .sin_half_angle = tan_field_of_view * cos_field_of_view};
+  return !Intersect(sphere_cone, field_of_view_cone);
+}
+
 template<typename FromFrame, typename ToFrame>
 double Perspective<FromFrame, ToFrame>::SphereSin²HalfAngle(
     Sphere<FromFrame> const& sphere) const {
@@ -421,6 +480,94 @@ Segments<FromFrame> Perspective<FromFrame, ToFrame>::VisibleSegments(
   return segments;
 }
 
+template<typename FromFrame, typename ToFrame>
+Segments<FromFrame> Perspective<FromFrame, ToFrame>::VisibleSegments(
+    Segments<FromFrame> const& segments,
+    std::vector<Sphere<FromFrame>> const& spheres) const {
+  // A point may only be hidden by a sphere if it lies in the visual cone of
+  // that sphere.  The visual cones of the spheres are computed once for all
+  // the segments.
+  std::vector<VisualCone> sphere_cones;
+  sphere_cones.reserve(spheres.size());
+  for (auto const& sphere : spheres) {
+    sphere_cones.push_back(MakeVisualCone(sphere.centre(), sphere.radius²()));
+  }
+
+  Segments<FromFrame> visible_segments;
+  visible_segments.reserve(segments.size());
+  std::vector<Sphere<FromFrame>> chunk_spheres;
+  chunk_spheres.reserve(spheres.size());
+  for (int begin = 0; begin < segments.size(); begin += segments_per_chunk_) {
+    int const end = std::min(begin + segments_per_chunk_,
+                             static_cast<int>(segments.size()));
+
+    // A bounding sphere of the chunk, centred at the midpoint of its
+    // extremities.  It is tight if the chunk is a nearly straight part of a
+    // polyline.
+    Position<FromFrame> const centre =
+        Barycentre<Position<FromFrame>, double>(
+            {segments[begin].first, segments[end - 1].second}, {1, 1});
+    Square<Length> radius²;
+    for (int i = begin; i < end; ++i) {
+      radius² = std::max({radius²,
+                          (segments[i].first - centre).Norm²(),
+                          (segments[i].second - centre).Norm²()});
+    }
+    VisualCone const chunk_cone = MakeVisualCone(centre, radius²);
+
+    chunk_spheres.clear();
+    for (int j = 0; j < spheres.size(); ++j) {
+      if (Intersect(chunk_cone, sphere_cones[j])) {
+        chunk_spheres.push_back(spheres[j]);
+      }
+    }
+
+    for (int i = begin; i < end; ++i) {
+      if (chunk_spheres.empty()) {
+        visible_segments.push_back(segments[i]);
+      } else {
+        auto const segment_visible_segments =
+            VisibleSegments(segments[i], chunk_spheres);
+        std::copy(segment_visible_segments.begin(),
+                  segment_visible_segments.end(),
+                  std::back_inserter(visible_segments));
+      }
+    }
+  }
+  return visible_segments;
+}
+
+template<typename FromFrame, typename ToFrame>
+auto Perspective<FromFrame, ToFrame>::MakeVisualCone(
+    Position<FromFrame> const& centre,
+    Square<Length> const& radius²) const -> VisualCone {
+  // See VisibleSegments for the notation.
+  Displacement<FromFrame> const KC = centre - camera_;
+  auto const KC² = KC.Norm²();
+  if (KC² <= radius²) {
+    return {.contains_camera = true};
+  }
+  double const sin²_half_angle = radius² / KC²;
+  return {.contains_camera = false,
+          .axis = KC / Sqrt(KC²),
+          .cos_half_angle = Sqrt(1 - sin²_half_angle),
+          .sin_half_angle = Sqrt(sin²_half_angle)};
+}
+
+template<typename FromFrame, typename ToFrame>
+bool Perspective<FromFrame, ToFrame>::Intersect(VisualCone const& cone1,
+                                                VisualCone const& cone2) {
+  if (cone1.contains_camera || cone2.contains_camera) {
+    return true;
+  }
+  // The cones are disjoint iff the angle between their axes is larger than
+  // the sum of their half-angles, which is at most π.
+  double const cos_sum_of_half_angles =
+      cone1.cos_half_angle * cone2.cos_half_angle -
+      cone1.sin_half_angle * cone2.sin_half_angle;
+  return InnerProduct(cone1.axis, cone2.axis) >= cos_sum_of_half_angles;
+}
+
 template<typename FromFrame, typename ToFrame>
 std::ostream& operator<<(std::ostream& out,
                          Perspective<FromFrame, ToFrame> const& perspective) {
@@ -1,6 +1,9 @@
 #include "geometry/perspective.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
+#include <vector>
 
 #include "geometry/frame.hpp"
 #include "geometry/orthogonal_map.hpp"
@@ -180,6 +183,78 @@ TEST_F(PerspectiveTest, IsHiddenBySphere) {
   EXPECT_FALSE(perspective.IsHiddenBySphere(p4, sphere));
 }
 
+TEST_F(PerspectiveTest, IsSphereHiddenBySphere) {
+  Perspective<World, Camera> perspective(Similarity<World, Camera>::Identity(),
+                                         /*focal=*/1 * Metre);
+
+  Sphere<World> const sphere(
+      World::origin + Displacement<World>({10 * Metre, 20 * Metre, 30 * Metre}),
+      /*radius=*/3 * Metre);
+
+  // Far behind the sphere.
+  Sphere<World> const s1(
+      World::origin +
+          Displacement<World>({100 * Metre, 200 * Metre, 300 * Metre}),
+      /*radius=*/10 * Metre);
+  // Behind the sphere, but too large.
+  Sphere<World> const s2(
+      World::origin +
+          Displacement<World>({100 * Metre, 200 * Metre, 300 * Metre}),
+      /*radius=*/50 * Metre);
+  // Far from the sphere.
+  Sphere<World> const s3(
+      World::origin +
+          Displacement<World>({100 * Metre, 50 * Metre, -70 * Metre}),
+      /*radius=*/1 * Metre);
+  // In front of the sphere.
+  Sphere<World> const s4(
+      World::origin + Displacement<World>({2 * Metre, 4 * Metre, 6 * Metre}),
+      /*radius=*/0.1 * Metre);
+  // Containing the camera.
+  Sphere<World> const s5(World::origin, /*radius=*/1 * Metre);
+
+  EXPECT_TRUE(perspective.IsHiddenBySphere(s1, sphere));
+  EXPECT_FALSE(perspective.IsHiddenBySphere(s2, sphere));
+  EXPECT_FALSE(perspective.IsHiddenBySphere(s3, sphere));
+  EXPECT_FALSE(perspective.IsHiddenBySphere(s4, sphere));
+  EXPECT_FALSE(perspective.IsHiddenBySphere(s5, sphere));
+  EXPECT_FALSE(perspective.IsHiddenBySphere(sphere, s5));
+}
+
+TEST_F(PerspectiveTest, IsOutsideFieldOfView) {
+  Perspective<World, Camera> perspective(Similarity<World, Camera>::Identity(),
+                                         /*focal=*/1 * Metre);
+  // A field of view of 45°.
+  double const tan_field_of_view = 1;
+
+  // On the optical axis.
+  Sphere<World> const s1(
+      World::origin + Displacement<World>({0 * Metre, 0 * Metre, 10 * Metre}),
+      /*radius=*/1 * Metre);
+  // On the side, but overlapping the field of view.
+  Sphere<World> const s2(
+      World::origin + Displacement<World>({12 * Metre, 0 * Metre, 10 * Metre}),
+      /*radius=*/2 * Metre);
+  // On the side, outside of the field of view.
+  Sphere<World> const s3(
+      World::origin + Displacement<World>({20 * Metre, 0 * Metre, 10 * Metre}),
+      /*radius=*/2 * Metre);
+  // Behind the camera.
+  Sphere<World> const s4(
+      World::origin + Displacement<World>({0 * Metre, 0 * Metre, -10 * Metre}),
+      /*radius=*/2 * Metre);
+  // Between the camera and the focal plane.
+  Sphere<World> const s5(
+      World::origin + Displacement<World>({0 * Metre, 0 * Metre, 0.5 * Metre}),
+      /*radius=*/0.1 * Metre);
+
+  EXPECT_FALSE(perspective.IsOutsideFieldOfView(s1, tan_field_of_view));
+  EXPECT_FALSE(perspective.IsOutsideFieldOfView(s2, tan_field_of_view));
+  EXPECT_TRUE(perspective.IsOutsideFieldOfView(s3, tan_field_of_view));
+  EXPECT_TRUE(perspective.IsOutsideFieldOfView(s4, tan_field_of_view));
+  EXPECT_TRUE(perspective.IsOutsideFieldOfView(s5, tan_field_of_view));
+}
+
 TEST_F(PerspectiveTest, SphereSin²HalfAngle) {
   Perspective<World, Camera> perspective(Similarity<World, Camera>::Identity(),
                                          /*focal=*/1 * Metre);
@@ -623,5 +698,49 @@ TEST_F(VisibleSegmentsTest, MultipleSpheres) {
               SizeIs(3));
 }
 
+TEST_F(VisibleSegmentsTest, Batch) {
+  // A circle in the plane x-z, partly hidden by |sphere_|, and spheres that
+  // hide nothing, behind the camera or far off to the side.
+  std::vector<Sphere<World>> const spheres{
+      sphere_,
+      Sphere<World>(
+          World::origin +
+              Displacement<World>({-20 * Metre, 0 * Metre, 0 * Metre}),
+          /*radius=*/1 * Metre),
+      Sphere<World>(
+          World::origin +
+              Displacement<World>({0 * Metre, 100 * Metre, 0 * Metre}),
+          /*radius=*/1 * Metre)};
+  Segments<World> segments;
+  constexpr int count = 100;
+  for (int i = 0; i < count; ++i) {
+    Angle const θ1 = 2 * π * i * Radian / count;
+    Angle const θ2 = 2 * π * (i + 1) * Radian / count;
+    segments.emplace_back(
+        World::origin +
+            Displacement<World>({5 * Cos(θ1) * Metre,
+                                 0 * Metre,
+                                 5 * Sin(θ1) * Metre}),
+        World::origin +
+            Displacement<World>({5 * Cos(θ2) * Metre,
+                                 0 * Metre,
+                                 5 * Sin(θ2) * Metre}));
+  }
+
+  Segments<World> expected_visible_segments;
+  for (auto const& segment : segments) {
+    auto const visible_segments = perspective_.VisibleSegments(segment,
+                                                               spheres);
+    std::copy(visible_segments.begin(),
+              visible_segments.end(),
+              std::back_inserter(expected_visible_segments));
+  }
+  auto const visible_segments = perspective_.VisibleSegments(segments,
+                                                             spheres);
+  EXPECT_THAT(visible_segments, SizeIs(expected_visible_segments.size()));
+  EXPECT_LT(visible_segments.size(), count);
+  EXPECT_EQ(expected_visible_segments, visible_segments);
+}
+
 }  // namespace geometry
 }  // namespace principia
@@ -29,6 +29,12 @@ struct SphericalCoordinates;
 // An |R3Element<Scalar>| is an element of Scalar³. |Scalar| should be a vector
 // space over ℝ, represented by |double|. |R3Element| is the underlying data
 // type for more advanced strongly typed structures suchas |Multivector|.
+// The coordinates are held in a pair of 128-bit registers rather than in a
+// single 256-bit one: the operations on a single element are dominated by
+// shuffles and horizontal additions, and the binaries are not VEX-encoded
+// throughout (see #3019).  Bulk computations that benefit from 256-bit
+// registers should use a structure of arrays with a runtime-dispatched kernel,
+// as is done by |PointMasses|.
 template<typename Scalar>
 struct alignas(16) R3Element final {
  public:
@@ -74,6 +80,24 @@ struct alignas(16) R3Element final {
   };
 };
 
+// A storage form of |R3Element<Scalar>| without the padding required by the
+// SIMD registers: it occupies 3 * sizeof(Scalar) bytes instead of
+// 4 * sizeof(Scalar).  It has no arithmetic; it is meant for large containers
+// whose elements are mostly at rest, and converts to and from |R3Element| by
+// copying the coordinates.
+template<typename Scalar>
+struct PackedR3Element final {
+  constexpr PackedR3Element();
+  // Implicit, so that containers can be filled from |R3Element|s.
+  PackedR3Element(R3Element<Scalar> const& r3_element);  // NOLINT
+
+  operator R3Element<Scalar>() const;
+
+  Scalar x;
+  Scalar y;
+  Scalar z;
+};
+
 template<typename Scalar>
 struct SphericalCoordinates final {
   // Default, but prevents aggregate initialization of |SphericalCoordinates| to
@@ -225,6 +249,7 @@ using internal::FusedMultiplyAdd;
 using internal::FusedMultiplySubtract;
 using internal::Normalize;
 using internal::NormalizeOrZero;
+using internal::PackedR3Element;
 using internal::R3Element;
 using internal::RadiusLatitudeLongitude;
 using internal::SphericalCoordinates;
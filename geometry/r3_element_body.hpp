@@ -184,6 +184,21 @@ R3Element<Scalar> R3Element<Scalar>::ReadFromMessage(
           Serializer::ReadFromMessage(message.z())};
 }
 
+template<typename Scalar>
+constexpr PackedR3Element<Scalar>::PackedR3Element() : x(), y(), z() {
+  static_assert(sizeof(PackedR3Element) == 3 * sizeof(Scalar),
+                "PackedR3Element has padding");
+}
+
+template<typename Scalar>
+PackedR3Element<Scalar>::PackedR3Element(R3Element<Scalar> const& r3_element)
+    : x(r3_element.x), y(r3_element.y), z(r3_element.z) {}
+
+template<typename Scalar>
+PackedR3Element<Scalar>::operator R3Element<Scalar>() const {
+  return R3Element<Scalar>(x, y, z);
+}
+
 template<typename Scalar>
 SphericalCoordinates<Scalar>::SphericalCoordinates() {}
 
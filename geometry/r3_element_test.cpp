@@ -1,6 +1,7 @@
 #include "geometry/r3_element.hpp"
 
 #include <functional>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
@@ -202,6 +203,16 @@ TEST_F(R3ElementTest, SerializationSuccess) {
   EXPECT_EQ(d1, d2);
 }
 
+TEST_F(R3ElementTest, Packed) {
+  static_assert(sizeof(PackedR3Element<Speed>) == 3 * sizeof(Speed));
+  static_assert(sizeof(R3Element<Speed>) == 4 * sizeof(Speed));
+  std::vector<PackedR3Element<Speed>> const packed = {u_, v_, w_};
+  EXPECT_EQ(u_, R3Element<Speed>(packed[0]));
+  EXPECT_EQ(v_, R3Element<Speed>(packed[1]));
+  EXPECT_EQ(w_, R3Element<Speed>(packed[2]));
+  EXPECT_EQ(null_velocity_, R3Element<Speed>(PackedR3Element<Speed>()));
+}
+
 TEST_F(R3ElementTest, SphericalCoordinates) {
   R3Element<Length> x{1 * Metre, 0 * Metre, 0 * Metre};
   R3Element<Length> y{0 * Metre, 1 * Metre, 0 * Metre};
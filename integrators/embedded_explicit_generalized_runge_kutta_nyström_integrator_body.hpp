@@ -49,6 +49,8 @@ absl::Status EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator<
   using Velocity = typename ODE::DependentVariableDerivative;
   using Acceleration = typename ODE::DependentVariableDerivative2;
 
+  typename Integrator<ODE>::Instance::SolveTimer const timer(*this);
+
   auto const& a = integrator_.a_;
   auto const& aʹ = integrator_.aʹ_;
   auto const& b̂ = integrator_.b̂_;
@@ -193,8 +195,8 @@ absl::Status EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator<
           q_stage[k] = q̂[k].value + h * c[i] * v̂[k].value + h² * Σⱼ_aᵢⱼ_gⱼₖ;
           v_stage[k] = v̂[k].value + h * Σⱼ_aʹᵢⱼ_gⱼₖ;
         }
-        step_status.Update(
-            equation.compute_acceleration(t_stage, q_stage, v_stage, g[i]));
+        step_status.Update(this->Evaluate(
+            equation.compute_acceleration, t_stage, q_stage, v_stage, g[i]));
       }
 
       // Increment computation and step size control.
@@ -222,6 +224,9 @@ absl::Status EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator<
       }
       tolerance_to_error_ratio =
           this->tolerance_to_error_ratio_(h, current_state, error_estimate);
+      if (tolerance_to_error_ratio < 1.0) {
+        this->RecordRejectedStep();
+      }
     } while (tolerance_to_error_ratio < 1.0);
 
     status.Update(step_status);
@@ -244,6 +249,7 @@ absl::Status EmbeddedExplicitGeneralizedRungeKuttaNyströmIntegrator<
       q̂[k].Increment(Δq̂[k]);
       v̂[k].Increment(Δv̂[k]);
     }
+    this->RecordAcceptedStep(h);
     append_state(current_state);
     RETURN_IF_STOPPED;  // After the state has been updated.
     ++step_count;
@@ -54,6 +54,8 @@ Solve(typename ODE::IndependentVariable const& s_final) {
   using DependentVariableDerivatives =
       typename ODE::DependentVariableDerivatives;
 
+  typename Integrator<ODE>::Instance::SolveTimer const timer(*this);
+
   auto const& a = integrator_.a_;
   auto const& b̂ = integrator_.b̂_;
   auto const& b = integrator_.b_;
@@ -120,7 +122,8 @@ Solve(typename ODE::IndependentVariable const& s_final) {
   absl::Status step_status;
 
   if (first_same_as_last) {
-    status = equation.compute_derivative(s.value, y_stage, last_f);
+    status = this->Evaluate(equation.compute_derivative,
+                            s.value, y_stage, last_f);
   }
 
   // No step size control on the first step.  If this instance is being
@@ -193,7 +196,8 @@ Solve(typename ODE::IndependentVariable const& s_final) {
                 y_stage = ŷ.value + Σⱼ_aᵢⱼ_kⱼ;
               });
 
-          step_status.Update(equation.compute_derivative(s_stage, y_stage, f));
+          step_status.Update(this->Evaluate(
+              equation.compute_derivative, s_stage, y_stage, f));
         }
         for_all_of(f, k[i]).loop([h](auto const& f, auto& kᵢ) {
           kᵢ = h * f;
@@ -220,6 +224,9 @@ Solve(typename ODE::IndependentVariable const& s_final) {
       }
       tolerance_to_error_ratio =
           this->tolerance_to_error_ratio_(h, current_state, error_estimate);
+      if (tolerance_to_error_ratio < 1.0) {
+        this->RecordRejectedStep();
+      }
     } while (tolerance_to_error_ratio < 1.0);
 
     status.Update(step_status);
@@ -240,6 +247,7 @@ Solve(typename ODE::IndependentVariable const& s_final) {
       ŷ.Increment(Δŷ);
     });
 
+    this->RecordAcceptedStep(h);
     append_state(current_state);
     RETURN_IF_STOPPED;  // After the state has been updated.
     ++step_count;
@@ -10,12 +10,15 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "base/not_null.hpp"
 #include "base/traits.hpp"
 #include "geometry/instant.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
+#include "numerics/double_precision.hpp"
 #include "numerics/fixed_arrays.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
@@ -31,6 +34,7 @@ using namespace principia::base::_traits;
 using namespace principia::geometry::_instant;
 using namespace principia::integrators::_integrators;
 using namespace principia::integrators::_ordinary_differential_equations;
+using namespace principia::numerics::_double_precision;
 using namespace principia::numerics::_fixed_arrays;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
@@ -110,7 +114,42 @@ class EmbeddedExplicitRungeKuttaNyströmIntegrator
         bool first_use,
         EmbeddedExplicitRungeKuttaNyströmIntegrator const& integrator);
 
+    // Returns the state at |t|, which must lie within the last step whose final
+    // state was passed to |append_state|.  This is typically called by
+    // |append_state| to sample the solution between the steps.  The interpolant
+    // is the quintic Hermite polynomial matching the positions, velocities and
+    // accelerations at both ends of the step.  The accelerations are stage
+    // values, so no right-hand side evaluation is needed; this requires the
+    // FSAL property.
+    typename ODE::State DenseOutput(Instant const& t) const;
+
+    // An event is a zero of |function| along the solution, for instance a zero
+    // of r·v for an apsis.  When |function| changes sign over an accepted step,
+    // the zero is located by Brent's method on the |DenseOutput| and |on_event|
+    // is called with the state at the zero, before the end of the step is
+    // passed to |append_state|.  Zeros that don't change the sign of |function|
+    // over a step, e.g., pairs of zeros in the same step, are not detected.
+    // This requires the FSAL property.
+    struct EventDetector {
+      std::function<double(typename ODE::State const& state)> function;
+      std::function<void(typename ODE::State const& state)> on_event;
+    };
+
+    void AddEventDetector(EventDetector event_detector);
+
    private:
+    // The data of the last step needed by |DenseOutput|.
+    struct LastStep {
+      DoublePrecision<Instant> t₀;
+      Time h;
+      typename ODE::DependentVariables q₀;
+      std::vector<typename ODE::DependentVariableDerivative> v₀;
+      typename ODE::DependentVariableDerivatives2 a₀;
+      std::vector<typename ODE::DependentVariableDifference> Δq;
+      std::vector<typename ODE::DependentVariableDerivative> Δv;
+      typename ODE::DependentVariableDerivatives2 a₁;
+    };
+
     Instance(InitialValueProblem<ODE> const& problem,
              AppendState const& append_state,
              ToleranceToErrorRatio const& tolerance_to_error_ratio,
@@ -119,7 +158,18 @@ class EmbeddedExplicitRungeKuttaNyströmIntegrator
              bool first_use,
              EmbeddedExplicitRungeKuttaNyströmIntegrator const& integrator);
 
+    // Calls the |on_event| of the |event_detectors_| whose function changed
+    // sign over the last step, and updates |event_function_values_| to the
+    // values at |current_state_|.
+    void DetectEvents();
+
     EmbeddedExplicitRungeKuttaNyströmIntegrator const& integrator_;
+    // Only set for FSAL methods, once a step has been appended.
+    std::optional<LastStep> last_step_;
+    std::vector<EventDetector> event_detectors_;
+    // The values of the functions of the |event_detectors_| at the start of
+    // the current step.
+    std::vector<double> event_function_values_;
     friend class EmbeddedExplicitRungeKuttaNyströmIntegrator;
   };
 
@@ -13,6 +13,7 @@
 #include "geometry/sign.hpp"
 #include "glog/logging.h"
 #include "numerics/double_precision.hpp"
+#include "numerics/root_finders.hpp"
 
 namespace principia {
 namespace integrators {
@@ -21,6 +22,7 @@ namespace internal {
 
 using namespace principia::geometry::_sign;
 using namespace principia::numerics::_double_precision;
+using namespace principia::numerics::_root_finders;
 
 template<typename Method, typename ODE_>
 EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::
@@ -46,6 +48,8 @@ Instance::Solve(Instant const& t_final) {
   using Velocity = typename ODE::DependentVariableDerivative;
   using Acceleration = typename ODE::DependentVariableDerivative2;
 
+  typename Integrator<ODE>::Instance::SolveTimer const timer(*this);
+
   auto const& a = integrator_.a_;
   auto const& b̂ = integrator_.b̂_;
   auto const& b̂ʹ = integrator_.b̂ʹ_;
@@ -79,6 +83,12 @@ Instance::Solve(Instant const& t_final) {
       << "Cannot reuse an instance where the last step is exact";
   first_use = false;
 
+  // The events of a step are detected from the values at its start.
+  event_function_values_.clear();
+  for (auto const& event_detector : event_detectors_) {
+    event_function_values_.push_back(event_detector.function(current_state));
+  }
+
   // Time step.  Updated as the integration progresses to allow restartability.
   Time& h = this->step_;
   // Current time.  This is a non-const reference whose purpose is to make the
@@ -185,8 +195,8 @@ Instance::Solve(Instant const& t_final) {
           }
           q_stage[k] = q̂[k].value + h * c[i] * v̂[k].value + h² * Σⱼ_aᵢⱼ_gⱼₖ;
         }
-        step_status.Update(
-            equation.compute_acceleration(t_stage, q_stage, g[i]));
+        step_status.Update(this->Evaluate(
+            equation.compute_acceleration, t_stage, q_stage, g[i]));
       }
 
       // Increment computation and step size control.
@@ -214,6 +224,9 @@ Instance::Solve(Instant const& t_final) {
       }
       tolerance_to_error_ratio =
           this->tolerance_to_error_ratio_(h, current_state, error_estimate);
+      if (tolerance_to_error_ratio < 1.0) {
+        this->RecordRejectedStep();
+      }
     } while (tolerance_to_error_ratio < 1.0);
 
     status.Update(step_status);
@@ -225,6 +238,25 @@ Instance::Solve(Instant const& t_final) {
     }
 
     if (first_same_as_last) {
+      // Record the step for |DenseOutput| before the stages are swapped.
+      // Assigning to the existing vectors reuses their storage.
+      if (!last_step_.has_value()) {
+        last_step_.emplace();
+      }
+      LastStep& last_step = *last_step_;
+      last_step.t₀ = t;
+      last_step.h = h;
+      last_step.q₀.resize(dimension);
+      last_step.v₀.resize(dimension);
+      for (int k = 0; k < dimension; ++k) {
+        last_step.q₀[k] = q̂[k].value;
+        last_step.v₀[k] = v̂[k].value;
+      }
+      last_step.a₀ = g.front();
+      last_step.Δq = Δq̂;
+      last_step.Δv = Δv̂;
+      last_step.a₁ = g.back();
+
       using std::swap;
       swap(g.front(), g.back());
       first_stage = 1;
@@ -236,6 +268,10 @@ Instance::Solve(Instant const& t_final) {
       q̂[k].Increment(Δq̂[k]);
       v̂[k].Increment(Δv̂[k]);
     }
+    if (!event_detectors_.empty()) {
+      DetectEvents();
+    }
+    this->RecordAcceptedStep(h);
     append_state(current_state);
     RETURN_IF_STOPPED;  // After the state has been updated.
     ++step_count;
@@ -254,6 +290,87 @@ Instance::Solve(Instant const& t_final) {
   return status;
 }
 
+template<typename Method, typename ODE_>
+typename ODE_::State
+EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::Instance::
+DenseOutput(Instant const& t) const {
+  static_assert(first_same_as_last,
+                "Dense output requires the first-same-as-last property");
+  CHECK(last_step_.has_value()) << "No step has been appended";
+  auto const& [t₀, h, q₀, v₀, a₀, Δq, Δv, a₁] = *last_step_;
+  int const dimension = q₀.size();
+
+  // The quintic Hermite basis on [0, 1], and its derivatives, for the
+  // displacement Δq, the velocities v₀ and v₁, and the accelerations a₀ and a₁.
+  // The basis function for q₀ need not be computed as the interpolant is
+  // expressed as a displacement from q₀.
+  double const θ = ((t - t₀.value) - t₀.error) / h;
+  double const θ² = θ * θ;
+  double const θ³ = θ² * θ;
+  double const one_minus_θ = 1 - θ;
+  double const one_minus_θ² = one_minus_θ * one_minus_θ;
+  double const one_minus_θ³ = one_minus_θ² * one_minus_θ;
+  double const H_Δq = θ³ * (10 + θ * (-15 + 6 * θ));
+  double const H_v₀ = θ * one_minus_θ³ * (1 + 3 * θ);
+  double const H_v₁ = θ³ * one_minus_θ * (3 * θ - 4);
+  double const H_a₀ = 0.5 * θ² * one_minus_θ³;
+  double const H_a₁ = 0.5 * θ³ * one_minus_θ²;
+  double const Hʹ_Δq = 30 * θ² * one_minus_θ²;
+  double const Hʹ_v₀ = one_minus_θ² * (1 + θ * (2 - 15 * θ));
+  double const Hʹ_v₁ = θ² * (-12 + θ * (28 - 15 * θ));
+  double const Hʹ_a₀ = 0.5 * θ * one_minus_θ² * (2 - 5 * θ);
+  double const Hʹ_a₁ = 0.5 * θ² * one_minus_θ * (3 - 5 * θ);
+
+  typename ODE::State state;
+  state.time = DoublePrecision<Instant>(t);
+  state.positions.reserve(dimension);
+  state.velocities.reserve(dimension);
+  for (int k = 0; k < dimension; ++k) {
+    auto const v₁ = v₀[k] + Δv[k];
+    state.positions.emplace_back(
+        q₀[k] + (H_Δq * Δq[k] +
+                 h * (H_v₀ * v₀[k] + H_v₁ * v₁) +
+                 h * h * (H_a₀ * a₀[k] + H_a₁ * a₁[k])));
+    state.velocities.emplace_back(Hʹ_Δq * Δq[k] / h +
+                                  Hʹ_v₀ * v₀[k] + Hʹ_v₁ * v₁ +
+                                  h * (Hʹ_a₀ * a₀[k] + Hʹ_a₁ * a₁[k]));
+  }
+  return state;
+}
+
+template<typename Method, typename ODE_>
+void EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::Instance::
+AddEventDetector(EventDetector event_detector) {
+  static_assert(first_same_as_last,
+                "Event detection requires the first-same-as-last property");
+  event_detectors_.push_back(std::move(event_detector));
+}
+
+template<typename Method, typename ODE_>
+void EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::Instance::
+DetectEvents() {
+  if constexpr (first_same_as_last) {
+    auto const& current_state = this->current_state_;
+    Instant const t₀ = last_step_->t₀.value;
+    Instant const t₁ = current_state.time.value;
+    for (int i = 0; i < event_detectors_.size(); ++i) {
+      auto const& event_detector = event_detectors_[i];
+      double const value₀ = event_function_values_[i];
+      double const value₁ = event_detector.function(current_state);
+      if ((value₀ < 0 && value₁ > 0) || (value₀ > 0 && value₁ < 0)) {
+        Instant const t_event = Brent(
+            [this, &event_detector](Instant const& t) {
+              return event_detector.function(DenseOutput(t));
+            },
+            std::min(t₀, t₁),
+            std::max(t₀, t₁));
+        event_detector.on_event(DenseOutput(t_event));
+      }
+      event_function_values_[i] = value₁;
+    }
+  }
+}
+
 template<typename Method, typename ODE_>
 EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_> const&
 EmbeddedExplicitRungeKuttaNyströmIntegrator<Method, ODE_>::
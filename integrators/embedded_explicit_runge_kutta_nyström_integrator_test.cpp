@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <limits>
+#include <optional>
+#include <type_traits>
 #include <vector>
 
 #include "geometry/instant.hpp"
@@ -29,7 +31,10 @@ using ::std::placeholders::_1;
 using ::std::placeholders::_2;
 using ::std::placeholders::_3;
 using ::testing::ElementsAreArray;
+using ::testing::Eq;
+using ::testing::Gt;
 using ::testing::Lt;
+using ::testing::NotNull;
 using namespace principia::geometry::_instant;
 using namespace principia::integrators::_embedded_explicit_runge_kutta_nyström_integrator;  // NOLINT
 using namespace principia::integrators::_integrators;
@@ -129,6 +134,13 @@ TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest,
                                            parameters);
     auto outcome = instance->Solve(t_final);
     EXPECT_THAT(outcome, StatusIs(termination_condition::Done));
+    auto const& statistics = instance->statistics();
+    EXPECT_EQ(steps_forward, statistics.accepted_steps);
+    EXPECT_EQ(initial_rejections + subsequent_rejections,
+              statistics.rejected_steps);
+    EXPECT_EQ(evaluations, statistics.evaluations);
+    EXPECT_LT(statistics.smallest_step, statistics.largest_step);
+    EXPECT_LE(statistics.evaluation_time, statistics.solve_time);
   }
   EXPECT_THAT(AbsoluteError(x_initial, solution.back().positions[0].value),
               IsNear(3.5e-4_(1) * Metre));
@@ -430,6 +442,178 @@ TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, Restart) {
   EXPECT_THAT(solution2, ElementsAreArray(solution1));
 }
 
+TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, DenseOutput) {
+  auto const& integrator = EmbeddedExplicitRungeKuttaNyströmIntegrator<
+      methods::DormandالمكاوىPrince1986RKN434FM, ODE>();
+  using Instance = std::remove_cvref_t<decltype(integrator)>::Instance;
+  Length const q_initial = 1 * Metre;
+  Speed const v_initial = 0 * Metre / Second;
+  Time const period = 2 * π * Second;
+  Instant const t_initial;
+  Instant const t_final = t_initial + 10 * period;
+  Length const length_tolerance = 1 * Milli(Metre);
+  Speed const speed_tolerance = 1 * Milli(Metre) / Second;
+
+  int evaluations = 0;
+  ODE harmonic_oscillator;
+  harmonic_oscillator.compute_acceleration =
+      std::bind(ComputeHarmonicOscillatorAcceleration1D,
+                _1, _2, _3, &evaluations);
+  InitialValueProblem<ODE> problem;
+  problem.equation = harmonic_oscillator;
+  problem.initial_state = {t_initial, {q_initial}, {v_initial}};
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final - t_initial,
+      /*safety_factor=*/0.9);
+
+  // Sample each step at its ends and at a few interior points.
+  Instance const* dense_instance = nullptr;
+  std::optional<Instant> t_previous;
+  Length max_end_error;
+  Length max_interior_error;
+  Speed max_interior_speed_error;
+  int evaluations_in_dense_output = 0;
+  auto const append_state = [&](ODE::State const& state) {
+    Instant const t₁ = state.time.value;
+    ODE::State const end = dense_instance->DenseOutput(t₁);
+    // The end of the step is reproduced up to rounding.
+    EXPECT_THAT(AbsoluteError(state.positions[0].value,
+                              end.positions[0].value),
+                Lt(1e-14 * Metre));
+    EXPECT_THAT(AbsoluteError(state.velocities[0].value,
+                              end.velocities[0].value),
+                Lt(1e-14 * Metre / Second));
+    max_end_error = std::max(
+        max_end_error,
+        AbsoluteError(q_initial * Cos((t₁ - t_initial) * Radian / Second),
+                      state.positions[0].value));
+    if (t_previous.has_value()) {
+      ODE::State const start = dense_instance->DenseOutput(*t_previous);
+      EXPECT_THAT(start.time.value, Eq(*t_previous));
+      int const evaluations_before = evaluations;
+      for (double const θ : {0.25, 0.5, 0.75}) {
+        Instant const t = *t_previous + θ * (t₁ - *t_previous);
+        ODE::State const interior = dense_instance->DenseOutput(t);
+        max_interior_error = std::max(
+            max_interior_error,
+            AbsoluteError(q_initial * Cos((t - t_initial) * Radian / Second),
+                          interior.positions[0].value));
+        max_interior_speed_error = std::max(
+            max_interior_speed_error,
+            AbsoluteError(-q_initial * Sin((t - t_initial) * Radian / Second) /
+                              Second,
+                          interior.velocities[0].value));
+      }
+      evaluations_in_dense_output += evaluations - evaluations_before;
+    }
+    t_previous = t₁;
+  };
+
+  auto const instance = integrator.NewInstance(
+      problem,
+      append_state,
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2, _3,
+                length_tolerance,
+                speed_tolerance,
+                [](bool tolerable) {}),
+      parameters);
+  dense_instance = dynamic_cast<Instance const*>(&*instance);
+  ASSERT_THAT(dense_instance, NotNull());
+  EXPECT_THAT(instance->Solve(t_final), StatusIs(termination_condition::Done));
+
+  // The interpolation within the steps is about as accurate as the integration
+  // itself, and doesn't evaluate the right-hand side.
+  EXPECT_EQ(0, evaluations_in_dense_output);
+  EXPECT_THAT(max_end_error, IsNear(2.7e-3_(1) * Metre));
+  EXPECT_THAT(max_interior_error, Lt(1.1 * max_end_error));
+  EXPECT_THAT(max_interior_speed_error, IsNear(2.8e-3_(1) * Metre / Second));
+}
+
+TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, Events) {
+  auto const& integrator = EmbeddedExplicitRungeKuttaNyströmIntegrator<
+      methods::DormandالمكاوىPrince1986RKN434FM, ODE>();
+  using Instance = std::remove_cvref_t<decltype(integrator)>::Instance;
+  Length const q_initial = 1 * Metre;
+  Speed const v_initial = 0 * Metre / Second;
+  Time const period = 2 * π * Second;
+  Instant const t_initial;
+  Instant const t_final = t_initial + 10 * period;
+  Length const length_tolerance = 1 * Milli(Metre);
+  Speed const speed_tolerance = 1 * Milli(Metre) / Second;
+
+  ODE harmonic_oscillator;
+  harmonic_oscillator.compute_acceleration =
+      std::bind(ComputeHarmonicOscillatorAcceleration1D,
+                _1, _2, _3, /*evaluations=*/nullptr);
+  InitialValueProblem<ODE> problem;
+  problem.equation = harmonic_oscillator;
+  problem.initial_state = {t_initial, {q_initial}, {v_initial}};
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final - t_initial,
+      /*safety_factor=*/0.9);
+
+  std::vector<Instant> appended_times;
+  auto const instance = integrator.NewInstance(
+      problem,
+      [&appended_times](ODE::State const& state) {
+        appended_times.push_back(state.time.value);
+      },
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2, _3,
+                length_tolerance,
+                speed_tolerance,
+                [](bool tolerable) {}),
+      parameters);
+  auto& dense_instance = dynamic_cast<Instance&>(*instance);
+
+  // The nodes, where q = 0, and the apsides, where q v = 0.  The events must
+  // be reported in the step that follows the last appended state.
+  std::vector<Instant> nodes;
+  std::vector<Instant> apsides;
+  auto const check_step = [&appended_times](Instant const& t) {
+    if (!appended_times.empty()) {
+      EXPECT_THAT(t, Gt(appended_times.back()));
+    }
+  };
+  dense_instance.AddEventDetector(
+      {.function =
+           [](ODE::State const& state) {
+             return state.positions[0].value / Metre;
+           },
+       .on_event =
+           [&check_step, &nodes](ODE::State const& state) {
+             check_step(state.time.value);
+             EXPECT_THAT(Abs(state.positions[0].value), Lt(1e-12 * Metre));
+             nodes.push_back(state.time.value);
+           }});
+  dense_instance.AddEventDetector(
+      {.function =
+           [](ODE::State const& state) {
+             return state.positions[0].value * state.velocities[0].value /
+                    (Metre * Metre / Second);
+           },
+       .on_event =
+           [&apsides, &check_step](ODE::State const& state) {
+             check_step(state.time.value);
+             apsides.push_back(state.time.value);
+           }});
+  EXPECT_THAT(instance->Solve(t_final), StatusIs(termination_condition::Done));
+
+  // The events are at multiples of a quarter period, with an error commensurate
+  // with that of the integration.
+  ASSERT_EQ(20, nodes.size());
+  ASSERT_EQ(39, apsides.size());
+  for (int i = 0; i < nodes.size(); ++i) {
+    EXPECT_THAT(AbsoluteError(t_initial + (2 * i + 1) * period / 4, nodes[i]),
+                Lt(5 * Milli(Second)));
+  }
+  for (int i = 0; i < apsides.size(); ++i) {
+    EXPECT_THAT(AbsoluteError(t_initial + (i + 1) * period / 4, apsides[i]),
+                Lt(5 * Milli(Second)));
+  }
+}
+
 TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, Serialization) {
   AdaptiveStepSizeIntegrator<ODE> const& integrator =
       EmbeddedExplicitRungeKuttaNyströmIntegrator<
@@ -26,6 +26,8 @@ ExplicitLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
     IndependentVariable const& s_final) {
   using DependentVariables = typename ODE::DependentVariables;
 
+  typename Integrator<ODE>::Instance::SolveTimer const timer(*this);
+
   auto const& α = integrator_.α_;
   auto const& β_numerator = integrator_.β_numerator_;
   auto const& β_denominator = integrator_.β_denominator_;
@@ -114,12 +116,13 @@ ExplicitLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
           y = yₙ₊₁;
         });
     current_step.y = std::move(yₙ₊₁);
-    status.Update(
-        equation.compute_derivative(s.value, y_stage, current_step.yʹ));
+    status.Update(this->Evaluate(
+        equation.compute_derivative, s.value, y_stage, current_step.yʹ));
     starter_.Push(std::move(current_step));
 
     // Inform the caller of the new state.
     current_state.s = s;
+    this->RecordAcceptedStep(h);
     append_state(current_state);
     RETURN_IF_STOPPED;  // After the state has been updated.
     if (absl::IsAborted(status)) {
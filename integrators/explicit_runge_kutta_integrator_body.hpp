@@ -55,6 +55,8 @@ Solve(typename ODE::IndependentVariable const& s_final) {
   using DependentVariableDerivatives =
       typename ODE::DependentVariableDerivatives;
 
+  typename Integrator<ODE>::Instance::SolveTimer const timer(*this);
+
   auto const& a = integrator_.a_;
   auto const& b = integrator_.b_;
   auto const& c = integrator_.c_;
@@ -101,7 +103,8 @@ Solve(typename ODE::IndependentVariable const& s_final) {
   absl::Status status;
 
   if (first_same_as_last) {
-    status = equation.compute_derivative(s.value, y_stage, last_f);
+    status = this->Evaluate(equation.compute_derivative,
+                            s.value, y_stage, last_f);
   }
 
   while (abs_h <= Abs((s_final - s.value) - s.error)) {
@@ -127,9 +130,10 @@ Solve(typename ODE::IndependentVariable const& s_final) {
               y_stage = y.value + Σⱼ_aᵢⱼ_kⱼ;
             });
 
-        status.Update(
-            equation.compute_derivative(
-                s.value + (s.error + c[i] * h), y_stage, f));
+        status.Update(this->Evaluate(equation.compute_derivative,
+                                     s.value + (s.error + c[i] * h),
+                                     y_stage,
+                                     f));
       }
       for_all_of(f, k[i]).loop([h](auto const& f, auto& kᵢ) {
         kᵢ = h * f;
@@ -157,6 +161,7 @@ Solve(typename ODE::IndependentVariable const& s_final) {
       y.Increment(Δy);
     });
 
+    this->RecordAcceptedStep(h);
     append_state(current_state);
     RETURN_IF_STOPPED;  // After the state has been updated.
     if (absl::IsAborted(status)) {
@@ -1,6 +1,8 @@
 #ifndef PRINCIPIA_INTEGRATORS_INTEGRATORS_HPP_
 #define PRINCIPIA_INTEGRATORS_INTEGRATORS_HPP_
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -26,12 +28,36 @@ using namespace principia::integrators::_ordinary_differential_equations;
 using namespace principia::numerics::_double_precision;
 using namespace principia::quantities::_quantities;
 
+// Counters describing the work performed by integrator instances.  They are
+// not serialized.  For multistep integrators, the steps and evaluations of the
+// startup integrator are not counted, but its time is.
+template<typename IndependentVariableDifference>
+struct IntegrationStatistics final {
+  std::int64_t accepted_steps = 0;
+  // Only adaptive-step integrators reject steps.
+  std::int64_t rejected_steps = 0;
+  // The number of evaluations of the right-hand side of the equation.
+  std::int64_t evaluations = 0;
+  // The smallest and largest absolute values of the accepted steps, zero if
+  // there are none.
+  IndependentVariableDifference smallest_step{};
+  IndependentVariableDifference largest_step{};
+  // The wall time spent evaluating the right-hand side, and in |Solve|
+  // overall.  The difference is the time spent in the integrator proper.
+  Time evaluation_time;
+  Time solve_time;
+
+  IntegrationStatistics& operator+=(IntegrationStatistics const& right);
+};
+
 // A base class for integrators.
 template<typename ODE_>
 class Integrator {
  public:
   using ODE = ODE_;
   using IndependentVariable = typename ODE::IndependentVariable;
+  using Statistics =
+      IntegrationStatistics<typename ODE::IndependentVariableDifference>;
   using AppendState =
       std::function<void(typename ODE::State const& state)>;
 
@@ -60,6 +86,9 @@ class Integrator {
     typename ODE::State const& state() const;
     typename ODE::State& state();
 
+    // The work performed by this instance since its construction.
+    Statistics const& statistics() const;
+
     // Performs a copy of this object.
     virtual not_null<std::unique_ptr<Instance>> Clone() const = 0;
 
@@ -71,11 +100,35 @@ class Integrator {
     // For testing.
     Instance();
 
+    // Subclasses must create an object of this class at the beginning of
+    // |Solve|: it adds its lifetime to |statistics_.solve_time|.
+    class SolveTimer final {
+     public:
+      explicit SolveTimer(Instance& instance);
+      ~SolveTimer();
+
+     private:
+      Instance& instance_;
+      std::chrono::steady_clock::time_point const start_;
+    };
+
+    // Calls |right_hand_side| with the given |args|, counting and timing the
+    // evaluation.  Subclasses must evaluate the right-hand side of the equation
+    // through this function.
+    template<typename RightHandSide, typename... Args>
+    absl::Status Evaluate(RightHandSide const& right_hand_side,
+                          Args&&... args);
+
+    void RecordAcceptedStep(
+        typename ODE::IndependentVariableDifference const& step);
+    void RecordRejectedStep();
+
     // We make the data members protected because they need to be easily
     // accessible by subclasses.
     ODE const equation_;
     typename ODE::State current_state_;
     AppendState const append_state_;
+    Statistics statistics_;
   };
 
   virtual ~Integrator() = default;
@@ -245,6 +298,7 @@ AdaptiveStepSizeIntegrator<Equation> const& ParseAdaptiveStepSizeIntegrator(
 
 using internal::AdaptiveStepSizeIntegrator;
 using internal::FixedStepSizeIntegrator;
+using internal::IntegrationStatistics;
 using internal::Integrator;
 using internal::ParseAdaptiveStepSizeIntegrator;
 using internal::ParseFixedStepSizeIntegrator;
@@ -2,6 +2,8 @@
 
 #include "integrators/integrators.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <limits>
 #include <memory>
 #include <string>
@@ -15,7 +17,10 @@
 #include "integrators/methods.hpp"
 #include "integrators/symmetric_linear_multistep_integrator.hpp"
 #include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
+#include "integrators/variable_step_adams_integrator.hpp"
+#include "quantities/elementary_functions.hpp"
 #include "quantities/serialization.hpp"
+#include "quantities/si.hpp"
 
 // A case branch in a switch on the serialized integrator |kind|.  It determines
 // the |method| type from the |kind| defined in scope |message| and calls
@@ -32,7 +37,11 @@
 // It has not escaped our notice that the acronym is a fair characterization of
 // these macros.
 #define PRINCIPIA_ASS_INTEGRATOR_CASES(                              \
-    eegrkn_action, eerkn_action, eerk_action)                        \
+    eegrkn_action, eerkn_action, eerk_action, vsa_action)            \
+  PRINCIPIA_INTEGRATOR_CASE(AdaptiveStepSizeIntegrator,              \
+                            ADAMS_BASHFORTH_MOULTON_PECE_ORDER_12,   \
+                            AdamsBashforthMoultonPECEOrder12,        \
+                            vsa_action)                              \
   PRINCIPIA_INTEGRATOR_CASE(AdaptiveStepSizeIntegrator,              \
                             DORMAND_ELMIKKAWY_PRINCE_1986_RKN_434FM, \
                             DormandالمكاوىPrince1986RKN434FM,        \
@@ -238,7 +247,10 @@ using namespace principia::integrators::_embedded_explicit_runge_kutta_nyström_
 using namespace principia::integrators::_methods;
 using namespace principia::integrators::_symmetric_linear_multistep_integrator;
 using namespace principia::integrators::_symplectic_runge_kutta_nyström_integrator;  // NOLINT
+using namespace principia::integrators::_variable_step_adams_integrator;
+using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_serialization;
+using namespace principia::quantities::_si;
 
 template<typename Integrator>
 not_null<std::unique_ptr<typename Integrator::Instance>>
@@ -298,6 +310,32 @@ ReadEerknInstanceFromMessage(
                                                integrator);
 }
 
+template<typename Integrator>
+not_null<std::unique_ptr<typename Integrator::Instance>>
+ReadVsaInstanceFromMessage(
+    serialization::AdaptiveStepSizeIntegratorInstance const& message,
+    InitialValueProblem<typename Integrator::ODE> const& problem,
+    typename Integrator::AppendState const& append_state,
+    typename Integrator::ToleranceToErrorRatio const& tolerance_to_error_ratio,
+    typename Integrator::Parameters const& parameters,
+    Time const& time_step,
+    bool const first_use,
+    Integrator const& integrator) {
+  CHECK(message.HasExtension(
+      serialization::VariableStepAdamsIntegratorInstance::extension))
+      << message.DebugString();
+  auto const& extension = message.GetExtension(
+      serialization::VariableStepAdamsIntegratorInstance::extension);
+  return Integrator::Instance::ReadFromMessage(extension,
+                                               problem,
+                                               append_state,
+                                               tolerance_to_error_ratio,
+                                               parameters,
+                                               time_step,
+                                               first_use,
+                                               integrator);
+}
+
 template<typename Integrator>
 not_null<std::unique_ptr<typename Integrator::Instance>>
 ReadSlmsInstanceFromMessage(
@@ -417,6 +455,24 @@ Result ReadSprkFromMessage(
   }
 }
 
+template<typename IndependentVariableDifference>
+IntegrationStatistics<IndependentVariableDifference>&
+IntegrationStatistics<IndependentVariableDifference>::operator+=(
+    IntegrationStatistics const& right) {
+  if (right.accepted_steps > 0) {
+    smallest_step = accepted_steps == 0
+                        ? right.smallest_step
+                        : std::min(smallest_step, right.smallest_step);
+    largest_step = std::max(largest_step, right.largest_step);
+  }
+  accepted_steps += right.accepted_steps;
+  rejected_steps += right.rejected_steps;
+  evaluations += right.evaluations;
+  evaluation_time += right.evaluation_time;
+  solve_time += right.solve_time;
+  return *this;
+}
+
 template<typename ODE_>
 Integrator<ODE_>::Instance::Instance(
     InitialValueProblem<ODE> const& problem,
@@ -452,6 +508,12 @@ typename ODE_::State& Integrator<ODE_>::Instance::state() {
   return current_state_;
 }
 
+template<typename ODE_>
+typename Integrator<ODE_>::Statistics const&
+Integrator<ODE_>::Instance::statistics() const {
+  return statistics_;
+}
+
 template<typename ODE_>
 void Integrator<ODE_>::Instance::WriteToMessage(
     not_null<serialization::IntegratorInstance*> message) const {
@@ -461,6 +523,50 @@ void Integrator<ODE_>::Instance::WriteToMessage(
 template<typename ODE_>
 Integrator<ODE_>::Instance::Instance() : equation_() {}
 
+template<typename ODE_>
+Integrator<ODE_>::Instance::SolveTimer::SolveTimer(Instance& instance)
+    : instance_(instance), start_(std::chrono::steady_clock::now()) {}
+
+template<typename ODE_>
+Integrator<ODE_>::Instance::SolveTimer::~SolveTimer() {
+  instance_.statistics_.solve_time +=
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start_)
+          .count() * Second;
+}
+
+template<typename ODE_>
+template<typename RightHandSide, typename... Args>
+absl::Status Integrator<ODE_>::Instance::Evaluate(
+    RightHandSide const& right_hand_side,
+    Args&&... args) {
+  auto const start = std::chrono::steady_clock::now();
+  absl::Status status = right_hand_side(std::forward<Args>(args)...);
+  statistics_.evaluation_time +=
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count() * Second;
+  ++statistics_.evaluations;
+  return status;
+}
+
+template<typename ODE_>
+void Integrator<ODE_>::Instance::RecordAcceptedStep(
+    typename ODE::IndependentVariableDifference const& step) {
+  auto const abs_step = Abs(step);
+  if (statistics_.accepted_steps == 0) {
+    statistics_.smallest_step = abs_step;
+    statistics_.largest_step = abs_step;
+  } else {
+    statistics_.smallest_step = std::min(statistics_.smallest_step, abs_step);
+    statistics_.largest_step = std::max(statistics_.largest_step, abs_step);
+  }
+  ++statistics_.accepted_steps;
+}
+
+template<typename ODE_>
+void Integrator<ODE_>::Instance::RecordRejectedStep() {
+  ++statistics_.rejected_steps;
+}
+
 template<typename ODE_>
 Time const& FixedStepSizeIntegrator<ODE_>::Instance::step() const {
   return step_;
@@ -752,6 +858,22 @@ void AdaptiveStepSizeIntegrator<ODE_>::Instance::WriteToMessage(
     base::noreturn();                                                        \
   }
 #define PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_EERK(method) LOG(FATAL) << "NYI"
+#define PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_VSA(method)                 \
+  if constexpr (is_instance_of_v<SpecialSecondOrderDifferentialEquation,   \
+                                 ODE>) {                                   \
+    auto const& integrator =                                               \
+        VariableStepAdamsIntegrator<methods::method, ODE>();               \
+    return ReadVsaInstanceFromMessage(extension,                           \
+                                      problem,                             \
+                                      append_state,                        \
+                                      tolerance_to_error_ratio,            \
+                                      parameters,                          \
+                                      step,                                \
+                                      first_use,                           \
+                                      integrator);                         \
+  } else {                                                                 \
+    base::noreturn();                                                      \
+  }
 
 template<typename ODE_>
 template<typename, typename>
@@ -799,7 +921,8 @@ AdaptiveStepSizeIntegrator<ODE_>::Instance::ReadFromMessage(
     PRINCIPIA_ASS_INTEGRATOR_CASES(
         PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_EEGRKN,
         PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_EERKN,
-        PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_EERK)
+        PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_EERK,
+        PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_VSA)
     default:
       LOG(FATAL) << message.DebugString();
       base::noreturn();
@@ -811,6 +934,7 @@ AdaptiveStepSizeIntegrator<ODE_>::Instance::ReadFromMessage(
 #undef PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_EEGRKN
 #undef PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_EERKN
 #undef PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_EERK
+#undef PRINCIPIA_READ_ASS_INTEGRATOR_INSTANCE_VSA
 
 template<typename ODE_>
 AdaptiveStepSizeIntegrator<ODE_>::Instance::Instance(
@@ -852,6 +976,14 @@ AdaptiveStepSizeIntegrator<ODE_>::Instance::Instance(
 
 #define PRINCIPIA_READ_ASS_INTEGRATOR_EERK(method) LOG(FATAL) << "NYI"
 
+#define PRINCIPIA_READ_ASS_INTEGRATOR_VSA(method)                        \
+  if constexpr (is_instance_of_v<SpecialSecondOrderDifferentialEquation, \
+                                 ODE>) {                                 \
+    return VariableStepAdamsIntegrator<methods::method, ODE>();          \
+  } else {                                                               \
+    base::noreturn();                                                    \
+  }
+
 template<typename ODE_>
 AdaptiveStepSizeIntegrator<ODE_> const&
 AdaptiveStepSizeIntegrator<ODE_>::ReadFromMessage(
@@ -859,7 +991,8 @@ AdaptiveStepSizeIntegrator<ODE_>::ReadFromMessage(
   switch (message.kind()) {
     PRINCIPIA_ASS_INTEGRATOR_CASES(PRINCIPIA_READ_ASS_INTEGRATOR_EEGRKN,
                                    PRINCIPIA_READ_ASS_INTEGRATOR_EERKN,
-                                   PRINCIPIA_READ_ASS_INTEGRATOR_EERK)
+                                   PRINCIPIA_READ_ASS_INTEGRATOR_EERK,
+                                   PRINCIPIA_READ_ASS_INTEGRATOR_VSA)
     default:
       LOG(FATAL) << message.kind();
       base::noreturn();
@@ -871,6 +1004,7 @@ AdaptiveStepSizeIntegrator<ODE_>::ReadFromMessage(
 #undef PRINCIPIA_READ_ASS_INTEGRATOR_EEGRKN
 #undef PRINCIPIA_READ_ASS_INTEGRATOR_EERKN
 #undef PRINCIPIA_READ_ASS_INTEGRATOR_EERK
+#undef PRINCIPIA_READ_ASS_INTEGRATOR_VSA
 
 template<typename Equation>
 AdaptiveStepSizeIntegrator<Equation> const& ParseAdaptiveStepSizeIntegrator(
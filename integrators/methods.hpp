@@ -130,6 +130,11 @@ struct SymplecticPartitionedRungeKutta : not_constructible {
   // static constexpr FixedVector<double, stages> b(...);
 };
 
+struct VariableStepAdams : not_constructible {
+  // static constexpr int max_order = ...;
+  // static constexpr serialization::AdaptiveStepSizeIntegrator::Kind kind = ..;
+};
+
 // Every SPRK may be transformed into an SRKN by specifying a composition method
 // (the possible composition methods are constrained by the properties of the
 // SPRK).  This struct effects that transformation.
@@ -240,6 +245,16 @@ struct AdamsBashforthOrder6 : ExplicitLinearMultistep {
   static constexpr double β_denominator = 1440.0;
 };
 
+// A variable-step, variable-order Adams-Bashforth-Moulton method in PECE mode,
+// in the spirit of [SG75].  The order of the predictor varies between 1 and
+// |max_order|, the corrector has one order more.
+struct AdamsBashforthMoultonPECEOrder12 : VariableStepAdams {
+  static constexpr int max_order = 12;
+  static constexpr serialization::AdaptiveStepSizeIntegrator::Kind kind =
+      serialization::AdaptiveStepSizeIntegrator::
+          ADAMS_BASHFORTH_MOULTON_PECE_ORDER_12;
+};
+
 // The following methods have coefficients from [BM02].
 struct BlanesMoan2002S6 : SymplecticPartitionedRungeKutta {
   static constexpr int order = 4;
@@ -1373,6 +1388,7 @@ struct 吉田1990Order8E : SymplecticPartitionedRungeKutta {
 
 }  // namespace internal
 
+using internal::AdamsBashforthMoultonPECEOrder12;
 using internal::AdamsBashforthOrder2;
 using internal::AdamsBashforthOrder3;
 using internal::AdamsBashforthOrder4;
@@ -1423,6 +1439,7 @@ using internal::Ruth1983;
 using internal::SymmetricLinearMultistep;
 using internal::SymplecticPartitionedRungeKutta;
 using internal::SymplecticRungeKuttaNyström;
+using internal::VariableStepAdams;
 using internal::吉田1990Order6A;
 using internal::吉田1990Order6B;
 using internal::吉田1990Order6C;
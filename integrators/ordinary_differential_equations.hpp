@@ -185,9 +185,26 @@ struct ExplicitSecondOrderOrdinaryDifferentialEquation final {
   RightHandSideComputation compute_acceleration;
 };
 
+// The default type of the functor that computes f(q, t) for a
+// |SpecialSecondOrderDifferentialEquation|.
+template<typename DependentVariable>
+using SpecialSecondOrderRightHandSideComputation =
+    std::function<absl::Status(
+        Instant const& t,
+        std::vector<DependentVariable> const& positions,
+        std::vector<Derivative<DependentVariable, Instant, 2>>& accelerations)>;
+
 // A differential equation of the form q″ = f(t, q).
-// |DependentVariable_| is the type of q.
-template<typename DependentVariable_>
+// |DependentVariable_| is the type of q.  |RightHandSideComputation_| is the
+// type of the functor that computes f.  By default it is a |std::function|,
+// which accepts any callable but costs an indirect call for each evaluation.
+// A concrete functor type may be given instead, in which case the integrators
+// can inline the computation of f in their |Solve| loop.  It must be
+// default-constructible and copyable, and callable like the |std::function|.
+// The |State| does not depend on |RightHandSideComputation_|.
+template<typename DependentVariable_,
+         typename RightHandSideComputation_ =
+             SpecialSecondOrderRightHandSideComputation<DependentVariable_>>
 struct SpecialSecondOrderDifferentialEquation final {
   static constexpr std::int64_t order = 2;
   using IndependentVariable = Instant;
@@ -206,10 +223,7 @@ struct SpecialSecondOrderDifferentialEquation final {
   using DependentVariableDerivatives2 =
       std::vector<DependentVariableDerivative2>;
 
-  using RightHandSideComputation =
-      std::function<absl::Status(IndependentVariable const& t,
-                                 DependentVariables const& positions,
-                                 DependentVariableDerivatives2& accelerations)>;
+  using RightHandSideComputation = RightHandSideComputation_;
 
   using State = typename ExplicitSecondOrderOrdinaryDifferentialEquation<
       DependentVariable>::State;
@@ -235,6 +249,7 @@ using internal::ExplicitFirstOrderOrdinaryDifferentialEquation;
 using internal::ExplicitSecondOrderOrdinaryDifferentialEquation;
 using internal::InitialValueProblem;
 using internal::SpecialSecondOrderDifferentialEquation;
+using internal::SpecialSecondOrderRightHandSideComputation;
 namespace termination_condition = internal::termination_condition;
 
 }  // namespace _ordinary_differential_equations
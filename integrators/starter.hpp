@@ -39,6 +39,12 @@ class Starter {
   // This object must be |started()|.
   void Push(Step step);
 
+  // Moves the oldest step to the end of |previous_steps_| and returns it, for
+  // the caller to overwrite it with the new step.  Unlike |Push|, this reuses
+  // the storage of the oldest step and doesn't allocate.  This object must be
+  // |started()|.
+  Step& RecycleOldestStep();
+
   // Returns the startup steps.  This object must be |started()|.
   std::list<Step> const& previous_steps() const;
 
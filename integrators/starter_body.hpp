@@ -80,6 +80,15 @@ void Starter<ODE, Step, steps>::Push(Step step) {
   previous_steps_.pop_front();
 }
 
+template<typename ODE, typename Step, int steps>
+Step& Starter<ODE, Step, steps>::RecycleOldestStep() {
+  CHECK(started());
+  previous_steps_.splice(previous_steps_.end(),
+                         previous_steps_,
+                         previous_steps_.begin());
+  return previous_steps_.back();
+}
+
 template<typename ODE, typename Step, int steps>
 std::list<Step> const& Starter<ODE, Step, steps>::previous_steps() const {
   CHECK(started());
@@ -108,6 +108,13 @@ class SymmetricLinearMultistepIntegrator
 
     Starter starter_;
     SymmetricLinearMultistepIntegrator const& integrator_;
+
+    // Scratch storage for |Solve|, sized at construction.
+    typename ODE::DependentVariables positions_;
+    std::vector<DoublePrecision<typename ODE::DependentVariableDifference>>
+        Σⱼ_minus_αⱼ_qⱼ_;
+    typename ODE::DependentVariableDerivatives2 Σⱼ_βⱼ_numerator_aⱼ_;
+
     friend class SymmetricLinearMultistepIntegrator;
   };
 
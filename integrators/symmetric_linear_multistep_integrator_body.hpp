@@ -30,6 +30,8 @@ SymmetricLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
   using DoubleDisplacements = std::vector<DoubleDisplacement>;
   using DoublePosition = DoublePrecision<Position>;
 
+  typename Integrator<ODE>::Instance::SolveTimer const timer(*this);
+
   auto const& α = integrator_.α_;
   auto const& β_numerator = integrator_.β_numerator_;
   auto const& β_denominator = integrator_.β_denominator_;
@@ -62,10 +64,12 @@ SymmetricLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
   int const k = order;
 
   absl::Status status;
-  std::vector<Position> positions(dimension);
-
-  DoubleDisplacements Σⱼ_minus_αⱼ_qⱼ(dimension);
-  std::vector<Acceleration> Σⱼ_βⱼ_numerator_aⱼ(dimension);
+  // The scratch storage is preallocated so that the loop below doesn't
+  // allocate.
+  std::vector<Position>& positions = positions_;
+  DoubleDisplacements& Σⱼ_minus_αⱼ_qⱼ = Σⱼ_minus_αⱼ_qⱼ_;
+  std::vector<Acceleration>& Σⱼ_βⱼ_numerator_aⱼ = Σⱼ_βⱼ_numerator_aⱼ_;
+  CHECK_EQ(dimension, positions.size());
   while (h <= (t_final - t.value) - t.error) {
     // We take advantage of the symmetry to iterate on the list of previous
     // steps from both ends.
@@ -112,11 +116,11 @@ SymmetricLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
       }
     }
 
-    // Create a new step in the instance.
+    // Create a new step in the instance, reusing the storage of the oldest
+    // step, which is not needed anymore.
     t.Increment(h);
-    Step current_step{.time = t};
-    current_step.accelerations.resize(dimension);
-    current_step.displacements.reserve(dimension);
+    Step& current_step = starter_.RecycleOldestStep();
+    current_step.time = t;
 
     // Fill the new step.  We skip the division by αₖ as it is equal to 1.0.
     double const αₖ = α[0];
@@ -125,22 +129,22 @@ SymmetricLinearMultistepIntegrator<Method, ODE_>::Instance::Solve(
       DoubleDisplacement& current_displacement = Σⱼ_minus_αⱼ_qⱼ[d];
       current_displacement.Increment(h * h *
                                      Σⱼ_βⱼ_numerator_aⱼ[d] / β_denominator);
-      current_step.displacements.push_back(current_displacement);
+      current_step.displacements[d] = current_displacement;
       DoublePosition const current_position =
           DoublePosition() + current_displacement;
       positions[d] = current_position.value;
       current_state.positions[d] = current_position;
     }
-    status.Update(
-        equation.compute_acceleration(t.value,
-                                      positions,
-                                      current_step.accelerations));
-    starter_.Push(std::move(current_step));
+    status.Update(this->Evaluate(equation.compute_acceleration,
+                                 t.value,
+                                 positions,
+                                 current_step.accelerations));
 
     ComputeVelocityUsingCohenHubbardOesterwinter();
 
     // Inform the caller of the new state.
     current_state.time = t;
+    this->RecordAcceptedStep(h);
     append_state(current_state);
     RETURN_IF_STOPPED;  // After the state has been updated.
     if (absl::IsAborted(status)) {
@@ -276,7 +280,10 @@ SymmetricLinearMultistepIntegrator<Method, ODE_>::Instance::Instance(
     SymmetricLinearMultistepIntegrator const& integrator)
     : FixedStepSizeIntegrator<ODE>::Instance(problem, append_state, step),
       starter_(integrator.startup_integrator_, startup_step_divisor, this),
-      integrator_(integrator) {}
+      integrator_(integrator),
+      positions_(problem.initial_state.positions.size()),
+      Σⱼ_minus_αⱼ_qⱼ_(problem.initial_state.positions.size()),
+      Σⱼ_βⱼ_numerator_aⱼ_(problem.initial_state.positions.size()) {}
 
 template<typename Method, typename ODE_>
 void SymmetricLinearMultistepIntegrator<Method, ODE_>::
@@ -9,6 +9,7 @@
 #define PRINCIPIA_INTEGRATORS_SYMPLECTIC_RUNGE_KUTTA_NYSTRÖM_INTEGRATOR_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "base/not_null.hpp"
@@ -107,6 +108,13 @@ class SymplecticRungeKuttaNyströmIntegrator
              SymplecticRungeKuttaNyströmIntegrator const& integrator);
 
     SymplecticRungeKuttaNyströmIntegrator const& integrator_;
+
+    // Scratch storage for |Solve|, sized at construction.
+    std::vector<typename ODE::DependentVariableDifference> Δq_;
+    std::vector<typename ODE::DependentVariableDerivative> Δv_;
+    typename ODE::DependentVariables q_stage_;
+    typename ODE::DependentVariableDerivatives2 g_;
+
     friend class SymplecticRungeKuttaNyströmIntegrator;
   };
 
@@ -3,6 +3,7 @@
 #include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
 
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -29,8 +30,10 @@ Instance::Solve(Instant const& t_final) {
   using Velocity = typename ODE::DependentVariableDerivative;
   using Acceleration = typename ODE::DependentVariableDerivative2;
 
-  auto const& a = integrator_.a_;
-  auto const& b = integrator_.b_;
+  typename Integrator<ODE>::Instance::SolveTimer const timer(*this);
+
+  // The coefficients a and b are used as compile-time constants, see below.
+  // The nodes c are computed at construction.
   auto const& c = integrator_.c_;
 
   auto& current_state = this->current_state_;
@@ -60,10 +63,13 @@ Instance::Solve(Instant const& t_final) {
   // equations more readable.
   DoublePrecision<Instant>& t = current_state.time;
 
+  // The scratch storage is preallocated so that the loop below doesn't
+  // allocate.
+  CHECK_EQ(dimension, Δq_.size());
   // Position increment.
-  std::vector<Displacement> Δq(dimension);
+  std::vector<Displacement>& Δq = Δq_;
   // Velocity increment.
-  std::vector<Velocity> Δv(dimension);
+  std::vector<Velocity>& Δv = Δv_;
   // Current position.  This is a non-const reference whose purpose is to make
   // the equations more readable.
   std::vector<DoublePrecision<Position>>& q = current_state.positions;
@@ -72,9 +78,9 @@ Instance::Solve(Instant const& t_final) {
   std::vector<DoublePrecision<Velocity>>& v = current_state.velocities;
 
   // Current Runge-Kutta-Nyström stage.
-  std::vector<Position> q_stage(dimension);
+  std::vector<Position>& q_stage = q_stage_;
   // Accelerations at the current stage.
-  std::vector<Acceleration> g(dimension);
+  std::vector<Acceleration>& g = g_;
 
   // The first full stage of the step, i.e. the first stage where
   // exp(bᵢ h B) exp(aᵢ h A) must be entirely computed.
@@ -87,45 +93,58 @@ Instance::Solve(Instant const& t_final) {
 
   absl::Status status;
 
-  if (composition == BAB) {
+  if constexpr (composition == BAB) {
     for (int k = 0; k < dimension; ++k) {
       q_stage[k] = q[k].value;
     }
-    status.Update(equation.compute_acceleration(t.value, q_stage, g));
+    status.Update(
+        this->Evaluate(equation.compute_acceleration, t.value, q_stage, g));
   }
 
+  // A full stage exp(bᵢ h B) exp(aᵢ h A), for i ≥ |first_stage|.
+  auto const stage = [&]<int i>(std::integral_constant<int, i>) {
+    constexpr double aᵢ = a_[i];
+    constexpr double bᵢ = b_[i];
+    for (int k = 0; k < dimension; ++k) {
+      q_stage[k] = q[k].value + Δq[k];
+    }
+    status.Update(this->Evaluate(equation.compute_acceleration,
+                                 t.value + (t.error + c[i] * h),
+                                 q_stage,
+                                 g));
+    for (int k = 0; k < dimension; ++k) {
+      if constexpr (bᵢ != 0) {
+        // exp(bᵢ h B)
+        Δv[k] += h * bᵢ * g[k];
+      }
+      if constexpr (aᵢ != 0) {
+        // exp(aᵢ h A)
+        Δq[k] += h * aᵢ * (v[k].value + Δv[k]);
+      }
+    }
+  };
+
   while (abs_h <= Abs((t_final - t.value) - t.error)) {
     std::fill(Δq.begin(), Δq.end(), Displacement{});
     std::fill(Δv.begin(), Δv.end(), Velocity{});
 
-    if (first_stage == 1) {
+    if constexpr (first_stage == 1) {
       for (int k = 0; k < dimension; ++k) {
-        if (composition == BAB) {
+        if constexpr (composition == BAB) {
           // exp(b₀ h B)
-          Δv[k] += h * b[0] * g[k];
+          Δv[k] += h * b_[0] * g[k];
         }
         // exp(a₀ h A)
-        Δq[k] += h * a[0] * (v[k].value + Δv[k]);
+        Δq[k] += h * a_[0] * (v[k].value + Δv[k]);
       }
     }
 
-    for (int i = first_stage; i < stages_; ++i) {
-      for (int k = 0; k < dimension; ++k) {
-        q_stage[k] = q[k].value + Δq[k];
-      }
-      status.Update(
-          equation.compute_acceleration(
-              t.value + (t.error + c[i] * h), q_stage, g));
-      for (int k = 0; k < dimension; ++k) {
-        // exp(bᵢ h B)
-        Δv[k] += h * b[i] * g[k];
-        // NOTE(egg): in the BAB case, at the last stage, this will be an
-        // exercise in adding 0.  I don't think the optimizer can know that.  Do
-        // we care?
-        // exp(aᵢ h A)
-        Δq[k] += h * a[i] * (v[k].value + Δv[k]);
-      }
-    }
+    // The remaining stages are expanded at compile time, so that the
+    // coefficients are constants and the vanishing ones are elided (this is the
+    // case of the last aᵢ in the BAB case).
+    [&]<std::size_t... j>(std::index_sequence<j...>) {
+      (stage(std::integral_constant<int, first_stage + j>()), ...);
+    }(std::make_index_sequence<stages_ - first_stage>());
 
     // Increment the solution.
     t.Increment(h);
@@ -133,6 +152,7 @@ Instance::Solve(Instant const& t_final) {
       q[k].Increment(Δq[k]);
       v[k].Increment(Δv[k]);
     }
+    this->RecordAcceptedStep(h);
     append_state(current_state);
     RETURN_IF_STOPPED;  // After the state has been updated.
     if (absl::IsAborted(status)) {
@@ -195,7 +215,11 @@ Instance::Instance(InitialValueProblem<ODE> const& problem,
     : FixedStepSizeIntegrator<ODE>::Instance(problem,
                                              std::move(append_state),
                                              step),
-      integrator_(integrator) {}
+      integrator_(integrator),
+      Δq_(problem.initial_state.positions.size()),
+      Δv_(problem.initial_state.positions.size()),
+      q_stage_(problem.initial_state.positions.size()),
+      g_(problem.initial_state.positions.size()) {}
 
 template<typename Method, typename ODE_>
 SymplecticRungeKuttaNyströmIntegrator<Method, ODE_>::
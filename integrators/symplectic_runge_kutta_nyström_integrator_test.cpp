@@ -29,6 +29,7 @@ using ::std::placeholders::_1;
 using ::std::placeholders::_2;
 using ::std::placeholders::_3;
 using ::testing::AllOf;
+using ::testing::ElementsAreArray;
 using ::testing::Ge;
 using ::testing::Gt;
 using ::testing::Le;
@@ -866,5 +867,54 @@ TEST_P(SymplecticRungeKuttaNyströmIntegratorTest, Serialization) {
   EXPECT_THAT(message1, EqualsProto(message2));
 }
 
+// Checks that an equation with a concrete functor type for its right-hand side
+// gives the same results as one with a |std::function|.
+TEST(SymplecticRungeKuttaNyströmIntegratorInliningTest, Functor) {
+  using InlinedODE = SpecialSecondOrderDifferentialEquation<
+      Length, HarmonicOscillatorAcceleration1D>;
+  using Method = methods::BlanesMoan2002SRKN14A;
+  Length const q_initial = 1 * Metre;
+  Speed const v_initial = 0 * Metre / Second;
+  Instant const t_initial;
+  Instant const t_final = t_initial + 163 * Second;
+  Time const step = 0.2 * Second;
+
+  int evaluations = 0;
+  std::vector<ODE::State> solution;
+  {
+    InitialValueProblem<ODE> problem;
+    problem.equation.compute_acceleration =
+        std::bind(ComputeHarmonicOscillatorAcceleration1D,
+                  _1, _2, _3, &evaluations);
+    problem.initial_state = {t_initial, {q_initial}, {v_initial}};
+    auto const append_state = [&solution](ODE::State const& state) {
+      solution.push_back(state);
+    };
+    auto const& integrator = SymplecticRungeKuttaNyströmIntegrator<Method, ODE>();
+    auto const instance =
+        integrator.NewInstance(problem, append_state, step);
+    EXPECT_OK(instance->Solve(t_final));
+  }
+
+  int inlined_evaluations = 0;
+  std::vector<InlinedODE::State> inlined_solution;
+  {
+    InitialValueProblem<InlinedODE> problem;
+    problem.equation.compute_acceleration.evaluations = &inlined_evaluations;
+    problem.initial_state = {t_initial, {q_initial}, {v_initial}};
+    auto const append_state =
+        [&inlined_solution](InlinedODE::State const& state) {
+          inlined_solution.push_back(state);
+        };
+    auto const& integrator = SymplecticRungeKuttaNyströmIntegrator<Method, InlinedODE>();
+    auto const instance =
+        integrator.NewInstance(problem, append_state, step);
+    EXPECT_OK(instance->Solve(t_final));
+  }
+
+  EXPECT_EQ(evaluations, inlined_evaluations);
+  EXPECT_THAT(inlined_solution, ElementsAreArray(solution));
+}
+
 }  // namespace integrators
 }  // namespace principia
@@ -0,0 +1,161 @@
+// The files containing the tree of of child classes of |Integrator| must be
+// included in the order of inheritance to avoid circular dependencies.  This
+// class will end up being reincluded as part of the implementation of its
+// parent.
+#ifndef PRINCIPIA_INTEGRATORS_INTEGRATORS_HPP_
+#include "integrators/integrators.hpp"
+#else
+#ifndef PRINCIPIA_INTEGRATORS_VARIABLE_STEP_ADAMS_INTEGRATOR_HPP_
+#define PRINCIPIA_INTEGRATORS_VARIABLE_STEP_ADAMS_INTEGRATOR_HPP_
+
+#include <array>
+#include <list>
+#include <memory>
+
+#include "absl/status/status.h"
+#include "base/not_null.hpp"
+#include "base/traits.hpp"
+#include "geometry/instant.hpp"
+#include "integrators/ordinary_differential_equations.hpp"
+#include "quantities/quantities.hpp"
+#include "serialization/integrators.pb.h"
+
+namespace principia {
+namespace integrators {
+namespace _variable_step_adams_integrator {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::base::_traits;
+using namespace principia::geometry::_instant;
+using namespace principia::integrators::_integrators;
+using namespace principia::integrators::_ordinary_differential_equations;
+using namespace principia::quantities::_quantities;
+
+// This class solves ordinary differential equations of the form q″ = f(q, t)
+// using a variable-step, variable-order Adams method in PECE mode.  The
+// equation is integrated directly in second-order form: the increments of the
+// velocity and of the position over a step of length h are the integrals of
+// f and (h - τ) f, respectively, where f is replaced by the polynomial that
+// interpolates the accelerations of the previous steps (predictor) or of the
+// previous steps and the predicted end of the step (corrector).  Since the
+// steps are not equally spaced, the weights of the formulæ are recomputed at
+// each step by Gauss-Legendre quadrature of the Lagrange basis polynomials.
+// Each step costs two evaluations of the right-hand side, one for the
+// predicted position and one for the corrected position.  The difference
+// between the predictor and the corrector is the error estimate.  After each
+// step the order of the predictor, between 1 and |max_order|, is chosen
+// among the current order and its two neighbours as the one that permits the
+// largest next step.  The integration starts at order 1 and the order
+// increases as the history grows.
+template<typename Method, typename ODE_>
+class VariableStepAdamsIntegrator : public AdaptiveStepSizeIntegrator<ODE_> {
+ public:
+  using ODE = ODE_;
+  static_assert(is_instance_of_v<SpecialSecondOrderDifferentialEquation, ODE>);
+  using typename Integrator<ODE>::AppendState;
+  using typename AdaptiveStepSizeIntegrator<ODE>::Parameters;
+  using typename AdaptiveStepSizeIntegrator<ODE>::ToleranceToErrorRatio;
+
+  static constexpr int max_order = Method::max_order;
+
+  VariableStepAdamsIntegrator() = default;
+
+  VariableStepAdamsIntegrator(VariableStepAdamsIntegrator const&) = delete;
+  VariableStepAdamsIntegrator(VariableStepAdamsIntegrator&&) = delete;
+  VariableStepAdamsIntegrator& operator=(
+      VariableStepAdamsIntegrator const&) = delete;
+  VariableStepAdamsIntegrator& operator=(
+      VariableStepAdamsIntegrator&&) = delete;
+
+  class Instance : public AdaptiveStepSizeIntegrator<ODE>::Instance {
+   public:
+    absl::Status Solve(Instant const& t_final) override;
+    VariableStepAdamsIntegrator const& integrator() const override;
+    not_null<std::unique_ptr<typename Integrator<ODE>::Instance>> Clone()
+        const override;
+
+    // The history of the integration is not serialized: a deserialized
+    // instance restarts at order 1 from its current state.
+    void WriteToMessage(
+        not_null<serialization::IntegratorInstance*> message) const override;
+    template<typename DV = typename ODE::DependentVariable,
+             typename = std::enable_if_t<is_serializable_v<DV>>>
+    static not_null<std::unique_ptr<Instance>> ReadFromMessage(
+        serialization::VariableStepAdamsIntegratorInstance const& extension,
+        InitialValueProblem<ODE> const& problem,
+        AppendState const& append_state,
+        ToleranceToErrorRatio const& tolerance_to_error_ratio,
+        Parameters const& parameters,
+        Time const& time_step,
+        bool first_use,
+        VariableStepAdamsIntegrator const& integrator);
+
+    // The order of the predictor for the next step.
+    int order() const;
+
+   private:
+    // A point of the history of the integration.
+    struct Step {
+      Instant time;
+      typename ODE::DependentVariableDerivatives2 accelerations;
+    };
+
+    Instance(InitialValueProblem<ODE> const& problem,
+             AppendState const& append_state,
+             ToleranceToErrorRatio const& tolerance_to_error_ratio,
+             Parameters const& parameters,
+             Time const& time_step,
+             bool first_use,
+             VariableStepAdamsIntegrator const& integrator);
+
+    VariableStepAdamsIntegrator const& integrator_;
+    // The most recent step comes first.  At most |max_order| steps are kept.
+    std::list<Step> history_;
+    int order_ = 1;
+    friend class VariableStepAdamsIntegrator;
+  };
+
+  not_null<std::unique_ptr<typename Integrator<ODE>::Instance>> NewInstance(
+      InitialValueProblem<ODE> const& problem,
+      AppendState const& append_state,
+      ToleranceToErrorRatio const& tolerance_to_error_ratio,
+      Parameters const& parameters) const override;
+
+  void WriteToMessage(
+      not_null<serialization::AdaptiveStepSizeIntegrator*> message)
+      const override;
+
+ private:
+  // The corrector uses one node more than the predictor of maximal order.
+  static constexpr int max_nodes_ = max_order + 1;
+  using Nodes = std::array<double, max_nodes_>;
+
+  // The ratio between successive steps is bounded to preserve the stability of
+  // the multistep formulæ.
+  static constexpr double max_step_ratio_ = 2;
+
+  // Computes the weights of the Adams formulæ on [0, 1] for the first
+  // |number_of_nodes| values of |nodes|, expressed in units of the step.
+  // |velocity_weights| are the integrals of the Lagrange basis polynomials ℓⱼ,
+  // |position_weights| the integrals of (1 - s) ℓⱼ(s).
+  static void ComputeWeights(Nodes const& nodes,
+                             int number_of_nodes,
+                             Nodes& velocity_weights,
+                             Nodes& position_weights);
+};
+
+}  // namespace internal
+
+template<typename Method, typename ODE_>
+internal::VariableStepAdamsIntegrator<Method, ODE_> const&
+VariableStepAdamsIntegrator();
+
+}  // namespace _variable_step_adams_integrator
+}  // namespace integrators
+}  // namespace principia
+
+#include "integrators/variable_step_adams_integrator_body.hpp"
+
+#endif  // PRINCIPIA_INTEGRATORS_VARIABLE_STEP_ADAMS_INTEGRATOR_HPP_
+#endif  // PRINCIPIA_INTEGRATORS_INTEGRATORS_HPP_
@@ -0,0 +1,483 @@
+#pragma once
+
+#include "integrators/variable_step_adams_integrator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/jthread.hpp"
+#include "geometry/sign.hpp"
+#include "glog/logging.h"
+#include "integrators/methods.hpp"
+#include "numerics/double_precision.hpp"
+#include "numerics/gauss_legendre_weights.mathematica.h"
+#include "numerics/legendre_roots.mathematica.h"
+
+namespace principia {
+namespace integrators {
+namespace _variable_step_adams_integrator {
+namespace internal {
+
+using namespace principia::geometry::_sign;
+using namespace principia::numerics::_double_precision;
+using namespace principia::numerics::_gauss_legendre_weights;
+using namespace principia::numerics::_legendre_roots;
+
+template<typename Method, typename ODE_>
+absl::Status VariableStepAdamsIntegrator<Method, ODE_>::Instance::Solve(
+    Instant const& t_final) {
+  using Position = typename ODE::DependentVariable;
+  using Displacement = typename ODE::DependentVariableDifference;
+  using Velocity = typename ODE::DependentVariableDerivative;
+  using Acceleration = typename ODE::DependentVariableDerivative2;
+
+  typename Integrator<ODE>::Instance::SolveTimer const timer(*this);
+
+  auto& append_state = this->append_state_;
+  auto& current_state = this->current_state_;
+  auto& first_use = this->first_use_;
+  auto& parameters = this->parameters_;
+  auto const& equation = this->equation_;
+
+  // State before the last, truncated step.
+  std::optional<typename ODE::State> final_state;
+
+  // Argument checks.
+  int const dimension = current_state.positions.size();
+  Sign const integration_direction = Sign(parameters.first_step);
+  if (integration_direction.is_positive()) {
+    // Integrating forward.
+    CHECK_LT(current_state.time.value, t_final);
+  } else {
+    // Integrating backward.
+    CHECK_GT(current_state.time.value, t_final);
+  }
+  CHECK(first_use || !parameters.last_step_is_exact)
+      << "Cannot reuse an instance where the last step is exact";
+  first_use = false;
+
+  // Time step.  Updated as the integration progresses to allow restartability.
+  Time& h = this->step_;
+  // Current time.  This is a non-const reference whose purpose is to make the
+  // equations more readable.
+  DoublePrecision<Instant>& t = current_state.time;
+  // Current position and velocity.  These are non-const references whose
+  // purpose is to make the equations more readable.
+  std::vector<DoublePrecision<Position>>& q = current_state.positions;
+  std::vector<DoublePrecision<Velocity>>& v = current_state.velocities;
+
+  absl::Status status;
+  absl::Status step_status;
+
+  // The positions passed to the right-hand side.
+  std::vector<Position> q_stage(dimension);
+
+  // The history starts with the acceleration at the initial state.
+  if (history_.empty()) {
+    auto& step = history_.emplace_front();
+    step.time = t.value;
+    step.accelerations.resize(dimension);
+    for (int i = 0; i < dimension; ++i) {
+      q_stage[i] = q[i].value;
+    }
+    status.Update(this->Evaluate(
+        equation.compute_acceleration, t.value, q_stage, step.accelerations));
+  }
+
+  // The predicted acceleration at the end of the step.
+  std::vector<Acceleration> a_predicted(dimension);
+  // The increments of the predictor of the current order, of the corrector, and
+  // of the predictors of the neighbouring orders.
+  std::vector<Displacement> Δq_predicted(dimension);
+  std::vector<Velocity> Δv_predicted(dimension);
+  std::vector<Displacement> Δq_corrected(dimension);
+  std::vector<Velocity> Δv_corrected(dimension);
+  std::vector<Displacement> Δq_other(dimension);
+  std::vector<Velocity> Δv_other(dimension);
+  // Accumulators for the weighted sums of the accelerations.
+  std::vector<Acceleration> Σⱼ_velocity_weightⱼ_aⱼ(dimension);
+  std::vector<Acceleration> Σⱼ_position_weightⱼ_aⱼ(dimension);
+
+  typename ODE::State::Error error_estimate;
+  error_estimate.position_error.resize(dimension);
+  error_estimate.velocity_error.resize(dimension);
+
+  // The nodes of the predictor, i.e., the times of the history scaled by the
+  // step, and the nodes of the corrector, which has an additional node at the
+  // end of the step.
+  Nodes predictor_nodes;
+  Nodes corrector_nodes;
+  Nodes velocity_weights;
+  Nodes position_weights;
+
+  // Sets |Δq| and |Δv| to the increments of the formula with the given weights.
+  // If |a_end| is not null, the first weight applies to it and the following
+  // ones to the first |number_of_steps| of the history; otherwise the weights
+  // apply to the history.
+  auto const increments = [&](std::vector<Acceleration> const* const a_end,
+                              int const number_of_steps,
+                              std::vector<Displacement>& Δq,
+                              std::vector<Velocity>& Δv) {
+    int node = 0;
+    if (a_end == nullptr) {
+      std::fill(Σⱼ_velocity_weightⱼ_aⱼ.begin(),
+                Σⱼ_velocity_weightⱼ_aⱼ.end(),
+                Acceleration{});
+      std::fill(Σⱼ_position_weightⱼ_aⱼ.begin(),
+                Σⱼ_position_weightⱼ_aⱼ.end(),
+                Acceleration{});
+    } else {
+      for (int i = 0; i < dimension; ++i) {
+        Σⱼ_velocity_weightⱼ_aⱼ[i] = velocity_weights[0] * (*a_end)[i];
+        Σⱼ_position_weightⱼ_aⱼ[i] = position_weights[0] * (*a_end)[i];
+      }
+      ++node;
+    }
+    auto it = history_.cbegin();
+    for (int j = 0; j < number_of_steps; ++j, ++it, ++node) {
+      auto const& aⱼ = it->accelerations;
+      for (int i = 0; i < dimension; ++i) {
+        Σⱼ_velocity_weightⱼ_aⱼ[i] += velocity_weights[node] * aⱼ[i];
+        Σⱼ_position_weightⱼ_aⱼ[i] += position_weights[node] * aⱼ[i];
+      }
+    }
+    for (int i = 0; i < dimension; ++i) {
+      Δv[i] = h * Σⱼ_velocity_weightⱼ_aⱼ[i];
+      Δq[i] = h * v[i].value + h * h * Σⱼ_position_weightⱼ_aⱼ[i];
+    }
+  };
+
+  // Returns the tolerance-to-error ratio of a predictor whose increments are
+  // |Δq| and |Δv|, using the corrector as the reference.
+  auto const ratio = [&](std::vector<Displacement> const& Δq,
+                         std::vector<Velocity> const& Δv) {
+    for (int i = 0; i < dimension; ++i) {
+      error_estimate.position_error[i] = Δq_corrected[i] - Δq[i];
+      error_estimate.velocity_error[i] = Δv_corrected[i] - Δv[i];
+    }
+    return this->tolerance_to_error_ratio_(h, current_state, error_estimate);
+  };
+
+  bool at_end = false;
+
+  // The number of steps already performed.
+  std::int64_t step_count = 0;
+
+  while (!at_end) {
+    // The order of the predictor for this step.
+    int const k = std::min<int>(order_, history_.size());
+    double tolerance_to_error_ratio;
+
+    // Compute the next step with decreasing step sizes until the error is
+    // tolerable.
+    for (;;) {
+      // Reset the status as any error returned by a force computation for a
+      // rejected step is now moot.
+      step_status = absl::OkStatus();
+
+      if (t.value + (t.error + h) == t.value) {
+        return absl::Status(termination_condition::VanishingStepSize,
+                            "At time " + DebugString(t.value) +
+                                ", step size is effectively zero.  "
+                                "Singularity or stiff system suspected.");
+      }
+
+      // Termination condition.
+      if (parameters.last_step_is_exact) {
+        Time const time_to_end = (t_final - t.value) - t.error;
+        at_end = integration_direction * h >=
+                 integration_direction * time_to_end;
+        if (at_end) {
+          // The chosen step size will overshoot.  Clip it to just reach the
+          // end, and terminate if the step is accepted.
+          h = time_to_end;
+          final_state = current_state;
+        }
+      }
+      Instant const t_next = (parameters.last_step_is_exact && at_end)
+                                 ? t_final
+                                 : t.value + (t.error + h);
+
+      // The nodes depend on the step size.
+      {
+        int j = 0;
+        corrector_nodes[0] = 1;
+        for (auto const& step : history_) {
+          predictor_nodes[j] = (step.time - t.value) / h;
+          corrector_nodes[j + 1] = predictor_nodes[j];
+          if (++j == max_order) {
+            break;
+          }
+        }
+      }
+
+      // Predict.
+      ComputeWeights(predictor_nodes, k, velocity_weights, position_weights);
+      increments(/*a_end=*/nullptr, k, Δq_predicted, Δv_predicted);
+
+      // Evaluate.
+      for (int i = 0; i < dimension; ++i) {
+        q_stage[i] = q[i].value + Δq_predicted[i];
+      }
+      step_status.Update(this->Evaluate(
+          equation.compute_acceleration, t_next, q_stage, a_predicted));
+
+      // Correct.
+      ComputeWeights(
+          corrector_nodes, k + 1, velocity_weights, position_weights);
+      increments(&a_predicted, k, Δq_corrected, Δv_corrected);
+
+      tolerance_to_error_ratio = ratio(Δq_predicted, Δv_predicted);
+      if (tolerance_to_error_ratio >= 1.0) {
+        break;
+      }
+      // The step is rejected.  Note that |at_end| is recomputed for the new
+      // step.
+      this->RecordRejectedStep();
+      h *= parameters.safety_factor *
+           std::pow(tolerance_to_error_ratio, 1.0 / (k + 1));
+    }
+
+    status.Update(step_status);
+
+    if (!parameters.last_step_is_exact && t.value + (t.error + h) > t_final) {
+      // We did overshoot.  Drop the point that we just computed and exit.
+      final_state = current_state;
+      break;
+    }
+
+    // Choose the order of the next step as the one that permits the largest
+    // step, based on the errors of the predictors of the neighbouring orders.
+    double best_step_factor = parameters.safety_factor *
+                              std::pow(tolerance_to_error_ratio, 1.0 / (k + 1));
+    int best_order = k;
+    if (k > 1) {
+      ComputeWeights(
+          predictor_nodes, k - 1, velocity_weights, position_weights);
+      increments(/*a_end=*/nullptr, k - 1, Δq_other, Δv_other);
+      double const step_factor =
+          parameters.safety_factor *
+          std::pow(ratio(Δq_other, Δv_other), 1.0 / k);
+      if (step_factor > best_step_factor) {
+        best_step_factor = step_factor;
+        best_order = k - 1;
+      }
+    }
+    if (k < max_order && history_.size() > k) {
+      ComputeWeights(
+          predictor_nodes, k + 1, velocity_weights, position_weights);
+      increments(/*a_end=*/nullptr, k + 1, Δq_other, Δv_other);
+      double const step_factor =
+          parameters.safety_factor *
+          std::pow(ratio(Δq_other, Δv_other), 1.0 / (k + 2));
+      if (step_factor > best_step_factor) {
+        best_step_factor = step_factor;
+        best_order = k + 1;
+      }
+    }
+
+    // Increment the solution with the corrector.
+    t.Increment(h);
+    for (int i = 0; i < dimension; ++i) {
+      q[i].Increment(Δq_corrected[i]);
+      v[i].Increment(Δv_corrected[i]);
+    }
+    this->RecordAcceptedStep(h);
+
+    // Evaluate at the corrected position and record the step, recycling the
+    // oldest one if the history is full.
+    if (history_.size() == max_order) {
+      history_.splice(history_.begin(), history_, std::prev(history_.end()));
+    } else {
+      history_.emplace_front().accelerations.resize(dimension);
+    }
+    Step& step = history_.front();
+    step.time = t.value;
+    for (int i = 0; i < dimension; ++i) {
+      q_stage[i] = q[i].value;
+    }
+    status.Update(this->Evaluate(
+        equation.compute_acceleration, t.value, q_stage, step.accelerations));
+
+    order_ = best_order;
+    h *= std::min(best_step_factor, max_step_ratio_);
+
+    append_state(current_state);
+    RETURN_IF_STOPPED;  // After the state has been updated.
+    ++step_count;
+    if (step_count == parameters.max_steps && !at_end) {
+      return absl::Status(termination_condition::ReachedMaximalStepCount,
+                          "Reached maximum step count " +
+                              std::to_string(parameters.max_steps) +
+                              " at time " + DebugString(t.value) +
+                              "; requested t_final is " + DebugString(t_final) +
+                              ".");
+    }
+  }
+  // The resolution is restartable from the last non-truncated state.
+  CHECK(final_state);
+  current_state = *final_state;
+  return status;
+}
+
+template<typename Method, typename ODE_>
+VariableStepAdamsIntegrator<Method, ODE_> const&
+VariableStepAdamsIntegrator<Method, ODE_>::Instance::integrator() const {
+  return integrator_;
+}
+
+template<typename Method, typename ODE_>
+not_null<std::unique_ptr<typename Integrator<ODE_>::Instance>>
+VariableStepAdamsIntegrator<Method, ODE_>::Instance::Clone() const {
+  return std::unique_ptr<Instance>(new Instance(*this));
+}
+
+template<typename Method, typename ODE_>
+void VariableStepAdamsIntegrator<Method, ODE_>::Instance::WriteToMessage(
+    not_null<serialization::IntegratorInstance*> message) const {
+  AdaptiveStepSizeIntegrator<ODE>::Instance::WriteToMessage(message);
+  [[maybe_unused]] auto* const extension =
+      message
+          ->MutableExtension(
+              serialization::AdaptiveStepSizeIntegratorInstance::extension)
+          ->MutableExtension(
+              serialization::VariableStepAdamsIntegratorInstance::extension);
+}
+
+template<typename Method, typename ODE_>
+template<typename, typename>
+not_null<std::unique_ptr<
+    typename VariableStepAdamsIntegrator<Method, ODE_>::Instance>>
+VariableStepAdamsIntegrator<Method, ODE_>::Instance::ReadFromMessage(
+    serialization::VariableStepAdamsIntegratorInstance const& extension,
+    InitialValueProblem<ODE> const& problem,
+    AppendState const& append_state,
+    ToleranceToErrorRatio const& tolerance_to_error_ratio,
+    Parameters const& parameters,
+    Time const& time_step,
+    bool const first_use,
+    VariableStepAdamsIntegrator const& integrator) {
+  // Cannot use |make_not_null_unique| because the constructor of |Instance| is
+  // private.
+  return std::unique_ptr<Instance>(new Instance(problem,
+                                                append_state,
+                                                tolerance_to_error_ratio,
+                                                parameters,
+                                                time_step,
+                                                first_use,
+                                                integrator));
+}
+
+template<typename Method, typename ODE_>
+int VariableStepAdamsIntegrator<Method, ODE_>::Instance::order() const {
+  return order_;
+}
+
+template<typename Method, typename ODE_>
+VariableStepAdamsIntegrator<Method, ODE_>::Instance::Instance(
+    InitialValueProblem<ODE> const& problem,
+    AppendState const& append_state,
+    ToleranceToErrorRatio const& tolerance_to_error_ratio,
+    Parameters const& parameters,
+    Time const& time_step,
+    bool const first_use,
+    VariableStepAdamsIntegrator const& integrator)
+    : AdaptiveStepSizeIntegrator<ODE>::Instance(problem,
+                                                append_state,
+                                                tolerance_to_error_ratio,
+                                                parameters,
+                                                time_step,
+                                                first_use),
+      integrator_(integrator) {}
+
+template<typename Method, typename ODE_>
+not_null<std::unique_ptr<typename Integrator<ODE_>::Instance>>
+VariableStepAdamsIntegrator<Method, ODE_>::NewInstance(
+    InitialValueProblem<ODE> const& problem,
+    AppendState const& append_state,
+    ToleranceToErrorRatio const& tolerance_to_error_ratio,
+    Parameters const& parameters) const {
+  // Cannot use |make_not_null_unique| because the constructor of |Instance| is
+  // private.
+  return std::unique_ptr<Instance>(
+      new Instance(problem,
+                   append_state,
+                   tolerance_to_error_ratio,
+                   parameters,
+                   /*step=*/parameters.first_step,
+                   /*first_use=*/true,
+                   *this));
+}
+
+template<typename Method, typename ODE_>
+void VariableStepAdamsIntegrator<Method, ODE_>::WriteToMessage(
+    not_null<serialization::AdaptiveStepSizeIntegrator*> message) const {
+  message->set_kind(Method::kind);
+}
+
+template<typename Method, typename ODE_>
+void VariableStepAdamsIntegrator<Method, ODE_>::ComputeWeights(
+    Nodes const& nodes,
+    int const number_of_nodes,
+    Nodes& velocity_weights,
+    Nodes& position_weights) {
+  // The integrands are polynomials of degree at most |max_nodes_|, which this
+  // quadrature integrates exactly.
+  constexpr int points = max_nodes_ / 2 + 1;
+  static_assert(points < LegendreRoots.rows(),
+                "No table for Gauss-Legendre with the chosen number of points");
+  double const* const roots = LegendreRoots.row<points>();
+  double const* const weights = GaussLegendreWeights.row<points>();
+
+  // The barycentric weights of the nodes.
+  Nodes λ;
+  for (int j = 0; j < number_of_nodes; ++j) {
+    double product = 1;
+    for (int m = 0; m < number_of_nodes; ++m) {
+      if (m != j) {
+        product *= nodes[j] - nodes[m];
+      }
+    }
+    λ[j] = 1 / product;
+  }
+
+  std::fill_n(velocity_weights.begin(), number_of_nodes, 0.0);
+  std::fill_n(position_weights.begin(), number_of_nodes, 0.0);
+  for (int p = 0; p < points; ++p) {
+    // The Gauss-Legendre points are in the interior of [0, 1], so they never
+    // coincide with a node.
+    double const s = (roots[p] + 1) / 2;
+    double const weight = weights[p] / 2;
+    double node_polynomial = 1;
+    for (int m = 0; m < number_of_nodes; ++m) {
+      node_polynomial *= s - nodes[m];
+    }
+    for (int j = 0; j < number_of_nodes; ++j) {
+      double const weight_ℓⱼ =
+          weight * node_polynomial * λ[j] / (s - nodes[j]);
+      velocity_weights[j] += weight_ℓⱼ;
+      position_weights[j] += (1 - s) * weight_ℓⱼ;
+    }
+  }
+}
+
+}  // namespace internal
+
+template<typename Method, typename ODE_>
+internal::VariableStepAdamsIntegrator<Method, ODE_> const&
+VariableStepAdamsIntegrator() {
+  static_assert(
+      std::is_base_of<_methods::VariableStepAdams, Method>::value,
+      "Method must be derived from VariableStepAdams");
+  static internal::VariableStepAdamsIntegrator<Method, ODE_> const integrator;
+  return integrator;
+}
+
+}  // namespace _variable_step_adams_integrator
+}  // namespace integrators
+}  // namespace principia
@@ -0,0 +1,229 @@
+#include "integrators/variable_step_adams_integrator.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "geometry/instant.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "integrators/integrators.hpp"
+#include "integrators/methods.hpp"
+#include "integrators/ordinary_differential_equations.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/approximate_quantity.hpp"
+#include "testing_utilities/integration.hpp"
+#include "testing_utilities/is_near.hpp"
+#include "testing_utilities/matchers.hpp"
+#include "testing_utilities/numerics.hpp"
+
+namespace principia {
+namespace integrators {
+
+using ::std::placeholders::_1;
+using ::std::placeholders::_2;
+using ::std::placeholders::_3;
+using ::testing::Ge;
+using ::testing::Le;
+using ::testing::Lt;
+using namespace principia::geometry::_instant;
+using namespace principia::integrators::_integrators;
+using namespace principia::integrators::_methods;
+using namespace principia::integrators::_ordinary_differential_equations;
+using namespace principia::integrators::_variable_step_adams_integrator;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_approximate_quantity;
+using namespace principia::testing_utilities::_integration;
+using namespace principia::testing_utilities::_is_near;
+using namespace principia::testing_utilities::_matchers;
+using namespace principia::testing_utilities::_numerics;
+
+using ODE = SpecialSecondOrderDifferentialEquation<Length>;
+
+namespace {
+
+double HarmonicOscillatorToleranceRatio(
+    Time const& h,
+    ODE::State const& /*state*/,
+    ODE::State::Error const& error,
+    Length const& q_tolerance,
+    Speed const& v_tolerance) {
+  return std::min(q_tolerance / Abs(error.position_error[0]),
+                  v_tolerance / Abs(error.velocity_error[0]));
+}
+
+}  // namespace
+
+class VariableStepAdamsIntegratorTest : public ::testing::Test {
+ protected:
+  using Integrator = _variable_step_adams_integrator::internal::
+      VariableStepAdamsIntegrator<methods::AdamsBashforthMoultonPECEOrder12,
+                                  ODE>;
+
+  VariableStepAdamsIntegratorTest()
+      : integrator_(VariableStepAdamsIntegrator<
+                    methods::AdamsBashforthMoultonPECEOrder12, ODE>()) {
+    harmonic_oscillator_.compute_acceleration =
+        std::bind(ComputeHarmonicOscillatorAcceleration1D,
+                  _1, _2, _3, &evaluations_);
+    problem_.equation = harmonic_oscillator_;
+    problem_.initial_state = {t_initial_, {x_initial_}, {v_initial_}};
+  }
+
+  Integrator const& integrator_;
+  Length const x_initial_ = 1 * Metre;
+  Speed const v_initial_ = 0 * Metre / Second;
+  Time const period_ = 2 * π * Second;
+  Instant const t_initial_;
+  Instant const t_final_ = t_initial_ + 10 * period_;
+  int evaluations_ = 0;
+  ODE harmonic_oscillator_;
+  InitialValueProblem<ODE> problem_;
+  std::vector<ODE::State> solution_;
+};
+
+TEST_F(VariableStepAdamsIntegratorTest, HarmonicOscillator) {
+  Length const length_tolerance = 1 * Milli(Metre);
+  Speed const speed_tolerance = 1 * Milli(Metre) / Second;
+  auto const append_state = [this](ODE::State const& state) {
+    solution_.push_back(state);
+  };
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final_ - t_initial_,
+      /*safety_factor=*/0.9);
+  auto const tolerance_to_error_ratio =
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2, _3,
+                length_tolerance,
+                speed_tolerance);
+  auto const instance = integrator_.NewInstance(problem_,
+                                                append_state,
+                                                tolerance_to_error_ratio,
+                                                parameters);
+  EXPECT_THAT(instance->Solve(t_final_),
+              StatusIs(termination_condition::Done));
+
+  EXPECT_THAT(AbsoluteError(x_initial_, solution_.back().positions[0].value),
+              IsNear(9.1e-6_(1) * Metre));
+  EXPECT_THAT(AbsoluteError(v_initial_, solution_.back().velocities[0].value),
+              IsNear(2.1e-4_(1) * Metre / Second));
+  EXPECT_EQ(t_final_, solution_.back().time.value);
+  // The order has increased from its initial value.
+  EXPECT_THAT(dynamic_cast<Integrator::Instance const&>(*instance).order(),
+              Ge(5));
+  // Two evaluations per accepted step, plus one for the initial state and one
+  // per rejection.  At the same tolerance, the RKN method 4(3) takes 132 steps
+  // and about 1.5 times as many evaluations.
+  int const steps = solution_.size();
+  EXPECT_EQ(118, steps);
+  EXPECT_EQ(270, evaluations_);
+  EXPECT_EQ(steps, instance->statistics().accepted_steps);
+  EXPECT_EQ(evaluations_ - 1 - 2 * steps,
+            instance->statistics().rejected_steps);
+  EXPECT_EQ(evaluations_, instance->statistics().evaluations);
+}
+
+TEST_F(VariableStepAdamsIntegratorTest, HighAccuracy) {
+  Length const length_tolerance = 1e-10 * Metre;
+  Speed const speed_tolerance = 1e-10 * Metre / Second;
+  auto const append_state = [this](ODE::State const& state) {
+    solution_.push_back(state);
+  };
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final_ - t_initial_,
+      /*safety_factor=*/0.9);
+  auto const tolerance_to_error_ratio =
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2, _3,
+                length_tolerance,
+                speed_tolerance);
+  auto const instance = integrator_.NewInstance(problem_,
+                                                append_state,
+                                                tolerance_to_error_ratio,
+                                                parameters);
+  EXPECT_THAT(instance->Solve(t_final_),
+              StatusIs(termination_condition::Done));
+
+  EXPECT_THAT(AbsoluteError(x_initial_, solution_.back().positions[0].value),
+              Lt(1e-8 * Metre));
+  EXPECT_THAT(AbsoluteError(v_initial_, solution_.back().velocities[0].value),
+              Lt(1e-8 * Metre / Second));
+  EXPECT_EQ(Integrator::max_order,
+            dynamic_cast<Integrator::Instance const&>(*instance).order());
+}
+
+TEST_F(VariableStepAdamsIntegratorTest, Restart) {
+  Length const length_tolerance = 1e-6 * Metre;
+  Speed const speed_tolerance = 1e-6 * Metre / Second;
+  auto const append_state = [this](ODE::State const& state) {
+    solution_.push_back(state);
+  };
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final_ - t_initial_,
+      /*safety_factor=*/0.9);
+  auto const tolerance_to_error_ratio =
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2, _3,
+                length_tolerance,
+                speed_tolerance);
+  auto const instance = integrator_.NewInstance(problem_,
+                                                append_state,
+                                                tolerance_to_error_ratio,
+                                                parameters);
+  // Solving in two parts keeps the history, and reaches the same final state
+  // as a single solve up to the effect of the intermediate clipping.
+  EXPECT_THAT(instance->Solve(t_initial_ + 5 * period_),
+              StatusIs(termination_condition::Done));
+  int const evaluations_first_half = evaluations_;
+  EXPECT_THAT(instance->Solve(t_final_),
+              StatusIs(termination_condition::Done));
+  EXPECT_EQ(t_final_, solution_.back().time.value);
+  EXPECT_THAT(AbsoluteError(x_initial_, solution_.back().positions[0].value),
+              Lt(1e-5 * Metre));
+  // No restart at order 1: the second half is about as cheap as the first.
+  EXPECT_THAT(evaluations_ - evaluations_first_half,
+              Le(evaluations_first_half));
+}
+
+TEST_F(VariableStepAdamsIntegratorTest, Serialization) {
+  auto const append_state = [this](ODE::State const& state) {
+    solution_.push_back(state);
+  };
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final_ - t_initial_,
+      /*safety_factor=*/0.9);
+  auto const tolerance_to_error_ratio =
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2, _3,
+                /*q_tolerance=*/1 * Milli(Metre),
+                /*v_tolerance=*/1 * Milli(Metre) / Second);
+
+  auto const instance1 = integrator_.NewInstance(problem_,
+                                                 append_state,
+                                                 tolerance_to_error_ratio,
+                                                 parameters);
+  serialization::IntegratorInstance message1;
+  instance1->WriteToMessage(&message1);
+  auto const instance2 =
+      AdaptiveStepSizeIntegrator<ODE>::Instance::ReadFromMessage(
+          message1,
+          harmonic_oscillator_,
+          append_state,
+          tolerance_to_error_ratio);
+  serialization::IntegratorInstance message2;
+  instance2->WriteToMessage(&message2);
+  EXPECT_THAT(message1, EqualsProto(message2));
+
+  EXPECT_EQ(&integrator_,
+            &ParseAdaptiveStepSizeIntegrator<ODE>(
+                "ADAMS_BASHFORTH_MOULTON_PECE_ORDER_12"));
+}
+
+}  // namespace integrators
+}  // namespace principia
@@ -4,11 +4,15 @@
 #include <memory>
 #include <type_traits>
 
+#include "base/macros.hpp"  // 🧙 For forward declarations.
 #include "base/not_constructible.hpp"
 #include "base/not_null.hpp"
 
 namespace principia {
 namespace journal {
+
+FORWARD_DECLARE(class, Recorder, FROM(recorder), INTO(method));
+
 namespace _method {
 namespace internal {
 
@@ -91,6 +95,11 @@ class Method final {
   typename P::Return Return(typename P::Return const& result);
 
  private:
+  // The recorder that was active at construction, if any.  It is read once so
+  // that the constructor and the destructor agree on whether to record, and so
+  // that the common case where journaling is off costs a single test.  The
+  // messages are only built if it is not null.
+  Recorder* const recorder_;
   std::function<void(not_null<typename Profile::Message*> message)> out_filler_;
   std::function<void(not_null<typename Profile::Message*> message)>
       return_filler_;
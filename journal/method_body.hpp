@@ -14,35 +14,37 @@ namespace internal {
 using namespace principia::journal::_recorder;
 
 template<typename Profile>
-Method<Profile>::Method() {
-  if (Recorder::active_recorder_ != nullptr) {
+Method<Profile>::Method() : recorder_(Recorder::active_recorder_) {
+  if (recorder_ != nullptr) [[unlikely]] {
     serialization::Method method;
     [[maybe_unused]] auto* const message_in =
         method.MutableExtension(Profile::Message::extension);
-    Recorder::active_recorder_->WriteAtConstruction(method);
+    recorder_->WriteAtConstruction(method);
   }
 }
 
 template<typename Profile>
 template<typename P, typename>
-Method<Profile>::Method(typename P::In const& in) {
-  if (Recorder::active_recorder_ != nullptr) {
+Method<Profile>::Method(typename P::In const& in)
+    : recorder_(Recorder::active_recorder_) {
+  if (recorder_ != nullptr) [[unlikely]] {
     serialization::Method method;
     auto* const message_in =
         method.MutableExtension(Profile::Message::extension);
     Profile::Fill(in, message_in);
-    Recorder::active_recorder_->WriteAtConstruction(method);
+    recorder_->WriteAtConstruction(method);
   }
 }
 
 template<typename Profile>
 template<typename P, typename>
-Method<Profile>::Method(typename P::Out const& out) {
-  if (Recorder::active_recorder_ != nullptr) {
+Method<Profile>::Method(typename P::Out const& out)
+    : recorder_(Recorder::active_recorder_) {
+  if (recorder_ != nullptr) [[unlikely]] {
     serialization::Method method;
     [[maybe_unused]] auto* const message_in =
         method.MutableExtension(Profile::Message::extension);
-    Recorder::active_recorder_->WriteAtConstruction(method);
+    recorder_->WriteAtConstruction(method);
     out_filler_ = [out](
         not_null<typename Profile::Message*> const message) {
       Profile::Fill(out, message);
@@ -52,13 +54,14 @@ Method<Profile>::Method(typename P::Out const& out) {
 
 template<typename Profile>
 template<typename P, typename>
-Method<Profile>::Method(typename P::In const& in, typename P::Out const& out) {
-  if (Recorder::active_recorder_ != nullptr) {
+Method<Profile>::Method(typename P::In const& in, typename P::Out const& out)
+    : recorder_(Recorder::active_recorder_) {
+  if (recorder_ != nullptr) [[unlikely]] {
     serialization::Method method;
     auto* const message_in =
         method.MutableExtension(Profile::Message::extension);
     Profile::Fill(in, message_in);
-    Recorder::active_recorder_->WriteAtConstruction(method);
+    recorder_->WriteAtConstruction(method);
     out_filler_ = [out](
         not_null<typename Profile::Message*> const message) {
       Profile::Fill(out, message);
@@ -69,7 +72,7 @@ Method<Profile>::Method(typename P::In const& in, typename P::Out const& out) {
 template<typename Profile>
 Method<Profile>::~Method() {
   CHECK(returned_);
-  if (Recorder::active_recorder_ != nullptr) {
+  if (recorder_ != nullptr) [[unlikely]] {
     serialization::Method method;
     auto* const extension =
         method.MutableExtension(Profile::Message::extension);
@@ -79,7 +82,7 @@ Method<Profile>::~Method() {
     if (return_filler_ != nullptr) {
       return_filler_(extension);
     }
-    Recorder::active_recorder_->WriteAtDestruction(method);
+    recorder_->WriteAtDestruction(method);
   }
 }
 
@@ -96,7 +99,7 @@ typename P::Return Method<Profile>::Return(
     typename P::Return const& result) {
   CHECK(!returned_);
   returned_ = true;
-  if (Recorder::active_recorder_ != nullptr) {
+  if (recorder_ != nullptr) [[unlikely]] {
     return_filler_ =
         [result](not_null<typename Profile::Message*> const message) {
           Profile::Fill(result, message);
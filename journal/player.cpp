@@ -1,17 +1,23 @@
 #include "journal/player.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 
 #include "absl/strings/match.h"
 #include "base/array.hpp"
 #include "base/get_line.hpp"
 #include "base/hexadecimal.hpp"
 #include "base/version.hpp"
+#include "gipfeli/gipfeli.h"
 #include "glog/logging.h"
 #include "journal/profiles.hpp"  // 🧙 For generated profiles.
+#include "journal/recorder.hpp"
 
 #define PRINCIPIA_PLAYER_ALLOW_VERSION_MISMATCH 0
 
@@ -25,15 +31,87 @@ using namespace principia::base::_array;
 using namespace principia::base::_get_line;
 using namespace principia::base::_hexadecimal;
 using namespace principia::base::_version;
+using namespace principia::journal::_recorder;
 
 using namespace std::chrono_literals;
 
-Player::Player(std::filesystem::path const& path)
-    : stream_(path, std::ios::in) {
+Player::Player(std::filesystem::path const& path) : path_(path) {
   principia__ActivatePlayer();
+  {
+    std::ifstream probe(path, std::ios::in | std::ios::binary);
+    CHECK(!probe.fail()) << path;
+    std::string magic(Recorder::binary_magic.size() + 1, '\0');
+    probe.read(magic.data(), magic.size());
+    if (probe.gcount() == static_cast<std::streamsize>(magic.size()) &&
+        absl::StartsWith(magic, Recorder::binary_magic)) {
+      binary_ = true;
+      if (magic.back() != '\0') {
+        decompressor_ = google::compression::NewGipfeliCompressor();
+      }
+    }
+  }
+  if (binary_) {
+    stream_.open(path, std::ios::in | std::ios::binary);
+    stream_.seekg(Recorder::binary_magic.size() + 1);
+  } else {
+    stream_.open(path, std::ios::in);
+  }
   CHECK(!stream_.fail());
 }
 
+Player::~Player() {
+  if (prefetcher_.joinable()) {
+    {
+      absl::MutexLock l(&prefetch_lock_);
+      shutdown_ = true;
+    }
+    prefetcher_.join();
+  }
+}
+
+void Player::WriteIndex(std::filesystem::path const& path, int const period) {
+  Player player(path);
+  std::ofstream index(IndexPath(path), std::ios::out);
+  CHECK(!index.fail()) << IndexPath(path);
+  for (int i = 0;; ++i) {
+    Position const position = player.CurrentPosition();
+    if (player.ReadFromStream() == nullptr ||
+        player.ReadFromStream() == nullptr) {
+      break;
+    }
+    if (i % period == 0) {
+      index << i << " " << position.offset << " " << position.chunk_position
+            << "\n";
+    }
+  }
+}
+
+bool Player::SeekTo(int const index) {
+  CHECK(!prefetcher_.joinable()) << "Cannot seek after reading";
+  int current_index = 0;
+  std::ifstream index_stream(IndexPath(path_), std::ios::in);
+  if (!index_stream.fail()) {
+    int entry_index;
+    Position entry_position;
+    std::optional<Position> position;
+    while (index_stream >> entry_index >> entry_position.offset >>
+               entry_position.chunk_position &&
+           entry_index <= index) {
+      current_index = entry_index;
+      position = entry_position;
+    }
+    if (position.has_value()) {
+      SeekTo(*position);
+    }
+  }
+  for (; current_index < index; ++current_index) {
+    if (ReadFromStream() == nullptr || ReadFromStream() == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool Player::Play(int const index) {
   return Process(/*method_in=*/Read(), index, /*play=*/true);
 }
@@ -50,7 +128,76 @@ serialization::Method const& Player::last_method_out_return() const {
   return *last_method_out_return_;
 }
 
+std::chrono::nanoseconds Player::last_method_duration() const {
+  return last_method_duration_;
+}
+
+std::filesystem::path Player::IndexPath(std::filesystem::path const& path) {
+  return std::filesystem::path(path) += ".index";
+}
+
 std::unique_ptr<serialization::Method> Player::Read() {
+  if (!prefetcher_.joinable()) {
+    prefetcher_ = MakeStoppableThread([this]() { Prefetch(); });
+  }
+  absl::MutexLock l(&prefetch_lock_);
+  auto const has_prefetched_methods = [this]() {
+    prefetch_lock_.AssertReaderHeld();
+    return !prefetched_methods_.empty();
+  };
+  prefetch_lock_.Await(absl::Condition(&has_prefetched_methods));
+  std::unique_ptr<serialization::Method> method =
+      std::move(prefetched_methods_.front());
+  // The end of the stream is never removed from the queue.
+  if (method != nullptr) {
+    prefetched_methods_.pop_front();
+  }
+  return method;
+}
+
+void Player::Prefetch() {
+  for (;;) {
+    std::unique_ptr<serialization::Method> method = ReadFromStream();
+    bool const end_of_stream = method == nullptr;
+    absl::MutexLock l(&prefetch_lock_);
+    auto const has_room_or_shutdown = [this]() {
+      prefetch_lock_.AssertReaderHeld();
+      return prefetched_methods_.size() <
+                 static_cast<std::size_t>(max_prefetched_methods) ||
+             shutdown_;
+    };
+    prefetch_lock_.Await(absl::Condition(&has_room_or_shutdown));
+    if (shutdown_) {
+      return;
+    }
+    prefetched_methods_.push_back(std::move(method));
+    if (end_of_stream) {
+      return;
+    }
+  }
+}
+
+std::unique_ptr<serialization::Method> Player::ReadFromStream() {
+  if (binary_) {
+    if (chunk_position_ == chunk_.size() && !ReadChunk()) {
+      return nullptr;
+    }
+    CHECK_LE(chunk_position_ + 4, chunk_.size());
+    std::uint32_t size = 0;
+    for (int i = 0; i < 4; ++i) {
+      size |= static_cast<std::uint32_t>(
+                  static_cast<unsigned char>(chunk_[chunk_position_ + i]))
+              << (8 * i);
+    }
+    chunk_position_ += 4;
+    CHECK_LE(chunk_position_ + size, chunk_.size());
+    auto method = std::make_unique<serialization::Method>();
+    CHECK(method->ParseFromArray(&chunk_[chunk_position_],
+                                 static_cast<int>(size)));
+    chunk_position_ += size;
+    return method;
+  }
+
   std::string const line = GetLine(stream_);
   if (line.empty()) {
     return nullptr;
@@ -64,6 +211,62 @@ std::unique_ptr<serialization::Method> Player::Read() {
   return method;
 }
 
+bool Player::ReadChunk() {
+  chunk_offset_ = stream_.tellg();
+  std::optional<std::uint32_t> const chunk_size = ReadSize();
+  if (!chunk_size.has_value()) {
+    return false;
+  }
+  std::string stored_chunk(*chunk_size, '\0');
+  stream_.read(stored_chunk.data(), stored_chunk.size());
+  CHECK_EQ(static_cast<std::streamsize>(stored_chunk.size()), stream_.gcount())
+      << "Truncated chunk";
+  if (decompressor_ == nullptr) {
+    chunk_ = std::move(stored_chunk);
+  } else {
+    chunk_.clear();
+    CHECK(decompressor_->Uncompress(stored_chunk, &chunk_));
+  }
+  chunk_position_ = 0;
+  return true;
+}
+
+std::optional<std::uint32_t> Player::ReadSize() {
+  unsigned char bytes[4];
+  stream_.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+  if (stream_.gcount() == 0) {
+    return std::nullopt;
+  }
+  CHECK_EQ(4, stream_.gcount()) << "Truncated size";
+  std::uint32_t size = 0;
+  for (int i = 0; i < 4; ++i) {
+    size |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+  }
+  return size;
+}
+
+auto Player::CurrentPosition() -> Position {
+  if (binary_ && chunk_position_ < chunk_.size()) {
+    return {.offset = chunk_offset_, .chunk_position = chunk_position_};
+  } else {
+    return {.offset = stream_.tellg(), .chunk_position = 0};
+  }
+}
+
+void Player::SeekTo(Position const& position) {
+  stream_.clear();
+  stream_.seekg(position.offset);
+  CHECK(!stream_.fail()) << position.offset;
+  chunk_.clear();
+  chunk_position_ = 0;
+  if (position.chunk_position > 0) {
+    CHECK(binary_);
+    CHECK(ReadChunk());
+    CHECK_LT(position.chunk_position, chunk_.size());
+    chunk_position_ = position.chunk_position;
+  }
+}
+
 bool Player::Process(std::unique_ptr<serialization::Method> method_in,
                      int const index, bool const play) {
   if (method_in == nullptr) {
@@ -108,12 +311,15 @@ bool Player::Process(std::unique_ptr<serialization::Method> method_in,
                                  << method_out_return->ShortDebugString();
 #endif
 
+  last_method_duration_ = std::chrono::nanoseconds{};
   if (play) {
     auto const before = std::chrono::system_clock::now();
 
 #include "journal/player.generated.cc"
 
     auto const after = std::chrono::system_clock::now();
+    last_method_duration_ =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(after - before);
     if (after - before > 100ms) {
       LOG(ERROR) << "Long method (" << (after - before) / 1ms << " ms):\n"
                  << method_in->DebugString();
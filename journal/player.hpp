@@ -1,10 +1,17 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <map>
 #include <memory>
+#include <optional>
+#include <string>
 
+#include "absl/synchronization/mutex.h"
+#include "base/jthread.hpp"
+#include "gipfeli/compression.h"
 #include "serialization/journal.pb.h"
 
 namespace principia {
@@ -16,12 +23,32 @@ class RecorderTest;
 namespace _player {
 namespace internal {
 
+using namespace principia::base::_jthread;
+
+// The messages are read and parsed ahead of their execution by a background
+// thread.
 class Player final {
  public:
   using PointerMap = std::map<std::uint64_t, void*>;
 
+  // The journal may be in any of the formats of the |Recorder|.
   explicit Player(std::filesystem::path const& path);
 
+  ~Player();
+
+  // Writes an index of the journal at |path| next to it, with the position of
+  // one message out of |period|.
+  static void WriteIndex(std::filesystem::path const& path,
+                         int period = 10'000);
+
+  // Positions the player so that the next message to be replayed is the one
+  // with the given |index|, using the index of the journal if it exists.  The
+  // messages that are skipped are not executed, so this is mostly useful with
+  // |Scan|, e.g., to inspect the messages that precede a crash.  Must be
+  // called before any message has been replayed.  Returns false if the journal
+  // has fewer messages.
+  bool SeekTo(int index);
+
   // Replays the next message in the journal.  Returns false at end of journal.
   // |index| is the 0-based index of the message in the journal.
   bool Play(int index);
@@ -33,10 +60,45 @@ class Player final {
   serialization::Method const& last_method_in() const;
   serialization::Method const& last_method_out_return() const;
 
+  // The time taken to execute the last replayed message, zero if it was only
+  // scanned.
+  std::chrono::nanoseconds last_method_duration() const;
+
  private:
-  // Reads one message from the stream.  Returns a |nullptr| at end of stream.
+  // The position of a message in the journal.
+  struct Position {
+    std::streamoff offset;
+    // For the binary formats, the position of the message in the uncompressed
+    // chunk that starts at |offset|.
+    std::size_t chunk_position;
+  };
+
+  // The number of messages that are read ahead of their execution.
+  static constexpr int max_prefetched_methods = 1000;
+
+  static std::filesystem::path IndexPath(std::filesystem::path const& path);
+
+  // Returns the next message prefetched from the stream.  Returns a |nullptr|
+  // at end of stream.
   std::unique_ptr<serialization::Method> Read();
 
+  // The loop of the |prefetcher_|.
+  void Prefetch();
+
+  // Reads one message from the stream.  Returns a |nullptr| at end of stream.
+  std::unique_ptr<serialization::Method> ReadFromStream();
+
+  // Reads the next chunk of a binary journal.  Returns false at end of stream.
+  bool ReadChunk();
+
+  // Reads a size written by the |Recorder| from the stream.  Returns nullopt
+  // at end of stream.
+  std::optional<std::uint32_t> ReadSize();
+
+  // The position of the next message to be read from the stream.
+  Position CurrentPosition();
+  void SeekTo(Position const& position);
+
   // Implementation of |Play| and |Scan|.
   bool Process(std::unique_ptr<serialization::Method> method_in,
                int const index, bool const play);
@@ -46,10 +108,30 @@ class Player final {
                         serialization::Method const& method_out_return);
 
   PointerMap pointer_map_;
+  std::filesystem::path const path_;
+
+  // Only accessed by the |prefetcher_| once it has started.
   std::ifstream stream_;
 
+  // Set for the binary formats, in which case |decompressor_| is set if the
+  // chunks are compressed, and |chunk_| is the uncompressed chunk that starts
+  // at |chunk_offset_| in the stream, being read at |chunk_position_|.
+  bool binary_ = false;
+  std::unique_ptr<google::compression::Compressor> decompressor_;
+  std::string chunk_;
+  std::streamoff chunk_offset_ = 0;
+  std::size_t chunk_position_ = 0;
+
+  absl::Mutex prefetch_lock_;
+  // A |nullptr| marks the end of the stream.
+  std::deque<std::unique_ptr<serialization::Method>> prefetched_methods_
+      GUARDED_BY(prefetch_lock_);
+  bool shutdown_ GUARDED_BY(prefetch_lock_) = false;
+  jthread prefetcher_;
+
   std::unique_ptr<serialization::Method> last_method_in_;
   std::unique_ptr<serialization::Method> last_method_out_return_;
+  std::chrono::nanoseconds last_method_duration_{};
 
   friend class journal::PlayerTest;
   friend class journal::RecorderTest;
@@ -1,10 +1,14 @@
 #include "journal/player.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "benchmark/benchmark.h"
 #include "glog/logging.h"
 #include "gtest/gtest.h"
@@ -38,6 +42,59 @@ void BM_PlayForReal(benchmark::State& state) {
 
 BENCHMARK(BM_PlayForReal);
 
+// Replays a journal of a map view session and reports the median and 99th
+// percentile of the durations of the calls that plot or render trajectories,
+// per method.  You must set |path|.
+void BM_PlayPlotting(benchmark::State& state) {
+  static absl::flat_hash_set<std::string> const plotting_methods = {
+      "CameraReferenceRotation",
+      "CameraScale",
+      "PlanetariumCreate",
+      "PlanetariumDelete",
+      "PlanetariumPlotCelestialFutureTrajectory",
+      "PlanetariumPlotCelestialPastTrajectory",
+      "PlanetariumPlotCelestialTrajectories",
+      "PlanetariumPlotEquipotential",
+      "PlanetariumPlotFlightPlanSegment",
+      "PlanetariumPlotPrediction",
+      "PlanetariumPlotPsychohistory",
+      "RenderedPredictionApsides",
+      "RenderedPredictionClosestApproaches",
+      "RenderedPredictionNodes",
+      "SetPlottingFrame"};
+  std::string const path =
+      R"(P:\Public Mockingbird\Principia\Journals\JOURNAL.20240301-194015)";
+  for (auto _ : state) {
+    std::map<std::string, std::vector<std::chrono::nanoseconds>> durations;
+    Player player(path);
+    int count = 0;
+    while (player.Play(count)) {
+      ++count;
+      // The only field of a method is the extension of its message.
+      std::vector<google::protobuf::FieldDescriptor const*> fields;
+      player.last_method_in().GetReflection()->ListFields(
+          player.last_method_in(), &fields);
+      CHECK_EQ(1, fields.size());
+      std::string const& name = fields.front()->extension_scope()->name();
+      if (plotting_methods.contains(name)) {
+        durations[name].push_back(player.last_method_duration());
+      }
+    }
+    for (auto& [name, method_durations] : durations) {
+      std::sort(method_durations.begin(), method_durations.end());
+      auto const p50 = method_durations[method_durations.size() / 2];
+      auto const p99 = method_durations[method_durations.size() * 99 / 100];
+      state.counters[name + " p50 µs"] = p50 / 1us;
+      state.counters[name + " p99 µs"] = p99 / 1us;
+      LOG(ERROR) << name << ": " << method_durations.size()
+                 << " calls, p50 " << p50 / 1us << " µs, p99 " << p99 / 1us
+                 << " µs";
+    }
+  }
+}
+
+BENCHMARK(BM_PlayPlotting);
+
 class PlayerTest : public ::testing::Test {
  protected:
   PlayerTest()
@@ -86,6 +143,44 @@ TEST_F(PlayerTest, PlayTiny) {
   EXPECT_EQ(3, count);
 }
 
+TEST_F(PlayerTest, SeekTo) {
+  for (auto const format : {Recorder::Format::Hexadecimal,
+                            Recorder::Format::CompressedBinary}) {
+    std::string const path = test_name_ + ".journal";
+    {
+      Recorder* const r(new Recorder(path, format));
+      Recorder::Activate(r);
+      for (int i = 0; i < 10; ++i) {
+        Method<NewPlugin> m({"MJD1", "MJD2", static_cast<double>(i)});
+        m.Return(plugin_.get());
+      }
+      Recorder::Deactivate();
+    }
+    Player::WriteIndex(path, /*period=*/3);
+
+    // The journal starts with a GetVersion message.
+    for (int const index : {0, 4, 6, 10}) {
+      Player player(path);
+      EXPECT_TRUE(player.SeekTo(index));
+      EXPECT_TRUE(player.Scan(index));
+      auto const& method_in = player.last_method_in();
+      if (index == 0) {
+        EXPECT_TRUE(
+            method_in.HasExtension(serialization::GetVersion::extension));
+      } else {
+        EXPECT_EQ(index - 1,
+                  method_in.GetExtension(serialization::NewPlugin::extension)
+                      .in()
+                      .planetarium_rotation_in_degrees());
+      }
+    }
+    {
+      Player player(path);
+      EXPECT_FALSE(player.SeekTo(12));
+    }
+  }
+}
+
 TEST_F(PlayerTest, DISABLED_SECULAR_Benchmarks) {
   benchmark::RunSpecifiedBenchmarks();
 }
@@ -2,7 +2,7 @@
 
 #include "base/not_constructible.hpp"
 #include "base/not_null.hpp"
-#include "base/pull_serializer.hpp"
+#include "base/pipelined_serializer.hpp"
 #include "base/push_deserializer.hpp"
 #include "base/push_pull_callback.hpp"
 #include "journal/player.hpp"
@@ -53,7 +53,7 @@ using interface::XY;
 using interface::XYZ;
 using namespace principia::base::_not_constructible;
 using namespace principia::base::_not_null;
-using namespace principia::base::_pull_serializer;
+using namespace principia::base::_pipelined_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::base::_push_pull_callback;
 using namespace principia::journal::_player;
@@ -1,11 +1,16 @@
 #include "journal/recorder.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <limits>
+#include <string>
+#include <utility>
 
 #include "base/array.hpp"
 #include "base/hexadecimal.hpp"
 #include "base/serialization.hpp"
 #include "base/version.hpp"
+#include "gipfeli/gipfeli.h"
 #include "glog/logging.h"
 
 namespace principia {
@@ -18,9 +23,42 @@ using namespace principia::base::_hexadecimal;
 using namespace principia::base::_serialization;
 using namespace principia::base::_version;
 
-Recorder::Recorder(std::filesystem::path const& path)
-    : stream_(path, std::ios::out) {
+namespace {
+
+void AppendSize(std::size_t const size, std::string& bytes) {
+  CHECK_LE(size, std::numeric_limits<std::uint32_t>::max());
+  for (int i = 0; i < 4; ++i) {
+    bytes.push_back(static_cast<char>((size >> (8 * i)) & 0xFF));
+  }
+}
+
+}  // namespace
+
+Recorder::Recorder(std::filesystem::path const& path, Format const format)
+    : format_(format),
+      stream_(path,
+              format == Format::Hexadecimal
+                  ? std::ios::out
+                  : std::ios::out | std::ios::binary),
+      compressor_(format == Format::CompressedBinary
+                      ? google::compression::NewGipfeliCompressor()
+                      : nullptr) {
   CHECK(!stream_.fail()) << path;
+  if (format_ != Format::Hexadecimal) {
+    stream_ << binary_magic
+            << static_cast<char>(format_ == Format::CompressedBinary);
+    writer_ = MakeStoppableThread([this]() { WriteChunks(); });
+  }
+}
+
+Recorder::~Recorder() {
+  if (writer_.joinable()) {
+    {
+      absl::MutexLock l(&buffer_lock_);
+      shutdown_ = true;
+    }
+    writer_.join();
+  }
 }
 
 void Recorder::WriteAtConstruction(serialization::Method const& method) {
@@ -62,11 +100,56 @@ bool Recorder::IsActivated() {
 }
 
 void Recorder::WriteLocked(serialization::Method const& method) {
-  static auto* const encoder = new HexadecimalEncoder</*null_terminated=*/true>;
   CHECK_LT(0, method.ByteSize()) << method.DebugString();
-  auto const hexadecimal = encoder->Encode(SerializeAsBytes(method).get());
-  stream_ << hexadecimal.data.get() << "\n";
-  stream_.flush();
+  if (format_ == Format::Hexadecimal) {
+    static auto* const encoder =
+        new HexadecimalEncoder</*null_terminated=*/true>;
+    auto const hexadecimal = encoder->Encode(SerializeAsBytes(method).get());
+    stream_ << hexadecimal.data.get() << "\n";
+    stream_.flush();
+  } else {
+    // Serialize outside of the |buffer_lock_| so as to not block the |writer_|.
+    std::string const bytes = method.SerializeAsString();
+    absl::MutexLock l(&buffer_lock_);
+    AppendSize(bytes.size(), buffer_);
+    buffer_.append(bytes);
+  }
+}
+
+void Recorder::WriteChunks() {
+  std::string uncompressed;
+  std::string compressed;
+  for (;;) {
+    bool shutdown;
+    {
+      absl::MutexLock l(&buffer_lock_);
+      auto const chunk_full_or_shutdown = [this]() {
+        buffer_lock_.AssertReaderHeld();
+        return buffer_.size() >= chunk_size || shutdown_;
+      };
+      buffer_lock_.AwaitWithTimeout(absl::Condition(&chunk_full_or_shutdown),
+                                    absl::FromChrono(max_buffering_time));
+      // Swapping the buffers keeps their capacity.
+      uncompressed.clear();
+      std::swap(uncompressed, buffer_);
+      shutdown = shutdown_;
+    }
+    if (!uncompressed.empty()) {
+      std::string const* chunk = &uncompressed;
+      if (compressor_ != nullptr) {
+        compressed.clear();
+        compressor_->Compress(uncompressed, &compressed);
+        chunk = &compressed;
+      }
+      std::string size;
+      AppendSize(chunk->size(), size);
+      stream_ << size << *chunk;
+      stream_.flush();
+    }
+    if (shutdown) {
+      return;
+    }
+  }
 }
 
 Recorder* Recorder::active_recorder_ = nullptr;
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
 
 #include "absl/synchronization/mutex.h"
+#include "base/jthread.hpp"
 #include "base/macros.hpp"  // 🧙 For forward declarations.
 #include "base/not_null.hpp"
+#include "gipfeli/compression.h"
 #include "serialization/journal.pb.h"
 
 namespace principia {
@@ -18,11 +24,34 @@ class RecorderTest;
 namespace _recorder {
 namespace internal {
 
+using namespace principia::base::_jthread;
 using namespace principia::base::_not_null;
 
 class Recorder final {
  public:
-  explicit Recorder(std::filesystem::path const& path);
+  // In the |Hexadecimal| format, each method is hex-encoded and written on a
+  // line of its own, and the file is flushed after each method.  In the
+  // |Binary| and |CompressedBinary| formats, the file starts with
+  // |binary_magic| followed by a byte that indicates if the chunks are
+  // compressed with gipfeli.  It is then made of chunks, each of which is
+  // preceded by its size as a 32-bit little-endian integer.  Once uncompressed,
+  // a chunk is a sequence of methods, each of which is preceded by its size as
+  // a 32-bit little-endian integer.  The methods are buffered and written by a
+  // background thread, so some of them may be lost in a crash.
+  enum class Format {
+    Hexadecimal,
+    Binary,
+    CompressedBinary,
+  };
+
+  // The first byte cannot start a line of the |Hexadecimal| format.
+  static constexpr std::string_view binary_magic = "\xFFPrincipiaJournal";
+
+  explicit Recorder(std::filesystem::path const& path,
+                    Format format = Format::Hexadecimal);
+
+  // Writes the methods that are still buffered.
+  ~Recorder();
 
   // Locking is used to ensure that the pairs of writes don't get intermixed.
   void WriteAtConstruction(serialization::Method const& method);
@@ -33,11 +62,28 @@ class Recorder final {
   static bool IsActivated();
 
  private:
+  // A chunk is written when this many bytes are buffered, or at the latest
+  // after |max_buffering_time|.
+  static constexpr int chunk_size = 1 << 20;
+  static constexpr std::chrono::seconds max_buffering_time{1};
+
   void WriteLocked(serialization::Method const& method);
 
+  // The loop of the |writer_| thread in the binary formats.
+  void WriteChunks();
+
+  Format const format_;
   absl::Mutex lock_;
   std::ofstream stream_;
 
+  // Only used by the |writer_|.
+  std::unique_ptr<google::compression::Compressor> const compressor_;
+
+  absl::Mutex buffer_lock_;
+  std::string buffer_ GUARDED_BY(buffer_lock_);
+  bool shutdown_ GUARDED_BY(buffer_lock_) = false;
+  jthread writer_;
+
   static Recorder* active_recorder_;
 
   template<typename>
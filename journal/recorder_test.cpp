@@ -146,5 +146,46 @@ TEST_F(RecorderTest, Recording) {
   }
 }
 
+TEST_F(RecorderTest, BinaryFormats) {
+  for (auto const format : {Recorder::Format::Binary,
+                            Recorder::Format::CompressedBinary}) {
+    std::string const path = test_name_ + ".journal.bin";
+    {
+      Recorder recorder(path, format);
+      for (int i = 0; i < 1000; ++i) {
+        serialization::Method method_in;
+        auto* const in =
+            method_in.MutableExtension(serialization::NewPlugin::extension)
+                ->mutable_in();
+        in->set_game_epoch("1 s");
+        in->set_solar_system_epoch("2 s");
+        in->set_planetarium_rotation_in_degrees(i);
+        serialization::Method method_return;
+        method_return.MutableExtension(serialization::NewPlugin::extension)
+            ->mutable_return_()
+            ->set_result(i + 1);
+        recorder.WriteAtConstruction(method_in);
+        recorder.WriteAtDestruction(method_return);
+      }
+    }
+
+    std::vector<serialization::Method> const methods = ReadAll(path);
+    ASSERT_EQ(2000, methods.size());
+    for (int i = 0; i < 1000; ++i) {
+      auto const& in = methods[2 * i]
+                           .GetExtension(serialization::NewPlugin::extension)
+                           .in();
+      EXPECT_EQ("1 s", in.game_epoch());
+      EXPECT_EQ("2 s", in.solar_system_epoch());
+      EXPECT_EQ(i, in.planetarium_rotation_in_degrees());
+      EXPECT_EQ(i + 1,
+                methods[2 * i + 1]
+                    .GetExtension(serialization::NewPlugin::extension)
+                    .return_()
+                    .result());
+    }
+  }
+}
+
 }  // namespace journal
 }  // namespace principia
@@ -2,12 +2,14 @@
 
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <thread>
 #include <utility>
 #include <vector>
 
 #include "base/status_utilities.hpp"  // 🧙 For CHECK_OK.
+#include "serialization/ksp_plugin.pb.h"
 #include "integrators/embedded_explicit_generalized_runge_kutta_nyström_integrator.hpp"
 #include "integrators/embedded_explicit_runge_kutta_nyström_integrator.hpp"
 #include "integrators/methods.hpp"
@@ -39,6 +41,10 @@ inline absl::Status DoesNotFit() {
   return absl::Status(FlightPlan::does_not_fit, "Does not fit");
 }
 
+inline absl::Status Recomputing() {
+  return absl::Status(FlightPlan::recomputing, "Recomputing");
+}
+
 inline absl::Status Singular(Square<Speed> const& Δv²) {
   return absl::Status(FlightPlan::singular,
                       absl::StrCat("Singular: ", DebugString(Δv²)));
@@ -60,7 +66,8 @@ FlightPlan::FlightPlan(
       desired_final_time_(desired_final_time),
       adaptive_step_parameters_(std::move(adaptive_step_parameters)),
       generalized_adaptive_step_parameters_(
-          std::move(generalized_adaptive_step_parameters)) {
+          std::move(generalized_adaptive_step_parameters)),
+      segment_cache_(make_not_null_shared<SegmentCache>()) {
   CHECK(desired_final_time_ >= initial_time_);
   MakeProlongator(desired_final_time_);
 
@@ -82,31 +89,18 @@ FlightPlan::FlightPlan(FlightPlan const& other)
       initial_degrees_of_freedom_(other.initial_degrees_of_freedom_),
       desired_final_time_(other.desired_final_time_),
       anomalous_segments_(other.anomalous_segments_),
+      anomalous_status_(other.anomalous_status_),
+      integration_statistics_(other.integration_statistics_),
       manœuvres_(other.manœuvres_),
       coast_analysers_(),
       ephemeris_(other.ephemeris_),
       analysis_is_enabled_(other.analysis_is_enabled_),
       adaptive_step_parameters_(other.adaptive_step_parameters_),
       generalized_adaptive_step_parameters_(
-          other.generalized_adaptive_step_parameters_) {
+          other.generalized_adaptive_step_parameters_),
+      segment_cache_(other.segment_cache_) {
   MakeProlongator(desired_final_time_);
-  bool first_segment = true;
-  for (auto const& other_segment : other.trajectory_.segments()) {
-    if (!first_segment) {
-      // The first segment was created by the constructor of the trajectory.
-      trajectory_.NewSegment();
-    }
-    bool first_point = true;
-    for (auto const& [time, degrees_of_freedom] : other_segment) {
-      // For segments other than the first, |NewSegment| copied the last point
-      // of the previous segment.
-      if (!first_point || first_segment) {
-        CHECK_OK(trajectory_.Append(time, degrees_of_freedom));
-      }
-      first_point = false;
-    }
-    first_segment = false;
-  }
+  trajectory_ = other.trajectory_.MakeCopy();
   for (auto it = trajectory_.segments().begin();
        it != trajectory_.segments().end();
        ++it) {
@@ -116,6 +110,15 @@ FlightPlan::FlightPlan(FlightPlan const& other)
     coast_analysers_.push_back(make_not_null_unique<OrbitAnalyser>(
         ephemeris_, DefaultHistoryParameters()));
   }
+  // The segments being recomputed asynchronously by |other| are placeholders,
+  // recompute them synchronously.
+  if (other.recomputation_index_.has_value()) {
+    int const index = *other.recomputation_index_;
+    PopSegmentsAffectedByManœuvre(index);
+    ComputeSegments(manœuvres_.begin() + index,
+                    manœuvres_.end(),
+                    max_ephemeris_steps_per_frame).IgnoreError();
+  }
 }
 
 Instant FlightPlan::initial_time() const {
@@ -152,6 +155,7 @@ absl::Status FlightPlan::Insert(NavigationManœuvre::Burn const& burn,
                                 int const index) {
   CHECK_GE(index, 0);
   CHECK_LE(index, number_of_manœuvres());
+  FinishRecomputation();
   NavigationManœuvre const manœuvre(
       index == 0 ? initial_mass_ : manœuvres_[index - 1].final_mass(),
       burn);
@@ -176,6 +180,7 @@ absl::Status FlightPlan::Insert(NavigationManœuvre::Burn const& burn,
 absl::Status FlightPlan::Remove(int index) {
   CHECK_GE(index, 0);
   CHECK_LT(index, number_of_manœuvres());
+  FinishRecomputation();
   manœuvres_.erase(manœuvres_.begin() + index);
   coast_analysers_.erase(coast_analysers_.begin() + index + 1);
   UpdateInitialMassOfManœuvresAfter(index);
@@ -189,30 +194,8 @@ absl::Status FlightPlan::Replace(NavigationManœuvre::Burn const& burn,
                                  int const index) {
   CHECK_LE(0, index);
   CHECK_LT(index, number_of_manœuvres());
-  NavigationManœuvre const manœuvre(manœuvres_[index].initial_mass(),
-                                    burn);
-  if (manœuvre.IsSingular()) {
-    return Singular(manœuvre.Δv().Norm²());
-  }
-  if (index == number_of_manœuvres() - 1) {
-    // This is the last manœuvre.  If it doesn't fit just because the flight
-    // plan is too short, extend the flight plan.
-    if (manœuvre.IsAfter(start_of_previous_coast(index))) {
-      desired_final_time_ =
-          std::max(desired_final_time_, manœuvre.final_time());
-    } else {
-      return DoesNotFit();
-    }
-  } else if (!manœuvre.FitsBetween(start_of_previous_coast(index),
-                                   start_of_next_burn(index))) {
-    return DoesNotFit();
-  }
-
-  // Replace the manœuvre at position |index| and rebuild all the ones that
-  // follow as they may have a different initial mass.  Also pop the segments
-  // that we'll recompute.
-  manœuvres_[index] = manœuvre;
-  UpdateInitialMassOfManœuvresAfter(index);
+  FinishRecomputation();
+  RETURN_IF_ERROR(ReplaceManœuvre(burn, index));
 
   // TODO(phl): Recompute as late as possible.
   PopSegmentsAffectedByManœuvre(index);
@@ -221,8 +204,65 @@ absl::Status FlightPlan::Replace(NavigationManœuvre::Burn const& burn,
                          max_ephemeris_steps_per_frame);
 }
 
+absl::Status FlightPlan::ReplaceAsynchronously(
+    NavigationManœuvre::Burn const& burn,
+    int const index) {
+  CHECK_LE(0, index);
+  CHECK_LT(index, number_of_manœuvres());
+  PickUpRecomputation();
+  RETURN_IF_ERROR(ReplaceManœuvre(burn, index));
+
+  // If a recomputation is in progress, it is superseded by this one, which
+  // must start early enough to cover the segments that it was computing.
+  int const first_index = recomputation_index_.has_value()
+                              ? std::min(index, *recomputation_index_)
+                              : index;
+  InterruptRecomputation();
+  PopSegmentsAffectedByManœuvre(first_index);
+  if (anomalous_segments_ > 0) {
+    // An earlier segment is anomalous, there is nothing to integrate.
+    return ComputeSegments(manœuvres_.begin() + first_index,
+                           manœuvres_.end(),
+                           max_ephemeris_steps_per_frame);
+  }
+
+  // The recomputation is done on a copy of this flight plan, which only
+  // contains the segments that are kept.  It must be a |shared_ptr| because
+  // |MakeStoppableThread| copies its argument.
+  auto const flight_plan = std::make_shared<FlightPlan>(*this);
+  flight_plan->EnableAnalysis(false);
+
+  // Until the recomputation publishes its results, the affected segments are
+  // anomalous and empty.
+  recomputation_index_ = first_index;
+  anomalous_segments_ = 1;
+  anomalous_status_ = Recomputing();
+  ComputeSegments(manœuvres_.begin() + first_index,
+                  manœuvres_.end(),
+                  max_ephemeris_steps_per_frame).IgnoreError();
+
+  recomputer_ = MakeStoppableThread([this, flight_plan, first_index]() {
+    // The ephemeris is prolonged with the usual budget.  If it is exhausted
+    // the segments are published with a deadline status, and the computation
+    // is resumed by |RecomputeSegmentsAvoidingDeadlineIfNeeded|, like for a
+    // synchronous computation.
+    absl::Status const status = flight_plan->ComputeSegments(
+        flight_plan->manœuvres_.begin() + first_index,
+        flight_plan->manœuvres_.end(),
+        max_ephemeris_steps_per_frame,
+        /*manœuvre_computed=*/[this, &flight_plan]() {
+          PublishRecomputation(*flight_plan, /*done=*/false);
+        });
+    if (!absl::IsCancelled(status)) {
+      PublishRecomputation(*flight_plan, /*done=*/true);
+    }
+  });
+  return absl::OkStatus();
+}
+
 absl::Status FlightPlan::SetDesiredFinalTime(
     Instant const& desired_final_time) {
+  FinishRecomputation();
   if (desired_final_time < start_of_last_coast()) {
     return BadDesiredFinalTime();
   }
@@ -244,6 +284,9 @@ absl::Status FlightPlan::SetAdaptiveStepParameters(
         generalized_adaptive_step_parameters) {
   adaptive_step_parameters_ = adaptive_step_parameters;
   generalized_adaptive_step_parameters_ = generalized_adaptive_step_parameters;
+  // The cached segments were computed with the old parameters, but the copies
+  // of this flight plan may still use them.
+  segment_cache_ = make_not_null_shared<SegmentCache>();
   return RecomputeAllSegments();
 }
 
@@ -257,6 +300,10 @@ FlightPlan::generalized_adaptive_step_parameters() const {
   return generalized_adaptive_step_parameters_;
 }
 
+IntegrationStatistics<Time> const& FlightPlan::integration_statistics() const {
+  return integration_statistics_;
+}
+
 int FlightPlan::number_of_segments() const {
   return segments_.size();
 }
@@ -303,18 +350,26 @@ double FlightPlan::progress_of_analysis(int coast_index) const {
   return coast_analysers_[coast_index]->progress_of_next_analysis();
 }
 
+std::int64_t FlightPlan::MemoryFootprint() const {
+  return sizeof(*this) + trajectory_.MemoryFootprint() +
+         manœuvres_.capacity() * sizeof(NavigationManœuvre) +
+         segments_.capacity() *
+             sizeof(DiscreteTrajectorySegmentIterator<Barycentric>);
+}
+
 void FlightPlan::EnableAnalysis(bool const enabled) {
   if (enabled != analysis_is_enabled_) {
     if (enabled) {
       // Request analysis of all non-anomalous coasts, and the first anomalous
-      // segment if it is a coast.
+      // segment if it is a coast.  The analyses are only computed once they
+      // are looked at.
       for (int index = 0;
            index < segments_.size() - std::max(0, anomalous_segments_ - 1);
            ++index) {
         if (index % 2 == 0) {
           auto const& coast = segments_[index];
           auto const& [first_time, first_degrees_of_freedom] = coast->front();
-          coast_analysers_[index / 2]->RequestAnalysis(
+          coast_analysers_[index / 2]->DeferAnalysis(
               {.first_time = first_time,
                .first_degrees_of_freedom = first_degrees_of_freedom,
                .mission_duration = coast->back().time - first_time,
@@ -425,9 +480,161 @@ FlightPlan::FlightPlan()
               Ephemeris<Barycentric>::GeneralizedNewtonianMotionEquation>(),
           /*max_steps=*/1,
           /*length_integration_tolerance=*/1 * Metre,
-          /*speed_integration_tolerance=*/1 * Metre / Second) {}
+          /*speed_integration_tolerance=*/1 * Metre / Second),
+      segment_cache_(make_not_null_shared<SegmentCache>()) {}
+
+bool FlightPlan::SegmentCache::Key::operator==(Key const& other) const {
+  return initial_time == other.initial_time &&
+         initial_degrees_of_freedom == other.initial_degrees_of_freedom &&
+         final_time == other.final_time &&
+         manœuvre == other.manœuvre;
+}
+
+std::shared_ptr<FlightPlan::SegmentCache::Points const>
+FlightPlan::SegmentCache::Find(Key const& key) {
+  absl::MutexLock l(&lock_);
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->first == key) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return entries_.front().second;
+    }
+  }
+  return nullptr;
+}
+
+void FlightPlan::SegmentCache::Insert(Key key, Points points) {
+  absl::MutexLock l(&lock_);
+  entries_.emplace_front(std::move(key),
+                         std::make_shared<Points const>(std::move(points)));
+  if (entries_.size() > capacity_) {
+    entries_.pop_back();
+  }
+}
+
+absl::Status FlightPlan::ReplaceManœuvre(NavigationManœuvre::Burn const& burn,
+                                         int const index) {
+  NavigationManœuvre const manœuvre(manœuvres_[index].initial_mass(),
+                                    burn);
+  if (manœuvre.IsSingular()) {
+    return Singular(manœuvre.Δv().Norm²());
+  }
+  if (index == number_of_manœuvres() - 1) {
+    // This is the last manœuvre.  If it doesn't fit just because the flight
+    // plan is too short, extend the flight plan.
+    if (manœuvre.IsAfter(start_of_previous_coast(index))) {
+      desired_final_time_ =
+          std::max(desired_final_time_, manœuvre.final_time());
+    } else {
+      return DoesNotFit();
+    }
+  } else if (!manœuvre.FitsBetween(start_of_previous_coast(index),
+                                   start_of_next_burn(index))) {
+    return DoesNotFit();
+  }
+
+  // Replace the manœuvre at position |index| and rebuild all the ones that
+  // follow as they may have a different initial mass.
+  manœuvres_[index] = manœuvre;
+  UpdateInitialMassOfManœuvresAfter(index);
+  return absl::OkStatus();
+}
+
+void FlightPlan::PublishRecomputation(FlightPlan const& flight_plan,
+                                      bool const done) {
+  auto recomputation = std::make_unique<Recomputation>();
+  recomputation->trajectory = flight_plan.trajectory_.MakeCopy();
+  for (auto it = recomputation->trajectory.segments().begin();
+       it != recomputation->trajectory.segments().end();
+       ++it) {
+    recomputation->segments.push_back(it);
+  }
+  recomputation->anomalous_segments = flight_plan.anomalous_segments_;
+  recomputation->anomalous_status = flight_plan.anomalous_status_;
+  recomputation->integration_statistics = flight_plan.integration_statistics_;
+  recomputation->desired_final_time = flight_plan.desired_final_time_;
+  recomputation->done = done;
+  if (!done) {
+    // The last coast is being computed, it and the segments of the following
+    // manœuvres are anomalous.
+    recomputation->anomalous_segments = 1;
+    recomputation->anomalous_status = Recomputing();
+    while (recomputation->segments.size() <
+           2 * flight_plan.manœuvres_.size() + 1) {
+      recomputation->segments.push_back(
+          recomputation->trajectory.NewSegment());
+      ++recomputation->anomalous_segments;
+    }
+  }
+
+  absl::MutexLock l(&recomputation_lock_);
+  recomputation_ = std::move(recomputation);
+}
+
+void FlightPlan::PickUpRecomputation() {
+  std::unique_ptr<Recomputation> recomputation;
+  {
+    absl::MutexLock l(&recomputation_lock_);
+    recomputation = std::move(recomputation_);
+  }
+  if (recomputation == nullptr) {
+    return;
+  }
+
+  trajectory_ = std::move(recomputation->trajectory);
+  segments_ = std::move(recomputation->segments);
+  anomalous_segments_ = recomputation->anomalous_segments;
+  anomalous_status_ = std::move(recomputation->anomalous_status);
+  integration_statistics_ = recomputation->integration_statistics;
+  CHECK_EQ(segments_.size(), 2 * manœuvres_.size() + 1);
+
+  // All the coasting trajectories refer to the previous |trajectory_|.
+  for (int i = 0; i < manœuvres_.size(); ++i) {
+    auto& manœuvre = manœuvres_[i];
+    manœuvre.clear_coasting_trajectory();
+    if (2 * i < number_of_segments() - anomalous_segments_) {
+      manœuvre.set_coasting_trajectory(segments_[2 * i]);
+    }
+  }
+
+  if (recomputation->done) {
+    int const index = *recomputation_index_;
+    desired_final_time_ = recomputation->desired_final_time;
+    recomputer_ = jthread();
+    recomputation_index_.reset();
+    if (analysis_is_enabled_) {
+      // Analyse the coasts that were computed, and the first anomalous one, as
+      // |ComputeSegments| would have done.
+      for (int coast_index = index;
+           2 * coast_index <=
+               number_of_segments() - std::max(1, anomalous_segments_);
+           ++coast_index) {
+        RequestCoastAnalysis(coast_index);
+      }
+    }
+  }
+}
+
+void FlightPlan::InterruptRecomputation() {
+  recomputer_ = jthread();
+  recomputation_index_.reset();
+  absl::MutexLock l(&recomputation_lock_);
+  recomputation_.reset();
+}
+
+void FlightPlan::FinishRecomputation() {
+  PickUpRecomputation();
+  if (recomputation_index_.has_value()) {
+    int const index = *recomputation_index_;
+    InterruptRecomputation();
+    PopSegmentsAffectedByManœuvre(index);
+    ComputeSegments(manœuvres_.begin() + index,
+                    manœuvres_.end(),
+                    max_ephemeris_steps_per_frame).IgnoreError();
+  }
+}
 
 absl::Status FlightPlan::RecomputeAllSegments() {
+  InterruptRecomputation();
   // It is important that the segments be destroyed in (reverse chronological)
   // order of the forks.
   while (segments_.size() > 1) {
@@ -440,6 +647,7 @@ absl::Status FlightPlan::RecomputeAllSegments() {
 }
 
 absl::Status FlightPlan::RecomputeSegmentsAvoidingDeadlineIfNeeded() {
+  PickUpRecomputation();
   if (anomalous_segments_ == 0 ||
       !absl::IsDeadlineExceeded(anomalous_status_)) {
     return absl::OkStatus();
@@ -458,34 +666,72 @@ absl::Status FlightPlan::RecomputeSegmentsAvoidingDeadlineIfNeeded() {
   return ComputeSegments(it, manœuvres_.end(), /*max_ephemeris_steps*/0);
 }
 
+absl::Status FlightPlan::FlowSegmentWithCache(
+    SegmentCache::Key key,
+    DiscreteTrajectorySegmentIterator<Barycentric> const segment,
+    std::function<absl::Status()> const& flow) {
+  if (auto const points = segment_cache_->Find(key); points != nullptr) {
+    for (auto const& [time, degrees_of_freedom] : *points) {
+      CHECK_OK(trajectory_.Append(time, degrees_of_freedom));
+    }
+    return absl::OkStatus();
+  }
+
+  // Make sure that the ephemeris covers the entire segment, reanimating and
+  // waiting if necessary.
+  if (key.initial_time < ephemeris_->t_min()) {
+    ephemeris_->AwaitReanimation(key.initial_time);
+  }
+
+  absl::Status const status = flow();
+  // Only the segments that reach their final time are worth caching: the
+  // others depend on the deadline.
+  if (status.ok()) {
+    SegmentCache::Points points;
+    for (auto it = std::next(segment->find(key.initial_time));
+         it != segment->end();
+         ++it) {
+      points.push_back(*it);
+    }
+    segment_cache_->Insert(std::move(key), std::move(points));
+  }
+  return status;
+}
+
 absl::Status FlightPlan::BurnSegment(
     NavigationManœuvre const& manœuvre,
     DiscreteTrajectorySegmentIterator<Barycentric> const segment,
     std::int64_t const max_ephemeris_steps) {
   Instant const final_time = manœuvre.final_time();
   if (manœuvre.initial_time() < final_time) {
-    // Make sure that the ephemeris covers the entire segment, reanimating and
-    // waiting if necessary.
-    Instant const starting_time = segment->back().time;
-    if (starting_time < ephemeris_->t_min()) {
-      ephemeris_->AwaitReanimation(starting_time);
-    }
-
-    if (manœuvre.is_inertially_fixed()) {
-      return ephemeris_->FlowWithAdaptiveStep(
-                             &trajectory_,
-                             manœuvre.InertialIntrinsicAcceleration(),
-                             final_time,
-                             adaptive_step_parameters_,
-                             max_ephemeris_steps);
-    } else {
-      return ephemeris_->FlowWithAdaptiveStep(
-                             &trajectory_,
-                             manœuvre.FrenetIntrinsicAcceleration(),
-                             final_time,
-                             generalized_adaptive_step_parameters_,
-                             max_ephemeris_steps);
-    }
+    serialization::Manoeuvre message;
+    manœuvre.WriteToMessage(&message);
+    auto const& [initial_time, initial_degrees_of_freedom] = segment->back();
+    return FlowSegmentWithCache(
+        {.initial_time = initial_time,
+         .initial_degrees_of_freedom = initial_degrees_of_freedom,
+         .final_time = final_time,
+         .manœuvre = message.SerializeAsString()},
+        segment,
+        [this, &manœuvre, final_time, max_ephemeris_steps]() {
+          if (manœuvre.is_inertially_fixed()) {
+            return ephemeris_->FlowWithAdaptiveStep(
+                &trajectory_,
+                manœuvre.InertialIntrinsicAcceleration(),
+                final_time,
+                adaptive_step_parameters_,
+                max_ephemeris_steps,
+                &integration_statistics_);
+          } else {
+            return ephemeris_->FlowWithAdaptiveStep(
+                &trajectory_,
+                manœuvre.FrenetIntrinsicAcceleration(),
+                final_time,
+                generalized_adaptive_step_parameters_,
+                max_ephemeris_steps,
+                &integration_statistics_);
+          }
+        });
   } else {
     return absl::OkStatus();
   }
@@ -495,26 +741,30 @@ absl::Status FlightPlan::CoastSegment(
     Instant const& desired_final_time,
     DiscreteTrajectorySegmentIterator<Barycentric> const segment,
     std::int64_t const max_ephemeris_steps) {
-  // Make sure that the ephemeris covers the entire segment, reanimating and
-  // waiting if necessary.
-  Instant const starting_time = segment->back().time;
-  if (starting_time < ephemeris_->t_min()) {
-    ephemeris_->AwaitReanimation(starting_time);
-  }
-
-  return ephemeris_->FlowWithAdaptiveStep(
-                         &trajectory_,
-                         Ephemeris<Barycentric>::NoIntrinsicAcceleration,
-                         desired_final_time,
-                         adaptive_step_parameters_,
-                         max_ephemeris_steps);
+  auto const& [initial_time, initial_degrees_of_freedom] = segment->back();
+  return FlowSegmentWithCache(
+      {.initial_time = initial_time,
+       .initial_degrees_of_freedom = initial_degrees_of_freedom,
+       .final_time = desired_final_time},
+      segment,
+      [this, &desired_final_time, max_ephemeris_steps]() {
+        return ephemeris_->FlowWithAdaptiveStep(
+            &trajectory_,
+            Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+            desired_final_time,
+            adaptive_step_parameters_,
+            max_ephemeris_steps,
+            &integration_statistics_);
+      });
 }
 
 absl::Status FlightPlan::ComputeSegments(
     std::vector<NavigationManœuvre>::iterator const begin,
     std::vector<NavigationManœuvre>::iterator const end,
-    std::int64_t const max_ephemeris_steps) {
+    std::int64_t const max_ephemeris_steps,
+    std::function<void()> const& manœuvre_computed) {
   CHECK(!segments_.empty());
+  integration_statistics_ = {};
   if (anomalous_segments_ == 0) {
     anomalous_status_ = absl::OkStatus();
   }
@@ -536,12 +786,7 @@ absl::Status FlightPlan::ComputeSegments(
         anomalous_status_ = status;
       }
       if (analysis_is_enabled_) {
-        auto const& [first_time, first_degrees_of_freedom] = coast->front();
-        coast_analysers_[it - manœuvres_.begin()]->RequestAnalysis(
-            {.first_time = first_time,
-             .first_degrees_of_freedom = first_degrees_of_freedom,
-             .mission_duration = coast->back().time - first_time,
-             .extended_mission_duration = desired_final_time_ - first_time});
+        RequestCoastAnalysis(it - manœuvres_.begin());
       }
     }
 
@@ -560,6 +805,9 @@ absl::Status FlightPlan::ComputeSegments(
     }
 
     AddLastSegment();
+    if (anomalous_segments_ == 0 && manœuvre_computed != nullptr) {
+      manœuvre_computed();
+    }
   }
   if (anomalous_segments_ == 0) {
     // If the desired end time is before the end of the last burn, move it to
@@ -569,12 +817,7 @@ absl::Status FlightPlan::ComputeSegments(
     desired_final_time_ =
         std::max(desired_final_time_, segments_.back()->t_max());
     if (analysis_is_enabled_) {
-      auto const& [first_time, first_degrees_of_freedom] =
-          segments_.back()->front();
-      coast_analysers_.back()->RequestAnalysis(
-          {.first_time = first_time,
-           .first_degrees_of_freedom = first_degrees_of_freedom,
-           .mission_duration = desired_final_time_ - first_time});
+      RequestCoastAnalysis(manœuvres_.size());
     }
     absl::Status const status = CoastSegment(desired_final_time_,
                                              segments_.back(),
@@ -588,6 +831,25 @@ absl::Status FlightPlan::ComputeSegments(
   return overall_status;
 }
 
+void FlightPlan::RequestCoastAnalysis(int const coast_index) {
+  auto const& coast = segments_[2 * coast_index];
+  auto const& [first_time, first_degrees_of_freedom] = coast->front();
+  if (coast_index == manœuvres_.size()) {
+    // The last coast is analysed until the desired final time, even if it is
+    // not yet computed.
+    coast_analysers_[coast_index]->DeferAnalysis(
+        {.first_time = first_time,
+         .first_degrees_of_freedom = first_degrees_of_freedom,
+         .mission_duration = desired_final_time_ - first_time});
+  } else {
+    coast_analysers_[coast_index]->DeferAnalysis(
+        {.first_time = first_time,
+         .first_degrees_of_freedom = first_degrees_of_freedom,
+         .mission_duration = coast->back().time - first_time,
+         .extended_mission_duration = desired_final_time_ - first_time});
+  }
+}
+
 void FlightPlan::AddLastSegment() {
   segments_.emplace_back(trajectory_.NewSegment());
   if (anomalous_segments_ > 0) {
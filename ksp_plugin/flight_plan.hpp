@@ -1,14 +1,21 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <list>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
 #include "base/jthread.hpp"
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
+#include "integrators/integrators.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "ksp_plugin/orbit_analyser.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
@@ -25,6 +32,7 @@ namespace internal {
 using namespace principia::base::_jthread;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_instant;
+using namespace principia::integrators::_integrators;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_orbit_analyser;
 using namespace principia::physics::_degrees_of_freedom;
@@ -101,6 +109,18 @@ class FlightPlan {
   // Otherwise, updates the flight plan and returns the integration status.
   virtual absl::Status Replace(NavigationManœuvre::Burn const& burn, int index);
 
+  // Same as |Replace|, but the segments affected by the manœuvre are
+  // recomputed on a separate thread.  The validity of the |burn| is checked
+  // synchronously, and the manœuvres are updated immediately.  Until the end
+  // of the recomputation, the affected segments are anomalous with status
+  // |recomputing|, and they are progressively replaced as each manœuvre is
+  // integrated by the functions that "avoid deadlines".  A subsequent call to
+  // this function interrupts the recomputation in progress; a call to any
+  // other function that changes manœuvres completes it synchronously.
+  virtual absl::Status ReplaceAsynchronously(
+      NavigationManœuvre::Burn const& burn,
+      int index);
+
   // Updates the desired final time of the flight plan.  Returns an error and
   // has no effect if |desired_final_time| is before the beginning of the last
   // coast.
@@ -119,6 +139,10 @@ class FlightPlan {
   virtual Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters const&
   generalized_adaptive_step_parameters() const;
 
+  // The work performed by the integrators during the last computation of the
+  // segments, which may have been partial.
+  virtual IntegrationStatistics<Time> const& integration_statistics() const;
+
   // Returns the number of trajectories in this object.
   virtual int number_of_segments() const;
 
@@ -129,7 +153,8 @@ class FlightPlan {
 
   // Same as above, but if the flight plan is anomalous because of a deadline,
   // tries to recompute it in case the ephemeris is long enough.  This can still
-  // run into a deadline.
+  // run into a deadline.  Also picks up the segments published by an
+  // asynchronous recomputation, if any.
   virtual DiscreteTrajectorySegmentIterator<Barycentric>
   GetSegmentAvoidingDeadlines(int index);
   virtual DiscreteTrajectory<Barycentric> const&
@@ -139,10 +164,16 @@ class FlightPlan {
   // dynamically.
   void EnableAnalysis(bool enabled);
 
-  // |coast_index| must be in [0, number_of_manœuvres()].
+  // |coast_index| must be in [0, number_of_manœuvres()].  The coasts are only
+  // analysed once this function has been called for them, so that only the
+  // coasts that are looked at cost anything.
   virtual OrbitAnalyser::Analysis* analysis(int coast_index);
   double progress_of_analysis(int coast_index) const;
 
+  // Returns an estimate of the number of bytes used by the trajectory and the
+  // manœuvres of this flight plan.
+  std::int64_t MemoryFootprint() const;
+
   void WriteToMessage(not_null<serialization::FlightPlan*> message) const;
 
   // This may return a null pointer if the flight plan contained in the
@@ -159,12 +190,85 @@ class FlightPlan {
       absl::StatusCode::kOutOfRange;
   static constexpr absl::StatusCode singular =
       absl::StatusCode::kInvalidArgument;
+  static constexpr absl::StatusCode recomputing =
+      absl::StatusCode::kUnavailable;
 
  protected:
   // For mocking.
   FlightPlan();
 
  private:
+  // A small cache of the segments computed by |CoastSegment| and
+  // |BurnSegment|, so that replaying a recent edit, e.g., when dragging a
+  // burn back and forth, doesn't integrate identical segments again.  It is
+  // shared between a flight plan and its copies, and is replaced when the
+  // adaptive step parameters change.  This class is thread-safe.
+  class SegmentCache {
+   public:
+    using Points = std::vector<DiscreteTrajectory<Barycentric>::value_type>;
+
+    // Identifies a segment by its initial point, its final time and, for a
+    // burn, the serialized manœuvre.  The ephemeris never changes what it has
+    // computed, so it needs not be part of the key.
+    struct Key {
+      Instant initial_time;
+      DegreesOfFreedom<Barycentric> initial_degrees_of_freedom;
+      Instant final_time;
+      std::string manœuvre;  // Empty for a coast.
+
+      bool operator==(Key const& other) const;
+    };
+
+    // Returns the points of the segment with the given |key|, excluding the
+    // initial one, or null if it is not in the cache.
+    std::shared_ptr<Points const> Find(Key const& key);
+
+    void Insert(Key key, Points points);
+
+   private:
+    static constexpr int capacity_ = 32;
+
+    absl::Mutex lock_;
+    // The most recently used entries come first.
+    std::list<std::pair<Key, std::shared_ptr<Points const>>> entries_
+        GUARDED_BY(lock_);
+  };
+
+  // The segments computed by |recomputer_|, handed over to the main thread.
+  struct Recomputation {
+    DiscreteTrajectory<Barycentric> trajectory;
+    std::vector<DiscreteTrajectorySegmentIterator<Barycentric>> segments;
+    int anomalous_segments;
+    absl::Status anomalous_status;
+    IntegrationStatistics<Time> integration_statistics;
+    Instant desired_final_time;
+    // False if the segments of some manœuvres are still being computed.
+    bool done;
+  };
+
+  // Checks that the manœuvre at |index| may be replaced by one using the
+  // specified |burn| and, if so, replaces it and updates the initial masses of
+  // the following ones.  Does not change the segments.
+  absl::Status ReplaceManœuvre(NavigationManœuvre::Burn const& burn,
+                               int index);
+
+  // Called on |recomputer_| to publish the segments of |flight_plan|.  If
+  // |done| is false, the segments after the last coast of |flight_plan| are
+  // published as anomalous with status |recomputing|.
+  void PublishRecomputation(FlightPlan const& flight_plan, bool done);
+
+  // Replaces the segments of this object with those published by
+  // |recomputer_|, if any.  Joins |recomputer_| if it is done.
+  void PickUpRecomputation();
+
+  // Stops |recomputer_| and discards its results.  The segments that it was
+  // computing are left anomalous: the caller must recompute them.
+  void InterruptRecomputation();
+
+  // Picks up the results of |recomputer_| if it is done, otherwise stops it
+  // and recomputes synchronously the segments that it was computing.
+  void FinishRecomputation();
+
   // Clears and recomputes all trajectories in |segments_|.
   absl::Status RecomputeAllSegments();
 
@@ -173,6 +277,14 @@ class FlightPlan {
   // the ephemeris has been prolonged enough.
   absl::Status RecomputeSegmentsAvoidingDeadlineIfNeeded();
 
+  // Flows the given |segment|, which must be the last one, to the final time
+  // of |key| using |flow|, unless its points are found in |segment_cache_|.
+  // The points computed without error are inserted in the cache.
+  absl::Status FlowSegmentWithCache(
+      SegmentCache::Key key,
+      DiscreteTrajectorySegmentIterator<Barycentric> segment,
+      std::function<absl::Status()> const& flow);
+
   // Flows the given |segment| for the duration of |manœuvre| using its
   // intrinsic acceleration.
   absl::Status BurnSegment(
@@ -191,12 +303,21 @@ class FlightPlan {
   // the last coast of |segments_| and then appends one coast and one burn for
   // each manœuvre in |manœuvres|.  If one of the integration returns an error,
   // returns that error.  In this case the trajectories that follow the one in
-  // error are of length 0 and are anomalous.
+  // error are of length 0 and are anomalous.  If |manœuvre_computed| is not
+  // null, it is called after the burn of each manœuvre has been computed
+  // without error.
   // TODO(phl): The argument should really be an std::span, but then Apple has
   // invented the Macintosh.
-  absl::Status ComputeSegments(std::vector<NavigationManœuvre>::iterator begin,
-                               std::vector<NavigationManœuvre>::iterator end,
-                               std::int64_t max_ephemeris_steps);
+  absl::Status ComputeSegments(
+      std::vector<NavigationManœuvre>::iterator begin,
+      std::vector<NavigationManœuvre>::iterator end,
+      std::int64_t max_ephemeris_steps,
+      std::function<void()> const& manœuvre_computed = nullptr);
+
+  // Requests the analysis of the coast with the given index, which must be
+  // in [0, number_of_manœuvres()].  The analysis is deferred until |analysis|
+  // is called for that coast.
+  void RequestCoastAnalysis(int coast_index);
 
   // Adds a trajectory to |segments_|, forked at the end of the last one.  If
   // there are already anomalous trajectories, the newly created trajectory is
@@ -251,6 +372,8 @@ class FlightPlan {
   // The status of the first anomalous segment.  Set and used exclusively by
   // |ComputeSegments|.
   absl::Status anomalous_status_;
+  // Reset and updated by |ComputeSegments|.
+  IntegrationStatistics<Time> integration_statistics_;
 
   std::vector<NavigationManœuvre> manœuvres_;
 
@@ -266,6 +389,20 @@ class FlightPlan {
   Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters_;
   Ephemeris<Barycentric>::GeneralizedAdaptiveStepParameters
       generalized_adaptive_step_parameters_;
+
+  not_null<std::shared_ptr<SegmentCache>> segment_cache_;
+
+  // The index of the first manœuvre whose segments are being recomputed by
+  // |recomputer_|, if any.  Only accessed by the main thread.
+  std::optional<int> recomputation_index_;
+
+  absl::Mutex recomputation_lock_;
+  std::unique_ptr<Recomputation> recomputation_
+      GUARDED_BY(recomputation_lock_);
+
+  // Declared last so that it is destroyed first, as it accesses the other
+  // members.
+  jthread recomputer_;
 };
 
 }  // namespace internal
@@ -1,13 +1,20 @@
 #include "ksp_plugin/flight_plan_optimizer.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
+#include <optional>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "base/jthread.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/grassmann.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
@@ -23,6 +30,8 @@ namespace internal {
 
 using std::placeholders::_1;
 using std::placeholders::_2;
+using namespace principia::base::_jthread;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_grassmann;
 using namespace principia::integrators::_ordinary_differential_equations;
@@ -30,6 +39,7 @@ using namespace principia::numerics::_angle_reduction;
 using namespace principia::physics::_apsides;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_si;
+using namespace std::chrono_literals;
 
 // Conversion factors between |Argument| and |HomogeneousArgument|.
 constexpr Time time_homogeneization_factor = 1 * Second;
@@ -44,6 +54,18 @@ constexpr double flight_plan_extension_factor = 1.05;
 
 constexpr int max_apsides = 20;
 
+// The memory that may be used by the copies of the flight plan made to
+// evaluate the metric in parallel.
+constexpr std::int64_t max_bytes_for_parallel_evaluations = 256 << 20;
+
+// The pool used for the parallel evaluations.  The optimizations are rare and
+// short-lived, so a single pool is shared by all the optimizers.
+ThreadPool<void>& EvaluationThreadPool() {
+  static auto* const pool =
+      new ThreadPool<void>(std::thread::hardware_concurrency());
+  return *pool;
+}
+
 class FlightPlanOptimizer::LinearCombinationOfMetrics
     : public FlightPlanOptimizer::Metric {
  public:
@@ -552,11 +574,12 @@ absl::Status FlightPlanOptimizer::Optimize(int const index,
 
 DiscreteTrajectory<Barycentric>::value_type
 FlightPlanOptimizer::EvaluateClosestPeriapsis(
+    FlightPlan& flight_plan,
     Celestial const& celestial,
     Instant const& begin_time,
-    bool const extend_if_needed) const {
+    bool const extend_if_needed) {
   auto const& celestial_trajectory = celestial.trajectory();
-  auto const& vessel_trajectory = flight_plan_->GetAllSegments();
+  auto const& vessel_trajectory = flight_plan.GetAllSegments();
 
   Length distance_at_closest_periapsis;
   std::optional<DiscreteTrajectory<Barycentric>::value_type> closest_periapsis;
@@ -597,12 +620,12 @@ FlightPlanOptimizer::EvaluateClosestPeriapsis(
 
     // Try to nudge the desired final time.  This may not succeed, in which case
     // we give up.
-    auto const previous_actual_final_time = flight_plan_->actual_final_time();
+    auto const previous_actual_final_time = flight_plan.actual_final_time();
     auto const new_desired_final_time = Barycentre<Instant, double>(
-        {flight_plan_->initial_time(), flight_plan_->desired_final_time()},
+        {flight_plan.initial_time(), flight_plan.desired_final_time()},
         {1 - flight_plan_extension_factor, flight_plan_extension_factor});
-    flight_plan_->SetDesiredFinalTime(new_desired_final_time).IgnoreError();
-    if (flight_plan_->actual_final_time() <= previous_actual_final_time) {
+    flight_plan.SetDesiredFinalTime(new_desired_final_time).IgnoreError();
+    if (flight_plan.actual_final_time() <= previous_actual_final_time) {
       return vessel_trajectory.back();
     }
   }
@@ -632,7 +655,8 @@ FlightPlanOptimizer::EvaluatePeriapsisWithReplacement(
   // better than the alternative of returning an infinity, which introduces
   // discontinuities.
   auto const periapsis =
-      EvaluateClosestPeriapsis(celestial,
+      EvaluateClosestPeriapsis(*flight_plan_,
+                               celestial,
                                manœuvre.initial_time(),
                                /*extend_if_needed=*/replace_status.ok());
 
@@ -641,6 +665,102 @@ FlightPlanOptimizer::EvaluatePeriapsisWithReplacement(
   return periapsis;
 }
 
+void FlightPlanOptimizer::EvaluatePeriapsidesWithReplacementInParallel(
+    Celestial const& celestial,
+    std::vector<HomogeneousArgument> const& homogeneous_arguments,
+    NavigationManœuvre const& manœuvre,
+    int const index) {
+  std::vector<HomogeneousArgument> uncached_arguments;
+  for (auto const& homogeneous_argument : homogeneous_arguments) {
+    if (!cache_.contains(homogeneous_argument)) {
+      uncached_arguments.push_back(homogeneous_argument);
+    }
+  }
+  if (uncached_arguments.size() < 2) {
+    // Nothing to gain from parallelism.
+    return;
+  }
+
+  std::int64_t const max_copies = std::max<std::int64_t>(
+      1,
+      max_bytes_for_parallel_evaluations / flight_plan_->MemoryFootprint());
+  absl::Mutex progress_lock;
+
+  struct Evaluation {
+    std::optional<DiscreteTrajectory<Barycentric>::value_type> periapsis;
+    Instant desired_final_time;
+  };
+  std::vector<Evaluation> evaluations(uncached_arguments.size());
+
+  for (int first = 0; first < uncached_arguments.size(); first += max_copies) {
+    int const last = std::min<std::int64_t>(uncached_arguments.size(),
+                                            first + max_copies);
+    std::vector<std::unique_ptr<StoppableTask>> tasks;
+    std::vector<std::future<void>> futures;
+    for (int i = first; i < last; ++i) {
+      auto const& task = tasks.emplace_back(std::make_unique<StoppableTask>());
+      futures.push_back(EvaluationThreadPool().Add(
+          [this,
+           &celestial,
+           &manœuvre,
+           &progress_lock,
+           &task = *task,
+           &evaluation = evaluations[i],
+           &homogeneous_argument = uncached_arguments[i],
+           index]() {
+            task.Run([&]() {
+              // The copy only reads the |flight_plan_|, which is not modified
+              // while the tasks run.
+              FlightPlan flight_plan(*flight_plan_);
+              flight_plan.EnableAnalysis(/*enabled=*/false);
+              auto const replace_status = flight_plan.Replace(
+                  UpdatedBurn(homogeneous_argument, manœuvre), index);
+              if (progress_callback_ != nullptr) {
+                absl::MutexLock l(&progress_lock);
+                progress_callback_(flight_plan);
+              }
+              evaluation.periapsis = EvaluateClosestPeriapsis(
+                  flight_plan,
+                  celestial,
+                  manœuvre.initial_time(),
+                  /*extend_if_needed=*/replace_status.ok());
+              evaluation.desired_final_time = flight_plan.desired_final_time();
+            });
+          }));
+    }
+
+    // Wait for the tasks, propagating a stop request to them.
+    bool stopped = false;
+    for (auto& future : futures) {
+      while (future.wait_for(20ms) != std::future_status::ready) {
+        if (!stopped &&
+            this_stoppable_thread::get_stop_token().stop_requested()) {
+          stopped = true;
+          for (auto const& task : tasks) {
+            task->request_stop();
+          }
+        }
+      }
+    }
+    if (stopped) {
+      // The evaluations are incomplete, don't cache them.
+      return;
+    }
+  }
+
+  Instant desired_final_time = flight_plan_->desired_final_time();
+  for (int i = 0; i < uncached_arguments.size(); ++i) {
+    cache_.emplace(uncached_arguments[i], evaluations[i].periapsis.value());
+    desired_final_time =
+        std::max(desired_final_time, evaluations[i].desired_final_time);
+  }
+  // The serial evaluations extend the |flight_plan_| as needed, and the next
+  // evaluations benefit from the extension.  Preserve that behaviour.
+  if (desired_final_time > flight_plan_->desired_final_time()) {
+    flight_plan_->SetDesiredFinalTime(desired_final_time).IgnoreError();
+  }
+}
+
 Length FlightPlanOptimizer::EvaluateDistanceToCelestialWithReplacement(
     Celestial const& celestial,
     HomogeneousArgument const& homogeneous_argument,
@@ -658,6 +778,14 @@ FlightPlanOptimizer::Evaluate𝛁DistanceToCelestialWithReplacement(
     HomogeneousArgument const& homogeneous_argument,
     NavigationManœuvre const& manœuvre,
     int const index) {
+  std::vector<HomogeneousArgument> probes{homogeneous_argument};
+  for (int i = 0; i < HomogeneousArgument::dimension; ++i) {
+    probes.push_back(homogeneous_argument);
+    probes.back()[i] += δ_homogeneous_argument;
+  }
+  EvaluatePeriapsidesWithReplacementInParallel(
+      celestial, probes, manœuvre, index);
+
   auto const distance = EvaluateDistanceToCelestialWithReplacement(
       celestial, homogeneous_argument, manœuvre, index);
 
@@ -682,12 +810,18 @@ EvaluateGateauxDerivativeOfDistanceToCelestialWithReplacement(
     Difference<HomogeneousArgument> const& direction_homogeneous_argument,
     NavigationManœuvre const& manœuvre,
     int const index) {
-  auto const distance = EvaluateDistanceToCelestialWithReplacement(
-      celestial, homogeneous_argument, manœuvre, index);
   double const h = δ_homogeneous_argument /
                    direction_homogeneous_argument.Norm();
   auto const homogeneous_argument_h =
       homogeneous_argument + h * direction_homogeneous_argument;
+  EvaluatePeriapsidesWithReplacementInParallel(
+      celestial,
+      {homogeneous_argument, homogeneous_argument_h},
+      manœuvre,
+      index);
+
+  auto const distance = EvaluateDistanceToCelestialWithReplacement(
+      celestial, homogeneous_argument, manœuvre, index);
   auto const distance_δh = EvaluateDistanceToCelestialWithReplacement(
       celestial, homogeneous_argument_h, manœuvre, index);
   return (distance_δh - distance) / h;
@@ -720,6 +854,14 @@ FlightPlanOptimizer::Evaluate𝛁RelativeInclinationWithReplacement(
     HomogeneousArgument const& homogeneous_argument,
     NavigationManœuvre const& manœuvre,
     int const index) {
+  std::vector<HomogeneousArgument> probes{homogeneous_argument};
+  for (int k = 0; k < HomogeneousArgument::dimension; ++k) {
+    probes.push_back(homogeneous_argument);
+    probes.back()[k] += δ_homogeneous_argument;
+  }
+  EvaluatePeriapsidesWithReplacementInParallel(
+      celestial, probes, manœuvre, index);
+
   auto const angle =
       EvaluateRelativeInclinationWithReplacement(celestial,
                                                  frame,
@@ -753,6 +895,16 @@ Angle FlightPlanOptimizer::
         Difference<HomogeneousArgument> const& direction_homogeneous_argument,
         NavigationManœuvre const& manœuvre,
         int const index) {
+  double const h =
+      δ_homogeneous_argument / direction_homogeneous_argument.Norm();
+  auto const homogeneous_argument_h =
+      homogeneous_argument + h * direction_homogeneous_argument;
+  EvaluatePeriapsidesWithReplacementInParallel(
+      celestial,
+      {homogeneous_argument, homogeneous_argument_h},
+      manœuvre,
+      index);
+
   auto const angle =
       EvaluateRelativeInclinationWithReplacement(celestial,
                                                   frame,
@@ -760,10 +912,6 @@ Angle FlightPlanOptimizer::
                                                   homogeneous_argument,
                                                   manœuvre,
                                                   index);
-  double const h =
-      δ_homogeneous_argument / direction_homogeneous_argument.Norm();
-  auto const homogeneous_argument_h =
-      homogeneous_argument + h * direction_homogeneous_argument;
   auto const angle_δh =
       EvaluateRelativeInclinationWithReplacement(celestial,
                                                  frame,
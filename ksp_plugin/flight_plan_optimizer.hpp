@@ -12,6 +12,7 @@
 #include "ksp_plugin/celestial.hpp"
 #include "ksp_plugin/flight_plan.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "numerics/fixed_arrays.hpp"
 #include "numerics/gradient_descent.hpp"
 #include "physics/discrete_trajectory.hpp"
@@ -110,7 +111,8 @@ class FlightPlanOptimizer {
   static MetricFactory ForΔv();
 
   // Called throughout the optimization to let the client know the tentative
-  // state of the flight plan.
+  // state of the flight plan.  The calls may be made on other threads than the
+  // one that calls |Optimize|, but they are never concurrent.
   using ProgressCallback = std::function<void(FlightPlan const&)>;
 
   // Constructs an optimizer for |flight_plan|.  |flight_plan| must outlive this
@@ -149,10 +151,23 @@ class FlightPlanOptimizer {
   // |celestial|, occurring after |begin_time|.  If |extend_if_needed| is true,
   // the flight plan is extended until its end is not the point that minimizes
   // the metric.
-  DiscreteTrajectory<Barycentric>::value_type EvaluateClosestPeriapsis(
+  static DiscreteTrajectory<Barycentric>::value_type EvaluateClosestPeriapsis(
+      FlightPlan& flight_plan,
       Celestial const& celestial,
       Instant const& begin_time,
-      bool extend_if_needed) const;
+      bool extend_if_needed);
+
+  // Computes the closest periapsis, as |EvaluatePeriapsisWithReplacement|, for
+  // each of the |homogeneous_arguments| that is not in the |cache_|, and
+  // inserts the results in the |cache_|.  The evaluations are done
+  // concurrently on copies of the |flight_plan_|, the number of copies being
+  // limited by their memory footprint.  Used to evaluate the probes of the
+  // finite differences in parallel.
+  void EvaluatePeriapsidesWithReplacementInParallel(
+      Celestial const& celestial,
+      std::vector<HomogeneousArgument> const& homogeneous_arguments,
+      NavigationManœuvre const& manœuvre,
+      int index);
 
   // Replaces the manœuvre at the given |index| based on the |argument|, and
   // computes the closest periapis.  Leaves the |flight_plan| unchanged.
@@ -2,14 +2,20 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include "quantities/named_quantities.hpp"
+
 namespace principia {
 namespace ksp_plugin {
 namespace _geometric_potential_plotter {
 namespace internal {
 
+using namespace principia::quantities::_named_quantities;
+
 GeometricPotentialPlotter::GeometricPotentialPlotter(
     not_null<Ephemeris<Barycentric>*> const ephemeris)
     : ephemeris_(ephemeris) {}
@@ -47,7 +53,14 @@ GeometricPotentialPlotter::last_parameters() const {
 
 void GeometricPotentialPlotter::RefreshEquipotentials() {
   absl::MutexLock l(&lock_);
-  if (next_equipotentials_.has_value()) {
+  if (next_equipotentials_.has_value() &&
+      (next_equipotentials_->complete ||
+       !equipotentials_.has_value() ||
+       !equipotentials_->complete ||
+       equipotentials_->parameters.primaries !=
+           next_equipotentials_->parameters.primaries ||
+       equipotentials_->parameters.secondaries !=
+           next_equipotentials_->parameters.secondaries)) {
     equipotentials_ = std::move(next_equipotentials_);
     next_equipotentials_.reset();
   }
@@ -60,22 +73,54 @@ GeometricPotentialPlotter::equipotentials() const {
 
 absl::Status GeometricPotentialPlotter::PlotEquipotentials(
     Parameters const& parameters) {
-  auto result = LagrangeEquipotentials<Barycentric, Navigation>(ephemeris_)
-                    .ComputeLines(parameters);
+  // The lines computed so far, by energy, only accessed by the callback.
+  std::map<SpecificEnergy, std::vector<not_null<std::shared_ptr<Line const>>>>
+      lines_by_energy;
+  auto const make_equipotentials = [&lines_by_energy, &parameters](bool complete) {
+    Equipotentials equipotentials{.parameters = parameters,
+                                  .complete = complete};
+    for (auto const& [energy, lines] : lines_by_energy) {
+      equipotentials.lines.insert(
+          equipotentials.lines.end(), lines.begin(), lines.end());
+    }
+    return equipotentials;
+  };
+
+  auto const status =
+      LagrangeEquipotentials<Barycentric, Navigation>(ephemeris_)
+          .ComputeLines(
+              parameters,
+              [this, &lines_by_energy, &make_equipotentials](
+                  SpecificEnergy const& energy,
+                  Equipotential<Barycentric, Navigation>::Lines lines) {
+                auto& shared_lines = lines_by_energy[energy];
+                for (auto& line : lines) {
+                  shared_lines.push_back(
+                      make_not_null_shared<Line const>(std::move(line)));
+                }
+                absl::MutexLock l(&lock_);
+                // Don't overwrite complete equipotentials that have not been
+                // picked up yet.
+                if (!next_equipotentials_.has_value() ||
+                    !next_equipotentials_->complete) {
+                  next_equipotentials_ =
+                      make_equipotentials(/*complete=*/false);
+                }
+              })
+          .status();
 
   absl::MutexLock l(&lock_);
-  // We don’t reset |next_equipotentials_| unless |result.ok()|, so that if we
+  // We don’t reset |next_equipotentials_| unless |status.ok()|, so that if we
   // have a transient error, we keep the old ones until the problem goes away.
-  if (result.ok()) {
-    next_equipotentials_ = {{}, parameters};
-    for (auto& [energy, lines] : result->lines) {
-      next_equipotentials_->lines.insert(next_equipotentials_->lines.end(),
-                                         std::make_move_iterator(lines.begin()),
-                                         std::make_move_iterator(lines.end()));
-    }
+  // Partial results are dropped, though.
+  if (status.ok()) {
+    next_equipotentials_ = make_equipotentials(/*complete=*/true);
+  } else if (next_equipotentials_.has_value() &&
+             !next_equipotentials_->complete) {
+    next_equipotentials_.reset();
   }
   plotter_idle_ = true;
-  return result.status();
+  return status;
 }
 
 }  // namespace internal
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <map>
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include "base/jthread.hpp"
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "physics/ephemeris.hpp"
 #include "physics/equipotential.hpp"
 #include "physics/lagrange_equipotentials.hpp"
@@ -30,9 +34,15 @@ class GeometricPotentialPlotter {
   using Parameters =
       LagrangeEquipotentials<Barycentric, Navigation>::Parameters;
 
+  using Line = Equipotential<Barycentric, Navigation>::Line;
+
   struct Equipotentials {
-    Equipotential<Barycentric, Navigation>::Lines lines;
+    // The lines are shared so that partial results may be published while the
+    // computation proceeds.
+    std::vector<not_null<std::shared_ptr<Line const>>> lines;
     Parameters parameters;
+    // False if the lines for some energy levels have not been computed yet.
+    bool complete = true;
   };
 
   explicit GeometricPotentialPlotter(
@@ -49,7 +59,10 @@ class GeometricPotentialPlotter {
   // The last value passed to |RequestEquipotentials|.
   std::optional<Parameters> const& last_parameters() const;
 
-  // Sets |equipotentials()| to the latest computed equipotentials.
+  // Sets |equipotentials()| to the latest computed equipotentials.  Partial
+  // results are only used if the current equipotentials are partial too or are
+  // for other bodies, so that the lines don't flicker when they are
+  // recomputed.
   void RefreshEquipotentials();
 
   Equipotentials const* equipotentials() const;
@@ -72,8 +85,8 @@ class GeometricPotentialPlotter {
   // If it is joined once idle (and joinable), it will not attempt to acquire
   // |lock_|.
   bool plotter_idle_ GUARDED_BY(lock_) = true;
-  // |next_analysis_| is set by the |analyser_| thread; it is read and cleared
-  // by the main thread.
+  // |next_equipotentials_| is set by the |plotter_| thread, possibly with
+  // partial results; it is read and cleared by the main thread.
   std::optional<Equipotentials> next_equipotentials_ GUARDED_BY(lock_);
 };
 
@@ -0,0 +1,12 @@
+#include "ksp_plugin/instantiations.hpp"
+
+namespace principia {
+
+template class physics::_discrete_trajectory::internal::
+    DiscreteTrajectory<ksp_plugin::_frames::Barycentric>;
+template class physics::_discrete_trajectory_segment::internal::
+    DiscreteTrajectorySegment<ksp_plugin::_frames::Barycentric>;
+template class physics::_ephemeris::internal::
+    Ephemeris<ksp_plugin::_frames::Barycentric>;
+
+}  // namespace principia
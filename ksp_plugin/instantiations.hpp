@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ksp_plugin/frames.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/discrete_trajectory_segment.hpp"
+#include "physics/ephemeris.hpp"
+
+// The plugin uses the following class templates with |Barycentric| in nearly
+// all its translation units.  To avoid compiling them (and emitting their code
+// and vtables) in each of these translation units, they are explicitly
+// instantiated once, in instantiations.cpp.
+// When building the journal, which only imports the functions of the interface
+// from the plugin DLL, these specializations are implicitly instantiated as
+// usual.
+
+#if !PRINCIPIA_DLL_IMPORT
+namespace principia {
+
+extern template class physics::_discrete_trajectory::internal::
+    DiscreteTrajectory<ksp_plugin::_frames::Barycentric>;
+extern template class physics::_discrete_trajectory_segment::internal::
+    DiscreteTrajectorySegment<ksp_plugin::_frames::Barycentric>;
+extern template class physics::_ephemeris::internal::
+    Ephemeris<ksp_plugin::_frames::Barycentric>;
+
+}  // namespace principia
+#endif
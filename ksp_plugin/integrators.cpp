@@ -24,6 +24,7 @@ DefaultDownsamplingParameters() {
   return DiscreteTrajectorySegment<Barycentric>::DownsamplingParameters{
       .max_dense_intervals = 10'000,
       .tolerance = 10 * Metre,
+      .max_fits_per_append = 100,
   };
 }
 
@@ -33,6 +34,7 @@ OrbitAnalyserDownsamplingParameters() {
   return DiscreteTrajectorySegment<Barycentric>::DownsamplingParameters{
       .max_dense_intervals = 10'000,
       .tolerance = 1 * Milli(Metre),
+      .max_fits_per_append = 1'000,
   };
 }
 
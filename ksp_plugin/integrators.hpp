@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "physics/discrete_trajectory_segment.hpp"
 #include "physics/ephemeris.hpp"
 #include "quantities/quantities.hpp"
@@ -2,6 +2,7 @@
 
 #include <cctype>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <iomanip>
@@ -18,11 +19,14 @@
 #include <psapi.h>
 #endif
 
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
 #include "astronomy/epoch.hpp"
 #include "astronomy/time_scales.hpp"
 #include "base/array.hpp"
 #include "base/base64.hpp"
+#include "base/compressors.hpp"
 #include "base/encoder.hpp"
 #include "base/fingerprint2011.hpp"
 #include "base/flags.hpp"
@@ -30,7 +34,7 @@
 #include "base/macros.hpp"  // 🧙 For NAMED.
 #include "base/not_null.hpp"
 #include "base/optional_logging.hpp"  // 🧙 For logging.
-#include "base/pull_serializer.hpp"
+#include "base/pipelined_serializer.hpp"
 #include "base/push_deserializer.hpp"
 #include "base/serialization.hpp"
 #include "base/version.hpp"
@@ -49,6 +53,7 @@
 #include "journal/recorder.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/identification.hpp"
+#include "ksp_plugin/integrators.hpp"
 #include "ksp_plugin/iterators.hpp"
 #include "ksp_plugin/part.hpp"
 #include "physics/degrees_of_freedom.hpp"
@@ -83,12 +88,13 @@ using namespace principia::astronomy::_epoch;
 using namespace principia::astronomy::_time_scales;
 using namespace principia::base::_array;
 using namespace principia::base::_base64;
+using namespace principia::base::_compressors;
 using namespace principia::base::_encoder;
 using namespace principia::base::_fingerprint2011;
 using namespace principia::base::_flags;
 using namespace principia::base::_hexadecimal;
 using namespace principia::base::_not_null;
-using namespace principia::base::_pull_serializer;
+using namespace principia::base::_pipelined_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::base::_serialization;
 using namespace principia::base::_version;
@@ -104,6 +110,7 @@ using namespace principia::journal::_method;
 using namespace principia::journal::_recorder;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_identification;
+using namespace principia::ksp_plugin::_integrators;
 using namespace principia::ksp_plugin::_iterators;
 using namespace principia::ksp_plugin::_part;
 using namespace principia::physics::_degrees_of_freedom;
@@ -128,17 +135,28 @@ using namespace principia::quantities::_si;
 namespace {
 
 constexpr char gipfeli_compressor[] = "gipfeli";
+constexpr char lz4_compressor[] = "lz4";
+// May be followed by a colon and a compression level, e.g., "zstd:19".
+constexpr char zstd_compressor[] = "zstd";
 
 constexpr char base64_encoder[] = "base64";
 constexpr char hexadecimal_encoder[] = "hexadecimal";
 
 constexpr int chunk_size = 64 << 10;
 constexpr int number_of_chunks = 8;
-
+// The number of chunks compressed or uncompressed concurrently.  A
+// |PullSerializer| with |number_of_chunks| chunks cannot compress more than
+// |(number_of_chunks - 2) / 2| chunks at the same time.
+constexpr int number_of_compressors = (number_of_chunks - 2) / 2;
+
+// The arena on which the |serialization::Plugin| messages are allocated during
+// serialization and deserialization.  A save is typically hundreds of
+// megabytes, so the blocks are allowed to grow large to keep their number, and
+// the resulting heap fragmentation, small.
 not_null<Arena*> arena = []() {
   ArenaOptions options;
   options.initial_block_size = chunk_size;
-  options.max_block_size = 16 * chunk_size;
+  options.max_block_size = 256 * chunk_size;
   return new Arena(options);
 }();
 
@@ -166,8 +184,13 @@ DiscreteTrajectorySegment<Barycentric>::DownsamplingParameters
 MakeDownsamplingParameters(
     ConfigurationDownsamplingParameters const& parameters) {
   return DiscreteTrajectorySegment<Barycentric>::DownsamplingParameters{
-      std::stoi(parameters.max_dense_intervals),
-      ParseQuantity<Length>(parameters.tolerance)};
+      .max_dense_intervals = std::stoi(parameters.max_dense_intervals),
+      .tolerance = ParseQuantity<Length>(parameters.tolerance),
+      .max_fits_per_append =
+          parameters.max_fits_per_append == nullptr
+              ? DefaultDownsamplingParameters().max_fits_per_append
+              : std::optional<std::int64_t>(
+                    std::stoll(parameters.max_fits_per_append))};
 }
 
 Ephemeris<Barycentric>::FixedStepParameters MakeFixedStepParameters(
@@ -290,11 +313,36 @@ std::unique_ptr<google::compression::Compressor> NewCompressor(
     return nullptr;
   } else if (compressor == gipfeli_compressor) {
     return google::compression::NewGipfeliCompressor();
+  } else if (compressor == lz4_compressor) {
+    return std::make_unique<Lz4Compressor>();
+  } else if (std::string_view level = compressor;
+             absl::ConsumePrefix(&level, zstd_compressor)) {
+    if (level.empty()) {
+      return std::make_unique<ZstdCompressor>();
+    }
+    int zstd_level;
+    CHECK(absl::ConsumePrefix(&level, ":") &&
+          absl::SimpleAtoi(level, &zstd_level))
+        << "Invalid compressor " << compressor;
+    return std::make_unique<ZstdCompressor>(zstd_level);
   } else {
     LOG(FATAL) << "Unknown compressor " << compressor;
   }
 }
 
+// Returns |number_of_compressors| instances of |compressor|, or none if
+// |compressor| is empty.
+std::vector<std::unique_ptr<google::compression::Compressor>> NewCompressors(
+    std::string_view const compressor) {
+  std::vector<std::unique_ptr<google::compression::Compressor>> compressors;
+  if (!compressor.empty()) {
+    for (int i = 0; i < number_of_compressors; ++i) {
+      compressors.push_back(NewCompressor(compressor));
+    }
+  }
+  return compressors;
+}
+
 Encoder<char, /*null_terminated=*/true>*
 NewEncoder(std::string_view const encoder) {
   if (encoder == hexadecimal_encoder) {
@@ -320,7 +368,8 @@ void __cdecl principia__ActivatePlayer() {
 // activate it.  If |activate| is false and there is an active journal,
 // deactivate it.  Does nothing if there is already a journal in the desired
 // state.  |verbose| causes methods to be output in the INFO log before being
-// executed.
+// executed.  If the flag |journal_format| is |binary| or |compressed_binary|,
+// the journal is written in that format by a background thread.
 void __cdecl principia__ActivateRecorder(bool const activate) {
   // NOTE: Do not journal!  You'd end up with half a message in the journal and
   // that would cause trouble.
@@ -331,8 +380,14 @@ void __cdecl principia__ActivateRecorder(bool const activate) {
     std::tm* const localtime = std::localtime(&time);
     std::stringstream name;
     name << std::put_time(localtime, "JOURNAL.%Y%m%d-%H%M%S");
+    Recorder::Format format = Recorder::Format::Hexadecimal;
+    if (Flags::IsPresent("journal_format", "binary")) {
+      format = Recorder::Format::Binary;
+    } else if (Flags::IsPresent("journal_format", "compressed_binary")) {
+      format = Recorder::Format::CompressedBinary;
+    }
     Recorder* const recorder = new Recorder(
-        std::filesystem::path("glog") / "Principia" / name.str());
+        std::filesystem::path("glog") / "Principia" / name.str(), format);
     Vessel::MakeSynchronous();
     Recorder::Activate(recorder);
   } else if (!activate && Recorder::IsActivated()) {
@@ -555,7 +610,7 @@ void __cdecl principia__DeserializePlugin(
     LOG(INFO) << "Begin plugin deserialization";
     *deserializer = new PushDeserializer(chunk_size,
                                          number_of_chunks,
-                                         NewCompressor(compressor));
+                                         NewCompressors(compressor));
     CHECK_NOTNULL(arena);
     not_null<serialization::Plugin*> const message =
         Arena::CreateMessage<serialization::Plugin>(arena);
@@ -1093,42 +1148,37 @@ static PushDeserializer* verification_deserializer = nullptr;
 static Plugin const* verification_plugin = nullptr;
 #endif
 
-// |plugin| must not be null.  The caller takes ownership of the result, except
-// when it is null (at the end of the stream).  No transfer of ownership of
-// |*plugin|.  |*serializer| must be null on the first call and must be passed
-// unchanged to the successive calls; its ownership is not transferred.
-char const* __cdecl principia__SerializePlugin(
+namespace {
+
+// Returns the next chunk of the serialization of |plugin|, null-terminated, or
+// an empty array at the end of the stream.  See |principia__SerializePlugin|
+// for the handling of |serializer|.
+UniqueArray<char> PullSerializedPluginChunk(
     Plugin const* const plugin,
-    PullSerializer** const serializer,
+    PipelinedSerializer** const serializer,
     char const* const compressor,
     char const* const encoder) {
-  journal::Method<journal::SerializePlugin> m({plugin,
-                                               serializer,
-                                               compressor,
-                                               encoder},
-                                              {serializer});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(serializer);
 
   // Create and start a serializer if the caller didn't provide one.
   if (*serializer == nullptr) {
     LOG(INFO) << "Begin plugin serialization";
-    *serializer = new PullSerializer(chunk_size,
-                                     number_of_chunks,
-                                     NewCompressor(compressor));
+    *serializer = new PipelinedSerializer(chunk_size,
+                                          number_of_chunks,
+                                          NewCompressors(compressor),
+                                          NewEncoder(encoder));
     not_null<serialization::Plugin*> const message =
         Arena::CreateMessage<serialization::Plugin>(arena);
     plugin->WriteToMessage(message);
     (*serializer)->Start(message);
   }
 
-  // Pull a chunk.
-  Array<std::uint8_t> bytes;
-  bytes = (*serializer)->Pull();
+  // Pull a chunk, already compressed and encoded by the serializer.
+  UniqueArray<char> chunk = (*serializer)->Pull();
 
-  // If this is the end of the serialization, delete the serializer and return a
-  // nullptr.
-  if (bytes.size == 0) {
+  // If this is the end of the serialization, delete the serializer.
+  if (chunk.size == 0) {
 #if PRINCIPIA_VERIFY_SERIALIZATION
     principia__DeserializePlugin("",
                                  &verification_deserializer,
@@ -1144,19 +1194,92 @@ char const* __cdecl principia__SerializePlugin(
     LOG(INFO) << "End plugin serialization";
     TakeOwnership(serializer);
     arena->Reset();
-    return m.Return(nullptr);
+    return chunk;
   }
 
-  // Encode and return to the client.
-  auto hexadecimal = NewEncoder(encoder)->Encode(bytes);
 #if PRINCIPIA_VERIFY_SERIALIZATION
-  principia__DeserializePlugin(hexadecimal.data.get(),
+  principia__DeserializePlugin(chunk.data.get(),
                                &verification_deserializer,
                                &verification_plugin,
                                compressor,
                                encoder);
 #endif
-  return m.Return(hexadecimal.data.release());
+  return chunk;
+}
+
+}  // namespace
+
+// |plugin| must not be null.  The caller takes ownership of the result, except
+// when it is null (at the end of the stream).  No transfer of ownership of
+// |*plugin|.  |*serializer| must be null on the first call and must be passed
+// unchanged to the successive calls; its ownership is not transferred.
+char const* __cdecl principia__SerializePlugin(
+    Plugin const* const plugin,
+    PipelinedSerializer** const serializer,
+    char const* const compressor,
+    char const* const encoder) {
+  journal::Method<journal::SerializePlugin> m({plugin,
+                                               serializer,
+                                               compressor,
+                                               encoder},
+                                              {serializer});
+  UniqueArray<char> chunk =
+      PullSerializedPluginChunk(plugin, serializer, compressor, encoder);
+  if (chunk.size == 0) {
+    return m.Return(nullptr);
+  }
+  return m.Return(chunk.data.release());
+}
+
+// Same as |principia__SerializePlugin|, but the chunk is copied, without its
+// null terminator, into the |buffer| owned by the caller, and its length is
+// returned; 0 is returned at the end of the stream.  This avoids transferring
+// the ownership of each chunk to the caller, and the call to
+// |principia__DeleteString| that frees it.  |buffer_size| must be at least the
+// result of |principia__SerializePluginMaxChunkSize|.
+int __cdecl principia__SerializePluginIntoBuffer(
+    Plugin const* const plugin,
+    PipelinedSerializer** const serializer,
+    char const* const compressor,
+    char const* const encoder,
+    char* const buffer,
+    int const buffer_size) {
+  journal::Method<journal::SerializePluginIntoBuffer> m({plugin,
+                                                         serializer,
+                                                         compressor,
+                                                         encoder,
+                                                         buffer,
+                                                         buffer_size},
+                                                        {serializer});
+  UniqueArray<char> const chunk =
+      PullSerializedPluginChunk(plugin, serializer, compressor, encoder);
+  if (chunk.size == 0) {
+    return m.Return(0);
+  }
+  std::int64_t const length = chunk.size - 1;
+  CHECK_EQ(chunk.data[length], '\0');
+  CHECK_LE(length, buffer_size);
+  std::memcpy(buffer, chunk.data.get(), length);
+  return m.Return(static_cast<int>(length));
+}
+
+// Returns an upper bound on the length of the chunks returned by
+// |principia__SerializePluginIntoBuffer| for the given |compressor| and
+// |encoder|.
+int __cdecl principia__SerializePluginMaxChunkSize(
+    char const* const compressor,
+    char const* const encoder) {
+  journal::Method<journal::SerializePluginMaxChunkSize> m({compressor,
+                                                           encoder});
+  std::int64_t const compressed_chunk_size =
+      compressor[0] == '\0'
+          ? chunk_size
+          : NewCompressor(compressor)->MaxCompressedLength(chunk_size);
+  // The encoded length includes the null terminator.
+  std::int64_t const encoded_chunk_size =
+      NewEncoder(encoder)->EncodedLength(
+          Array<std::uint8_t const>(nullptr, compressed_chunk_size)) - 1;
+  return m.Return(static_cast<int>(encoded_chunk_size));
 }
 
 // Sets the maximum number of seconds which logs may be buffered for.
@@ -1188,6 +1311,29 @@ void __cdecl principia__SetMainBody(Plugin* const plugin, int const index) {
   return m.Return();
 }
 
+void __cdecl principia__SetMaxHistoryStep(
+    Plugin* const plugin,
+    char const* const max_history_step) {
+  journal::Method<journal::SetMaxHistoryStep> m({plugin, max_history_step});
+  CHECK_NOTNULL(plugin);
+  plugin->SetMaxHistoryStep(ParseQuantity<Time>(max_history_step));
+  return m.Return();
+}
+
+// A non-positive |tolerance| restores the default, where the predictions are
+// entirely integrated.
+void __cdecl principia__SetPredictionKeplerTolerance(
+    Plugin* const plugin,
+    char const* const tolerance) {
+  journal::Method<journal::SetPredictionKeplerTolerance> m({plugin, tolerance});
+  CHECK_NOTNULL(plugin);
+  Angle const parsed_tolerance = ParseQuantity<Angle>(tolerance);
+  plugin->SetPredictionKeplerTolerance(
+      parsed_tolerance > Angle() ? std::make_optional(parsed_tolerance)
+                                 : std::nullopt);
+  return m.Return();
+}
+
 // Make it so that all log messages of at least |min_severity| are logged to
 // stderr (in addition to logging to the usual log file(s)).
 void __cdecl principia__SetStderrLogging(int const min_severity) {
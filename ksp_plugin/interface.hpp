@@ -8,7 +8,7 @@
 
 #include "absl/status/status.h"
 #include "base/not_null.hpp"
-#include "base/pull_serializer.hpp"
+#include "base/pipelined_serializer.hpp"
 #include "base/push_deserializer.hpp"
 #include "base/push_pull_callback.hpp"
 #include "geometry/grassmann.hpp"
@@ -19,6 +19,7 @@
 #include "geometry/space.hpp"
 #include "ksp_plugin/flight_plan.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "ksp_plugin/iterators.hpp"
 #include "ksp_plugin/orbit_analyser.hpp"
 #include "ksp_plugin/pile_up.hpp"
@@ -42,7 +43,7 @@ namespace interface {
 // with convenience |using|s.
 
 using namespace principia::base::_not_null;
-using namespace principia::base::_pull_serializer;
+using namespace principia::base::_pipelined_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::base::_push_pull_callback;
 using namespace principia::geometry::_grassmann;
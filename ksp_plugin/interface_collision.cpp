@@ -7,6 +7,7 @@
 #include "journal/method.hpp"
 #include "journal/profiles.hpp"  // 🧙 For generated profiles.
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/identification.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
@@ -17,6 +18,7 @@ namespace interface {
 using namespace principia::base::_push_pull_callback;
 using namespace principia::journal::_method;
 using namespace principia::ksp_plugin::_frames;
+using namespace principia::ksp_plugin::_identification;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
@@ -31,7 +33,10 @@ NewExecutor(Plugin const* const plugin,
             int const celestial_index,
             XYZ const sun_world_position,
             int const max_points,
-            TrajectoryLike const& vessel_trajectory) {
+            int const terrain_level_of_detail,
+            GUID const& vessel_guid,
+            VesselTrajectory const vessel_trajectory,
+            TrajectoryLike const& trajectory) {
   CHECK_NOTNULL(plugin);
 
   auto task = [celestial_index,
@@ -39,15 +44,21 @@ NewExecutor(Plugin const* const plugin,
                plugin,
                sun_world_position =
                    FromXYZ<Position<World>>(sun_world_position),
-               &vessel_trajectory](
+               terrain_level_of_detail,
+               vessel_guid,
+               vessel_trajectory,
+               &trajectory](
                   std::function<Length(Angle const& latitude,
                                        Angle const& longitude)> const& radius) {
     return plugin->ComputeAndRenderFirstCollision(celestial_index,
+                                                  vessel_guid,
                                                   vessel_trajectory,
-                                                  vessel_trajectory.begin(),
-                                                  vessel_trajectory.end(),
+                                                  trajectory,
+                                                  trajectory.begin(),
+                                                  trajectory.end(),
                                                   sun_world_position,
                                                   max_points,
+                                                  terrain_level_of_detail,
                                                   radius);
   };
 
@@ -107,12 +118,14 @@ PushPullExecutor<
     int const celestial_index,
     XYZ const sun_world_position,
     int const max_points,
+    int const terrain_level_of_detail,
     char const* const vessel_guid) {
   journal::Method<journal::CollisionNewFlightPlanExecutor> m{
       {plugin,
        celestial_index,
        sun_world_position,
        max_points,
+       terrain_level_of_detail,
        vessel_guid}};
   CHECK_NOTNULL(plugin);
   auto& flight_plan = GetFlightPlan(*plugin, vessel_guid);
@@ -120,6 +133,9 @@ PushPullExecutor<
                               celestial_index,
                               sun_world_position,
                               max_points,
+                              terrain_level_of_detail,
+                              vessel_guid,
+                              VesselTrajectory::FlightPlan,
                               flight_plan.GetAllSegments())
                       .release());
 }
@@ -131,12 +147,14 @@ PushPullExecutor<
     int const celestial_index,
     XYZ const sun_world_position,
     int const max_points,
+    int const terrain_level_of_detail,
     char const* const vessel_guid) {
   journal::Method<journal::CollisionNewPredictionExecutor> m{
       {plugin,
        celestial_index,
        sun_world_position,
        max_points,
+       terrain_level_of_detail,
        vessel_guid}};
   CHECK_NOTNULL(plugin);
   not_null<Vessel*> const vessel = plugin->GetVessel(vessel_guid);
@@ -144,6 +162,9 @@ PushPullExecutor<
                               celestial_index,
                               sun_world_position,
                               max_points,
+                              terrain_level_of_detail,
+                              vessel_guid,
+                              VesselTrajectory::Prediction,
                               *vessel->prediction())
                       .release());
 }
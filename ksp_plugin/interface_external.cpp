@@ -154,8 +154,46 @@ Status* __cdecl principia__ExternalFlowFreefall(
     return m.Return(
         ToNewStatus(absl::InvalidArgumentError("|plugin| must not be null")));
   }
-  return m.Return(ToNewStatus(absl::UnimplementedError(
-      "|ExternalFlowFreefall| is not yet implemented")));
+  if (!plugin->HasCelestial(central_body_index)) {
+    return m.Return(ToNewStatus(
+        absl::NotFoundError(
+            absl::StrCat("No celestial with index ", central_body_index))));
+  }
+  Instant const initial_time = FromGameTime(*plugin, t_initial);
+  Instant const final_time = FromGameTime(*plugin, t_final);
+  if (final_time < initial_time) {
+    return m.Return(ToNewStatus(absl::InvalidArgumentError(
+        (std::stringstream{} << "|t_final| " << final_time
+                             << " is before |t_initial| " << initial_time)
+            .str())));
+  }
+  auto const body_centred_inertial =
+      plugin->NewBodyCentredNonRotatingNavigationFrame(central_body_index);
+  // As in |principia__ExternalGetNearestPlannedCoastDegreesOfFreedom|, the
+  // orthogonal map to world coordinates does not depend on time because
+  // |body_centred_inertial| does not rotate with respect to |Barycentric|.
+  RigidMotion<Navigation, World> to_world_body_centred_inertial(
+      RigidTransformation<Navigation, World>(
+          Navigation::origin,
+          World::origin,
+          plugin->renderer().BarycentricToWorld(plugin->PlanetariumRotation()) *
+              body_centred_inertial->FromThisFrameAtTime(
+                  plugin->CurrentTime()).orthogonal_map()),
+      Navigation::nonrotating,
+      Navigation::unmoving);
+  auto const final_degrees_of_freedom = plugin->FlowFreefall(
+      *body_centred_inertial,
+      to_world_body_centred_inertial.Inverse()(
+          FromQP<DegreesOfFreedom<World>>(
+              world_body_centred_initial_degrees_of_freedom)),
+      initial_time,
+      final_time);
+  if (!final_degrees_of_freedom.ok()) {
+    return m.Return(ToNewStatus(final_degrees_of_freedom.status()));
+  }
+  *world_body_centred_final_degrees_of_freedom =
+      ToQP(to_world_body_centred_inertial(*final_degrees_of_freedom));
+  return m.Return(OK());
 }
 
 Status* __cdecl principia__ExternalGeopotentialGetCoefficient(
@@ -523,6 +523,8 @@ void __cdecl principia__FlightPlanRenderedApsides(
   DiscreteTrajectory<World> rendered_apoapsides;
   DiscreteTrajectory<World> rendered_periapsides;
   plugin->ComputeAndRenderApsides(celestial_index,
+                                  vessel_guid,
+                                  VesselTrajectory::FlightPlan,
                                   flight_plan,
                                   flight_plan.begin(), flight_plan.end(),
                                   FromXYZ<Position<World>>(sun_world_position),
@@ -552,6 +554,8 @@ void __cdecl principia__FlightPlanRenderedClosestApproaches(
       GetFlightPlan(*plugin, vessel_guid).GetAllSegments();
   DiscreteTrajectory<World> rendered_closest_approaches;
   plugin->ComputeAndRenderClosestApproaches(
+      vessel_guid,
+      VesselTrajectory::FlightPlan,
       flight_plan,
       flight_plan.begin(), flight_plan.end(),
       FromXYZ<Position<World>>(sun_world_position),
@@ -637,8 +641,9 @@ Status* __cdecl principia__FlightPlanReplace(Plugin const* const plugin,
                                                  burn,
                                                  index});
   CHECK_NOTNULL(plugin);
-  auto const status = GetFlightPlan(*plugin, vessel_guid)
-                          .Replace(FromInterfaceBurn(*plugin, burn), index);
+  auto const status =
+      GetFlightPlan(*plugin, vessel_guid)
+          .ReplaceAsynchronously(FromInterfaceBurn(*plugin, burn), index);
   plugin->ExtendPredictionForFlightPlan(vessel_guid);
   return m.Return(ToNewStatus(status));
 }
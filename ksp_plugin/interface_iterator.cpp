@@ -62,6 +62,29 @@ double __cdecl principia__IteratorGetDiscreteTrajectoryTime(
       }));
 }
 
+// Fills the array of size |tqps_size| at |tqps| with the times and degrees of
+// freedom of the points starting at the current position of the |iterator|,
+// and advances the |iterator| past them.  Returns the number of points
+// written, which is less than |tqps_size| only if the end was reached.
+int __cdecl principia__IteratorGetDiscreteTrajectoryTQPs(
+    Iterator* const iterator,
+    TQP* const tqps,
+    int const tqps_size) {
+  journal::Method<journal::IteratorGetDiscreteTrajectoryTQPs> m(
+      {iterator, tqps, tqps_size});
+  CHECK_NOTNULL(iterator);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<DiscreteTrajectory<World>>*>(iterator));
+  auto const plugin = typed_iterator->plugin();
+  return m.Return(typed_iterator->GetAndIncrement<TQP>(
+      [plugin](DiscreteTrajectory<World>::iterator const& iterator) -> TQP {
+        return {.t = ToGameTime(*plugin, iterator->time),
+                .qp = ToQP(iterator->degrees_of_freedom)};
+      },
+      tqps,
+      tqps_size));
+}
+
 XYZ __cdecl principia__IteratorGetDiscreteTrajectoryXYZ(
     Iterator const* const iterator) {
   journal::Method<journal::IteratorGetDiscreteTrajectoryXYZ> m({iterator});
@@ -74,6 +97,24 @@ XYZ __cdecl principia__IteratorGetDiscreteTrajectoryXYZ(
       }));
 }
 
+// Same as above, but only for the positions.
+int __cdecl principia__IteratorGetDiscreteTrajectoryXYZs(
+    Iterator* const iterator,
+    XYZ* const xyzs,
+    int const xyzs_size) {
+  journal::Method<journal::IteratorGetDiscreteTrajectoryXYZs> m(
+      {iterator, xyzs, xyzs_size});
+  CHECK_NOTNULL(iterator);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<DiscreteTrajectory<World>>*>(iterator));
+  return m.Return(typed_iterator->GetAndIncrement<XYZ>(
+      [](DiscreteTrajectory<World>::iterator const& iterator) -> XYZ {
+        return ToXYZ(iterator->degrees_of_freedom.position());
+      },
+      xyzs,
+      xyzs_size));
+}
+
 Iterator* __cdecl principia__IteratorGetRP2LinesIterator(
     Iterator const* const iterator) {
   journal::Method<journal::IteratorGetRP2LinesIterator> m({iterator});
@@ -6,12 +6,14 @@
 #include <string>
 #include <type_traits>
 
+#include "base/tracing.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
 
 namespace principia {
 namespace interface {
 
+using namespace principia::base::_tracing;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
@@ -79,5 +81,18 @@ void __cdecl principia__MonitorStop(int const i) {
   }
 }
 
+void __cdecl principia__TracingEnable(bool const enabled) {
+  EnableTracing(enabled);
+}
+
+void __cdecl principia__TracingLogHistograms() {
+  LogTracingHistograms();
+}
+
+void __cdecl principia__TracingWriteChromeTrace(char const* const filename) {
+  auto const status = WriteChromeTrace(filename);
+  LOG_IF(ERROR, !status.ok()) << status;
+}
+
 }  // namespace interface
 }  // namespace principia
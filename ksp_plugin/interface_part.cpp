@@ -19,6 +19,33 @@ using namespace principia::ksp_plugin::_identification;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_si;
 
+namespace {
+
+RigidMotion<Barycentric, World> BarycentricToWorld(Plugin const& plugin,
+                                                   Origin const& origin) {
+  return plugin.BarycentricToWorld(
+      origin.reference_part_is_unmoving,
+      origin.reference_part_id,
+      origin.reference_part_is_at_origin
+          ? std::nullopt
+          : std::make_optional(
+                FromXYZ<Position<World>>(origin.main_body_centre_in_world)));
+}
+
+QPRW ToQPRW(RigidMotion<EccentricPart, World> const& part_motion) {
+  DegreesOfFreedom<World> const part_dof =
+      part_motion({EccentricPart::origin, EccentricPart::unmoving});
+  Rotation<EccentricPart, World> const part_orientation =
+      part_motion.orthogonal_map().AsRotation();
+  AngularVelocity<World> const part_angular_velocity =
+      part_motion.angular_velocity_of<EccentricPart>();
+  return {ToQP(part_dof),
+          ToWXYZ(part_orientation.quaternion()),
+          ToXYZ(part_angular_velocity.coordinates() / (Radian / Second))};
+}
+
+}  // namespace
+
 void __cdecl principia__PartApplyIntrinsicForce(
     Plugin* const plugin,
     PartId const part_id,
@@ -68,26 +95,43 @@ QPRW __cdecl principia__PartGetActualRigidMotion(
   journal::Method<journal::PartGetActualRigidMotion> m(
       {plugin, part_id, origin});
   CHECK_NOTNULL(plugin);
-  RigidMotion<EccentricPart, World> const part_motion =
-      plugin->GetPartActualMotion(
-          part_id,
-          plugin->BarycentricToWorld(
-              origin.reference_part_is_unmoving,
-              origin.reference_part_id,
-              origin.reference_part_is_at_origin
-                  ? std::nullopt
-                  : std::make_optional(FromXYZ<Position<World>>(
-                        origin.main_body_centre_in_world))));
-  DegreesOfFreedom<World> const part_dof =
-      part_motion({EccentricPart::origin, EccentricPart::unmoving});
-  Rotation<EccentricPart, World> const part_orientation =
-      part_motion.orthogonal_map().AsRotation();
-  AngularVelocity<World> const part_angular_velocity =
-      part_motion.angular_velocity_of<EccentricPart>();
-  return m.Return(
-      {ToQP(part_dof),
-       ToWXYZ(part_orientation.quaternion()),
-       ToXYZ(part_angular_velocity.coordinates() / (Radian / Second))});
+  return m.Return(ToQPRW(plugin->GetPartActualMotion(
+      part_id, BarycentricToWorld(*plugin, origin))));
+}
+
+// Fills the arrays at |part_ids| and |part_motions| with the ids of the parts
+// of the vessel with GUID |vessel_guid| and the results of
+// |principia__PartGetActualRigidMotion| for these parts, and returns the number
+// of parts.  The motion of |World| is only computed once.  |part_ids_size| and
+// |part_motions_size| must be at least the number of parts.  |plugin| must not
+// be null.  No transfer of ownership.
+int __cdecl principia__PartsGetActualRigidMotions(
+    Plugin const* const plugin,
+    char const* const vessel_guid,
+    Origin const origin,
+    PartId* const part_ids,
+    int const part_ids_size,
+    QPRW* const part_motions,
+    int const part_motions_size) {
+  journal::Method<journal::PartsGetActualRigidMotions> m(
+      {plugin,
+       vessel_guid,
+       origin,
+       part_ids,
+       part_ids_size,
+       part_motions,
+       part_motions_size});
+  CHECK_NOTNULL(plugin);
+  auto const motions = plugin->GetAllPartsActualMotions(
+      vessel_guid, BarycentricToWorld(*plugin, origin));
+  CHECK_LE(motions.size(), part_ids_size);
+  CHECK_LE(motions.size(), part_motions_size);
+  for (int i = 0; i < motions.size(); ++i) {
+    auto const& [part_id, part_motion] = motions[i];
+    part_ids[i] = part_id;
+    part_motions[i] = ToQPRW(part_motion);
+  }
+  return m.Return(static_cast<int>(motions.size()));
 }
 
 bool __cdecl principia__PartIsTruthful(
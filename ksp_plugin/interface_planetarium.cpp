@@ -1,8 +1,13 @@
 #include "ksp_plugin/interface.hpp"
 
 #include <algorithm>
+#include <future>
 #include <limits>
+#include <optional>
+#include <thread>
+#include <vector>
 
+#include "base/thread_pool.hpp"
 #include "geometry/affine_map.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/orthogonal_map.hpp"
@@ -24,6 +29,7 @@
 namespace principia {
 namespace interface {
 
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_affine_map;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_orthogonal_map;
@@ -40,6 +46,62 @@ using namespace principia::physics::_discrete_trajectory;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
+namespace {
+
+// The pool used to plot the trajectories of the celestials concurrently.
+ThreadPool<void>& PlottingThreadPool() {
+  static auto* const pool =
+      new ThreadPool<void>(std::thread::hardware_concurrency());
+  return *pool;
+}
+
+// The time up to which the future trajectories of the celestials are plotted:
+// the furthest of the final time of the prediction of the vessel with the
+// given GUID or that of its flight plan.
+Instant CelestialFutureFinalTime(Plugin const& plugin,
+                                 char const* const vessel_guid) {
+  auto const& vessel = *plugin.GetVessel(vessel_guid);
+  Instant const prediction_final_time = vessel.prediction()->t_max();
+  return vessel.has_flight_plan()
+             ? std::max(vessel.flight_plan().actual_final_time(),
+                        prediction_final_time)
+             : prediction_final_time;
+}
+
+// Fills the array of size |vertices_size| at |vertices| with vertices for the
+// trajectory of the celestial with the given index from |desired_first_time|
+// (or the earliest time available if the relevant |t_min| is more recent) to
+// |last_time|.  This function is thread-safe.
+void PlotCelestialTrajectory(Planetarium const& planetarium,
+                             Plugin const& plugin,
+                             int const celestial_index,
+                             Instant const& desired_first_time,
+                             Instant const& last_time,
+                             bool const reverse,
+                             ScaledSpacePoint* const vertices,
+                             int const vertices_size,
+                             double* const minimal_distance_from_camera,
+                             int* const vertex_count) {
+  auto const& celestial_trajectory =
+      plugin.GetCelestial(celestial_index).trajectory();
+  Instant const first_time =
+      std::max(desired_first_time, celestial_trajectory.t_min());
+  Length minimal_distance;
+  *vertex_count = planetarium.PlotMethod3(
+      celestial_trajectory,
+      first_time,
+      last_time,
+      /*now=*/plugin.CurrentTime(),
+      reverse,
+      vertices,
+      vertices_size,
+      &minimal_distance,
+      /*cache_samples=*/true);
+  *minimal_distance_from_camera = minimal_distance / Metre;
+}
+
+}  // namespace
+
 Planetarium* __cdecl principia__PlanetariumCreate(
     Plugin const* const plugin,
     XYZ const sun_world_position,
@@ -149,14 +211,13 @@ void __cdecl principia__PlanetariumPlotFlightPlanSegment(
   if (index % 2 == 0 ||
       segment->empty() ||
       segment->front().time >= plugin->renderer().GetPlottingFrame()->t_min()) {
-    planetarium->PlotMethod3(
+    *vertex_count = planetarium->PlotMethod3(
         *segment, segment->begin(), segment->end(),
         plugin->CurrentTime(),
         /*reverse=*/false,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size);
+        vertices,
+        vertices_size,
+        /*cache_samples=*/true);
   }
   return m.Return();
 }
@@ -178,72 +239,16 @@ void __cdecl principia__PlanetariumPlotPrediction(
   *vertex_count = 0;
 
   auto const prediction = plugin->GetVessel(vessel_guid)->prediction();
-  planetarium->PlotMethod3(
+  *vertex_count = planetarium->PlotMethod3(
       *prediction, prediction->begin(), prediction->end(),
       plugin->CurrentTime(),
       /*reverse=*/false,
-      [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-        vertices[(*vertex_count)++] = vertex;
-      },
-      vertices_size);
+      vertices,
+      vertices_size,
+      /*cache_samples=*/true);
   return m.Return();
 }
 
-// Fills the array of size |vertices_size| at |vertices| with vertices for the
-// rendered past trajectory of the vessel with the given GUID; the
-// trajectory goes back |max_history_length| seconds before the present time (or
-// to the earliest time available if the relevant |t_min| is more recent).
-void __cdecl principia__PlanetariumPlotPsychohistory(
-    Planetarium const* const planetarium,
-    Plugin const* const plugin,
-    char const* const vessel_guid,
-    double const max_history_length,
-    ScaledSpacePoint* const vertices,
-    int const vertices_size,
-    int* const vertex_count) {
-  journal::Method<journal::PlanetariumPlotPsychohistory> m(
-      {planetarium,
-       plugin,
-       vessel_guid,
-       max_history_length,
-       vertices,
-       vertices_size},
-      {vertex_count});
-  CHECK_NOTNULL(plugin);
-  CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  // Do not plot the psychohistory when there is a target vessel as it is
-  // misleading.
-  if (plugin->renderer().HasTargetVessel()) {
-    return m.Return();
-  } else {
-    auto const vessel = plugin->GetVessel(vessel_guid);
-    auto const& trajectory = vessel->trajectory();
-    auto const& psychohistory = vessel->psychohistory();
-
-    Instant const desired_first_time =
-        plugin->CurrentTime() - max_history_length * Second;
-
-    // Since we would want to plot starting from |desired_first_time|, ask the
-    // reanimator to reconstruct the past.  That may take a while, during which
-    // time the history will be shorter than desired.
-    vessel->RequestReanimation(desired_first_time);
-
-    planetarium->PlotMethod3(
-        trajectory,
-        trajectory.lower_bound(desired_first_time),
-        psychohistory->end(),
-        /*now=*/plugin->CurrentTime(),
-        /*reverse=*/true,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size);
-    return m.Return();
-  }
-}
-
 // Fills the array of size |vertices_size| at |vertices| with vertices for the
 // rendered past trajectory of the celestial with the given index; the
 // trajectory goes back |max_history_length| seconds before the present time (or
@@ -274,8 +279,6 @@ void __cdecl principia__PlanetariumPlotCelestialPastTrajectory(
     *minimal_distance_from_camera = std::numeric_limits<double>::infinity();
     return m.Return();
   } else {
-    auto const& celestial_trajectory =
-        plugin->GetCelestial(celestial_index).trajectory();
     Instant const desired_first_time =
         plugin->CurrentTime() - max_history_length * Second;
 
@@ -284,21 +287,16 @@ void __cdecl principia__PlanetariumPlotCelestialPastTrajectory(
     // time the history will be shorter than desired.
     plugin->RequestReanimation(desired_first_time);
 
-    Instant const first_time =
-        std::max(desired_first_time, celestial_trajectory.t_min());
-    Length minimal_distance;
-    planetarium->PlotMethod3(
-        celestial_trajectory,
-        first_time,
-        /*last_time=*/plugin->CurrentTime(),
-        /*now=*/plugin->CurrentTime(),
-        /*reverse=*/true,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size,
-        &minimal_distance);
-    *minimal_distance_from_camera = minimal_distance / Metre;
+    PlotCelestialTrajectory(*planetarium,
+                            *plugin,
+                            celestial_index,
+                            desired_first_time,
+                            /*last_time=*/plugin->CurrentTime(),
+                            /*reverse=*/true,
+                            vertices,
+                            vertices_size,
+                            minimal_distance_from_camera,
+                            vertex_count);
     return m.Return();
   }
 }
@@ -334,34 +332,115 @@ void __cdecl principia__PlanetariumPlotCelestialFutureTrajectory(
     *minimal_distance_from_camera = std::numeric_limits<double>::infinity();
     return m.Return();
   } else {
-    auto const& vessel = *plugin->GetVessel(vessel_guid);
-    Instant const prediction_final_time = vessel.prediction()->t_max();
-    Instant const final_time =
-        vessel.has_flight_plan()
-            ? std::max(vessel.flight_plan().actual_final_time(),
-                       prediction_final_time)
-            : prediction_final_time;
-    auto const& celestial_trajectory =
-        plugin->GetCelestial(celestial_index).trajectory();
     // No need to request reanimation here because the current time of the
     // plugin is necessarily covered.
-    Length minimal_distance;
-    planetarium->PlotMethod3(
-        celestial_trajectory,
-        /*first_time=*/plugin->CurrentTime(),
-        /*last_time=*/final_time,
-        /*now=*/plugin->CurrentTime(),
+    PlotCelestialTrajectory(
+        *planetarium,
+        *plugin,
+        celestial_index,
+        /*desired_first_time=*/plugin->CurrentTime(),
+        /*last_time=*/CelestialFutureFinalTime(*plugin, vessel_guid),
         /*reverse=*/false,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
+        vertices,
         vertices_size,
-        &minimal_distance);
-    *minimal_distance_from_camera = minimal_distance / Metre;
+        minimal_distance_from_camera,
+        vertex_count);
     return m.Return();
   }
 }
 
+// Plots the past and future trajectories of all the celestials concurrently.
+// The celestials must have the indices 0 to |plots_size| - 1.  The array of
+// size |vertices_size| at |vertices| is divided in 2 |plots_size| slices of
+// equal size: the past trajectory of the celestial with index i is in slice
+// 2 i, and its future trajectory in slice 2 i + 1.  The trajectories are those
+// of |PlanetariumPlotCelestialPastTrajectory| and
+// |PlanetariumPlotCelestialFutureTrajectory|, and the vertex counts and
+// minimal distances are stored in |plots[i]|.  The future trajectories are not
+// plotted if |vessel_guid| is empty.
+void __cdecl principia__PlanetariumPlotCelestialTrajectories(
+    Planetarium const* const planetarium,
+    Plugin const* const plugin,
+    double const max_history_length,
+    char const* const vessel_guid,
+    ScaledSpacePoint* const vertices,
+    int const vertices_size,
+    CelestialTrajectoryPlot* const plots,
+    int const plots_size) {
+  journal::Method<journal::PlanetariumPlotCelestialTrajectories> m(
+      {planetarium,
+       plugin,
+       max_history_length,
+       vessel_guid,
+       vertices,
+       vertices_size,
+       plots,
+       plots_size});
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(planetarium);
+  CHECK_NOTNULL(vessel_guid);
+  for (int i = 0; i < plots_size; ++i) {
+    plots[i] = {
+        .past_minimal_distance_from_camera =
+            std::numeric_limits<double>::infinity(),
+        .past_vertex_count = 0,
+        .future_minimal_distance_from_camera =
+            std::numeric_limits<double>::infinity(),
+        .future_vertex_count = 0};
+  }
+
+  // Do not plot the celestials when there is a target vessel as it is
+  // misleading.
+  if (plugin->renderer().HasTargetVessel() || plots_size == 0) {
+    return m.Return();
+  }
+
+  Instant const desired_first_time =
+      plugin->CurrentTime() - max_history_length * Second;
+  plugin->RequestReanimation(desired_first_time);
+  std::optional<Instant> future_final_time;
+  if (*vessel_guid != '\0') {
+    future_final_time = CelestialFutureFinalTime(*plugin, vessel_guid);
+  }
+
+  int const slice_size = vertices_size / (2 * plots_size);
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < plots_size; ++i) {
+    // The lambdas may capture by reference because we wait for all of them
+    // below.
+    futures.push_back(PlottingThreadPool().Add([&, i]() {
+      PlotCelestialTrajectory(*planetarium,
+                              *plugin,
+                              /*celestial_index=*/i,
+                              desired_first_time,
+                              /*last_time=*/plugin->CurrentTime(),
+                              /*reverse=*/true,
+                              vertices + 2 * i * slice_size,
+                              slice_size,
+                              &plots[i].past_minimal_distance_from_camera,
+                              &plots[i].past_vertex_count);
+    }));
+    if (future_final_time.has_value()) {
+      futures.push_back(PlottingThreadPool().Add([&, i]() {
+        PlotCelestialTrajectory(*planetarium,
+                                *plugin,
+                                /*celestial_index=*/i,
+                                /*desired_first_time=*/plugin->CurrentTime(),
+                                /*last_time=*/*future_final_time,
+                                /*reverse=*/false,
+                                vertices + (2 * i + 1) * slice_size,
+                                slice_size,
+                                &plots[i].future_minimal_distance_from_camera,
+                                &plots[i].future_vertex_count);
+      }));
+    }
+  }
+  for (auto const& future : futures) {
+    future.wait();
+  }
+  return m.Return();
+}
+
 // Fills the array of size |vertices_size| at |vertices| with vertices for the
 // rendered prediction of the vessel with the given GUID.
 void __cdecl principia__PlanetariumPlotEquipotential(
@@ -383,17 +462,15 @@ void __cdecl principia__PlanetariumPlotEquipotential(
   CHECK_GE(index, 0);
   CHECK_LT(index, equipotentials.lines.size());
   DiscreteTrajectory<Navigation> const& equipotential =
-      equipotentials.lines[index];
+      *equipotentials.lines[index];
 
-  planetarium->PlotMethod3(
+  *vertex_count = planetarium->PlotMethod3(
       equipotential,
       equipotential.front().time,
       equipotential.back().time,
       plugin->CurrentTime(),
       /*reverse=*/false,
-      [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-        vertices[(*vertex_count)++] = vertex;
-      },
+      vertices,
       vertices_size);
   return m.Return();
 }
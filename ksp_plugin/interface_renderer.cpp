@@ -50,6 +50,8 @@ void __cdecl principia__RenderedPredictionApsides(
   DiscreteTrajectory<World> rendered_apoapsides;
   DiscreteTrajectory<World> rendered_periapsides;
   plugin->ComputeAndRenderApsides(celestial_index,
+                                  vessel_guid,
+                                  VesselTrajectory::Prediction,
                                   *prediction,
                                   prediction->begin(),
                                   prediction->end(),
@@ -79,6 +81,8 @@ void __cdecl principia__RenderedPredictionClosestApproaches(
   auto const prediction = plugin->GetVessel(vessel_guid)->prediction();
   DiscreteTrajectory<World> rendered_closest_approaches;
   plugin->ComputeAndRenderClosestApproaches(
+      vessel_guid,
+      VesselTrajectory::Prediction,
       *prediction,
       prediction->begin(),
       prediction->end(),
@@ -2,6 +2,7 @@
 
 #include <numeric>
 #include <string>
+#include <vector>
 
 #include "geometry/grassmann.hpp"
 #include "geometry/orthogonal_map.hpp"
@@ -9,6 +10,7 @@
 #include "journal/method.hpp"
 #include "journal/profiles.hpp"  // 🧙 For generated profiles.
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/identification.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/rigid_motion.hpp"
 #include "quantities/named_quantities.hpp"
@@ -22,6 +24,7 @@ using namespace principia::geometry::_orthogonal_map;
 using namespace principia::geometry::_sign;
 using namespace principia::journal::_method;
 using namespace principia::ksp_plugin::_frames;
+using namespace principia::ksp_plugin::_identification;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_rigid_motion;
 using namespace principia::quantities::_named_quantities;
@@ -80,6 +83,16 @@ principia__VesselGetPredictionAdaptiveStepParameters(
       plugin->GetVessel(vessel_guid)->prediction_adaptive_step_parameters()));
 }
 
+// Returns an estimate of the number of bytes used by the vessel, including its
+// trajectory, its checkpoints and its flight plans.
+std::int64_t __cdecl principia__VesselMemoryFootprint(
+    Plugin const* const plugin,
+    char const* const vessel_guid) {
+  journal::Method<journal::VesselMemoryFootprint> m({plugin, vessel_guid});
+  CHECK_NOTNULL(plugin);
+  return m.Return(plugin->GetVessel(vessel_guid)->MemoryFootprint());
+}
+
 XYZ __cdecl principia__VesselNormal(Plugin const* const plugin,
                                     char const* const vessel_guid) {
   journal::Method<journal::VesselNormal> m({plugin, vessel_guid});
@@ -125,5 +138,32 @@ XYZ __cdecl principia__VesselVelocity(Plugin const* const plugin,
   return m.Return(ToXYZ(plugin->VesselVelocity(vessel_guid)));
 }
 
+// Fills the array of size |qps_size| at |qps| with the results of
+// |plugin->VesselFromParent| for the vessels in the null-terminated array
+// |vessel_guids|, relative to their current parents, in one call across the
+// interface.  |qps_size| must be the number of vessels.  |plugin| must not be
+// null.  No transfer of ownership.
+void __cdecl principia__VesselsFromParent(
+    Plugin const* const plugin,
+    char const* const* const vessel_guids,
+    QP* const qps,
+    int const qps_size) {
+  journal::Method<journal::VesselsFromParent> m(
+      {plugin, vessel_guids, qps, qps_size});
+  CHECK_NOTNULL(plugin);
+  std::vector<GUID> guids;
+  for (char const* const* c = vessel_guids;
+       *c != nullptr;
+       ++c) {
+    guids.push_back(std::string(*c));
+  }
+  CHECK_EQ(guids.size(), qps_size);
+  auto const from_parents = plugin->VesselsFromParent(guids);
+  for (int i = 0; i < from_parents.size(); ++i) {
+    qps[i] = ToQP(from_parents[i]);
+  }
+  return m.Return();
+}
+
 }  // namespace interface
 }  // namespace principia
@@ -63,6 +63,18 @@ class TypedIterator<DiscreteTrajectory<World>> : public Iterator {
       std::function<Interchange(
           DiscreteTrajectory<World>::iterator const&)> const& convert) const;
 
+  // Converts the elements starting at the one denoted by this iterator using
+  // |convert|, and stores them in the array of size |size| at |elements|.
+  // Advances this iterator past the elements that were stored.  Returns the
+  // number of elements stored, which is less than |size| only if the end was
+  // reached.
+  template<typename Interchange>
+  int GetAndIncrement(
+      std::function<Interchange(
+          DiscreteTrajectory<World>::iterator const&)> const& convert,
+      Interchange* elements,
+      int size);
+
   bool AtEnd() const override;
   void Increment() override;
   void Reset() override;
@@ -59,6 +59,19 @@ Interchange TypedIterator<DiscreteTrajectory<World>>::Get(
   return convert(iterator_);
 }
 
+template<typename Interchange>
+int TypedIterator<DiscreteTrajectory<World>>::GetAndIncrement(
+    std::function<Interchange(
+        DiscreteTrajectory<World>::iterator const&)> const& convert,
+    Interchange* const elements,
+    int const size) {
+  int count = 0;
+  for (; count < size && iterator_ != trajectory_.end(); ++count, ++iterator_) {
+    elements[count] = convert(iterator_);
+  }
+  return count;
+}
+
 inline bool TypedIterator<DiscreteTrajectory<World>>::AtEnd() const {
   return iterator_ == trajectory_.end();
 }
@@ -13,7 +13,6 @@ namespace ksp_plugin {
 namespace _manœuvre {
 namespace internal {
 
-using std::placeholders::_1;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_rigid_motion;
 
@@ -189,11 +188,10 @@ template<typename InertialFrame, typename Frame>
 typename Ephemeris<InertialFrame>::IntrinsicAcceleration
 Manœuvre<InertialFrame, Frame>::InertialIntrinsicAcceleration() const {
   CHECK(is_inertially_fixed());
-  return std::bind(
-      &Manœuvre<InertialFrame, Frame>::ComputeIntrinsicAcceleration,
-      this,
-      _1,
-      /*direction=*/InertialDirection());
+  return [this, direction = InertialDirection()](
+             Instant const& t) -> Vector<Acceleration, InertialFrame> {
+    return ComputeIntrinsicAcceleration(t, direction);
+  };
 }
 
 template<typename InertialFrame, typename Frame>
@@ -203,6 +201,11 @@ Manœuvre<InertialFrame, Frame>::FrenetIntrinsicAcceleration() const {
   return [this](Instant const& t,
                 DegreesOfFreedom<InertialFrame> const& degrees_of_freedom)
              -> Vector<Acceleration, InertialFrame> {
+    // The Frenet frame is expensive to compute, don't bother outside of the
+    // burn, where the acceleration is zero anyway.
+    if (t < initial_time() || t > final_time()) {
+      return Vector<Acceleration, InertialFrame>();
+    }
     return ComputeIntrinsicAcceleration(
         t,
         /*direction=*/ComputeFrenetFrame(t, degrees_of_freedom)(direction()));
@@ -255,8 +258,11 @@ OrthogonalMap<Frenet<Frame>, InertialFrame>
 Manœuvre<InertialFrame, Frame>::ComputeFrenetFrame(
     Instant const& t,
     DegreesOfFreedom<InertialFrame> const& degrees_of_freedom) const {
+  // The Frenet frame needs the geometric acceleration, which computes the
+  // motion of the frame at |t|: go through the cache so that the motion is only
+  // evaluated once per right-hand side evaluation of the burn.
   RigidMotion<InertialFrame, Frame> const to_frame_at_t =
-      frame()->ToThisFrameAtTime(t);
+      frame()->CachedToThisFrameAtTime(t);
   RigidMotion<Frame, InertialFrame> const from_frame_at_t =
       to_frame_at_t.Inverse();
   return from_frame_at_t.orthogonal_map() *
@@ -55,26 +55,40 @@ OrbitAnalyser::~OrbitAnalyser() {
 }
 
 void OrbitAnalyser::Interrupt() {
+  deferred_parameters_.reset();
   analyser_ = jthread();
   // We are single-threaded here, no need to lock.
   analyser_idle_ = true;
 }
 
 void OrbitAnalyser::RequestAnalysis(Parameters const& parameters) {
+  deferred_parameters_.reset();
   if (ephemeris_->t_min() > parameters.first_time) {
     // Too much has been forgotten; we cannot perform this analysis.
     return;
   }
   last_parameters_ = parameters;
-  absl::MutexLock l(&lock_);
-  // Only process this request if there is no analysis in progress.
-  if (analyser_idle_) {
-    analyser_idle_ = false;
-    analyser_ = MakeStoppableThread(
-        [this, parameters]() {
-          AnalyseOrbit(parameters).IgnoreError();
-        });
+  {
+    absl::MutexLock l(&lock_);
+    // Let an analysis in progress run to completion, unless it is stale.
+    if (!analyser_idle_ && !Supersedes(parameters, *analysed_parameters_)) {
+      return;
+    }
   }
+  // Either the analyser is idle, or it is stopped at its next check point and
+  // its partial results, if any, remain available.
+  Interrupt();
+  analysed_parameters_ = parameters;
+  absl::MutexLock l(&lock_);
+  analyser_idle_ = false;
+  analyser_ = MakeStoppableThread(
+      [this, parameters]() {
+        AnalyseOrbit(parameters).IgnoreError();
+      });
+}
+
+void OrbitAnalyser::DeferAnalysis(Parameters const& parameters) {
+  deferred_parameters_ = parameters;
 }
 
 std::optional<OrbitAnalyser::Parameters> const& OrbitAnalyser::last_parameters()
@@ -83,11 +97,26 @@ std::optional<OrbitAnalyser::Parameters> const& OrbitAnalyser::last_parameters()
 }
 
 void OrbitAnalyser::RefreshAnalysis() {
+  if (deferred_parameters_.has_value()) {
+    // Copy the parameters, since |RequestAnalysis| resets the deferred ones.
+    Parameters const parameters = *deferred_parameters_;
+    RequestAnalysis(parameters);
+  }
   absl::MutexLock l(&lock_);
   if (next_analysis_.has_value()) {
     analysis_ = std::move(next_analysis_);
     next_analysis_.reset();
   }
+  if (next_ground_track_.has_value() && analysis_.has_value()) {
+    analysis_->ground_track_ = std::move(next_ground_track_);
+    next_ground_track_.reset();
+    // Preserve any recurrence set by the caller on the partial analysis.
+    if (analysis_->recurrence_.has_value()) {
+      analysis_->equatorial_crossings_ =
+          analysis_->ground_track_->equator_crossing_longitudes(
+              *analysis_->recurrence_, /*first_ascending_pass_index=*/1);
+    }
+  }
 }
 
 OrbitAnalyser::Analysis* OrbitAnalyser::analysis() {
@@ -95,6 +124,9 @@ OrbitAnalyser::Analysis* OrbitAnalyser::analysis() {
 }
 
 double OrbitAnalyser::progress_of_next_analysis() const {
+  if (deferred_parameters_.has_value()) {
+    return 0;
+  }
   return progress_of_next_analysis_;
 }
 
@@ -156,6 +188,16 @@ absl::Status OrbitAnalyser::AnalyseOrbit(Parameters const& parameters) {
       if (analysis.closest_recurrence_->number_of_revolutions() == 0) {
         analysis.closest_recurrence_.reset();
       }
+      analysis.ResetRecurrence();
+
+      // Publish the elements and recurrence now: the computation of the mean
+      // sun may require prolonging the ephemeris, and the ground track may
+      // take a while.
+      {
+        absl::MutexLock l(&lock_);
+        next_analysis_ = std::move(analysis);
+        next_ground_track_.reset();
+      }
 
       std::optional<OrbitGroundTrack::MeanSun> mean_sun;
       RETURN_IF_ERROR(ComputeMeanSunIfPossible(parameters,
@@ -167,17 +209,35 @@ absl::Status OrbitAnalyser::AnalyseOrbit(Parameters const& parameters) {
                                           *primary,
                                           mean_sun);
       RETURN_IF_ERROR(ground_track);
-      analysis.ground_track_ = std::move(ground_track).value();
-      analysis.ResetRecurrence();
+
+      absl::MutexLock l(&lock_);
+      next_ground_track_ = std::move(ground_track).value();
+      analyser_idle_ = true;
+      return absl::OkStatus();
     }
   }
 
   absl::MutexLock l(&lock_);
   next_analysis_ = std::move(analysis);
+  next_ground_track_.reset();
   analyser_idle_ = true;
   return absl::OkStatus();
 }
 
+bool OrbitAnalyser::Supersedes(Parameters const& newer,
+                               Parameters const& older) {
+  if (newer.mission_duration != older.mission_duration ||
+      newer.extended_mission_duration != older.extended_mission_duration) {
+    return true;
+  }
+  // A request at a later time is the same trajectory, further along; one at
+  // the same or an earlier time is a different trajectory unless it is the
+  // same request.
+  return newer.first_time <= older.first_time &&
+         (newer.first_time != older.first_time ||
+          newer.first_degrees_of_freedom != older.first_degrees_of_freedom);
+}
+
 absl::Status OrbitAnalyser::FindBodyWithSmallestOsculatingPeriod(
     Parameters const& parameters,
     RotatingBody<Barycentric> const*& primary,
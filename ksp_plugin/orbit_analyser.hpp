@@ -15,6 +15,7 @@
 #include "geometry/instant.hpp"
 #include "geometry/interval.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "physics/body_centred_non_rotating_reference_frame.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
@@ -112,31 +113,46 @@ class OrbitAnalyser {
 
   virtual ~OrbitAnalyser();
 
-  // Cancels any computation in progress, causing the next call to
-  // |RequestAnalysis| to be processed as fast as possible.
+  // Cancels any computation in progress and any deferred request, causing the
+  // next call to |RequestAnalysis| to be processed as fast as possible.
   void Interrupt();
 
   // Sets the parameters that will be used for the computation of the next
-  // analysis.
+  // analysis.  If an analysis is in progress, it runs to completion unless
+  // |parameters| supersede its own, in which case it is abandoned at its next
+  // check point and an analysis of |parameters| is started instead.
   void RequestAnalysis(Parameters const& parameters);
 
+  // Records |parameters| to be passed to |RequestAnalysis| by the next call to
+  // |RefreshAnalysis|, superseding any request deferred earlier, so that no
+  // analysis is computed until the client is interested in its result.
+  void DeferAnalysis(Parameters const& parameters);
+
   // The last value passed to |RequestAnalysis|.
   std::optional<Parameters> const& last_parameters() const;
 
-  // Sets |analysis()| to the latest computed analysis.
+  // Issues the deferred request, if any, and sets |analysis()| to the latest
+  // computed analysis.  The analysis is published in stages: the elements and
+  // recurrence are available before the ground track, which is filled in by a
+  // later call to this function.
   void RefreshAnalysis();
 
   // Mutable so that the caller can call |SetRecurrence| and |ResetRecurrence|.
   Analysis* analysis();
 
   // The result is in [0, 1]; it tracks the progress of the computation of the
-  // next analysis.  Note that a new analysis may be ready even if this is not
+  // next analysis, and is 0 if that analysis is deferred.  Note that a new analysis may be ready even if this is not
   // equal to 1, if the analyser is working on a subsequent request.
   double progress_of_next_analysis() const;
 
  private:
   using PrimaryCentred = Frame<struct PrimaryCentredTag, NonRotating>;
 
+  // Returns true if the analysis of |older| is stale once |newer| has been
+  // requested, i.e., if |newer| is not merely a later point on the same
+  // trajectory, analysed with the same durations.
+  static bool Supersedes(Parameters const& newer, Parameters const& older);
+
   // Finds the primary body and analyze our orbit around it.
   absl::Status AnalyseOrbit(Parameters const& parameters);
 
@@ -177,6 +193,12 @@ class OrbitAnalyser {
       analysed_trajectory_parameters_;
 
   std::optional<Parameters> last_parameters_;
+  // The parameters passed to |DeferAnalysis| and not yet requested.  Only
+  // accessed by the main thread.
+  std::optional<Parameters> deferred_parameters_;
+  // The parameters of the analysis being computed by |analyser_|, if it is not
+  // idle.  Only accessed by the main thread.
+  std::optional<Parameters> analysed_parameters_;
 
   std::optional<Analysis> analysis_;
 
@@ -192,6 +214,10 @@ class OrbitAnalyser {
   // |next_analysis_| is set by the |analyser_| thread; it is read and cleared
   // by the main thread.
   std::optional<Analysis> next_analysis_ GUARDED_BY(lock_);
+  // |next_ground_track_| is set by the |analyser_| thread after it has set
+  // |next_analysis_|, and belongs to the last analysis that it set; it is read
+  // and cleared by the main thread.
+  std::optional<OrbitGroundTrack> next_ground_track_ GUARDED_BY(lock_);
   // |progress_of_next_analysis_| is set by the |analyser_| thread; it tracks
   // progress in computing |next_analysis_|.
   std::atomic<double> progress_of_next_analysis_ = 0;
@@ -5,6 +5,7 @@
 #include "base/disjoint_sets.hpp"  // 🧙 For _disjoint_sets.
 #include "geometry/instant.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "ksp_plugin/pile_up.hpp"
 #include "physics/ephemeris.hpp"
 
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/map_util.hpp"
+#include "base/tracing.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/identity.hpp"
 #include "geometry/orthogonal_map.hpp"
@@ -22,6 +23,7 @@
 #include "ksp_plugin/integrators.hpp"
 #include "ksp_plugin/part.hpp"
 #include "numerics/davenport_q_method.hpp"
+#include "physics/massive_body.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/parser.hpp"
 #include "quantities/si.hpp"
@@ -35,6 +37,7 @@ using ::std::placeholders::_1;
 using ::std::placeholders::_2;
 using ::std::placeholders::_3;
 using namespace principia::base::_map_util;
+using namespace principia::base::_tracing;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_identity;
 using namespace principia::geometry::_orthogonal_map;
@@ -47,10 +50,19 @@ using namespace principia::geometry::_space;
 using namespace principia::ksp_plugin::_integrators;
 using namespace principia::ksp_plugin::_part;
 using namespace principia::numerics::_davenport_q_method;
+using namespace principia::physics::_massive_body;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_parser;
 using namespace principia::quantities::_si;
 
+// When the history step is selected from the dynamics of the pile-up, there
+// are at least that many steps per radian of the osculating orbit around any
+// body at its periapsis.
+constexpr double history_steps_per_radian = 16;
+// A history step selected from the dynamics of the pile-up is reselected after
+// that many steps.
+constexpr int history_steps_between_selections = 64;
+
 const auto part_x = Vector<double, RigidPart>({1, 0, 0});
 const auto part_y = Vector<double, RigidPart>({0, 1, 0});
 const auto part_z = Vector<double, RigidPart>({0, 0, 1});
@@ -67,6 +79,7 @@ PileUp::PileUp(
       ephemeris_(ephemeris),
       adaptive_step_parameters_(std::move(adaptive_step_parameters)),
       fixed_step_parameters_(std::move(fixed_step_parameters)),
+      history_parameters_(fixed_step_parameters_),
       history_(trajectory_.segments().begin()),
       deletion_callback_(std::move(deletion_callback)) {
   LOG(INFO) << "Constructing pile up at " << this;
@@ -95,6 +108,7 @@ PileUp::PileUp(
 
 PileUp::~PileUp() {
   LOG(INFO) << "Destroying pile up at " << this;
+  LeaveBatch();
   if (deletion_callback_ != nullptr) {
     deletion_callback_();
   }
@@ -109,6 +123,15 @@ PileUp::fixed_step_parameters() const {
   return fixed_step_parameters_;
 }
 
+void PileUp::set_max_history_step(std::optional<Time> const& max_history_step) {
+  max_history_step_ = max_history_step;
+}
+
+std::int64_t PileUp::MemoryFootprint() const {
+  absl::ReaderMutexLock l(lock_.get());
+  return sizeof(*this) + trajectory_.MemoryFootprint();
+}
+
 void PileUp::SetPartApparentRigidMotion(
     not_null<Part*> const part,
     RigidMotion<RigidPart, Apparent> const& rigid_motion) {
@@ -119,6 +142,7 @@ void PileUp::SetPartApparentRigidMotion(
 }
 
 absl::Status PileUp::DeformAndAdvanceTime(Instant const& t) {
+  TracingScope tracing_scope("PileUp::DeformAndAdvanceTime");
   absl::MutexLock l(lock_.get());
   absl::Status status;
   if (psychohistory_->back().time < t) {
@@ -129,6 +153,168 @@ absl::Status PileUp::DeformAndAdvanceTime(Instant const& t) {
   return status;
 }
 
+std::vector<std::vector<not_null<PileUp*>>> PileUp::Batch(
+    std::list<PileUp*> const& pile_ups,
+    Instant const& t) {
+  std::vector<std::vector<not_null<PileUp*>>> batches;
+  // The pile-ups that may share an instance, indexed by the time of the end of
+  // their history and by their step.
+  std::map<std::pair<Instant, Time>, std::vector<not_null<PileUp*>>>
+      free_falling;
+  for (PileUp* const pile_up : pile_ups) {
+    bool leaves_batch;
+    {
+      absl::MutexLock l(pile_up->lock_.get());
+      pile_up->SelectHistoryStepIfNeeded();
+      Instant const history_last = pile_up->history_->back().time;
+      Time const step = pile_up->history_parameters_.step();
+      if (pile_up->psychohistory_->back().time < t &&
+          pile_up->intrinsic_force_ == Vector<Force, Barycentric>{} &&
+          history_last + step <= t) {
+        free_falling[{history_last, step}].push_back(pile_up);
+        continue;
+      }
+      // The quiescent fast path of |AdvanceTime| doesn't use the instance, so
+      // a pile-up that takes it may remain in its batch.
+      leaves_batch = pile_up->intrinsic_force_ != Vector<Force, Barycentric>{};
+    }
+    if (leaves_batch) {
+      pile_up->LeaveBatch();
+    }
+    batches.push_back({pile_up});
+  }
+
+  for (auto& [_, batch] : free_falling) {
+    if (batch.size() > 1 && IsCurrentBatch(batch)) {
+      // Same batch as last time, keep its instance.
+      batches.push_back(std::move(batch));
+      continue;
+    }
+    for (not_null<PileUp*> const pile_up : batch) {
+      pile_up->LeaveBatch();
+    }
+    if (batch.size() > 1) {
+      auto const shared =
+          std::make_shared<SharedFixedInstance>(SharedFixedInstance{batch});
+      for (not_null<PileUp*> const pile_up : batch) {
+        absl::MutexLock l(pile_up->lock_.get());
+        // Drop the individual instance, the history will be integrated by the
+        // shared one.
+        pile_up->fixed_instance_ = nullptr;
+        pile_up->shared_fixed_instance_ = shared;
+      }
+    }
+    batches.push_back(std::move(batch));
+  }
+  return batches;
+}
+
+std::vector<absl::Status> PileUp::DeformAndAdvanceTime(
+    std::vector<not_null<PileUp*>> const& pile_ups,
+    Instant const& t) {
+  CHECK(!pile_ups.empty());
+  if (pile_ups.size() == 1) {
+    return {pile_ups.front()->DeformAndAdvanceTime(t)};
+  }
+
+  // The pile-ups of a batch are only ever advanced together, so there cannot
+  // be a deadlock.
+  std::list<absl::MutexLock> locks;
+  for (not_null<PileUp*> const pile_up : pile_ups) {
+    locks.emplace_back(pile_up->lock_.get());
+  }
+  auto const shared = pile_ups.front()->shared_fixed_instance_;
+  CHECK(shared != nullptr);
+  CHECK(shared->pile_ups == pile_ups);
+
+  std::vector<Instant> history_lasts;
+  std::vector<not_null<DiscreteTrajectory<Barycentric>*>> trajectories;
+  for (not_null<PileUp*> const pile_up : pile_ups) {
+    CHECK_LT(pile_up->psychohistory_->back().time, t);
+    pile_up->DeformPileUpIfNeeded(t);
+    history_lasts.push_back(pile_up->history_->back().time);
+    // Remove the fork.
+    pile_up->trajectory_.DeleteSegments(pile_up->psychohistory_);
+    trajectories.push_back(&pile_up->trajectory_);
+  }
+
+  not_null<Ephemeris<Barycentric>*> const ephemeris =
+      pile_ups.front()->ephemeris_;
+  if (shared->instance == nullptr) {
+    shared->instance = ephemeris->NewInstance(
+        trajectories,
+        Ephemeris<Barycentric>::NoIntrinsicAccelerations,
+        pile_ups.front()->history_parameters_);
+  }
+  absl::Status const fixed_step_status =
+      ephemeris->FlowWithFixedStep(t, *shared->instance);
+
+  // The status of the fixed-step integration doesn't tell which pile-up
+  // collided, so it is reported for all the pile-ups of the batch, like
+  // |AdvanceTime| does for a single pile-up.
+  std::vector<absl::Status> statuses;
+  for (int i = 0; i < pile_ups.size(); ++i) {
+    PileUp& pile_up = *pile_ups[i];
+    absl::Status& status = statuses.emplace_back(fixed_step_status);
+    status.Update(pile_up.ForkPsychohistory(t));
+    pile_up.AppendToParts(history_lasts[i]);
+    pile_up.NudgeParts();
+  }
+
+  // Don't reuse the instance after a failed integration, it will be recreated
+  // from the end of the histories.  We hold the locks of all the pile-ups of
+  // the batch, so we may change the shared state, but not the membership of
+  // the batch, which only changes on the main thread.
+  if (!fixed_step_status.ok()) {
+    shared->instance = nullptr;
+  }
+  return statuses;
+}
+
+void PileUp::LeaveBatch() {
+  std::shared_ptr<SharedFixedInstance> shared;
+  {
+    absl::MutexLock l(lock_.get());
+    shared = shared_fixed_instance_;
+  }
+  if (shared == nullptr) {
+    return;
+  }
+  // Detach all the pile-ups from the shared state while holding their locks,
+  // in the order of the batch, like |DeformAndAdvanceTime|.  The pile-ups that
+  // already detached themselves are left alone.
+  std::list<absl::MutexLock> locks;
+  for (not_null<PileUp*> const pile_up : shared->pile_ups) {
+    locks.emplace_back(pile_up->lock_.get());
+  }
+  for (not_null<PileUp*> const pile_up : shared->pile_ups) {
+    if (pile_up->shared_fixed_instance_ == shared) {
+      pile_up->shared_fixed_instance_ = nullptr;
+    }
+  }
+}
+
+bool PileUp::IsCurrentBatch(std::vector<not_null<PileUp*>> const& batch) {
+  std::list<absl::ReaderMutexLock> locks;
+  for (not_null<PileUp*> const pile_up : batch) {
+    locks.emplace_back(pile_up->lock_.get());
+  }
+  auto const& shared = batch.front()->shared_fixed_instance_;
+  if (shared == nullptr || shared->pile_ups != batch) {
+    return false;
+  }
+  for (not_null<PileUp*> const pile_up : batch) {
+    if (pile_up->shared_fixed_instance_ != shared) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PileUp::DetachFromBatch() {
+  shared_fixed_instance_ = nullptr;
+}
+
 void PileUp::RecomputeFromParts() {
   absl::MutexLock l(lock_.get());
   mass_ = Mass();
@@ -404,6 +590,7 @@ PileUp::PileUp(
       ephemeris_(ephemeris),
       adaptive_step_parameters_(std::move(adaptive_step_parameters)),
       fixed_step_parameters_(std::move(fixed_step_parameters)),
+      history_parameters_(fixed_step_parameters_),
       trajectory_(std::move(trajectory)),
       angular_momentum_(angular_momentum),
       deletion_callback_(std::move(deletion_callback)) {
@@ -564,6 +751,9 @@ void PileUp::DeformPileUpIfNeeded(Instant const& t) {
 
   // Now update the motions of the parts in the pile-up frame, and keep their
   // orientations with respect to the principal axes in case we warp.
+  RigidTransformation<NonRotatingPileUp, PileUpPrincipalAxes> const
+      to_pile_up_principal_axes =
+          actual_pile_up_motion.rigid_transformation().Inverse();
   actual_part_rigid_motion_.clear();
   rigid_pile_up_.clear();
   for (auto const& [part, apparent_part_rigid_motion] :
@@ -574,8 +764,7 @@ void PileUp::DeformPileUpIfNeeded(Instant const& t) {
     actual_part_rigid_motion_.emplace(part, actual_rigid_motion);
     rigid_pile_up_.emplace(
         part,
-        actual_pile_up_motion.rigid_transformation().Inverse() *
-            actual_rigid_motion.rigid_transformation());
+        to_pile_up_principal_axes * actual_rigid_motion.rigid_transformation());
   }
   apparent_part_rigid_motion_.clear();
 }
@@ -583,31 +772,50 @@ void PileUp::DeformPileUpIfNeeded(Instant const& t) {
 absl::Status PileUp::AdvanceTime(Instant const& t) {
   absl::Status status;
   Instant const history_last = history_->back().time;
-  if (intrinsic_force_ == Vector<Force, Barycentric>{}) {
+  if (intrinsic_force_ == Vector<Force, Barycentric>{} &&
+      (fixed_instance_ != nullptr || shared_fixed_instance_ != nullptr) &&
+      t < history_last + history_parameters_.step()) {
+    // Quiescent fast path: the pile-up was already free-falling during the
+    // previous call, and the history will not get a new point before |t|, so
+    // the existing psychohistory is a valid integration of the same motion.
+    // Extend it instead of reintegrating it from the end of the history.
+    status = ephemeris_->FlowWithAdaptiveStep(
+        &trajectory_,
+        Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+        t,
+        adaptive_step_parameters_);
+    // Only keep the end points of the psychohistory, otherwise it would grow
+    // by at least one point per call until the next history point, and all its
+    // points are copied to the parts at each call.  Over less than a history
+    // step, the Hermite interpolation between the end points is well within
+    // the integration tolerance.
+    auto const last = psychohistory_->back();
+    trajectory_.DeleteSegments(psychohistory_);
+    psychohistory_ = trajectory_.NewSegment();
+    trajectory_.Append(last.time, last.degrees_of_freedom).IgnoreError();
+  } else if (intrinsic_force_ == Vector<Force, Barycentric>{}) {
+    // This pile-up is integrated on its own, it cannot use the instance of its
+    // batch, if any.
+    DetachFromBatch();
     // Remove the fork.
     trajectory_.DeleteSegments(psychohistory_);
     if (fixed_instance_ == nullptr) {
+      SelectHistoryStepIfNeeded();
       fixed_instance_ = ephemeris_->NewInstance(
           {&trajectory_},
           Ephemeris<Barycentric>::NoIntrinsicAccelerations,
-          fixed_step_parameters_);
+          history_parameters_);
     }
     CHECK_LT(history_->back().time, t);
     status = ephemeris_->FlowWithFixedStep(t, *fixed_instance_);
-    psychohistory_ = trajectory_.NewSegment();
-    if (history_->back().time < t) {
-      // Do not clear the |fixed_instance_| here, we will use it for the next
-      // fixed-step integration.
-      status.Update(ephemeris_->FlowWithAdaptiveStep(
-          &trajectory_,
-          Ephemeris<Barycentric>::NoIntrinsicAcceleration,
-          t,
-          adaptive_step_parameters_));
-    }
+    // Do not clear the |fixed_instance_| here, we will use it for the next
+    // fixed-step integration.
+    status.Update(ForkPsychohistory(t));
   } else {
     // Destroy the fixed instance, it wouldn't be correct to use it the next
     // time we go through this function.  It will be re-created as needed.
     fixed_instance_ = nullptr;
+    DetachFromBatch();
     // We make the |psychohistory_|, if any, authoritative, i.e. append it to
     // the end of the |history_|.  We integrate on top of it.  Note how we skip
     // the first point of the psychohistory, which is already present in the
@@ -630,22 +838,104 @@ absl::Status PileUp::AdvanceTime(Instant const& t) {
     psychohistory_ = trajectory_.NewSegment();
   }
 
+  AppendToParts(history_last);
+  return status;
+}
+
+void PileUp::SelectHistoryStepIfNeeded() {
+  bool const has_instance =
+      fixed_instance_ != nullptr || shared_fixed_instance_ != nullptr;
+  auto const& [history_last, degrees_of_freedom] = history_->back();
+  if (has_instance &&
+      (!max_history_step_.has_value() ||
+       history_last < history_step_selection_time_ +
+                          history_steps_between_selections *
+                              history_parameters_.step())) {
+    return;
+  }
+
+  Time step = fixed_step_parameters_.step();
+  if (max_history_step_.has_value()) {
+    // The shortest time to sweep a radian of the osculating orbit around any
+    // body, which happens at the periapsis.  This doesn't vary along a Keplerian
+    // orbit, and it anticipates close approaches to the bodies.
+    Time characteristic_time = Infinity<Time>;
+    for (not_null<MassiveBody const*> const body : ephemeris_->bodies()) {
+      RelativeDegreesOfFreedom<Barycentric> const relative_degrees_of_freedom =
+          degrees_of_freedom -
+          ephemeris_->trajectory(body)->EvaluateDegreesOfFreedom(history_last);
+      Displacement<Barycentric> const& r =
+          relative_degrees_of_freedom.displacement();
+      Velocity<Barycentric> const& v = relative_degrees_of_freedom.velocity();
+      GravitationalParameter const& μ = body->gravitational_parameter();
+      SpecificEnergy const ε = v.Norm²() / 2 - μ / r.Norm();
+      Product<Length, Speed> const h = Wedge(r, v).Norm();
+      if (h == Product<Length, Speed>{}) {
+        // A radial trajectory.
+        characteristic_time = Time{};
+        break;
+      }
+      double const e = Sqrt(std::max(0.0, 1 + 2 * ε * Pow<2>(h / μ)));
+      Length const periapsis_distance = Pow<2>(h) / (μ * (1 + e));
+      characteristic_time =
+          std::min(characteristic_time, Pow<2>(periapsis_distance) / h);
+    }
+    while (2 * step <= *max_history_step_ &&
+           2 * step <= characteristic_time / history_steps_per_radian) {
+      step *= 2;
+    }
+  }
+
+  history_step_selection_time_ = history_last;
+  if (step != history_parameters_.step()) {
+    // The existing instance, if any, integrates with the old step.
+    DetachFromBatch();
+    fixed_instance_ = nullptr;
+    history_parameters_ = Ephemeris<Barycentric>::FixedStepParameters(
+        fixed_step_parameters_.integrator(), step);
+  }
+}
+
+absl::Status PileUp::ForkPsychohistory(Instant const& t) {
+  psychohistory_ = trajectory_.NewSegment();
+  if (history_->back().time < t) {
+    return ephemeris_->FlowWithAdaptiveStep(
+        &trajectory_,
+        Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+        t,
+        adaptive_step_parameters_);
+  }
+  return absl::OkStatus();
+}
+
+void PileUp::AppendToParts(Instant const& history_last) {
   // Append the |history_| to the parts' history and the |psychohistory_| to the
   // parts' psychohistory.  Drop the history of the pile-up, we won't need it
   // anymore.
+  // The degrees of freedom of the parts with respect to the pile-up don't
+  // change during the step, so they are looked up once rather than once per
+  // point.
+  std::vector<DegreesOfFreedom<NonRotatingPileUp>>
+      actual_part_degrees_of_freedom;
+  actual_part_degrees_of_freedom.reserve(parts_.size());
+  for (not_null<Part*> const part : parts_) {
+    actual_part_degrees_of_freedom.push_back(
+        FindOrDie(actual_part_rigid_motion_, part)({RigidPart::origin,
+                                                    RigidPart::unmoving}));
+  }
+
   auto const history_end = history_->end();
   auto const psychohistory_end = psychohistory_->end();
   for (auto it = trajectory_.upper_bound(history_last);
        it != history_end;
        ++it) {
-    AppendToPart<&Part::AppendToHistory>(it);
+    AppendToPart<&Part::AppendToHistory>(it, actual_part_degrees_of_freedom);
   }
   for (auto it = history_end; it != psychohistory_end; ++it) {
-    AppendToPart<&Part::AppendToPsychohistory>(it);
+    AppendToPart<&Part::AppendToPsychohistory>(it,
+                                               actual_part_degrees_of_freedom);
   }
   trajectory_.ForgetBefore(psychohistory_->front().time);
-
-  return status;
 }
 
 void PileUp::NudgeParts() const {
@@ -667,7 +957,10 @@ void PileUp::NudgeParts() const {
 }
 
 template<PileUp::AppendToPartTrajectory append_to_part_trajectory>
-void PileUp::AppendToPart(DiscreteTrajectory<Barycentric>::iterator it) const {
+void PileUp::AppendToPart(
+    DiscreteTrajectory<Barycentric>::iterator const it,
+    std::vector<DegreesOfFreedom<NonRotatingPileUp>> const&
+        actual_part_degrees_of_freedom) const {
   auto const& pile_up_dof = it->degrees_of_freedom;
   RigidMotion<Barycentric, NonRotatingPileUp> const barycentric_to_pile_up(
       RigidTransformation<Barycentric, NonRotatingPileUp>(
@@ -677,13 +970,12 @@ void PileUp::AppendToPart(DiscreteTrajectory<Barycentric>::iterator it) const {
       Barycentric::nonrotating,
       pile_up_dof.velocity());
   auto const pile_up_to_barycentric = barycentric_to_pile_up.Inverse();
+  auto actual_part_degrees_of_freedom_it =
+      actual_part_degrees_of_freedom.begin();
   for (not_null<Part*> const part : parts_) {
-    DegreesOfFreedom<NonRotatingPileUp> const actual_part_degrees_of_freedom =
-        FindOrDie(actual_part_rigid_motion_, part)({RigidPart::origin,
-                                                    RigidPart::unmoving});
     (static_cast<Part*>(part)->*append_to_part_trajectory)(
         it->time,
-        pile_up_to_barycentric(actual_part_degrees_of_freedom));
+        pile_up_to_barycentric(*actual_part_degrees_of_freedom_it++));
   }
 }
 
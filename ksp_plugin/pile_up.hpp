@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
@@ -18,6 +19,7 @@
 #include "integrators/integrators.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/identification.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/discrete_trajectory_segment_iterator.hpp"
@@ -109,6 +111,18 @@ class PileUp {
   Ephemeris<Barycentric>::FixedStepParameters const& fixed_step_parameters()
       const;
 
+  // If |max_history_step| is not null, the step of the fixed-step integration
+  // of the history is selected from the dynamics of the pile-up, between the
+  // step of the |fixed_step_parameters| and |*max_history_step|.  The step is
+  // selected when a fixed-step integration starts, and reselected periodically
+  // during the integration.  Not serialized.  Must not be called concurrently
+  // with any other method of this class.
+  void set_max_history_step(std::optional<Time> const& max_history_step);
+
+  // Returns an estimate of the number of bytes used by the trajectory of this
+  // pile-up.
+  std::int64_t MemoryFootprint() const;
+
   // Set the rigid motion for the given |part|.  This rigid motion is *apparent*
   // in the sense that it was reported by the game but we know better since we
   // are doing science.
@@ -122,6 +136,33 @@ class PileUp {
   // not concurrently with any other method of this class.
   absl::Status DeformAndAdvanceTime(Instant const& t);
 
+  // Partitions the |pile_ups| that are about to be advanced to |t| into
+  // batches.  The pile-ups of a batch integrate their histories with a single
+  // shared fixed-step instance, so that the gravitational accelerations on all
+  // of them are computed together, and in particular the positions of the
+  // massive bodies are evaluated once per step for the whole batch.  A batch
+  // is made of the free-falling pile-ups whose histories end at the same time
+  // and are going to be extended by at least one step; all other pile-ups are
+  // in batches of one.  The instances are kept across calls as long as the
+  // batches don't change.  Must not be called concurrently with any other
+  // method of the pile-ups.
+  static std::vector<std::vector<not_null<PileUp*>>> Batch(
+      std::list<PileUp*> const& pile_ups,
+      Instant const& t);
+
+  // Same as calling |DeformAndAdvanceTime| on each of the |pile_ups|, which
+  // must be a batch returned by |Batch| for the same |t|.  Returns the status
+  // of each pile-up.
+  static std::vector<absl::Status> DeformAndAdvanceTime(
+      std::vector<not_null<PileUp*>> const& pile_ups,
+      Instant const& t);
+
+  // Stops sharing a fixed-step instance with other pile-ups.  The other
+  // pile-ups of the batch stop sharing it too.  Takes the locks of all the
+  // pile-ups of the batch; the membership of the batches only changes on the
+  // main thread, through this function and |Batch|.
+  void LeaveBatch();
+
   // Recomputes the state of motion of the pile-up based on that of its parts.
   void RecomputeFromParts();
 
@@ -161,6 +202,11 @@ class PileUp {
       not_null<Ephemeris<Barycentric>*> ephemeris,
       std::function<void()> deletion_callback);
 
+  // Sets |history_parameters_| if there is no fixed-step instance or if it is
+  // time to reselect the step, in which case the existing instance is dropped
+  // if the step changes.
+  void SelectHistoryStepIfNeeded();
+
   // Sets |euler_solver_| and updates |rigid_pile_up_|.
   void MakeEulerSolver(InertiaTensor<NonRotatingPileUp> const& inertia_tensor,
                        Instant const& t);
@@ -179,14 +225,37 @@ class PileUp {
   // and of its parts have a (possibly ahistorical) final point exactly at |t|.
   absl::Status AdvanceTime(Instant const& t);
 
+  // Forks the |psychohistory_| at the end of the |history_| and integrates it
+  // up to |t| with an adaptive step.
+  absl::Status ForkPsychohistory(Instant const& t);
+
+  // Appends to the histories of the parts the points of the |history_| after
+  // |history_last|, and to their psychohistories the points of the
+  // |psychohistory_|.
+  void AppendToParts(Instant const& history_last);
+
   // Adjusts the degrees of freedom of all parts in this pile up based on the
   // degrees of freedom of the pile-up computed by |AdvanceTime| and on the
   // |NonRotatingPileUp| degrees of freedom of the parts, as set by
   // |DeformPileUpIfNeeded|.
   void NudgeParts() const;
 
+  // True iff all the pile-ups of |batch| still share the instance created for
+  // that batch.
+  static bool IsCurrentBatch(std::vector<not_null<PileUp*>> const& batch);
+
+  // Drops the reference of this pile-up to the instance of its batch, if any,
+  // e.g., when it is integrated on its own.  Doesn't touch the other pile-ups
+  // of the batch, which |Batch| dissolves on the main thread.  |lock_| must be
+  // held.
+  void DetachFromBatch();
+
+  // Appends the point at |it| to the trajectories of all the parts, given
+  // their |actual_part_degrees_of_freedom|, in the order of |parts_|.
   template<AppendToPartTrajectory append_to_part_trajectory>
-  void AppendToPart(DiscreteTrajectory<Barycentric>::iterator it) const;
+  void AppendToPart(DiscreteTrajectory<Barycentric>::iterator it,
+                    std::vector<DegreesOfFreedom<NonRotatingPileUp>> const&
+                        actual_part_degrees_of_freedom) const;
 
   // Wrapped in a |unique_ptr| to be moveable.
   not_null<std::unique_ptr<absl::Mutex>> lock_;
@@ -196,7 +265,17 @@ class PileUp {
   Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters_;
   Ephemeris<Barycentric>::FixedStepParameters fixed_step_parameters_;
 
-  // Recomputed by the parts subset on every change.  Not serialized.
+  // The parameters actually used for the fixed-step integration of the
+  // history.  Their step is that of |fixed_step_parameters_| unless
+  // |max_history_step_| is set.  Not serialized.
+  std::optional<Time> max_history_step_;
+  Ephemeris<Barycentric>::FixedStepParameters history_parameters_;
+  Instant history_step_selection_time_ = InfinitePast;
+
+  // Recomputed by the parts subset on every change.  Not serialized.  The
+  // forces and torques of all the parts are summed once per frame, and the
+  // resulting acceleration is constant over the integration of the frame, so
+  // the cost of a burn doesn't depend on the number of engines.
   Mass mass_;
   Vector<Force, Barycentric> intrinsic_force_;
   Bivector<Torque, NonRotatingPileUp> intrinsic_torque_;
@@ -237,6 +316,21 @@ class PileUp {
       Ephemeris<Barycentric>::NewtonianMotionEquation>::Instance>
       fixed_instance_;
 
+  // The state shared by the pile-ups of a batch.  The |instance| integrates the
+  // trajectories of the |pile_ups|, in that order.  It is created on the first
+  // integration of the batch.
+  struct SharedFixedInstance {
+    std::vector<not_null<PileUp*>> pile_ups;
+    std::unique_ptr<typename Integrator<
+        Ephemeris<Barycentric>::NewtonianMotionEquation>::Instance>
+        instance;
+  };
+
+  // Non-null if this pile-up belongs to a batch of more than one pile-up, in
+  // which case |fixed_instance_| is null.  A pile-up may drop this reference
+  // while its batch is not yet dissolved, see |DetachFromBatch|.
+  std::shared_ptr<SharedFixedInstance> shared_fixed_instance_;
+
   PartTo<RigidMotion<RigidPart, NonRotatingPileUp>> actual_part_rigid_motion_;
   PartTo<RigidMotion<RigidPart, Apparent>> apparent_part_rigid_motion_;
 
@@ -5,7 +5,10 @@
 #include <utility>
 #include <vector>
 
+#include "base/tracing.hpp"
+#include "geometry/barycentre_calculator.hpp"
 #include "geometry/sign.hpp"
+#include "physics/discrete_trajectory_segment.hpp"
 #include "physics/massive_body.hpp"
 #include "physics/similar_motion.hpp"
 #include "quantities/elementary_functions.hpp"
@@ -16,7 +19,10 @@ namespace ksp_plugin {
 namespace _planetarium {
 namespace internal {
 
+using namespace principia::base::_tracing;
+using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_sign;
+using namespace principia::physics::_discrete_trajectory_segment;
 using namespace principia::physics::_massive_body;
 using namespace principia::physics::_similar_motion;
 using namespace principia::quantities::_elementary_functions;
@@ -24,6 +30,10 @@ using namespace principia::quantities::_named_quantities;
 
 namespace {
 constexpr int max_plot_method_2_steps = 10'000;
+// The bounding spheres of the interpolation between consecutive points of a
+// discrete trajectory are computed in the plotting frame, ignoring its motion
+// between the points.  They are enlarged by this factor to remain conservative.
+constexpr double bounding_sphere_margin = 1.5;
 }  // namespace
 
 Planetarium::Parameters::Parameters(double const sphere_radius_multiplier,
@@ -39,12 +49,33 @@ Planetarium::Planetarium(
     Perspective<Navigation, Camera> perspective,
     not_null<Ephemeris<Barycentric> const*> const ephemeris,
     not_null<PlottingFrame const*> const plotting_frame,
-    PlottingToScaledSpaceConversion plotting_to_scaled_space)
+    PlottingToScaledSpaceConversion plotting_to_scaled_space,
+    SampleCache* const sample_cache,
+    PlottingFrameMotions const* const plotting_frame_motions)
     : parameters_(parameters),
       perspective_(std::move(perspective)),
       ephemeris_(ephemeris),
       plotting_frame_(plotting_frame),
-      plotting_to_scaled_space_(std::move(plotting_to_scaled_space)) {}
+      plotting_to_scaled_space_(std::move(plotting_to_scaled_space)),
+      sample_cache_(sample_cache),
+      plotting_frame_motions_(plotting_frame_motions) {
+  if (plotting_frame_motions_ != nullptr) {
+    CHECK_EQ(plotting_frame_motions_->plotting_frame(), plotting_frame_);
+  }
+  if (sample_cache_ != nullptr) {
+    absl::MutexLock l(&sample_cache_->lock_);
+    std::int64_t const generation = ++sample_cache_->generation_;
+    auto& entries = sample_cache_->entries_;
+    for (auto it = entries.begin(); it != entries.end();) {
+      if (generation - it->second.generation >
+          SampleCache::max_unused_generations) {
+        entries.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
 
 RP2Lines<Length, Camera> Planetarium::PlotMethod0(
     DiscreteTrajectory<Barycentric> const& trajectory,
@@ -52,6 +83,7 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod0(
     DiscreteTrajectory<Barycentric>::iterator const end,
     Instant const& now,
     bool const /*reverse*/) const {
+  TracingScope tracing_scope("Planetarium::PlotMethod0");
   auto const plottable_begin = trajectory.lower_bound(plotting_frame_->t_min());
   auto const plottable_end = trajectory.lower_bound(plotting_frame_->t_max());
   auto const plottable_spheres = ComputePlottableSpheres(now);
@@ -101,6 +133,7 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod1(
     DiscreteTrajectory<Barycentric>::iterator const end,
     Instant const& now,
     bool const reverse) const {
+  TracingScope tracing_scope("Planetarium::PlotMethod1");
   Length const focal_plane_tolerance =
       perspective_.focal() * parameters_.tan_angular_resolution_;
   auto const focal_plane_tolerance² =
@@ -156,6 +189,7 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
     Instant const& now,
     bool const reverse,
     Length* const minimal_distance) const {
+  TracingScope tracing_scope("Planetarium::PlotMethod2");
   RP2Lines<Length, Camera> lines;
   auto const plottable_spheres = ComputePlottableSpheres(now);
   double const tan²_angular_resolution =
@@ -171,11 +205,26 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
   if (direction * (final_time - previous_time) <= Time{}) {
     return lines;
   }
+  // The times at which we evaluate are close to one another, so for a discrete
+  // trajectory we use a hint to avoid searching the entire timeline each time.
+  auto const* const discrete_trajectory =
+      dynamic_cast<DiscreteTrajectory<Barycentric> const*>(&trajectory);
+  DiscreteTrajectory<Barycentric>::iterator hint;
+  if (discrete_trajectory != nullptr) {
+    hint = discrete_trajectory->begin();
+  }
+  auto const evaluate_degrees_of_freedom = [discrete_trajectory,
+                                            &hint,
+                                            &trajectory](Instant const& t) {
+    return discrete_trajectory == nullptr
+               ? trajectory.EvaluateDegreesOfFreedom(t)
+               : discrete_trajectory->EvaluateDegreesOfFreedom(t, hint);
+  };
+
   SimilarMotion<Barycentric, Navigation> to_plotting_frame_at_t =
-      plotting_frame_->ToThisFrameAtTimeSimilarly(previous_time);
+      ToPlottingFrameAtTime(previous_time);
   DegreesOfFreedom<Navigation> const initial_degrees_of_freedom =
-      to_plotting_frame_at_t(
-          trajectory.EvaluateDegreesOfFreedom(previous_time));
+      to_plotting_frame_at_t(evaluate_degrees_of_freedom(previous_time));
   Position<Navigation> previous_position =
       initial_degrees_of_freedom.position();
   Velocity<Navigation> previous_velocity =
@@ -191,6 +240,30 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
 
   std::optional<Position<Navigation>> last_endpoint;
 
+  // When the last step is invisible, the parts of a discrete trajectory that
+  // are certainly invisible are skipped without being evaluated.  The next
+  // visible segment starts a new line.
+  auto const skip_invisible_intervals = [&]() {
+    if (discrete_trajectory == nullptr) {
+      return;
+    }
+    Instant const end_of_invisible_interval =
+        EndOfInvisibleInterval(*discrete_trajectory,
+                               plottable_spheres,
+                               previous_time,
+                               final_time,
+                               reverse);
+    if (end_of_invisible_interval == previous_time) {
+      return;
+    }
+    previous_time = end_of_invisible_interval;
+    to_plotting_frame_at_t = ToPlottingFrameAtTime(previous_time);
+    DegreesOfFreedom<Navigation> const degrees_of_freedom =
+        to_plotting_frame_at_t(evaluate_degrees_of_freedom(previous_time));
+    previous_position = degrees_of_freedom.position();
+    previous_velocity = degrees_of_freedom.velocity();
+  };
+
   int steps_accepted = 0;
 
   goto estimate_tan²_error;
@@ -211,9 +284,10 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
       }
       Position<Navigation> const extrapolated_position =
           previous_position + previous_velocity * Δt;
-      to_plotting_frame_at_t = plotting_frame_->ToThisFrameAtTimeSimilarly(t);
-      degrees_of_freedom_in_barycentric =
-          trajectory.EvaluateDegreesOfFreedom(t);
+      to_plotting_frame_at_t =
+          t == final_time ? ToPlottingFrameAtTime(t)
+                          : plotting_frame_->ToThisFrameAtTimeSimilarly(t);
+      degrees_of_freedom_in_barycentric = evaluate_degrees_of_freedom(t);
       position = to_plotting_frame_at_t.similarity()(
                      degrees_of_freedom_in_barycentric->position());
 
@@ -228,9 +302,9 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
     ++steps_accepted;
 
     // TODO(egg): also limit to field of view.
+    Segment<Navigation> const step(previous_position, position);
     auto const segment_behind_focal_plane =
-        perspective_.SegmentBehindFocalPlane(
-            Segment<Navigation>(previous_position, position));
+        perspective_.SegmentBehindFocalPlane(step);
 
     previous_time = t;
     previous_position = position;
@@ -238,6 +312,7 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
         to_plotting_frame_at_t(*degrees_of_freedom_in_barycentric).velocity();
 
     if (!segment_behind_focal_plane) {
+      skip_invisible_intervals();
       continue;
     }
 
@@ -258,6 +333,14 @@ RP2Lines<Length, Camera> Planetarium::PlotMethod2(
       lines.back().push_back(perspective_(segment.second));
       last_endpoint = segment.second;
     }
+    if (visible_segments.empty() ||
+        perspective_.IsOutsideFieldOfView(
+            Sphere<Navigation>(
+                Barycentre<Position<Navigation>, double>(step, {1, 1}),
+                0.5 * (step.second - step.first).Norm()),
+            parameters_.tan_field_of_view_)) {
+      skip_invisible_intervals();
+    }
   }
   if (minimal_distance != nullptr) {
     *minimal_distance = Sqrt(minimal_squared_distance);
@@ -283,10 +366,184 @@ void Planetarium::PlotMethod3(
       trajectory, begin_time, last_time, now, reverse, add_point, max_points);
 }
 
+int Planetarium::PlotMethod3(
+    Trajectory<Barycentric> const& trajectory,
+    DiscreteTrajectory<Barycentric>::iterator const begin,
+    DiscreteTrajectory<Barycentric>::iterator const end,
+    Instant const& now,
+    bool const reverse,
+    ScaledSpacePoint* const vertices,
+    int const max_points,
+    bool const cache_samples) const {
+  TracingScope tracing_scope("Planetarium::PlotMethod3");
+  if (begin == end) {
+    return 0;
+  }
+  auto last = std::prev(end);
+  auto const begin_time = std::max(begin->time, plotting_frame_->t_min());
+  auto const last_time = std::min(last->time, plotting_frame_->t_max());
+  return PlotMethod3(trajectory,
+                     begin_time,
+                     last_time,
+                     now,
+                     reverse,
+                     vertices,
+                     max_points,
+                     /*minimal_distance=*/nullptr,
+                     cache_samples);
+}
+
+void Planetarium::DropChangedSamples(
+    Trajectory<Barycentric> const& trajectory,
+    SampleCache::Points& points,
+    SampleCache::Samples& samples) {
+  DiscreteTrajectory<Barycentric>::iterator begin;
+  DiscreteTrajectory<Barycentric>::iterator end;
+  if (auto const* const discrete_trajectory =
+          dynamic_cast<DiscreteTrajectory<Barycentric> const*>(&trajectory);
+      discrete_trajectory != nullptr) {
+    begin = discrete_trajectory->begin();
+    end = discrete_trajectory->end();
+  } else if (auto const* const discrete_trajectory_segment =
+                 dynamic_cast<DiscreteTrajectorySegment<Barycentric> const*>(
+                     &trajectory);
+             discrete_trajectory_segment != nullptr) {
+    begin = discrete_trajectory_segment->begin();
+    end = discrete_trajectory_segment->end();
+  } else {
+    return;
+  }
+
+  // Typically the trajectory has lost points at its beginning and gained
+  // points at its end.  Find the common part, starting at the first point of
+  // the trajectory.
+  Instant const first_time = begin == end ? Instant() : begin->time;
+  auto it = begin;
+  auto points_it = std::lower_bound(
+      points.begin(), points.end(), first_time,
+      [](auto const& point, Instant const& t) { return point.first < t; });
+  std::optional<Instant> last_common_time;
+  for (; it != end && points_it != points.end() &&
+         it->time == points_it->first &&
+         it->degrees_of_freedom == points_it->second;
+       ++it, ++points_it) {
+    last_common_time = it->time;
+  }
+
+  // The trajectory is interpolated between consecutive points, so a sample is
+  // valid if it is not after the last common point.  The samples before the
+  // first point of the trajectory are dropped later if they are not in the
+  // plotted interval.
+  if (last_common_time.has_value()) {
+    samples.erase(samples.upper_bound(*last_common_time), samples.end());
+  } else {
+    samples.clear();
+  }
+
+  points.clear();
+  for (it = begin; it != end; ++it) {
+    points.emplace_back(it->time, it->degrees_of_freedom);
+  }
+}
+
+Instant Planetarium::EndOfInvisibleInterval(
+    DiscreteTrajectory<Barycentric> const& trajectory,
+    std::vector<Sphere<Navigation>> const& plottable_spheres,
+    Instant const& t,
+    Instant const& final_time,
+    bool const reverse) const {
+  auto const to_navigation = [this](auto const& point) {
+    return ToPlottingFrameAtTime(point.time)(point.degrees_of_freedom);
+  };
+  // The cubic Hermite interpolation between two points lies in the convex hull
+  // of its Bézier control points, so a sphere that contains these points
+  // bounds it.
+  auto const is_invisible = [this, &plottable_spheres](
+                                Instant const& t1,
+                                DegreesOfFreedom<Navigation> const& dof1,
+                                Instant const& t2,
+                                DegreesOfFreedom<Navigation> const& dof2) {
+    Time const Δt = t2 - t1;
+    Position<Navigation> const centre =
+        Barycentre<Position<Navigation>, double>(
+            {dof1.position(), dof2.position()}, {1, 1});
+    Length const radius =
+        bounding_sphere_margin *
+        std::max({(dof1.position() - centre).Norm(),
+                  (dof1.position() + dof1.velocity() * Δt / 3 - centre).Norm(),
+                  (dof2.position() - dof2.velocity() * Δt / 3 - centre).Norm()});
+    Sphere<Navigation> const bounding_sphere(centre, radius);
+    if (perspective_.IsOutsideFieldOfView(bounding_sphere,
+                                          parameters_.tan_field_of_view_)) {
+      return true;
+    }
+    for (auto const& plottable_sphere : plottable_spheres) {
+      if (perspective_.IsHiddenBySphere(bounding_sphere, plottable_sphere)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  Instant end_of_invisible_interval = t;
+  if (reverse) {
+    // The interval [it1->time, it2->time] contains |t|.
+    auto it2 = trajectory.lower_bound(t);
+    if (it2 == trajectory.begin() || it2 == trajectory.end()) {
+      return t;
+    }
+    auto it1 = std::prev(it2);
+    DegreesOfFreedom<Navigation> dof2 = to_navigation(*it2);
+    for (;;) {
+      DegreesOfFreedom<Navigation> const dof1 = to_navigation(*it1);
+      if (!is_invisible(it1->time, dof1, it2->time, dof2)) {
+        break;
+      }
+      if (it1->time <= final_time) {
+        return final_time;
+      }
+      end_of_invisible_interval = it1->time;
+      if (it1 == trajectory.begin()) {
+        break;
+      }
+      it2 = it1;
+      --it1;
+      dof2 = dof1;
+    }
+  } else {
+    // The interval [it1->time, it2->time] contains |t|.
+    auto it2 = trajectory.upper_bound(t);
+    if (it2 == trajectory.begin() || it2 == trajectory.end()) {
+      return t;
+    }
+    auto it1 = std::prev(it2);
+    DegreesOfFreedom<Navigation> dof1 = to_navigation(*it1);
+    for (; it2 != trajectory.end(); it1 = it2, ++it2) {
+      DegreesOfFreedom<Navigation> const dof2 = to_navigation(*it2);
+      if (!is_invisible(it1->time, dof1, it2->time, dof2)) {
+        break;
+      }
+      if (it2->time >= final_time) {
+        return final_time;
+      }
+      end_of_invisible_interval = it2->time;
+      dof1 = dof2;
+    }
+  }
+  return end_of_invisible_interval;
+}
+
+SimilarMotion<Barycentric, Navigation> Planetarium::ToPlottingFrameAtTime(
+    Instant const& t) const {
+  return plotting_frame_motions_ == nullptr
+             ? plotting_frame_->ToThisFrameAtTimeSimilarly(t)
+             : plotting_frame_motions_->ToPlottingFrameAtTime(t);
+}
+
 std::vector<Sphere<Navigation>> Planetarium::ComputePlottableSpheres(
     Instant const& now) const {
   SimilarMotion<Barycentric, Navigation> const similar_motion_at_now =
-      plotting_frame_->ToThisFrameAtTimeSimilarly(now);
+      ToPlottingFrameAtTime(now);
   std::vector<Sphere<Navigation>> plottable_spheres;
 
   auto const& bodies = ephemeris_->bodies();
@@ -312,14 +569,14 @@ Segments<Navigation> Planetarium::ComputePlottableSegments(
     const std::vector<Sphere<Navigation>>& plottable_spheres,
     DiscreteTrajectory<Barycentric>::iterator const begin,
     DiscreteTrajectory<Barycentric>::iterator const end) const {
-  Segments<Navigation> all_segments;
+  Segments<Navigation> segments_behind_focal_plane;
   if (begin == end) {
-    return all_segments;
+    return segments_behind_focal_plane;
   }
   auto it1 = begin;
   Instant t1 = it1->time;
   SimilarMotion<Barycentric, Navigation> similar_motion_at_t1 =
-      plotting_frame_->ToThisFrameAtTimeSimilarly(t1);
+      ToPlottingFrameAtTime(t1);
   Position<Navigation> p1 =
       similar_motion_at_t1(it1->degrees_of_freedom).position();
 
@@ -330,7 +587,7 @@ Segments<Navigation> Planetarium::ComputePlottableSegments(
 
     // Transform the degrees of freedom to the plotting frame.
     SimilarMotion<Barycentric, Navigation> const similar_motion_at_t2 =
-        plotting_frame_->ToThisFrameAtTimeSimilarly(t2);
+        ToPlottingFrameAtTime(t2);
     Position<Navigation> const p2 =
         similar_motion_at_t2(it2->degrees_of_freedom).position();
 
@@ -340,13 +597,7 @@ Segments<Navigation> Planetarium::ComputePlottableSegments(
     auto const segment_behind_focal_plane =
         perspective_.SegmentBehindFocalPlane(segment);
     if (segment_behind_focal_plane) {
-      // Find the part(s) of the segment that are not hidden by spheres.  These
-      // are the ones we want to plot.
-      auto segments = perspective_.VisibleSegments(*segment_behind_focal_plane,
-                                                   plottable_spheres);
-      std::move(segments.begin(),
-                segments.end(),
-                std::back_inserter(all_segments));
+      segments_behind_focal_plane.push_back(*segment_behind_focal_plane);
     }
 
     it1 = it2;
@@ -355,7 +606,12 @@ Segments<Navigation> Planetarium::ComputePlottableSegments(
     p1 = p2;
   }
 
-  return all_segments;
+  // Find the part(s) of the segments that are not hidden by spheres.  These
+  // are the ones we want to plot.  The segments are processed in a batch so
+  // that the spheres that are far from a part of the trajectory are culled
+  // once for all its segments.
+  return perspective_.VisibleSegments(segments_behind_focal_plane,
+                                      plottable_spheres);
 }
 
 }  // namespace internal
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <utility>
 #include <vector>
 
+#include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/orthogonal_map.hpp"
@@ -11,10 +16,13 @@
 #include "geometry/space.hpp"
 #include "geometry/sphere.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
+#include "ksp_plugin/plotting_frame_motions.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/rigid_motion.hpp"
+#include "physics/similar_motion.hpp"
 #include "physics/trajectory.hpp"
 #include "quantities/quantities.hpp"
 
@@ -32,10 +40,12 @@ using namespace principia::geometry::_rp2_point;
 using namespace principia::geometry::_space;
 using namespace principia::geometry::_sphere;
 using namespace principia::ksp_plugin::_frames;
+using namespace principia::ksp_plugin::_plotting_frame_motions;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_rigid_motion;
+using namespace principia::physics::_similar_motion;
 using namespace principia::physics::_trajectory;
 using namespace principia::quantities::_quantities;
 
@@ -75,16 +85,71 @@ class Planetarium {
     friend class Planetarium;
   };
 
+  // The degrees of freedom in the plotting frame of the points evaluated by
+  // the previous plots of some trajectories.  The cache outlives the
+  // planetariums, which are typically constructed for each frame, so that a
+  // trajectory that doesn't change, e.g., that of a celestial, needs not be
+  // evaluated again when only the camera or the plotted interval change.
+  // Since the samples are kept across zoom levels, a plot at a coarse
+  // resolution picks a subset of the samples of a plot at a finer one.  The
+  // samples are only valid for a specific plotting frame: the client must use
+  // a new cache when the plotting frame changes.  For a discrete trajectory in
+  // |Barycentric|, e.g., a prediction, the cache also records the points of the
+  // trajectory, and the samples that depend on points that have changed are
+  // dropped, so that only the new parts of the trajectory are evaluated.  This
+  // class is thread-safe, but a trajectory must not be plotted concurrently in
+  // the same direction.
+  class SampleCache final {
+   public:
+    SampleCache() = default;
+
+   private:
+    // Bounds the memory used by the cache.
+    static constexpr int max_samples_per_trajectory = 10'000;
+    // The entries that were not used by the last planetariums are dropped,
+    // since their trajectories may have been destroyed.
+    static constexpr std::int64_t max_unused_generations = 100;
+
+    using Samples = absl::btree_map<Instant, DegreesOfFreedom<Navigation>>;
+    using Points =
+        std::vector<std::pair<Instant, DegreesOfFreedom<Barycentric>>>;
+    // The past and the future of a trajectory are typically plotted in
+    // opposite directions over disjoint intervals, so they are cached
+    // separately.
+    using Key = std::pair<void const*, /*reverse=*/bool>;
+
+    struct Entry {
+      Samples samples;
+      // The points of the discrete trajectory from which the |samples| were
+      // computed, empty for other trajectories.
+      Points points;
+      // The |generation_| of the last planetarium that used this entry.
+      std::int64_t generation;
+    };
+
+    absl::Mutex lock_;
+    // Incremented each time a planetarium is constructed with this cache.
+    std::int64_t generation_ GUARDED_BY(lock_) = 0;
+    absl::flat_hash_map<Key, Entry> entries_ GUARDED_BY(lock_);
+    friend class Planetarium;
+  };
+
   using PlottingToScaledSpaceConversion =
       std::function<ScaledSpacePoint(Position<Navigation> const&)>;
 
   // TODO(phl): All this Navigation is weird.  Should it be named Plotting?
   // In particular Navigation vs. NavigationFrame is a mess.
+  // If |sample_cache| is not null, it must have been used with the same
+  // |plotting_frame| only, and it must outlive this object.  Similarly, if
+  // |plotting_frame_motions| is not null, it must cache the motions of
+  // |plotting_frame| and it must outlive this object.
   Planetarium(Parameters const& parameters,
               Perspective<Navigation, Camera> perspective,
               not_null<Ephemeris<Barycentric> const*> ephemeris,
               not_null<PlottingFrame const*> plotting_frame,
-              PlottingToScaledSpaceConversion plotting_to_scaled_space);
+              PlottingToScaledSpaceConversion plotting_to_scaled_space,
+              SampleCache* sample_cache = nullptr,
+              PlottingFrameMotions const* plotting_frame_motions = nullptr);
 
   // A no-op method that just returns all the points in the trajectory defined
   // by |begin| and |end|.
@@ -114,7 +179,10 @@ class Planetarium {
       Instant const& now,
       bool reverse) const;
 
-  // The same method, operating on the |Trajectory| interface.
+  // The same method, operating on the |Trajectory| interface.  For a discrete
+  // trajectory, the parts that are certainly outside of the field of view or
+  // hidden by a celestial are skipped without being sampled, and they don't
+  // contribute to the |minimal_distance|.
   RP2Lines<Length, Camera> PlotMethod2(
       Trajectory<Barycentric> const& trajectory,
       Instant const& first_time,
@@ -134,8 +202,29 @@ class Planetarium {
       std::function<void(ScaledSpacePoint const&)> const& add_point,
       int max_points) const;
 
+  // The same method, writing the points to the array of size |max_points| at
+  // |vertices|, the layout of which matches the vertex buffers of the adapter.
+  // Returns the number of points written.  This avoids a call through a
+  // |std::function| for each point.  See below for |cache_samples|.
+  int PlotMethod3(
+      Trajectory<Barycentric> const& trajectory,
+      DiscreteTrajectory<Barycentric>::iterator begin,
+      DiscreteTrajectory<Barycentric>::iterator end,
+      Instant const& now,
+      bool reverse,
+      ScaledSpacePoint* vertices,
+      int max_points,
+      bool cache_samples = false) const;
+
   // The same method, operating on the |Trajectory| interface for any frame that
-  // can be converted to |Navigation|.
+  // can be converted to |Navigation|.  If |cache_samples| is true and this
+  // object has a sample cache, the points of the plot are taken from the
+  // samples of the previous plots of the same |trajectory| when they are close
+  // enough to the desired points, and the points evaluated by this plot are
+  // added to the samples.  The perspective is still used to check the error of
+  // each segment.  This is only correct if the |trajectory| never changes,
+  // unless it is a discrete trajectory in |Barycentric|, in which case the
+  // samples that depend on points that have changed are not used.
   template<typename Frame>
   void PlotMethod3(
       Trajectory<Frame> const& trajectory,
@@ -145,9 +234,67 @@ class Planetarium {
       bool reverse,
       std::function<void(ScaledSpacePoint const&)> const& add_point,
       int max_points,
-      Length* minimal_distance = nullptr) const;
+      Length* minimal_distance = nullptr,
+      bool cache_samples = false) const;
+
+  // The same method, writing the points to the array of size |max_points| at
+  // |vertices| and returning the number of points written.
+  template<typename Frame>
+  int PlotMethod3(
+      Trajectory<Frame> const& trajectory,
+      Instant const& first_time,
+      Instant const& last_time,
+      Instant const& now,
+      bool reverse,
+      ScaledSpacePoint* vertices,
+      int max_points,
+      Length* minimal_distance = nullptr,
+      bool cache_samples = false) const;
 
  private:
+  // The implementation of |PlotMethod3|, which calls |add_point| for each
+  // point of the plot.
+  template<typename Frame, typename AddPoint>
+  void GenericPlotMethod3(
+      Trajectory<Frame> const& trajectory,
+      Instant const& first_time,
+      Instant const& last_time,
+      Instant const& now,
+      bool reverse,
+      AddPoint const& add_point,
+      int max_points,
+      Length* minimal_distance,
+      bool cache_samples) const;
+
+  // If |trajectory| is a discrete trajectory, removes from |samples| those that
+  // depend on points of the |trajectory| that are not in |points|, and sets
+  // |points| to the points of the |trajectory|.  Otherwise, does nothing.
+  static void DropChangedSamples(Trajectory<Barycentric> const& trajectory,
+                                 SampleCache::Points& points,
+                                 SampleCache::Samples& samples);
+
+  // Returns the time, in the direction of the plot and not beyond
+  // |final_time|, up to which the |trajectory| starting at |t| is certainly
+  // invisible, i.e., outside of the field of view or hidden by one of the
+  // |plottable_spheres|.  The visibility is determined for the intervals
+  // between consecutive points of the |trajectory| using bounding spheres, so
+  // the |trajectory| is not evaluated at intermediate times.  Returns |t| if
+  // the interval that contains |t| may be visible.
+  Instant EndOfInvisibleInterval(
+      DiscreteTrajectory<Barycentric> const& trajectory,
+      std::vector<Sphere<Navigation>> const& plottable_spheres,
+      Instant const& t,
+      Instant const& final_time,
+      bool reverse) const;
+
+  // Returns the motion of the plotting frame at |t|, taken from the
+  // |plotting_frame_motions_| if there are any.  This should only be used for
+  // instants that are likely to be plotted again, e.g., the points of discrete
+  // trajectories or the ends of the plots, not for the intermediate instants
+  // chosen by the adaptive methods, which would clutter the cache.
+  SimilarMotion<Barycentric, Navigation> ToPlottingFrameAtTime(
+      Instant const& t) const;
+
   // Computes the coordinates of the spheres that represent the |ephemeris_|
   // bodies.  These coordinates are in the |plotting_frame_| at time |now|.
   std::vector<Sphere<Navigation>> ComputePlottableSpheres(
@@ -165,6 +312,8 @@ class Planetarium {
   not_null<Ephemeris<Barycentric> const*> const ephemeris_;
   not_null<PlottingFrame const*> const plotting_frame_;
   PlottingToScaledSpaceConversion plotting_to_scaled_space_;
+  SampleCache* const sample_cache_;
+  PlottingFrameMotions const* const plotting_frame_motions_;
 };
 
 inline ScaledSpacePoint ScaledSpacePoint::FromCoordinates(
@@ -3,6 +3,9 @@
 #include "ksp_plugin/planetarium.hpp"
 
 #include <algorithm>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 #include "geometry/sign.hpp"
 #include "physics/similar_motion.hpp"
@@ -19,30 +22,22 @@ using namespace principia::physics::_similar_motion;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
 
-// A helper function that converts a trajectory expressed in |Frame| into one
-// expressed in |Navigation|, using the given |plotting_frame| if needed for the
-// transformation.
-template<typename Frame>
+// Helper functions that convert a trajectory expressed in |Barycentric| or
+// |Navigation| into one expressed in |Navigation|, using the given
+// |to_plotting_frame_at_time| if needed for the transformation.
+template<typename ToPlottingFrameAtTime>
 DegreesOfFreedom<Navigation> EvaluateDegreesOfFreedomInNavigation(
-    PlottingFrame const& plotting_frame,
-    Trajectory<Frame> const& trajectory,
-    Instant const& t);
-
-template<>
-inline DegreesOfFreedom<Navigation>
-EvaluateDegreesOfFreedomInNavigation<Barycentric>(
-    PlottingFrame const& plotting_frame,
+    ToPlottingFrameAtTime const& to_plotting_frame_at_time,
     Trajectory<Barycentric> const& trajectory,
     Instant const& t) {
   SimilarMotion<Barycentric, Navigation> to_plotting_frame_at_t =
-      plotting_frame.ToThisFrameAtTimeSimilarly(t);
+      to_plotting_frame_at_time(t);
   return to_plotting_frame_at_t(trajectory.EvaluateDegreesOfFreedom(t));
 }
 
-template<>
-inline DegreesOfFreedom<Navigation>
-EvaluateDegreesOfFreedomInNavigation<Navigation>(
-    PlottingFrame const& plotting_frame,
+template<typename ToPlottingFrameAtTime>
+DegreesOfFreedom<Navigation> EvaluateDegreesOfFreedomInNavigation(
+    ToPlottingFrameAtTime const& to_plotting_frame_at_time,
     Trajectory<Navigation> const& trajectory,
     Instant const& t) {
   return trajectory.EvaluateDegreesOfFreedom(t);
@@ -57,7 +52,57 @@ void Planetarium::PlotMethod3(
     bool const reverse,
     std::function<void(ScaledSpacePoint const&)> const& add_point,
     int const max_points,
-    Length* const minimal_distance) const {
+    Length* const minimal_distance,
+    bool const cache_samples) const {
+  GenericPlotMethod3(trajectory,
+                     first_time,
+                     last_time,
+                     now,
+                     reverse,
+                     add_point,
+                     max_points,
+                     minimal_distance,
+                     cache_samples);
+}
+
+template<typename Frame>
+int Planetarium::PlotMethod3(
+    Trajectory<Frame> const& trajectory,
+    Instant const& first_time,
+    Instant const& last_time,
+    Instant const& now,
+    bool const reverse,
+    ScaledSpacePoint* const vertices,
+    int const max_points,
+    Length* const minimal_distance,
+    bool const cache_samples) const {
+  int vertex_count = 0;
+  GenericPlotMethod3(
+      trajectory,
+      first_time,
+      last_time,
+      now,
+      reverse,
+      [vertices, &vertex_count](ScaledSpacePoint const& vertex) {
+        vertices[vertex_count++] = vertex;
+      },
+      max_points,
+      minimal_distance,
+      cache_samples);
+  return vertex_count;
+}
+
+template<typename Frame, typename AddPoint>
+void Planetarium::GenericPlotMethod3(
+    Trajectory<Frame> const& trajectory,
+    Instant const& first_time,
+    Instant const& last_time,
+    Instant const& now,
+    bool const reverse,
+    AddPoint const& add_point,
+    int const max_points,
+    Length* const minimal_distance,
+    bool const cache_samples) const {
   double const tan²_angular_resolution =
       Pow<2>(parameters_.tan_angular_resolution_);
   auto const final_time = reverse ? first_time : last_time;
@@ -71,9 +116,62 @@ void Planetarium::PlotMethod3(
   if (direction * (final_time - previous_time) <= Time{}) {
     return;
   }
+
+  bool const use_sample_cache = cache_samples && sample_cache_ != nullptr;
+  SampleCache::Key const sample_cache_key(&trajectory, reverse);
+  // The samples are moved out of the cache while plotting so that other
+  // trajectories may be plotted concurrently.
+  std::optional<SampleCache::Samples> cached_samples;
+  SampleCache::Points points;
+  SampleCache::Samples new_samples;
+  if (use_sample_cache) {
+    absl::MutexLock l(&sample_cache_->lock_);
+    if (auto const it = sample_cache_->entries_.find(sample_cache_key);
+        it != sample_cache_->entries_.end()) {
+      cached_samples = std::move(it->second.samples);
+      points = std::move(it->second.points);
+      sample_cache_->entries_.erase(it);
+    }
+  }
+  if constexpr (std::is_same_v<Frame, Barycentric>) {
+    if (use_sample_cache) {
+      SampleCache::Samples no_samples;
+      DropChangedSamples(trajectory,
+                         points,
+                         cached_samples.has_value() ? *cached_samples
+                                                    : no_samples);
+    }
+  }
+  // Only the ends of the plot are likely to be plotted again.
+  auto const to_plotting_frame_at_time = [this, first_time, last_time](
+                                             Instant const& t) {
+    return t == first_time || t == last_time
+               ? ToPlottingFrameAtTime(t)
+               : plotting_frame_->ToThisFrameAtTimeSimilarly(t);
+  };
+  auto const evaluate_degrees_of_freedom = [&](Instant const& t) {
+    if (cached_samples.has_value()) {
+      if (auto const it = cached_samples->find(t);
+          it != cached_samples->end()) {
+        return it->second;
+      }
+    }
+    DegreesOfFreedom<Navigation> const degrees_of_freedom =
+        EvaluateDegreesOfFreedomInNavigation(
+            to_plotting_frame_at_time, trajectory, t);
+    // Even the evaluations for the steps that are rejected are kept: they may
+    // be useful for a plot at a finer resolution.
+    if (use_sample_cache) {
+      new_samples.emplace(t, degrees_of_freedom);
+    }
+    return degrees_of_freedom;
+  };
+
   DegreesOfFreedom<Navigation> const initial_degrees_of_freedom =
-      EvaluateDegreesOfFreedomInNavigation<Frame>(
-          *plotting_frame_, trajectory, previous_time);
+      evaluate_degrees_of_freedom(previous_time);
+  if (use_sample_cache) {
+    new_samples.emplace(previous_time, initial_degrees_of_freedom);
+  }
   Position<Navigation> previous_position =
       initial_degrees_of_freedom.position();
   Velocity<Navigation> previous_velocity =
@@ -105,10 +203,31 @@ void Planetarium::PlotMethod3(
         t = final_time;
         Δt = t - previous_time;
       }
+      if (cached_samples.has_value()) {
+        // Use the cached sample closest to |t|, if it is not too far from it.
+        // If the step is lengthened too much, the error check below rejects
+        // it.
+        Instant const lowest = previous_time + 0.5 * Δt;
+        Instant const highest = t + 0.25 * Δt;
+        auto it = cached_samples->lower_bound(std::min(lowest, highest));
+        std::optional<Instant> closest;
+        for (; it != cached_samples->end() &&
+               it->first <= std::max(lowest, highest);
+             ++it) {
+          if (!closest.has_value() ||
+              Abs(it->first - t) < Abs(*closest - t)) {
+            closest = it->first;
+          }
+        }
+        if (closest.has_value() &&
+            direction * (*closest - final_time) <= Time{}) {
+          t = *closest;
+          Δt = t - previous_time;
+        }
+      }
       Position<Navigation> const extrapolated_position =
           previous_position + previous_velocity * Δt;
-      degrees_of_freedom = EvaluateDegreesOfFreedomInNavigation<Frame>(
-          *plotting_frame_, trajectory, t);
+      degrees_of_freedom = evaluate_degrees_of_freedom(t);
       position = degrees_of_freedom->position();
 
       // The quadratic term of the error between the linear interpolation and
@@ -126,6 +245,9 @@ void Planetarium::PlotMethod3(
 
     add_point(plotting_to_scaled_space_(position));
     ++points_added;
+    if (use_sample_cache) {
+      new_samples.emplace(t, *degrees_of_freedom);
+    }
 
     if (minimal_distance != nullptr) {
       minimal_squared_distance =
@@ -136,6 +258,28 @@ void Planetarium::PlotMethod3(
   if (minimal_distance != nullptr) {
     *minimal_distance = Sqrt(minimal_squared_distance);
   }
+  if (use_sample_cache) {
+    // The samples of the previous plots are kept so that a plot at any
+    // resolution finds the points that it needs: the cache is effectively a
+    // multi-resolution representation of the trajectory.  The samples outside
+    // of the plotted interval are dropped, so that they don't accumulate as
+    // time passes.  If there are too many samples anyway, only those of this
+    // plot are kept.
+    if (cached_samples.has_value() &&
+        cached_samples->size() + new_samples.size() <=
+            SampleCache::max_samples_per_trajectory) {
+      cached_samples->erase(cached_samples->begin(),
+                            cached_samples->lower_bound(first_time));
+      cached_samples->erase(cached_samples->upper_bound(last_time),
+                            cached_samples->end());
+      new_samples.merge(*cached_samples);
+    }
+    absl::MutexLock l(&sample_cache_->lock_);
+    sample_cache_->entries_[sample_cache_key] = {
+        .samples = std::move(new_samples),
+        .points = std::move(points),
+        .generation = sample_cache_->generation_};
+  }
 }
 
 }  // namespace internal
@@ -0,0 +1,57 @@
+#include "ksp_plugin/plotting_frame_motions.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _plotting_frame_motions {
+namespace internal {
+
+PlottingFrameMotions::PlottingFrameMotions(
+    not_null<PlottingFrame const*> const plotting_frame)
+    : plotting_frame_(plotting_frame) {}
+
+not_null<PlottingFrame const*> PlottingFrameMotions::plotting_frame() const {
+  return plotting_frame_;
+}
+
+SimilarMotion<Barycentric, Navigation>
+PlottingFrameMotions::ToPlottingFrameAtTime(Instant const& t) const {
+  {
+    absl::ReaderMutexLock l(&lock_);
+    if (auto const it = to_plotting_frame_.find(t);
+        it != to_plotting_frame_.end()) {
+      return it->second;
+    }
+  }
+  // The motion is computed outside of the lock, so concurrent callers may
+  // compute it more than once, but they get the same result.
+  auto const motion = plotting_frame_->ToThisFrameAtTimeSimilarly(t);
+  absl::MutexLock l(&lock_);
+  if (to_plotting_frame_.size() >= max_motions_) {
+    to_plotting_frame_.clear();
+  }
+  to_plotting_frame_.emplace(t, motion);
+  return motion;
+}
+
+SimilarMotion<Navigation, Barycentric>
+PlottingFrameMotions::FromPlottingFrameAtTime(Instant const& t) const {
+  {
+    absl::ReaderMutexLock l(&lock_);
+    if (auto const it = from_plotting_frame_.find(t);
+        it != from_plotting_frame_.end()) {
+      return it->second;
+    }
+  }
+  auto const motion = plotting_frame_->FromThisFrameAtTimeSimilarly(t);
+  absl::MutexLock l(&lock_);
+  if (from_plotting_frame_.size() >= max_motions_) {
+    from_plotting_frame_.clear();
+  }
+  from_plotting_frame_.emplace(t, motion);
+  return motion;
+}
+
+}  // namespace internal
+}  // namespace _plotting_frame_motions
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "absl/container/btree_map.h"
+#include "absl/synchronization/mutex.h"
+#include "base/not_null.hpp"
+#include "geometry/instant.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "physics/similar_motion.hpp"
+
+namespace principia {
+namespace ksp_plugin {
+namespace _plotting_frame_motions {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_instant;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::physics::_similar_motion;
+
+// A cache of the motions of a plotting frame at the instants where they have
+// been requested.  Computing the motion of a rotating frame requires evaluating
+// the trajectories of its bodies, and many instants (e.g., the points of the
+// histories of the vessels) are plotted again at each frame.  The motions are
+// those computed by the plotting frame: there is no interpolation.  This class
+// is thread-safe.
+class PlottingFrameMotions {
+ public:
+  // The motion of the |plotting_frame| at a given instant must never change,
+  // which excludes frames defined in terms of vessel predictions.  The
+  // |plotting_frame| must outlive this object.
+  explicit PlottingFrameMotions(not_null<PlottingFrame const*> plotting_frame);
+
+  not_null<PlottingFrame const*> plotting_frame() const;
+
+  SimilarMotion<Barycentric, Navigation> ToPlottingFrameAtTime(
+      Instant const& t) const;
+  SimilarMotion<Navigation, Barycentric> FromPlottingFrameAtTime(
+      Instant const& t) const;
+
+ private:
+  // When a map reaches this size it is cleared, to bound the memory usage.
+  static constexpr int max_motions_ = 1 << 16;
+
+  not_null<PlottingFrame const*> const plotting_frame_;
+
+  mutable absl::Mutex lock_;
+  mutable absl::btree_map<Instant, SimilarMotion<Barycentric, Navigation>>
+      to_plotting_frame_ GUARDED_BY(lock_);
+  mutable absl::btree_map<Instant, SimilarMotion<Navigation, Barycentric>>
+      from_plotting_frame_ GUARDED_BY(lock_);
+};
+
+}  // namespace internal
+
+using internal::PlottingFrameMotions;
+
+}  // namespace _plotting_frame_motions
+}  // namespace ksp_plugin
+}  // namespace principia
@@ -1,22 +1,28 @@
 #include "ksp_plugin/plugin.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <ios>
+#include <iterator>
 #include <limits>
 #include <list>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
 #include "astronomy/solar_system_fingerprints.hpp"
 #include "astronomy/stabilize_ksp.hpp"
 #include "astronomy/time_scales.hpp"
@@ -26,6 +32,8 @@
 #include "base/hexadecimal.hpp"
 #include "base/map_util.hpp"
 #include "base/serialization.hpp"
+#include "base/status_utilities.hpp"  // 🧙 For RETURN_IF_ERROR.
+#include "base/tracing.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/identity.hpp"
@@ -66,6 +74,7 @@ using namespace principia::base::_flags;
 using namespace principia::base::_hexadecimal;
 using namespace principia::base::_map_util;
 using namespace principia::base::_serialization;
+using namespace principia::base::_tracing;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_identity;
@@ -103,6 +112,205 @@ Length const& MaxCollisionError() {
   return max_collision_error;
 }
 
+// A hash of a point of a trajectory, used to detect that it has not changed
+// since a previous computation.
+std::size_t PointHash(
+    DiscreteTrajectory<Barycentric>::value_type const& point) {
+  auto const& [time, degrees_of_freedom] = point;
+  auto const q = (degrees_of_freedom.position() - Barycentric::origin)
+                     .coordinates() / Metre;
+  auto const v = degrees_of_freedom.velocity().coordinates() /
+                 (Metre / Second);
+  return absl::HashOf(
+      (time - Instant()) / Second, q.x, q.y, q.z, v.x, v.y, v.z);
+}
+
+// Appends to |times| and |hashes| the times and hashes of the points of
+// [begin, end[ at which |reference| may be evaluated, which are the points that
+// |ComputeApsides| scans.  Returns the first of these points.
+DiscreteTrajectory<Barycentric>::iterator HashPointsCoveredBy(
+    Trajectory<Barycentric> const& reference,
+    DiscreteTrajectory<Barycentric>::iterator const& begin,
+    DiscreteTrajectory<Barycentric>::iterator const& end,
+    std::vector<Instant>& times,
+    std::vector<std::size_t>& hashes) {
+  Instant const t_min = reference.t_min();
+  Instant const t_max = reference.t_max();
+  auto first = begin;
+  while (first != end && first->time < t_min) {
+    ++first;
+  }
+  for (auto it = first; it != end && it->time <= t_max; ++it) {
+    times.push_back(it->time);
+    hashes.push_back(PointHash(*it));
+  }
+  return first;
+}
+
+// Returns the time of the last point of the longest prefix of the points with
+// the given |times| and |hashes| that is identical to the cached points from
+// the same time on, or null if the first point is not among the cached ones.
+// The cached points may start earlier, since a prediction forgets its
+// beginning as time passes.
+std::optional<Instant> LastUnchangedTime(
+    std::vector<Instant> const& times,
+    std::vector<std::size_t> const& hashes,
+    std::vector<Instant> const& cached_times,
+    std::vector<std::size_t> const& cached_hashes) {
+  if (times.empty()) {
+    return std::nullopt;
+  }
+  // If there is no cached point at |times.front()|, this finds a point with a
+  // different time, and therefore a different hash.
+  std::int64_t const cached_first =
+      std::lower_bound(cached_times.begin(), cached_times.end(),
+                       times.front()) -
+      cached_times.begin();
+  std::int64_t const unchanged_points =
+      std::mismatch(hashes.begin(),
+                    hashes.end(),
+                    cached_hashes.begin() + cached_first,
+                    cached_hashes.end())
+          .first -
+      hashes.begin();
+  if (unchanged_points == 0) {
+    return std::nullopt;
+  }
+  return times[unchanged_points - 1];
+}
+
+// Prepares |apoapsides| and |periapsides|, found by a previous call to
+// |ComputeApsides| over points that are unchanged up to |last_unchanged_time|,
+// for a call over [first, end[, and returns the point from which that call
+// must scan to give the same result as a scan of the whole of [first, end[.
+DiscreteTrajectory<Barycentric>::iterator PrepareApsidesRescan(
+    DiscreteTrajectory<Barycentric>::iterator const& first,
+    DiscreteTrajectory<Barycentric>::iterator const& end,
+    std::optional<Instant> const& last_unchanged_time,
+    int const max_points,
+    DiscreteTrajectory<Barycentric>& apoapsides,
+    DiscreteTrajectory<Barycentric>& periapsides) {
+  if (first == end || !last_unchanged_time.has_value()) {
+    apoapsides.clear();
+    periapsides.clear();
+    return first;
+  }
+
+  // The previous scan stopped once it had found enough apsides, so it didn't
+  // look at the points after the last one.
+  Instant scanned_until = *last_unchanged_time;
+  if (apoapsides.size() >= max_points && periapsides.size() >= max_points) {
+    scanned_until = std::min(
+        scanned_until,
+        std::max(apoapsides.back().time, periapsides.back().time));
+  }
+
+  // An apsis is found after the first of the two points that bracket it, so
+  // the apsides at or before |first| are not found by a new scan.
+  apoapsides.ForgetBefore(apoapsides.upper_bound(first->time));
+  periapsides.ForgetBefore(periapsides.upper_bound(first->time));
+
+  // If enough apsides were found in the part that was scanned, a new scan would
+  // stop at the last of them.
+  if (apoapsides.size() >= max_points && periapsides.size() >= max_points) {
+    Instant const last_apsis_time =
+        std::max(std::next(apoapsides.begin(), max_points - 1)->time,
+                 std::next(periapsides.begin(), max_points - 1)->time);
+    if (last_apsis_time <= scanned_until) {
+      apoapsides.ForgetAfter(apoapsides.upper_bound(last_apsis_time));
+      periapsides.ForgetAfter(periapsides.upper_bound(last_apsis_time));
+      return end;
+    }
+  }
+
+  // Otherwise, scan from the last point that was scanned and is unchanged.
+  if (first->time > scanned_until) {
+    apoapsides.clear();
+    periapsides.clear();
+    return first;
+  }
+  auto scan_begin = first;
+  for (auto it = std::next(first); it != end && it->time <= scanned_until;
+       ++it) {
+    scan_begin = it;
+  }
+  apoapsides.ForgetAfter(apoapsides.upper_bound(scan_begin->time));
+  periapsides.ForgetAfter(periapsides.upper_bound(scan_begin->time));
+  return scan_begin;
+}
+
+// A hash of the points of a trajectory and of the parameters of the collision
+// search, used to detect that a search would give the same result as the
+// previous one.
+std::size_t CollisionFingerprint(
+    DiscreteTrajectory<Barycentric>::iterator const& begin,
+    DiscreteTrajectory<Barycentric>::iterator const& end,
+    int const max_points) {
+  std::size_t fingerprint = absl::HashOf(max_points);
+  for (auto it = begin; it != end; ++it) {
+    fingerprint = absl::HashOf(fingerprint, PointHash(*it));
+  }
+  return fingerprint;
+}
+
+// If the flag |parallel_ephemeris_threads| is present, its value is the number
+// of threads used to compute the accelerations between the celestials.
+void ConfigureEphemerisIfRequested(Ephemeris<Barycentric>& ephemeris) {
+  std::string_view name = "parallel_ephemeris_threads";
+  if (Flags::IsPresent(name)) {
+    auto const values = Flags::Values(name);
+    CHECK_EQ(values.size(), 1);
+    std::int64_t const pool_size = std::stoll(*values.begin());
+    LOG(INFO) << "Integrating the ephemeris on " << pool_size << " threads";
+    ephemeris.EnableParallelMassiveBodiesIntegration(pool_size);
+  }
+  // If the flag |batched_ephemeris_positions| is present, the positions of the
+  // celestials are evaluated in batches when integrating the vessels.
+  if (Flags::IsPresent("batched_ephemeris_positions")) {
+    LOG(INFO) << "Evaluating the positions of the celestials in batches";
+    ephemeris.EnableBatchedPositionsEvaluation();
+  }
+}
+
+// If the flag |ephemeris_prolongation_horizon| is present, its value is the
+// time interval by which the ephemeris is asynchronously prolonged ahead of the
+// current time, so that the predictions and flight plans don't have to wait
+// for |Prolong|.
+std::optional<Time> const& EphemerisProlongationHorizon() {
+  static std::optional<Time> const ephemeris_prolongation_horizon =
+      []() -> std::optional<Time> {
+    std::string_view name = "ephemeris_prolongation_horizon";
+    if (Flags::IsPresent(name)) {
+      auto const values = Flags::Values(name);
+      CHECK_EQ(values.size(), 1);
+      return ParseQuantity<Time>(*values.begin());
+    } else {
+      return std::nullopt;
+    }
+  }();
+  return ephemeris_prolongation_horizon;
+}
+
+// The (wall-clock) period at which the memory footprints of the ephemeris, of
+// the pile-ups and of the vessels are logged.  If the flag
+// |memory_footprint_logging_period| is present, its value overrides the
+// default.
+std::chrono::steady_clock::duration const& MemoryFootprintLoggingPeriod() {
+  static std::chrono::steady_clock::duration const
+      memory_footprint_logging_period = []() {
+    Time period = 10 * Minute;
+    std::string_view name = "memory_footprint_logging_period";
+    if (Flags::IsPresent(name)) {
+      auto const values = Flags::Values(name);
+      CHECK_EQ(values.size(), 1);
+      period = ParseQuantity<Time>(*values.begin());
+    }
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(period / Second));
+  }();
+  return memory_footprint_logging_period;
+}
+
 // Keep this consistent with |prediction_steps_| in |main_window.cs|.
 constexpr std::int64_t max_steps_in_prediction = 1 << 24;
 
@@ -228,12 +436,16 @@ void Plugin::EndInitialization() {
                  << initial_state_.DebugString();
   }
 
-  // Construct the ephemeris.
+  // Construct the ephemeris.  This only fits the initial state: no integration
+  // takes place until the ephemeris is first prolonged, which happens
+  // asynchronously, so there is nothing here that would be worth caching
+  // across games for a given system fingerprint.
   ephemeris_ =
       solar_system.MakeEphemeris(ephemeris_accuracy_parameters_.value_or(
                                      DefaultEphemerisAccuracyParameters()),
                                  ephemeris_fixed_step_parameters_.value_or(
                                      DefaultEphemerisFixedStepParameters()));
+  ConfigureEphemerisIfRequested(*ephemeris_);
 
   // Construct the celestials using the bodies from the ephemeris.
   for (std::string const& name : solar_system.names()) {
@@ -474,6 +686,7 @@ void Plugin::InsertOrKeepLoadedPart(
     } else {
       associated_vessel = vessel;
       vessel->AddPart(current_vessel->ExtractPart(part_id));
+      pile_up_topology_changed_ = true;
     }
   } else {
     AddPart(vessel,
@@ -536,14 +749,10 @@ bool Plugin::PartIsTruthful(PartId const part_id) const {
 }
 
 void Plugin::PrepareToReportCollisions() {
-  for (auto const& [_, vessel] : vessels_) {
-    // NOTE(egg): The lifetime requirement on the second argument of
-    // |MakeSingleton| (which forwards to the argument of the constructor of
-    // |Subset<Part>::Properties|) is that |part| outlives the constructed
-    // |Properties|; since these are owned by |part|, this is true.
-    vessel->ForAllParts(
-        [](Part& part) { Subset<Part>::MakeSingleton(part, &part); });
-  }
+  // The union-find is deferred to |FreeVesselsAndPartsAndCollectPileUps|, so
+  // that it may be skipped if nothing changed.
+  part_collisions_.clear();
+  ground_collisions_.clear();
 }
 
 void Plugin::ReportGroundCollision(PartId const part) const {
@@ -551,7 +760,7 @@ void Plugin::ReportGroundCollision(PartId const part) const {
   Part& p = *v.part(part);
   LOG(INFO) << "Collision between " << p.ShortDebugString()
             << " and the ground.";
-  Subset<Part>::Find(p).mutable_properties().Ground();
+  ground_collisions_.insert(part);
 }
 
 void Plugin::ReportPartCollision(PartId const part1, PartId const part2) const {
@@ -567,7 +776,7 @@ void Plugin::ReportPartCollision(PartId const part1, PartId const part2) const {
                                       << " will vanish";
   CHECK(v1.WillKeepPart(part1)) << p1.ShortDebugString() << " will vanish";
   CHECK(v2.WillKeepPart(part2)) << p2.ShortDebugString() << " will vanish";
-  Subset<Part>::Unite(Subset<Part>::Find(p1), Subset<Part>::Find(p2));
+  part_collisions_.insert(std::minmax(part1, part2));
 }
 
 void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
@@ -590,16 +799,68 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
       renderer_->ClearTargetVesselIf(vessel);
       zombie_prediction_adaptive_step_parameters_.insert_or_assign(
           vessel->guid(), vessel->prediction_adaptive_step_parameters());
+      EraseCachedResults(vessel->guid());
       it = vessels_.erase(it);
+      pile_up_topology_changed_ = true;
     }
   }
   CHECK(kept_vessels_.empty());
 
   // Free old parts.  This must be done before binding the vessels, otherwise
-  // the part subsets for the affected vessels will contain deleted parts.
+  // the part subsets for the affected vessels will contain deleted parts.  The
+  // parts remove themselves from |part_id_to_vessel_| when destroyed.
+  auto const number_of_parts = part_id_to_vessel_.size();
   for (not_null<Vessel*> const vessel : loaded_vessels_) {
     vessel->FreeParts();
   }
+  if (part_id_to_vessel_.size() != number_of_parts) {
+    pile_up_topology_changed_ = true;
+  }
+
+  // If the parts and the collisions are the same as in the previous step, so
+  // are the part subsets, and each of them is an existing pile-up.  Note that
+  // a grounded subset must be destroyed, so it always requires a rebuild.
+  if (pile_up_topology_changed_ || !ground_collisions_.empty() ||
+      part_collisions_ != previous_part_collisions_) {
+    RebuildPileUps(Δt);
+  } else {
+    for (PileUp* const pile_up : pile_ups_) {
+      pile_up->RecomputeFromParts();
+    }
+  }
+  previous_part_collisions_ = part_collisions_;
+  pile_up_topology_changed_ = false;
+
+  // Now that the composition of the vessels is known, as well as their
+  // intrinsic forces and torques, we may detect collapsibility changes.
+  for (auto const& [_, vessel] : vessels_) {
+    vessel->DetectCollapsibilityChange();
+  }
+}
+
+void Plugin::RebuildPileUps(Time const& Δt) {
+  for (auto const& [_, vessel] : vessels_) {
+    // NOTE(egg): The lifetime requirement on the second argument of
+    // |MakeSingleton| (which forwards to the argument of the constructor of
+    // |Subset<Part>::Properties|) is that |part| outlives the constructed
+    // |Properties|; since these are owned by |part|, this is true.
+    vessel->ForAllParts(
+        [](Part& part) { Subset<Part>::MakeSingleton(part, &part); });
+  }
+
+  // Replay the reported collisions.  The parts that collided with one another
+  // were kept, but a part that touched the ground may have been freed.
+  for (auto const& [part1, part2] : part_collisions_) {
+    Part& p1 = *FindOrDie(part_id_to_vessel_, part1)->part(part1);
+    Part& p2 = *FindOrDie(part_id_to_vessel_, part2)->part(part2);
+    Subset<Part>::Unite(Subset<Part>::Find(p1), Subset<Part>::Find(p2));
+  }
+  for (PartId const part : ground_collisions_) {
+    if (auto const it = part_id_to_vessel_.find(part);
+        it != part_id_to_vessel_.end()) {
+      Subset<Part>::Find(*it->second->part(part)).mutable_properties().Ground();
+    }
+  }
 
   // Bind the vessels.  This guarantees that all part subsets are disjoint
   // unions of vessels.
@@ -633,6 +894,7 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
       renderer_->ClearTargetVesselIf(vessel);
       zombie_prediction_adaptive_step_parameters_.insert_or_assign(
           vessel->guid(), vessel->prediction_adaptive_step_parameters());
+      EraseCachedResults(vessel->guid());
       CHECK_EQ(vessels_.erase(vessel->guid()), 1);
     }
   }
@@ -651,12 +913,6 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
           ephemeris_.get());
     });
   }
-
-  // Now that the composition of the vessels is known, as well as their
-  // intrinsic forces and torques, we may detect collapsibility changes.
-  for (auto const& [_, vessel] : vessels_) {
-    vessel->DetectCollapsibilityChange();
-  }
 }
 
 void Plugin::SetPartApparentRigidMotion(
@@ -698,6 +954,20 @@ RigidMotion<EccentricPart, World> Plugin::GetPartActualMotion(
          part.MakeRigidToEccentricMotion().Inverse();
 }
 
+std::vector<std::pair<PartId, RigidMotion<EccentricPart, World>>>
+Plugin::GetAllPartsActualMotions(
+    GUID const& vessel_guid,
+    RigidMotion<Barycentric, World> const& barycentric_to_world) const {
+  std::vector<std::pair<PartId, RigidMotion<EccentricPart, World>>> result;
+  FindOrDie(vessels_, vessel_guid)->ForAllParts(
+      [&barycentric_to_world, &result](Part& part) {
+        result.emplace_back(part.part_id(),
+                            barycentric_to_world * part.rigid_motion() *
+                                part.MakeRigidToEccentricMotion().Inverse());
+      });
+  return result;
+}
+
 DegreesOfFreedom<World> Plugin::CelestialWorldDegreesOfFreedom(
     Index const index,
     RigidMotion<Barycentric, World> const& barycentric_to_world,
@@ -759,6 +1029,7 @@ RigidMotion<Barycentric, World> Plugin::BarycentricToWorld(
 }
 
 void Plugin::AdvanceTime(Instant const& t, Angle const& planetarium_rotation) {
+  TracingScope tracing_scope("Plugin::AdvanceTime");
   CHECK(!initializing_);
   CHECK_GT(t, current_time_);
 
@@ -768,33 +1039,79 @@ void Plugin::AdvanceTime(Instant const& t, Angle const& planetarium_rotation) {
 
   current_time_ = t;
   planetarium_rotation_ = planetarium_rotation;
+  vessel_snapshot_.reset();
   ephemeris_->Prolong(current_time_).IgnoreError();
+  if (auto const& horizon = EphemerisProlongationHorizon();
+      horizon.has_value()) {
+    ephemeris_->RequestProlongation(current_time_ + horizon.value());
+  }
   UpdatePlanetariumRotation();
   loaded_vessels_.clear();
+
+  auto const now = std::chrono::steady_clock::now();
+  if (now - last_memory_footprint_logging_time_ >=
+      MemoryFootprintLoggingPeriod()) {
+    last_memory_footprint_logging_time_ = now;
+    LogMemoryFootprints();
+  }
 }
 
 void Plugin::CatchUpLaggingVessels(VesselSet& collided_vessels) {
   CHECK(!initializing_);
 
-  // Start all the integrations in parallel.
+  // Start all the integrations in parallel.  Each task advances a batch of
+  // pile-ups, see |PileUp::Batch|, and the vessels of these pile-ups, so that
+  // a slow batch doesn't delay the others.
   std::vector<PileUpFuture> pile_up_futures;
-  for (auto* const pile_up : pile_ups_) {
-    pile_up_futures.emplace_back(
-        pile_up,
-        vessel_thread_pool_.Add([this, pile_up]() {
+  for (PileUp* const pile_up : pile_ups_) {
+    pile_up->set_max_history_step(max_history_step_);
+  }
+  for (auto& batch : PileUp::Batch(pile_ups_, current_time_)) {
+    // The vessels are collected on this thread because |part_id_to_vessel_|
+    // must not be accessed concurrently with its modifications.
+    std::vector<VesselSet> pile_up_vessels;
+    std::vector<std::promise<absl::Status>> promises(batch.size());
+    for (int i = 0; i < batch.size(); ++i) {
+      auto& vessels = pile_up_vessels.emplace_back();
+      for (not_null<Part*> const part : batch[i]->parts()) {
+        vessels.insert(FindOrDie(part_id_to_vessel_, part->part_id()));
+      }
+      pile_up_futures.emplace_back(batch[i], promises[i].get_future());
+    }
+    vessel_thread_pool_.Add(
+        [this,
+         batch = std::move(batch),
+         pile_up_vessels = std::move(pile_up_vessels),
+         promises = std::move(promises)]() mutable {
           // Note that there cannot be contention in the following method as
-          // no two pile-ups are advanced at the same time.
-          return pile_up->DeformAndAdvanceTime(current_time_);
-        }));
+          // no two batches are advanced at the same time.
+          std::vector<absl::Status> const statuses =
+              PileUp::DeformAndAdvanceTime(batch, current_time_);
+          for (int i = 0; i < batch.size(); ++i) {
+            // A vessel belongs to a single pile-up, so no two tasks advance
+            // the same vessel.
+            for (not_null<Vessel*> const vessel : pile_up_vessels[i]) {
+              if (vessel->psychohistory()->back().time < current_time_) {
+                if (!statuses[i].ok()) {
+                  vessel->DisableDownsampling();
+                }
+                vessel->AdvanceTime();
+              }
+            }
+            promises[i].set_value(statuses[i]);
+          }
+          return absl::OkStatus();
+        });
   }
 
   // Wait for the integrations to finish and figure out which vessels collided
-  // with a celestial.
+  // with a celestial.  The critical path is the slowest task, irrespective of
+  // the order in which we wait.
   for (auto& pile_up_future : pile_up_futures) {
     WaitForVesselToCatchUp(pile_up_future, collided_vessels);
   }
 
-  // Update the vessels.
+  // Update the vessels that are not in any pile-up.
   for (auto const& [_, vessel] : vessels_) {
     if (vessel->psychohistory()->back().time < current_time_) {
       if (Contains(collided_vessels, vessel.get())) {
@@ -816,20 +1133,29 @@ not_null<std::unique_ptr<PileUpFuture>> Plugin::CatchUpVessel(
     pile_up = part.containing_pile_up();
   });
 
+  // This pile-up is integrated on its own, so it cannot share an instance with
+  // other pile-ups.  This must happen on this thread as it affects the other
+  // pile-ups of the batch.
+  pile_up->LeaveBatch();
+
+  // The game is waiting for this vessel, so it overtakes the pile-ups that are
+  // merely lagging.
   return make_not_null_unique<PileUpFuture>(
       pile_up,
-      vessel_thread_pool_.Add([this, pile_up, &vessel]() {
-        // Note that there can be contention in the following method if the
-        // caller is catching-up two vessels belonging to the same pile-up in
-        // parallel.
-        absl::Status const status =
-            pile_up->DeformAndAdvanceTime(current_time_);
-        if (!status.ok()) {
-          vessel.DisableDownsampling();
-        }
-        vessel.AdvanceTime();
-        return status;
-      }));
+      vessel_thread_pool_.Add(
+          [this, pile_up, &vessel]() {
+            // Note that there can be contention in the following method if the
+            // caller is catching-up two vessels belonging to the same pile-up
+            // in parallel.
+            absl::Status const status =
+                pile_up->DeformAndAdvanceTime(current_time_);
+            if (!status.ok()) {
+              vessel.DisableDownsampling();
+            }
+            vessel.AdvanceTime();
+            return status;
+          },
+          ThreadPool<absl::Status>::Priority::High));
 }
 
 void Plugin::WaitForVesselToCatchUp(PileUpFuture& pile_up_future,
@@ -870,6 +1196,30 @@ RelativeDegreesOfFreedom<AliceSun> Plugin::VesselFromParent(
   return result;
 }
 
+std::vector<RelativeDegreesOfFreedom<AliceSun>> Plugin::VesselsFromParent(
+    std::vector<GUID> const& vessel_guids) const {
+  CHECK(!initializing_);
+  absl::flat_hash_map<Celestial const*, DegreesOfFreedom<Barycentric>>
+      parent_degrees_of_freedom;
+  std::vector<RelativeDegreesOfFreedom<AliceSun>> result;
+  result.reserve(vessel_guids.size());
+  for (auto const& vessel_guid : vessel_guids) {
+    Vessel const& vessel = *FindOrDie(vessels_, vessel_guid);
+    auto it = parent_degrees_of_freedom.find(vessel.parent());
+    if (it == parent_degrees_of_freedom.end()) {
+      it = parent_degrees_of_freedom
+               .emplace(vessel.parent(),
+                        vessel.parent()->current_degrees_of_freedom(
+                            current_time_))
+               .first;
+    }
+    RelativeDegreesOfFreedom<Barycentric> const barycentric_result =
+        vessel.psychohistory()->back().degrees_of_freedom - it->second;
+    result.push_back(PlanetariumRotation()(barycentric_result));
+  }
+  return result;
+}
+
 RelativeDegreesOfFreedom<AliceSun> Plugin::CelestialFromParent(
     Index const celestial_index) const {
   CHECK(!initializing_);
@@ -919,6 +1269,15 @@ void Plugin::SetPredictionAdaptiveStepParameters(
       prediction_adaptive_step_parameters);
 }
 
+void Plugin::SetMaxHistoryStep(std::optional<Time> const& max_history_step) {
+  max_history_step_ = max_history_step;
+}
+
+void Plugin::SetPredictionKeplerTolerance(
+    std::optional<Angle> const& tolerance) {
+  prediction_kepler_tolerance_ = tolerance;
+}
+
 void Plugin::UpdatePrediction(std::vector<GUID> const& vessel_guids) const {
   CHECK(!initializing_);
   std::set<not_null<Vessel*>> predicted_vessels;
@@ -926,12 +1285,26 @@ void Plugin::UpdatePrediction(std::vector<GUID> const& vessel_guids) const {
     predicted_vessels.insert(FindOrDie(vessels_, guid).get());
   }
   Vessel* target_vessel = nullptr;
+  if (renderer_->HasTargetVessel()) {
+    target_vessel = &renderer_->GetTargetVessel();
+  }
+
+  // The first vessel is normally the active vessel.  Only its prediction and
+  // that of the target vessel are in focus.
+  Vessel const* const active_vessel =
+      vessel_guids.empty() ? nullptr
+                           : FindOrDie(vessels_, vessel_guids.front()).get();
+  for (auto const vessel : predicted_vessels) {
+    vessel->set_prediction_in_focus(vessel == active_vessel ||
+                                    vessel == target_vessel);
+    vessel->set_prediction_kepler_tolerance(prediction_kepler_tolerance_);
+  }
 
   // If there is a target vessel, ensure that the prediction of the
   // |predicted_vessels| is not longer than that of the target vessel.  This is
   // necessary to build the targeting frame.
-  if (renderer_->HasTargetVessel()) {
-    target_vessel = &renderer_->GetTargetVessel();
+  if (target_vessel != nullptr) {
+    target_vessel->set_prediction_in_focus(true);
     target_vessel->RefreshPrediction();
     for (auto const vessel : predicted_vessels) {
       vessel->RefreshPrediction(target_vessel->prediction()->back().time);
@@ -987,6 +1360,8 @@ void Plugin::ExtendPredictionForFlightPlan(GUID const& vessel_guid) const {
 
 void Plugin::ComputeAndRenderApsides(
     Index const celestial_index,
+    GUID const& vessel_guid,
+    VesselTrajectory const vessel_trajectory,
     Trajectory<Barycentric> const& trajectory,
     DiscreteTrajectory<Barycentric>::iterator const& begin,
     DiscreteTrajectory<Barycentric>::iterator const& end,
@@ -994,15 +1369,42 @@ void Plugin::ComputeAndRenderApsides(
     int const max_points,
     DiscreteTrajectory<World>& apoapsides,
     DiscreteTrajectory<World>& periapsides) const {
-  DiscreteTrajectory<Barycentric> apoapsides_trajectory;
-  DiscreteTrajectory<Barycentric> periapsides_trajectory;
-  ComputeApsides(FindOrDie(celestials_, celestial_index)->trajectory(),
+  auto const& celestial_trajectory =
+      FindOrDie(celestials_, celestial_index)->trajectory();
+  std::vector<Instant> point_times;
+  std::vector<std::size_t> point_hashes;
+  auto const first = HashPointsCoveredBy(
+      celestial_trajectory, begin, end, point_times, point_hashes);
+  auto& cached_apsides =
+      apsides_cache_[vessel_guid][{vessel_trajectory, celestial_index,
+                                   max_points}];
+  auto& apoapsides_trajectory = cached_apsides.apoapsides;
+  auto& periapsides_trajectory = cached_apsides.periapsides;
+
+  // An apsis is found between two consecutive points, and only depends on
+  // them.  The apsides found up to the last point that didn't change since the
+  // previous call are still valid, so we only scan the trajectory from that
+  // point on.  As time passes, a prediction loses points at its beginning and
+  // gains points at its end, but most of its points are unchanged.
+  auto const scan_begin = PrepareApsidesRescan(
+      first,
+      end,
+      LastUnchangedTime(point_times,
+                        point_hashes,
+                        cached_apsides.point_times,
+                        cached_apsides.point_hashes),
+      max_points,
+      apoapsides_trajectory,
+      periapsides_trajectory);
+  ComputeApsides(celestial_trajectory,
                  trajectory,
-                 begin,
+                 scan_begin,
                  end,
                  max_points,
                  apoapsides_trajectory,
                  periapsides_trajectory);
+  cached_apsides.point_times = std::move(point_times);
+  cached_apsides.point_hashes = std::move(point_hashes);
   apoapsides = renderer_->RenderBarycentricTrajectoryInWorld(
                    current_time_,
                    apoapsides_trajectory.begin(),
@@ -1017,62 +1419,128 @@ void Plugin::ComputeAndRenderApsides(
                     PlanetariumRotation());
 }
 
+absl::StatusOr<DegreesOfFreedom<Navigation>> Plugin::FlowFreefall(
+    NavigationFrame const& frame,
+    DegreesOfFreedom<Navigation> const& degrees_of_freedom,
+    Instant const& t_initial,
+    Instant const& t_final) const {
+  CHECK(!initializing_);
+  CHECK_LE(t_initial, t_final);
+  if (t_initial < ephemeris_->t_min()) {
+    return absl::OutOfRangeError(
+        (std::stringstream{} << "|t_initial| " << t_initial
+                             << " is before the beginning of the ephemeris "
+                             << ephemeris_->t_min())
+            .str());
+  }
+  // The ephemeris must cover |t_initial| for the change of frame.
+  RETURN_IF_ERROR(ephemeris_->Prolong(t_initial));
+  DiscreteTrajectory<Barycentric> trajectory;
+  RETURN_IF_ERROR(trajectory.Append(
+      t_initial,
+      frame.FromThisFrameAtTime(t_initial)(degrees_of_freedom)));
+  RETURN_IF_ERROR(ephemeris_->FlowWithAdaptiveStep(
+      &trajectory,
+      Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+      t_final,
+      DefaultPredictionParameters()));
+  return frame.ToThisFrameAtTime(t_final)(
+      trajectory.back().degrees_of_freedom);
+}
+
 std::optional<DiscreteTrajectory<World>::value_type>
 Plugin::ComputeAndRenderFirstCollision(
     Index const celestial_index,
+    GUID const& vessel_guid,
+    VesselTrajectory const vessel_trajectory,
     Trajectory<Barycentric> const& trajectory,
     DiscreteTrajectory<Barycentric>::iterator const& begin,
     DiscreteTrajectory<Barycentric>::iterator const& end,
     Position<World> const& sun_world_position,
     int max_points,
+    int const terrain_level_of_detail,
     std::function<Length(Angle const& latitude,
                          Angle const& longitude)> const& radius) const {
   auto const& celestial = FindOrDie(celestials_, celestial_index);
   auto const& celestial_body = *celestial->body();
   auto const& celestial_trajectory = celestial->trajectory();
 
-  // TODO(phl): We should cache the apsides.
-  DiscreteTrajectory<Barycentric> apoapsides_trajectory;
-  DiscreteTrajectory<Barycentric> periapsides_trajectory;
-  ComputeApsides(celestial_trajectory,
-                 trajectory,
-                 begin,
-                 end,
-                 max_points,
-                 apoapsides_trajectory,
-                 periapsides_trajectory);
+  // The terrain doesn't change for a given level of detail, so if the
+  // trajectory is the same as in the previous search we can reuse its result
+  // without computing the apsides or pulling any radius.  This happens every
+  // frame for flight plans that are not being edited.
+  std::tuple<VesselTrajectory, Index, int> const cache_key{
+      vessel_trajectory, celestial_index, terrain_level_of_detail};
+  std::size_t const fingerprint = CollisionFingerprint(begin, end, max_points);
+  std::optional<DiscreteTrajectory<Barycentric>::value_type> maybe_collision;
+  bool cache_hit = false;
+  {
+    absl::MutexLock l(&collision_cache_lock_);
+    if (auto const vessel_it = collision_cache_.find(vessel_guid);
+        vessel_it != collision_cache_.end()) {
+      if (auto const it = vessel_it->second.find(cache_key);
+          it != vessel_it->second.end() &&
+          it->second.fingerprint == fingerprint) {
+        maybe_collision = it->second.collision;
+        cache_hit = true;
+      }
+    }
+  }
 
-  const auto intervals = ComputeCollisionIntervals(celestial_body,
-                                                   celestial_trajectory,
-                                                   trajectory,
-                                                   apoapsides_trajectory,
-                                                   periapsides_trajectory);
-
-  VLOG(1) << "Found " << intervals.size() << " collision intervals";
-  for (auto const& interval : intervals) {
-    VLOG(1) << "Collision interval: " << interval;
-    auto const maybe_collision = ComputeFirstCollision(celestial_body,
-                                                       celestial_trajectory,
-                                                       trajectory,
-                                                       interval,
-                                                       MaxCollisionError(),
-                                                       radius);
-    if (maybe_collision.has_value()) {
-      auto const& collision = maybe_collision.value();
-
-      // We create a trajectory with a single point to simplify rendering.
-      DiscreteTrajectory<Barycentric> trajectory_to_render;
-      CHECK_OK(trajectory_to_render.Append(collision.time,
-                                           collision.degrees_of_freedom));
-      DiscreteTrajectory<World> rendered_trajectory =
-          renderer_->RenderBarycentricTrajectoryInWorld(
-              current_time_,
-              trajectory_to_render.begin(),
-              trajectory_to_render.end(),
-              sun_world_position,
-              PlanetariumRotation());
-      return rendered_trajectory.front();
+  if (!cache_hit) {
+    // TODO(phl): We should cache the apsides.
+    DiscreteTrajectory<Barycentric> apoapsides_trajectory;
+    DiscreteTrajectory<Barycentric> periapsides_trajectory;
+    ComputeApsides(celestial_trajectory,
+                   trajectory,
+                   begin,
+                   end,
+                   max_points,
+                   apoapsides_trajectory,
+                   periapsides_trajectory);
+
+    const auto intervals = ComputeCollisionIntervals(celestial_body,
+                                                     celestial_trajectory,
+                                                     trajectory,
+                                                     apoapsides_trajectory,
+                                                     periapsides_trajectory);
+
+    VLOG(1) << "Found " << intervals.size() << " collision intervals";
+    for (auto const& interval : intervals) {
+      VLOG(1) << "Collision interval: " << interval;
+      maybe_collision = ComputeFirstCollision(celestial_body,
+                                              celestial_trajectory,
+                                              trajectory,
+                                              interval,
+                                              MaxCollisionError(),
+                                              radius);
+      if (maybe_collision.has_value()) {
+        break;
+      }
     }
+
+    absl::MutexLock l(&collision_cache_lock_);
+    collision_cache_[vessel_guid].insert_or_assign(
+        cache_key,
+        CachedCollision{.fingerprint = fingerprint,
+                        .collision = maybe_collision});
+  }
+
+  if (maybe_collision.has_value()) {
+    auto const& collision = maybe_collision.value();
+
+    // We create a trajectory with a single point to simplify rendering.
+    DiscreteTrajectory<Barycentric> trajectory_to_render;
+    CHECK_OK(trajectory_to_render.Append(collision.time,
+                                         collision.degrees_of_freedom));
+    DiscreteTrajectory<World> rendered_trajectory =
+        renderer_->RenderBarycentricTrajectoryInWorld(
+            current_time_,
+            trajectory_to_render.begin(),
+            trajectory_to_render.end(),
+            sun_world_position,
+            PlanetariumRotation());
+    return rendered_trajectory.front();
   }
 
   // No collision.
@@ -1080,6 +1548,8 @@ Plugin::ComputeAndRenderFirstCollision(
 }
 
 void Plugin::ComputeAndRenderClosestApproaches(
+    GUID const& vessel_guid,
+    VesselTrajectory const vessel_trajectory,
     Trajectory<Barycentric> const& trajectory,
     DiscreteTrajectory<Barycentric>::iterator const& begin,
     DiscreteTrajectory<Barycentric>::iterator const& end,
@@ -1087,16 +1557,65 @@ void Plugin::ComputeAndRenderClosestApproaches(
     int const max_points,
     DiscreteTrajectory<World>& closest_approaches) const {
   CHECK(renderer_->HasTargetVessel());
-
-  DiscreteTrajectory<Barycentric> apoapsides_trajectory;
-  DiscreteTrajectory<Barycentric> periapsides_trajectory;
-  ComputeApsides(*renderer_->GetTargetVessel().prediction(),
+  auto const& target_prediction = *renderer_->GetTargetVessel().prediction();
+
+  std::vector<Instant> point_times;
+  std::vector<std::size_t> point_hashes;
+  auto const first = HashPointsCoveredBy(
+      target_prediction, begin, end, point_times, point_hashes);
+  std::vector<Instant> target_point_times;
+  std::vector<std::size_t> target_point_hashes;
+  HashPointsCoveredBy(target_prediction,
+                      target_prediction.begin(),
+                      target_prediction.end(),
+                      target_point_times,
+                      target_point_hashes);
+  auto& cached_closest_approaches =
+      closest_approaches_cache_[vessel_guid][{vessel_trajectory, max_points}];
+  auto& apoapsides_trajectory = cached_closest_approaches.apoapsides;
+  auto& periapsides_trajectory = cached_closest_approaches.periapsides;
+
+  // As in |ComputeAndRenderApsides|, the apsides found between two points that
+  // didn't change are still valid, provided that the prediction of the target
+  // didn't change either at these times.  The target is evaluated by
+  // interpolating between its points, so it is unchanged up to its last
+  // unchanged point.  This avoids evaluating the target at each point of the
+  // trajectory on every frame, which dominates the cost of this function.
+  auto const last_unchanged_vessel_time =
+      LastUnchangedTime(point_times,
+                        point_hashes,
+                        cached_closest_approaches.point_times,
+                        cached_closest_approaches.point_hashes);
+  auto const last_unchanged_target_time =
+      LastUnchangedTime(target_point_times,
+                        target_point_hashes,
+                        cached_closest_approaches.target_point_times,
+                        cached_closest_approaches.target_point_hashes);
+  std::optional<Instant> last_unchanged_time;
+  if (last_unchanged_vessel_time.has_value() &&
+      last_unchanged_target_time.has_value()) {
+    last_unchanged_time =
+        std::min(*last_unchanged_vessel_time, *last_unchanged_target_time);
+  }
+  auto const scan_begin = PrepareApsidesRescan(first,
+                                               end,
+                                               last_unchanged_time,
+                                               max_points,
+                                               apoapsides_trajectory,
+                                               periapsides_trajectory);
+  ComputeApsides(target_prediction,
                  trajectory,
-                 begin,
+                 scan_begin,
                  end,
                  max_points,
                  apoapsides_trajectory,
                  periapsides_trajectory);
+  cached_closest_approaches.point_times = std::move(point_times);
+  cached_closest_approaches.point_hashes = std::move(point_hashes);
+  cached_closest_approaches.target_point_times =
+      std::move(target_point_times);
+  cached_closest_approaches.target_point_hashes =
+      std::move(target_point_hashes);
   closest_approaches =
       renderer_->RenderBarycentricTrajectoryInWorld(
           current_time_,
@@ -1190,11 +1709,27 @@ not_null<std::unique_ptr<Planetarium>> Plugin::NewPlanetarium(
     std::function<ScaledSpacePoint(Position<Navigation> const&)>
         plotting_to_scaled_space)
     const {
+  // The frame of a target vessel depends on its prediction, which changes all
+  // the time, so nothing is cached in that case.
+  Planetarium::SampleCache* sample_cache = nullptr;
+  if (!renderer_->HasTargetVessel()) {
+    serialization::ReferenceFrame message;
+    renderer_->GetPlottingFrame()->WriteToMessage(&message);
+    std::string plotting_frame = message.SerializeAsString();
+    if (planetarium_sample_cache_ == nullptr ||
+        plotting_frame != planetarium_sample_cache_plotting_frame_) {
+      planetarium_sample_cache_ = std::make_unique<Planetarium::SampleCache>();
+      planetarium_sample_cache_plotting_frame_ = std::move(plotting_frame);
+    }
+    sample_cache = planetarium_sample_cache_.get();
+  }
   return make_not_null_unique<Planetarium>(parameters,
                                            perspective,
                                            ephemeris_.get(),
                                            renderer_->GetPlottingFrame(),
-                                           std::move(plotting_to_scaled_space));
+                                           std::move(plotting_to_scaled_space),
+                                           sample_cache,
+                                           renderer_->GetPlottingFrameMotions());
 }
 
 not_null<std::unique_ptr<NavigationFrame>>
@@ -1375,21 +1910,18 @@ std::unique_ptr<FrameField<World, Navball>> Plugin::NavballFrameField(
 }
 
 Vector<double, World> Plugin::VesselTangent(GUID const& vessel_guid) const {
-  return renderer_->FrenetToWorld(
-      *FindOrDie(vessels_, vessel_guid),
-      PlanetariumRotation())(Vector<double, Frenet<Navigation>>({1, 0, 0}));
+  return GetVesselSnapshot(vessel_guid).frenet_to_world(
+      Vector<double, Frenet<Navigation>>({1, 0, 0}));
 }
 
 Vector<double, World> Plugin::VesselNormal(GUID const& vessel_guid) const {
-  return renderer_->FrenetToWorld(
-      *FindOrDie(vessels_, vessel_guid),
-      PlanetariumRotation())(Vector<double, Frenet<Navigation>>({0, 1, 0}));
+  return GetVesselSnapshot(vessel_guid).frenet_to_world(
+      Vector<double, Frenet<Navigation>>({0, 1, 0}));
 }
 
 Vector<double, World> Plugin::VesselBinormal(GUID const& vessel_guid) const {
-  return renderer_->FrenetToWorld(
-      *FindOrDie(vessels_, vessel_guid),
-      PlanetariumRotation())(Vector<double, Frenet<Navigation>>({0, 0, 1}));
+  return GetVesselSnapshot(vessel_guid).frenet_to_world(
+      Vector<double, Frenet<Navigation>>({0, 0, 1}));
 }
 
 Velocity<World> Plugin::UnmanageableVesselVelocity(
@@ -1405,9 +1937,7 @@ Velocity<World> Plugin::UnmanageableVesselVelocity(
 }
 
 Velocity<World> Plugin::VesselVelocity(GUID const& vessel_guid) const {
-  Vessel const& vessel = *FindOrDie(vessels_, vessel_guid);
-  auto const back = vessel.psychohistory()->back();
-  return VesselVelocity(back.time, back.degrees_of_freedom);
+  return GetVesselSnapshot(vessel_guid).velocity;
 }
 
 void Plugin::RequestReanimation(Instant const& desired_t_min) const {
@@ -1573,6 +2103,7 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
       Ephemeris<Barycentric>::ReadFromMessage(/*using_checkpoint_at_or_before=*/
                                               plugin->current_time_,
                                               message.ephemeris());
+  ConfigureEphemerisIfRequested(*plugin->ephemeris_);
   plugin->ephemeris_->Prolong(plugin->game_epoch_).IgnoreError();
   plugin->ephemeris_->Prolong(plugin->current_time_).IgnoreError();
   CHECK_LE(plugin->ephemeris_->t_min(), plugin->current_time_);
@@ -1582,17 +2113,40 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
                              plugin->celestials_,
                              plugin->name_to_index_);
 
-  for (auto const& vessel_message : message.vessel()) {
-    not_null<Celestial const*> const parent =
-        FindOrDie(plugin->celestials_, vessel_message.parent_index()).get();
-    not_null<std::unique_ptr<Vessel>> vessel = Vessel::ReadFromMessage(
-        vessel_message.vessel(),
-        parent,
-        plugin->ephemeris_.get(),
-        [&part_id_to_vessel = plugin->part_id_to_vessel_](
-            PartId const part_id) {
-          CHECK_NE(part_id_to_vessel.erase(part_id), 0) << part_id;
-        });
+  // Once the ephemeris and the celestials exist the vessels are independent of
+  // each other, so they are deserialized in parallel.  The maps that refer to
+  // them are filled serially once all the vessels have been constructed.
+  std::vector<std::unique_ptr<Vessel>> deserialized_vessels(
+      message.vessel_size());
+  std::vector<std::future<absl::Status>> deserialized_vessel_futures;
+  for (int i = 0; i < message.vessel_size(); ++i) {
+    deserialized_vessel_futures.push_back(plugin->vessel_thread_pool_.Add(
+        [i, &deserialized_vessels, &message, &plugin = *plugin]() {
+          auto const& vessel_message = message.vessel(i);
+          not_null<Celestial const*> const parent =
+              FindOrDie(plugin.celestials_, vessel_message.parent_index())
+                  .get();
+          // The deletion callback is only called once the vessel is
+          // destroyed, long after deserialization.
+          deserialized_vessels[i] = Vessel::ReadFromMessage(
+              vessel_message.vessel(),
+              parent,
+              plugin.ephemeris_.get(),
+              [&part_id_to_vessel = plugin.part_id_to_vessel_](
+                  PartId const part_id) {
+                CHECK_NE(part_id_to_vessel.erase(part_id), 0) << part_id;
+              });
+          return absl::OkStatus();
+        }));
+  }
+  for (auto& future : deserialized_vessel_futures) {
+    CHECK_OK(future.get());
+  }
+
+  for (int i = 0; i < message.vessel_size(); ++i) {
+    auto const& vessel_message = message.vessel(i);
+    not_null<std::unique_ptr<Vessel>> vessel =
+        std::move(deserialized_vessels[i]);
 
     if (vessel_message.loaded()) {
       plugin->loaded_vessels_.insert(vessel.get());
@@ -1701,6 +2255,25 @@ void Plugin::InitializeIndices(std::string const& name,
   CHECK(inserted) << celestial_index;
 }
 
+void Plugin::LogMemoryFootprints() const {
+  std::int64_t const ephemeris_footprint = ephemeris_->MemoryFootprint();
+  std::int64_t pile_ups_footprint = 0;
+  for (auto const* const pile_up : pile_ups_) {
+    pile_ups_footprint += pile_up->MemoryFootprint();
+  }
+  std::int64_t vessels_footprint = 0;
+  for (auto const& [_, vessel] : vessels_) {
+    std::int64_t const vessel_footprint = vessel->MemoryFootprint();
+    vessels_footprint += vessel_footprint;
+    VLOG(1) << "Memory footprint of " << vessel->ShortDebugString() << ": "
+            << vessel_footprint << " bytes";
+  }
+  LOG(INFO) << "Memory footprints: ephemeris " << ephemeris_footprint
+            << " bytes, " << pile_ups_.size() << " pile-ups "
+            << pile_ups_footprint << " bytes, " << vessels_.size()
+            << " vessels " << vessels_footprint << " bytes";
+}
+
 void Plugin::UpdatePlanetariumRotation() {
   using PlanetariumFrame = Frame<struct PlanetariumFrameTag>;
 
@@ -1731,6 +2304,34 @@ Velocity<World> Plugin::VesselVelocity(
       plotting_frame_degrees_of_freedom.velocity());
 }
 
+Plugin::VesselSnapshot const& Plugin::GetVesselSnapshot(
+    GUID const& vessel_guid) const {
+  Vessel const& vessel = *FindOrDie(vessels_, vessel_guid);
+  auto const back = vessel.psychohistory()->back();
+  // As for the planetarium sample cache, the frame of a target vessel changes
+  // all the time, so the snapshot is always recomputed in that case.
+  std::string plotting_frame;
+  bool const cacheable = !renderer_->HasTargetVessel();
+  if (cacheable) {
+    serialization::ReferenceFrame message;
+    renderer_->GetPlottingFrame()->WriteToMessage(&message);
+    plotting_frame = message.SerializeAsString();
+    if (vessel_snapshot_.has_value() &&
+        vessel_snapshot_->vessel_guid == vessel_guid &&
+        vessel_snapshot_->time == back.time &&
+        vessel_snapshot_->plotting_frame == plotting_frame) {
+      return *vessel_snapshot_;
+    }
+  }
+  vessel_snapshot_.emplace(VesselSnapshot{
+      .vessel_guid = vessel_guid,
+      .time = back.time,
+      .plotting_frame = cacheable ? std::move(plotting_frame) : std::string(),
+      .frenet_to_world = renderer_->FrenetToWorld(vessel, PlanetariumRotation()),
+      .velocity = VesselVelocity(back.time, back.degrees_of_freedom)});
+  return *vessel_snapshot_;
+}
+
 template<typename T>
 void Plugin::ReadCelestialsFromMessages(
     Ephemeris<Barycentric> const& ephemeris,
@@ -1776,6 +2377,7 @@ void Plugin::AddPart(not_null<Vessel*> const vessel,
                      Args... args) {
   auto const [_, inserted] = part_id_to_vessel_.emplace(part_id, vessel);
   CHECK(inserted) << NAMED(part_id);
+  pile_up_topology_changed_ = true;
   auto deletion_callback = [part_id, &map = part_id_to_vessel_] {
     // This entails a lookup, but iterators are not stable in |flat_hash_map|.
     map.erase(part_id);
@@ -1791,6 +2393,13 @@ bool Plugin::is_loaded(not_null<Vessel*> vessel) const {
   return Contains(loaded_vessels_, vessel);
 }
 
+void Plugin::EraseCachedResults(GUID const& vessel_guid) {
+  apsides_cache_.erase(vessel_guid);
+  closest_approaches_cache_.erase(vessel_guid);
+  absl::MutexLock l(&collision_cache_lock_);
+  collision_cache_.erase(vessel_guid);
+}
+
 }  // namespace internal
 }  // namespace _plugin
 }  // namespace ksp_plugin
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <future>
 #include <limits>
 #include <list>
@@ -8,11 +9,14 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "base/disjoint_sets.hpp"
 #include "base/monostable.hpp"
 #include "base/not_null.hpp"
@@ -30,6 +34,7 @@
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/geometric_potential_plotter.hpp"
 #include "ksp_plugin/identification.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "ksp_plugin/pile_up.hpp"
 #include "ksp_plugin/planetarium.hpp"
 #include "ksp_plugin/renderer.hpp"
@@ -42,6 +47,7 @@
 #include "physics/frame_field.hpp"
 #include "physics/hierarchical_system.hpp"
 #include "physics/massive_body.hpp"
+#include "physics/reference_frame.hpp"
 #include "physics/rigid_motion.hpp"
 #include "physics/rigid_reference_frame.hpp"
 #include "physics/rotating_body.hpp"
@@ -90,6 +96,7 @@ using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_frame_field;
 using namespace principia::physics::_hierarchical_system;
 using namespace principia::physics::_massive_body;
+using namespace principia::physics::_reference_frame;
 using namespace principia::physics::_rigid_motion;
 using namespace principia::physics::_rigid_reference_frame;
 using namespace principia::physics::_rotating_body;
@@ -103,6 +110,14 @@ using namespace principia::quantities::_si;
 // |b.flightGlobalsIndex| in C#. We use this as a key in a map.
 using Index = int;
 
+// A trajectory of a vessel whose apsides, collisions and closest approaches are
+// cached by the |Plugin|.  The trajectory objects are not suitable as keys of
+// these caches, since the prediction is replaced each time it is recomputed.
+enum class VesselTrajectory {
+  Prediction,
+  FlightPlan,
+};
+
 class Plugin {
  public:
   Plugin() = delete;
@@ -243,10 +258,9 @@ class Plugin {
 
   virtual bool PartIsTruthful(PartId part_id) const;
 
-  // Calls |MakeSingleton| for all parts in loaded vessels, enabling the use of
-  // union-find for pile up construction.  This must be called after the calls
-  // to |ApplyPartIntrinsicForce|, and before the calls to
-  // |ReportGroundCollision| or |ReportPartCollision|.
+  // Forgets the collisions reported during the previous step.  This must be
+  // called after the calls to |ApplyPartIntrinsicForce|, and before the calls
+  // to |ReportGroundCollision| or |ReportPartCollision|.
   virtual void PrepareToReportCollisions();
 
   // Notifies |this| that the given part is touching the ground.
@@ -260,7 +274,9 @@ class Plugin {
   // since the last call to |FreeVesselsAndCollectPileUps|, as well as the
   // vessels which transitively touch the ground.  Destroys the parts in loaded
   // vessels for which |InsertOrKeepLoadedPart| has not been called.  Updates
-  // the list of |pile_ups_| according to the reported collisions.
+  // the list of |pile_ups_| according to the reported collisions.  If neither
+  // the parts of the vessels nor the collisions have changed since the previous
+  // call, the existing pile-ups are kept and only recomputed from their parts.
   virtual void FreeVesselsAndPartsAndCollectPileUps(Time const& Δt);
 
   // Calls |SetPartApparentRigidMotion| on the pile-up containing the relevant
@@ -276,6 +292,13 @@ class Plugin {
       PartId part_id,
       RigidMotion<Barycentric, World> const& barycentric_to_world) const;
 
+  // Same as |GetPartActualMotion| for all the parts of the given vessel, which
+  // must be loaded.  The result is in no particular order.
+  virtual std::vector<std::pair<PartId, RigidMotion<EccentricPart, World>>>
+  GetAllPartsActualMotions(
+      GUID const& vessel_guid,
+      RigidMotion<Barycentric, World> const& barycentric_to_world) const;
+
   // Returns the |World| degrees of freedom of the |Celestial| with the given
   // |Index|, identifying the origin of |World| with the centre of mass of the
   // |Part| with the given |PartId|.
@@ -331,6 +354,13 @@ class Plugin {
       Index parent_index,
       GUID const& vessel_guid) const;
 
+  // Same as |VesselFromParent| for each of the vessels with GUIDs in
+  // |vessel_guids|, relative to their current parents, which must have been
+  // set by |InsertOrKeepVessel|.  The degrees of freedom of each parent are
+  // only evaluated once.
+  virtual std::vector<RelativeDegreesOfFreedom<AliceSun>> VesselsFromParent(
+      std::vector<GUID> const& vessel_guids) const;
+
   // Returns the displacement and velocity of the celestial at index
   // |celestial_index| relative to its parent at current time. For a KSP
   // |CelestialBody| |b|, the argument corresponds to |b.flightGlobalsIndex|,
@@ -345,7 +375,24 @@ class Plugin {
       Ephemeris<Barycentric>::AdaptiveStepParameters const&
           prediction_adaptive_step_parameters) const;
 
-  // Updates the prediction for the vessels with guids in |vessel_guids|.
+  // If |max_history_step| is not null, the history steps of the free-falling
+  // pile-ups are selected from their dynamics, up to |*max_history_step|, see
+  // |PileUp::set_max_history_step|.  Otherwise they use the history
+  // parameters.  Not persisted.
+  virtual void SetMaxHistoryStep(std::optional<Time> const& max_history_step);
+
+  // Sets the tolerance used by |UpdatePrediction| for the Keplerian start of
+  // the predictions, see |Vessel::set_prediction_kepler_tolerance|.  Not
+  // persisted.
+  virtual void SetPredictionKeplerTolerance(
+      std::optional<Angle> const& tolerance);
+
+  // Updates the prediction for the vessels with guids in |vessel_guids|.  The
+  // predictions of the first of these vessels, normally the active vessel, and
+  // of the target vessel, if any, are in focus and computed in full.  Those of
+  // the other vessels in |vessel_guids| are out of focus, hence shorter and
+  // refreshed less frequently.  The prognosticators of all the other vessels
+  // are stopped.
   void UpdatePrediction(std::vector<GUID> const& vessel_guids) const;
 
   virtual void CreateFlightPlan(GUID const& vessel_guid,
@@ -357,9 +404,13 @@ class Plugin {
   virtual void ExtendPredictionForFlightPlan(GUID const& vessel_guid) const;
 
   // Computes the apsides of the trajectory defined by |begin| and |end| with
-  // respect to the celestial with index |celestial_index|.
+  // respect to the celestial with index |celestial_index|.  |trajectory| is the
+  // |vessel_trajectory| of the vessel with GUID |vessel_guid|, for which the
+  // apsides are cached.
   virtual void ComputeAndRenderApsides(
       Index celestial_index,
+      GUID const& vessel_guid,
+      VesselTrajectory vessel_trajectory,
       Trajectory<Barycentric> const& trajectory,
       DiscreteTrajectory<Barycentric>::iterator const& begin,
       DiscreteTrajectory<Barycentric>::iterator const& end,
@@ -368,22 +419,44 @@ class Plugin {
       DiscreteTrajectory<World>& apoapsides,
       DiscreteTrajectory<World>& periapsides) const;
 
+  // Integrates the free fall of a massless body whose degrees of freedom in
+  // |frame| at |t_initial| are |degrees_of_freedom|, using the prediction
+  // integrator, and returns its degrees of freedom in |frame| at |t_final|.
+  // Uses a fresh trajectory and doesn't touch the vessels, so it may be called
+  // concurrently; only the ephemeris is prolonged if needed.  |t_final| must
+  // not be before |t_initial|.
+  virtual absl::StatusOr<DegreesOfFreedom<Navigation>> FlowFreefall(
+      NavigationFrame const& frame,
+      DegreesOfFreedom<Navigation> const& degrees_of_freedom,
+      Instant const& t_initial,
+      Instant const& t_final) const;
+
   // Computes the first collision between the trajectory defined by |begin| and
-  // |end| and the celestial with index |celestial_index|.
+  // |end| and the celestial with index |celestial_index|.  |trajectory| is the
+  // |vessel_trajectory| of the vessel with GUID |vessel_guid|, for which the
+  // collision is cached.  |terrain_level_of_detail| identifies the resolution
+  // of |radius|: a collision found with a different resolution is not reused.
   virtual std::optional<DiscreteTrajectory<World>::value_type>
   ComputeAndRenderFirstCollision(
       Index celestial_index,
+      GUID const& vessel_guid,
+      VesselTrajectory vessel_trajectory,
       Trajectory<Barycentric> const& trajectory,
       DiscreteTrajectory<Barycentric>::iterator const& begin,
       DiscreteTrajectory<Barycentric>::iterator const& end,
       Position<World> const& sun_world_position,
       int max_points,
+      int terrain_level_of_detail,
       std::function<Length(Angle const& latitude,
                            Angle const& longitude)> const& radius) const;
 
   // Computes the closest approaches of the trajectory defined by |begin| and
   // |end| with respect to the trajectory of the targetted vessel.
+  // |trajectory| is the |vessel_trajectory| of the vessel with GUID
+  // |vessel_guid|, for which the closest approaches are cached.
   virtual void ComputeAndRenderClosestApproaches(
+      GUID const& vessel_guid,
+      VesselTrajectory vessel_trajectory,
       Trajectory<Barycentric> const& trajectory,
       DiscreteTrajectory<Barycentric>::iterator const& begin,
       DiscreteTrajectory<Barycentric>::iterator const& end,
@@ -506,10 +579,29 @@ class Plugin {
   // whenever |main_body_| or |planetarium_rotation_| changes.
   void UpdatePlanetariumRotation();
 
+  // Logs an estimate of the memory used by the ephemeris, the pile-ups and the
+  // vessels.  The footprint of each vessel is logged at verbosity 1.
+  void LogMemoryFootprints() const;
+
   Velocity<World> VesselVelocity(
       Instant const& time,
       DegreesOfFreedom<Barycentric> const& degrees_of_freedom) const;
 
+  // The quantities displayed on the navball for a vessel, which are queried
+  // several times per frame.
+  struct VesselSnapshot {
+    GUID vessel_guid;
+    Instant time;
+    std::string plotting_frame;
+    OrthogonalMap<Frenet<Navigation>, World> frenet_to_world;
+    Velocity<World> velocity;
+  };
+
+  // Returns the snapshot for the vessel with the given GUID, recomputing it if
+  // the vessel, its last point, the plotting frame or the planetarium rotation
+  // has changed since it was taken.
+  VesselSnapshot const& GetVesselSnapshot(GUID const& vessel_guid) const;
+
   // Fill |celestials| using the |index| and |parent_index| fields found in
   // |celestial_messages|.
   template<typename T>
@@ -530,6 +622,15 @@ class Plugin {
   // Whether |loaded_vessels_| contains |vessel|.
   bool is_loaded(not_null<Vessel*> vessel) const;
 
+  // Erases the results cached for the trajectories of the vessel with GUID
+  // |vessel_guid|, which is being removed.
+  void EraseCachedResults(GUID const& vessel_guid);
+
+  // Partitions the parts into subsets using union-find on the vessels and the
+  // reported collisions, destroys the grounded vessels and collects the
+  // subsets into pile-ups.
+  void RebuildPileUps(Time const& Δt);
+
   // Initialization objects.
   Monostable initializing_;
   serialization::GravityModel gravity_model_;
@@ -560,6 +661,8 @@ class Plugin {
   DiscreteTrajectorySegment<Barycentric>::DownsamplingParameters
       history_downsampling_parameters_;
   Ephemeris<Barycentric>::FixedStepParameters history_fixed_step_parameters_;
+  std::optional<Time> max_history_step_;
+  std::optional<Angle> prediction_kepler_tolerance_;
   Ephemeris<Barycentric>::AdaptiveStepParameters psychohistory_parameters_;
 
   // The thread pool for advancing vessels.
@@ -579,6 +682,68 @@ class Plugin {
   // Not null after initialization.
   std::unique_ptr<Renderer> renderer_;
 
+  // The cache shared by the planetariums returned by |NewPlanetarium|, and the
+  // serialized plotting frame for which its samples are valid.  Null if no
+  // planetarium has been created since the last change of plotting frame.
+  mutable std::unique_ptr<Planetarium::SampleCache> planetarium_sample_cache_;
+  mutable std::string planetarium_sample_cache_plotting_frame_;
+
+  // The last snapshot returned by |GetVesselSnapshot|.  Reset by |AdvanceTime|,
+  // which changes the planetarium rotation.  Only used on the main thread.
+  mutable std::optional<VesselSnapshot> vessel_snapshot_;
+
+  // The result of the last call to |ComputeAndRenderFirstCollision| for each
+  // vessel, trajectory of that vessel, celestial and level of detail of the
+  // terrain, and the fingerprint of the trajectory for which it is valid.  The
+  // entries of a vessel are erased when it is removed.  Written by the threads
+  // of the collision executors.
+  struct CachedCollision {
+    std::size_t fingerprint;
+    std::optional<DiscreteTrajectory<Barycentric>::value_type> collision;
+  };
+  mutable absl::Mutex collision_cache_lock_;
+  mutable absl::flat_hash_map<
+      GUID,
+      absl::flat_hash_map<std::tuple<VesselTrajectory, Index, int>,
+                          CachedCollision>>
+      collision_cache_ GUARDED_BY(collision_cache_lock_);
+
+  // The apsides found by the last call to |ComputeAndRenderApsides| for each
+  // vessel, trajectory of that vessel, celestial and |max_points|, and the time
+  // and hash of each point of the trajectory that was scanned.  The entries of
+  // a vessel are erased when it is removed.  Only used on the main thread.
+  struct CachedApsides {
+    std::vector<Instant> point_times;
+    std::vector<std::size_t> point_hashes;
+    DiscreteTrajectory<Barycentric> apoapsides;
+    DiscreteTrajectory<Barycentric> periapsides;
+  };
+  mutable absl::flat_hash_map<
+      GUID,
+      absl::flat_hash_map<std::tuple<VesselTrajectory, Index, int>,
+                          CachedApsides>>
+      apsides_cache_;
+
+  // The apsides with respect to the target vessel found by the last call to
+  // |ComputeAndRenderClosestApproaches| for each vessel, trajectory of that
+  // vessel and |max_points|, and the time and hash of each point of the
+  // trajectory that was scanned and of the prediction of the target vessel.
+  // The entries of a vessel are erased when it is removed.  Only used on the
+  // main thread.
+  struct CachedClosestApproaches {
+    std::vector<Instant> point_times;
+    std::vector<std::size_t> point_hashes;
+    std::vector<Instant> target_point_times;
+    std::vector<std::size_t> target_point_hashes;
+    DiscreteTrajectory<Barycentric> apoapsides;
+    DiscreteTrajectory<Barycentric> periapsides;
+  };
+  mutable absl::flat_hash_map<
+      GUID,
+      absl::flat_hash_map<std::pair<VesselTrajectory, int>,
+                          CachedClosestApproaches>>
+      closest_approaches_cache_;
+
   RotatingBody<Barycentric> const* main_body_ = nullptr;
   AngularVelocity<Barycentric> angular_velocity_of_world_;
 
@@ -591,6 +756,16 @@ class Plugin {
   VesselSet loaded_vessels_;
   // The vessels that will be kept during the next call to |AdvanceTime|.
   VesselConstSet kept_vessels_;
+
+  // The collisions reported since the last call to |PrepareToReportCollisions|.
+  // The pairs are ordered.  Mutable because the reporting functions are const.
+  mutable std::set<std::pair<PartId, PartId>> part_collisions_;
+  mutable std::set<PartId> ground_collisions_;
+  // The part collisions used to build the current pile-ups.
+  std::set<std::pair<PartId, PartId>> previous_part_collisions_;
+  // True if parts were added, removed, or moved between vessels since the
+  // pile-ups were last built, in which case they must be rebuilt.
+  bool pile_up_topology_changed_ = true;
   // Contains the adaptive step parameters for the vessel that existed in the
   // past but are no longer known to the plugin.  Useful to avoid losing the
   // parameters, e.g., when a vessel hits the ground.
@@ -601,6 +776,10 @@ class Plugin {
 
   std::optional<GeometricPotentialPlotter> geometric_potential_plotter_;
 
+  // The wall-clock time at which the memory footprints were last logged.
+  std::chrono::steady_clock::time_point last_memory_footprint_logging_time_ =
+      std::chrono::steady_clock::now();
+
   friend class NavballFrameField;
   friend class ksp_plugin::TestablePlugin;
 };
@@ -609,6 +788,7 @@ class Plugin {
 
 using internal::Index;
 using internal::Plugin;
+using internal::VesselTrajectory;
 
 }  // namespace _plugin
 }  // namespace ksp_plugin
@@ -10,6 +10,7 @@
 #include "geometry/permutation.hpp"
 #include "physics/body_centred_body_direction_reference_frame.hpp"
 #include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory_segment.hpp"
 
 namespace principia {
 namespace ksp_plugin {
@@ -21,14 +22,22 @@ using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_permutation;
 using namespace principia::physics::_body_centred_body_direction_reference_frame;  // NOLINT
 using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory_segment;
 
 Renderer::Renderer(not_null<Celestial const*> const sun,
                    not_null<std::unique_ptr<PlottingFrame>> plotting_frame)
     : sun_(sun),
-      plotting_frame_(std::move(plotting_frame)) {}
+      plotting_frame_(std::move(plotting_frame)),
+      plotting_frame_motions_(
+          make_not_null_unique<PlottingFrameMotions>(plotting_frame_.get())) {}
 
 void Renderer::SetPlottingFrame(
     not_null<std::unique_ptr<PlottingFrame>> plotting_frame) {
+  // Create the new cache before destroying the old frame, which is referenced
+  // by the old cache.
+  auto plotting_frame_motions =
+      make_not_null_unique<PlottingFrameMotions>(plotting_frame.get());
+  plotting_frame_motions_ = std::move(plotting_frame_motions);
   plotting_frame_ = std::move(plotting_frame);
 }
 
@@ -37,6 +46,10 @@ not_null<PlottingFrame const*> Renderer::GetPlottingFrame() const {
                  : plotting_frame_.get();
 }
 
+PlottingFrameMotions const* Renderer::GetPlottingFrameMotions() const {
+  return target_ ? nullptr : plotting_frame_motions_.get();
+}
+
 void Renderer::SetTargetVessel(
     not_null<Vessel*> const vessel,
     not_null<Celestial const*> const celestial,
@@ -95,10 +108,11 @@ Renderer::RenderBarycentricTrajectoryInPlotting(
     DiscreteTrajectory<Barycentric>::iterator const& begin,
     DiscreteTrajectory<Barycentric>::iterator const& end) const {
   DiscreteTrajectory<Navigation> trajectory;
+  DiscreteTrajectorySegment<Barycentric> const* const prediction =
+      target_ ? &*target_->vessel->prediction() : nullptr;
   for (auto it = begin; it != end; ++it) {
     auto const& [time, degrees_of_freedom] = *it;
-    if (target_) {
-      auto const prediction = target_->vessel->prediction();
+    if (prediction != nullptr) {
       if (time < prediction->t_min()) {
         continue;
       } else if (time > prediction->t_max()) {
@@ -149,22 +163,23 @@ Renderer::RenderPlottingTrajectoryInWorld(
   // camera is fixed in the plotting frame and project there; additional data
   // can be gathered from the velocities in the plotting frame as needed and
   // sent directly to be shown in markers.
+  // The maps that don't depend on |t| are computed once for the entire
+  // trajectory.  At |t| we only need the scale of |PlottingToWorld|, which is
+  // that of |PlottingToBarycentric| since the map from |Barycentric| to |World|
+  // is orthogonal.
   Similarity<Navigation, World> const
       from_plotting_frame_to_world_at_current_time =
           PlottingToWorld(time, sun_world_position, planetarium_rotation);
+  Permutation<Navigation, World> const yxz(
+      Permutation<Navigation, World>::CoordinatePermutation::YXZ);
   for (auto const& [t, degrees_of_freedom] : Range(begin, end)) {
     DegreesOfFreedom<Navigation> const& navigation_degrees_of_freedom =
         degrees_of_freedom;
-    ConformalMap<double, Navigation, World> const
-        from_plotting_frame_to_world_at_t =
-            PlottingToWorld(t, planetarium_rotation);
+    double const scale_at_t = PlottingToBarycentric(t).scale();
     DegreesOfFreedom<World> const world_degrees_of_freedom = {
         from_plotting_frame_to_world_at_current_time(
             navigation_degrees_of_freedom.position()),
-        Permutation<Navigation, World>(
-            Permutation<Navigation, World>::CoordinatePermutation::YXZ)(
-            from_plotting_frame_to_world_at_t.scale() *
-            navigation_degrees_of_freedom.velocity())};
+        yxz(scale_at_t * navigation_degrees_of_freedom.velocity())};
     trajectory.Append(t, world_degrees_of_freedom).IgnoreError();
   }
   return trajectory;
@@ -172,7 +187,11 @@ Renderer::RenderPlottingTrajectoryInWorld(
 
 SimilarMotion<Barycentric, Navigation> Renderer::BarycentricToPlotting(
     Instant const& time) const {
-  return GetPlottingFrame()->ToThisFrameAtTimeSimilarly(time);
+  if (target_) {
+    return target_->target_frame->ToThisFrameAtTimeSimilarly(time);
+  } else {
+    return plotting_frame_motions_->ToPlottingFrameAtTime(time);
+  }
 }
 
 RigidTransformation<Barycentric, World> Renderer::BarycentricToWorld(
@@ -244,7 +263,7 @@ OrthogonalMap<Frenet<Navigation>, World> Renderer::FrenetToWorld(
 
 ConformalMap<double, Navigation, Barycentric> Renderer::PlottingToBarycentric(
     Instant const& time) const {
-  return GetPlottingFrame()->FromThisFrameAtTimeSimilarly(time).conformal_map();
+  return FromPlottingFrameAtTime(time).conformal_map();
 }
 
 Similarity<Navigation, World> Renderer::PlottingToWorld(
@@ -253,7 +272,7 @@ Similarity<Navigation, World> Renderer::PlottingToWorld(
     Rotation<Barycentric, AliceSun> const& planetarium_rotation) const {
   return BarycentricToWorld(time, sun_world_position, planetarium_rotation)
              .Forget<Similarity>() *
-         GetPlottingFrame()->FromThisFrameAtTimeSimilarly(time).similarity();
+         FromPlottingFrameAtTime(time).similarity();
 }
 
 ConformalMap<double, Navigation, World> Renderer::PlottingToWorld(
@@ -295,8 +314,7 @@ Rotation<CameraCompensatedReference, World> Renderer::CameraReferenceRotation(
   Permutation<CameraReference, Navigation> const camera_mirror(
       OddPermutation::XZY);
   return (BarycentricToWorld(planetarium_rotation) *
-          GetPlottingFrame()->FromThisFrameAtTimeSimilarly(time)
-              .conformal_map().orthogonal_map¹₁() *
+          FromPlottingFrameAtTime(time).conformal_map().orthogonal_map¹₁() *
           camera_mirror.Forget<OrthogonalMap>()).AsRotation() *
          camera_compensation;
 }
@@ -316,6 +334,15 @@ not_null<std::unique_ptr<Renderer>> Renderer::ReadFromMessage(
       PlottingFrame::ReadFromMessage(message.plotting_frame(), ephemeris));
 }
 
+SimilarMotion<Navigation, Barycentric> Renderer::FromPlottingFrameAtTime(
+    Instant const& time) const {
+  if (target_) {
+    return target_->target_frame->FromThisFrameAtTimeSimilarly(time);
+  } else {
+    return plotting_frame_motions_->FromPlottingFrameAtTime(time);
+  }
+}
+
 Renderer::Target::Target(
     not_null<Vessel*> const vessel,
     not_null<Celestial const*> const celestial,
@@ -14,6 +14,8 @@
 #include "geometry/space_transformations.hpp"
 #include "ksp_plugin/celestial.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
+#include "ksp_plugin/plotting_frame_motions.hpp"
 #include "ksp_plugin/vessel.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
@@ -38,6 +40,7 @@ using namespace principia::geometry::_space;
 using namespace principia::geometry::_space_transformations;
 using namespace principia::ksp_plugin::_celestial;
 using namespace principia::ksp_plugin::_frames;
+using namespace principia::ksp_plugin::_plotting_frame_motions;
 using namespace principia::ksp_plugin::_vessel;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_ephemeris;
@@ -62,6 +65,11 @@ class Renderer {
   // |SetPlottingFrame| if it is overridden by a target vessel.
   virtual not_null<PlottingFrame const*> GetPlottingFrame() const;
 
+  // Returns a cache of the motions of the current plotting frame, or null if
+  // there is a target vessel.  A different object is returned after the
+  // plotting frame changes.
+  virtual PlottingFrameMotions const* GetPlottingFrameMotions() const;
+
   // Overrides the current plotting frame with one that is centred on the given
   // |vessel|.
   virtual void SetTargetVessel(
@@ -185,6 +193,9 @@ class Renderer {
       not_null<Ephemeris<Barycentric> const*> ephemeris);
 
  private:
+  SimilarMotion<Navigation, Barycentric> FromPlottingFrameAtTime(
+      Instant const& time) const;
+
   struct Target {
     Target(not_null<Vessel*> vessel,
            not_null<Celestial const*> celestial,
@@ -197,6 +208,10 @@ class Renderer {
   not_null<Celestial const*> const sun_;
 
   not_null<std::unique_ptr<PlottingFrame>> plotting_frame_;
+  // The motions of |plotting_frame_|, shared by all the transformations and
+  // by the planetaria, and preserved across frames.  Not used when there is a
+  // target vessel, as its frame changes with its prediction.
+  not_null<std::unique_ptr<PlottingFrameMotions>> plotting_frame_motions_;
 
   std::optional<Target> target_;
 };
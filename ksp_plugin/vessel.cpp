@@ -1,18 +1,31 @@
 #include "ksp_plugin/vessel.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
+#include <future>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "absl/container/btree_set.h"
+#include "base/jthread.hpp"
 #include "base/map_util.hpp"
+#include "base/thread_pool.hpp"
+#include "base/tracing.hpp"
 #include "base/traits.hpp"
 #include "geometry/barycentre_calculator.hpp"
+#include "geometry/space.hpp"
+#include "google/protobuf/arena.h"
 #include "ksp_plugin/integrators.hpp"
+#include "physics/kepler_orbit.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
 #include "testing_utilities/make_not_null.hpp"
 
 namespace principia {
@@ -20,11 +33,19 @@ namespace ksp_plugin {
 namespace _vessel {
 namespace internal {
 
+using ::google::protobuf::Arena;
 using ::std::placeholders::_1;
+using namespace principia::base::_jthread;
 using namespace principia::base::_map_util;
+using namespace principia::base::_thread_pool;
+using namespace principia::base::_tracing;
 using namespace principia::base::_traits;
 using namespace principia::geometry::_barycentre_calculator;
+using namespace principia::geometry::_space;
 using namespace principia::ksp_plugin::_integrators;
+using namespace principia::physics::_kepler_orbit;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_si;
 using namespace principia::testing_utilities::_make_not_null;
 
 using namespace std::chrono_literals;
@@ -32,18 +53,81 @@ using namespace std::chrono_literals;
 // TODO(phl): Move this to some kind of parameters.
 constexpr std::int64_t max_points_to_serialize = 20'000;
 
+// A prediction that is out of focus has at most this number of steps and is
+// not requested more often than this (wall-clock) period.
+constexpr std::int64_t max_steps_in_prediction_out_of_focus = 1 << 12;
+constexpr std::chrono::steady_clock::duration
+    prognostication_period_out_of_focus = 1s;
+
+bool SameAdaptiveStepParameters(
+    Ephemeris<Barycentric>::AdaptiveStepParameters const& left,
+    Ephemeris<Barycentric>::AdaptiveStepParameters const& right) {
+  return &left.integrator() == &right.integrator() &&
+         left.max_steps() == right.max_steps() &&
+         left.length_integration_tolerance() ==
+             right.length_integration_tolerance() &&
+         left.speed_integration_tolerance() ==
+             right.speed_integration_tolerance();
+}
+
+// If the serialized |history| of a vessel has nonempty segments prior to its
+// backstory, returns them as a separate message and stores the backstory, the
+// psychohistory and the prediction in |recent_history|.  Otherwise, returns
+// nullopt and leaves |recent_history| untouched.
+std::optional<serialization::DiscreteTrajectory> SplitSerializedHistory(
+    serialization::DiscreteTrajectory const& history,
+    serialization::DiscreteTrajectory& recent_history) {
+  // The history must be made of a number of segments followed by the tracked
+  // backstory, psychohistory and prediction.
+  int const backstory_position = history.segment_size() - 3;
+  if (backstory_position <= 0 || history.tracked_position_size() != 3) {
+    return std::nullopt;
+  }
+  for (int i = 0; i < 3; ++i) {
+    if (history.tracked_position(i) != backstory_position + i) {
+      return std::nullopt;
+    }
+  }
+  if (history.segment_by_left_endpoint().empty() ||
+      history.segment_by_left_endpoint(0).segment() >= backstory_position ||
+      history.segment_by_left_endpoint().rbegin()->segment() <
+          backstory_position) {
+    return std::nullopt;
+  }
+
+  serialization::DiscreteTrajectory older_history;
+  recent_history.Clear();
+  for (int i = 0; i < history.segment_size(); ++i) {
+    *(i < backstory_position ? older_history.add_segment()
+                             : recent_history.add_segment()) =
+        history.segment(i);
+  }
+  for (auto const& segment_by_left_endpoint :
+       history.segment_by_left_endpoint()) {
+    if (segment_by_left_endpoint.segment() < backstory_position) {
+      *older_history.add_segment_by_left_endpoint() = segment_by_left_endpoint;
+    } else {
+      auto* const recent_segment_by_left_endpoint =
+          recent_history.add_segment_by_left_endpoint();
+      *recent_segment_by_left_endpoint = segment_by_left_endpoint;
+      recent_segment_by_left_endpoint->set_segment(
+          segment_by_left_endpoint.segment() - backstory_position);
+    }
+  }
+  for (int i = 0; i < 3; ++i) {
+    recent_history.add_tracked_position(i);
+  }
+  return older_history;
+}
+
 bool operator!=(Vessel::PrognosticatorParameters const& left,
                 Vessel::PrognosticatorParameters const& right) {
   return left.first_time != right.first_time ||
          left.first_degrees_of_freedom != right.first_degrees_of_freedom ||
-         &left.adaptive_step_parameters.integrator() !=
-             &right.adaptive_step_parameters.integrator() ||
-         left.adaptive_step_parameters.max_steps() !=
-             right.adaptive_step_parameters.max_steps() ||
-         left.adaptive_step_parameters.length_integration_tolerance() !=
-             right.adaptive_step_parameters.length_integration_tolerance() ||
-         left.adaptive_step_parameters.speed_integration_tolerance() !=
-             right.adaptive_step_parameters.speed_integration_tolerance();
+         !SameAdaptiveStepParameters(left.adaptive_step_parameters,
+                                     right.adaptive_step_parameters) ||
+         left.kepler_tolerance != right.kepler_tolerance ||
+         left.primary != right.primary;
 }
 
 Vessel::Vessel(
@@ -70,7 +154,9 @@ Vessel::Vessel(
           [this](Instant const& desired_t_min) {
             return Reanimate(desired_t_min);
           },
-          20ms),  // 50 Hz.
+          20ms,  // 50 Hz.
+          &scheduler(),
+          RecurringThreadScheduler::Priority::Background),
       reanimator_clientele_(/*default_value=*/InfiniteFuture),
       backstory_(trajectory_.segments().begin()),
       psychohistory_(trajectory_.segments().end()),
@@ -79,7 +165,9 @@ Vessel::Vessel(
           [this](PrognosticatorParameters const& parameters) {
             return FlowPrognostication(parameters);
           },
-          20ms)  // 50 Hz.
+          20ms,  // 50 Hz.
+          &scheduler(),
+          RecurringThreadScheduler::Priority::Interactive)
 {}
 
 Vessel::~Vessel() {
@@ -234,6 +322,11 @@ void Vessel::DetectCollapsibilityChange() {
       }
     }
 
+    // Deleting the backstory makes the preceding segment the backstory, so it
+    // must exist.
+    if (segment_action == Delete) {
+      MaterializeHistory();
+    }
     auto psychohistory = trajectory_.DetachSegments(psychohistory_);
     switch (segment_action) {
       case Create: {
@@ -285,6 +378,17 @@ void Vessel::DisableDownsampling() {
   downsampling_parameters_ = std::nullopt;
 }
 
+void Vessel::EnableHistoryArchive(std::filesystem::path const& path,
+                                  Time const& age) {
+  CHECK_LT(Time{}, age);
+  history_archive_ = std::make_unique<TrajectoryArchive<Barycentric>>(path);
+  history_archive_age_ = age;
+}
+
+TrajectoryArchive<Barycentric> const* Vessel::history_archive() const {
+  return history_archive_.get();
+}
+
 not_null<Part*> Vessel::part(PartId const id) const {
   return FindOrDie(parts_, id).get();
 }
@@ -301,6 +405,7 @@ void Vessel::ForAllParts(std::function<void(Part&)> action) const {
 }
 
 DiscreteTrajectory<Barycentric> const& Vessel::trajectory() const {
+  MaterializeHistory();
   return trajectory_;
 }
 
@@ -323,6 +428,34 @@ Vessel::prediction_adaptive_step_parameters() const {
   return prediction_adaptive_step_parameters_;
 }
 
+void Vessel::set_prediction_kepler_tolerance(
+    std::optional<Angle> const& tolerance) {
+  if (prediction_kepler_tolerance_ != tolerance) {
+    prediction_kepler_tolerance_ = tolerance;
+    // Don't extend a prediction computed with a different tolerance.
+    prognostication_adaptive_step_parameters_.reset();
+  }
+}
+
+void Vessel::set_prediction_in_focus(bool const in_focus) {
+  if (prediction_in_focus_ == in_focus) {
+    return;
+  }
+  prediction_in_focus_ = in_focus;
+  prognosticator_.SetPriority(
+      in_focus ? RecurringThreadScheduler::Priority::Interactive
+               : RecurringThreadScheduler::Priority::Background);
+}
+
+bool Vessel::prediction_in_focus() const {
+  return prediction_in_focus_;
+}
+
+IntegrationStatistics<Time> Vessel::prognostication_statistics() const {
+  absl::ReaderMutexLock l(&lock_);
+  return prognostication_statistics_;
+}
+
 bool Vessel::has_flight_plan() const {
   return !flight_plans_.empty();
 }
@@ -445,7 +578,9 @@ void Vessel::AdvanceTime() {
   // pre-existing prediction.
   auto optional_prognostication = prognosticator_.Get();
   if (optional_prognostication.has_value()) {
-    AttachPrediction(std::move(optional_prognostication.value()));
+    AttachPrediction(
+        MergePrognostication(std::move(prediction),
+                             std::move(optional_prognostication).value()));
   } else {
     AttachPrediction(std::move(prediction));
   }
@@ -453,9 +588,13 @@ void Vessel::AdvanceTime() {
   for (auto const& [_, part] : parts_) {
     part->ClearHistory();
   }
+
+  ArchiveHistoryIfNeeded();
 }
 
 void Vessel::RequestReanimation(Instant const& desired_t_min) {
+  // The reanimation proceeds from the beginning of the history.
+  MaterializeHistory();
   reanimator_.Start();
 
   // No locking here because vessel reanimation is only invoked from the main
@@ -600,6 +739,7 @@ absl::Status Vessel::RebaseFlightPlan(Mass const& initial_mass) {
 }
 
 void Vessel::RefreshPrediction() {
+  TracingScope tracing_scope("Vessel::RefreshPrediction");
   // The |prognostication| is a trajectory which is computed asynchronously and
   // may be used as a prediction;
   std::optional<DiscreteTrajectory<Barycentric>> prognostication;
@@ -607,23 +747,88 @@ void Vessel::RefreshPrediction() {
   // Note that we know that |RefreshPrediction| is called on the main thread,
   // therefore the ephemeris currently covers the last time of the
   // psychohistory.  Were this to change, this code might have to change.
+  auto const& [psychohistory_last_time, psychohistory_last_degrees_of_freedom] =
+      psychohistory_->back();
+  auto adaptive_step_parameters = prediction_adaptive_step_parameters_;
+  if (!prediction_in_focus_) {
+    adaptive_step_parameters.set_max_steps(
+        std::min(adaptive_step_parameters.max_steps(),
+                 max_steps_in_prediction_out_of_focus));
+  }
   PrognosticatorParameters prognosticator_parameters{
-      psychohistory_->back().time,
-      psychohistory_->back().degrees_of_freedom,
-      prediction_adaptive_step_parameters_};
-  if (synchronous_) {
-    auto status_or_prognostication =
-        FlowPrognostication(std::move(prognosticator_parameters));
-    if (status_or_prognostication.ok()) {
-      prognostication = std::move(status_or_prognostication).value();
+      psychohistory_last_time,
+      psychohistory_last_degrees_of_freedom,
+      adaptive_step_parameters,
+      prediction_kepler_tolerance_,
+      parent_->body()};
+  bool const same_parameters =
+      prognostication_adaptive_step_parameters_.has_value() &&
+      SameAdaptiveStepParameters(*prognostication_adaptive_step_parameters_,
+                                 adaptive_step_parameters);
+
+  // Out of focus, a new prognostication is only requested once in a while,
+  // unless the parameters changed.  An earlier request may still complete.
+  auto const now = std::chrono::steady_clock::now();
+  bool const throttled =
+      !prediction_in_focus_ && same_parameters &&
+      now < prognostication_request_time_ + prognostication_period_out_of_focus;
+
+  if (!throttled) {
+    // If the parameters didn't change and the vessel is still on its predicted
+    // trajectory within the integration tolerances, i.e., it is coasting, the
+    // prediction remains valid and we only need to integrate its
+    // continuation.  |MergePrognostication| splices the result.
+    if (same_parameters &&
+        prediction_ != trajectory_.segments().end() &&
+        !prediction_->empty() &&
+        prediction_->front().time <= psychohistory_last_time &&
+        psychohistory_last_time < prediction_->back().time) {
+      DegreesOfFreedom<Barycentric> const predicted_degrees_of_freedom =
+          prediction_->EvaluateDegreesOfFreedom(psychohistory_last_time);
+      if ((predicted_degrees_of_freedom.position() -
+           psychohistory_last_degrees_of_freedom.position()).Norm() <=
+              adaptive_step_parameters.length_integration_tolerance() &&
+          (predicted_degrees_of_freedom.velocity() -
+           psychohistory_last_degrees_of_freedom.velocity()).Norm() <=
+              adaptive_step_parameters.speed_integration_tolerance()) {
+        // The points of the prediction count towards its maximum number of
+        // steps.  If there is no room left, there is nothing to integrate.
+        std::int64_t const remaining_steps =
+            adaptive_step_parameters.max_steps() - (prediction_->size() - 1);
+        if (remaining_steps <= 0) {
+          return;
+        }
+        auto const& [prediction_last_time,
+                     prediction_last_degrees_of_freedom] = prediction_->back();
+        prognosticator_parameters.first_time = prediction_last_time;
+        prognosticator_parameters.first_degrees_of_freedom =
+            prediction_last_degrees_of_freedom;
+        prognosticator_parameters.adaptive_step_parameters.set_max_steps(
+            remaining_steps);
+      }
     }
-  } else {
-    prognosticator_.Put(std::move(prognosticator_parameters));
-    prognosticator_.Start();
+    prognostication_adaptive_step_parameters_ = adaptive_step_parameters;
+    prognostication_request_time_ = now;
+
+    if (synchronous_) {
+      auto status_or_prognostication =
+          FlowPrognostication(std::move(prognosticator_parameters));
+      if (status_or_prognostication.ok()) {
+        prognostication = std::move(status_or_prognostication).value();
+      }
+    } else {
+      prognosticator_.Put(std::move(prognosticator_parameters));
+      prognosticator_.Start();
+    }
+  }
+  if (!synchronous_) {
     prognostication = prognosticator_.Get();
   }
   if (prognostication.has_value()) {
-    AttachPrediction(std::move(prognostication).value());
+    auto prediction = trajectory_.DetachSegments(prediction_);
+    prediction_ = trajectory_.segments().end();
+    AttachPrediction(MergePrognostication(std::move(prediction),
+                                          std::move(prognostication).value()));
   }
 }
 
@@ -645,11 +850,6 @@ void Vessel::RequestOrbitAnalysis(Time const& mission_duration) {
     // default will do in the meantime.
     orbit_analyser_.emplace(ephemeris_, DefaultHistoryParameters());
   }
-  if (orbit_analyser_->last_parameters().has_value() &&
-      orbit_analyser_->last_parameters()->mission_duration !=
-          mission_duration) {
-    orbit_analyser_->Interrupt();
-  }
   orbit_analyser_->RequestAnalysis(
       {.first_time = psychohistory_->back().time,
        .first_degrees_of_freedom = psychohistory_->back().degrees_of_freedom,
@@ -681,9 +881,32 @@ std::string Vessel::ShortDebugString() const {
   return name_ + " (" + guid_ + ")";
 }
 
+std::int64_t Vessel::MemoryFootprint() const {
+  std::int64_t footprint = sizeof(*this) + checkpointer_->MemoryFootprint();
+  {
+    absl::ReaderMutexLock l(&lock_);
+    footprint += trajectory_.MemoryFootprint();
+    if (serialized_history_.has_value()) {
+      footprint += serialized_history_->SpaceUsedLong();
+    }
+  }
+  for (auto const& flight_plan : flight_plans_) {
+    if (std::holds_alternative<OptimizableFlightPlan>(flight_plan)) {
+      footprint += std::get<OptimizableFlightPlan>(flight_plan)
+                       .flight_plan->MemoryFootprint();
+    } else {
+      footprint +=
+          std::get<serialization::FlightPlan>(flight_plan).SpaceUsedLong();
+    }
+  }
+  return footprint;
+}
+
 void Vessel::WriteToMessage(not_null<serialization::Vessel*> const message,
                             PileUp::SerializationIndexForPileUp const&
                                 serialization_index_for_pile_up) const {
+  // The serialized history may extend before the |backstory_|.
+  MaterializeHistory();
   message->set_guid(guid_);
   message->set_name(name_);
   body_.WriteToMessage(message->mutable_body());
@@ -696,6 +919,10 @@ void Vessel::WriteToMessage(not_null<serialization::Vessel*> const message,
         downsampling_parameters_->max_dense_intervals);
     downsampling_parameters_->tolerance.WriteToMessage(
         serialized_downsampling_parameters->mutable_tolerance());
+    if (downsampling_parameters_->max_fits_per_append.has_value()) {
+      serialized_downsampling_parameters->set_max_fits_per_append(
+          *downsampling_parameters_->max_fits_per_append);
+    }
   }
   for (auto const& [_, part] : parts_) {
     part->WriteToMessage(message->add_parts(), serialization_index_for_pile_up);
@@ -793,6 +1020,9 @@ not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
     vessel->kept_parts_.insert(part_id);
   }
 
+  // Set if the beginning of the history is kept in serialized form.
+  std::optional<Instant> history_t_min;
+
   if (is_pre_cesàro) {
     auto const psychohistory =
         DiscreteTrajectory<Barycentric>::ReadFromMessage(message.history(),
@@ -839,8 +1069,22 @@ not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
     vessel->backstory_ = std::prev(vessel->psychohistory_);
     vessel->downsampling_parameters_ = DefaultDownsamplingParameters();
   } else {
+    // Only the segments starting at the backstory are needed to integrate the
+    // vessel, the older ones are deserialized when first needed.  The recent
+    // segments are only copied to be deserialized, so they are allocated on an
+    // arena which is released in one go.
+    Arena arena;
+    not_null<serialization::DiscreteTrajectory*> const recent_history =
+        Arena::CreateMessage<serialization::DiscreteTrajectory>(&arena);
+    vessel->serialized_history_ =
+        SplitSerializedHistory(message.history(), *recent_history);
+    if (vessel->serialized_history_.has_value()) {
+      history_t_min = Instant::ReadFromMessage(
+          message.history().segment_by_left_endpoint(0).left_endpoint());
+    }
     vessel->trajectory_ = DiscreteTrajectory<Barycentric>::ReadFromMessage(
-        message.history(),
+        vessel->serialized_history_.has_value() ? *recent_history
+                                                : message.history(),
         /*tracked=*/{&vessel->backstory_,
                      &vessel->psychohistory_,
                      &vessel->prediction_});
@@ -858,6 +1102,10 @@ not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
                   message.downsampling_parameters().max_dense_intervals(),
               .tolerance = Length::ReadFromMessage(
                   message.downsampling_parameters().tolerance())};
+      if (message.downsampling_parameters().has_max_fits_per_append()) {
+        vessel->downsampling_parameters_->max_fits_per_append =
+            message.downsampling_parameters().max_fits_per_append();
+      }
     } else {
       vessel->downsampling_parameters_ = std::nullopt;
     }
@@ -884,38 +1132,18 @@ not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
   // end of the trajectory from the serialized form.  Interestingly enough, that
   // checkpoint (that is, the non-collapsible segment) may overlap the beginning
   // of the trajectory that we just deserialized, in which case we must rebuild
-  // the front part of the non-collapsible segment to make sure that the
-  // trajectory doesn't start in the middle of a non-collapsible segment (the
-  // integration of the preceding collapsible segment would not end at the right
-  // time if it did).
-  Instant const checkpoint =
-      vessel->checkpointer_->checkpoint_at_or_after(
-          vessel->trajectory().t_min());
+  // the front part of the non-collapsible segment, see
+  // |RestoreCheckpointOverlappingHistory|.  If the beginning of the history is
+  // still serialized, this happens when it is materialized.
+  Instant const checkpoint = vessel->checkpointer_->checkpoint_at_or_after(
+      history_t_min.value_or(vessel->trajectory_.t_min()));
   if (checkpoint != InfiniteFuture) {
-    CHECK_OK(vessel->checkpointer_->ReadFromCheckpointAt(
-        checkpoint,
-        [checkpoint, &vessel](
-            serialization::Vessel::Checkpoint const& message) {
-          // This code is similar to the one in ReanimateOneCheckpoint except
-          // that (1) we never need to reconstruct a collapsible segment; (2) we
-          // may actually have to truncate the non-collapsible segment obtained
-          // from the checkpoint.
-          LOG(INFO) << "Restoring " << vessel->ShortDebugString()
-                    << " to initial checkpoint at " << checkpoint;
-
-          DiscreteTrajectorySegmentIterator<Barycentric> unused;
-          auto reanimated_trajectory =
-              DiscreteTrajectory<Barycentric>::ReadFromMessage(
-                  message.non_collapsible_segment(),
-                  /*tracked=*/{&unused});
-          CHECK(!reanimated_trajectory.empty());
-          CHECK_EQ(checkpoint, reanimated_trajectory.back().time);
-          reanimated_trajectory.ForgetAfter(vessel->trajectory().t_min());
-          if (!reanimated_trajectory.empty()) {
-            vessel->trajectory_.Merge(std::move(reanimated_trajectory));
-          }
-          return absl::OkStatus();
-        }));
+    absl::MutexLock l(&vessel->lock_);
+    if (history_t_min.has_value()) {
+      vessel->checkpoint_overlapping_serialized_history_ = checkpoint;
+    } else {
+      vessel->RestoreCheckpointOverlappingHistory(checkpoint);
+    }
   }
   vessel->oldest_reanimated_checkpoint_ = checkpoint;
 
@@ -941,6 +1169,17 @@ void Vessel::MakeSynchronous() {
   synchronous_ = true;
 }
 
+RecurringThreadScheduler& Vessel::scheduler() {
+  // One worker is reserved for the prognostications, so that the prediction of
+  // the active vessel doesn't wait for the reanimations to complete.
+  static int const workers =
+      std::max<int>(2, std::thread::hardware_concurrency());
+  // Never destroyed, to avoid problems with the order of static destructions.
+  static auto* const scheduler = new RecurringThreadScheduler(
+      workers, /*max_background_workers=*/workers - 1);
+  return *scheduler;
+}
+
 Vessel::Vessel()
     : body_(),
       prediction_adaptive_step_parameters_(DefaultPredictionParameters()),
@@ -1009,23 +1248,89 @@ absl::Status Vessel::Reanimate(Instant const desired_t_min) {
     checkpoints.erase(oldest_reanimated_checkpoint_);
   }
 
-  for (auto it = checkpoints.crbegin(); it != checkpoints.crend(); ++it) {
-    Instant const& checkpoint = *it;
+  // Each checkpoint is reanimated from its time until the start of the
+  // non-collapsible segment of the following checkpoint (or of the trajectory).
+  // These intervals are known without integrating, so they are integrated in
+  // parallel.  |t_initials| and |t_finals| go backwards in time.
+  std::vector<Instant> const t_initials(checkpoints.crbegin(),
+                                        checkpoints.crend());
+  if (t_initials.empty()) {
+    return absl::OkStatus();
+  }
+  std::vector<Instant> t_finals;
+  for (Instant const& t_initial : t_initials) {
+    t_finals.push_back(t_final);
     RETURN_IF_ERROR(checkpointer_->ReadFromCheckpointAt(
-        checkpoint,
-        [this, t_initial = checkpoint, &t_final](
-            serialization::Vessel::Checkpoint const& message) -> absl::Status {
-          auto const status_or_t_final =
-              ReanimateOneCheckpoint(message, t_initial, t_final);
-          RETURN_IF_ERROR(status_or_t_final);
-          t_final = status_or_t_final.value();
+        t_initial,
+        [&t_final](serialization::Vessel::Checkpoint const& message) {
+          // The left endpoints are ordered by time, so the first one is the
+          // start of the non-collapsible segment.
+          t_final = Instant::ReadFromMessage(message.non_collapsible_segment()
+                                                 .segment_by_left_endpoint(0)
+                                                 .left_endpoint());
           return absl::OkStatus();
         }));
   }
-  return absl::OkStatus();
+
+  std::int64_t const number_of_intervals = t_initials.size();
+  std::vector<absl::StatusOr<DiscreteTrajectory<Barycentric>>>
+      reanimated_trajectories(number_of_intervals);
+  ThreadPool<void>& pool = ReanimationThreadPool();
+  std::vector<std::unique_ptr<StoppableTask>> tasks;
+  std::vector<std::future<void>> futures;
+  for (std::int64_t i = 0; i < number_of_intervals; ++i) {
+    auto const& task = tasks.emplace_back(std::make_unique<StoppableTask>());
+    futures.push_back(pool.Add([this,
+                                &task = *task,
+                                &result = reanimated_trajectories[i],
+                                t_initial = t_initials[i],
+                                t_final = t_finals[i]]() {
+      task.Run([&]() {
+        absl::Status const status = checkpointer_->ReadFromCheckpointAt(
+            t_initial,
+            [&](serialization::Vessel::Checkpoint const& message) {
+              result = ReanimateOneCheckpoint(message, t_initial, t_final);
+              return result.status();
+            });
+        if (!status.ok()) {
+          result = status;
+        }
+      });
+    }));
+  }
+
+  // Push the reanimated trajectories into the queue where they will be consumed
+  // by RequestReanimation, going backwards in time as they become available.
+  // We must not push past an error, there would be a gap.  Stop requests are
+  // propagated to the tasks.
+  absl::Status status;
+  bool stopped = false;
+  for (std::int64_t i = 0; i < number_of_intervals; ++i) {
+    while (futures[i].wait_for(20ms) != std::future_status::ready) {
+      if (!stopped &&
+          this_stoppable_thread::get_stop_token().stop_requested()) {
+        stopped = true;
+        for (auto const& task : tasks) {
+          task->request_stop();
+        }
+      }
+    }
+    if (!status.ok()) {
+      continue;
+    }
+    if (!reanimated_trajectories[i].ok()) {
+      status = reanimated_trajectories[i].status();
+      continue;
+    }
+    absl::MutexLock l(&lock_);
+    reanimated_trajectories_.push(
+        std::move(reanimated_trajectories[i]).value());
+    oldest_reanimated_checkpoint_ = t_initials[i];
+  }
+  return status;
 }
 
-absl::StatusOr<Instant> Vessel::ReanimateOneCheckpoint(
+absl::StatusOr<DiscreteTrajectory<Barycentric>> Vessel::ReanimateOneCheckpoint(
     serialization::Vessel::Checkpoint const& message,
     Instant const& t_initial,
     Instant const& t_final) {
@@ -1045,8 +1350,6 @@ absl::StatusOr<Instant> Vessel::ReanimateOneCheckpoint(
           message.collapsible_fixed_step_parameters());
   CHECK(!reanimated_trajectory.empty());
   CHECK_EQ(t_initial, reanimated_trajectory.back().time);
-  Instant const reanimated_trajectory_t_initial =
-      reanimated_trajectory.front().time;
   std::int64_t const reanimated_trajectory_size = reanimated_trajectory.size();
 
   // Construct a new collapsible segment at the end of the non-collapsible
@@ -1071,16 +1374,7 @@ absl::StatusOr<Instant> Vessel::ReanimateOneCheckpoint(
             << " points), coast to " << t_final << " ("
             << collapsible_segment->size() << " points)";
 
-
-  // Push the reanimated trajectory into the queue where it will be consumed by
-  // RequestReanimation.
-  {
-    absl::MutexLock l(&lock_);
-    reanimated_trajectories_.push(std::move(reanimated_trajectory));
-    oldest_reanimated_checkpoint_ = t_initial;
-  }
-
-  return reanimated_trajectory_t_initial;
+  return reanimated_trajectory;
 }
 
 bool Vessel::DesiredTMinReachedOrFullyReanimated(
@@ -1099,19 +1393,92 @@ bool Vessel::DesiredTMinReachedOrFullyReanimated(
          oldest_reanimated_checkpoint_ == checkpointer_->oldest_checkpoint();
 }
 
+std::int64_t Vessel::AppendKeplerianPrognostication(
+    MassiveBody const& primary,
+    Angle const& tolerance,
+    Instant const& t_max,
+    std::int64_t const max_points,
+    DiscreteTrajectory<Barycentric>& prognostication) const {
+  // The angle swept, as seen from the primary, between consecutive points.
+  // This makes the error of the Hermite interpolation negligible for display.
+  constexpr Angle Δθ = 2 * π * Radian / 64;
+  GravitationalParameter const& μ = primary.gravitational_parameter();
+  auto const primary_trajectory = ephemeris_->trajectory(&primary);
+
+  auto const& [t0, degrees_of_freedom0] = prognostication.back();
+  KeplerOrbit<Barycentric> const orbit(
+      primary,
+      MasslessBody{},
+      degrees_of_freedom0 - primary_trajectory->EvaluateDegreesOfFreedom(t0),
+      t0);
+
+  // The maximal norm of the acceleration of the vessel relative to the
+  // primary, minus that of the Keplerian orbit, since |t0|.
+  Acceleration max_perturbation;
+  RelativeDegreesOfFreedom<Barycentric> relative_degrees_of_freedom =
+      orbit.StateVectors(t0);
+  Instant t = t0;
+  std::int64_t points = 0;
+  while (points < max_points) {
+    t += Δθ / Radian * relative_degrees_of_freedom.displacement().Norm() /
+         relative_degrees_of_freedom.velocity().Norm();
+    if (t >= t_max) {
+      break;
+    }
+    relative_degrees_of_freedom = orbit.StateVectors(t);
+    DegreesOfFreedom<Barycentric> const degrees_of_freedom =
+        primary_trajectory->EvaluateDegreesOfFreedom(t) +
+        relative_degrees_of_freedom;
+    Displacement<Barycentric> const r =
+        relative_degrees_of_freedom.displacement();
+    Length const r_norm = r.Norm();
+    Vector<Acceleration, Barycentric> const perturbation =
+        ephemeris_->ComputeGravitationalAccelerationOnMasslessBody(
+            degrees_of_freedom.position(), t) -
+        ephemeris_->ComputeGravitationalAccelerationOnMassiveBody(&primary,
+                                                                  t) +
+        μ * r / Pow<3>(r_norm);
+    max_perturbation = std::max(max_perturbation, perturbation.Norm());
+    if (0.5 * max_perturbation * Pow<2>(t - t0) > tolerance / Radian * r_norm) {
+      break;
+    }
+    prognostication.Append(t, degrees_of_freedom).IgnoreError();
+    ++points;
+  }
+  return points;
+}
+
 absl::StatusOr<DiscreteTrajectory<Barycentric>> Vessel::FlowPrognostication(
     PrognosticatorParameters prognosticator_parameters) {
   DiscreteTrajectory<Barycentric> prognostication;
   prognostication.Append(
       prognosticator_parameters.first_time,
       prognosticator_parameters.first_degrees_of_freedom).IgnoreError();
+  if (prognosticator_parameters.kepler_tolerance.has_value()) {
+    auto& adaptive_step_parameters =
+        prognosticator_parameters.adaptive_step_parameters;
+    std::int64_t const points = AppendKeplerianPrognostication(
+        *prognosticator_parameters.primary,
+        *prognosticator_parameters.kepler_tolerance,
+        ephemeris_->t_max(),
+        adaptive_step_parameters.max_steps(),
+        prognostication);
+    // The Keplerian points count towards the maximum number of steps.
+    if (points == adaptive_step_parameters.max_steps()) {
+      return std::move(prognostication);
+    }
+    adaptive_step_parameters.set_max_steps(
+        adaptive_step_parameters.max_steps() - points);
+  }
+  IntegrationStatistics<Time> statistics;
   absl::Status status;
   status = ephemeris_->FlowWithAdaptiveStep(
       &prognostication,
       Ephemeris<Barycentric>::NoIntrinsicAcceleration,
       ephemeris_->t_max(),
       prognosticator_parameters.adaptive_step_parameters,
-      FlightPlan::max_ephemeris_steps_per_frame);
+      FlightPlan::max_ephemeris_steps_per_frame,
+      &statistics);
   bool const reached_t_max = status.ok();
   if (reached_t_max) {
     // This will prolong the ephemeris by |max_ephemeris_steps_per_frame|.
@@ -1120,7 +1487,12 @@ absl::StatusOr<DiscreteTrajectory<Barycentric>> Vessel::FlowPrognostication(
         Ephemeris<Barycentric>::NoIntrinsicAcceleration,
         InfiniteFuture,
         prognosticator_parameters.adaptive_step_parameters,
-        FlightPlan::max_ephemeris_steps_per_frame);
+        FlightPlan::max_ephemeris_steps_per_frame,
+        &statistics);
+  }
+  {
+    absl::MutexLock l(&lock_);
+    prognostication_statistics_ = statistics;
   }
   LOG_IF_EVERY_N(INFO, !status.ok(), 50)
       << "Prognostication from " << prognosticator_parameters.first_time
@@ -1201,6 +1573,29 @@ void Vessel::AttachPrediction(DiscreteTrajectory<Barycentric>&& trajectory) {
   }
 }
 
+DiscreteTrajectory<Barycentric> Vessel::MergePrognostication(
+    DiscreteTrajectory<Barycentric> prediction,
+    DiscreteTrajectory<Barycentric> prognostication) const {
+  // A prognostication that starts after the end of the psychohistory can only
+  // be the continuation of a prediction.
+  if (prognostication.empty() ||
+      prognostication.front().time <= psychohistory_->back().time) {
+    return prognostication;
+  }
+  if (prediction.empty() ||
+      prediction.back().time != prognostication.front().time ||
+      prediction.back().degrees_of_freedom !=
+          prognostication.front().degrees_of_freedom) {
+    return prediction;
+  }
+  for (auto it = std::next(prognostication.begin());
+       it != prognostication.end();
+       ++it) {
+    prediction.Append(it->time, it->degrees_of_freedom).IgnoreError();
+  }
+  return prediction;
+}
+
 bool Vessel::IsCollapsible() const {
   PileUp* containing_pile_up = nullptr;
   std::set<not_null<Part*>> parts;
@@ -1235,6 +1630,94 @@ bool Vessel::has_deserialized_flight_plan() const {
          std::holds_alternative<OptimizableFlightPlan>(selected_flight_plan());
 }
 
+void Vessel::MaterializeHistory() const {
+  absl::MutexLock l(&lock_);
+  if (!serialized_history_.has_value()) {
+    return;
+  }
+  LOG(INFO) << "Materializing the history of " << ShortDebugString();
+  auto older_history = DiscreteTrajectory<Barycentric>::ReadFromMessage(
+      *serialized_history_, /*tracked=*/{});
+  serialized_history_.reset();
+
+  // The segment iterators are invalidated by the attachment, so we record
+  // their positions relative to the beginning of the |trajectory_|.
+  auto const position =
+      [this](DiscreteTrajectorySegmentIterator<Barycentric> const sit) {
+        return std::distance(trajectory_.segments().begin(), sit);
+      };
+  auto const backstory_position = position(backstory_);
+  auto const psychohistory_position = position(psychohistory_);
+  auto const prediction_position = position(prediction_);
+
+  auto const recent_history_begin =
+      older_history.AttachSegments(std::move(trajectory_));
+  trajectory_ = std::move(older_history);
+  backstory_ = std::next(recent_history_begin, backstory_position);
+  psychohistory_ = std::next(recent_history_begin, psychohistory_position);
+  prediction_ = std::next(recent_history_begin, prediction_position);
+
+  if (checkpoint_overlapping_serialized_history_.has_value()) {
+    RestoreCheckpointOverlappingHistory(
+        *checkpoint_overlapping_serialized_history_);
+    checkpoint_overlapping_serialized_history_.reset();
+  }
+}
+
+void Vessel::ArchiveHistoryIfNeeded() {
+  if (history_archive_ == nullptr) {
+    return;
+  }
+  // The points older than |history_archive_age_| are only archived once they
+  // span at least |history_archive_age_|, to avoid writing tiny chunks.
+  Instant t = backstory_->back().time - history_archive_age_;
+  if (!is_collapsible_) {
+    t = std::min(t, backstory_->front().time);
+  }
+  absl::MutexLock l(&lock_);
+  // The materialized history and the reanimated trajectories are merged at the
+  // beginning of the |trajectory_|, so they must be complete.
+  bool const fully_reanimated =
+      !serialized_history_.has_value() &&
+      reanimated_trajectories_.empty() &&
+      oldest_reanimated_checkpoint_ <= checkpointer_->oldest_checkpoint();
+  if (fully_reanimated &&
+      trajectory_.front().time + history_archive_age_ <= t) {
+    history_archive_->Archive(trajectory_, t);
+  }
+}
+
+void Vessel::RestoreCheckpointOverlappingHistory(
+    Instant const& checkpoint) const {
+  // Rebuild the front part of the non-collapsible segment to make sure that
+  // the trajectory doesn't start in the middle of a non-collapsible segment
+  // (the integration of the preceding collapsible segment would not end at the
+  // right time if it did).
+  CHECK_OK(checkpointer_->ReadFromCheckpointAt(
+      checkpoint,
+      [this, checkpoint](serialization::Vessel::Checkpoint const& message) {
+        // This code is similar to the one in ReanimateOneCheckpoint except
+        // that (1) we never need to reconstruct a collapsible segment; (2) we
+        // may actually have to truncate the non-collapsible segment obtained
+        // from the checkpoint.
+        LOG(INFO) << "Restoring " << ShortDebugString()
+                  << " to initial checkpoint at " << checkpoint;
+
+        DiscreteTrajectorySegmentIterator<Barycentric> unused;
+        auto reanimated_trajectory =
+            DiscreteTrajectory<Barycentric>::ReadFromMessage(
+                message.non_collapsible_segment(),
+                /*tracked=*/{&unused});
+        CHECK(!reanimated_trajectory.empty());
+        CHECK_EQ(checkpoint, reanimated_trajectory.back().time);
+        reanimated_trajectory.ForgetAfter(trajectory_.t_min());
+        if (!reanimated_trajectory.empty()) {
+          trajectory_.Merge(std::move(reanimated_trajectory));
+        }
+        return absl::OkStatus();
+      }));
+}
+
 Vessel::LazilyDeserializedFlightPlan& Vessel::selected_flight_plan() {
   CHECK_GE(selected_flight_plan_index_, 0);
   CHECK_LT(selected_flight_plan_index_, flight_plans_.size());
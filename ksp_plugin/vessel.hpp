@@ -1,6 +1,10 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <string>
 #include <variant>
@@ -14,12 +18,14 @@
 #include "base/recurring_thread.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
+#include "integrators/integrators.hpp"
 #include "ksp_plugin/celestial.hpp"
 #include "ksp_plugin/flight_plan.hpp"
 #include "ksp_plugin/flight_plan_optimization_driver.hpp"
 #include "ksp_plugin/flight_plan_optimizer.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/identification.hpp"
+#include "ksp_plugin/instantiations.hpp"  // 🧙 For extern templates.
 #include "ksp_plugin/manœuvre.hpp"
 #include "ksp_plugin/orbit_analyser.hpp"
 #include "ksp_plugin/part.hpp"
@@ -31,8 +37,10 @@
 #include "physics/discrete_trajectory_segment.hpp"
 #include "physics/discrete_trajectory_segment_iterator.hpp"
 #include "physics/ephemeris.hpp"
+#include "physics/massive_body.hpp"
 #include "physics/massless_body.hpp"
 #include "physics/rotating_body.hpp"
+#include "physics/trajectory_archive.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 #include "serialization/ksp_plugin.pb.h"
@@ -49,6 +57,7 @@ using namespace principia::base::_not_null;
 using namespace principia::base::_recurring_thread;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
+using namespace principia::integrators::_integrators;
 using namespace principia::ksp_plugin::_celestial;
 using namespace principia::ksp_plugin::_flight_plan;
 using namespace principia::ksp_plugin::_flight_plan_optimization_driver;
@@ -66,8 +75,10 @@ using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_discrete_trajectory_segment;
 using namespace principia::physics::_discrete_trajectory_segment_iterator;
 using namespace principia::physics::_ephemeris;
+using namespace principia::physics::_massive_body;
 using namespace principia::physics::_massless_body;
 using namespace principia::physics::_rotating_body;
+using namespace principia::physics::_trajectory_archive;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 
@@ -147,6 +158,21 @@ class Vessel {
   // trouble.
   virtual void DisableDownsampling();
 
+  // From now on, |AdvanceTime| moves the points of the history that are older
+  // than |age|, with respect to the end of the history, to an archive at
+  // |path|.  The archive is written in chunks covering at least |age|.  The
+  // archived points are no longer part of |trajectory()| and are not
+  // serialized, but they may be evaluated through |history_archive()|.
+  // Nothing is archived until the vessel is fully reanimated, and the
+  // non-collapsible backstory is never archived, as it may need to be written
+  // to a checkpoint.  Not persisted.
+  void EnableHistoryArchive(std::filesystem::path const& path,
+                            Time const& age);
+
+  // The archive of the history, or null if |EnableHistoryArchive| was not
+  // called.
+  TrajectoryArchive<Barycentric> const* history_archive() const;
+
   // Returns the part with the given ID.  Such a part must have been added using
   // |AddPart|.
   virtual not_null<Part*> part(PartId id) const;
@@ -166,6 +192,25 @@ class Vessel {
   virtual Ephemeris<Barycentric>::AdaptiveStepParameters const&
   prediction_adaptive_step_parameters() const;
 
+  // If |tolerance| is not null, the prediction starts with the Keplerian orbit
+  // around the parent, for as long as the displacement caused by the other
+  // bodies is estimated to be seen from the parent under an angle below
+  // |*tolerance|.  The rest of the prediction is integrated as usual.  This is
+  // only suitable for display, e.g., with |tolerance| the angular resolution of
+  // the planetarium.  Not persisted.
+  virtual void set_prediction_kepler_tolerance(
+      std::optional<Angle> const& tolerance);
+
+  // Whether the user is looking at the prediction of this vessel.  A
+  // prediction that is out of focus is shorter, is refreshed less frequently,
+  // and is computed with a lower priority.  The prediction is in focus when
+  // the vessel is constructed.
+  virtual void set_prediction_in_focus(bool in_focus);
+  virtual bool prediction_in_focus() const;
+
+  // The work performed by the integrator for the last prognostication.
+  virtual IntegrationStatistics<Time> prognostication_statistics() const;
+
   // Returns true iff the vessel has a flight plan, deserialized or not.  Never
   // fails.
   virtual bool has_flight_plan() const;
@@ -259,7 +304,9 @@ class Vessel {
 
   // Tries to replace the current prediction with a more recently computed one.
   // No guarantees that this happens.  No guarantees regarding the end time of
-  // the prediction when this call returns.
+  // the prediction when this call returns.  If the vessel is still on its
+  // predicted trajectory and the prediction parameters have not changed, the
+  // prediction is not recomputed, only its end is extended.
   virtual void RefreshPrediction();
 
   // Same as above, but when this call returns the prediction is guaranteed to
@@ -291,6 +338,12 @@ class Vessel {
   // Returns "vessel_name (GUID)".
   std::string ShortDebugString() const;
 
+  // Returns an estimate of the number of bytes used by this vessel, including
+  // its trajectory, its checkpoints and its flight plans.  The flight plans
+  // that have not been deserialized yet are counted by the size of their
+  // message.
+  std::int64_t MemoryFootprint() const EXCLUDES(lock_);
+
   // The vessel must satisfy |is_initialized()|.
   virtual void WriteToMessage(not_null<serialization::Vessel*> message,
                               PileUp::SerializationIndexForPileUp const&
@@ -317,10 +370,19 @@ class Vessel {
     Instant first_time;
     DegreesOfFreedom<Barycentric> first_degrees_of_freedom;
     Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters;
+    // If not null, the prognostication starts with the Keplerian orbit around
+    // |primary|, see |set_prediction_kepler_tolerance|.
+    std::optional<Angle> kepler_tolerance;
+    MassiveBody const* primary = nullptr;
   };
   friend bool operator!=(PrognosticatorParameters const& left,
                          PrognosticatorParameters const& right);
 
+  // The scheduler that executes the reanimators and prognosticators of all the
+  // vessels, so that the number of threads doesn't grow with the number of
+  // vessels.
+  static RecurringThreadScheduler& scheduler();
+
   using TrajectoryIterator =
       DiscreteTrajectory<Barycentric>::iterator (Part::*)();
 
@@ -346,9 +408,10 @@ class Vessel {
 
   // |t_initial| is the time of the checkpoint, which is the end of the non-
   // collapsible segment.  |t_final| is the start of the trajectory or of the
-  // next reanimated segment.  Returns the start of this reanimated segment,
-  // which will be the |t_final| of the next iteration.
-  absl::StatusOr<Instant> ReanimateOneCheckpoint(
+  // next reanimated segment.  Returns the reanimated trajectory, which starts
+  // with the non-collapsible segment.  May be called concurrently for distinct
+  // checkpoints.
+  absl::StatusOr<DiscreteTrajectory<Barycentric>> ReanimateOneCheckpoint(
       serialization::Vessel::Checkpoint const& message,
       Instant const& t_initial,
       Instant const& t_final) EXCLUDES(lock_);
@@ -359,6 +422,18 @@ class Vessel {
   bool DesiredTMinReachedOrFullyReanimated(Instant const& desired_t_min)
       SHARED_LOCKS_REQUIRED(lock_);
 
+  // Appends to |prognostication| points of the Keplerian orbit around
+  // |primary| that starts at its last point.  Stops before |t_max|, after
+  // |max_points| points, or when the displacement caused by the other bodies,
+  // bounded by ½ max |δa| Δt², exceeds |tolerance| as seen from |primary|.
+  // Returns the number of points appended.
+  std::int64_t AppendKeplerianPrognostication(
+      MassiveBody const& primary,
+      Angle const& tolerance,
+      Instant const& t_max,
+      std::int64_t max_points,
+      DiscreteTrajectory<Barycentric>& prognostication) const;
+
   // Runs the integrator to compute the |prognostication_| based on the given
   // parameters.
   absl::StatusOr<DiscreteTrajectory<Barycentric>>
@@ -376,6 +451,16 @@ class Vessel {
   // become the new |prediction_|.  If |prediction_| is not null, it is deleted.
   void AttachPrediction(DiscreteTrajectory<Barycentric>&& trajectory);
 
+  // Returns the trajectory that should become the prediction when the
+  // |prognostication| is available and the previous prediction was
+  // |prediction|.  If the |prognostication| extends the |prediction|, as
+  // requested by |RefreshPrediction|, the two are spliced.  If it extends an
+  // older prediction, it is useless and the |prediction| is returned.
+  // Otherwise the |prognostication| is returned.
+  DiscreteTrajectory<Barycentric> MergePrognostication(
+      DiscreteTrajectory<Barycentric> prediction,
+      DiscreteTrajectory<Barycentric> prognostication) const;
+
   // A vessel is collapsible if it is alone in its pile-up and is in inertial
   // motion.
   bool IsCollapsible() const;
@@ -383,6 +468,23 @@ class Vessel {
   // Returns true if this object holds a non-null deserialized flight plan.
   bool has_deserialized_flight_plan() const;
 
+  // If |ReadFromMessage| kept the beginning of the history in serialized form,
+  // deserializes it and inserts it before the |backstory_|.  Must be called
+  // before accessing any point of the |trajectory_| prior to the |backstory_|.
+  // This doesn't change the trajectory as seen by the clients, which can only
+  // access it through |trajectory()|, so it may be called by const member
+  // functions.  Thread-safe and idempotent.
+  void MaterializeHistory() const EXCLUDES(lock_);
+
+  // Restores the non-collapsible segment stored in the given |checkpoint|, to
+  // make sure that the trajectory doesn't start in the middle of it.
+  void RestoreCheckpointOverlappingHistory(Instant const& checkpoint) const
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Moves the old points of the history to the |history_archive_|, if any, see
+  // |EnableHistoryArchive|.
+  void ArchiveHistoryIfNeeded() EXCLUDES(lock_);
+
   LazilyDeserializedFlightPlan& selected_flight_plan();
   LazilyDeserializedFlightPlan const& selected_flight_plan() const;
 
@@ -392,6 +494,7 @@ class Vessel {
   MasslessBody const body_;
   Ephemeris<Barycentric>::AdaptiveStepParameters
       prediction_adaptive_step_parameters_;
+  std::optional<Angle> prediction_kepler_tolerance_;
   // The parent body for the 2-body approximation.
   not_null<Celestial const*> parent_;
   not_null<Ephemeris<Barycentric>*> const ephemeris_;
@@ -412,11 +515,24 @@ class Vessel {
   // The vessel trajectory is made of a number of history segments ending at the
   // backstory and (most of the time) the psychohistory and prediction.  The
   // prediction is periodically recomputed by the prognosticator.  Only grows
-  // "backwards" under |lock_|.
-  DiscreteTrajectory<Barycentric> trajectory_;
+  // "backwards" under |lock_|.  Mutable because of |MaterializeHistory|.
+  mutable DiscreteTrajectory<Barycentric> trajectory_;
+
+  // The segments of the history prior to the |backstory_|, when they are kept
+  // in serialized form by |ReadFromMessage| until first needed.  In that case
+  // |trajectory_| starts at the |backstory_|, and the checkpoint that overlaps
+  // the beginning of the history, if any, is restored on materialization.
+  mutable std::optional<serialization::DiscreteTrajectory> serialized_history_
+      GUARDED_BY(lock_);
+  mutable std::optional<Instant> checkpoint_overlapping_serialized_history_
+      GUARDED_BY(lock_);
 
   not_null<std::unique_ptr<Checkpointer<serialization::Vessel>>> checkpointer_;
 
+  // Set by |EnableHistoryArchive|.  The |history_archive_| is thread-safe.
+  std::unique_ptr<TrajectoryArchive<Barycentric>> history_archive_;
+  Time history_archive_age_;
+
   // Vessels that are constructed de novo won't ever need reanimation, so all
   // the checkpoints are animate at birth.
   Instant oldest_reanimated_checkpoint_ GUARDED_BY(lock_) = InfinitePast;
@@ -429,22 +545,33 @@ class Vessel {
   std::optional<Instant> last_desired_t_min_;
 
   // The trajectories that have been reanimated are put in this queue by
-  // ReanimateOneCheckpoint and consumed by RequestReanimation.
+  // Reanimate and consumed by RequestReanimation.
   std::queue<DiscreteTrajectory<Barycentric>> reanimated_trajectories_
       GUARDED_BY(lock_);
 
   // The last (most recent) segment of the |history_| prior to the
   // |psychohistory_|.  May be identical to |history_|.  Always identical to
-  // |std::prev(psychohistory_)|.
-  DiscreteTrajectorySegmentIterator<Barycentric> backstory_;
+  // |std::prev(psychohistory_)|.  The segment iterators are mutable because
+  // |MaterializeHistory| recomputes them.
+  mutable DiscreteTrajectorySegmentIterator<Barycentric> backstory_;
 
   // The |psychohistory_| is the segment following the |backstory_| and the
   // |prediction_| is the segment following the |psychohistory_|.
-  DiscreteTrajectorySegmentIterator<Barycentric> psychohistory_;
-  DiscreteTrajectorySegmentIterator<Barycentric> prediction_;
+  mutable DiscreteTrajectorySegmentIterator<Barycentric> psychohistory_;
+  mutable DiscreteTrajectorySegmentIterator<Barycentric> prediction_;
 
   RecurringThread<PrognosticatorParameters,
                   DiscreteTrajectory<Barycentric>> prognosticator_;
+  IntegrationStatistics<Time> prognostication_statistics_ GUARDED_BY(lock_);
+  // The parameters of the last prognostication requested by
+  // |RefreshPrediction|, if any.  Only accessed on the main thread.
+  std::optional<Ephemeris<Barycentric>::AdaptiveStepParameters>
+      prognostication_adaptive_step_parameters_;
+  // The wall-clock time of the last prognostication requested by
+  // |RefreshPrediction|.  Only accessed on the main thread.
+  std::chrono::steady_clock::time_point prognostication_request_time_;
+  // Only accessed on the main thread.
+  bool prediction_in_focus_ = true;
 
   std::vector<LazilyDeserializedFlightPlan> flight_plans_;
   int selected_flight_plan_index_ = -1;
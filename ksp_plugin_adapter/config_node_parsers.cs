@@ -52,7 +52,8 @@ public static ConfigurationDownsamplingParameters
       NewConfigurationDownsamplingParameters(ConfigNode node) {
     return new ConfigurationDownsamplingParameters{
         max_dense_intervals = node.GetUniqueValue("max_dense_intervals"),
-        tolerance = node.GetUniqueValue("tolerance")
+        tolerance = node.GetUniqueValue("tolerance"),
+        max_fits_per_append = node.GetAtMostOneValue("max_fits_per_append")
     };
   }
 
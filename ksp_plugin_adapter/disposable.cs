@@ -1,21 +1,33 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Runtime.InteropServices;
 
 namespace principia {
 namespace ksp_plugin_adapter {
 
 static class DisposableIteratorExtensions {
+  // Retrieves the points in batches, to avoid one call across the interface
+  // per point.
   public static IEnumerable<TQP> DiscreteTrajectoryPoints(
       this DisposableIterator apsis_iterator) {
-    for (;
-         !apsis_iterator.IteratorAtEnd();
-         apsis_iterator.IteratorIncrement()) {
-      yield return new TQP {
-          t = apsis_iterator.IteratorGetDiscreteTrajectoryTime(),
-          qp = apsis_iterator.IteratorGetDiscreteTrajectoryQP()
-      };
+    var points = new TQP[points_per_batch];
+    GCHandle handle = GCHandle.Alloc(points, GCHandleType.Pinned);
+    try {
+      int size;
+      do {
+        size = apsis_iterator.IteratorGetDiscreteTrajectoryTQPs(
+            handle.AddrOfPinnedObject(),
+            points.Length);
+        for (int i = 0; i < size; ++i) {
+          yield return points[i];
+        }
+      } while (size == points.Length);
+    } finally {
+      handle.Free();
     }
   }
+
+  private const int points_per_batch = 1024;
 }
 
 class DisposableIterator : IDisposable {
@@ -2,6 +2,7 @@
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Runtime.InteropServices;
 using UnityEngine.Profiling;
 using static principia.ksp_plugin_adapter.FrameType;
 
@@ -497,12 +498,63 @@ class PartCentredForceHolder {
     }
   }
 
-  private void UpdateVessel(Vessel vessel, double universal_time) {
-    string vessel_guid = vessel.id.ToString();
-    if (plugin_.HasVessel(vessel_guid)) {
-      QP from_parent = plugin_.VesselFromParent(
-          vessel.mainBody.flightGlobalsIndex,
-          vessel_guid);
+  // Returns the degrees of freedom relative to their parents of the vessels on
+  // rails known to the plugin, obtained in a single call to the plugin.
+  private Dictionary<Vessel, QP> VesselsFromParent() {
+    Vessel[] vessels = FlightGlobals.Vessels.Where(
+        vessel => is_manageable_on_rails(vessel) &&
+                  plugin_.HasVessel(vessel.id.ToString())).ToArray();
+    var from_parents = new QP[vessels.Length];
+    GCHandle handle = GCHandle.Alloc(from_parents, GCHandleType.Pinned);
+    try {
+      plugin_.VesselsFromParent(
+          vessels.Select(vessel => vessel.id.ToString()).ToArray(),
+          handle.AddrOfPinnedObject(),
+          from_parents.Length);
+    } finally {
+      handle.Free();
+    }
+    var result = new Dictionary<Vessel, QP>();
+    for (int i = 0; i < vessels.Length; ++i) {
+      result.Add(vessels[i], from_parents[i]);
+    }
+    return result;
+  }
+
+  // Returns the actual motions of the parts of |vessel| known to the plugin,
+  // indexed by flight ID, obtained in a single call to the plugin.
+  private Dictionary<uint, QPRW> PartsGetActualRigidMotions(Vessel vessel,
+                                                           Origin origin) {
+    // The plugin only knows the faithful parts, so this is an upper bound.
+    var part_ids = new uint[vessel.parts.Count];
+    var part_motions = new QPRW[vessel.parts.Count];
+    GCHandle part_ids_handle = GCHandle.Alloc(part_ids, GCHandleType.Pinned);
+    GCHandle part_motions_handle =
+        GCHandle.Alloc(part_motions, GCHandleType.Pinned);
+    int count;
+    try {
+      count = plugin_.PartsGetActualRigidMotions(
+          vessel.id.ToString(),
+          origin,
+          part_ids_handle.AddrOfPinnedObject(),
+          part_ids.Length,
+          part_motions_handle.AddrOfPinnedObject(),
+          part_motions.Length);
+    } finally {
+      part_ids_handle.Free();
+      part_motions_handle.Free();
+    }
+    var result = new Dictionary<uint, QPRW>();
+    for (int i = 0; i < count; ++i) {
+      result.Add(part_ids[i], part_motions[i]);
+    }
+    return result;
+  }
+
+  private void UpdateVessel(Vessel vessel,
+                            double universal_time,
+                            Dictionary<Vessel, QP> from_parents) {
+    if (from_parents.TryGetValue(vessel, out QP from_parent)) {
       vessel.orbit.UpdateFromStateVectors(pos : (Vector3d)from_parent.q,
                                           vel : (Vector3d)from_parent.p,
                                           refBody : vessel.orbit.referenceBody,
@@ -825,16 +877,29 @@ class PartCentredForceHolder {
     if (PluginRunning()) {
       IntPtr serializer = IntPtr.Zero;
       int chunks = 0;
-      for (;;) {
-        string serialization = plugin_.SerializePlugin(
-            ref serializer,
-            serialization_compression_,
-            serialization_encoding_);
-        if (serialization == null) {
-          break;
+      // All the chunks are written to the same buffer, so that no native
+      // string is allocated and freed per chunk.
+      var buffer = new byte[Interface.SerializePluginMaxChunkSize(
+          serialization_compression_,
+          serialization_encoding_)];
+      GCHandle handle = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+      try {
+        for (;;) {
+          int size = plugin_.SerializePluginIntoBuffer(
+              ref serializer,
+              serialization_compression_,
+              serialization_encoding_,
+              handle.AddrOfPinnedObject(),
+              buffer.Length);
+          if (size == 0) {
+            break;
+          }
+          node.AddValue(principia_serialized_plugin,
+                        System.Text.Encoding.ASCII.GetString(buffer, 0, size));
+          ++chunks;
         }
-        node.AddValue(principia_serialized_plugin, serialization);
-        ++chunks;
+      } finally {
+        handle.Free();
       }
       Log.Info("Serialization has " + chunks + " chunks");
     }
@@ -870,6 +935,9 @@ class PartCentredForceHolder {
       if (serialization_encoding_ == "hexadecimal") {
         serialization_encoding_ = "base64";
       }
+      SetTransientNumerics(plugin_,
+                           GameDatabase.Instance.GetAtMostOneNode(
+                               principia_numerics_blueprint_config_name));
 
       previous_display_mode_ = null;
       must_set_plotting_frame_ = true;
@@ -1463,10 +1531,11 @@ class PartCentredForceHolder {
             continue;
           }
 
+          Dictionary<uint, QPRW> part_actual_motions =
+              PartsGetActualRigidMotions(vessel, origin);
           foreach (Part part in vessel.parts.Where(PartIsFaithful)) {
             UnityEngine.Rigidbody part_rb = part.rb;
-            QPRW part_actual_motion =
-                plugin_.PartGetActualRigidMotion(part.flightID, origin);
+            QPRW part_actual_motion = part_actual_motions[part.flightID];
             QP part_actual_degrees_of_freedom = part_actual_motion.qp;
             var part_position = (Vector3d)part_actual_degrees_of_freedom.q;
             var part_velocity = (Vector3d)part_actual_degrees_of_freedom.p;
@@ -1620,9 +1689,12 @@ out DisposableIterator
       foreach (var vessel in all_collided_vessels) {
         vessel?.Die();
       }
+      double universal_time = Planetarium.GetUniversalTime();
+      Dictionary<Vessel, QP> from_parents = VesselsFromParent();
       ApplyToVesselsOnRails(vessel =>
                                 UpdateVessel(vessel,
-                                             Planetarium.GetUniversalTime()));
+                                             universal_time,
+                                             from_parents));
     }
   }
 
@@ -2299,6 +2371,14 @@ select PartCentredForceHolder.
     }
   }
 
+  // The resolution of the terrain returned by |TerrainAltitude|, which is
+  // higher when the PQS of |centre| is active.  The plugin doesn't reuse a
+  // collision found with a different resolution.
+  private static int TerrainLevelOfDetail(CelestialBody centre) {
+    PQS pqs = centre.pqsController;
+    return pqs != null && pqs.isActive ? pqs.maxLevel : 0;
+  }
+
   private TQP? RenderedPredictionCollision(string vessel_guid,
                                            CelestialBody centre) {
     var executor = plugin_.CollisionNewPredictionExecutor(
@@ -2306,6 +2386,7 @@ select PartCentredForceHolder.
         sun_world_position: (XYZ)Planetarium.fetch.Sun.position,
         // TODO(phl): This should be much larger, if it is limited at all.
         max_points: MapNodePool.MaxNodesPerProvenance,
+        terrain_level_of_detail: TerrainLevelOfDetail(centre),
         vessel_guid: vessel_guid);
 
     for (;;) {
@@ -2334,6 +2415,7 @@ select PartCentredForceHolder.
         sun_world_position: (XYZ)Planetarium.fetch.Sun.position,
         // TODO(phl): This should be much larger, if it is limited at all.
         max_points: MapNodePool.MaxNodesPerProvenance,
+        terrain_level_of_detail: TerrainLevelOfDetail(centre),
         vessel_guid: vessel_guid);
 
     for (;;) {
@@ -2645,6 +2727,25 @@ out DisposableIterator
           ConfigNodeParsers.NewConfigurationAdaptiveStepParameters(
               psychohistory_parameters));
     }
+    SetTransientNumerics(plugin, numerics_blueprint);
+  }
+
+  // Sets the parameters of the numerics blueprint that are not serialized with
+  // the plugin, and must therefore be set again after deserialization.
+  private static void SetTransientNumerics(IntPtr plugin,
+                                           ConfigNode numerics_blueprint) {
+    string max_history_step = numerics_blueprint?.GetAtMostOneNode("history")?.
+        GetAtMostOneValue("max_integration_step_size");
+    if (max_history_step != null) {
+      plugin.SetMaxHistoryStep(max_history_step);
+    }
+
+    string kepler_tolerance =
+        numerics_blueprint?.GetAtMostOneNode("psychohistory")?.
+            GetAtMostOneValue("kepler_tolerance");
+    if (kepler_tolerance != null) {
+      plugin.SetPredictionKeplerTolerance(kepler_tolerance);
+    }
   }
 
   private void ResetPlugin() {
@@ -3,7 +3,7 @@
 #include <string>
 #include <vector>
 
-#include "base/pull_serializer.hpp"
+#include "base/pipelined_serializer.hpp"
 #include "base/push_deserializer.hpp"
 #include "base/serialization.hpp"
 #include "benchmark/benchmark.h"
@@ -29,7 +29,7 @@ using interface::principia__FutureCatchUpVessel;
 using interface::principia__FutureWaitForVesselToCatchUp;
 using interface::principia__IteratorDelete;
 using interface::principia__SerializePlugin;
-using namespace principia::base::_pull_serializer;
+using namespace principia::base::_pipelined_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::base::_serialization;
 using namespace principia::ksp_plugin::_identification;
@@ -87,7 +87,7 @@ void BM_PluginSerializationBenchmark(benchmark::State& state) {
 
   std::int64_t bytes_processed = 0;
   for (auto _ : state) {
-    PullSerializer* serializer = nullptr;
+    PipelinedSerializer* serializer = nullptr;
     char const* serialization = nullptr;
     for (;;) {
       serialization = principia__SerializePlugin(plugin.get(),
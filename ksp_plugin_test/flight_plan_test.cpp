@@ -45,6 +45,7 @@ using ::testing::Eq;
 using ::testing::Gt;
 using ::testing::Lt;
 using ::testing::MockFunction;
+using ::testing::Not;
 using namespace principia::astronomy::_epoch;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_instant;
@@ -370,6 +371,78 @@ TEST_F(FlightPlanTest, Replace) {
   EXPECT_LT(t0_ + 1.7 * Second, flight_plan_->desired_final_time());
 }
 
+TEST_F(FlightPlanTest, ReplaceAsynchronously) {
+  EXPECT_OK(flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second));
+  EXPECT_OK(flight_plan_->Insert(MakeFirstBurn(), 0));
+  EXPECT_OK(flight_plan_->Insert(MakeSecondBurn(), 1));
+  auto shorter_burn = MakeFirstBurn();
+  *shorter_burn.intensity.Δv /= 2;
+  auto longer_burn = MakeFirstBurn();
+  *longer_burn.intensity.Δv *= 1.5;
+  auto late_burn = MakeSecondBurn();
+  *late_burn.timing.initial_time += 1 * Second;
+
+  FlightPlan synchronous_flight_plan(*flight_plan_);
+  EXPECT_OK(synchronous_flight_plan.Replace(longer_burn, /*index=*/0));
+
+  // The second replacement interrupts the first one.  The validity of the
+  // burns is checked synchronously.
+  EXPECT_OK(flight_plan_->ReplaceAsynchronously(shorter_burn, /*index=*/0));
+  EXPECT_THAT(flight_plan_->ReplaceAsynchronously(std::move(late_burn),
+                                                  /*index=*/0),
+              StatusIs(FlightPlan::does_not_fit));
+  EXPECT_OK(flight_plan_->ReplaceAsynchronously(longer_burn, /*index=*/0));
+  EXPECT_EQ(synchronous_flight_plan.GetManœuvre(1).initial_mass(),
+            flight_plan_->GetManœuvre(1).initial_mass());
+
+  for (;;) {
+    flight_plan_->GetAllSegmentsAvoidingDeadlines();
+    EXPECT_EQ(5, flight_plan_->number_of_segments());
+    if (flight_plan_->anomalous_status().code() != FlightPlan::recomputing) {
+      break;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_OK(flight_plan_->anomalous_status());
+  EXPECT_EQ(0, flight_plan_->number_of_anomalous_manœuvres());
+  EXPECT_EQ(synchronous_flight_plan.actual_final_time(),
+            flight_plan_->actual_final_time());
+  for (int i = 0; i < flight_plan_->number_of_segments(); ++i) {
+    EXPECT_EQ(synchronous_flight_plan.GetSegment(i)->size(),
+              flight_plan_->GetSegment(i)->size());
+    EXPECT_THAT(flight_plan_->GetSegment(i)->back().degrees_of_freedom,
+                Eq(synchronous_flight_plan.GetSegment(i)
+                       ->back().degrees_of_freedom));
+  }
+}
+
+TEST_F(FlightPlanTest, SegmentCache) {
+  EXPECT_OK(flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second));
+  EXPECT_OK(flight_plan_->Insert(MakeFirstBurn(), 0));
+  EXPECT_OK(flight_plan_->Insert(MakeSecondBurn(), 1));
+  auto const final_point = flight_plan_->GetAllSegments().back();
+  auto longer_burn = MakeFirstBurn();
+  *longer_burn.intensity.Δv *= 1.5;
+
+  EXPECT_OK(flight_plan_->Replace(longer_burn, /*index=*/0));
+  EXPECT_LT(0, flight_plan_->integration_statistics().accepted_steps);
+  EXPECT_THAT(flight_plan_->GetAllSegments().back().degrees_of_freedom,
+              Not(Eq(final_point.degrees_of_freedom)));
+
+  // Going back to the original burn doesn't integrate anything.
+  EXPECT_OK(flight_plan_->Replace(MakeFirstBurn(), /*index=*/0));
+  EXPECT_EQ(0, flight_plan_->integration_statistics().accepted_steps);
+  EXPECT_EQ(final_point.time, flight_plan_->GetAllSegments().back().time);
+  EXPECT_THAT(flight_plan_->GetAllSegments().back().degrees_of_freedom,
+              Eq(final_point.degrees_of_freedom));
+
+  // Changing the adaptive step parameters invalidates the cache.
+  EXPECT_OK(flight_plan_->SetAdaptiveStepParameters(
+      flight_plan_->adaptive_step_parameters(),
+      flight_plan_->generalized_adaptive_step_parameters()));
+  EXPECT_LT(0, flight_plan_->integration_statistics().accepted_steps);
+}
+
 TEST_F(FlightPlanTest, Segments) {
   EXPECT_OK(flight_plan_->SetDesiredFinalTime(t0_ + 42 * Second));
   EXPECT_OK(flight_plan_->Insert(MakeFirstBurn(), 0));
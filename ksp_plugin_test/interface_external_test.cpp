@@ -13,6 +13,8 @@
 #include "ksp_plugin_test/fake_plugin.hpp"
 #include "physics/solar_system.hpp"
 #include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/numbers.hpp"  // 🧙 For π.
 #include "quantities/si.hpp"
 #include "testing_utilities/approximate_quantity.hpp"
 #include "testing_utilities/componentwise.hpp"
@@ -27,6 +29,7 @@ using ::testing::AllOf;
 using ::testing::Eq;
 using ::testing::Gt;
 using ::testing::Lt;
+using ::testing::Not;
 using namespace principia::astronomy::_frames;
 using namespace principia::base::_not_null;
 using namespace principia::ksp_plugin::_frames;
@@ -35,6 +38,7 @@ using namespace principia::ksp_plugin::_vessel;
 using namespace principia::ksp_plugin_test::_fake_plugin;
 using namespace principia::physics::_solar_system;
 using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_si;
 using namespace principia::testing_utilities::_approximate_quantity;
 using namespace principia::testing_utilities::_componentwise;
@@ -78,6 +82,62 @@ class InterfaceExternalTest : public ::testing::Test {
   Vessel* vessel_;
 };
 
+TEST_F(InterfaceExternalTest, FlowFreefall) {
+  auto const to_world =
+      plugin_.renderer().BarycentricToWorld(plugin_.PlanetariumRotation());
+  Length const r = 6783 * Kilo(Metre);
+  GravitationalParameter const μ =
+      plugin_.GetCelestial(SolarSystemFactory::Earth)
+          .body()->gravitational_parameter();
+  Speed const v = Sqrt(μ / r);
+  Time const half_period = π * r / v;
+  QP const initial_degrees_of_freedom{
+      .q = ToXYZ(to_world(Displacement<Barycentric>({r, 0 * Metre, 0 * Metre}))
+                     .coordinates() /
+                 Metre),
+      .p = ToXYZ(to_world(Velocity<Barycentric>(
+                              {0 * Metre / Second, v, 0 * Metre / Second}))
+                     .coordinates() /
+                 (Metre / Second))};
+  double const t_initial = ToGameTime(plugin_, plugin_.CurrentTime());
+  double const t_final =
+      ToGameTime(plugin_, plugin_.CurrentTime() + half_period);
+
+  QP result;
+  auto const* status = principia__ExternalFlowFreefall(
+      &plugin_,
+      SolarSystemFactory::Earth,
+      initial_degrees_of_freedom,
+      t_initial,
+      t_final,
+      &result);
+  EXPECT_THAT(*status, IsOk());
+  auto const barycentric_result =
+      to_world.Inverse()(FromQP<RelativeDegreesOfFreedom<World>>(result));
+  // Half an orbit later, the body is on the other side of the Earth.
+  EXPECT_THAT(barycentric_result,
+              Componentwise(Componentwise(IsNear(-6.8e3_(1) * Kilo(Metre)),
+                                          AllOf(Gt(-100 * Kilo(Metre)),
+                                                Lt(100 * Kilo(Metre))),
+                                          AllOf(Gt(-1 * Kilo(Metre)),
+                                                Lt(1 * Kilo(Metre)))),
+                            Componentwise(AllOf(Gt(-100 * Metre / Second),
+                                                Lt(100 * Metre / Second)),
+                                          IsNear(-7.7_(1) * Kilo(Metre) /
+                                                 Second),
+                                          AllOf(Gt(-1 * Metre / Second),
+                                                Lt(1 * Metre / Second)))));
+
+  // Flowing backwards is an error.
+  status = principia__ExternalFlowFreefall(&plugin_,
+                                           SolarSystemFactory::Earth,
+                                           initial_degrees_of_freedom,
+                                           t_final,
+                                           t_initial,
+                                           &result);
+  EXPECT_THAT(*status, Not(IsOk()));
+}
+
 TEST_F(InterfaceExternalTest, GetNearestPlannedCoastDegreesOfFreedom) {
   plugin_.CreateFlightPlan(
       vessel_guid, plugin_.CurrentTime() + 6 * Hour, 1 * Tonne);
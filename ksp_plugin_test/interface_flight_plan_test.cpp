@@ -1,5 +1,6 @@
 #include "ksp_plugin/interface.hpp"
 
+#include <array>
 #include <memory>
 #include <string>
 #include <utility>
@@ -382,6 +383,23 @@ TEST_F(InterfaceFlightPlanTest, FlightPlan) {
   EXPECT_EQ(XYZ({0, 2, 4}),
             principia__IteratorGetDiscreteTrajectoryXYZ(iterator));
 
+  // Same thing, in bulk.
+  principia__IteratorReset(iterator);
+  std::array<XYZ, 2> xyzs;
+  EXPECT_EQ(2,
+            principia__IteratorGetDiscreteTrajectoryXYZs(
+                iterator, xyzs.data(), xyzs.size()));
+  EXPECT_EQ(XYZ({0, 0, 0}), xyzs[0]);
+  EXPECT_EQ(XYZ({0, 1, 2}), xyzs[1]);
+  EXPECT_EQ(1,
+            principia__IteratorGetDiscreteTrajectoryXYZs(
+                iterator, xyzs.data(), xyzs.size()));
+  EXPECT_EQ(XYZ({0, 2, 4}), xyzs[0]);
+  EXPECT_TRUE(principia__IteratorAtEnd(iterator));
+  EXPECT_EQ(0,
+            principia__IteratorGetDiscreteTrajectoryXYZs(
+                iterator, xyzs.data(), xyzs.size()));
+
   interface_burn.thrust_in_kilonewtons = 10;
   EXPECT_CALL(*plugin_,
               NewBodyCentredNonRotatingNavigationFrame(celestial_index))
@@ -391,7 +409,7 @@ TEST_F(InterfaceFlightPlanTest, FlightPlan) {
   auto const manœuvre = NavigationManœuvre(/*initial_mass=*/1 * Kilogram, burn);
   EXPECT_CALL(
       flight_plan,
-      Replace(
+      ReplaceAsynchronously(
           AllOf(HasThrust(10 * Kilo(Newton)),
                 HasSpecificImpulse(2 * Second * StandardGravity),
                 HasInitialTime(Instant() + 3 * Second),
@@ -9,7 +9,7 @@
 #include "astronomy/time_scales.hpp"
 #include "base/file.hpp"
 #include "base/not_null.hpp"
-#include "base/pull_serializer.hpp"
+#include "base/pipelined_serializer.hpp"
 #include "base/push_deserializer.hpp"
 #include "base/serialization.hpp"
 #include "geometry/grassmann.hpp"
@@ -70,7 +70,7 @@ using ::testing::_;
 using namespace principia::astronomy::_time_scales;
 using namespace principia::base::_file;
 using namespace principia::base::_not_null;
-using namespace principia::base::_pull_serializer;
+using namespace principia::base::_pipelined_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::base::_serialization;
 using namespace principia::geometry::_grassmann;
@@ -486,6 +486,20 @@ TEST_F(InterfaceTest, AdvanceTime) {
   principia__AdvanceTime(plugin_.get(), time, planetarium_rotation);
 }
 
+TEST_F(InterfaceTest, SetMaxHistoryStep) {
+  EXPECT_CALL(*plugin_,
+              SetMaxHistoryStep(std::optional<Time>(10 * Minute)));
+  principia__SetMaxHistoryStep(plugin_.get(), "10 min");
+}
+
+TEST_F(InterfaceTest, SetPredictionKeplerTolerance) {
+  EXPECT_CALL(*plugin_,
+              SetPredictionKeplerTolerance(std::optional<Angle>(1 * Degree)));
+  principia__SetPredictionKeplerTolerance(plugin_.get(), "1 deg");
+  EXPECT_CALL(*plugin_, SetPredictionKeplerTolerance(std::optional<Angle>()));
+  principia__SetPredictionKeplerTolerance(plugin_.get(), "0 deg");
+}
+
 TEST_F(InterfaceTest, VesselFromParent) {
   EXPECT_CALL(*plugin_,
               VesselFromParent(celestial_index, vessel_guid))
@@ -504,6 +518,68 @@ TEST_F(InterfaceTest, VesselFromParent) {
   EXPECT_THAT(result, Eq(parent_relative_degrees_of_freedom));
 }
 
+TEST_F(InterfaceTest, VesselsFromParent) {
+  RelativeDegreesOfFreedom<AliceSun> const from_parent(
+      Displacement<AliceSun>({parent_position.x * si::Unit<Length>,
+                              parent_position.y * si::Unit<Length>,
+                              parent_position.z * si::Unit<Length>}),
+      Velocity<AliceSun>({parent_velocity.x * si::Unit<Speed>,
+                          parent_velocity.y * si::Unit<Speed>,
+                          parent_velocity.z * si::Unit<Speed>}));
+  char const* const vessel_guids[] = {vessel_guid, vessel_guid, nullptr};
+  EXPECT_CALL(*plugin_,
+              VesselsFromParent(ElementsAre(vessel_guid, vessel_guid)))
+      .WillOnce(Return(std::vector<RelativeDegreesOfFreedom<AliceSun>>{
+          from_parent, from_parent}));
+  QP qps[2];
+  principia__VesselsFromParent(plugin_.get(), vessel_guids, qps, 2);
+  EXPECT_THAT(qps[0], Eq(parent_relative_degrees_of_freedom));
+  EXPECT_THAT(qps[1], Eq(parent_relative_degrees_of_freedom));
+}
+
+TEST_F(InterfaceTest, PartsGetActualRigidMotions) {
+  Origin const origin{.reference_part_is_at_origin = true,
+                      .reference_part_is_unmoving = true,
+                      .reference_part_id = part_id,
+                      .main_body_centre_in_world = {0, 0, 0}};
+  auto const barycentric_to_world =
+      RigidMotion<Barycentric, World>::MakeNonRotatingMotion(
+          DegreesOfFreedom<World>(World::origin, World::unmoving));
+  auto const part_motion =
+      RigidMotion<EccentricPart, World>::MakeNonRotatingMotion(
+          DegreesOfFreedom<World>(
+              World::origin + Displacement<World>({parent_position.x * Metre,
+                                                   parent_position.y * Metre,
+                                                   parent_position.z * Metre}),
+              Velocity<World>({parent_velocity.x * (Metre / Second),
+                               parent_velocity.y * (Metre / Second),
+                               parent_velocity.z * (Metre / Second)})));
+  // The motion of |World| is computed once for all the parts.
+  EXPECT_CALL(*plugin_, BarycentricToWorld(true, part_id, Eq(std::nullopt)))
+      .WillOnce(Return(barycentric_to_world));
+  EXPECT_CALL(*plugin_, GetAllPartsActualMotions(vessel_guid, _))
+      .WillOnce(Return(
+          std::vector<std::pair<PartId, RigidMotion<EccentricPart, World>>>{
+              {part_id, part_motion}, {part_id + 1, part_motion}}));
+  PartId part_ids[3];
+  QPRW part_motions[3];
+  EXPECT_EQ(2,
+            principia__PartsGetActualRigidMotions(plugin_.get(),
+                                                  vessel_guid,
+                                                  origin,
+                                                  part_ids,
+                                                  3,
+                                                  part_motions,
+                                                  3));
+  QPRW const expected_motion{parent_relative_degrees_of_freedom,
+                             {1, 0, 0, 0},
+                             {0, 0, 0}};
+  EXPECT_EQ(part_id, part_ids[0]);
+  EXPECT_EQ(part_id + 1, part_ids[1]);
+  EXPECT_THAT(part_motions[0], Eq(expected_motion));
+  EXPECT_THAT(part_motions[1], Eq(expected_motion));
+}
+
 TEST_F(InterfaceTest, CelestialFromParent) {
   EXPECT_CALL(*plugin_,
               CelestialFromParent(celestial_index))
@@ -628,7 +704,7 @@ TEST_F(InterfaceTest, Apocalypse) {
 }
 
 TEST_F(InterfaceTest, SerializePlugin) {
-  PullSerializer* serializer = nullptr;
+  PipelinedSerializer* serializer = nullptr;
   auto const message = ParseFromBytes<principia::serialization::Plugin>(
       serialized_simple_plugin_);
 
@@ -648,6 +724,34 @@ TEST_F(InterfaceTest, SerializePlugin) {
   EXPECT_THAT(serialization, IsNull());
 }
 
+TEST_F(InterfaceTest, SerializePluginIntoBuffer) {
+  PipelinedSerializer* serializer = nullptr;
+  auto const message = ParseFromBytes<principia::serialization::Plugin>(
+      serialized_simple_plugin_);
+
+  int const max_chunk_size =
+      principia__SerializePluginMaxChunkSize(/*compressor=*/"", "hexadecimal");
+  EXPECT_LE(hexadecimal_simple_plugin_.size(), max_chunk_size);
+  std::vector<char> buffer(max_chunk_size);
+
+  EXPECT_CALL(*plugin_, WriteToMessage(_)).WillOnce(SetArgPointee<0>(message));
+  int const size = principia__SerializePluginIntoBuffer(plugin_.get(),
+                                                        &serializer,
+                                                        /*compressor=*/"",
+                                                        "hexadecimal",
+                                                        buffer.data(),
+                                                        buffer.size());
+  EXPECT_EQ(hexadecimal_simple_plugin_,
+            std::string(buffer.data(), buffer.data() + size));
+  EXPECT_EQ(0,
+            principia__SerializePluginIntoBuffer(plugin_.get(),
+                                                 &serializer,
+                                                 /*compressor=*/"",
+                                                 "hexadecimal",
+                                                 buffer.data(),
+                                                 buffer.size()));
+}
+
 TEST_F(InterfaceTest, DeserializePlugin) {
   PushDeserializer* deserializer = nullptr;
   Plugin const* plugin = nullptr;
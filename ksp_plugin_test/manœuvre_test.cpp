@@ -165,9 +165,6 @@ TEST_F(ManœuvreTest, TimedBurn) {
   EXPECT_EQ(t0_ + (2 - Sqrt(2)) * Second, manœuvre.time_of_half_Δv());
 
   EXPECT_OK(discrete_trajectory_.Append(manœuvre.initial_time(), dof_));
-  EXPECT_CALL(*mock_reference_frame_,
-              ToThisFrameAtTime(manœuvre.initial_time()))
-      .WillOnce(Return(rigid_motion_));
   EXPECT_CALL(*mock_reference_frame_,
               MotionOfThisFrame(manœuvre.initial_time()))
       .WillOnce(Return(accelerated_rigid_motion_));
@@ -227,9 +224,6 @@ TEST_F(ManœuvreTest, TargetΔv) {
   EXPECT_EQ(t0_, manœuvre.time_of_half_Δv());
 
   EXPECT_OK(discrete_trajectory_.Append(manœuvre.initial_time(), dof_));
-  EXPECT_CALL(*mock_reference_frame_,
-              ToThisFrameAtTime(manœuvre.initial_time()))
-      .WillOnce(Return(rigid_motion_));
   EXPECT_CALL(*mock_reference_frame_,
               MotionOfThisFrame(manœuvre.initial_time()))
       .WillOnce(Return(accelerated_rigid_motion_));
@@ -314,9 +308,6 @@ TEST_F(ManœuvreTest, Apollo8SIVB) {
   // Final acceleration from Table 4-2. Comparison of Significant Trajectory
   // Events.
   EXPECT_OK(discrete_trajectory_.Append(first_manœuvre.initial_time(), dof_));
-  EXPECT_CALL(*mock_reference_frame_,
-              ToThisFrameAtTime(first_manœuvre.initial_time()))
-      .WillOnce(Return(rigid_motion_));
   EXPECT_CALL(*mock_reference_frame_,
               MotionOfThisFrame(first_manœuvre.initial_time()))
       .WillOnce(Return(accelerated_rigid_motion_));
@@ -363,9 +354,6 @@ TEST_F(ManœuvreTest, Apollo8SIVB) {
   // Final acceleration from Table 4-2. Comparison of Significant Trajectory
   // Events.
   EXPECT_OK(discrete_trajectory_.Append(second_manœuvre.initial_time(), dof_));
-  EXPECT_CALL(*mock_reference_frame_,
-              ToThisFrameAtTime(second_manœuvre.initial_time()))
-      .WillOnce(Return(rigid_motion_));
   EXPECT_CALL(*mock_reference_frame_,
               MotionOfThisFrame(second_manœuvre.initial_time()))
       .WillOnce(Return(accelerated_rigid_motion_));
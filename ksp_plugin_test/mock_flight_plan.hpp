@@ -28,6 +28,10 @@ class MockFlightPlan : public FlightPlan {
               Replace,
               (NavigationManœuvre::Burn const& burn, int index),
               (override));
+  MOCK_METHOD(absl::Status,
+              ReplaceAsynchronously,
+              (NavigationManœuvre::Burn const& burn, int index),
+              (override));
 
   MOCK_METHOD(absl::Status,
               SetDesiredFinalTime,
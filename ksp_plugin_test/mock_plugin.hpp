@@ -3,6 +3,8 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "ksp_plugin/plugin.hpp"  // 🧙 For Plugin.
@@ -71,6 +73,11 @@ class MockPlugin : public Plugin {
               (Index parent_index, GUID const& vessel_guid),
               (const, override));
 
+  MOCK_METHOD(std::vector<RelativeDegreesOfFreedom<AliceSun>>,
+              VesselsFromParent,
+              (std::vector<GUID> const& vessel_guids),
+              (const, override));
+
   MOCK_METHOD(RelativeDegreesOfFreedom<AliceSun>,
               CelestialFromParent,
               (Index celestial_index),
@@ -95,6 +102,30 @@ class MockPlugin : public Plugin {
                    prediction_adaptive_step_parameters),
               (const, override));
 
+  MOCK_METHOD(void,
+              SetMaxHistoryStep,
+              (std::optional<Time> const& max_history_step),
+              (override));
+
+  MOCK_METHOD(void,
+              SetPredictionKeplerTolerance,
+              (std::optional<Angle> const& tolerance),
+              (override));
+
+  MOCK_METHOD(
+      (std::vector<std::pair<PartId, RigidMotion<EccentricPart, World>>>),
+      GetAllPartsActualMotions,
+      (GUID const& vessel_guid,
+       (RigidMotion<Barycentric, World> const& barycentric_to_world)),
+      (const, override));
+
+  MOCK_METHOD((RigidMotion<Barycentric, World>),
+              BarycentricToWorld,
+              (bool reference_part_is_unmoving,
+               PartId reference_part_id,
+               std::optional<Position<World>> const& main_body_centre),
+              (const, override));
+
   MOCK_METHOD(bool, HasVessel, (GUID const& vessel_guid), (const, override));
   MOCK_METHOD(not_null<Vessel*>,
               GetVessel,
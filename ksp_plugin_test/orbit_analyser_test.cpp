@@ -117,6 +117,26 @@ TEST_F(OrbitAnalyserTest, TinyAnalysis) {
   } while (analyser.analysis() == nullptr);
 }
 
+TEST_F(OrbitAnalyserTest, DeferredAnalysis) {
+  OrbitAnalyser analyser(ephemeris_.get(), DefaultHistoryParameters());
+  auto const& arc =
+      *topex_poséidon_.orbit(
+          {StandardProduct3::SatelliteGroup::General, 1}).front();
+  EXPECT_OK(ephemeris_->Prolong(arc.begin()->time));
+  analyser.DeferAnalysis(
+      {.first_time = arc.begin()->time,
+       .first_degrees_of_freedom = itrs_.FromThisFrameAtTime(arc.begin()->time)(
+           arc.begin()->degrees_of_freedom),
+       .mission_duration = Abs(J2000 - arc.begin()->time) * 0x1p-45});
+  // Nothing is computed until the analysis is refreshed.
+  absl::SleepFor(absl::Milliseconds(100));
+  EXPECT_FALSE(analyser.last_parameters().has_value());
+  EXPECT_THAT(analyser.progress_of_next_analysis(), Eq(0));
+  do {
+    analyser.RefreshAnalysis();
+    absl::SleepFor(absl::Milliseconds(10));
+  } while (analyser.analysis() == nullptr);
+}
 
 TEST_F(OrbitAnalyserTest, TOPEXPoséidon) {
   OrbitAnalyser analyser(ephemeris_.get(), DefaultHistoryParameters());
@@ -135,11 +155,13 @@ TEST_F(OrbitAnalyserTest, TOPEXPoséidon) {
     absl::SleepFor(absl::Milliseconds(10));
   }
   // Since |progress_of_next_analysis| only tracks the integration, not the
-  // analysis, we have no guarantee that an analysis is available immediately.
+  // analysis, we have no guarantee that an analysis is available immediately,
+  // and the ground track is published after the elements.
   do {
     absl::SleepFor(absl::Milliseconds(10));
     analyser.RefreshAnalysis();
-  } while (analyser.analysis() == nullptr);
+  } while (analyser.analysis() == nullptr ||
+           !analyser.analysis()->ground_track().has_value());
   EXPECT_THAT(analyser.analysis()
                   ->elements()
                   ->mean_semimajor_axis_interval()
@@ -171,5 +193,33 @@ TEST_F(OrbitAnalyserTest, TOPEXPoséidon) {
                              Property(&OrbitRecurrence::Cᴛₒ, 10))));
 }
 
+TEST_F(OrbitAnalyserTest, Restart) {
+  OrbitAnalyser analyser(ephemeris_.get(), DefaultHistoryParameters());
+  auto const& arc =
+      *topex_poséidon_.orbit(
+          {StandardProduct3::SatelliteGroup::General, 1}).front();
+  EXPECT_OK(ephemeris_->Prolong(arc.begin()->time));
+  OrbitAnalyser::Parameters parameters{
+      .first_time = arc.begin()->time,
+      .first_degrees_of_freedom = itrs_.FromThisFrameAtTime(arc.begin()->time)(
+          arc.begin()->degrees_of_freedom),
+      .mission_duration = 100 * Day};
+  analyser.RequestAnalysis(parameters);
+  // The long analysis is stale as soon as a different mission duration is
+  // requested, so it is abandoned without publishing anything.
+  parameters.mission_duration = 3 * Hour;
+  analyser.RequestAnalysis(parameters);
+  do {
+    absl::SleepFor(absl::Milliseconds(10));
+    analyser.RefreshAnalysis();
+  } while (analyser.analysis() == nullptr ||
+           !analyser.analysis()->ground_track().has_value());
+  EXPECT_THAT(analyser.analysis()->mission_duration(), IsNear(3_(1) * Hour));
+  EXPECT_THAT(analyser.analysis()->recurrence(),
+              Optional(AllOf(Property(&OrbitRecurrence::νₒ, 13),
+                             Property(&OrbitRecurrence::Dᴛₒ, -3),
+                             Property(&OrbitRecurrence::Cᴛₒ, 10))));
+}
+
 }  // namespace ksp_plugin
 }  // namespace principia
@@ -1,6 +1,7 @@
 #include "ksp_plugin/pile_up.hpp"
 
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <utility>
@@ -11,6 +12,7 @@
 #include "base/not_null.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
+#include "geometry/instant.hpp"
 #include "geometry/r3_element.hpp"
 #include "geometry/r3x3_matrix.hpp"
 #include "geometry/rotation.hpp"
@@ -59,6 +61,7 @@ using namespace principia::astronomy::_epoch;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_instant;
 using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_r3x3_matrix;
 using namespace principia::geometry::_rotation;
@@ -314,7 +317,7 @@ TEST_F(PileUpTest, LifecycleWithIntrinsicForce) {
 
   CheckPreAdvanceTimeInvariants(pile_up);
 
-  EXPECT_CALL(ephemeris, FlowWithAdaptiveStep(_, _, _, _, _))
+  EXPECT_CALL(ephemeris, FlowWithAdaptiveStep(_, _, _, _, _, _))
       .WillOnce(DoAll(
           AppendToDiscreteTrajectory(DegreesOfFreedom<Barycentric>(
               Barycentric::origin +
@@ -444,7 +447,7 @@ TEST_F(PileUpTest, LifecycleWithoutIntrinsicForce) {
                                          140.2 * Metre / Second,
                                          310.2 / 3.0 * Metre / Second}))),
           Return(absl::OkStatus())));
-  EXPECT_CALL(ephemeris, FlowWithAdaptiveStep(_, _, _, _, _))
+  EXPECT_CALL(ephemeris, FlowWithAdaptiveStep(_, _, _, _, _, _))
       .WillOnce(DoAll(
           AppendToDiscreteTrajectory(DegreesOfFreedom<Barycentric>(
               Barycentric::origin +
@@ -653,6 +656,198 @@ TEST_F(PileUpTest, MidStepIntrinsicForce) {
       AlmostEquals(old_velocity + 0.5 * fixed_step * a, 1));
 }
 
+// Check that a free-falling pile-up extends its psychohistory, keeping only its
+// end points, until the next point of its history.
+TEST_F(PileUpTest, QuiescentPsychohistory) {
+  // An empty ephemeris, as in the previous test.
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  bodies.emplace_back(make_not_null_unique<MassiveBody>(1 * Kilogram));
+  std::vector<DegreesOfFreedom<Barycentric>> initial_state{
+      DegreesOfFreedom<Barycentric>{
+          Barycentric::origin +
+              Displacement<Barycentric>(
+                  {std::pow(2, 100) * Metre, 0 * Metre, 0 * Metre}),
+          Barycentric::unmoving}};
+  Ephemeris<Barycentric> ephemeris{
+      std::move(bodies),
+      initial_state,
+      /*initial_time=*/J2000,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Metre,
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<Barycentric>::FixedStepParameters{
+          SymplecticRungeKuttaNyströmIntegrator<
+              BlanesMoan2002SRKN6B,
+              Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+          1 * Second}};
+
+  EXPECT_CALL(deletion_callback_, Call()).Times(1);
+  TestablePileUp pile_up({&p1_, &p2_}, J2000,
+                         DefaultPsychohistoryParameters(),
+                         DefaultHistoryParameters(),
+                         &ephemeris,
+                         deletion_callback_.AsStdFunction());
+  Time const history_step = DefaultHistoryParameters().step();
+
+  EXPECT_OK(pile_up.AdvanceTime(J2000 + 0.5 * history_step));
+  DegreesOfFreedom<Barycentric> const initial_degrees_of_freedom =
+      pile_up.psychohistory()->front().degrees_of_freedom;
+  for (double const fraction : {0.6, 0.7, 0.8, 0.9}) {
+    Instant const t = J2000 + fraction * history_step;
+    EXPECT_OK(pile_up.AdvanceTime(t));
+    EXPECT_EQ(2, pile_up.psychohistory()->size());
+    EXPECT_EQ(J2000, pile_up.psychohistory()->front().time);
+    EXPECT_EQ(t, pile_up.psychohistory()->back().time);
+    // The motion is uniform, and the psychohistory extends it exactly.
+    EXPECT_THAT(pile_up.psychohistory()->back().degrees_of_freedom,
+                Componentwise(AlmostEquals(
+                                  initial_degrees_of_freedom.position() +
+                                      initial_degrees_of_freedom.velocity() *
+                                          (t - J2000),
+                                  0, 16),
+                              AlmostEquals(
+                                  initial_degrees_of_freedom.velocity(), 0)));
+  }
+
+  // Crossing a history step goes through the regular path.
+  EXPECT_OK(pile_up.AdvanceTime(J2000 + 1.5 * history_step));
+  EXPECT_EQ(J2000 + history_step, pile_up.psychohistory()->front().time);
+  EXPECT_EQ(J2000 + 1.5 * history_step,
+            pile_up.psychohistory()->back().time);
+}
+
+// Checks that the pile-ups integrated in a batch have the same motion as if
+// they were integrated separately.
+TEST_F(PileUpTest, BatchedHistories) {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  bodies.emplace_back(make_not_null_unique<MassiveBody>(6e24 * Kilogram));
+  std::vector<DegreesOfFreedom<Barycentric>> initial_state{
+      DegreesOfFreedom<Barycentric>{
+          Barycentric::origin +
+              Displacement<Barycentric>({1e7 * Metre, 0 * Metre, 0 * Metre}),
+          Barycentric::unmoving}};
+  Ephemeris<Barycentric> ephemeris{
+      std::move(bodies),
+      initial_state,
+      /*initial_time=*/J2000,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<Barycentric>::FixedStepParameters{
+          SymplecticRungeKuttaNyströmIntegrator<
+              BlanesMoan2002SRKN6B,
+              Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+          1 * Second}};
+
+  // Copies of |p1_| and |p2_| for the separate integrations.
+  Part p3(part_id1_ + 2,
+          "p3",
+          mass1_,
+          EccentricPart::origin,
+          inertia_tensor1_,
+          RigidMotion<EccentricPart, Barycentric>::MakeNonRotatingMotion(
+              p1_dof_),
+          /*deletion_callback=*/nullptr);
+  Part p4(part_id2_ + 2,
+          "p4",
+          mass2_,
+          EccentricPart::origin,
+          inertia_tensor2_,
+          RigidMotion<EccentricPart, Barycentric>::MakeNonRotatingMotion(
+              p2_dof_),
+          /*deletion_callback=*/nullptr);
+
+  auto const make_pile_up = [&ephemeris](not_null<Part*> const part) {
+    return std::make_unique<TestablePileUp>(std::list<not_null<Part*>>{part},
+                                            J2000,
+                                            DefaultPsychohistoryParameters(),
+                                            DefaultHistoryParameters(),
+                                            &ephemeris,
+                                            /*deletion_callback=*/nullptr);
+  };
+  auto const batched1 = make_pile_up(&p1_);
+  auto const batched2 = make_pile_up(&p2_);
+  auto const separate1 = make_pile_up(&p3);
+  auto const separate2 = make_pile_up(&p4);
+
+  Time const history_step = DefaultHistoryParameters().step();
+  for (double const steps : {2.5, 4.5, 4.8, 7.5}) {
+    Instant const t = J2000 + steps * history_step;
+    auto const batches =
+        PileUp::Batch({batched1.get(), batched2.get()}, t);
+    if (steps == 4.8) {
+      // No history step to integrate.
+      ASSERT_EQ(2, batches.size());
+    } else {
+      ASSERT_EQ(1, batches.size());
+      EXPECT_THAT(batches[0], ElementsAre(batched1.get(), batched2.get()));
+    }
+    for (auto const& batch : batches) {
+      for (auto const& status : PileUp::DeformAndAdvanceTime(batch, t)) {
+        EXPECT_OK(status);
+      }
+    }
+    EXPECT_OK(separate1->DeformAndAdvanceTime(t));
+    EXPECT_OK(separate2->DeformAndAdvanceTime(t));
+
+    for (auto const& [separate, batched] :
+         {std::pair{separate1.get(), batched1.get()},
+          std::pair{separate2.get(), batched2.get()}}) {
+      EXPECT_EQ(separate->psychohistory()->front().time,
+                batched->psychohistory()->front().time);
+      EXPECT_EQ(separate->psychohistory()->front().degrees_of_freedom,
+                batched->psychohistory()->front().degrees_of_freedom);
+      EXPECT_EQ(t, batched->psychohistory()->back().time);
+      EXPECT_EQ(separate->psychohistory()->back().degrees_of_freedom,
+                batched->psychohistory()->back().degrees_of_freedom);
+    }
+  }
+  EXPECT_EQ(J2000 + 7 * history_step, batched1->psychohistory()->front().time);
+}
+
+// Checks that the history step is selected from the dynamics of the pile-up
+// when there is a maximal history step.
+TEST_F(PileUpTest, MaxHistoryStep) {
+  // An empty ephemeris, as in the previous tests.
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  bodies.emplace_back(make_not_null_unique<MassiveBody>(1 * Kilogram));
+  std::vector<DegreesOfFreedom<Barycentric>> initial_state{
+      DegreesOfFreedom<Barycentric>{
+          Barycentric::origin +
+              Displacement<Barycentric>(
+                  {std::pow(2, 100) * Metre, 0 * Metre, 0 * Metre}),
+          Barycentric::unmoving}};
+  Ephemeris<Barycentric> ephemeris{
+      std::move(bodies),
+      initial_state,
+      /*initial_time=*/J2000,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Metre,
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<Barycentric>::FixedStepParameters{
+          SymplecticRungeKuttaNyströmIntegrator<
+              BlanesMoan2002SRKN6B,
+              Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+          1 * Second}};
+
+  EXPECT_CALL(deletion_callback_, Call()).Times(1);
+  TestablePileUp pile_up({&p1_}, J2000,
+                         DefaultPsychohistoryParameters(),
+                         DefaultHistoryParameters(),
+                         &ephemeris,
+                         deletion_callback_.AsStdFunction());
+  Time const history_step = DefaultHistoryParameters().step();
+  pile_up.set_max_history_step(4 * history_step);
+
+  // The pile-up is very far from the only body, so its history uses the
+  // maximal step.
+  Instant const t = J2000 + 10.5 * history_step;
+  auto const batches = PileUp::Batch({&pile_up}, t);
+  ASSERT_EQ(1, batches.size());
+  for (auto const& status : PileUp::DeformAndAdvanceTime(batches[0], t)) {
+    EXPECT_OK(status);
+  }
+  EXPECT_EQ(J2000 + 8 * history_step, pile_up.psychohistory()->front().time);
+  EXPECT_EQ(t, pile_up.psychohistory()->back().time);
+}
+
 TEST_F(PileUpTest, Serialization) {
   MockEphemeris<Barycentric> ephemeris;
   p1_.apply_intrinsic_force(
@@ -736,7 +931,7 @@ TEST_F(PileUpTest, SerializationCompatibility) {
                                          &ephemeris,
                                          deletion_callback_.AsStdFunction());
 
-  EXPECT_CALL(ephemeris, FlowWithAdaptiveStep(_, _, _, _, _))
+  EXPECT_CALL(ephemeris, FlowWithAdaptiveStep(_, _, _, _, _, _))
       .WillOnce(DoAll(
           AppendToDiscreteTrajectory(DegreesOfFreedom<Barycentric>(
               Barycentric::origin +
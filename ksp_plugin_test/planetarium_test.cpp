@@ -27,6 +27,7 @@
 #include "physics/rigid_motion.hpp"
 #include "physics/rigid_reference_frame.hpp"
 #include "physics/rotating_body.hpp"
+#include "physics/trajectory.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
@@ -40,7 +41,9 @@ namespace ksp_plugin {
 
 using ::testing::_;
 using ::testing::AllOf;
+using ::testing::DoAll;
 using ::testing::Ge;
+using ::testing::InvokeWithoutArgs;
 using ::testing::Le;
 using ::testing::Return;
 using ::testing::ReturnRef;
@@ -66,6 +69,7 @@ using namespace principia::physics::_massive_body;
 using namespace principia::physics::_rigid_motion;
 using namespace principia::physics::_rigid_reference_frame;
 using namespace principia::physics::_rotating_body;
+using namespace principia::physics::_trajectory;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
@@ -264,6 +268,342 @@ TEST_F(PlanetariumTest, PlotMethod2) {
   }
 }
 
+TEST_F(PlanetariumTest, PlotMethod2Culling) {
+  // Half of a circular trajectory around the origin, with large segments, the
+  // middle of which passes behind the camera, close to it.
+  DiscreteTrajectory<Barycentric> discrete_trajectory;
+  AppendTrajectoryTimeline(/*from=*/NewCircularTrajectoryTimeline<Barycentric>(
+                                        /*period=*/100'000 * Second,
+                                        /*r=*/30 * Metre,
+                                        /*Δt=*/1000 * Second,
+                                        /*t1=*/t0_,
+                                        /*t2=*/t0_ + 50'001 * Second),
+                           /*to=*/discrete_trajectory);
+
+  int evaluations = 0;
+  EXPECT_CALL(plotting_frame_, ToThisFrameAtTime(_))
+      .WillRepeatedly(DoAll(InvokeWithoutArgs([&evaluations]() {
+                              ++evaluations;
+                            }),
+                            Return(RigidMotion<Barycentric, Navigation>(
+                                RigidTransformation<Barycentric,
+                                                    Navigation>::Identity(),
+                                Barycentric::nonrotating,
+                                Barycentric::unmoving))));
+
+  // No dark area, human visual acuity, wide field of view.
+  Planetarium::Parameters parameters(
+      /*sphere_radius_multiplier=*/1,
+      /*angular_resolution=*/0.4 * ArcMinute,
+      /*field_of_view=*/90 * Degree);
+  Planetarium planetarium(parameters,
+                          perspective_,
+                          &ephemeris_,
+                          &plotting_frame_,
+                          plotting_to_scaled_space_);
+  auto const plot = [&](Trajectory<Barycentric> const& trajectory) {
+    evaluations = 0;
+    return planetarium.PlotMethod2(trajectory,
+                                   discrete_trajectory.front().time,
+                                   discrete_trajectory.back().time,
+                                   /*now=*/t0_,
+                                   /*reverse=*/false);
+  };
+
+  // The segment is not culled since it is not a |DiscreteTrajectory|.
+  auto const unculled_rp2_lines =
+      plot(discrete_trajectory.segments().front());
+  int const unculled_evaluations = evaluations;
+  auto const culled_rp2_lines = plot(discrete_trajectory);
+  int const culled_evaluations = evaluations;
+
+  // The part behind the camera is not plotted, and the culling avoids
+  // evaluating it at fine resolution.
+  EXPECT_THAT(unculled_rp2_lines, SizeIs(2));
+  EXPECT_THAT(culled_rp2_lines, SizeIs(2));
+  EXPECT_LT(culled_evaluations, unculled_evaluations);
+}
+
+TEST_F(PlanetariumTest, PlotMethod3Vertices) {
+  // A circular trajectory around the origin, with many small segments.
+  DiscreteTrajectory<Barycentric> discrete_trajectory;
+  AppendTrajectoryTimeline(/*from=*/NewCircularTrajectoryTimeline<Barycentric>(
+                                        /*period=*/100'000 * Second,
+                                        /*r=*/10 * Metre,
+                                        /*Δt=*/1 * Second,
+                                        /*t1=*/t0_,
+                                        /*t2=*/t0_ + 30'000 * Second),
+                           /*to=*/discrete_trajectory);
+
+  EXPECT_CALL(plotting_frame_, t_min())
+      .WillRepeatedly(Return(discrete_trajectory.front().time));
+  EXPECT_CALL(plotting_frame_, t_max())
+      .WillRepeatedly(Return(discrete_trajectory.back().time));
+  EXPECT_CALL(plotting_frame_, ToThisFrameAtTime(_))
+      .WillRepeatedly(Return(RigidMotion<Barycentric, Navigation>(
+          RigidTransformation<Barycentric, Navigation>::Identity(),
+          Barycentric::nonrotating,
+          Barycentric::unmoving)));
+
+  // No dark area, human visual acuity, wide field of view.
+  Planetarium::Parameters parameters(
+      /*sphere_radius_multiplier=*/1,
+      /*angular_resolution=*/0.4 * ArcMinute,
+      /*field_of_view=*/90 * Degree);
+  Planetarium planetarium(parameters,
+                          perspective_,
+                          &ephemeris_,
+                          &plotting_frame_,
+                          plotting_to_scaled_space_);
+
+  std::vector<ScaledSpacePoint> points;
+  planetarium.PlotMethod3(
+      discrete_trajectory,
+      discrete_trajectory.begin(),
+      discrete_trajectory.end(),
+      /*now=*/t0_,
+      /*reverse=*/false,
+      [&points](ScaledSpacePoint const& point) { points.push_back(point); },
+      /*max_points=*/10'000);
+
+  // The vertices are the same as the points, and the plot stops when the
+  // buffer is full.
+  std::vector<ScaledSpacePoint> vertices(points.size());
+  for (int const max_points : {static_cast<int>(points.size()), 10}) {
+    int const vertex_count =
+        planetarium.PlotMethod3(discrete_trajectory,
+                                discrete_trajectory.begin(),
+                                discrete_trajectory.end(),
+                                /*now=*/t0_,
+                                /*reverse=*/false,
+                                vertices.data(),
+                                max_points);
+    EXPECT_EQ(max_points, vertex_count);
+    for (int i = 0; i < vertex_count; ++i) {
+      EXPECT_EQ(points[i].x, vertices[i].x);
+      EXPECT_EQ(points[i].y, vertices[i].y);
+      EXPECT_EQ(points[i].z, vertices[i].z);
+    }
+  }
+}
+
+TEST_F(PlanetariumTest, PlotMethod3SampleCache) {
+  // A circular trajectory around the origin, with many small segments.
+  DiscreteTrajectory<Barycentric> discrete_trajectory;
+  AppendTrajectoryTimeline(/*from=*/NewCircularTrajectoryTimeline<Barycentric>(
+                                        /*period=*/100'000 * Second,
+                                        /*r=*/10 * Metre,
+                                        /*Δt=*/1 * Second,
+                                        /*t1=*/t0_,
+                                        /*t2=*/t0_ + 30'000 * Second),
+                           /*to=*/discrete_trajectory);
+
+  int evaluations = 0;
+  EXPECT_CALL(plotting_frame_, ToThisFrameAtTime(_))
+      .WillRepeatedly(DoAll(InvokeWithoutArgs([&evaluations]() {
+                              ++evaluations;
+                            }),
+                            Return(RigidMotion<Barycentric, Navigation>(
+                                RigidTransformation<Barycentric,
+                                                    Navigation>::Identity(),
+                                Barycentric::nonrotating,
+                                Barycentric::unmoving))));
+
+  // No dark area, human visual acuity, wide field of view.
+  Planetarium::Parameters parameters(
+      /*sphere_radius_multiplier=*/1,
+      /*angular_resolution=*/0.4 * ArcMinute,
+      /*field_of_view=*/90 * Degree);
+  Planetarium::SampleCache sample_cache;
+  auto const plot = [&](Instant const& first_time, Instant const& last_time) {
+    Planetarium planetarium(parameters,
+                            perspective_,
+                            &ephemeris_,
+                            &plotting_frame_,
+                            plotting_to_scaled_space_,
+                            &sample_cache);
+    std::vector<ScaledSpacePoint> points;
+    planetarium.PlotMethod3(
+        discrete_trajectory,
+        first_time,
+        last_time,
+        /*now=*/last_time,
+        /*reverse=*/false,
+        [&points](ScaledSpacePoint const& point) { points.push_back(point); },
+        /*max_points=*/10'000,
+        /*minimal_distance=*/nullptr,
+        /*cache_samples=*/true);
+    return points;
+  };
+
+  auto const points1 = plot(t0_, t0_ + 25'000 * Second);
+  int const evaluations1 = evaluations;
+  evaluations = 0;
+  // The plot of a slightly shifted interval reuses most of the samples.
+  auto const points2 = plot(t0_ + 10 * Second, t0_ + 25'010 * Second);
+  int const evaluations2 = evaluations;
+
+  EXPECT_EQ(44, evaluations1);
+  EXPECT_EQ(43, points1.size());
+  // Only the endpoints of the second plot are evaluated.
+  EXPECT_EQ(2, evaluations2);
+  EXPECT_EQ(44, points2.size());
+}
+
+TEST_F(PlanetariumTest, PlotMethod3SampleCacheResolutions) {
+  // A circular trajectory around the origin, with many small segments.
+  DiscreteTrajectory<Barycentric> discrete_trajectory;
+  AppendTrajectoryTimeline(/*from=*/NewCircularTrajectoryTimeline<Barycentric>(
+                                        /*period=*/100'000 * Second,
+                                        /*r=*/10 * Metre,
+                                        /*Δt=*/1 * Second,
+                                        /*t1=*/t0_,
+                                        /*t2=*/t0_ + 30'000 * Second),
+                           /*to=*/discrete_trajectory);
+
+  int evaluations = 0;
+  EXPECT_CALL(plotting_frame_, ToThisFrameAtTime(_))
+      .WillRepeatedly(DoAll(InvokeWithoutArgs([&evaluations]() {
+                              ++evaluations;
+                            }),
+                            Return(RigidMotion<Barycentric, Navigation>(
+                                RigidTransformation<Barycentric,
+                                                    Navigation>::Identity(),
+                                Barycentric::nonrotating,
+                                Barycentric::unmoving))));
+
+  Planetarium::SampleCache sample_cache;
+  auto const plot = [&](Angle const& angular_resolution) {
+    // No dark area, wide field of view.
+    Planetarium::Parameters parameters(
+        /*sphere_radius_multiplier=*/1,
+        angular_resolution,
+        /*field_of_view=*/90 * Degree);
+    Planetarium planetarium(parameters,
+                            perspective_,
+                            &ephemeris_,
+                            &plotting_frame_,
+                            plotting_to_scaled_space_,
+                            &sample_cache);
+    std::vector<ScaledSpacePoint> points;
+    evaluations = 0;
+    planetarium.PlotMethod3(
+        discrete_trajectory,
+        /*first_time=*/t0_,
+        /*last_time=*/t0_ + 25'000 * Second,
+        /*now=*/t0_ + 25'000 * Second,
+        /*reverse=*/false,
+        [&points](ScaledSpacePoint const& point) { points.push_back(point); },
+        /*max_points=*/10'000,
+        /*minimal_distance=*/nullptr,
+        /*cache_samples=*/true);
+    return points.size();
+  };
+
+  // A fine plot, a coarse plot that reuses its samples, and a fine plot that
+  // still finds the samples of the first one.
+  EXPECT_EQ(84, plot(0.1 * ArcMinute));
+  EXPECT_EQ(85, evaluations);
+  EXPECT_EQ(29, plot(1 * ArcMinute));
+  EXPECT_EQ(0, evaluations);
+  EXPECT_EQ(84, plot(0.1 * ArcMinute));
+  EXPECT_EQ(0, evaluations);
+}
+
+TEST_F(PlanetariumTest, PlotMethod3SampleCacheChangingTrajectory) {
+  // A circular trajectory around the origin, with many small segments, which
+  // is extended and then changed very slightly, like a prediction.
+  auto const timeline = NewCircularTrajectoryTimeline<Barycentric>(
+      /*period=*/100'000 * Second,
+      /*r=*/10 * Metre,
+      /*Δt=*/1 * Second,
+      /*t1=*/t0_,
+      /*t2=*/t0_ + 30'000 * Second);
+  auto const other_timeline = NewCircularTrajectoryTimeline<Barycentric>(
+      /*period=*/100'000 * Second,
+      /*r=*/10.000'001 * Metre,
+      /*Δt=*/1 * Second,
+      /*t1=*/t0_,
+      /*t2=*/t0_ + 30'000 * Second);
+  DiscreteTrajectory<Barycentric> discrete_trajectory;
+  auto const append = [&discrete_trajectory](auto const& from,
+                                             Instant const& t1,
+                                             Instant const& t2) {
+    for (auto const& [time, degrees_of_freedom] : from) {
+      if (t1 <= time && time < t2) {
+        CHECK_OK(discrete_trajectory.Append(time, degrees_of_freedom));
+      }
+    }
+  };
+
+  int evaluations = 0;
+  EXPECT_CALL(plotting_frame_, ToThisFrameAtTime(_))
+      .WillRepeatedly(DoAll(InvokeWithoutArgs([&evaluations]() {
+                              ++evaluations;
+                            }),
+                            Return(RigidMotion<Barycentric, Navigation>(
+                                RigidTransformation<Barycentric,
+                                                    Navigation>::Identity(),
+                                Barycentric::nonrotating,
+                                Barycentric::unmoving))));
+
+  // No dark area, human visual acuity, wide field of view.
+  Planetarium::Parameters parameters(
+      /*sphere_radius_multiplier=*/1,
+      /*angular_resolution=*/0.4 * ArcMinute,
+      /*field_of_view=*/90 * Degree);
+  auto const plot = [&](Planetarium::SampleCache& sample_cache) {
+    Planetarium planetarium(parameters,
+                            perspective_,
+                            &ephemeris_,
+                            &plotting_frame_,
+                            plotting_to_scaled_space_,
+                            &sample_cache);
+    std::vector<ScaledSpacePoint> points;
+    evaluations = 0;
+    planetarium.PlotMethod3(
+        discrete_trajectory,
+        discrete_trajectory.front().time,
+        discrete_trajectory.back().time,
+        /*now=*/discrete_trajectory.back().time,
+        /*reverse=*/false,
+        [&points](ScaledSpacePoint const& point) { points.push_back(point); },
+        /*max_points=*/10'000,
+        /*minimal_distance=*/nullptr,
+        /*cache_samples=*/true);
+    return evaluations;
+  };
+
+  Planetarium::SampleCache sample_cache;
+  append(timeline, t0_, t0_ + 20'000 * Second);
+  int const initial_evaluations = plot(sample_cache);
+  EXPECT_LT(0, initial_evaluations);
+
+  // When the trajectory is extended, the samples of its old part are reused,
+  // so only the new part is evaluated.
+  append(timeline, t0_ + 20'000 * Second, t0_ + 30'000 * Second);
+  int const extended_evaluations = plot(sample_cache);
+  {
+    Planetarium::SampleCache fresh_sample_cache;
+    EXPECT_LT(extended_evaluations, plot(fresh_sample_cache));
+  }
+  EXPECT_LT(extended_evaluations, initial_evaluations);
+
+  // When the end of the trajectory changes, only the samples of its unchanged
+  // beginning are reused.
+  discrete_trajectory.ForgetAfter(t0_ + 10'000 * Second);
+  append(other_timeline, t0_ + 10'000 * Second, t0_ + 30'000 * Second);
+  int const changed_evaluations = plot(sample_cache);
+  EXPECT_LT(extended_evaluations, changed_evaluations);
+  {
+    Planetarium::SampleCache fresh_sample_cache;
+    EXPECT_LT(changed_evaluations, plot(fresh_sample_cache));
+  }
+
+  // Plotting the unchanged trajectory again doesn't evaluate anything.
+  EXPECT_EQ(0, plot(sample_cache));
+}
+
 #if !defined(_DEBUG)
 TEST_F(PlanetariumTest, RealSolarSystem) {
   auto const discrete_trajectory =
@@ -6,7 +6,7 @@
 #include <vector>
 
 #include "base/file.hpp"
-#include "base/pull_serializer.hpp"
+#include "base/pipelined_serializer.hpp"
 #include "base/push_deserializer.hpp"
 #include "ksp_plugin/interface.hpp"  // 🧙 For interface functions.
 #include "testing_utilities/serialization.hpp"
@@ -24,7 +24,7 @@ using interface::principia__DeleteString;
 using interface::principia__DeserializePlugin;
 using interface::principia__SerializePlugin;
 using namespace principia::base::_file;
-using namespace principia::base::_pull_serializer;
+using namespace principia::base::_pipelined_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::testing_utilities::_serialization;
 
@@ -85,7 +85,7 @@ void WritePluginToFile(std::filesystem::path const& filename,
                        not_null<std::unique_ptr<Plugin const>> plugin,
                        std::int64_t& bytes_processed) {
   OFStream file(filename);
-  PullSerializer* serializer = nullptr;
+  PipelinedSerializer* serializer = nullptr;
   char const* b64 = nullptr;
 
   LOG(ERROR) << "Serialization starting";
@@ -32,8 +32,10 @@
 #include "integrators/symmetric_linear_multistep_integrator.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "ksp_plugin/identification.hpp"
+#include "ksp_plugin/vessel.hpp"
 #include "physics/continuous_trajectory.hpp"
 #include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/kepler_orbit.hpp"
 #include "physics/massive_body.hpp"
@@ -41,9 +43,11 @@
 #include "physics/rigid_motion.hpp"
 #include "physics/rigid_reference_frame.hpp"
 #include "physics/solar_system.hpp"
+#include "physics/trajectory.hpp"
 #include "quantities/astronomy.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
+#include "quantities/numbers.hpp"  // 🧙 For π.
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
 #include "testing_utilities/almost_equals.hpp"
@@ -51,6 +55,7 @@
 #include "testing_utilities/make_not_null.hpp"
 #include "testing_utilities/matchers.hpp"
 #include "testing_utilities/numerics.hpp"
+#include "testing_utilities/numerics_matchers.hpp"
 #include "testing_utilities/serialization.hpp"
 #include "testing_utilities/solar_system_factory.hpp"
 #include "testing_utilities/vanishes_before.hpp"
@@ -98,14 +103,17 @@ using namespace principia::integrators::_symmetric_linear_multistep_integrator;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_identification;
 using namespace principia::ksp_plugin::_plugin;
+using namespace principia::ksp_plugin::_vessel;
 using namespace principia::physics::_continuous_trajectory;
 using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_kepler_orbit;
 using namespace principia::physics::_massive_body;
 using namespace principia::physics::_rigid_motion;
 using namespace principia::physics::_rigid_reference_frame;
 using namespace principia::physics::_solar_system;
+using namespace principia::physics::_trajectory;
 using namespace principia::quantities::_astronomy;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
@@ -116,6 +124,7 @@ using namespace principia::testing_utilities::_componentwise;
 using namespace principia::testing_utilities::_make_not_null;
 using namespace principia::testing_utilities::_matchers;
 using namespace principia::testing_utilities::_numerics;
+using namespace principia::testing_utilities::_numerics_matchers;
 using namespace principia::testing_utilities::_serialization;
 using namespace principia::testing_utilities::_solar_system_factory;
 using namespace principia::testing_utilities::_vanishes_before;
@@ -139,6 +148,26 @@ MATCHER_P(HasNonvanishingIntrinsicAccelerationAt, t, "") {
   return false;
 }
 
+// Inserts a point at |time|, which must not be the time of an existing point,
+// in |trajectory|.
+void InsertPoint(Instant const& time,
+                 DegreesOfFreedom<Barycentric> const& degrees_of_freedom,
+                 DiscreteTrajectory<Barycentric>& trajectory) {
+  DiscreteTrajectory<Barycentric> new_trajectory;
+  bool inserted = false;
+  for (auto const& [t, dof] : trajectory) {
+    if (!inserted && time < t) {
+      EXPECT_OK(new_trajectory.Append(time, degrees_of_freedom));
+      inserted = true;
+    }
+    EXPECT_OK(new_trajectory.Append(t, dof));
+  }
+  if (!inserted) {
+    EXPECT_OK(new_trajectory.Append(time, degrees_of_freedom));
+  }
+  trajectory = std::move(new_trajectory);
+}
+
 }  // namespace
 
 class TestablePlugin : public Plugin {
@@ -170,6 +199,49 @@ class TestablePlugin : public Plugin {
     return trajectories_.at(index);
   }
 
+  // Inserts a spurious closest approach at |time| in the cache of
+  // |ComputeAndRenderClosestApproaches| for the given arguments.  It survives
+  // the calls that don't rescan the part of the trajectory around |time|.
+  static void InsertSpuriousClosestApproach(
+      Plugin const& plugin,
+      GUID const& vessel_guid,
+      VesselTrajectory const vessel_trajectory,
+      int const max_points,
+      Instant const& time,
+      DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+    InsertPoint(time,
+                degrees_of_freedom,
+                plugin.closest_approaches_cache_.at(vessel_guid)
+                    .at({vessel_trajectory, max_points})
+                    .periapsides);
+  }
+
+  static void ClearClosestApproachesCache(Plugin const& plugin) {
+    plugin.closest_approaches_cache_.clear();
+  }
+
+  // Inserts a spurious periapsis at |time| in the cache of
+  // |ComputeAndRenderApsides| for the given arguments.  It survives the calls
+  // that don't rescan the part of the trajectory around |time|.
+  static void InsertSpuriousPeriapsis(
+      Plugin const& plugin,
+      Index const celestial_index,
+      GUID const& vessel_guid,
+      VesselTrajectory const vessel_trajectory,
+      int const max_points,
+      Instant const& time,
+      DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+    InsertPoint(time,
+                degrees_of_freedom,
+                plugin.apsides_cache_.at(vessel_guid)
+                    .at({vessel_trajectory, celestial_index, max_points})
+                    .periapsides);
+  }
+
+  static void ClearApsidesCache(Plugin const& plugin) {
+    plugin.apsides_cache_.clear();
+  }
+
   // We override this part of initialization in order to create a
   // |MockEphemeris| rather than an |Ephemeris|.
   void EndInitialization() override {
@@ -972,5 +1044,372 @@ TEST_F(PluginTest, Frenet) {
       AlmostEquals(alice_sun_to_world(satellite_initial_velocity_), 7, 83));
 }
 
+class PluginClosestApproachesTest : public PluginTest {
+ protected:
+  static constexpr int max_points = 100;
+  static constexpr int number_of_points = 1001;
+
+  PluginClosestApproachesTest()
+      : plugin_with_targets_(initial_time_, initial_time_, 0 * Radian) {
+    // The predictions must be computed by |UpdatePrediction|.
+    Vessel::MakeSynchronous();
+    plugin_with_targets_.InsertCelestialAbsoluteCartesian(
+        SolarSystemFactory::Earth,
+        /*parent_index=*/std::nullopt,
+        solar_system_->gravity_model_message(
+            SolarSystemFactory::name(SolarSystemFactory::Earth)),
+        solar_system_->cartesian_initial_state_message(
+            SolarSystemFactory::name(SolarSystemFactory::Earth)));
+    plugin_with_targets_.EndInitialization();
+    PartId part_id = 42;
+    for (auto const& [guid, scale] : {std::pair{target_, 1.0},
+                                      std::pair{other_target_, 1.1}}) {
+      bool inserted;
+      plugin_with_targets_.InsertOrKeepVessel(guid,
+                                              "v" + guid,
+                                              SolarSystemFactory::Earth,
+                                              /*loaded=*/false,
+                                              inserted);
+      plugin_with_targets_.InsertUnloadedPart(
+          part_id++,
+          "part",
+          guid,
+          RelativeDegreesOfFreedom<AliceSun>(
+              scale * satellite_initial_displacement_,
+              satellite_initial_velocity_ / std::sqrt(scale)));
+    }
+    plugin_with_targets_.PrepareToReportCollisions();
+    plugin_with_targets_.FreeVesselsAndPartsAndCollectPileUps(
+        20 * Milli(Second));
+    plugin_with_targets_.SetTargetVessel(target_, SolarSystemFactory::Earth);
+    plugin_with_targets_.AdvanceTime(
+        plugin_with_targets_.CurrentTime() + 1 * Second, 0 * Radian);
+    for (auto const& guid : {target_, other_target_}) {
+      auto future = plugin_with_targets_.CatchUpVessel(guid);
+      VesselSet collided_vessels;
+      plugin_with_targets_.WaitForVesselToCatchUp(*future, collided_vessels);
+    }
+    plugin_with_targets_.UpdatePrediction({target_, other_target_});
+  }
+
+  // Appends the points of indices [first, last[ of a trajectory that
+  // oscillates along the x axis around the prediction of the target.  The
+  // distance to the target is minimal at the odd multiples of
+  // |oscillation_period() / 2| after the beginning of the prediction.
+  void AppendPoints(int const first,
+                    int const last,
+                    DiscreteTrajectory<Barycentric>& trajectory) const {
+    AppendPointsAround(*plugin_with_targets_.GetVessel(target_)->prediction(),
+                       first,
+                       last,
+                       trajectory);
+  }
+
+  // Same as above, but the trajectory oscillates around |reference|.
+  void AppendPointsAround(Trajectory<Barycentric> const& reference,
+                          int const first,
+                          int const last,
+                          DiscreteTrajectory<Barycentric>& trajectory) const {
+    Instant const& t_min =
+        plugin_with_targets_.GetVessel(target_)->prediction()->front().time;
+    Length const d = 10 * Kilo(Metre);
+    Length const a = 5 * Kilo(Metre);
+    AngularFrequency const ω = 2 * π * Radian / oscillation_period();
+    for (int i = first; i < last; ++i) {
+      Instant const t = t_min + i * oscillation_period() / 100;
+      Angle const φ = ω * (t - t_min);
+      auto const reference_degrees_of_freedom =
+          reference.EvaluateDegreesOfFreedom(t);
+      EXPECT_OK(trajectory.Append(
+          t,
+          {reference_degrees_of_freedom.position() +
+               Displacement<Barycentric>({d + a * Cos(φ),
+                                          0 * Metre,
+                                          0 * Metre}),
+           reference_degrees_of_freedom.velocity() +
+               Velocity<Barycentric>({-a * ω * Sin(φ) / Radian,
+                                      0 * Metre / Second,
+                                      0 * Metre / Second})}));
+    }
+  }
+
+  // The trajectory built by |AppendPoints| spans 10 oscillation periods.
+  Time oscillation_period() const {
+    auto const& target_prediction =
+        *plugin_with_targets_.GetVessel(target_)->prediction();
+    return (target_prediction.back().time - target_prediction.front().time) /
+           (number_of_points - 1) * 100;
+  }
+
+  DiscreteTrajectory<World> ComputeClosestApproaches(
+      DiscreteTrajectory<Barycentric> const& trajectory) const {
+    DiscreteTrajectory<World> closest_approaches;
+    plugin_with_targets_.ComputeAndRenderClosestApproaches(
+        vessel_guid_,
+        VesselTrajectory::Prediction,
+        trajectory,
+        trajectory.begin(),
+        trajectory.end(),
+        World::origin,
+        max_points,
+        closest_approaches);
+    return closest_approaches;
+  }
+
+  // Marks the cache with a spurious closest approach shortly after the point
+  // of |trajectory| with the given |index|, and returns its time.
+  Instant InsertSpuriousClosestApproach(
+      DiscreteTrajectory<Barycentric> const& trajectory,
+      int const index = 0) const {
+    Instant const time =
+        std::next(trajectory.begin(), index)->time + 1 * Milli(Second);
+    TestablePlugin::InsertSpuriousClosestApproach(
+        plugin_with_targets_,
+        vessel_guid_,
+        VesselTrajectory::Prediction,
+        max_points,
+        time,
+        trajectory.front().degrees_of_freedom);
+    return time;
+  }
+
+  GUID const vessel_guid_ = "Vessel";
+  GUID const target_ = "Target Vessel";
+  GUID const other_target_ = "Other Target Vessel";
+  Plugin plugin_with_targets_;
+};
+
+TEST_F(PluginClosestApproachesTest, CacheHit) {
+  ASSERT_THAT(plugin_with_targets_.GetVessel(target_)->prediction()->size(),
+              Gt(1));
+  DiscreteTrajectory<Barycentric> trajectory;
+  AppendPoints(0, number_of_points, trajectory);
+  EXPECT_THAT(ComputeClosestApproaches(trajectory).size(), Eq(10));
+
+  // Nothing changed, so the cached closest approaches are not recomputed.
+  Instant const spurious_time = InsertSpuriousClosestApproach(trajectory);
+  auto const closest_approaches = ComputeClosestApproaches(trajectory);
+  ASSERT_THAT(closest_approaches.size(), Eq(11));
+  EXPECT_THAT(closest_approaches.front().time, Eq(spurious_time));
+}
+
+TEST_F(PluginClosestApproachesTest, ExtendedTrajectory) {
+  DiscreteTrajectory<Barycentric> trajectory;
+  AppendPoints(0, number_of_points / 2 + 1, trajectory);
+  EXPECT_THAT(ComputeClosestApproaches(trajectory).size(), Eq(5));
+
+  // Only the extension of the trajectory is scanned: the cached closest
+  // approaches are kept, and the new ones are found.
+  Instant const spurious_time = InsertSpuriousClosestApproach(trajectory);
+  AppendPoints(number_of_points / 2 + 1, number_of_points, trajectory);
+  auto const closest_approaches = ComputeClosestApproaches(trajectory);
+  ASSERT_THAT(closest_approaches.size(), Eq(11));
+  EXPECT_THAT(closest_approaches.front().time, Eq(spurious_time));
+  Instant const t_min =
+      plugin_with_targets_.GetVessel(target_)->prediction()->front().time;
+  EXPECT_THAT(closest_approaches.back().time - t_min,
+              AbsoluteErrorFrom(9.5 * oscillation_period(),
+                                Lt(1 * Milli(Second))));
+}
+
+TEST_F(PluginClosestApproachesTest, TrimmedAndExtendedTrajectory) {
+  DiscreteTrajectory<Barycentric> trajectory;
+  AppendPoints(0, number_of_points / 2 + 1, trajectory);
+  EXPECT_THAT(ComputeClosestApproaches(trajectory).size(), Eq(5));
+
+  // This is how a prediction changes as time passes: its beginning is
+  // forgotten and it is extended.  Only the extension is scanned, so a spurious
+  // closest approach in the part that is kept survives.
+  Instant const spurious_time =
+      InsertSpuriousClosestApproach(trajectory, /*index=*/60);
+  trajectory.ForgetBefore(std::next(trajectory.begin(), 25)->time);
+  AppendPoints(number_of_points / 2 + 1, number_of_points, trajectory);
+  auto const closest_approaches = ComputeClosestApproaches(trajectory);
+  ASSERT_THAT(closest_approaches.size(), Eq(11));
+  EXPECT_THAT(std::next(closest_approaches.begin())->time, Eq(spurious_time));
+
+  // Apart from the spurious closest approach, same result as without a cache.
+  TestablePlugin::ClearClosestApproachesCache(plugin_with_targets_);
+  auto const uncached_closest_approaches = ComputeClosestApproaches(trajectory);
+  ASSERT_THAT(uncached_closest_approaches.size(), Eq(10));
+  auto it1 = closest_approaches.begin();
+  for (auto it2 = uncached_closest_approaches.begin();
+       it2 != uncached_closest_approaches.end();
+       ++it1, ++it2) {
+    if (it1->time == spurious_time) {
+      ++it1;
+    }
+    EXPECT_THAT(it1->time, Eq(it2->time));
+  }
+}
+
+TEST_F(PluginClosestApproachesTest, TargetChange) {
+  DiscreteTrajectory<Barycentric> trajectory;
+  AppendPoints(0, number_of_points, trajectory);
+  ComputeClosestApproaches(trajectory);
+
+  // The prediction of the new target differs from the start, so the entire
+  // trajectory is scanned again.
+  Instant const spurious_time = InsertSpuriousClosestApproach(trajectory);
+  plugin_with_targets_.SetTargetVessel(other_target_,
+                                       SolarSystemFactory::Earth);
+  auto const closest_approaches = ComputeClosestApproaches(trajectory);
+  ASSERT_FALSE(closest_approaches.empty());
+  EXPECT_THAT(closest_approaches.front().time, Ne(spurious_time));
+
+  // Same result as without a cache.
+  TestablePlugin::ClearClosestApproachesCache(plugin_with_targets_);
+  auto const uncached_closest_approaches = ComputeClosestApproaches(trajectory);
+  ASSERT_THAT(closest_approaches.size(),
+              Eq(uncached_closest_approaches.size()));
+  for (auto it1 = closest_approaches.begin(),
+            it2 = uncached_closest_approaches.begin();
+       it1 != closest_approaches.end();
+       ++it1, ++it2) {
+    EXPECT_THAT(it1->time, Eq(it2->time));
+  }
+}
+
+// The apsides with respect to the Earth of trajectories that oscillate around
+// it.  The predictions of the targets ensure that the trajectory of the Earth
+// covers these trajectories.
+class PluginApsidesTest : public PluginClosestApproachesTest {
+ protected:
+  void AppendPoints(int const first,
+                    int const last,
+                    DiscreteTrajectory<Barycentric>& trajectory) const {
+    AppendPointsAround(
+        plugin_with_targets_.GetCelestial(SolarSystemFactory::Earth)
+            .trajectory(),
+        first,
+        last,
+        trajectory);
+  }
+
+  // Returns the times of the apoapsides and of the periapsides.
+  std::pair<std::vector<Instant>, std::vector<Instant>> ComputeApsides(
+      DiscreteTrajectory<Barycentric> const& trajectory) const {
+    DiscreteTrajectory<World> apoapsides;
+    DiscreteTrajectory<World> periapsides;
+    plugin_with_targets_.ComputeAndRenderApsides(SolarSystemFactory::Earth,
+                                                 vessel_guid_,
+                                                 VesselTrajectory::Prediction,
+                                                 trajectory,
+                                                 trajectory.begin(),
+                                                 trajectory.end(),
+                                                 World::origin,
+                                                 max_points,
+                                                 apoapsides,
+                                                 periapsides);
+    std::pair<std::vector<Instant>, std::vector<Instant>> times;
+    for (auto const& [time, _] : apoapsides) {
+      times.first.push_back(time);
+    }
+    for (auto const& [time, _] : periapsides) {
+      times.second.push_back(time);
+    }
+    return times;
+  }
+};
+
+TEST_F(PluginApsidesTest, TrimmedAndExtendedTrajectory) {
+  DiscreteTrajectory<Barycentric> trajectory;
+  AppendPoints(0, number_of_points / 2 + 1, trajectory);
+  EXPECT_THAT(ComputeApsides(trajectory).second, SizeIs(5));
+
+  // A spurious periapsis in the middle of the part of the trajectory that stays
+  // unchanged.
+  Instant const spurious_time =
+      std::next(trajectory.begin(), 60)->time + 1 * Milli(Second);
+  TestablePlugin::InsertSpuriousPeriapsis(
+      plugin_with_targets_,
+      SolarSystemFactory::Earth,
+      vessel_guid_,
+      VesselTrajectory::Prediction,
+      max_points,
+      spurious_time,
+      trajectory.front().degrees_of_freedom);
+
+  // This is how a prediction changes as time passes: its beginning is
+  // forgotten and it is extended.  Only the extension is scanned, so the
+  // spurious periapsis survives.
+  trajectory.ForgetBefore(std::next(trajectory.begin(), 25)->time);
+  AppendPoints(number_of_points / 2 + 1, number_of_points, trajectory);
+  auto [cached_apoapsides, cached_periapsides] = ComputeApsides(trajectory);
+  auto const spurious_periapsis = std::find(
+      cached_periapsides.begin(), cached_periapsides.end(), spurious_time);
+  ASSERT_TRUE(spurious_periapsis != cached_periapsides.end());
+  cached_periapsides.erase(spurious_periapsis);
+
+  // Apart from the spurious periapsis, same result as without a cache.
+  TestablePlugin::ClearApsidesCache(plugin_with_targets_);
+  auto const [uncached_apoapsides, uncached_periapsides] =
+      ComputeApsides(trajectory);
+  EXPECT_THAT(uncached_periapsides, SizeIs(10));
+  EXPECT_THAT(cached_apoapsides, Eq(uncached_apoapsides));
+  EXPECT_THAT(cached_periapsides, Eq(uncached_periapsides));
+}
+
+class PluginFirstCollisionTest : public PluginApsidesTest {
+ protected:
+  // Returns the time of the first collision with a spherical Earth of the
+  // given |radius|.
+  std::optional<Instant> ComputeFirstCollision(
+      DiscreteTrajectory<Barycentric> const& trajectory,
+      int const terrain_level_of_detail,
+      Length const& radius) const {
+    auto const collision = plugin_with_targets_.ComputeAndRenderFirstCollision(
+        SolarSystemFactory::Earth,
+        vessel_guid_,
+        VesselTrajectory::Prediction,
+        trajectory,
+        trajectory.begin(),
+        trajectory.end(),
+        World::origin,
+        max_points,
+        terrain_level_of_detail,
+        [radius](Angle const& latitude, Angle const& longitude) {
+          return radius;
+        });
+    if (collision.has_value()) {
+      return collision->time;
+    } else {
+      return std::nullopt;
+    }
+  }
+};
+
+TEST_F(PluginFirstCollisionTest, TerrainLevelOfDetail) {
+  DiscreteTrajectory<Barycentric> trajectory;
+  AppendPoints(0, number_of_points, trajectory);
+  Instant const& t_min = trajectory.front().time;
+
+  // The distance to the centre of the Earth goes from 15 km to 5 km during the
+  // first half of an oscillation.
+  auto const collision =
+      ComputeFirstCollision(trajectory,
+                            /*terrain_level_of_detail=*/0,
+                            /*radius=*/10 * Kilo(Metre));
+  ASSERT_TRUE(collision.has_value());
+  EXPECT_THAT(*collision - t_min,
+              AbsoluteErrorFrom(oscillation_period() / 4,
+                                Lt(oscillation_period() / 100)));
+
+  // For the same level of detail, the terrain is assumed to be unchanged, and
+  // the cached collision is returned.
+  auto const cached_collision =
+      ComputeFirstCollision(trajectory,
+                            /*terrain_level_of_detail=*/0,
+                            /*radius=*/2 * Kilo(Metre));
+  ASSERT_TRUE(cached_collision.has_value());
+  EXPECT_THAT(*cached_collision, Eq(*collision));
+
+  // For a different level of detail, the terrain is looked at again.
+  EXPECT_FALSE(ComputeFirstCollision(trajectory,
+                                     /*terrain_level_of_detail=*/1,
+                                     /*radius=*/2 * Kilo(Metre))
+                   .has_value());
+}
+
 }  // namespace ksp_plugin
 }  // namespace principia
@@ -94,6 +94,7 @@ TEST_F(RendererTest, TargetVessel) {
   renderer_.SetTargetVessel(&vessel, &celestial_, &ephemeris);
   EXPECT_TRUE(renderer_.HasTargetVessel());
   EXPECT_THAT(renderer_.GetTargetVessel(), Ref(vessel));
+  EXPECT_EQ(nullptr, renderer_.GetPlottingFrameMotions());
   MockVessel other_vessel;
   renderer_.ClearTargetVesselIf(&other_vessel);
   EXPECT_THAT(renderer_.GetTargetVessel(), Ref(vessel));
@@ -147,6 +148,54 @@ TEST_F(RendererTest, RenderBarycentricTrajectoryInPlottingWithoutTargetVessel) {
   }
 }
 
+TEST_F(RendererTest, PlottingFrameMotions) {
+  DiscreteTrajectory<Barycentric> trajectory_to_render;
+  AppendTrajectoryTimeline(
+      NewLinearTrajectoryTimeline(
+          /*v=*/Velocity<Barycentric>(
+              {6 * Metre / Second, 5 * Metre / Second, 4 * Metre / Second}),
+          /*Δt=*/1 * Second,
+          /*t1=*/t0_,
+          /*t2=*/t0_ + 10 * Second),
+      /*to=*/trajectory_to_render);
+
+  RigidMotion<Barycentric, Navigation> rigid_motion(
+      RigidTransformation<Barycentric, Navigation>::Identity(),
+      Barycentric::nonrotating,
+      Barycentric::unmoving);
+  // The motions are computed only once even though the trajectory is rendered
+  // twice.
+  for (Instant t = t0_; t < t0_ + 10 * Second; t += 1 * Second) {
+    EXPECT_CALL(*reference_frame_, ToThisFrameAtTime(t))
+        .WillOnce(Return(rigid_motion));
+  }
+
+  auto const* const plotting_frame_motions =
+      renderer_.GetPlottingFrameMotions();
+  ASSERT_NE(nullptr, plotting_frame_motions);
+  EXPECT_EQ(renderer_.GetPlottingFrame(),
+            plotting_frame_motions->plotting_frame());
+  for (int i = 0; i < 2; ++i) {
+    auto const rendered_trajectory =
+        renderer_.RenderBarycentricTrajectoryInPlotting(
+            trajectory_to_render.begin(),
+            trajectory_to_render.end());
+    EXPECT_EQ(10, rendered_trajectory.size());
+  }
+
+  // Changing the plotting frame invalidates the cache.
+  auto new_plotting_frame =
+      std::make_unique<MockRigidReferenceFrame<Barycentric, Navigation>>();
+  auto const* const new_reference_frame = new_plotting_frame.get();
+  renderer_.SetPlottingFrame(std::move(new_plotting_frame));
+  EXPECT_EQ(renderer_.GetPlottingFrame(),
+            renderer_.GetPlottingFrameMotions()->plotting_frame());
+  EXPECT_CALL(*new_reference_frame, ToThisFrameAtTime(t0_))
+      .WillOnce(Return(rigid_motion));
+  renderer_.BarycentricToPlotting(t0_);
+  renderer_.BarycentricToPlotting(t0_);
+}
+
 TEST_F(RendererTest, RenderBarycentricTrajectoryInPlottingWithTargetVessel) {
   MockEphemeris<Barycentric> ephemeris;
   MockContinuousTrajectory<Barycentric> celestial_trajectory;
@@ -1,9 +1,11 @@
 #include "ksp_plugin/vessel.hpp"
 
+#include <filesystem>
 #include <limits>
 #include <list>
 #include <memory>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -30,29 +32,37 @@
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/massive_body.hpp"
+#include "physics/mock_continuous_trajectory.hpp"  // 🧙 For MockContinuousTrajectory.  // NOLINT
 #include "physics/mock_ephemeris.hpp"  // 🧙 For MockEphemeris.
 #include "physics/rigid_motion.hpp"
 #include "physics/rotating_body.hpp"
 #include "physics/tensors.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
+#include "quantities/numbers.hpp"  // 🧙 For π.
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
 #include "testing_utilities/almost_equals.hpp"
 #include "testing_utilities/componentwise.hpp"
 #include "testing_utilities/discrete_trajectory_factories.hpp"
 #include "testing_utilities/matchers.hpp"
+#include "testing_utilities/numerics_matchers.hpp"
 
 namespace principia {
 namespace ksp_plugin {
 
 using ::testing::AllOf;
+using ::testing::An;
 using ::testing::AnyNumber;
+using ::testing::AtLeast;
 using ::testing::DoAll;
 using ::testing::ElementsAre;
 using ::testing::Ge;
 using ::testing::Le;
+using ::testing::Lt;
+using ::testing::NotNull;
 using ::testing::MockFunction;
+using ::testing::Property;
 using ::testing::Return;
 using ::testing::ReturnRef;
 using ::testing::_;
@@ -73,6 +83,7 @@ using namespace principia::ksp_plugin::_pile_up;
 using namespace principia::ksp_plugin::_plugin;
 using namespace principia::ksp_plugin::_vessel;
 using namespace principia::ksp_plugin_test::_plugin_io;
+using namespace principia::physics::_continuous_trajectory;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_discrete_trajectory;
 using namespace principia::physics::_ephemeris;
@@ -88,6 +99,7 @@ using namespace principia::testing_utilities::_almost_equals;
 using namespace principia::testing_utilities::_componentwise;
 using namespace principia::testing_utilities::_discrete_trajectory_factories;
 using namespace principia::testing_utilities::_matchers;
+using namespace principia::testing_utilities::_numerics_matchers;
 
 class VesselTest : public testing::Test {
  protected:
@@ -197,10 +209,10 @@ TEST_F(VesselTest, PrepareHistory) {
   EXPECT_CALL(ephemeris_, t_max())
       .WillRepeatedly(Return(t0_ + 2 * Second));
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
       .Times(AnyNumber());
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _, _))
       .Times(AnyNumber());
   vessel_.CreateTrajectoryIfNeeded(t0_ + 1 * Second);
 
@@ -220,10 +232,10 @@ TEST_F(VesselTest, AdvanceTime) {
   EXPECT_CALL(ephemeris_, t_max())
       .WillRepeatedly(Return(t0_ + 2 * Second));
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
       .Times(AnyNumber());
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _, _))
       .Times(AnyNumber());
   vessel_.CreateTrajectoryIfNeeded(t0_);
 
@@ -286,7 +298,7 @@ TEST_F(VesselTest, Prediction) {
       /*t1=*/t0_,
       /*t2=*/t0_ + 2 * Second);
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _, _))
       .WillOnce(DoAll(
           AppendPointsToDiscreteTrajectory(&expected_vessel_prediction),
           Return(absl::OkStatus())))
@@ -296,7 +308,7 @@ TEST_F(VesselTest, Prediction) {
   // these points.
   EXPECT_CALL(
       ephemeris_,
-      FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+      FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
       .WillRepeatedly(Return(absl::OkStatus()));
 
   vessel_.CreateTrajectoryIfNeeded(t0_);
@@ -322,6 +334,281 @@ TEST_F(VesselTest, Prediction) {
   }
 }
 
+TEST_F(VesselTest, PredictionReuse) {
+  using AdaptiveStepParameters = Ephemeris<Barycentric>::AdaptiveStepParameters;
+  EXPECT_CALL(ephemeris_, t_min_locked())
+      .WillRepeatedly(Return(t0_));
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(t0_ + 2 * Second));
+
+  auto const vessel_degrees_of_freedom =
+      Barycentre<DegreesOfFreedom<Barycentric>, Mass>({p1_dof_, p2_dof_},
+                                                      {mass1_, mass2_});
+  auto const expected_vessel_prediction1 = NewLinearTrajectoryTimeline(
+      vessel_degrees_of_freedom,
+      /*Δt=*/0.5 * Second,
+      /*t1=*/t0_,
+      /*t2=*/t0_ + 2.5 * Second);
+  auto const expected_vessel_prediction2 = NewLinearTrajectoryTimeline(
+      vessel_degrees_of_freedom,
+      /*Δt=*/0.5 * Second,
+      /*t0=*/t0_,
+      /*t1=*/t0_ + 2.5 * Second,
+      /*t2=*/t0_ + 3.5 * Second);
+
+  // The first prognostication is computed from the psychohistory.
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _, _, t0_ + 2 * Second,
+                  Property(&AdaptiveStepParameters::max_steps, 1000), _, _))
+      .WillRepeatedly(DoAll(
+          AppendPointsToDiscreteTrajectory(&expected_vessel_prediction1),
+          Return(absl::OkStatus())));
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _, _, InfiniteFuture,
+                  Property(&AdaptiveStepParameters::max_steps, 1000), _, _))
+      .WillRepeatedly(Return(absl::OkStatus()));
+
+  // The next ones only extend the prediction, with the steps that it is not
+  // using.
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _, _, t0_ + 2 * Second,
+                  Property(&AdaptiveStepParameters::max_steps, 996), _, _))
+      .WillRepeatedly(Return(absl::OkStatus()));
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _, _, InfiniteFuture,
+                  Property(&AdaptiveStepParameters::max_steps, 996), _, _))
+      .WillRepeatedly(DoAll(
+          AppendPointsToDiscreteTrajectory(&expected_vessel_prediction2),
+          Return(absl::OkStatus())));
+
+  vessel_.CreateTrajectoryIfNeeded(t0_);
+  // Polling for the integrations to happen.
+  do {
+    vessel_.RefreshPrediction();
+    using namespace std::chrono_literals;
+    std::this_thread::sleep_for(100ms);
+  } while (vessel_.prediction()->back().time < t0_ + 2 * Second);
+  do {
+    vessel_.RefreshPrediction();
+    using namespace std::chrono_literals;
+    std::this_thread::sleep_for(100ms);
+  } while (vessel_.prediction()->back().time < t0_ + 3 * Second);
+
+  EXPECT_EQ(7, vessel_.prediction()->size());
+  auto it = expected_vessel_prediction1.begin();
+  for (auto const& [time, degrees_of_freedom] : *vessel_.prediction()) {
+    EXPECT_EQ(time, it->time);
+    EXPECT_THAT(
+        degrees_of_freedom,
+        Componentwise(AlmostEquals(it->degrees_of_freedom.position(), 0, 0),
+                      AlmostEquals(it->degrees_of_freedom.velocity(), 0, 8)));
+    if (it->time == t0_ + 2 * Second) {
+      it = expected_vessel_prediction2.begin();
+    } else {
+      ++it;
+    }
+  }
+}
+
+TEST_F(VesselTest, PredictionOutOfFocus) {
+  using AdaptiveStepParameters = Ephemeris<Barycentric>::AdaptiveStepParameters;
+  EXPECT_CALL(ephemeris_, t_min_locked())
+      .WillRepeatedly(Return(t0_));
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(t0_ + 2 * Second));
+
+  auto const expected_vessel_prediction = NewLinearTrajectoryTimeline(
+      Barycentre<DegreesOfFreedom<Barycentric>, Mass>({p1_dof_, p2_dof_},
+                                                      {mass1_, mass2_}),
+      /*Δt=*/0.5 * Second,
+      /*t1=*/t0_,
+      /*t2=*/t0_ + 2.5 * Second);
+
+  // The number of steps is capped when the prediction is out of focus.
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _, _, t0_ + 2 * Second,
+                  Property(&AdaptiveStepParameters::max_steps, 1 << 12), _, _))
+      .WillRepeatedly(DoAll(
+          AppendPointsToDiscreteTrajectory(&expected_vessel_prediction),
+          Return(absl::OkStatus())));
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _, _, InfiniteFuture,
+                  Property(&AdaptiveStepParameters::max_steps, 1 << 12), _, _))
+      .WillRepeatedly(Return(absl::OkStatus()));
+
+  auto prediction_adaptive_step_parameters = DefaultPredictionParameters();
+  prediction_adaptive_step_parameters.set_max_steps(1 << 20);
+  vessel_.set_prediction_adaptive_step_parameters(
+      prediction_adaptive_step_parameters);
+  EXPECT_TRUE(vessel_.prediction_in_focus());
+  vessel_.set_prediction_in_focus(false);
+  EXPECT_FALSE(vessel_.prediction_in_focus());
+
+  vessel_.CreateTrajectoryIfNeeded(t0_);
+  // Polling for the integration to happen.
+  do {
+    vessel_.RefreshPrediction();
+    using namespace std::chrono_literals;
+    std::this_thread::sleep_for(100ms);
+  } while (vessel_.prediction()->back().time < t0_ + 2 * Second);
+
+  EXPECT_EQ(5, vessel_.prediction()->size());
+}
+
+// A vessel in a circular orbit around a body at rest at the origin, for testing
+// the Keplerian start of the predictions.  The points of the Keplerian orbit
+// are 1/64 of a period, or about 91 s, apart.
+class VesselKeplerianPredictionTest : public VesselTest {
+ protected:
+  using AdaptiveStepParameters = Ephemeris<Barycentric>::AdaptiveStepParameters;
+
+  VesselKeplerianPredictionTest()
+      : primary_(MassiveBody::Parameters(μ_),
+                 RotatingBody<Barycentric>::Parameters(
+                     /*mean_radius=*/1000 * Kilo(Metre),
+                     /*reference_angle=*/0 * Degree,
+                     /*reference_instant=*/t0_,
+                     /*angular_frequency=*/1 * Radian / Second,
+                     /*right_ascension_of_pole=*/0 * Degree,
+                     /*declination_of_pole=*/90 * Degree)),
+        primary_celestial_(&primary_),
+        orbiting_vessel_("456",
+                         "orbiting vessel",
+                         &primary_celestial_,
+                         &ephemeris_,
+                         DefaultPredictionParameters(),
+                         DefaultDownsamplingParameters()) {
+    orbiting_vessel_.AddPart(make_not_null_unique<Part>(
+        part_id1_,
+        "p1",
+        mass1_,
+        EccentricPart::origin,
+        inertia_tensor1_,
+        RigidMotion<EccentricPart, Barycentric>::MakeNonRotatingMotion(
+            DegreesOfFreedom<Barycentric>(
+                Barycentric::origin +
+                    Displacement<Barycentric>({r_, 0 * Metre, 0 * Metre}),
+                Velocity<Barycentric>({0 * Metre / Second,
+                                       Sqrt(μ_ / r_),
+                                       0 * Metre / Second}))),
+        /*deletion_callback=*/nullptr));
+
+    EXPECT_CALL(ephemeris_, t_min_locked())
+        .WillRepeatedly(Return(t0_));
+    EXPECT_CALL(ephemeris_, t_max())
+        .WillRepeatedly(Return(t0_ + 1 * Day));
+    EXPECT_CALL(ephemeris_, trajectory(_))
+        .WillRepeatedly(Return(&primary_trajectory_));
+    EXPECT_CALL(primary_trajectory_, EvaluateDegreesOfFreedom(_))
+        .WillRepeatedly(Return(DegreesOfFreedom<Barycentric>(
+            Barycentric::origin, Barycentric::unmoving)));
+    EXPECT_CALL(ephemeris_,
+                ComputeGravitationalAccelerationOnMassiveBody(_, _))
+        .WillRepeatedly(Return(Vector<Acceleration, Barycentric>()));
+    // The continuations of the prediction.  Irrelevant since they don't add
+    // points.
+    EXPECT_CALL(ephemeris_, FlowWithAdaptiveStep(_, _, _, _, _, _))
+        .WillRepeatedly(Return(absl::OkStatus()));
+  }
+
+  // Sets up the ephemeris so that the vessel is subject to the gravity of the
+  // primary and to the given constant |perturbation|.
+  void SetPerturbation(
+      Vector<Acceleration, Barycentric> const& perturbation) {
+    EXPECT_CALL(ephemeris_,
+                ComputeGravitationalAccelerationOnMasslessBody(
+                    An<Position<Barycentric> const&>(), _))
+        .WillRepeatedly([this, perturbation](Position<Barycentric> const& q,
+                                             Instant const& t) {
+          Displacement<Barycentric> const r = q - Barycentric::origin;
+          return -μ_ * r / Pow<3>(r.Norm()) + perturbation;
+        });
+  }
+
+  void ComputePrediction() {
+    orbiting_vessel_.set_prediction_kepler_tolerance(1 * Degree);
+    orbiting_vessel_.CreateTrajectoryIfNeeded(t0_);
+    // Polling for the integration to happen.
+    do {
+      orbiting_vessel_.RefreshPrediction();
+      using namespace std::chrono_literals;
+      std::this_thread::sleep_for(100ms);
+    } while (orbiting_vessel_.prediction()->back().time == t0_);
+  }
+
+  GravitationalParameter const μ_ =
+      398600.4418 * Pow<3>(Kilo(Metre)) / Pow<2>(Second);
+  Length const r_ = 7000 * Kilo(Metre);
+  RotatingBody<Barycentric> const primary_;
+  Celestial const primary_celestial_;
+  MockContinuousTrajectory<Barycentric> primary_trajectory_;
+  Vessel orbiting_vessel_;
+};
+
+TEST_F(VesselKeplerianPredictionTest, Unperturbed) {
+  // The orbit is followed up to the end of the ephemeris, after 948 points,
+  // and the integration gets the remaining steps.
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _, _, t0_ + 1 * Day,
+                  Property(&AdaptiveStepParameters::max_steps, 1000 - 948),
+                  _, _))
+      .Times(AtLeast(1))
+      .WillRepeatedly(Return(absl::OkStatus()));
+  SetPerturbation(Vector<Acceleration, Barycentric>());
+  ComputePrediction();
+
+  EXPECT_EQ(949, orbiting_vessel_.prediction()->size());
+  EXPECT_LT(t0_ + 1 * Day - 91 * Second,
+            orbiting_vessel_.prediction()->back().time);
+  for (auto const& [time, degrees_of_freedom] :
+       *orbiting_vessel_.prediction()) {
+    EXPECT_THAT((degrees_of_freedom.position() - Barycentric::origin).Norm(),
+                RelativeErrorFrom(r_, Lt(1e-12)));
+  }
+}
+
+TEST_F(VesselKeplerianPredictionTest, Perturbed) {
+  // The displacement caused by the perturbation, ½ δa Δt², exceeds 1° as seen
+  // from the primary after about 15 630 s, i.e., after 171 points.  The rest of
+  // the prediction is integrated.
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(
+                  _, _, t0_ + 1 * Day,
+                  Property(&AdaptiveStepParameters::max_steps, 1000 - 171),
+                  _, _))
+      .WillRepeatedly(
+          [](not_null<DiscreteTrajectory<Barycentric>*> const trajectory,
+             auto&&...) {
+            auto const [last_time, last_degrees_of_freedom] =
+                trajectory->back();
+            for (int i = 1; i <= 3; ++i) {
+              EXPECT_OK(trajectory->Append(last_time + i * Second,
+                                           last_degrees_of_freedom));
+            }
+            return absl::OkStatus();
+          });
+  SetPerturbation(Vector<Acceleration, Barycentric>(
+      {0 * Metre / Pow<2>(Second),
+       0 * Metre / Pow<2>(Second),
+       1e-3 * Metre / Pow<2>(Second)}));
+  ComputePrediction();
+
+  EXPECT_EQ(1 + 171 + 3, orbiting_vessel_.prediction()->size());
+  auto const last_keplerian = std::next(orbiting_vessel_.prediction()->begin(),
+                                        171);
+  EXPECT_LT(t0_ + 15'000 * Second, last_keplerian->time);
+  EXPECT_GT(t0_ + 15'630 * Second, last_keplerian->time);
+  EXPECT_EQ(last_keplerian->time + 3 * Second,
+            orbiting_vessel_.prediction()->back().time);
+}
+
 TEST_F(VesselTest, PredictBeyondTheInfinite) {
   EXPECT_CALL(ephemeris_, t_min_locked())
       .WillRepeatedly(Return(t0_));
@@ -336,7 +623,7 @@ TEST_F(VesselTest, PredictBeyondTheInfinite) {
       /*t1=*/t0_,
       /*t2=*/t0_ + 5.5 * Second);
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 5 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 5 * Second, _, _, _))
       .WillOnce(DoAll(
           AppendPointsToDiscreteTrajectory(&expected_vessel_prediction1),
           Return(absl::OkStatus())))
@@ -350,7 +637,7 @@ TEST_F(VesselTest, PredictBeyondTheInfinite) {
       /*t1=*/t0_ + 5.5 * Second,
       /*t2=*/t0_ + FlightPlan::max_ephemeris_steps_per_frame * Second);
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
       .WillOnce(DoAll(
           AppendPointsToDiscreteTrajectory(&expected_vessel_prediction2),
           Return(absl::OkStatus())))
@@ -387,13 +674,13 @@ TEST_F(VesselTest, FlightPlan) {
   EXPECT_CALL(ephemeris_, t_max())
       .WillRepeatedly(Return(t0_ + 4 * Second));
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
       .Times(AnyNumber());
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _, _))
       .Times(AnyNumber());
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 3 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 3 * Second, _, _, _))
       .Times(AnyNumber());
   EXPECT_CALL(ephemeris_,
               Prolong(_, _))
@@ -509,10 +796,10 @@ TEST_F(VesselTest, Checkpointing) {
   EXPECT_CALL(ephemeris_, t_max())
       .WillRepeatedly(Return(t0_ + 30 * Second));
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
       .Times(AnyNumber());
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 30 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 30 * Second, _, _, _))
       .Times(AnyNumber());
 
   // Disable downsampling to make sure that we do not try to append to existing
@@ -666,6 +953,103 @@ TEST_F(VesselTest, Checkpointing) {
         25, segment_by_left_endpoint1.left_endpoint().scalar().magnitude());
     EXPECT_EQ(4, segment_by_left_endpoint1.segment());
   }
+
+  // The segments prior to the backstory are only deserialized when the
+  // trajectory is accessed.
+  EXPECT_CALL(ephemeris_, Prolong(_, _)).Times(AnyNumber());
+  auto const v = Vessel::ReadFromMessage(
+      message, &celestial_, &ephemeris_, /*deletion_callback=*/nullptr);
+  EXPECT_EQ(vessel_.psychohistory()->front().time,
+            v->psychohistory()->front().time);
+  // The history may be materialized by several threads at the same time.
+  std::thread materializer([&v]() { v->trajectory(); });
+  EXPECT_EQ(vessel_.trajectory().front().time, v->trajectory().front().time);
+  materializer.join();
+  EXPECT_EQ(std::distance(vessel_.trajectory().begin(),
+                          vessel_.psychohistory()->begin()),
+            std::distance(v->trajectory().begin(),
+                          v->psychohistory()->begin()));
+  EXPECT_EQ(std::next(v->psychohistory()), v->prediction());
+}
+
+TEST_F(VesselTest, HistoryArchive) {
+  EXPECT_CALL(ephemeris_, t_max())
+      .WillRepeatedly(Return(t0_ + 30 * Second));
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
+      .Times(AnyNumber());
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(_, _, t0_ + 30 * Second, _, _, _))
+      .Times(AnyNumber());
+
+  std::filesystem::path const path = TEMP_DIR / "vessel_test_history.bin";
+  std::filesystem::remove(path);
+  vessel_.DisableDownsampling();
+  vessel_.EnableHistoryArchive(path, /*age=*/5 * Second);
+  vessel_.CreateTrajectoryIfNeeded(t0_);
+  ASSERT_THAT(vessel_.history_archive(), NotNull());
+
+  auto const pile_up =
+      std::make_shared<PileUp>(/*parts=*/std::list<not_null<Part*>>{p1_, p2_},
+                                Instant{},
+                                DefaultPsychohistoryParameters(),
+                                DefaultHistoryParameters(),
+                                &ephemeris_,
+                                /*deletion_callback=*/nullptr);
+  p1_->set_containing_pile_up(pile_up);
+  p2_->set_containing_pile_up(pile_up);
+
+  // Appends a free fall over ]t1, t2] to the histories of the parts.
+  auto const free_fall = [this](Instant const& t1, Instant const& t2) {
+    for (auto const& [part, dof] : {std::pair{p1_, p1_dof_},
+                                    std::pair{p2_, p2_dof_}}) {
+      AppendTrajectoryTimeline<Barycentric>(
+          NewLinearTrajectoryTimeline<Barycentric>(dof,
+                                                   /*Δt=*/1 * Second,
+                                                   /*t0=*/t0_,
+                                                   /*t1=*/t1,
+                                                   /*t2=*/t2),
+          [part](Instant const& time,
+                 DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+            part->AppendToHistory(time, degrees_of_freedom);
+          });
+    }
+  };
+
+  // The history covers [t0, t0 + 10 s], the points before t0 + 5 s are
+  // archived.
+  free_fall(t0_ + 1 * Second, t0_ + 11 * Second);
+  vessel_.DetectCollapsibilityChange();
+  vessel_.AdvanceTime();
+  auto const& archive = *vessel_.history_archive();
+  EXPECT_EQ(1, archive.number_of_chunks());
+  EXPECT_EQ(t0_ + 5 * Second, vessel_.trajectory().front().time);
+
+  // Less than 5 s more would not be archived.
+  free_fall(t0_ + 11 * Second, t0_ + 14 * Second);
+  vessel_.AdvanceTime();
+  EXPECT_EQ(1, archive.number_of_chunks());
+  EXPECT_EQ(t0_ + 5 * Second, vessel_.trajectory().front().time);
+
+  // The history covers [t0 + 5 s, t0 + 20 s], the points before t0 + 15 s are
+  // archived.
+  free_fall(t0_ + 14 * Second, t0_ + 21 * Second);
+  vessel_.AdvanceTime();
+  EXPECT_EQ(2, archive.number_of_chunks());
+  EXPECT_EQ(t0_, archive.t_min());
+  EXPECT_EQ(t0_ + 15 * Second, archive.t_max());
+  EXPECT_EQ(t0_ + 15 * Second, vessel_.trajectory().front().time);
+
+  // The archive has the motion of the barycentre of the parts.
+  auto const barycentre = Barycentre<DegreesOfFreedom<Barycentric>, Mass>(
+      {p1_dof_, p2_dof_}, {mass1_, mass2_});
+  for (Instant t = t0_; t <= t0_ + 15 * Second; t += 0.7 * Second) {
+    Position<Barycentric> const expected_position =
+        barycentre.position() + barycentre.velocity() * (t - t0_);
+    EXPECT_THAT((archive.EvaluatePosition(t) - expected_position).Norm(),
+                Lt(1 * Milli(Metre))) << t;
+  }
+  std::filesystem::remove(path);
 }
 
 // Exact same setup as the previous test, but with downsampling enabled.  We
@@ -680,10 +1064,10 @@ TEST_F(VesselTest, SingleSegment) {
   EXPECT_CALL(ephemeris_, t_max())
       .WillRepeatedly(Return(t0_ + 30 * Second));
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
       .Times(AnyNumber());
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 30 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 30 * Second, _, _, _))
       .Times(AnyNumber());
 
   vessel_.CreateTrajectoryIfNeeded(t0_);
@@ -800,6 +1184,97 @@ TEST_F(VesselTest, SingleSegment) {
   }
 }
 
+// Checks that the default parameters amortize the downsampling of the history:
+// when the dense span first exceeds |max_dense_intervals| it is not downsampled
+// in one go.
+TEST_F(VesselTest, AmortizedDownsampling) {
+  MockFunction<int(not_null<PileUp const*>)>
+      serialization_index_for_pile_up;
+  EXPECT_CALL(serialization_index_for_pile_up, Call(_))
+      .WillRepeatedly(Return(0));
+
+  Instant const t_max = t0_ + 10'101 * Second;
+  EXPECT_CALL(ephemeris_, t_max()).WillRepeatedly(Return(t_max));
+  EXPECT_CALL(ephemeris_,
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
+      .Times(AnyNumber());
+  EXPECT_CALL(ephemeris_, FlowWithAdaptiveStep(_, _, t_max, _, _, _))
+      .Times(AnyNumber());
+
+  auto const downsampling_parameters = DefaultDownsamplingParameters();
+  ASSERT_TRUE(downsampling_parameters.max_fits_per_append.has_value());
+  vessel_.CreateTrajectoryIfNeeded(t0_);
+
+  auto const pile_up =
+      std::make_shared<PileUp>(/*parts=*/std::list<not_null<Part*>>{p1_, p2_},
+                                Instant{},
+                                DefaultPsychohistoryParameters(),
+                                DefaultHistoryParameters(),
+                                &ephemeris_,
+                                /*deletion_callback=*/nullptr);
+  p1_->set_containing_pile_up(pile_up);
+  p2_->set_containing_pile_up(pile_up);
+
+  // A circular motion short enough that many Hermite cubics are needed to
+  // downsample it.
+  AngularFrequency const ω = 2 * π * Radian / (100 * Second);
+  Length const r = 10 * Kilo(Metre);
+  for (auto* const part : {p1_, p2_}) {
+    AppendTrajectoryTimeline<Barycentric>(
+        NewCircularTrajectoryTimeline<Barycentric>(ω,
+                                                   r,
+                                                   /*Δt=*/1 * Second,
+                                                   /*t1=*/t0_ + 1 * Second,
+                                                   /*t2=*/t_max),
+        [part](Instant const& time,
+               DegreesOfFreedom<Barycentric> const& degrees_of_freedom) {
+          part->AppendToHistory(time, degrees_of_freedom);
+        });
+  }
+
+  vessel_.DetectCollapsibilityChange();
+  vessel_.AdvanceTime();
+
+  serialization::Vessel message;
+  vessel_.WriteToMessage(&message,
+                         serialization_index_for_pile_up.AsStdFunction());
+  EXPECT_EQ(*downsampling_parameters.max_fits_per_append,
+            message.downsampling_parameters().max_fits_per_append());
+  {
+    // The history was downsampled, but only partially: most of the points
+    // appended after the threshold was reached are still dense.
+    auto const& segment0 = message.history().segment(0);
+    EXPECT_THAT(segment0.number_of_dense_points(), Ge(1'000));
+    EXPECT_THAT(segment0.number_of_dense_points(),
+                Lt(downsampling_parameters.max_dense_intervals));
+    EXPECT_THAT(segment0.zfp().timeline_size(), Lt(10'101));
+  }
+
+  // The downsampled history stays within the tolerance of the circle.
+  auto const& trajectory = vessel_.trajectory();
+  for (Instant t = t0_ + 2 * Second; t < t_max - 1 * Second; t += 7 * Second) {
+    Position<Barycentric> const expected_position =
+        Barycentric::origin +
+        Displacement<Barycentric>({r * Cos(ω * (t - Instant{})),
+                                   r * Sin(ω * (t - Instant{})),
+                                   0 * Metre});
+    EXPECT_THAT((trajectory.EvaluatePosition(t) - expected_position).Norm(),
+                Le(downsampling_parameters.tolerance)) << t;
+  }
+
+  // The parameters survive a round trip through serialization.
+  auto const v = Vessel::ReadFromMessage(
+      message,
+      &celestial_,
+      &ephemeris_,
+      /*deletion_callback=*/nullptr);
+  serialization::Vessel second_message;
+  v->WriteToMessage(&second_message,
+                    serialization_index_for_pile_up.AsStdFunction());
+  EXPECT_EQ(*downsampling_parameters.max_fits_per_append,
+            second_message.downsampling_parameters().max_fits_per_append());
+}
+
 TEST_F(VesselTest, SerializationSuccess) {
   MockFunction<int(not_null<PileUp const*>)>
       serialization_index_for_pile_up;
@@ -808,15 +1283,15 @@ TEST_F(VesselTest, SerializationSuccess) {
   EXPECT_CALL(ephemeris_, t_max())
       .WillRepeatedly(Return(t0_ + 4 * Second));
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
       .Times(AnyNumber());
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 2 * Second, _, _, _))
       .Times(AnyNumber());
   vessel_.CreateTrajectoryIfNeeded(t0_);
 
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 3 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 3 * Second, _, _, _))
       .WillRepeatedly(Return(absl::OkStatus()));
   EXPECT_CALL(ephemeris_,
               Prolong(_, _))
@@ -863,10 +1338,10 @@ TEST_F(VesselTest, TailSerialization) {
   EXPECT_CALL(ephemeris_, t_max())
       .WillRepeatedly(Return(t0_ + 30 * Second));
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _))
+              FlowWithAdaptiveStep(_, _, InfiniteFuture, _, _, _))
       .Times(AnyNumber());
   EXPECT_CALL(ephemeris_,
-              FlowWithAdaptiveStep(_, _, t0_ + 30 * Second, _, _))
+              FlowWithAdaptiveStep(_, _, t0_ + 30 * Second, _, _, _))
       .Times(AnyNumber());
   vessel_.CreateTrajectoryIfNeeded(t0_);
 
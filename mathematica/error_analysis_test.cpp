@@ -3,6 +3,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/strings/str_split.h"
 #include "base/map_util.hpp"
 #include "base/not_null.hpp"
 #include "glog/logging.h"
@@ -10,6 +11,7 @@
 #include "integrators/integrators.hpp"
 #include "ksp_plugin/frames.hpp"
 #include "mathematica/integrator_plots.hpp"
+#include "mathematica/integrator_selection.hpp"
 #include "mathematica/local_error_analysis.hpp"
 #include "mathematica/retrobop_dynamical_stability.hpp"
 #include "physics/ephemeris.hpp"
@@ -25,6 +27,7 @@ using namespace principia::base::_not_null;
 using namespace principia::integrators::_integrators;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::mathematica::_integrator_plots;
+using namespace principia::mathematica::_integrator_selection;
 using namespace principia::mathematica::_local_error_analysis;
 using namespace principia::mathematica::_retrobop_dynamical_stability;
 using namespace principia::physics::_ephemeris;
@@ -34,6 +37,27 @@ using namespace principia::quantities::_quantities;
 
 class ErrorAnalysisTest : public ::testing::Test {
  protected:
+  // Parses the command-line flags following the test filter.
+  static std::map<std::string, std::optional<std::string>> ParseFlags() {
+    ::std::vector<std::string> argv = ::testing::internal::GetArgvs();
+    std::map<std::string, std::optional<std::string>> flags;
+    for (int i = 2; i < argv.size(); ++i) {
+      std::string const flag(argv[i]);
+      std::size_t const name_begin = flag.find_first_not_of("-/");
+      std::size_t const name_end = flag.find('=');
+      if (name_begin == std::string::npos) {
+        LOG(FATAL) << "Invalid flag syntax '" << flag << "', expected\n"
+                   << "(--|/)<flag_name>[=value]";
+      }
+      std::string const flag_name =
+          flag.substr(name_begin, name_end - name_begin);
+      if (name_end != std::string::npos) {
+        flags.emplace(flag_name, flag.substr(name_end + 1, std::string::npos));
+      }
+      flags.emplace(flag_name, std::nullopt);
+    }
+    return flags;
+  }
 };
 
 #if !defined(_DEBUG)
@@ -70,23 +94,7 @@ TEST_F(ErrorAnalysisTest,
 
 TEST_F(ErrorAnalysisTest, DISABLED_SECULAR_LocalErrorAnalysis) {
   google::LogToStderr();
-  ::std::vector<std::string> argv = ::testing::internal::GetArgvs();
-  std::map<std::string, std::optional<std::string>> flags;
-  for (int i = 2; i < argv.size(); ++i) {
-    std::string const flag(argv[i]);
-    std::size_t const name_begin = flag.find_first_not_of("-/");
-    std::size_t const name_end = flag.find('=');
-    if (name_begin == std::string::npos) {
-      LOG(FATAL) << "Invalid flag syntax '" << flag << "', expected\n"
-                 << "(--|/)<flag_name>[=value]";
-    }
-    std::string const flag_name =
-        flag.substr(name_begin, name_end - name_begin);
-    if (name_end != std::string::npos) {
-      flags.emplace(flag_name, flag.substr(name_end + 1, std::string::npos));
-    }
-    flags.emplace(flag_name, std::nullopt);
-  }
+  auto flags = ParseFlags();
   if (flags.empty() || Contains(flags, "help") || Contains(flags, "?")) {
     // Example:
     // .\Release\x64\mathematica_tests.exe \
@@ -136,6 +144,80 @@ TEST_F(ErrorAnalysisTest, DISABLED_SECULAR_LocalErrorAnalysis) {
       ParseQuantity<Time>(flags["granularity"].value_or("1 d")),
       ParseQuantity<Time>(flags["duration"].value_or("500 d")));
 }
+
+TEST_F(ErrorAnalysisTest, DISABLED_SECULAR_IntegratorSelection) {
+  google::LogToStderr();
+  auto flags = ParseFlags();
+  if (flags.empty() || Contains(flags, "help") || Contains(flags, "?")) {
+    // Example:
+    // .\Release\x64\mathematica_tests.exe \
+    //   --gtest_filter=ErrorAnalysisTest.DISABLED_SECULAR_IntegratorSelection \
+    //   --gtest_also_run_disabled_tests \
+    //   --gravity_model=.\astronomy\kerbol_gravity_model.proto.txt \
+    //   --initial_state=.\astronomy\kerbol_initial_state_0_0.proto.txt \
+    //   --integrators=BLANES_MOAN_2002_SRKN_11B,BLANES_MOAN_2002_SRKN_14A \
+    //   --time_steps=10min,20min,40min --tolerance=1m
+    std::printf(
+        "Usage:\n"
+        "mathematica_tests --gtest_filter=%s.%s \n"
+        "    --gravity_model=<path>\n"
+        "    --initial_state=<path>\n"
+        "    --integrators=<fixed_step_size_integrator>[,...]\n"
+        "    --time_steps=<quantity(time)>[,...]\n"
+        "    [--tolerance=<quantity(length)>] default: 1 km\n"
+        "    [--output_directory=<path>] default: .\n"
+        "    [--reference_integrator=<fixed_step_size_integrator >] "
+        "        default: BLANES_MOAN_2002_SRKN_14A\n"
+        "    [--reference_step=<quantity(time)>] default: 1 min\n"
+        "    [--granularity=<quantity(time)>] default: 10 d\n"
+        "    [--duration=<quantity(time)>] default: 500 d\n",
+        testing::UnitTest::GetInstance()->current_test_info()->test_case_name(),
+        testing::UnitTest::GetInstance()->current_test_info()->name());
+    return;
+  }
+  auto const gravity_model_path =
+      std::filesystem::path(*flags["gravity_model"]);
+  auto const initial_state_path =
+      std::filesystem::path(*flags["initial_state"]);
+  auto solar_system = make_not_null_unique<SolarSystem<Barycentric>>(
+      gravity_model_path, initial_state_path, /*ignore_frame=*/true);
+  auto const out =
+      std::filesystem::path(flags["output_directory"].value_or(".")) /
+      (std::string("integrator_selection[") + solar_system->names()[0] + "," +
+       solar_system->epoch_literal() + "].wl");
+
+  // Every combination of integrator and step is a candidate.
+  std::vector<IntegratorSelector<Barycentric>::Candidate> candidates;
+  std::vector<std::string> const integrators =
+      absl::StrSplit(*flags["integrators"], ',');
+  std::vector<std::string> const time_steps =
+      absl::StrSplit(*flags["time_steps"], ',');
+  for (auto const& integrator : integrators) {
+    for (auto const& time_step : time_steps) {
+      candidates.push_back({.integrator = integrator,
+                            .step = ParseQuantity<Time>(time_step)});
+    }
+  }
+
+  IntegratorSelector<Barycentric> const selector(
+      std::move(solar_system),
+      ParseFixedStepSizeIntegrator<
+          Ephemeris<Barycentric>::NewtonianMotionEquation>(
+          flags["reference_integrator"].value_or("BLANES_MOAN_2002_SRKN_14A")),
+      ParseQuantity<Time>(flags["reference_step"].value_or("1 min")),
+      ParseQuantity<Time>(flags["granularity"].value_or("10 d")),
+      ParseQuantity<Time>(flags["duration"].value_or("500 d")));
+  auto const selected = selector.WriteParetoFront(
+      out,
+      candidates,
+      ParseQuantity<Length>(flags["tolerance"].value_or("1 km")));
+  if (selected.has_value()) {
+    LOG(INFO) << "Selected " << selected->integrator << " with a step of "
+              << selected->step;
+  } else {
+    LOG(INFO) << "No candidate meets the tolerance";
+  }
+}
 #endif
 
 }  // namespace mathematica
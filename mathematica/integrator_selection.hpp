@@ -0,0 +1,104 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "integrators/integrators.hpp"
+#include "physics/ephemeris.hpp"
+#include "physics/solar_system.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace mathematica {
+namespace _integrator_selection {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::integrators::_integrators;
+using namespace principia::physics::_ephemeris;
+using namespace principia::physics::_solar_system;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+
+// A utility to select the cheapest integrator and step for the numerical
+// integration of a |solar_system|.  Each candidate is used to integrate the
+// system over a fixed duration, and its error is measured against a reference
+// integration.  The results form an error-vs-time Pareto front.
+template<typename Frame>
+class IntegratorSelector {
+ public:
+  using NewtonianMotionEquation =
+      typename Ephemeris<Frame>::NewtonianMotionEquation;
+
+  struct Candidate {
+    // The name of the integrator kind, as accepted by
+    // |ParseFixedStepSizeIntegrator|.
+    std::string integrator;
+    Time step;
+  };
+
+  struct Result {
+    Candidate candidate;
+    // The wall time taken by the integration.
+    Time time;
+    // The largest position error of any body, over all the samples.
+    Length error;
+    // True iff no other candidate is both faster and more accurate.
+    bool pareto_optimal = false;
+  };
+
+  // The reference integration uses |reference_integrator| with
+  // |reference_step|.  The errors are sampled every |granularity| for
+  // |duration| from the solar system epoch.
+  IntegratorSelector(
+      not_null<std::unique_ptr<SolarSystem<Frame>>> solar_system,
+      FixedStepSizeIntegrator<NewtonianMotionEquation> const&
+          reference_integrator,
+      Time const& reference_step,
+      Time const& granularity,
+      Time const& duration);
+
+  // Integrates with each of the |candidates| and returns the results, sorted
+  // by increasing time.
+  std::vector<Result> Run(std::vector<Candidate> const& candidates) const;
+
+  // Runs the |candidates| and writes the results to a file with the given
+  // |path|.  Returns the fastest candidate whose error is at most |tolerance|,
+  // if any.
+  std::optional<Candidate> WriteParetoFront(
+      std::filesystem::path const& path,
+      std::vector<Candidate> const& candidates,
+      Length const& tolerance) const;
+
+ private:
+  not_null<std::unique_ptr<Ephemeris<Frame>>> MakeEphemeris(
+      FixedStepSizeIntegrator<NewtonianMotionEquation> const& integrator,
+      Time const& step) const;
+
+  static constexpr Length fitting_tolerance_ = 1 * Milli(Metre);
+
+  not_null<std::unique_ptr<SolarSystem<Frame>>> const solar_system_;
+  Time const granularity_;
+  Time const duration_;
+  // The positions of the bodies at each sample of the reference integration.
+  std::vector<std::vector<Position<Frame>>> reference_positions_;
+};
+
+}  // namespace internal
+
+using internal::IntegratorSelector;
+
+}  // namespace _integrator_selection
+}  // namespace mathematica
+}  // namespace principia
+
+#include "mathematica/integrator_selection_body.hpp"
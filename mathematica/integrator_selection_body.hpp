@@ -0,0 +1,166 @@
+#pragma once
+
+#include "mathematica/integrator_selection.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "astronomy/solar_system_fingerprints.hpp"
+#include "astronomy/stabilize_ksp.hpp"
+#include "base/file.hpp"
+#include "glog/logging.h"
+#include "mathematica/mathematica.hpp"
+#include "physics/massive_body.hpp"
+
+namespace principia {
+namespace mathematica {
+namespace _integrator_selection {
+namespace internal {
+
+using namespace principia::astronomy::_solar_system_fingerprints;
+using namespace principia::astronomy::_stabilize_ksp;
+using namespace principia::base::_file;
+using namespace principia::mathematica::_mathematica;
+using namespace principia::physics::_massive_body;
+
+template<typename Frame>
+IntegratorSelector<Frame>::IntegratorSelector(
+    not_null<std::unique_ptr<SolarSystem<Frame>>> solar_system,
+    FixedStepSizeIntegrator<NewtonianMotionEquation> const&
+        reference_integrator,
+    Time const& reference_step,
+    Time const& granularity,
+    Time const& duration)
+    : solar_system_(std::move(solar_system)),
+      granularity_(granularity),
+      duration_(duration) {
+  if (solar_system_->Fingerprint() == KSPStockSystemFingerprints[KSP191]) {
+    LOG(INFO) << "All hail retrobop!";
+    StabilizeKSP(*solar_system_);
+    CHECK_EQ(solar_system_->Fingerprint(),
+             KSPStabilizedSystemFingerprints[KSP191]);
+  }
+
+  auto const reference_ephemeris =
+      MakeEphemeris(reference_integrator, reference_step);
+  for (Instant t = solar_system_->epoch() + granularity_;
+       t <= solar_system_->epoch() + duration_;
+       t += granularity_) {
+    CHECK_OK(reference_ephemeris->Prolong(t));
+    auto& positions = reference_positions_.emplace_back();
+    for (auto const body : reference_ephemeris->bodies()) {
+      positions.push_back(
+          reference_ephemeris->trajectory(body)->EvaluatePosition(t));
+    }
+  }
+  LOG(INFO) << "Reference integration completed";
+}
+
+template<typename Frame>
+std::vector<typename IntegratorSelector<Frame>::Result>
+IntegratorSelector<Frame>::Run(std::vector<Candidate> const& candidates) const {
+  std::vector<Result> results;
+  for (auto const& candidate : candidates) {
+    auto const ephemeris = MakeEphemeris(
+        ParseFixedStepSizeIntegrator<NewtonianMotionEquation>(
+            candidate.integrator),
+        candidate.step);
+
+    // Only the integration is timed, not the evaluation of the errors.
+    std::chrono::steady_clock::duration elapsed{};
+    Length error;
+    int sample = 0;
+    for (Instant t = solar_system_->epoch() + granularity_;
+         t <= solar_system_->epoch() + duration_;
+         t += granularity_, ++sample) {
+      auto const start = std::chrono::steady_clock::now();
+      CHECK_OK(ephemeris->Prolong(t));
+      elapsed += std::chrono::steady_clock::now() - start;
+      auto const& reference_positions = reference_positions_[sample];
+      for (int i = 0; i < reference_positions.size(); ++i) {
+        error = std::max(error,
+                         (ephemeris->trajectory(ephemeris->bodies()[i])
+                              ->EvaluatePosition(t) -
+                          reference_positions[i]).Norm());
+      }
+    }
+    results.push_back(
+        {.candidate = candidate,
+         .time = std::chrono::duration<double>(elapsed).count() * Second,
+         .error = error});
+    LOG(INFO) << candidate.integrator << " " << candidate.step << ": "
+              << results.back().time << ", " << error;
+  }
+
+  std::sort(results.begin(), results.end(),
+            [](Result const& left, Result const& right) {
+              return left.time < right.time;
+            });
+  // A result is on the Pareto front iff it is more accurate than all the
+  // faster ones.
+  std::optional<Length> smallest_error;
+  for (auto& result : results) {
+    if (!smallest_error.has_value() || result.error < *smallest_error) {
+      result.pareto_optimal = true;
+      smallest_error = result.error;
+    }
+  }
+  return results;
+}
+
+template<typename Frame>
+auto IntegratorSelector<Frame>::WriteParetoFront(
+    std::filesystem::path const& path,
+    std::vector<Candidate> const& candidates,
+    Length const& tolerance) const -> std::optional<Candidate> {
+  std::vector<Result> const results = Run(candidates);
+
+  std::optional<Candidate> selected;
+  std::vector<std::string> integrators;
+  std::vector<Time> steps;
+  std::vector<Time> times;
+  std::vector<Length> errors;
+  std::vector<bool> pareto_optimal;
+  for (auto const& result : results) {
+    if (!selected.has_value() && result.error <= tolerance) {
+      selected = result.candidate;
+    }
+    integrators.push_back(result.candidate.integrator);
+    steps.push_back(result.candidate.step);
+    times.push_back(result.time);
+    errors.push_back(result.error);
+    pareto_optimal.push_back(result.pareto_optimal);
+  }
+
+  OFStream file(path);
+  file << Set("integrators", integrators);
+  file << Set("steps", steps, ExpressIn(Second));
+  file << Set("times", times, ExpressIn(Second));
+  file << Set("errors", errors, ExpressIn(Metre));
+  file << Set("paretoOptimal", pareto_optimal);
+  return selected;
+}
+
+template<typename Frame>
+not_null<std::unique_ptr<Ephemeris<Frame>>>
+IntegratorSelector<Frame>::MakeEphemeris(
+    FixedStepSizeIntegrator<NewtonianMotionEquation> const& integrator,
+    Time const& step) const {
+  auto ephemeris = solar_system_->MakeEphemeris(
+      /*accuracy_parameters=*/{fitting_tolerance_,
+                               /*geopotential_tolerance=*/0x1p-24},
+      typename Ephemeris<Frame>::FixedStepParameters(integrator, step));
+  CHECK_OK(ephemeris->Prolong(solar_system_->epoch()));
+  return ephemeris;
+}
+
+}  // namespace internal
+}  // namespace _integrator_selection
+}  // namespace mathematica
+}  // namespace principia
@@ -3,13 +3,16 @@
 #include "mathematica/local_error_analysis.hpp"
 
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "astronomy/solar_system_fingerprints.hpp"
 #include "astronomy/stabilize_ksp.hpp"
 #include "base/file.hpp"
+#include "base/thread_pool.hpp"
 #include "mathematica/mathematica.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/massive_body.hpp"
@@ -22,6 +25,7 @@ namespace internal {
 using namespace principia::astronomy::_solar_system_fingerprints;
 using namespace principia::astronomy::_stabilize_ksp;
 using namespace principia::base::_file;
+using namespace principia::base::_thread_pool;
 using namespace principia::mathematica::_mathematica;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_massive_body;
@@ -55,30 +59,52 @@ void LocalErrorAnalyser<Frame>::WriteLocalErrors(
       /*accuracy_parameters=*/{fitting_tolerance_,
                                /*geopotential_tolerance=*/0x1p-24},
       typename Ephemeris<Frame>::FixedStepParameters(integrator_, step_));
-  CHECK_OK(reference_ephemeris->Prolong(solar_system_->epoch()));
-  std::vector<std::vector<Length>> errors;
+  // The refined integrations only depend on the reference one at the start of
+  // their interval, so we complete the reference integration first and then
+  // run the refined ones in parallel.  The errors are collected in order, so
+  // the result doesn't depend on the scheduling.
+  std::vector<std::pair<Instant, Instant>> intervals;
   for (Instant t0 = solar_system_->epoch(),
                t = t0 + granularity;
        t < solar_system_->epoch() + duration;
        t0 = t, t += granularity) {
-    std::unique_ptr<Ephemeris<Frame>> refined_ephemeris =
-        ForkEphemeris(*reference_ephemeris, t0, fine_integrator, fine_step);
-    CHECK_OK(reference_ephemeris->Prolong(t));
-    CHECK_OK(refined_ephemeris->Prolong(t));
-    LOG_EVERY_N(INFO, 10) << "Prolonged to "
-                          << (t - solar_system_->epoch()) / Day << " days.";
+    intervals.emplace_back(t0, t);
+  }
+  CHECK_OK(reference_ephemeris->Prolong(
+      intervals.empty() ? solar_system_->epoch() : intervals.back().second));
+
+  ThreadPool<std::vector<Length>> pool(std::thread::hardware_concurrency());
+  std::vector<std::future<std::vector<Length>>> futures;
+  for (auto const& [t0, t] : intervals) {
+    futures.push_back(pool.Add([this,
+                                &fine_integrator,
+                                &reference_ephemeris,
+                                fine_step,
+                                t0 = t0,
+                                t = t]() {
+      std::unique_ptr<Ephemeris<Frame>> refined_ephemeris =
+          ForkEphemeris(*reference_ephemeris, t0, fine_integrator, fine_step);
+      CHECK_OK(refined_ephemeris->Prolong(t));
+      LOG_EVERY_N(INFO, 10) << "Prolonged to "
+                            << (t - solar_system_->epoch()) / Day << " days.";
 
-    errors.emplace_back();
-    for (auto const& body_name : solar_system_->names()) {
-      int const body_index = solar_system_->index(body_name);
-      errors.back().push_back(
-          (reference_ephemeris
-               ->trajectory(reference_ephemeris->bodies()[body_index])
-               ->EvaluatePosition(t) -
-           refined_ephemeris
-               ->trajectory(refined_ephemeris->bodies()[body_index])
-               ->EvaluatePosition(t)).Norm());
-    }
+      std::vector<Length> errors;
+      for (auto const& body_name : solar_system_->names()) {
+        int const body_index = solar_system_->index(body_name);
+        errors.push_back(
+            (reference_ephemeris
+                 ->trajectory(reference_ephemeris->bodies()[body_index])
+                 ->EvaluatePosition(t) -
+             refined_ephemeris
+                 ->trajectory(refined_ephemeris->bodies()[body_index])
+                 ->EvaluatePosition(t)).Norm());
+      }
+      return errors;
+    }));
+  }
+  std::vector<std::vector<Length>> errors;
+  for (auto& future : futures) {
+    errors.push_back(future.get());
   }
   OFStream file(path);
   file << Set("bodyNames", solar_system_->names());
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -52,6 +55,21 @@ class Logger final {
   template<typename... Args>
   void Set(std::string const& name, Args... args);
 
+  // Appends a row to the array for the variable |name|, without keeping it in
+  // memory.  The row contains the coordinates of |value|, which may be a
+  // number, a quantity, a vector, a point, degrees of freedom, or a tuple of
+  // those, expressed as doubles using |express_in|.  The rows are streamed as
+  // little-endian doubles to a file next to the one of this logger, named after
+  // |name|, and all the rows for |name| must have the same number of
+  // coordinates.  That file may be read with NumPy (|numpy.fromfile|).  When
+  // this object is destroyed, an assignment is generated that reads that file
+  // with |BinaryReadList| when the Mathematica file is loaded with |Get|.  This
+  // is much faster and uses much less memory than |Append| for large datasets.
+  template<typename T, typename OptionalExpressIn = std::nullopt_t>
+  void AppendBinary(std::string const& name,
+                    T const& value,
+                    OptionalExpressIn express_in = std::nullopt);
+
   // When a logger is disabled, the calls to |Append| and |Set| have no effect.
   // Loggers are enabled at construction.
   void Enable();
@@ -73,11 +91,20 @@ class Logger final {
   static void ClearConstructionCallback();
 
  private:
+  // A file to which the rows of a variable are streamed by |AppendBinary|.
+  struct BinaryFile {
+    std::filesystem::path path;
+    std::ofstream stream;
+    std::int64_t columns;
+  };
+
   std::atomic_bool enabled_ = true;
   std::optional<std::uint64_t> my_id_;
+  std::filesystem::path path_;
   OFStream file_;
   std::map<std::string, std::vector<std::string>> name_and_multiple_values_;
   std::map<std::string, std::string> name_and_single_value_;
+  std::map<std::string, BinaryFile> name_and_binary_file_;
 
   static std::atomic_uint64_t id_;
   static ConstructionCallback construction_callback_;
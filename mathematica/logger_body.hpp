@@ -2,17 +2,129 @@
 
 #include "mathematica/logger.hpp"
 
+#include <bit>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
+#include "geometry/grassmann.hpp"
+#include "geometry/point.hpp"
+#include "geometry/r3_element.hpp"
+#include "glog/logging.h"
 #include "mathematica/mathematica.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "quantities/tuples.hpp"
 
 namespace principia {
 namespace mathematica {
 namespace _logger {
 namespace internal {
 
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_point;
+using namespace principia::geometry::_r3_element;
 using namespace principia::mathematica::_mathematica;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::quantities::_tuples;
+
+// The binary files are read with |ByteOrdering -> -1|.
+static_assert(std::endian::native == std::endian::little);
+
+// Appends to |row| the coordinates of |value| expressed as doubles.
+template<typename T, typename OptionalExpressIn,
+         typename = std::enable_if_t<!is_tuple_v<T>>>
+void AppendCoordinates(T const& value,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row);
+template<typename T, typename OptionalExpressIn>
+void AppendCoordinates(R3Element<T> const& r3_element,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row);
+template<typename S, typename F, typename OptionalExpressIn>
+void AppendCoordinates(Vector<S, F> const& vector,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row);
+template<typename S, typename F, typename OptionalExpressIn>
+void AppendCoordinates(Bivector<S, F> const& bivector,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row);
+template<typename V, typename OptionalExpressIn>
+void AppendCoordinates(Point<V> const& point,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row);
+template<typename F, typename OptionalExpressIn>
+void AppendCoordinates(DegreesOfFreedom<F> const& degrees_of_freedom,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row);
+template<typename Tuple, typename OptionalExpressIn,
+         typename = std::enable_if_t<is_tuple_v<Tuple>>, typename = void>
+void AppendCoordinates(Tuple const& tuple,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row);
+
+template<typename T, typename OptionalExpressIn, typename>
+void AppendCoordinates(T const& value,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    row.push_back(static_cast<double>(value));
+  } else {
+    static_assert(
+        !std::is_same_v<OptionalExpressIn, std::nullopt_t>,
+        "Must specify a way to express units for dimensionful quantities");
+    row.push_back(express_in(value));
+  }
+}
+
+template<typename T, typename OptionalExpressIn>
+void AppendCoordinates(R3Element<T> const& r3_element,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row) {
+  AppendCoordinates(r3_element.x, express_in, row);
+  AppendCoordinates(r3_element.y, express_in, row);
+  AppendCoordinates(r3_element.z, express_in, row);
+}
+
+template<typename S, typename F, typename OptionalExpressIn>
+void AppendCoordinates(Vector<S, F> const& vector,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row) {
+  AppendCoordinates(vector.coordinates(), express_in, row);
+}
+
+template<typename S, typename F, typename OptionalExpressIn>
+void AppendCoordinates(Bivector<S, F> const& bivector,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row) {
+  AppendCoordinates(bivector.coordinates(), express_in, row);
+}
+
+template<typename V, typename OptionalExpressIn>
+void AppendCoordinates(Point<V> const& point,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row) {
+  AppendCoordinates(point - Point<V>(), express_in, row);
+}
+
+template<typename F, typename OptionalExpressIn>
+void AppendCoordinates(DegreesOfFreedom<F> const& degrees_of_freedom,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row) {
+  AppendCoordinates(degrees_of_freedom.position(), express_in, row);
+  AppendCoordinates(degrees_of_freedom.velocity(), express_in, row);
+}
+
+template<typename Tuple, typename OptionalExpressIn, typename, typename>
+void AppendCoordinates(Tuple const& tuple,
+                       OptionalExpressIn express_in,
+                       std::vector<double>& row) {
+  std::apply(
+      [express_in, &row](auto const&... elements) {
+        (AppendCoordinates(elements, express_in, row), ...);
+      },
+      tuple);
+}
 
 inline Logger::Logger(std::filesystem::path const& path, bool const make_unique)
     : file_([this, make_unique, &path]() {
@@ -26,10 +138,11 @@ inline Logger::Logger(std::filesystem::path const& path, bool const make_unique)
           filename += "_new";
 #endif
           filename += path.extension();
-          return path.parent_path() / filename;
+          path_ = path.parent_path() / filename;
         } else {
-          return path;
+          path_ = path;
         }
+        return path_;
       }()) {
   absl::ReaderMutexLock l(&construction_callback_lock_);
   if (construction_callback_ != nullptr) {
@@ -49,6 +162,23 @@ inline void Logger::Flush() {
   for (auto const& [name, value] : name_and_single_value_) {
     file_ << RawApply("Set", {name, value}) + ";\n";
   }
+  for (auto& [name, binary_file] : name_and_binary_file_) {
+    binary_file.stream.flush();
+    // The binary file is found relative to the Mathematica file being loaded.
+    std::string const binary_file_path = RawApply(
+        "FileNameJoin",
+        {RawApply("List",
+                  {RawApply("DirectoryName", {"$InputFileName"}),
+                   ToMathematica(binary_file.path.filename().string())})});
+    std::string const values =
+        RawApply("BinaryReadList",
+                 {binary_file_path,
+                  ToMathematica("Real64"),
+                  RawApply("Rule", {"ByteOrdering", "-1"})});
+    std::string const rows =
+        RawApply("Partition", {values, ToMathematica(binary_file.columns)});
+    file_ << RawApply("Set", {name, rows}) + ";\n";
+  }
 }
 
 template<typename... Args>
@@ -65,6 +195,32 @@ void Logger::Set(std::string const& name, Args... args) {
   }
 }
 
+template<typename T, typename OptionalExpressIn>
+void Logger::AppendBinary(std::string const& name,
+                          T const& value,
+                          OptionalExpressIn express_in) {
+  if (enabled_) {
+    std::vector<double> row;
+    AppendCoordinates(value, express_in, row);
+    auto it = name_and_binary_file_.find(name);
+    if (it == name_and_binary_file_.end()) {
+      std::filesystem::path path = path_.parent_path() / path_.stem();
+      path += "_" + name + ".bin";
+      it = name_and_binary_file_.emplace(name, BinaryFile{.path = path}).first;
+      auto& binary_file = it->second;
+      binary_file.stream.open(path, std::ios::binary | std::ios::trunc);
+      CHECK(binary_file.stream.good()) << path;
+      binary_file.columns = row.size();
+    }
+    auto& binary_file = it->second;
+    CHECK_EQ(binary_file.columns, static_cast<std::int64_t>(row.size()))
+        << name;
+    binary_file.stream.write(reinterpret_cast<char const*>(row.data()),
+                             row.size() * sizeof(double));
+    CHECK(binary_file.stream.good()) << binary_file.path;
+  }
+}
+
 inline void Logger::Enable() {
   enabled_ = true;
 }
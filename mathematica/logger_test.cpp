@@ -1,24 +1,32 @@
 #include "mathematica/logger.hpp"
 
 #include <filesystem>
+#include <fstream>
+#include <string>
 #include <tuple>
 #include <vector>
 
 #include "base/not_null.hpp"
 #include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "mathematica/mathematica.hpp"
+#include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
 
 namespace principia {
 namespace mathematica {
 
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
 using ::testing::Optional;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
+using namespace principia::geometry::_grassmann;
 using namespace principia::mathematica::_logger;
 using namespace principia::mathematica::_mathematica;
+using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
 class LoggerTest : public ::testing::Test {
@@ -68,6 +76,38 @@ TEST_F(LoggerTest, Logger) {
              << std::ifstream(TEMP_DIR / "mathematica_test0.wl").rdbuf())
                 .str());
 }
+
+TEST_F(LoggerTest, Binary) {
+  Logger::ClearConstructionCallback();
+  {
+    Logger logger(TEMP_DIR / "mathematica_binary_test.wl",
+                  /*make_unique=*/false);
+    for (int i = 0; i < 3; ++i) {
+      logger.AppendBinary(
+          "q",
+          std::tuple{i * Second,
+                     Vector<Length, F>({i * Metre, 2 * Metre, 3 * Metre})},
+          ExpressInSIUnits);
+    }
+    logger.AppendBinary("n", 7);
+  }
+  std::string const contents =
+      (std::stringstream{}
+       << std::ifstream(TEMP_DIR / "mathematica_binary_test.wl").rdbuf())
+          .str();
+  EXPECT_THAT(contents, HasSubstr("mathematica_binary_test_q.bin"));
+  EXPECT_THAT(contents, HasSubstr("Set[q,Partition[BinaryReadList["));
+
+  std::vector<double> q(4 * 3);
+  std::ifstream q_file(TEMP_DIR / "mathematica_binary_test_q.bin",
+                       std::ios::binary);
+  q_file.read(reinterpret_cast<char*>(q.data()), q.size() * sizeof(double));
+  EXPECT_TRUE(q_file.good());
+  EXPECT_THAT(q, ElementsAre(0, 0, 2, 3, 1, 1, 2, 3, 2, 2, 2, 3));
+  EXPECT_EQ(sizeof(double),
+            std::filesystem::file_size(TEMP_DIR /
+                                       "mathematica_binary_test_n.bin"));
+}
 #endif
 
 }  // namespace mathematica
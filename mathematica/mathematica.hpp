@@ -14,6 +14,7 @@
 #include "geometry/r3_element.hpp"
 #include "geometry/r3x3_matrix.hpp"
 #include "geometry/symmetric_bilinear_form.hpp"
+#include "integrators/integrators.hpp"
 #include "numerics/double_precision.hpp"
 #include "numerics/fixed_arrays.hpp"
 #include "numerics/piecewise_poisson_series.hpp"
@@ -42,6 +43,7 @@ using namespace principia::geometry::_quaternion;
 using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_r3x3_matrix;
 using namespace principia::geometry::_symmetric_bilinear_form;
+using namespace principia::integrators::_integrators;
 using namespace principia::numerics::_double_precision;
 using namespace principia::numerics::_fixed_arrays;
 using namespace principia::numerics::_piecewise_poisson_series;
@@ -322,6 +324,14 @@ template<typename OptionalExpressIn = std::nullopt_t>
 std::string ToMathematica(OrbitalElements::EquinoctialElements const& elements,
                           OptionalExpressIn express_in = std::nullopt);
 
+// The statistics are exported as a list {accepted steps, rejected steps,
+// evaluations, smallest step, largest step, evaluation time, solve time}.
+template<typename IndependentVariableDifference,
+         typename OptionalExpressIn = std::nullopt_t>
+std::string ToMathematica(
+    IntegrationStatistics<IndependentVariableDifference> const& statistics,
+    OptionalExpressIn express_in = std::nullopt);
+
 template<typename T, typename OptionalExpressIn = std::nullopt_t>
 std::string ToMathematica(std::optional<T> const& opt,
                           OptionalExpressIn express_in = std::nullopt);
@@ -611,6 +611,20 @@ std::string ToMathematica(OrbitalElements::EquinoctialElements const& elements,
                        express_in);
 }
 
+template<typename IndependentVariableDifference, typename OptionalExpressIn>
+std::string ToMathematica(
+    IntegrationStatistics<IndependentVariableDifference> const& statistics,
+    OptionalExpressIn express_in) {
+  return ToMathematica(std::make_tuple(statistics.accepted_steps,
+                                       statistics.rejected_steps,
+                                       statistics.evaluations,
+                                       statistics.smallest_step,
+                                       statistics.largest_step,
+                                       statistics.evaluation_time,
+                                       statistics.solve_time),
+                       express_in);
+}
+
 template<typename T, typename OptionalExpressIn>
 std::string ToMathematica(std::optional<T> const& opt,
                           OptionalExpressIn express_in) {
@@ -17,6 +17,7 @@
 #include "geometry/space.hpp"
 #include "geometry/symmetric_bilinear_form.hpp"
 #include "gtest/gtest.h"
+#include "integrators/integrators.hpp"
 #include "numerics/double_precision.hpp"
 #include "numerics/fixed_arrays.hpp"
 #include "numerics/piecewise_poisson_series.hpp"
@@ -48,6 +49,7 @@ using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_r3x3_matrix;
 using namespace principia::geometry::_space;
 using namespace principia::geometry::_symmetric_bilinear_form;
+using namespace principia::integrators::_integrators;
 using namespace principia::mathematica::_mathematica;
 using namespace principia::numerics::_double_precision;
 using namespace principia::numerics::_fixed_arrays;
@@ -409,6 +411,17 @@ TEST_F(MathematicaTest, ExpressIn) {
         ToMathematica(std::tuple(0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0)),
         ToMathematica(elements, ExpressIn(Metre, Second, Radian)));
   }
+  {
+    IntegrationStatistics<Time> statistics{.accepted_steps = 1,
+                                           .rejected_steps = 2,
+                                           .evaluations = 3,
+                                           .smallest_step = 4 * Second,
+                                           .largest_step = 5 * Second,
+                                           .evaluation_time = 6 * Second,
+                                           .solve_time = 7 * Second};
+    EXPECT_EQ(ToMathematica(std::tuple(1, 2, 3, 4.0, 5.0, 6.0, 7.0)),
+              ToMathematica(statistics, ExpressIn(Second)));
+  }
 
 // Does not compile, by design.
 #if 0
@@ -2,6 +2,11 @@
 
 #include "numerics/angle_reduction.hpp"
 
+#include <pmmintrin.h>
+
+#include <cmath>
+#include <cstdint>
+
 #include "base/macros.hpp"  // 🧙 For PRINCIPIA_USE_SSE3_INTRINSICS.
 #include "quantities/si.hpp"
 
@@ -65,7 +70,7 @@ class AngleReduction<Angle, -π / 2, π / 2> {
                      std::int64_t& integer_part) {
     double const θ_in_half_cycles = θ / (π * Radian);
     double reduced_in_half_cycles;
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_SSE3_INTRINSICS()
     auto const& x = θ_in_half_cycles;
     __m128d const x_128d = _mm_set_sd(x);
     integer_part = _mm_cvtsd_si64(x_128d);
@@ -13,12 +13,27 @@ namespace internal {
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_rotation;
 
+// Returns the rotation that best maps the directions |a| to the directions |b|
+// in the weighted least-squares sense (Wahba's problem), by computing the
+// eigensystem of Davenport's K matrix.
 template<typename FromFrame, typename ToFrame, typename Weight>
 Rotation<FromFrame, ToFrame> DavenportQMethod(
     std::vector<Vector<double, FromFrame>> const& a,
     std::vector<Vector<double, ToFrame>> const& b,
     std::vector<Weight> const& weights);
 
+// Solves a batch of Wahba's problems, the ith one being defined by |a[i]|,
+// |b[i]| and |weights[i]|.  Instead of computing the entire eigensystem of
+// each K matrix, this finds its largest eigenvalue as the largest root of the
+// characteristic polynomial, and the corresponding eigenvector from the
+// adjugate, which is much cheaper.  The full eigensystem is only computed for
+// the problems where the largest eigenvalue is (nearly) degenerate.
+template<typename FromFrame, typename ToFrame, typename Weight>
+std::vector<Rotation<FromFrame, ToFrame>> DavenportQMethod(
+    std::vector<std::vector<Vector<double, FromFrame>>> const& a,
+    std::vector<std::vector<Vector<double, ToFrame>>> const& b,
+    std::vector<std::vector<Weight>> const& weights);
+
 }  // namespace internal
 
 using internal::DavenportQMethod;
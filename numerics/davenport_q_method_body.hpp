@@ -2,6 +2,9 @@
 
 #include "numerics/davenport_q_method.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
 #include <vector>
 
 #include "geometry/quaternion.hpp"
@@ -9,6 +12,7 @@
 #include "geometry/r3x3_matrix.hpp"
 #include "numerics/fixed_arrays.hpp"
 #include "numerics/matrix_computations.hpp"
+#include "quantities/elementary_functions.hpp"
 #include "quantities/quantities.hpp"
 
 namespace principia {
@@ -21,10 +25,12 @@ using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_r3x3_matrix;
 using namespace principia::numerics::_fixed_arrays;
 using namespace principia::numerics::_matrix_computations;
+using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_quantities;
 
+// Returns Davenport's K matrix for the given observations.
 template<typename FromFrame, typename ToFrame, typename Weight>
-Rotation<FromFrame, ToFrame> DavenportQMethod(
+FixedMatrix<Weight, 4, 4> KMatrix(
     std::vector<Vector<double, FromFrame>> const& a,
     std::vector<Vector<double, ToFrame>> const& b,
     std::vector<Weight> const& weights) {
@@ -61,7 +67,13 @@ Rotation<FromFrame, ToFrame> DavenportQMethod(
     K(i, 3) = z[i];
   }
   K(3, 3) = μ;
+  return K;
+}
 
+// Returns the eigenvector of |K| for its most positive eigenvalue, as a
+// quaternion.
+template<typename Weight>
+Quaternion MostPositiveEigenvectorByJacobi(FixedMatrix<Weight, 4, 4> const& K) {
   // Compute its eigensystem.
   auto const eigensystem = ClassicalJacobi(K, /*max_iterations=*/20);
   auto const& eigenvalues = eigensystem.eigenvalues;
@@ -78,12 +90,165 @@ Rotation<FromFrame, ToFrame> DavenportQMethod(
           R3Element<double>(rotation(0, i), rotation(1, i), rotation(2, i)));
     }
   }
+  return eigenvector;
+}
+
+// The determinant of the 3×3 minor of |M| obtained by removing the row |i| and
+// the column |j|, with the sign of the cofactor.
+inline double Cofactor(FixedMatrix<double, 4, 4> const& M,
+                       int const i,
+                       int const j) {
+  int r[3];
+  int c[3];
+  for (int k = 0, l = 0; k < 4; ++k) {
+    if (k != i) {
+      r[l++] = k;
+    }
+  }
+  for (int k = 0, l = 0; k < 4; ++k) {
+    if (k != j) {
+      c[l++] = k;
+    }
+  }
+  double const minor =
+      M(r[0], c[0]) * (M(r[1], c[1]) * M(r[2], c[2]) -
+                       M(r[1], c[2]) * M(r[2], c[1])) -
+      M(r[0], c[1]) * (M(r[1], c[0]) * M(r[2], c[2]) -
+                       M(r[1], c[2]) * M(r[2], c[0])) +
+      M(r[0], c[2]) * (M(r[1], c[0]) * M(r[2], c[1]) -
+                       M(r[1], c[1]) * M(r[2], c[0]));
+  return (i + j) % 2 == 0 ? minor : -minor;
+}
+
+// Same as above, but using the characteristic polynomial of |K|.  Returns
+// nullopt if the most positive eigenvalue is too close to another one for this
+// method to be accurate.
+template<typename Weight>
+std::optional<Quaternion> MostPositiveEigenvectorByCharacteristicPolynomial(
+    FixedMatrix<Weight, 4, 4> const& K) {
+  // The Gershgorin circles give an upper bound for the eigenvalues, which we
+  // use to scale the matrix so that its eigenvalues are in [-1, 1].
+  Weight gershgorin_bound{};
+  for (int i = 0; i < 4; ++i) {
+    Weight row_bound{};
+    for (int j = 0; j < 4; ++j) {
+      row_bound += Abs(K(i, j));
+    }
+    gershgorin_bound = std::max(gershgorin_bound, row_bound);
+  }
+  if (gershgorin_bound == Weight{}) {
+    return std::nullopt;
+  }
+  FixedMatrix<double, 4, 4> k;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      k(i, j) = K(i, j) / gershgorin_bound;
+    }
+  }
+
+  // Since |k| is traceless, its characteristic polynomial is
+  // λ⁴ - tr(k²) λ² / 2 - tr(k³) λ / 3 + det(k).
+  double tr_k² = 0;
+  double tr_k³ = 0;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      double k²_ij = 0;
+      for (int l = 0; l < 4; ++l) {
+        k²_ij += k(i, l) * k(l, j);
+      }
+      tr_k² += k(i, j) * k(j, i);
+      tr_k³ += k²_ij * k(j, i);
+    }
+  }
+  double det_k = 0;
+  for (int j = 0; j < 4; ++j) {
+    det_k += k(0, j) * Cofactor(k, 0, j);
+  }
+  double const c₂ = -tr_k² / 2;
+  double const c₁ = -tr_k³ / 3;
+  double const c₀ = det_k;
+
+  // All the roots are real and at most 1, so Newton's method started at 1
+  // decreases monotonically towards the largest one.  Stop when it no longer
+  // makes progress.
+  constexpr int max_iterations = 32;
+  double λ = 1;
+  for (int n = 0; n < max_iterations; ++n) {
+    double const λ² = λ * λ;
+    double const p = (λ² + c₂) * λ² + c₁ * λ + c₀;
+    double const dp = (4 * λ² + 2 * c₂) * λ + c₁;
+    double const δ = p / dp;
+    if (!(δ > 0) || !std::isfinite(δ)) {
+      break;
+    }
+    λ -= δ;
+  }
+
+  // The adjugate of k - λ I is a multiple of the outer product of the
+  // eigenvector with itself; we use its column with the largest diagonal entry.
+  // If all the diagonal entries are small, the other eigenvalues are close to λ
+  // and the column is dominated by rounding errors.
+  constexpr double min_cofactor = 0x1p-40;
+  FixedMatrix<double, 4, 4> m = k;
+  for (int i = 0; i < 4; ++i) {
+    m(i, i) -= λ;
+  }
+  int best_column = 0;
+  double best_cofactor = 0;
+  for (int j = 0; j < 4; ++j) {
+    double const cofactor = Cofactor(m, j, j);
+    if (std::abs(cofactor) > std::abs(best_cofactor)) {
+      best_column = j;
+      best_cofactor = cofactor;
+    }
+  }
+  if (!(std::abs(best_cofactor) > min_cofactor)) {
+    return std::nullopt;
+  }
+  double x[4];
+  for (int i = 0; i < 4; ++i) {
+    x[i] = i == best_column ? best_cofactor : Cofactor(m, best_column, i);
+  }
+  Quaternion const eigenvector(x[3], R3Element<double>(x[0], x[1], x[2]));
+  return eigenvector / eigenvector.Norm();
+}
+
+template<typename FromFrame, typename ToFrame, typename Weight>
+Rotation<FromFrame, ToFrame> DavenportQMethod(
+    std::vector<Vector<double, FromFrame>> const& a,
+    std::vector<Vector<double, ToFrame>> const& b,
+    std::vector<Weight> const& weights) {
+  Quaternion const eigenvector =
+      MostPositiveEigenvectorByJacobi(KMatrix(a, b, weights));
 
   // The conjugation is because [And17] uses active rotations, but our rotations
   // are passive.
   return Rotation<FromFrame, ToFrame>(eigenvector.Conjugate());
 }
 
+template<typename FromFrame, typename ToFrame, typename Weight>
+std::vector<Rotation<FromFrame, ToFrame>> DavenportQMethod(
+    std::vector<std::vector<Vector<double, FromFrame>>> const& a,
+    std::vector<std::vector<Vector<double, ToFrame>>> const& b,
+    std::vector<std::vector<Weight>> const& weights) {
+  std::int64_t const size = a.size();
+  CHECK_EQ(size, b.size());
+  CHECK_EQ(size, weights.size());
+
+  std::vector<Rotation<FromFrame, ToFrame>> rotations;
+  rotations.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    auto const K = KMatrix(a[i], b[i], weights[i]);
+    std::optional<Quaternion> const eigenvector =
+        MostPositiveEigenvectorByCharacteristicPolynomial(K);
+    rotations.emplace_back(
+        eigenvector.has_value()
+            ? eigenvector->Conjugate()
+            : MostPositiveEigenvectorByJacobi(K).Conjugate());
+  }
+  return rotations;
+}
+
 }  // namespace internal
 }  // namespace _davenport_q_method
 }  // namespace numerics
@@ -123,5 +123,57 @@ TEST_F(DavenportQMethodTest, PerturbedWeighted) {
               AlmostEquals(rotation, 112'728'156, 473'381'658));
 }
 
+TEST_F(DavenportQMethodTest, Batch) {
+  std::vector<std::vector<Vector<double, World1>>> a;
+  std::vector<std::vector<Vector<double, World2>>> b;
+  std::vector<std::vector<Length>> weights;
+  std::uniform_real_distribution<double> quaternion_distribution(-1, 1);
+  std::uniform_real_distribution<double> perturbation_distribution(-1e-3, 1e-3);
+  std::uniform_real_distribution<double> weight_distribution(0.1, 10);
+  for (int i = 0; i < 100; ++i) {
+    Quaternion const q(quaternion_distribution(random_),
+                       R3Element<double>({quaternion_distribution(random_),
+                                          quaternion_distribution(random_),
+                                          quaternion_distribution(random_)}));
+    Rotation<World1, World2> const rotation(q / q.Norm());
+    auto& ai = a.emplace_back();
+    auto& bi = b.emplace_back();
+    auto& wi = weights.emplace_back();
+    // Few observations, some of them noisy, to exercise a variety of
+    // K matrices.
+    for (int j = 0; j < 2 + i % 5; ++j) {
+      auto const& vector1 = vectors1_[(7 * i + j) % vectors1_.size()];
+      Vector<double, World2> const vector2 =
+          rotation(vector1) +
+          Vector<double, World2>({perturbation_distribution(random_),
+                                  perturbation_distribution(random_),
+                                  perturbation_distribution(random_)});
+      ai.push_back(vector1);
+      bi.push_back(vector2 / vector2.Norm());
+      wi.push_back(weight_distribution(random_) * Metre);
+    }
+  }
+
+  auto const rotations = DavenportQMethod(a, b, weights);
+  ASSERT_EQ(a.size(), rotations.size());
+  for (int i = 0; i < a.size(); ++i) {
+    EXPECT_THAT(rotations[i],
+                AlmostEquals(DavenportQMethod(a[i], b[i], weights[i]),
+                             0, 4096)) << i;
+  }
+
+  // With a single observation the most positive eigenvalue is degenerate and
+  // we fall back to the eigensystem.  Any rotation mapping the observation
+  // correctly is acceptable.
+  Vector<double, World1> const x({1, 0, 0});
+  Vector<double, World2> const y({0, 1, 0});
+  auto const degenerate_rotations = DavenportQMethod(
+      std::vector<std::vector<Vector<double, World1>>>{{x}},
+      std::vector<std::vector<Vector<double, World2>>>{{y}},
+      std::vector<std::vector<Length>>{{1 * Metre}});
+  ASSERT_EQ(1, degenerate_rotations.size());
+  EXPECT_LT((degenerate_rotations[0](x) - y).Norm(), 1e-15);
+}
+
 }  // namespace numerics
 }  // namespace principia
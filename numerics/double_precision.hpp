@@ -27,7 +27,8 @@ struct DoublePrecision final {
   // Compensated summation.  This is less precise, but more efficient, than
   // |operator-=| or |operator+=|.  Unlike |QuickTwoSum|, these functions don't
   // DCHECK their argument, so the caller must ensure that |right| is small
-  // enough.
+  // enough.  They perform three additions and no multiplication, so they don't
+  // benefit from FMA; on |R3Element|-based types the additions are vectorized.
   DoublePrecision<T>& Decrement(Difference<T> const& right);
   DoublePrecision<T>& Increment(Difference<T> const& right);
 
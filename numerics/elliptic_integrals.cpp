@@ -6,6 +6,7 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "base/tags.hpp"
 #include "glog/logging.h"
@@ -54,6 +55,17 @@ using EnableIfAngleResult =
 template<typename T, typename = EnableIfAngleResult<T>>
 inline constexpr bool should_compute = !std::is_same_v<T, UnusedResult const>;
 
+// The complete integrals B(m), D(m), and J(n|m) only depend on the parameters,
+// so they may be shared by the evaluations of a batch of amplitudes.  They are
+// computed lazily, the first time that an amplitude needs them.
+template<typename ThirdKind>
+struct FukushimaCompleteIntegrals {
+  bool computed = false;
+  Angle B_m{uninitialized};
+  Angle D_m{uninitialized};
+  ThirdKind J_nǀm{uninitialized};
+};
+
 // Bulirsch's cel function, [Bul69], [OLBC10], 19.2(iii).
 Angle BulirschCel(double kc, double nc, double a, double b);
 
@@ -76,6 +88,16 @@ void FukushimaEllipticBDJ(double nc,
                           Angle& D_m,
                           ThirdKind& J_n_m);
 
+// Same as above, but obtains the integrals from |complete| if it is not null,
+// computing them there if needed.
+template<typename ThirdKind, typename = EnableIfAngleResult<ThirdKind>>
+void FukushimaEllipticBDJ(double nc,
+                          double mc,
+                          FukushimaCompleteIntegrals<ThirdKind>* complete,
+                          Angle& B_m,
+                          Angle& D_m,
+                          ThirdKind& J_n_m);
+
 // Computes Fukushima's incomplete integrals of the second kind and third kind
 // from the cosine of the amplitude: Bc(c|m) = B(arccos c|m),
 // Dc(c|m) = D(arccos c|m), Jc(c, n|m) = J(arccos c, n|m), where m = 1 - mc.
@@ -116,23 +138,40 @@ Angle FukushimaEllipticJsMaclaurinSeries(double y, double n, double m);
 Angle FukushimaT(double t, double h);
 
 // The common implementation underlying the functions |FukushimaEllipticBDJ| and
-// |FukushimaEllipticBD| declared in the header file.
+// |FukushimaEllipticBD| declared in the header file.  If |complete| is not
+// null, it must have been built for the same |n| and |mc|.
 template<typename ThirdKind, typename = EnableIfAngleResult<ThirdKind>>
-void FukushimaEllipticBDJ(Angle const& φ,
-                          double n,
-                          double mc,
-                          Angle& B_φǀm,
-                          Angle& D_φǀm,
-                          ThirdKind& J_φ_nǀm);
+void FukushimaEllipticBDJ(
+    Angle const& φ,
+    double n,
+    double mc,
+    Angle& B_φǀm,
+    Angle& D_φǀm,
+    ThirdKind& J_φ_nǀm,
+    FukushimaCompleteIntegrals<ThirdKind>* complete = nullptr);
 
 // Implementation of the B, D, J functions with all arguments reduced.
 template<typename ThirdKind, typename = EnableIfAngleResult<ThirdKind>>
-void FukushimaEllipticBDJReduced(Angle const& φ,
-                                 double n,
-                                 double mc,
-                                 Angle& B_φǀm,
-                                 Angle& D_φǀm,
-                                 ThirdKind& J_φ_nǀm);
+void FukushimaEllipticBDJReduced(
+    Angle const& φ,
+    double n,
+    double mc,
+    Angle& B_φǀm,
+    Angle& D_φǀm,
+    ThirdKind& J_φ_nǀm,
+    FukushimaCompleteIntegrals<ThirdKind>* complete);
+
+// The common implementation underlying the batch functions declared in the
+// header file.  Calls |store(i, B, D, J)| with the integrals for |φs[i]|.  The
+// complete integrals are shared by all the amplitudes when the parameters need
+// no reduction.
+template<typename ThirdKind,
+         typename Store,
+         typename = EnableIfAngleResult<ThirdKind>>
+void FukushimaEllipticBDJ(std::vector<Angle> const& φs,
+                          double n,
+                          double mc,
+                          Store const& store);
 
 // The common implementation underlying the functions |EllipticFEΠ| and
 // |EllipticFE| declared in the header file.
@@ -1356,6 +1395,29 @@ void FukushimaEllipticBDJ(double const nc,
   }
 }
 
+template<typename ThirdKind, typename>
+void FukushimaEllipticBDJ(double const nc,
+                          double const mc,
+                          FukushimaCompleteIntegrals<ThirdKind>* const complete,
+                          Angle& B_m,
+                          Angle& D_m,
+                          ThirdKind& J_n_m) {
+  if (complete == nullptr) {
+    FukushimaEllipticBDJ(nc, mc, B_m, D_m, J_n_m);
+    return;
+  }
+  if (!complete->computed) {
+    FukushimaEllipticBDJ(
+        nc, mc, complete->B_m, complete->D_m, complete->J_nǀm);
+    complete->computed = true;
+  }
+  B_m = complete->B_m;
+  D_m = complete->D_m;
+  if constexpr (should_compute<ThirdKind>) {
+    J_n_m = complete->J_nǀm;
+  }
+}
+
 // Note that the identifiers in the function definition are not the same as
 // those in the function declaration.
 // The declaration follows [Fuk11b], equations (9) and (10), and [Fuk12b],
@@ -1715,12 +1777,14 @@ Angle FukushimaT(double const t, double const h) {
 }
 
 template<typename ThirdKind, typename>
-void FukushimaEllipticBDJReduced(Angle const& φ,
-                                 double const n,
-                                 double const mc,
-                                 Angle& B_φǀm,
-                                 Angle& D_φǀm,
-                                 ThirdKind& J_φ_nǀm) {
+void FukushimaEllipticBDJReduced(
+    Angle const& φ,
+    double const n,
+    double const mc,
+    Angle& B_φǀm,
+    Angle& D_φǀm,
+    ThirdKind& J_φ_nǀm,
+    FukushimaCompleteIntegrals<ThirdKind>* const complete) {
   DCHECK_LE(φ, π/2 * Radian);
   DCHECK_GE(φ, 0 * Radian);
   if constexpr (should_compute<ThirdKind>) {
@@ -1764,7 +1828,7 @@ void FukushimaEllipticBDJReduced(Angle const& φ,
       Angle Ds{uninitialized};      // Ds(z|m).
       ThirdKind Js{uninitialized};  // Js(z, n|m).
       FukushimaEllipticBsDsJs(z, n, mc, Bs, Ds, Js);
-      FukushimaEllipticBDJ(nc, mc, B_m, D_m, J_nǀm);
+      FukushimaEllipticBDJ(nc, mc, complete, B_m, D_m, J_nǀm);
       double const sz = z * Sqrt(1.0 - c²);
       B_φǀm = B_m - (Bs - sz * Radian);
       D_φǀm = D_m - (Ds + sz * Radian);
@@ -1783,7 +1847,7 @@ void FukushimaEllipticBDJReduced(Angle const& φ,
         Angle Dc{uninitialized};      // Dc(w|m).
         ThirdKind Jc{uninitialized};  // Jc(w, n|m).
         FukushimaEllipticBcDcJc(Sqrt(mc * w²_over_mc), n, mc, Bc, Dc, Jc);
-        FukushimaEllipticBDJ(nc, mc, B_m, D_m, J_nǀm);
+        FukushimaEllipticBDJ(nc, mc, complete, B_m, D_m, J_nǀm);
         double const sz = c * Sqrt(w²_over_mc);
         B_φǀm = B_m - (Bc - sz * Radian);
         D_φǀm = D_m - (Dc + sz * Radian);
@@ -1797,12 +1861,14 @@ void FukushimaEllipticBDJReduced(Angle const& φ,
 }
 
 template<typename ThirdKind, typename>
-void FukushimaEllipticBDJ(Angle const& φ,
-                          double const n,
-                          double const mc,
-                          Angle& B_φǀm,
-                          Angle& D_φǀm,
-                          ThirdKind& J_φ_nǀm) {
+void FukushimaEllipticBDJ(
+    Angle const& φ,
+    double const n,
+    double const mc,
+    Angle& B_φǀm,
+    Angle& D_φǀm,
+    ThirdKind& J_φ_nǀm,
+    FukushimaCompleteIntegrals<ThirdKind>* const complete) {
   // See Appendix B of [Fuk11b] and Appendix A.1 of [Fuk12b] for argument
   // reduction.
 
@@ -1815,7 +1881,8 @@ void FukushimaEllipticBDJ(Angle const& φ,
     ReduceAngle<-π / 2, π / 2>(φ, φ_reduced, j);
     Angle const abs_φ_reduced = Abs(φ_reduced);
 
-    FukushimaEllipticBDJ(abs_φ_reduced, n, mc, B_φǀm, D_φǀm, J_φ_nǀm);
+    FukushimaEllipticBDJ(
+        abs_φ_reduced, n, mc, B_φǀm, D_φǀm, J_φ_nǀm, complete);
 
     if (φ_reduced < 0.0 * Radian) {
       // TODO(egg): Much ado about nothing's sign bit.
@@ -1831,7 +1898,7 @@ void FukushimaEllipticBDJ(Angle const& φ,
       Angle B_m{uninitialized};        // B(m).
       Angle D_m{uninitialized};        // D(m).
       ThirdKind J_nǀm{uninitialized};  // J(n|m).
-      FukushimaEllipticBDJ(nc, mc, B_m, D_m, J_nǀm);
+      FukushimaEllipticBDJ(nc, mc, complete, B_m, D_m, J_nǀm);
 
       // See [Fuk11b], equations (B.2), and [Fuk12b], equation (A.2).
       B_φǀm += 2 * j * B_m;
@@ -1934,7 +2001,29 @@ void FukushimaEllipticBDJ(Angle const& φ,
   }
 
   // No further reduction needed.
-  FukushimaEllipticBDJReduced(φ, n, mc, B_φǀm, D_φǀm, J_φ_nǀm);
+  FukushimaEllipticBDJReduced(φ, n, mc, B_φǀm, D_φǀm, J_φ_nǀm, complete);
+}
+
+template<typename ThirdKind, typename Store, typename>
+void FukushimaEllipticBDJ(std::vector<Angle> const& φs,
+                          double const n,
+                          double const mc,
+                          Store const& store) {
+  // The parameter reductions and the reductions of characteristics change |n|
+  // and |mc|, so the complete integrals may only be shared when none of them
+  // applies.  The amplitude reduction preserves the parameters.
+  bool const shareable = 0 <= mc && mc <= 1 &&
+                         (!should_compute<ThirdKind> || (0 <= n && n < 1));
+  FukushimaCompleteIntegrals<ThirdKind> complete;
+  for (int i = 0; i < φs.size(); ++i) {
+    Angle B{uninitialized};
+    Angle D{uninitialized};
+    ThirdKind J{uninitialized};
+    FukushimaEllipticBDJ(φs[i], n, mc,
+                         B, D, J,
+                         shareable ? &complete : nullptr);
+    store(i, B, D, J);
+  }
 }
 
 template<typename ThirdKind, typename>
@@ -2008,6 +2097,55 @@ void EllipticFEΠ(Angle const& φ,
   EllipticFEΠ<Angle>(φ, n, mc, F_φǀm, E_φǀm, Π_φ_nǀm);
 }
 
+void FukushimaEllipticBDJ(std::vector<Angle> const& φs,
+                          double const n,
+                          double const mc,
+                          std::vector<Angle>& B_φǀm,
+                          std::vector<Angle>& D_φǀm,
+                          std::vector<Angle>& J_φ_nǀm) {
+  B_φǀm.resize(φs.size());
+  D_φǀm.resize(φs.size());
+  J_φ_nǀm.resize(φs.size());
+  FukushimaEllipticBDJ<Angle>(
+      φs, n, mc,
+      [&B_φǀm, &D_φǀm, &J_φ_nǀm](
+          int const i, Angle const& B, Angle const& D, Angle const& J) {
+        B_φǀm[i] = B;
+        D_φǀm[i] = D;
+        J_φ_nǀm[i] = J;
+      });
+}
+
+std::vector<Angle> EllipticF(std::vector<Angle> const& φs, double const mc) {
+  std::vector<Angle> F_φǀm(φs.size());
+  FukushimaEllipticBDJ<UnusedResult const>(
+      φs, /*n=*/1, mc,
+      [&F_φǀm](int const i,
+               Angle const& B,
+               Angle const& D,
+               UnusedResult const& /*J*/) { F_φǀm[i] = B + D; });
+  return F_φǀm;
+}
+
+void EllipticFEΠ(std::vector<Angle> const& φs,
+                 double const n,
+                 double const mc,
+                 std::vector<Angle>& F_φǀm,
+                 std::vector<Angle>& E_φǀm,
+                 std::vector<Angle>& Π_φ_nǀm) {
+  F_φǀm.resize(φs.size());
+  E_φǀm.resize(φs.size());
+  Π_φ_nǀm.resize(φs.size());
+  FukushimaEllipticBDJ<Angle>(
+      φs, n, mc,
+      [mc, n, &F_φǀm, &E_φǀm, &Π_φ_nǀm](
+          int const i, Angle const& B, Angle const& D, Angle const& J) {
+        F_φǀm[i] = B + D;
+        E_φǀm[i] = B + mc * D;
+        Π_φ_nǀm[i] = F_φǀm[i] + n * J;
+      });
+}
+
 // Note that the identifiers in the function definition are not the same as
 // those in the function declaration.
 // The notation here follows [Fuk09a], whereas the notation in the function
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "quantities/quantities.hpp"
 
 namespace principia {
@@ -57,6 +59,25 @@ void EllipticFEΠ(Angle const& φ,
 // m = 1 - mc.
 Angle EllipticK(double mc);
 
+// Batch versions of the above functions, for amplitudes |φs| that share the
+// same |n| and |mc|.  The results are identical to those of the scalar
+// functions, but the complete integrals used by the argument reduction are
+// only computed once for the entire batch.  The output vectors are resized to
+// the size of |φs|.
+void FukushimaEllipticBDJ(std::vector<Angle> const& φs,
+                          double n,
+                          double mc,
+                          std::vector<Angle>& B_φǀm,
+                          std::vector<Angle>& D_φǀm,
+                          std::vector<Angle>& J_φ_nǀm);
+std::vector<Angle> EllipticF(std::vector<Angle> const& φs, double mc);
+void EllipticFEΠ(std::vector<Angle> const& φs,
+                 double n,
+                 double mc,
+                 std::vector<Angle>& F_φǀm,
+                 std::vector<Angle>& E_φǀm,
+                 std::vector<Angle>& Π_φ_nǀm);
+
 }  // namespace internal
 
 using internal::EllipticE;
@@ -186,5 +186,53 @@ TEST_F(EllipticIntegralsTest, MathematicaTrivariate) {
   }
 }
 
+TEST_F(EllipticIntegralsTest, Batch) {
+  // Amplitudes in all the regions of the selection rule, as well as amplitudes
+  // that need reduction.
+  std::vector<Angle> φs;
+  for (int i = -20; i <= 40; ++i) {
+    φs.push_back(i * 0.1 * Radian);
+  }
+
+  for (double const n : {0.0, 0.3, 0.9, 1.5, -0.4}) {
+    for (double const mc : {0.2, 0.7, 1.0, 1.6}) {
+      std::vector<Angle> bs;
+      std::vector<Angle> ds;
+      std::vector<Angle> js;
+      FukushimaEllipticBDJ(φs, n, mc, bs, ds, js);
+      std::vector<Angle> fs;
+      std::vector<Angle> es;
+      std::vector<Angle> ᴨs;
+      EllipticFEΠ(φs, n, mc, fs, es, ᴨs);
+      std::vector<Angle> const fs_only = EllipticF(φs, mc);
+      ASSERT_EQ(φs.size(), bs.size());
+      ASSERT_EQ(φs.size(), fs.size());
+      ASSERT_EQ(φs.size(), fs_only.size());
+
+      for (int i = 0; i < φs.size(); ++i) {
+        Angle b;
+        Angle d;
+        Angle j;
+        FukushimaEllipticBDJ(φs[i], n, mc, b, d, j);
+        Angle f;
+        Angle e;
+        Angle ᴨ;
+        EllipticFEΠ(φs[i], n, mc, f, e, ᴨ);
+
+        // The batch functions perform the same computations as the scalar
+        // ones, so the results are bit-for-bit identical.
+        EXPECT_EQ(b, bs[i]) << φs[i] << " " << n << " " << mc;
+        EXPECT_EQ(d, ds[i]) << φs[i] << " " << n << " " << mc;
+        EXPECT_EQ(j, js[i]) << φs[i] << " " << n << " " << mc;
+        EXPECT_EQ(f, fs[i]) << φs[i] << " " << n << " " << mc;
+        EXPECT_EQ(e, es[i]) << φs[i] << " " << n << " " << mc;
+        EXPECT_EQ(ᴨ, ᴨs[i]) << φs[i] << " " << n << " " << mc;
+        EXPECT_EQ(EllipticF(φs[i], mc), fs_only[i])
+            << φs[i] << " " << n << " " << mc;
+      }
+    }
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
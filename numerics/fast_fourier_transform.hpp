@@ -89,9 +89,91 @@ class FastFourierTransform {
   friend class numerics::FastFourierTransformTest;
 };
 
+template<typename Value, typename Argument>
+class RealFastFourierTransform;
+
+// The precomputed data for transforming real signals of a given size, which is
+// only known at runtime.  A plan may be shared by any number of
+// |RealFastFourierTransform| objects of the same size, irrespective of their
+// |Value| and |Argument|.
+class FastFourierTransformPlan {
+ public:
+  // The size must be a power of 2 greater than or equal to 2.
+  explicit FastFourierTransformPlan(int size);
+
+  int size() const;
+
+ private:
+  int const size_;
+  int const log2_half_size_;
+
+  // The twiddle factors e⁻²ⁱᵏᶿ, with θ = π / size_, for k ∈ [0, size_ / 2[.
+  std::vector<Complexification<double>> twiddles_;
+
+  template<typename Value, typename Argument>
+  friend class RealFastFourierTransform;
+};
+
+// Same as |FastFourierTransform|, but the size is given by a plan at runtime
+// and the values (u₀, ..., uₙ₋₁) are real.  The transform is computed by a
+// complex transform of size n / 2 on the pairs (u₂ᵣ, u₂ᵣ₊₁) using a radix-4
+// kernel, followed by a separation of the even and odd parts.  Since
+// Uₙ₋ₛ = Uₛ*, only the coefficients U₀, ..., Uₙ/₂ are stored.
+template<typename Value, typename Argument>
+class RealFastFourierTransform {
+ public:
+  using AngularFrequency = Derivative<Angle, Argument>;
+
+  // In the constructors, the container must have |plan.size()| elements.  For
+  // the purpose of expressing the frequencies, the values are assumed to be
+  // sampled at intervals of Δt.  No transfer of ownership of |plan|, which is
+  // only used during construction.
+
+  template<typename Container,
+           typename = std::enable_if_t<
+               std::is_convertible_v<typename Container::value_type, Value>>>
+  RealFastFourierTransform(FastFourierTransformPlan const& plan,
+                           Container const& container,
+                           Difference<Argument> const& Δt);
+
+  template<typename Iterator,
+           typename = std::enable_if_t<std::is_convertible_v<
+               typename std::iterator_traits<Iterator>::value_type,
+               Value>>>
+  RealFastFourierTransform(FastFourierTransformPlan const& plan,
+                           Iterator begin, Iterator end,
+                           Difference<Argument> const& Δt);
+
+  int size() const;
+
+  std::map<AngularFrequency, typename Hilbert<Value>::Norm²Type>
+  PowerSpectrum() const;
+
+  // Returns the interval that contains the largest peak of power in the
+  // specifed range.
+  Interval<AngularFrequency> Mode(AngularFrequency const& min_ω,
+                                  AngularFrequency const& max_ω) const;
+
+  // Given s ∈ [0, size - 1] ∩ ℕ, returns the coefficient Uₛ.
+  Complexification<Value> operator[](int s) const;
+
+  // Given s ∈ [0, size - 1] ∩ ℕ, returns the frequency corresponding to Uₛ.
+  AngularFrequency frequency(int s) const;
+
+ private:
+  int const size_;
+  Difference<Argument> const Δt_;
+  AngularFrequency const Δω_;
+
+  // The coefficients U₀, ..., Uₙ/₂, spaced in frequency by ω_.
+  std::vector<Complexification<Value>> transform_;
+};
+
 }  // namespace internal
 
 using internal::FastFourierTransform;
+using internal::FastFourierTransformPlan;
+using internal::RealFastFourierTransform;
 
 }  // namespace _fast_fourier_transform
 }  // namespace numerics
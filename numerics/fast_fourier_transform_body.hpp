@@ -2,8 +2,10 @@
 
 #include "numerics/fast_fourier_transform.hpp"
 
+#include <algorithm>
 #include <map>
 #include <optional>
+#include <vector>
 
 #include "quantities/elementary_functions.hpp"
 #include "quantities/si.hpp"
@@ -108,6 +110,65 @@ void DanielsonLánczos<Complex, array_size_, 4>::Transform(
   }
 }
 
+// An iterative decimation-in-time transform of the |z.size()| elements of |z|,
+// which must be in bit-reversed order, and where |z.size()| is 2^|log2_size|.
+// Pairs of radix-2 stages are fused into radix-4 (radix-2²) butterflies, which
+// need 3 complex multiplications for 4 elements instead of 4 and make half as
+// many passes over the data.  |twiddles| must contain e⁻²ⁱᵏᶿ, with
+// θ = π / (2 * z.size()), for k ∈ [0, z.size()[.
+template<typename Complex>
+void Radix4Transform(
+    int const log2_size,
+    std::vector<Complexification<double>> const& twiddles,
+    std::vector<Complex>& z) {
+  int const m = z.size();
+  int const n = 2 * m;
+
+  // The size of the blocks that have already been transformed.
+  int q = 1;
+  if (log2_size % 2 == 1) {
+    for (int i = 0; i < m; i += 2) {
+      auto const t = z[i + 1];
+      z[i + 1] = z[i] - t;
+      z[i] += t;
+    }
+    q = 2;
+  }
+
+  for (; 4 * q <= m; q *= 4) {
+    // The twiddle e⁻²ⁱʲᶿ with θ = π / (4 * q) has index j * stride.
+    int const stride = n / (4 * q);
+    for (int start = 0; start < m; start += 4 * q) {
+      for (int j = 0; j < q; ++j) {
+        Complexification<double> const& w₁ = twiddles[2 * j * stride];
+        Complexification<double> const& w₂ = twiddles[j * stride];
+        Complex& a = z[start + j];
+        Complex& b = z[start + j + q];
+        Complex& c = z[start + j + 2 * q];
+        Complex& d = z[start + j + 3 * q];
+
+        // First radix-2 stage, on blocks of size 2q.
+        auto const tb = b * w₁;
+        auto const td = d * w₁;
+        auto const a₁ = a + tb;
+        auto const b₁ = a - tb;
+        auto const c₁ = c + td;
+        auto const d₁ = c - td;
+
+        // Second radix-2 stage, on blocks of size 4q.  The twiddle for |d₁|
+        // is -i w₂.
+        auto const u = c₁ * w₂;
+        auto const v_times_i = d₁ * w₂;
+        Complex const v(v_times_i.imaginary_part(), -v_times_i.real_part());
+        a = a₁ + u;
+        c = a₁ - u;
+        b = b₁ + v;
+        d = b₁ - v;
+      }
+    }
+  }
+}
+
 template<typename Value, typename Argument, std::size_t size_>
 template<typename Container, typename>
 FastFourierTransform<Value, Argument, size_>::FastFourierTransform(
@@ -206,6 +267,146 @@ FastFourierTransform<Value, Argument, size_>::frequency(int const s) const {
   return s * Δω_;
 }
 
+inline FastFourierTransformPlan::FastFourierTransformPlan(int const size)
+    : size_(size),
+      log2_half_size_(FloorLog2(size / 2)) {
+  CHECK_LE(2, size_);
+  CHECK_EQ(size_, 2 << log2_half_size_);
+  twiddles_.reserve(size_ / 2);
+  for (int k = 0; k < size_ / 2; ++k) {
+    // Each twiddle is computed directly to avoid accumulating errors.
+    Angle const kθ = k * π * Radian / size_;
+    twiddles_.emplace_back(Cos(2 * kθ), -Sin(2 * kθ));
+  }
+}
+
+inline int FastFourierTransformPlan::size() const {
+  return size_;
+}
+
+template<typename Value, typename Argument>
+template<typename Container, typename>
+RealFastFourierTransform<Value, Argument>::RealFastFourierTransform(
+    FastFourierTransformPlan const& plan,
+    Container const& container,
+    Difference<Argument> const& Δt)
+    : RealFastFourierTransform(plan, container.cbegin(), container.cend(), Δt) {
+}
+
+template<typename Value, typename Argument>
+template<typename Iterator, typename>
+RealFastFourierTransform<Value, Argument>::RealFastFourierTransform(
+    FastFourierTransformPlan const& plan,
+    Iterator const begin,
+    Iterator const end,
+    Difference<Argument> const& Δt)
+    : size_(plan.size()),
+      Δt_(Δt),
+      Δω_(2 * π * Radian / (size_ * Δt_)) {
+  DCHECK_EQ(size_, std::distance(begin, end));
+  int const m = size_ / 2;
+
+  // Reindexing and packing of the pairs (u₂ᵣ, u₂ᵣ₊₁) as complex numbers.  The
+  // extra element is for Uₙ/₂.
+  transform_.resize(m + 1);
+  int bit_reversed_index = 0;
+  for (auto it = begin;
+       it != end;
+       bit_reversed_index = BitReversedIncrement(bit_reversed_index,
+                                                 plan.log2_half_size_)) {
+    Value const even = *it;
+    ++it;
+    Value const odd = *it;
+    ++it;
+    transform_[bit_reversed_index] = Complexification<Value>(even, odd);
+  }
+  transform_.pop_back();
+
+  Radix4Transform(plan.log2_half_size_, plan.twiddles_, transform_);
+  transform_.emplace_back();
+
+  // Separation of the transforms Eₛ and Oₛ of the even and odd values from the
+  // transform Zₛ of the pairs: Eₛ = (Zₛ + Zₘ₋ₛ*) / 2, Oₛ = (Zₛ - Zₘ₋ₛ*) / 2i,
+  // and Uₛ = Eₛ + e⁻²ⁱˢᶿ Oₛ.  Since Eₘ₋ₛ = Eₛ* and Oₘ₋ₛ = Oₛ*, we have
+  // Uₘ₋ₛ = (Eₛ - e⁻²ⁱˢᶿ Oₛ)*, so the coefficients are computed in pairs.
+  Complexification<double> const minus_i_over_2(0, -0.5);
+  for (int s = 1; 2 * s <= m; ++s) {
+    auto const z = transform_[s];
+    auto const z_conjugate = transform_[m - s].Conjugate();
+    auto const e = (z + z_conjugate) * 0.5;
+    auto const o = (z - z_conjugate) * minus_i_over_2;
+    auto const twiddled_o = o * plan.twiddles_[s];
+    transform_[s] = e + twiddled_o;
+    if (s != m - s) {
+      transform_[m - s] = (e - twiddled_o).Conjugate();
+    }
+  }
+  Value const e₀ = transform_[0].real_part();
+  Value const o₀ = transform_[0].imaginary_part();
+  transform_[0] = e₀ + o₀;
+  transform_[m] = e₀ - o₀;
+}
+
+template<typename Value, typename Argument>
+int RealFastFourierTransform<Value, Argument>::size() const {
+  return size_;
+}
+
+template<typename Value, typename Argument>
+auto RealFastFourierTransform<Value, Argument>::PowerSpectrum() const
+    -> std::map<AngularFrequency, typename Hilbert<Value>::Norm²Type> {
+  std::map<AngularFrequency, typename Hilbert<Value>::Norm²Type>
+      spectrum;
+  for (int k = 0; k < size_; ++k) {
+    spectrum.emplace_hint(spectrum.end(),
+                          k * Δω_,
+                          transform_[std::min(k, size_ - k)].Norm²());
+  }
+  return spectrum;
+}
+
+template<typename Value, typename Argument>
+auto RealFastFourierTransform<Value, Argument>::Mode(
+    AngularFrequency const& min_ω,
+    AngularFrequency const& max_ω) const -> Interval<AngularFrequency> {
+  CHECK_LE(min_ω, max_ω);
+  std::optional<int> max;
+  typename Hilbert<Value>::Norm²Type max_power;
+
+  // Only look at the stored coefficients because the spectrum is symmetrical.
+  int const stored_size = transform_.size();
+  for (int k = 0; k < stored_size; ++k) {
+    AngularFrequency const ω = k * Δω_;
+    auto const power = transform_[k].Norm²();
+    if (min_ω <= ω && ω <= max_ω && (!max.has_value() || power > max_power)) {
+      max = k;
+      max_power = power;
+    }
+  }
+  CHECK(max.has_value()) << min_ω << " " << max_ω;
+
+  Interval<AngularFrequency> result;
+  result.Include(std::max(*max - 1, 0) * Δω_);
+  result.Include((*max + 1) * Δω_);
+  return result;
+}
+
+template<typename Value, typename Argument>
+Complexification<Value> RealFastFourierTransform<Value, Argument>::operator[](
+    int const s) const {
+  DCHECK_GE(s, 0);
+  DCHECK_LT(s, size_);
+  return 2 * s <= size_ ? transform_[s] : transform_[size_ - s].Conjugate();
+}
+
+template<typename Value, typename Argument>
+auto RealFastFourierTransform<Value, Argument>::frequency(int const s) const
+    -> AngularFrequency {
+  DCHECK_GE(s, 0);
+  DCHECK_LT(s, size_);
+  return s * Δω_;
+}
+
 }  // namespace internal
 }  // namespace _fast_fourier_transform
 }  // namespace numerics
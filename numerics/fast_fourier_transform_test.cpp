@@ -215,6 +215,84 @@ TEST_F(FastFourierTransformTest, Vector) {
   }
 }
 
+TEST_F(FastFourierTransformTest, RealSquare) {
+  FastFourierTransformPlan const plan(8);
+  RealFastFourierTransform<double, Instant> const transform(
+      plan, std::vector<double>{1, 1, 1, 1, 0, 0, 0, 0}, 1 * Second);
+  EXPECT_EQ(8, transform.size());
+  EXPECT_THAT(transform[0], AlmostEquals(Complex{4}, 0));
+  EXPECT_THAT(transform[1], AlmostEquals(Complex{1, -1 - Sqrt(2)}, 0, 2));
+  EXPECT_THAT(transform[2], AlmostEquals(Complex{0}, 0));
+  EXPECT_THAT(transform[3], AlmostEquals(Complex{1, 1 - Sqrt(2)}, 0, 8));
+  EXPECT_THAT(transform[4], AlmostEquals(Complex{0}, 0));
+  EXPECT_THAT(transform[5], AlmostEquals(Complex{1, Sqrt(2) - 1}, 0, 8));
+  EXPECT_THAT(transform[6], AlmostEquals(Complex{0}, 0));
+  EXPECT_THAT(transform[7], AlmostEquals(Complex{1, 1 + Sqrt(2)}, 0, 2));
+}
+
+TEST_F(FastFourierTransformTest, RealMatchesComplex) {
+  // Odd and even powers of 2 exercise the leading radix-2 stage and the pure
+  // radix-4 passes, respectively.
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1, 1);
+  std::array<double, 128> signal;
+  for (auto& value : signal) {
+    value = distribution(random);
+  }
+  FastFourierTransform<double, Instant, 128> const complex_transform(
+      signal, 1 * Second);
+  FastFourierTransform<double, Instant, 64> const complex_half_transform(
+      signal.cbegin(), signal.cbegin() + 64, 1 * Second);
+
+  FastFourierTransformPlan const plan(128);
+  RealFastFourierTransform<double, Instant> const real_transform(
+      plan, signal, 1 * Second);
+  FastFourierTransformPlan const half_plan(64);
+  RealFastFourierTransform<double, Instant> const real_half_transform(
+      half_plan, signal.cbegin(), signal.cbegin() + 64, 1 * Second);
+
+  for (int s = 0; s < 128; ++s) {
+    EXPECT_THAT((real_transform[s] - complex_transform[s]).Norm²(),
+                Lt(1e-24)) << s;
+    EXPECT_EQ(complex_transform.frequency(s), real_transform.frequency(s));
+  }
+  for (int s = 0; s < 64; ++s) {
+    EXPECT_THAT((real_half_transform[s] - complex_half_transform[s]).Norm²(),
+                Lt(1e-24)) << s;
+  }
+}
+
+TEST_F(FastFourierTransformTest, RealVector) {
+  int const size = 1 << 16;
+  AngularFrequency const ω = 666 * π / size * Radian / Second;
+  Time const Δt = 1 * Second;
+  std::vector<Displacement<World>> signal;
+  for (int n = 0; n < size; ++n) {
+    signal.push_back(Displacement<World>({Sin(n * ω * Δt) * Metre,
+                                          Cos(n * ω * Δt) * Metre,
+                                          Sin(2 * n * ω * Δt) * Metre}));
+  }
+
+  FastFourierTransformPlan const plan(size);
+  RealFastFourierTransform<Displacement<World>, Instant> const transform(
+      plan, signal, Δt);
+  EXPECT_EQ(size, transform.PowerSpectrum().size());
+
+  {
+    auto const mode =
+        transform.Mode(AngularFrequency{}, Infinity<AngularFrequency>);
+    EXPECT_THAT(mode.midpoint(), AlmostEquals(ω, 0));
+    EXPECT_THAT(mode.measure(),
+                AlmostEquals(4 * π / size * Radian / Second, 24));
+  }
+  {
+    auto const mode = transform.Mode(0.99 * ω, 1.01 * ω);
+    EXPECT_THAT(mode.midpoint(), AlmostEquals(ω, 0));
+    EXPECT_THAT(mode.measure(),
+                AlmostEquals(4 * π / size * Radian / Second, 24));
+  }
+}
+
 TEST_F(FastFourierTransformTest, Inverse) {
   constexpr int n = 4;
   constexpr Time Δt = 1 * Second;
@@ -4,7 +4,9 @@
 
 #include <cmath>
 #include <cstdint>
+#include <vector>
 
+#include "base/macros.hpp"  // 🧙 For PRINCIPIA_USE_SSE3_INTRINSICS.
 #include "numerics/polynomial_evaluators.hpp"
 #include "numerics/polynomial_in_monomial_basis.hpp"
 
@@ -53,7 +55,7 @@ struct Decomposition {
 
 Decomposition Decompose(double const x) {
   Decomposition decomposition;
-#if PRINCIPIA_USE_SSE3_INTRINSICS
+#if PRINCIPIA_USE_SSE3_INTRINSICS()
   __m128d const x_128d = _mm_set_sd(x);
   decomposition.integer_part = _mm_cvtsd_si64(x_128d);
   decomposition.fractional_part = _mm_cvtsd_f64(
@@ -66,9 +68,12 @@ Decomposition Decompose(double const x) {
   return decomposition;
 }
 
-}  // namespace
-
-void FastSinCos2π(double const cycles, double& sin, double& cos) {
+// Computes the sine |s| and cosine |c| of the reduced angle, and the |quadrant|
+// in which they must be placed.
+void SinCosInQuadrant(double const cycles,
+                      double& s,
+                      double& c,
+                      std::int64_t& quadrant) {
   // Argument reduction.
   // - quadrant goes from 0 to 3, with 0 indicating the principal quadrant and
   //   the others numbered in the trigonometric direction;
@@ -80,13 +85,22 @@ void FastSinCos2π(double const cycles, double& sin, double& cos) {
   double const y = decomposition.fractional_part;
   double const y² = y * y;
   double const y³ = y² * y;
-  std::int64_t const quadrant = decomposition.integer_part & 0b11;
+  quadrant = decomposition.integer_part & 0b11;
 
   // The custom evaluation, compared to Estrin followed by multiplication by the
   // argument, i.e., y * (s₁ + s₃ * y² + s₅ * (y² * y²)), avoids having a
   // multiplication by y at the end.
-  double const s = s₁ * y + (s₃ + s₅ * y²) * y³;
-  double const c = cos_polynomial(y²);
+  s = s₁ * y + (s₃ + s₅ * y²) * y³;
+  c = cos_polynomial(y²);
+}
+
+}  // namespace
+
+void FastSinCos2π(double const cycles, double& sin, double& cos) {
+  double s;
+  double c;
+  std::int64_t quadrant;
+  SinCosInQuadrant(cycles, s, c, quadrant);
 
   switch (quadrant) {
     case 0:
@@ -108,6 +122,27 @@ void FastSinCos2π(double const cycles, double& sin, double& cos) {
   }
 }
 
+void FastSinCos2π(std::vector<double> const& cycles,
+                  std::vector<double>& sin,
+                  std::vector<double>& cos) {
+  sin.resize(cycles.size());
+  cos.resize(cycles.size());
+  for (int i = 0; i < cycles.size(); ++i) {
+    double s;
+    double c;
+    std::int64_t quadrant;
+    SinCosInQuadrant(cycles[i], s, c, quadrant);
+
+    // In the odd quadrants the lines are exchanged, and in the quadrants 2 and
+    // 3 they are negated.  Written as selections, which compile to conditional
+    // moves, this avoids the mispredictions of the |switch| above.
+    bool const odd = (quadrant & 0b01) != 0;
+    double const sign = (quadrant & 0b10) != 0 ? -1.0 : 1.0;
+    sin[i] = sign * (odd ? c : s);
+    cos[i] = sign * (odd ? -s : c);
+  }
+}
+
 }  // namespace internal
 }  // namespace _fast_sin_cos_2π
 }  // namespace numerics
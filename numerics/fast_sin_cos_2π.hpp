@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 namespace principia {
 namespace numerics {
 namespace _fast_sin_cos_2π {
@@ -10,6 +12,14 @@ namespace internal {
 // cycles.  The argument must be in the range of the 64-bit integers.
 void FastSinCos2π(double cycles, double& sin, double& cos);
 
+// Same as above, for all the elements of |cycles|.  The results are identical
+// to those of the scalar function, but the selection of the quadrant is
+// branch-free, so this function favours throughput when the arguments are
+// unpredictable.  |sin| and |cos| are resized to the size of |cycles|.
+void FastSinCos2π(std::vector<double> const& cycles,
+                  std::vector<double>& sin,
+                  std::vector<double>& cos);
+
 }  // namespace internal
 
 using internal::FastSinCos2π;
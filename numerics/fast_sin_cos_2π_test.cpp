@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <random>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
@@ -142,5 +143,28 @@ TEST_F(FastSinCos2πTest, Monotonicity) {
   EXPECT_LT(max_cos_error, 4e-16);
 }
 
+// Check that the vector function agrees exactly with the scalar one, in all the
+// quadrants.
+TEST_F(FastSinCos2πTest, Vector) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1e3, 1e3);
+  std::vector<double> cycles = {0.0, 0.25, 0.5, 0.75, 1.0, -0.25};
+  for (int i = 0; i < 1000; ++i) {
+    cycles.push_back(distribution(random));
+  }
+  std::vector<double> sins;
+  std::vector<double> coss;
+  FastSinCos2π(cycles, sins, coss);
+  ASSERT_EQ(cycles.size(), sins.size());
+  ASSERT_EQ(cycles.size(), coss.size());
+  for (int i = 0; i < cycles.size(); ++i) {
+    double sin;
+    double cos;
+    FastSinCos2π(cycles[i], sin, cos);
+    EXPECT_THAT(sins[i], AlmostEquals(sin, 0)) << cycles[i];
+    EXPECT_THAT(coss[i], AlmostEquals(cos, 0)) << cycles[i];
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -1,6 +1,9 @@
 #pragma once
 
-#include <list>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
 
 #include "absl/status/statusor.h"
 #include "geometry/hilbert.hpp"
@@ -25,8 +28,15 @@ using namespace principia::quantities::_named_quantities;
 // not all of |samples| is fitted maximally.  This function further guarantees
 // that the |Hermite3| interpolation of (*itᵣ, *(samples.end() - 1)) fits
 // |samples| within |tolerance|.
+// If |max_number_of_fits| is given, the search stops after that many
+// iterators have been found, and the last guarantee above does not hold.  The
+// caller may resume the fit by calling this function again on the samples
+// starting at itᵣ.
+// The samples are processed in a single forward pass, and finding itᵢ costs
+// O((itᵢ - itᵢ₋₁) log (itᵢ - itᵢ₋₁)) sample evaluations, independently of the
+// number of samples after itᵢ.
 template<typename Argument, typename Value, typename Samples>
-absl::StatusOr<std::list<typename Samples::const_iterator>> FitHermiteSpline(
+absl::StatusOr<std::vector<typename Samples::const_iterator>> FitHermiteSpline(
     Samples const& samples,
     std::function<Argument const&(typename Samples::value_type const&)> const&
         get_argument,
@@ -34,7 +44,8 @@ absl::StatusOr<std::list<typename Samples::const_iterator>> FitHermiteSpline(
         get_value,
     std::function<Derivative<Value, Argument> const&(
         typename Samples::value_type const&)> const& get_derivative,
-    typename Hilbert<Difference<Value>>::NormType const& tolerance);
+    typename Hilbert<Difference<Value>>::NormType const& tolerance,
+    std::optional<std::int64_t> max_number_of_fits = std::nullopt);
 
 }  // namespace internal
 
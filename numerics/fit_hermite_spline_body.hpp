@@ -1,7 +1,8 @@
 #pragma once
 
-#include <list>
+#include <cstdint>
 #include <type_traits>
+#include <vector>
 
 #include "base/jthread.hpp"  // 🧙 For RETURN_IF_STOPPED.
 #include "base/ranges.hpp"
@@ -16,7 +17,7 @@ using namespace principia::base::_ranges;
 using namespace principia::numerics::_hermite3;
 
 template<typename Argument, typename Value, typename Samples>
-absl::StatusOr<std::list<typename Samples::const_iterator>> FitHermiteSpline(
+absl::StatusOr<std::vector<typename Samples::const_iterator>> FitHermiteSpline(
     Samples const& samples,
     std::function<Argument const&(typename Samples::value_type const&)> const&
         get_argument,
@@ -24,7 +25,8 @@ absl::StatusOr<std::list<typename Samples::const_iterator>> FitHermiteSpline(
         get_value,
     std::function<Derivative<Value, Argument> const&(
         typename Samples::value_type const&)> const& get_derivative,
-    typename Hilbert<Difference<Value>>::NormType const& tolerance) {
+    typename Hilbert<Difference<Value>>::NormType const& tolerance,
+    std::optional<std::int64_t> const max_number_of_fits) {
   using Iterator = typename Samples::const_iterator;
 
   auto interpolation_error_is_within_tolerance =
@@ -38,7 +40,7 @@ absl::StatusOr<std::list<typename Samples::const_iterator>> FitHermiteSpline(
                 Range(begin, last + 1), get_argument, get_value, tolerance);
       };
 
-  std::list<Iterator> fit;
+  std::vector<Iterator> fit;
   if (samples.size() < 3) {
     // With 0 or 1 points there is nothing to interpolate, with 2 we cannot
     // estimate the error.
@@ -48,7 +50,8 @@ absl::StatusOr<std::list<typename Samples::const_iterator>> FitHermiteSpline(
   Iterator begin = samples.begin();
   Iterator const last = samples.end() - 1;
   while (last - begin + 1 >= 3 &&
-         !interpolation_error_is_within_tolerance(begin, last)) {
+         (!max_number_of_fits.has_value() ||
+          fit.size() < *max_number_of_fits)) {
     // Look for a cubic that fits the beginning within |tolerance| and
     // such the cubic fitting one more sample would not fit the samples within
     // |tolerance|.
@@ -56,10 +59,30 @@ absl::StatusOr<std::list<typename Samples::const_iterator>> FitHermiteSpline(
     // ideally we would like to find the longest one, but this would be costly,
     // and we do not expect significant gains from this in practice.
 
-    // Invariant: The Hermite interpolant on [begin, lower] is below the
-    // tolerance, the Hermite interpolant on [begin, upper] is above.
+    // Exponential search for an |upper| such that the Hermite interpolant on
+    // [begin, upper] is above the tolerance.  Throughout, the Hermite
+    // interpolant on [begin, lower] is below the tolerance.
     Iterator lower = begin + 1;
-    Iterator upper = last;
+    Iterator upper;
+    bool fits_until_last = false;
+    for (std::int64_t step = 1;; step *= 2) {
+      RETURN_IF_STOPPED;
+      upper = last - lower > step ? lower + step : last;
+      if (!interpolation_error_is_within_tolerance(begin, upper)) {
+        break;
+      }
+      if (upper == last) {
+        fits_until_last = true;
+        break;
+      }
+      lower = upper;
+    }
+    if (fits_until_last) {
+      break;
+    }
+
+    // Binary search.  Invariant: The Hermite interpolant on [begin, lower] is
+    // below the tolerance, the Hermite interpolant on [begin, upper] is above.
     for (;;) {
       RETURN_IF_STOPPED;
       auto const middle = lower + (upper - lower) / 2;
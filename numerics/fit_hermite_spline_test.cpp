@@ -1,6 +1,7 @@
 #include "numerics/fit_hermite_spline.hpp"
 
-#include <list>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 #include "base/ranges.hpp"
@@ -20,7 +21,9 @@ namespace principia {
 namespace numerics {
 
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::Eq;
+using ::testing::Le;
 using ::testing::ResultOf;
 using namespace principia::base::_ranges;
 using namespace principia::geometry::_instant;
@@ -64,7 +67,7 @@ TEST_F(FitHermiteSplineTest, Sinusoid) {
       samples.push_back({t.value, f(t.value), df(t.value)});
     }
   }
-  std::list<std::vector<Sample>::const_iterator> const interpolation_points =
+  std::vector<std::vector<Sample>::const_iterator> const interpolation_points =
       FitHermiteSpline<Instant, Length>(
           samples,
           [](auto&& sample) -> auto&& { return sample.t; },
@@ -113,6 +116,55 @@ TEST_F(FitHermiteSplineTest, Sinusoid) {
               IsNear(107_(1) * Nano(Metre)));
 }
 
+TEST_F(FitHermiteSplineTest, Resumption) {
+  AngularFrequency const ω = 1 * Radian / Second;
+  auto const f = [ω, this](Instant const& t) {
+    return Cos(ω * (t - t0_)) * Metre;
+  };
+  auto const df = [ω, this](Instant const& t) {
+    return -ω * Sin(ω *(t - t0_)) * Metre / Radian;
+  };
+  std::vector<Sample> samples;
+  {
+    auto t = DoublePrecision<Instant>(t0_);
+    for (; t.value < t0_ + π * Second; t.Increment(20 * Milli(Second))) {
+      samples.push_back({t.value, f(t.value), df(t.value)});
+    }
+  }
+  auto const fit = [](std::vector<Sample> const& samples,
+                      std::optional<std::int64_t> const max_number_of_fits) {
+    return FitHermiteSpline<Instant, Length>(
+               samples,
+               [](auto&& sample) -> auto&& { return sample.t; },
+               [](auto&& sample) -> auto&& { return sample.x; },
+               [](auto&& sample) -> auto&& { return sample.v; },
+               10 * Micro(Metre),
+               max_number_of_fits).value();
+  };
+
+  auto const all_points = fit(samples, std::nullopt);
+  ASSERT_THAT(all_points.size(), Eq(10));
+
+  // Fitting one polynomial at a time and resuming from the last point yields
+  // the same result.
+  std::vector<Instant> resumed_times;
+  std::vector<Sample> remaining_samples = samples;
+  for (;;) {
+    auto const points = fit(remaining_samples, 1);
+    EXPECT_THAT(points.size(), Le(1));
+    if (points.empty()) {
+      break;
+    }
+    resumed_times.push_back(points.front()->t);
+    remaining_samples.erase(remaining_samples.cbegin(), points.front());
+  }
+  std::vector<Instant> all_times;
+  for (auto const it : all_points) {
+    all_times.push_back(it->t);
+  }
+  EXPECT_THAT(resumed_times, ElementsAreArray(all_times));
+}
+
 #if PRINCIPIA_MUST_ALWAYS_DOWNSAMPLE
 TEST_F(FitHermiteSplineDeathTest, NoDownsampling) {
   AngularFrequency const ω = 1 * Radian / Second;
@@ -142,7 +194,7 @@ TEST_F(FitHermiteSplineDeathTest, NoDownsampling) {
   };
 
   EXPECT_DEATH({
-    std::list<std::vector<Sample>::const_iterator> const
+    std::vector<std::vector<Sample>::const_iterator> const
         interpolation_points = fit_hermite_spline();
   }, "tail.size.*samples.size");
 }
@@ -657,11 +657,16 @@ template<typename LScalar, typename RScalar,
 constexpr FixedMatrix<Product<LScalar, RScalar>, rows, columns>
 operator*(FixedMatrix<LScalar, rows, dimension> const& left,
           FixedMatrix<RScalar, dimension, columns> const& right) {
+  // The loops are ordered so that the innermost one runs along the rows of
+  // |right| and |result|, which are contiguous and may be vectorized.  Each
+  // entry of the result still accumulates its terms in increasing order of
+  // |k|, so the result is the same as with the textbook order of the loops.
   FixedMatrix<Product<LScalar, RScalar>, rows, columns> result{};
-  for (int i = 0; i < left.rows(); ++i) {
-    for (int j = 0; j < right.columns(); ++j) {
-      for (int k = 0; k < left.columns(); ++k) {
-        result(i, j) += left(i, k) * right(k, j);
+  for (int i = 0; i < rows; ++i) {
+    for (int k = 0; k < dimension; ++k) {
+      LScalar const& left_ik = left(i, k);
+      for (int j = 0; j < columns; ++j) {
+        result(i, j) += left_ik * right(k, j);
       }
     }
   }
@@ -687,11 +692,14 @@ template<typename LScalar, typename RScalar, int rows, int columns>
 constexpr FixedVector<Product<LScalar, RScalar>, columns> operator*(
     TransposedView<FixedMatrix<LScalar, rows, columns>> const& left,
     FixedVector<RScalar, rows> const& right) {
+  // Traverse the rows of the matrix, which are contiguous, in the outer loop.
+  // Each entry of the result accumulates its terms in increasing order of |i|,
+  // as it would with a traversal by column.
   std::array<Product<LScalar, RScalar>, columns> result{};
-  for (int j = 0; j < columns; ++j) {
-    auto& result_j = result[j];
-    for (int i = 0; i < rows; ++i) {
-      result_j += left.transpose(i, j) * right[i];
+  for (int i = 0; i < rows; ++i) {
+    RScalar const& right_i = right[i];
+    for (int j = 0; j < columns; ++j) {
+      result[j] += left.transpose(i, j) * right_i;
     }
   }
   return FixedVector<Product<LScalar, RScalar>, columns>(std::move(result));
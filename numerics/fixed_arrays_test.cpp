@@ -1,5 +1,8 @@
 #include "numerics/fixed_arrays.hpp"
 
+#include <random>
+
+#include "base/tags.hpp"
 #include "gtest/gtest.h"
 #include "numerics/transposed_view.hpp"
 #include "quantities/elementary_functions.hpp"
@@ -7,6 +10,7 @@
 namespace principia {
 namespace numerics {
 
+using namespace principia::base::_tags;
 using namespace principia::numerics::_fixed_arrays;
 using namespace principia::numerics::_transposed_view;
 using namespace principia::quantities::_elementary_functions;
@@ -134,6 +138,47 @@ TEST_F(FixedArraysTest, Algebra) {
             TransposedView{m34_} * v3_);  // NOLINT
 }
 
+// Check that the products give the same results, bit for bit, as the textbook
+// loops.
+TEST_F(FixedArraysTest, ProductsOrderOfSummation) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1.0, 1.0);
+  FixedMatrix<double, 18, 9> m(uninitialized);
+  FixedMatrix<double, 9, 7> n(uninitialized);
+  FixedVector<double, 18> v(uninitialized);
+  for (int i = 0; i < 18; ++i) {
+    for (int j = 0; j < 9; ++j) {
+      m(i, j) = distribution(random);
+    }
+    v[i] = distribution(random);
+  }
+  for (int i = 0; i < 9; ++i) {
+    for (int j = 0; j < 7; ++j) {
+      n(i, j) = distribution(random);
+    }
+  }
+
+  auto const mn = m * n;
+  for (int i = 0; i < 18; ++i) {
+    for (int j = 0; j < 7; ++j) {
+      double expected = 0;
+      for (int k = 0; k < 9; ++k) {
+        expected += m(i, k) * n(k, j);
+      }
+      EXPECT_EQ(expected, mn(i, j));
+    }
+  }
+
+  auto const ᵗmv = TransposedView{m} * v;  // NOLINT
+  for (int j = 0; j < 9; ++j) {
+    double expected = 0;
+    for (int i = 0; i < 18; ++i) {
+      expected += m(i, j) * v[i];
+    }
+    EXPECT_EQ(expected, ᵗmv[j]);
+  }
+}
+
 TEST_F(FixedArraysTest, VectorIndexing) {
   EXPECT_EQ(31, v3_[1]);
   v3_[2] = -666;
@@ -3,12 +3,16 @@
 #include "numerics/frequency_analysis.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <future>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "base/tags.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/hilbert.hpp"
 #include "numerics/matrix_computations.hpp"
@@ -30,6 +34,7 @@ namespace internal {
 #define PRINCIPIA_USE_R 1
 
 using namespace principia::base::_tags;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_hilbert;
 using namespace principia::numerics::_matrix_computations;
@@ -69,11 +74,45 @@ int MakeBasis(std::optional<AngularFrequency> const& ω,
   }
 }
 
+// Partitions the indices [m_begin, m_end[ into groups such that the elements of
+// |subspaces| at indices in different groups are orthogonal.  Within a group
+// the indices are in increasing order.
+inline std::vector<std::vector<int>> OrthogonalGroups(
+    std::vector<PoissonSeriesSubspace> const& subspaces,
+    int const m_begin,
+    int const m_end) {
+  std::vector<std::vector<int>> groups;
+  for (int m = m_begin; m < m_end; ++m) {
+    // Merge all the groups that have an element not orthogonal to |m|, and add
+    // |m| at the end of the merged group.
+    std::vector<int> merged_group;
+    std::vector<std::vector<int>> other_groups;
+    for (auto& group : groups) {
+      bool const orthogonal_to_group =
+          std::all_of(group.begin(), group.end(), [&subspaces, m](int const k) {
+            return PoissonSeriesSubspace::orthogonal(subspaces[k],
+                                                     subspaces[m]);
+          });
+      if (orthogonal_to_group) {
+        other_groups.push_back(std::move(group));
+      } else {
+        merged_group.insert(merged_group.end(), group.begin(), group.end());
+      }
+    }
+    std::sort(merged_group.begin(), merged_group.end());
+    merged_group.push_back(m);
+    other_groups.push_back(std::move(merged_group));
+    groups = std::move(other_groups);
+  }
+  return groups;
+}
+
 // Given a column |aₘ| of a matrix (or quasimatrix in our case, see [Tre10])
 // this function produces the columns |qₘ|, |rₘ| of its QR decomposition.  The
-// inner product is defined by |weight|, |t_min| and |t_max|.  |q| is the Q
-// quasimatrix constructed so far, and |subspaces| specify the subspaces spanned
-// by the |q|s and by |aₘ|.
+// inner product is defined by |weight|, |t_min| and |t_max|.  The first |m|
+// elements of |q| are the Q quasimatrix constructed so far; only those that are
+// not orthogonal to |aₘ| are accessed.  |subspaces| specify the subspaces
+// spanned by the |q|s and by |aₘ|.
 template<typename BasisSeries,
          int aperiodic_wdegree, int periodic_wdegree,
          template<typename, typename, int> class Evaluator>
@@ -84,12 +123,12 @@ absl::Status NormalGramSchmidtStep(
     Instant const& t_min,
     Instant const& t_max,
     std::vector<PoissonSeriesSubspace> const& subspaces,
+    int const m,
     std::vector<BasisSeries> const& q,
     BasisSeries& qₘ,
     UnboundedVector<double>& rₘ) {
   static absl::Status const bad_norm =
     absl::OutOfRangeError("Unable to compute norm");
-  int const m = q.size();
 
 #if PRINCIPIA_USE_CGS
   // This code follows [Bjö94], Algorithm 6.1.
@@ -302,26 +341,46 @@ IncrementalProjection(Function const& function,
   auto b = function - F;
   UnboundedVector<Norm> z(basis_size, uninitialized);
 
+  // The Gram-Schmidt step for an element of the basis only uses the elements
+  // of |q| that are not orthogonal to it.  Therefore, the new elements of each
+  // iteration are partitioned in groups of mutually orthogonal subspaces, which
+  // are orthonormalized in parallel.  The inner products are expensive, so we
+  // don't mind creating a pool for each call.
+  ThreadPool<void> pool(std::max(1u, std::thread::hardware_concurrency()));
+
   int m_begin = 0;
   for (;;) {
-    for (int m = m_begin; m < basis_size; ++m) {
-      BasisSeries qₘ(basis_zero, {{}});
-      UnboundedVector<double> rₘ(m + 1);
-
-      auto const status = NormalGramSchmidtStep(/*aₘ=*/basis[m],
-                                                weight, t_min, t_max,
-                                                basis_subspaces, q,
-                                                qₘ, rₘ);
+    q.resize(basis_size, BasisSeries(basis_zero, {{}}));
+    auto const groups =
+        OrthogonalGroups(basis_subspaces, m_begin, /*m_end=*/basis_size);
+    std::vector<absl::Status> statuses(groups.size());
+    std::vector<std::future<void>> futures;
+    for (int g = 0; g < groups.size(); ++g) {
+      futures.push_back(pool.Add([&, g]() {
+        for (int const m : groups[g]) {
+          UnboundedVector<double> rₘ(m + 1);
+          statuses[g] = NormalGramSchmidtStep(/*aₘ=*/basis[m],
+                                              weight, t_min, t_max,
+                                              basis_subspaces, m, q,
+                                              /*qₘ=*/q[m], rₘ);
+          if (!statuses[g].ok()) {
+            return;
+          }
+
+          // Fill the QR decomposition.  Each group writes distinct columns.
+          for (int i = 0; i <= m; ++i) {
+            r(i, m) = rₘ[i];
+          }
+        }
+      }));
+    }
+    for (auto& future : futures) {
+      future.wait();
+    }
+    for (auto const& status : statuses) {
       if (!status.ok()) {
         return F;
       }
-
-      // Fill the QR decomposition.
-      for (int i = 0; i <= m; ++i) {
-        r(i, m) = rₘ[i];
-      }
-      q.push_back(qₘ);
-      DCHECK_EQ(m + 1, q.size());
     }
 
     auto const status = AugmentedGramSchmidtStep(b,
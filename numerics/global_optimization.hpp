@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/hilbert.hpp"
 #include "numerics/nearest_neighbour.hpp"
 #include "quantities/named_quantities.hpp"
@@ -18,6 +19,7 @@ namespace _global_optimization {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_hilbert;
 using namespace principia::numerics::_nearest_neighbour;
 using namespace principia::quantities::_named_quantities;
@@ -73,16 +75,21 @@ class MultiLevelSingleLinkage {
   // Beware!  The Bayesian stopping rule is typically more efficient, but it is
   // only technically correct (the best kind of correct) if the relative sizes
   // of the regions of attraction follow a uniform distribution.
+  // If |pool| is not null, the local searches started in each iteration are
+  // performed in parallel on |pool|, in which case |f| and |grad_f| must be
+  // thread-safe.  The result doesn't depend on |pool|.
   std::vector<Argument> FindGlobalMaxima(
       std::int64_t points_per_round,
       std::optional<std::int64_t> number_of_rounds,
-      NormType local_search_tolerance);
+      NormType local_search_tolerance,
+      ThreadPool<void>* pool = nullptr);
 
   // Same as above, but minimization instead of maximization.
   std::vector<Argument> FindGlobalMinima(
       std::int64_t points_per_round,
       std::optional<std::int64_t> number_of_rounds,
-      NormType local_search_tolerance);
+      NormType local_search_tolerance,
+      ThreadPool<void>* pool = nullptr);
 
  private:
   using Norm²Type = typename Hilbert<Difference<Argument>>::Norm²Type;
@@ -97,6 +104,7 @@ class MultiLevelSingleLinkage {
       std::int64_t points_per_round,
       std::optional<std::int64_t> number_of_rounds,
       NormType local_search_tolerance,
+      ThreadPool<void>* pool,
       Field<Scalar, Argument> const& f,
       Field<Gradient<Scalar, Argument>, Argument> const& grad_f);
 
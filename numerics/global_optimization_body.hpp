@@ -3,12 +3,14 @@
 #include "numerics/global_optimization.hpp"
 
 #include <algorithm>
+#include <future>
 #include <map>
 #include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "absl/status/statusor.h"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/grassmann.hpp"
 #include "numerics/gradient_descent.hpp"
@@ -75,7 +77,8 @@ std::vector<Argument>
 MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMaxima(
     std::int64_t const points_per_round,
     std::optional<std::int64_t> const number_of_rounds,
-    NormType const local_search_tolerance) {
+    NormType const local_search_tolerance,
+    ThreadPool<void>* const pool) {
   Field<Scalar, Argument> minus_f = [this](Argument const& x) {
     return -f_(x);
   };
@@ -87,6 +90,7 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMaxima(
   return FindGlobalMinima(points_per_round,
                           number_of_rounds,
                           local_search_tolerance,
+                          pool,
                           minus_f,
                           minus_grad_f);
 }
@@ -96,10 +100,12 @@ std::vector<Argument>
 MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
     std::int64_t const points_per_round,
     std::optional<std::int64_t> const number_of_rounds,
-    NormType const local_search_tolerance) {
+    NormType const local_search_tolerance,
+    ThreadPool<void>* const pool) {
   return FindGlobalMinima(points_per_round,
                           number_of_rounds,
                           local_search_tolerance,
+                          pool,
                           f_,
                           grad_f_);
 }
@@ -110,6 +116,7 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
     std::int64_t const points_per_round,
     std::optional<std::int64_t> const number_of_rounds,
     NormType const local_search_tolerance,
+    ThreadPool<void>* const pool,
     Field<Scalar, Argument> const& f,
     Field<Gradient<Scalar, Argument>, Argument> const& grad_f) {
   // This is the set X* from [RT87b].
@@ -131,7 +138,7 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
       /*values=*/{},
       pcp_tree_max_values_per_cell);
 
-  int number_of_local_searches = 0;
+  std::int64_t number_of_local_searches = 0;
 
   // This structure corresponds to the list T in [RT87b].  Points are ordered
   // based on their distance to their nearest neighbour that has a lower value
@@ -210,7 +217,8 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
     Norm²Type const rₖ² = CriticalRadius²(/*σ=*/4, kN);
 
     // Process the points whose nearest neighbour is "sufficiently far" (or
-    // unknown).
+    // unknown), and collect the ones from which a local search must start.
+    std::vector<Argument const*> local_search_starts;
     for (auto it = schedule.upper_bound(rₖ²); it != schedule.end();) {
       Argument const& xᵢ = *it->second;
       auto* const xⱼ = point_neighbourhoods.FindNearestNeighbour(
@@ -220,31 +228,9 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
 
       if (xⱼ == nullptr) {
         // We must do a local search as xᵢ couldn't be added to an existing
-        // cluster.  Note that the radius of the search has to be the diametre
-        // of the box: it's possible that xᵢ would be near one vertex of the box
-        // and the stationary point near the opposite vertex.
-        ++number_of_local_searches;
-        auto const status_or_stationary_point =
-            BroydenFletcherGoldfarbShanno(xᵢ,
-                                          f,
-                                          grad_f,
-                                          local_search_tolerance,
-                                          box_diametre_);
-
-        // If the new stationary point is sufficiently far from the ones we
-        // already know, record it.
-        if (status_or_stationary_point.ok()) {
-          auto const& stationary_point = status_or_stationary_point.value();
-          if (IsNewStationaryPoint(stationary_point,
-                                   stationary_point_neighbourhoods,
-                                   local_search_tolerance)) {
-            stationary_points.push_back(
-                std::make_unique<Argument>(stationary_point));
-            stationary_point_neighbourhoods.Add(stationary_points.back().get());
-          }
-        }
-        // A local search has been started from xᵢ, so no point in considering
-        // it again.
+        // cluster.  A local search will be started from xᵢ, so no point in
+        // considering it again.
+        local_search_starts.push_back(&xᵢ);
         it = schedule.erase(it);
       } else {
         // Move the point xᵢ "down" in the |schedule| map, based on the distance
@@ -257,6 +243,52 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
         schedule.emplace(distance²_to_xⱼ, &xᵢ);
       }
     }
+
+    // The local searches only depend on their starting point, so they may run
+    // concurrently.  Note that the radius of the search has to be the diametre
+    // of the box: it's possible that xᵢ would be near one vertex of the box and
+    // the stationary point near the opposite vertex.
+    number_of_local_searches += local_search_starts.size();
+    std::vector<absl::StatusOr<Argument>> statuses_or_stationary_points(
+        local_search_starts.size());
+    auto local_search = [&](std::int64_t const i) {
+      statuses_or_stationary_points[i] =
+          BroydenFletcherGoldfarbShanno(*local_search_starts[i],
+                                        f,
+                                        grad_f,
+                                        local_search_tolerance,
+                                        box_diametre_);
+    };
+    if (pool == nullptr) {
+      for (std::int64_t i = 0; i < local_search_starts.size(); ++i) {
+        local_search(i);
+      }
+    } else {
+      std::vector<std::future<void>> futures;
+      for (std::int64_t i = 0; i < local_search_starts.size(); ++i) {
+        futures.push_back(pool->Add([&local_search, i]() { local_search(i); }));
+      }
+      for (auto& future : futures) {
+        future.wait();
+      }
+    }
+
+    // If a new stationary point is sufficiently far from the ones we already
+    // know, record it.  This is done in the order of the starting points so
+    // that the result doesn't depend on the scheduling of the local searches.
+    for (auto const& status_or_stationary_point :
+         statuses_or_stationary_points) {
+      if (status_or_stationary_point.ok()) {
+        auto const& stationary_point = status_or_stationary_point.value();
+        if (IsNewStationaryPoint(stationary_point,
+                                 stationary_point_neighbourhoods,
+                                 local_search_tolerance)) {
+          stationary_points.push_back(
+              std::make_unique<Argument>(stationary_point));
+          stationary_point_neighbourhoods.Add(stationary_points.back().get());
+        }
+      }
+    }
   }
 
   DLOG(ERROR) << "Number of local searches: " << number_of_local_searches;
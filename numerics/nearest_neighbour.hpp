@@ -36,6 +36,9 @@ class PrincipalComponentPartitioningTree {
 
   using Filter = std::function<bool(Value const*)>;
 
+  // The type of the distance between two values.
+  using Distance = typename Hilbert<Difference<Value>>::NormType;
+
   // We stop subdividing a cell when it contains |max_values_per_cell| or fewer
   // values.  This API takes (non-owning) pointers so that the client can relate
   // the values given here to the ones it gets from |FindNearestNeighbour|.  The
@@ -54,6 +57,15 @@ class PrincipalComponentPartitioningTree {
   Value const* FindNearestNeighbour(Value const& value,
                                     Filter const& filter = nullptr) const;
 
+  // Returns the values whose distance to the given |value| is at most
+  // |radius|, in no particular order.  Only the values for which |filter|
+  // returns true are considered.  Subtrees that lie entirely beyond |radius| of
+  // a separator plane are not visited.
+  std::vector<Value const*> FindWithinRadius(
+      Value const& value,
+      Distance const& radius,
+      Filter const& filter = nullptr) const;
+
  private:
   // A frame used to compute the principal components.
   using PrincipalComponentsFrame =
@@ -167,6 +179,14 @@ class PrincipalComponentPartitioningTree {
             std::int32_t& min_index,
             bool* must_check_other_side) const;
 
+  // Appends to |values| the values of the subtree rooted at |node| which are
+  // within |radius| of |displacement|.
+  void FindWithinRadius(Displacement const& displacement,
+                        Norm const& radius,
+                        Filter const& filter,
+                        Node const& node,
+                        std::vector<Value const*>& values) const;
+
   // Construction parameters.
   std::vector<not_null<Value const*>> values_;
   std::int64_t const max_values_per_cell_;
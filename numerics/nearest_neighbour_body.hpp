@@ -78,6 +78,19 @@ Value_ const* PrincipalComponentPartitioningTree<Value_>::FindNearestNeighbour(
              : static_cast<Value const*>(values_[min_index]);
 }
 
+template<typename Value_>
+std::vector<Value_ const*>
+PrincipalComponentPartitioningTree<Value_>::FindWithinRadius(
+    Value const& value,
+    Distance const& radius,
+    Filter const& filter) const {
+  std::vector<Value const*> values;
+  if (!displacements_.empty()) {
+    FindWithinRadius(value - centroid_, radius, filter, *root_, values);
+  }
+  return values;
+}
+
 template<typename Value_>
 void PrincipalComponentPartitioningTree<Value_>::Initialize() {
   // Compute the centroid of the values.
@@ -363,6 +376,41 @@ void PrincipalComponentPartitioningTree<Value_>::Find(
   }
 }
 
+template<typename Value_>
+void PrincipalComponentPartitioningTree<Value_>::FindWithinRadius(
+    Displacement const& displacement,
+    Norm const& radius,
+    Filter const& filter,
+    Node const& node,
+    std::vector<Value const*>& values) const {
+  if (std::holds_alternative<Internal>(node)) {
+    auto const& internal = std::get<Internal>(node);
+    Norm const projection =
+        InnerProduct(internal.principal_axis, displacement - internal.anchor);
+    // The first child contains the displacements whose projection is negative,
+    // the second one those whose projection is nonnegative.  A side needs to
+    // be visited only if the ball intersects it.
+    if (projection < radius) {
+      FindWithinRadius(
+          displacement, radius, filter, *internal.children.first, values);
+    }
+    if (projection >= -radius) {
+      FindWithinRadius(
+          displacement, radius, filter, *internal.children.second, values);
+    }
+  } else if (std::holds_alternative<Leaf>(node)) {
+    Norm² const radius² = Pow<2>(radius);
+    for (auto const index : std::get<Leaf>(node)) {
+      if ((displacements_[index] - displacement).Norm²() <= radius² &&
+          (filter == nullptr || filter(values_[index]))) {
+        values.push_back(values_[index]);
+      }
+    }
+  } else {
+    LOG(FATAL) << "Unexpected node";
+  }
+}
+
 }  // namespace internal
 }  // namespace _nearest_neighbour
 }  // namespace numerics
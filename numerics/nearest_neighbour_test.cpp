@@ -14,7 +14,9 @@ namespace principia {
 namespace numerics {
 
 using ::testing::Eq;
+using ::testing::IsEmpty;
 using ::testing::Pointee;
+using ::testing::UnorderedElementsAreArray;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
@@ -44,6 +46,19 @@ class PrincipalComponentPartitioningTreeTest : public ::testing::Test {
     return nearest;
   }
 
+  // Computes the points within |radius| using the brute force algorithm.
+  std::vector<V const*> BruteForceWithinRadius(V const& query_value,
+                                               double const radius,
+                                               std::vector<V> const& values) {
+    std::vector<V const*> within_radius;
+    for (auto const& value : values) {
+      if ((value - query_value).Norm() <= radius) {
+        within_radius.push_back(&value);
+      }
+    }
+    return within_radius;
+  }
+
   // Fills the vectors with |number_of_values| randomly generated values.
   void MakeValues(
       int const number_of_values,
@@ -235,5 +250,46 @@ TEST_F(PrincipalComponentPartitioningTreeTest, RandomFilter) {
   EXPECT_TRUE(filtering_was_effective) << "Filtering did nothing";
 }
 
+// Random points and radii, validated against the brute force algorithm.
+TEST_F(PrincipalComponentPartitioningTreeTest, RandomWithinRadius) {
+  static constexpr int points_in_tree = 100;
+  static constexpr int points_to_test = 100;
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<double> coordinate_distribution(-10, 10);
+  std::uniform_real_distribution<double> radius_distribution(0, 8);
+
+  std::vector<V> tree_points;
+  std::vector<not_null<V const*>> tree_pointers;
+  MakeValues(points_in_tree,
+             tree_points,
+             tree_pointers,
+             random,
+             coordinate_distribution);
+  PrincipalComponentPartitioningTree<V> tree1(tree_pointers,
+                                              /*max_values_per_cell=*/1);
+  PrincipalComponentPartitioningTree<V> tree3(tree_pointers,
+                                              /*max_values_per_cell=*/3);
+  PrincipalComponentPartitioningTree<V> const empty_tree(
+      {}, /*max_values_per_cell=*/1);
+
+  bool found_several = false;
+  for (int i = 0; i < points_to_test; ++i) {
+    auto const query_point = V({coordinate_distribution(random),
+                                coordinate_distribution(random),
+                                coordinate_distribution(random)});
+    double const radius = radius_distribution(random);
+
+    auto const within_radius =
+        BruteForceWithinRadius(query_point, radius, tree_points);
+    EXPECT_THAT(tree1.FindWithinRadius(query_point, radius),
+                UnorderedElementsAreArray(within_radius));
+    EXPECT_THAT(tree3.FindWithinRadius(query_point, radius),
+                UnorderedElementsAreArray(within_radius));
+    EXPECT_THAT(empty_tree.FindWithinRadius(query_point, radius), IsEmpty());
+    found_several |= within_radius.size() > 1;
+  }
+  EXPECT_TRUE(found_several);
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -69,8 +69,21 @@ NewhallApproximationInMonomialBasis(int degree,
                                     Instant const& t_max,
                                     Difference<Value>& error_estimate);
 
+// Returns the |error_estimate| that |NewhallApproximationInMonomialBasis|
+// would produce for the given parameters, without computing the approximation.
+// This is a single dot product, so it is much cheaper than the approximation
+// and it may be used to select the degree before fitting.
+template<typename Value>
+Difference<Value> NewhallApproximationErrorEstimate(
+    int degree,
+    std::vector<Value> const& q,
+    std::vector<Variation<Value>> const& v,
+    Instant const& t_min,
+    Instant const& t_max);
+
 }  // namespace internal
 
+using internal::NewhallApproximationErrorEstimate;
 using internal::NewhallApproximationInЧебышёвBasis;
 using internal::NewhallApproximationInMonomialBasis;
 
@@ -229,6 +229,31 @@ PRINCIPIA_NEWHALL_MONOMIAL_APPROXIMATOR_SPECIALIZATION(17);
 #undef PRINCIPIA_NEWHALL_ЧЕБЫШЁВ_APPROXIMATOR_SPECIALIZATION
 #undef PRINCIPIA_NEWHALL_MONOMIAL_APPROXIMATOR_SPECIALIZATION
 
+// Returns the |QV| for the monomial approximations, where the positions are
+// taken relative to |Value{}|.
+template<typename Value>
+QV<Difference<Value>> MakeQV(std::vector<Value> const& q,
+                             std::vector<Variation<Value>> const& v,
+                             Instant const& t_min,
+                             Instant const& t_max) {
+  CHECK_EQ(divisions + 1, q.size());
+  CHECK_EQ(divisions + 1, v.size());
+
+  Value const origin{};
+  Time const duration_over_two = 0.5 * (t_max - t_min);
+
+  // Tricky.  The order in Newhall's matrices is such that the entries for the
+  // largest time occur first.
+  QV<Difference<Value>> qv;
+  for (int i = 0, j = 2 * divisions;
+       i < divisions + 1 && j >= 0;
+       ++i, j -= 2) {
+    qv[j] = q[i] - origin;
+    qv[j + 1] = v[i] * duration_over_two;
+  }
+  return qv;
+}
+
 template<typename Value, int degree>
 PolynomialInЧебышёвBasis<Value, Instant, degree>
 NewhallApproximationInЧебышёвBasis(std::vector<Value> const& q,
@@ -305,21 +330,9 @@ NewhallApproximationInMonomialBasis(std::vector<Value> const& q,
                                     Instant const& t_min,
                                     Instant const& t_max,
                                     Difference<Value>& error_estimate) {
-  CHECK_EQ(divisions + 1, q.size());
-  CHECK_EQ(divisions + 1, v.size());
-
   Value const origin{};
   Time const duration_over_two = 0.5 * (t_max - t_min);
-
-  // Tricky.  The order in Newhall's matrices is such that the entries for the
-  // largest time occur first.
-  QV<Difference<Value>> qv;
-  for (int i = 0, j = 2 * divisions;
-       i < divisions + 1 && j >= 0;
-       ++i, j -= 2) {
-    qv[j] = q[i] - origin;
-    qv[j + 1] = v[i] * duration_over_two;
-  }
+  auto const qv = MakeQV(q, v, t_min, t_max);
 
   Instant const t_mid = Barycentre<Instant, double>({t_min, t_max}, {1, 1});
   return origin +
@@ -369,6 +382,45 @@ NewhallApproximationInMonomialBasis(int degree,
 
 #undef PRINCIPIA_NEWHALL_APPROXIMATION_IN_MONOMIAL_BASIS_CASE
 
+#define PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(degree) \
+  case (degree):                                                     \
+    return DotProduct<>::Compute(                                    \
+        newhall_c_matrix_чебышёв_degree_##degree##_divisions_8_w04   \
+            .row<(degree)>(),                                        \
+        qv)
+
+template<typename Value>
+Difference<Value> NewhallApproximationErrorEstimate(
+    int const degree,
+    std::vector<Value> const& q,
+    std::vector<Variation<Value>> const& v,
+    Instant const& t_min,
+    Instant const& t_max) {
+  auto const qv = MakeQV(q, v, t_min, t_max);
+  switch (degree) {
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(3);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(4);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(5);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(6);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(7);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(8);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(9);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(10);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(11);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(12);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(13);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(14);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(15);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(16);
+    PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE(17);
+    default:
+      LOG(FATAL) << "Unexpected degree " << degree;
+      break;
+  }
+}
+
+#undef PRINCIPIA_NEWHALL_APPROXIMATION_ERROR_ESTIMATE_CASE
+
 }  // namespace internal
 }  // namespace _newhall
 }  // namespace numerics
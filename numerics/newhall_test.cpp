@@ -814,5 +814,23 @@ TEST_F(NewhallTest, NonConstantDegree) {
                               length_function_1_(t_min_)), IsNear(9e-13_(1)));
 }
 
+TEST_F(NewhallTest, ErrorEstimate) {
+  std::vector<Length> lengths;
+  std::vector<Speed> speeds;
+  for (Instant t = t_min_; t <= t_max_; t += 0.5 * Second) {
+    lengths.push_back(length_function_1_(t));
+    speeds.push_back(speed_function_1_(t));
+  }
+
+  for (int degree = 3; degree <= 17; ++degree) {
+    Length length_error_estimate;
+    NewhallApproximationInMonomialBasis<Length, EstrinEvaluator>(
+        degree, lengths, speeds, t_min_, t_max_, length_error_estimate);
+    EXPECT_EQ(length_error_estimate,
+              NewhallApproximationErrorEstimate(
+                  degree, lengths, speeds, t_min_, t_max_)) << degree;
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -90,6 +90,12 @@ class PiecewisePoissonSeries {
   // t must be in the interval [t_min, t_max].
   Value operator()(Instant const& t) const;
 
+  // Evaluates this function at each element of |ts|, which must be sorted in
+  // increasing order and lie in the interval [t_min, t_max].  This is faster
+  // than calling |operator()| for each element because the pieces are walked
+  // linearly instead of being looked up by binary search.
+  std::vector<Value> Evaluate(std::vector<Instant> const& ts) const;
+
   // Returns the Fourier transform of this piecewise Poisson series.
   // The function is taken to be 0 outside [t_min, t_max].
   // The convention used is ∫ f(t) exp(-iωt) dt, corresponding to Mathematica’s
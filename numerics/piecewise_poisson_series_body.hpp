@@ -108,6 +108,33 @@ operator()(Instant const& t) const {
   return series_[it - bounds_.cbegin() - 1](t) + addend;
 }
 
+template<typename Value,
+         int aperiodic_degree_, int periodic_degree_,
+         template<typename, typename, int> class Evaluator>
+std::vector<Value>
+PiecewisePoissonSeries<Value, aperiodic_degree_, periodic_degree_, Evaluator>::
+Evaluate(std::vector<Instant> const& ts) const {
+  std::vector<Value> values;
+  values.reserve(ts.size());
+  // The index in |bounds_| of the upper bound of the interval to which the
+  // current time belongs.  Like in |operator()|, an element of |bounds_|
+  // belongs to the next interval, except for the last one.
+  int upper = 1;
+  int const last = bounds_.size() - 1;
+  for (int i = 0; i < ts.size(); ++i) {
+    Instant const& t = ts[i];
+    DCHECK(i == 0 || ts[i - 1] <= t)
+        << "Unsorted times " << ts[i - 1] << " and " << t;
+    DCHECK_LE(bounds_.front(), t);
+    DCHECK_LE(t, bounds_.back());
+    while (upper < last && bounds_[upper] <= t) {
+      ++upper;
+    }
+    values.push_back(series_[upper - 1](t) + EvaluateAddend(t));
+  }
+  return values;
+}
+
 template<typename Value,
          int aperiodic_degree_, int periodic_degree_,
          template<typename, typename, int> class Evaluator>
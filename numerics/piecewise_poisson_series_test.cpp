@@ -3,6 +3,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "geometry/frame.hpp"
 #include "geometry/instant.hpp"
@@ -94,6 +95,22 @@ TEST_F(PiecewisePoissonSeriesTest, Evaluate) {
   EXPECT_THAT(pp_(t0_ + 2 * Second), AlmostEquals(-1, 0));
 }
 
+TEST_F(PiecewisePoissonSeriesTest, EvaluateSortedTimes) {
+  double const ε = std::numeric_limits<double>::epsilon();
+  std::vector<Instant> const ts = {t0_,
+                                   t0_ + 0.5 * Second,
+                                   t0_ + 1 * (1 - ε / 2) * Second,
+                                   t0_ + 1 * Second,
+                                   t0_ + 1 * Second,
+                                   t0_ + 1.5 * Second,
+                                   t0_ + 2 * Second};
+  auto const values = pp_.Evaluate(ts);
+  ASSERT_EQ(ts.size(), values.size());
+  for (int i = 0; i < ts.size(); ++i) {
+    EXPECT_EQ(pp_(ts[i]), values[i]) << i;
+  }
+}
+
 TEST_F(PiecewisePoissonSeriesTest, VectorSpace) {
   {
     auto const pp = +pp_;
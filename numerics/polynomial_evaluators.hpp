@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+
 #include "numerics/polynomial_in_monomial_basis.hpp"
 #include "quantities/named_quantities.hpp"
 
@@ -36,6 +39,11 @@ namespace internal {
 // We use FORCE_INLINE because we have to write this recursively, but we really
 // want linear code.
 
+// The functions |EvaluateMany| and |EvaluateDerivativeMany| evaluate the same
+// polynomial at |size| arguments.  For Horner, the evaluations are interleaved
+// so that the processor may overlap their latencies and the compiler may
+// vectorize them; for Estrin, each evaluation already exposes some parallelism.
+
 template<typename Value, typename Argument, int degree, bool allow_fma>
 struct EstrinEvaluator {
   // The fully qualified name below designates the template, not the current
@@ -51,6 +59,15 @@ struct EstrinEvaluator {
   FORCE_INLINE(static) Derivative<Value, Argument>
   EvaluateDerivative(Coefficients const& coefficients,
                      Argument const& argument);
+
+  template<std::size_t size>
+  FORCE_INLINE(static) std::array<Value, size> EvaluateMany(
+      Coefficients const& coefficients,
+      std::array<Argument, size> const& arguments);
+  template<std::size_t size>
+  FORCE_INLINE(static) std::array<Derivative<Value, Argument>, size>
+  EvaluateDerivativeMany(Coefficients const& coefficients,
+                         std::array<Argument, size> const& arguments);
 };
 
 template<typename Value, typename Argument, int degree, bool allow_fma>
@@ -68,6 +85,15 @@ struct HornerEvaluator {
   FORCE_INLINE(static) Derivative<Value, Argument>
   EvaluateDerivative(Coefficients const& coefficients,
                      Argument const& argument);
+
+  template<std::size_t size>
+  FORCE_INLINE(static) std::array<Value, size> EvaluateMany(
+      Coefficients const& coefficients,
+      std::array<Argument, size> const& arguments);
+  template<std::size_t size>
+  FORCE_INLINE(static) std::array<Derivative<Value, Argument>, size>
+  EvaluateDerivativeMany(Coefficients const& coefficients,
+                         std::array<Argument, size> const& arguments);
 };
 
 }  // namespace internal
@@ -2,6 +2,7 @@
 
 #include "numerics/polynomial_evaluators.hpp"
 
+#include <array>
 #include <cstddef>
 #include <tuple>
 
@@ -298,6 +299,32 @@ EstrinEvaluator<Value, Argument, degree, allow_fma>::EvaluateDerivative(
   }
 }
 
+template<typename Value, typename Argument, int degree, bool allow_fma>
+template<std::size_t size>
+FORCE_INLINE(inline) std::array<Value, size>
+EstrinEvaluator<Value, Argument, degree, allow_fma>::EvaluateMany(
+    Coefficients const& coefficients,
+    std::array<Argument, size> const& arguments) {
+  std::array<Value, size> result;
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = Evaluate(coefficients, arguments[i]);
+  }
+  return result;
+}
+
+template<typename Value, typename Argument, int degree, bool allow_fma>
+template<std::size_t size>
+FORCE_INLINE(inline) std::array<Derivative<Value, Argument>, size>
+EstrinEvaluator<Value, Argument, degree, allow_fma>::EvaluateDerivativeMany(
+    Coefficients const& coefficients,
+    std::array<Argument, size> const& arguments) {
+  std::array<Derivative<Value, Argument>, size> result;
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = EvaluateDerivative(coefficients, arguments[i]);
+  }
+  return result;
+}
+
 // Internal helper for Horner evaluation.  |degree| is the degree of the overall
 // polynomial, |low| defines the subpolynomial that we currently evaluate, i.e.,
 // the one with a constant term coefficient |std::get<low>(coefficients)|.
@@ -313,6 +340,14 @@ struct InternalHornerEvaluator {
   FORCE_INLINE(static) Derivative<Value, Argument, low>
   EvaluateDerivative(Coefficients const& coefficients,
                      Argument const& argument);
+  template<std::size_t size>
+  FORCE_INLINE(static) std::array<Derivative<Value, Argument, low>, size>
+  EvaluateMany(Coefficients const& coefficients,
+               std::array<Argument, size> const& arguments);
+  template<std::size_t size>
+  FORCE_INLINE(static) std::array<Derivative<Value, Argument, low>, size>
+  EvaluateDerivativeMany(Coefficients const& coefficients,
+                         std::array<Argument, size> const& arguments);
 };
 
 template<typename Value, typename Argument, int degree, bool fma>
@@ -327,6 +362,14 @@ struct InternalHornerEvaluator<Value, Argument, degree, fma, degree> {
   FORCE_INLINE(static) Derivative<Value, Argument, degree>
   EvaluateDerivative(Coefficients const& coefficients,
                      Argument const& argument);
+  template<std::size_t size>
+  FORCE_INLINE(static) std::array<Derivative<Value, Argument, degree>, size>
+  EvaluateMany(Coefficients const& coefficients,
+               std::array<Argument, size> const& arguments);
+  template<std::size_t size>
+  FORCE_INLINE(static) std::array<Derivative<Value, Argument, degree>, size>
+  EvaluateDerivativeMany(Coefficients const& coefficients,
+                         std::array<Argument, size> const& arguments);
 };
 
 template<typename Value, typename Argument, int degree, bool fma, int low>
@@ -381,6 +424,74 @@ InternalHornerEvaluator<Value, Argument, degree, fma, degree>::
   return std::get<degree>(coefficients) * degree;
 }
 
+template<typename Value, typename Argument, int degree, bool fma, int low>
+template<std::size_t size>
+FORCE_INLINE(inline) std::array<Derivative<Value, Argument, low>, size>
+InternalHornerEvaluator<Value, Argument, degree, fma, low>::EvaluateMany(
+    Coefficients const& coefficients,
+    std::array<Argument, size> const& arguments) {
+  auto const a =
+      InternalHornerEvaluator<Value, Argument, degree, fma, low + 1>::
+          EvaluateMany(coefficients, arguments);
+  auto const& b = std::get<low>(coefficients);
+  std::array<Derivative<Value, Argument, low>, size> result;
+  for (std::size_t i = 0; i < size; ++i) {
+    auto const& x = arguments[i];
+    if constexpr (fma) {
+      using quantities::_elementary_functions::FusedMultiplyAdd;
+      result[i] = FusedMultiplyAdd(a[i], x, b);
+    } else {
+      result[i] = a[i] * x + b;
+    }
+  }
+  return result;
+}
+
+template<typename Value, typename Argument, int degree, bool fma, int low>
+template<std::size_t size>
+FORCE_INLINE(inline) std::array<Derivative<Value, Argument, low>, size>
+InternalHornerEvaluator<Value, Argument, degree, fma, low>::
+    EvaluateDerivativeMany(Coefficients const& coefficients,
+                           std::array<Argument, size> const& arguments) {
+  auto const a =
+      InternalHornerEvaluator<Value, Argument, degree, fma, low + 1>::
+          EvaluateDerivativeMany(coefficients, arguments);
+  auto const b = std::get<low>(coefficients) * low;
+  std::array<Derivative<Value, Argument, low>, size> result;
+  for (std::size_t i = 0; i < size; ++i) {
+    auto const& x = arguments[i];
+    if constexpr (fma) {
+      using quantities::_elementary_functions::FusedMultiplyAdd;
+      result[i] = FusedMultiplyAdd(a[i], x, b);
+    } else {
+      result[i] = a[i] * x + b;
+    }
+  }
+  return result;
+}
+
+template<typename Value, typename Argument, int degree, bool fma>
+template<std::size_t size>
+FORCE_INLINE(inline) std::array<Derivative<Value, Argument, degree>, size>
+InternalHornerEvaluator<Value, Argument, degree, fma, degree>::EvaluateMany(
+    Coefficients const& coefficients,
+    std::array<Argument, size> const& arguments) {
+  std::array<Derivative<Value, Argument, degree>, size> result;
+  result.fill(std::get<degree>(coefficients));
+  return result;
+}
+
+template<typename Value, typename Argument, int degree, bool fma>
+template<std::size_t size>
+FORCE_INLINE(inline) std::array<Derivative<Value, Argument, degree>, size>
+InternalHornerEvaluator<Value, Argument, degree, fma, degree>::
+    EvaluateDerivativeMany(Coefficients const& coefficients,
+                           std::array<Argument, size> const& arguments) {
+  std::array<Derivative<Value, Argument, degree>, size> result;
+  result.fill(std::get<degree>(coefficients) * degree);
+  return result;
+}
+
 template<typename Value, typename Argument, int degree, bool allow_fma>
 FORCE_INLINE(inline) Value
 HornerEvaluator<Value, Argument, degree, allow_fma>::Evaluate(
@@ -417,6 +528,44 @@ HornerEvaluator<Value, Argument, degree, allow_fma>::EvaluateDerivative(
   }
 }
 
+template<typename Value, typename Argument, int degree, bool allow_fma>
+template<std::size_t size>
+FORCE_INLINE(inline) std::array<Value, size>
+HornerEvaluator<Value, Argument, degree, allow_fma>::EvaluateMany(
+    Coefficients const& coefficients,
+    std::array<Argument, size> const& arguments) {
+  if (allow_fma && UseHardwareFMA) {
+    return InternalHornerEvaluator<
+        Value, Argument, degree, /*fma=*/true, /*low=*/0>::EvaluateMany(
+            coefficients, arguments);
+  } else {
+    return InternalHornerEvaluator<
+        Value, Argument, degree, /*fma=*/false, /*low=*/0>::EvaluateMany(
+            coefficients, arguments);
+  }
+}
+
+template<typename Value, typename Argument, int degree, bool allow_fma>
+template<std::size_t size>
+FORCE_INLINE(inline) std::array<Derivative<Value, Argument>, size>
+HornerEvaluator<Value, Argument, degree, allow_fma>::EvaluateDerivativeMany(
+    Coefficients const& coefficients,
+    std::array<Argument, size> const& arguments) {
+  if constexpr (degree == 0) {
+    return std::array<Derivative<Value, Argument>, size>{};
+  } else if (allow_fma && UseHardwareFMA) {
+    return InternalHornerEvaluator<
+        Value, Argument, degree,
+        /*fma=*/true, /*low=*/1>::EvaluateDerivativeMany(
+            coefficients, arguments);
+  } else {
+    return InternalHornerEvaluator<
+        Value, Argument, degree,
+        /*fma=*/false, /*low=*/1>::EvaluateDerivativeMany(
+            coefficients, arguments);
+  }
+}
+
 }  // namespace internal
 }  // namespace _polynomial_evaluators
 }  // namespace numerics
@@ -7,6 +7,8 @@
 #define PRINCIPIA_NUMERICS_POLYNOMIAL_IN_MONOMIAL_BASIS_HPP_
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -109,10 +111,21 @@ class PolynomialInMonomialBasis : public Polynomial<Value_, Argument_> {
   Derivative<Value, Argument> EvaluateDerivative(
       Argument const& argument) const override;
 
+  // Same as above, but at each of the |arguments|.  This is faster than
+  // evaluating at the arguments one by one when the evaluator is able to
+  // interleave the evaluations.
+  template<std::size_t size>
+  std::array<Value, size> EvaluateMany(
+      std::array<Argument, size> const& arguments) const;
+  template<std::size_t size>
+  std::array<Derivative<Value, Argument>, size> EvaluateDerivativeMany(
+      std::array<Argument, size> const& arguments) const;
+
   constexpr int degree() const override;
   bool is_zero() const override;
 
   Argument const& origin() const;
+  Coefficients const& coefficients() const;
 
   // Returns a copy of this polynomial adjusted to the given origin.
   PolynomialInMonomialBasis AtOrigin(Argument const& origin) const;
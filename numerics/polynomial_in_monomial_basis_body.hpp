@@ -3,6 +3,8 @@
 #include "numerics/polynomial_in_monomial_basis.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -382,6 +384,34 @@ EvaluateDerivative(Argument const& argument) const {
       coefficients_, argument - origin_);
 }
 
+template<typename Value_, typename Argument_, int degree_,
+         template<typename, typename, int> typename Evaluator>
+template<std::size_t size>
+std::array<Value_, size>
+PolynomialInMonomialBasis<Value_, Argument_, degree_, Evaluator>::
+EvaluateMany(std::array<Argument, size> const& arguments) const {
+  std::array<Difference<Argument>, size> differences;
+  for (std::size_t i = 0; i < size; ++i) {
+    differences[i] = arguments[i] - origin_;
+  }
+  return Evaluator<Value, Difference<Argument>, degree_>::EvaluateMany(
+      coefficients_, differences);
+}
+
+template<typename Value_, typename Argument_, int degree_,
+         template<typename, typename, int> typename Evaluator>
+template<std::size_t size>
+std::array<Derivative<Value_, Argument_>, size>
+PolynomialInMonomialBasis<Value_, Argument_, degree_, Evaluator>::
+EvaluateDerivativeMany(std::array<Argument, size> const& arguments) const {
+  std::array<Difference<Argument>, size> differences;
+  for (std::size_t i = 0; i < size; ++i) {
+    differences[i] = arguments[i] - origin_;
+  }
+  return Evaluator<Value, Difference<Argument>, degree_>::
+      EvaluateDerivativeMany(coefficients_, differences);
+}
+
 template<typename Value_, typename Argument_, int degree_,
          template<typename, typename, int> typename Evaluator>
 constexpr int
@@ -405,6 +435,15 @@ origin() const {
   return origin_;
 }
 
+template<typename Value_, typename Argument_, int degree_,
+         template<typename, typename, int> typename Evaluator>
+typename PolynomialInMonomialBasis<Value_, Argument_, degree_, Evaluator>::
+    Coefficients const&
+PolynomialInMonomialBasis<Value_, Argument_, degree_, Evaluator>::
+coefficients() const {
+  return coefficients_;
+}
+
 template<typename Value_, typename Argument_, int degree_,
          template<typename, typename, int> typename Evaluator>
 PolynomialInMonomialBasis<Value_, Argument_, degree_, Evaluator>
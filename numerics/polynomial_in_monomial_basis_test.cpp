@@ -1,5 +1,6 @@
 #include "numerics/polynomial_in_monomial_basis.hpp"
 
+#include <array>
 #include <tuple>
 
 #include "geometry/frame.hpp"
@@ -157,6 +158,35 @@ TEST_F(PolynomialInMonomialBasisTest, Evaluate2P) {
 #endif
 }
 
+// Check that evaluating at several arguments gives the same results as
+// evaluating at each argument.
+TEST_F(PolynomialInMonomialBasisTest, EvaluateMany) {
+  Instant const t0 = Instant() + 0.3 * Second;
+  P2P const p({World::origin + std::get<0>(coefficients_),
+               std::get<1>(coefficients_),
+               std::get<2>(coefficients_)},
+              t0);
+  std::array<Instant, 5> const arguments = {t0 - 1.5 * Second,
+                                            t0,
+                                            t0 + 0.5 * Second,
+                                            t0 + 0.7 * Second,
+                                            t0 + 3 * Second};
+  auto const positions = p.EvaluateMany(arguments);
+  auto const velocities = p.EvaluateDerivativeMany(arguments);
+  for (int i = 0; i < arguments.size(); ++i) {
+    EXPECT_EQ(p(arguments[i]), positions[i]) << i;
+    EXPECT_EQ(p.EvaluateDerivative(arguments[i]), velocities[i]) << i;
+  }
+
+  PolynomialInMonomialBasis<Displacement<World>, Time, 2, EstrinEvaluator> const
+      q(coefficients_);
+  std::array<Time, 2> const times = {-1 * Second, 2 * Second};
+  auto const displacements = q.EvaluateMany(times);
+  for (int i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(q(times[i]), displacements[i]) << i;
+  }
+}
+
 // Check that a polynomial of high order may be declared.
 TEST_F(PolynomialInMonomialBasisTest, Evaluate17) {
   P17::Coefficients const coefficients;
@@ -6,6 +6,8 @@
 #ifndef PRINCIPIA_NUMERICS_POLYNOMIAL_IN_ЧЕБЫШЁВ_BASIS_HPP_
 #define PRINCIPIA_NUMERICS_POLYNOMIAL_IN_ЧЕБЫШЁВ_BASIS_HPP_
 
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -116,6 +118,13 @@ class PolynomialInЧебышёвBasis<Value_, Argument_, degree_>
   Derivative<Value, Argument> EvaluateDerivative(
       Argument const& argument) const override;
 
+  // Same as |operator()| for each of the |arguments|.  The Clenshaw
+  // recurrences for the different arguments are interleaved, so this is
+  // faster than evaluating the arguments one at a time.
+  template<std::size_t size>
+  std::array<Value, size> EvaluateMany(
+      std::array<Argument, size> const& arguments) const;
+
   constexpr int degree() const override;
   bool is_zero() const override;
 
@@ -163,6 +163,56 @@ PolynomialInЧебышёвBasis<Value_, Argument_, degree_>::EvaluateDerivative(
          (one_over_width_ + one_over_width_);
 }
 
+template<typename Value_, typename Argument_, int degree_>
+template<std::size_t size>
+std::array<Value_, size>
+PolynomialInЧебышёвBasis<Value_, Argument_, degree_>::EvaluateMany(
+    std::array<Argument, size> const& arguments) const {
+  // See comments above.
+  std::array<double, size> scaled_arguments;
+  std::array<double, size> two_scaled_arguments;
+  for (std::size_t i = 0; i < size; ++i) {
+    Argument const& argument = arguments[i];
+    scaled_arguments[i] =
+        ((argument - upper_bound_) + (argument - lower_bound_)) *
+        one_over_width_;
+    DCHECK_LE(scaled_arguments[i], 1.1);
+    DCHECK_GE(scaled_arguments[i], -1.1);
+    two_scaled_arguments[i] = scaled_arguments[i] + scaled_arguments[i];
+  }
+
+  Value const& c₀ = coefficients_[0];
+  std::array<Value, size> result;
+  if constexpr (degree_ == 0) {
+    result.fill(c₀);
+  } else if constexpr (degree_ == 1) {
+    for (std::size_t i = 0; i < size; ++i) {
+      result[i] = c₀ + scaled_arguments[i] * coefficients_[1];
+    }
+  } else {
+    // The innermost loop runs over the arguments, which are independent, so
+    // that it may be vectorized.
+    std::array<Value, size> bₖ₊₂;
+    std::array<Value, size> bₖ₊₁;
+    bₖ₊₂.fill(coefficients_[degree_]);
+    for (std::size_t i = 0; i < size; ++i) {
+      bₖ₊₁[i] = coefficients_[degree_ - 1] + two_scaled_arguments[i] * bₖ₊₂[i];
+    }
+    for (int k = degree_ - 2; k >= 1; --k) {
+      Value const& cₖ = coefficients_[k];
+      for (std::size_t i = 0; i < size; ++i) {
+        Value const bₖ = cₖ + two_scaled_arguments[i] * bₖ₊₁[i] - bₖ₊₂[i];
+        bₖ₊₂[i] = bₖ₊₁[i];
+        bₖ₊₁[i] = bₖ;
+      }
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      result[i] = c₀ + scaled_arguments[i] * bₖ₊₁[i] - bₖ₊₂[i];
+    }
+  }
+  return result;
+}
+
 template<typename Value_, typename Argument_, int degree_>
 constexpr
 int PolynomialInЧебышёвBasis<Value_, Argument_, degree_>::degree() const {
@@ -1,5 +1,7 @@
 #include "numerics/polynomial_in_чебышёв_basis.hpp"
 
+#include <array>
+
 #include "astronomy/frames.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
@@ -108,6 +110,23 @@ TEST_F(PolynomialInЧебышёвBasisTest, X6) {
   EXPECT_EQ(1, x6(t0_ + 3 * Second));
 }
 
+TEST_F(PolynomialInЧебышёвBasisTest, EvaluateMany) {
+  PolynomialInЧебышёвBasis<double, Instant, 0> t0({1}, t_min_, t_max_);
+  PolynomialInЧебышёвBasis<double, Instant, 1> t1({0, 1}, t_min_, t_max_);
+  PolynomialInЧебышёвBasis<double, Instant, 6> x6(
+      {10.0 / 32.0, 0, 15.0 / 32.0, 0, 6.0 / 32.0, 0, 1.0 / 32.0},
+      t_min_, t_max_);
+  std::array<Instant, 5> const arguments{t0_ + -1 * Second,
+                                         t0_ + 1 * Second,
+                                         t0_ + 1.5 * Second,
+                                         t0_ + 2 * Second,
+                                         t0_ + 3 * Second};
+  EXPECT_THAT(t0.EvaluateMany(arguments), ElementsAre(1, 1, 1, 1, 1));
+  EXPECT_THAT(t1.EvaluateMany(arguments), ElementsAre(-1, 0, 0.25, 0.5, 1));
+  EXPECT_THAT(x6.EvaluateMany(arguments),
+              ElementsAre(1, 0, 1.0 / 4096.0, 1.0 / 64.0, 1));
+}
+
 TEST_F(PolynomialInЧебышёвBasisTest, T2Dimension) {
   PolynomialInЧебышёвBasis<Length, Instant, 2> t2(
       {0 * Metre, 0 * Metre, 1 * Metre},
@@ -3,6 +3,7 @@
 #include <optional>
 #include <type_traits>
 
+#include "base/thread_pool.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 
@@ -11,6 +12,7 @@ namespace numerics {
 namespace _quadrature {
 namespace internal {
 
+using namespace principia::base::_thread_pool;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 
@@ -24,7 +26,11 @@ Primitive<std::invoke_result_t<Function, Argument>, Argument> GaussLegendre(
 // the tolerance is satisfied.  The client controls the accuracy of the result
 // using |max_relative_error| (returns when the relative error on the result is
 // estimated to be less that the specified value) and |max_points| (returns when
-// the number of points would exceed the specified value).
+// the number of points would exceed the specified value).  If |pool| is not
+// null, the evaluations of |f| at the points added by each refinement are
+// performed in parallel on |pool|, in which case |f| must be thread-safe.  This
+// is only worthwhile for expensive integrands.  The values of |f| computed for
+// a given number of points are always reused for the next one.
 template<int initial_points = 3, typename Argument, typename Function>
 Primitive<std::invoke_result_t<Function, Argument>, Argument>
 AutomaticClenshawCurtis(
@@ -32,7 +38,8 @@ AutomaticClenshawCurtis(
     Argument const& lower_bound,
     Argument const& upper_bound,
     std::optional<double> max_relative_error,
-    std::optional<int> max_points);
+    std::optional<int> max_points,
+    ThreadPool<void>* pool = nullptr);
 
 // |points| must be of the form 2ᵖ + 1 for some p ∈ ℕ.  Returns the
 // Clenshaw-Curtis quadrature of f with the given number of points.
@@ -3,6 +3,8 @@
 #include "numerics/quadrature.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -50,7 +52,8 @@ void FillClenshawCurtisCache(
     Argument const& lower_bound,
     Argument const& upper_bound,
     std::vector<std::invoke_result_t<Function, Argument>>&
-        f_cos_N⁻¹π_bit_reversed);
+        f_cos_N⁻¹π_bit_reversed,
+    ThreadPool<void>* pool);
 
 template<int points, typename Argument, typename Function>
 Primitive<std::invoke_result_t<Function, Argument>, Argument>
@@ -63,7 +66,8 @@ AutomaticClenshawCurtisImplementation(
     Primitive<std::invoke_result_t<Function, Argument>, Argument> const
         previous_estimate,
     std::vector<std::invoke_result_t<Function, Argument>>&
-        f_cos_N⁻¹π_bit_reversed);
+        f_cos_N⁻¹π_bit_reversed,
+    ThreadPool<void>* pool);
 
 template<int points, typename Argument, typename Function>
 Primitive<std::invoke_result_t<Function, Argument>, Argument>
@@ -72,7 +76,8 @@ ClenshawCurtisImplementation(
     Argument const& lower_bound,
     Argument const& upper_bound,
     std::vector<std::invoke_result_t<Function, Argument>>&
-        f_cos_N⁻¹π_bit_reversed);
+        f_cos_N⁻¹π_bit_reversed,
+    ThreadPool<void>* pool);
 
 // Our automatic Cleshaw-Curtis implementation doubles the number of points
 // repeatedly until it reaches a suitable exit criterion.  Naïvely evaluating
@@ -102,7 +107,8 @@ void FillClenshawCurtisCache(
     Argument const& lower_bound,
     Argument const& upper_bound,
     std::vector<std::invoke_result_t<Function, Argument>>&
-        f_cos_N⁻¹π_bit_reversed) {
+        f_cos_N⁻¹π_bit_reversed,
+    ThreadPool<void>* const pool) {
   // If we identify [lower_bound, upper_bound] with [-1, 1],
   // f_cos_N⁻¹π_bit_reversed contains f(cos πs/N) in bit-reversed order of s.
   // We use a discrete Fourier transform rather than a cosine transform, see
@@ -131,16 +137,41 @@ void FillClenshawCurtisCache(
     // of N.
     FillClenshawCurtisCache<N / 2 + 1>(f,
                                        lower_bound, upper_bound,
-                                       f_cos_N⁻¹π_bit_reversed);
+                                       f_cos_N⁻¹π_bit_reversed,
+                                       pool);
     // N/2 evaluations for f(cos πs/N) with s odd.  Note the need to preserve
     // bit-reversed ordering.
-    int reverse = 0;
-    for (int evaluations = 0;
-         evaluations < N / 2;
-         ++evaluations, reverse = BitReversedIncrement(reverse, log2_N - 1)) {
-      int const s = 2 * reverse + 1;
-      f_cos_N⁻¹π_bit_reversed.push_back(
-          f(lower_bound + half_width * (1 + ЧебышёвLobattoPoint<N>(s))));
+    if (pool == nullptr) {
+      int reverse = 0;
+      for (int evaluations = 0;
+           evaluations < N / 2;
+           ++evaluations, reverse = BitReversedIncrement(reverse, log2_N - 1)) {
+        int const s = 2 * reverse + 1;
+        f_cos_N⁻¹π_bit_reversed.push_back(
+            f(lower_bound + half_width * (1 + ЧебышёвLobattoPoint<N>(s))));
+      }
+    } else {
+      // The slots are allocated before starting the evaluations, so that each
+      // task writes to its own entry and no reallocation may happen while the
+      // tasks are running.
+      std::int64_t const first = f_cos_N⁻¹π_bit_reversed.size();
+      f_cos_N⁻¹π_bit_reversed.resize(first + N / 2);
+      std::vector<std::future<void>> futures;
+      futures.reserve(N / 2);
+      int reverse = 0;
+      for (int evaluations = 0;
+           evaluations < N / 2;
+           ++evaluations, reverse = BitReversedIncrement(reverse, log2_N - 1)) {
+        int const s = 2 * reverse + 1;
+        Argument const node =
+            lower_bound + half_width * (1 + ЧебышёвLobattoPoint<N>(s));
+        auto& value = f_cos_N⁻¹π_bit_reversed[first + evaluations];
+        futures.push_back(
+            pool->Add([&f, node, &value]() { value = f(node); }));
+      }
+      for (auto& future : futures) {
+        future.wait();
+      }
     }
   }
 }
@@ -156,12 +187,13 @@ AutomaticClenshawCurtisImplementation(
     Primitive<std::invoke_result_t<Function, Argument>, Argument> const
         previous_estimate,
     std::vector<std::invoke_result_t<Function, Argument>>&
-        f_cos_N⁻¹π_bit_reversed) {
+        f_cos_N⁻¹π_bit_reversed,
+    ThreadPool<void>* const pool) {
   using Result = Primitive<std::invoke_result_t<Function, Argument>, Argument>;
 
   Result const estimate =
       ClenshawCurtisImplementation<points>(
-          f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
+          f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed, pool);
 
   // This is the naïve estimate mentioned in [Gen72b], p. 339.
   auto const absolute_error_estimate =
@@ -183,7 +215,8 @@ AutomaticClenshawCurtisImplementation(
           lower_bound, upper_bound,
           max_relative_error, max_points,
           estimate,
-          f_cos_N⁻¹π_bit_reversed);
+          f_cos_N⁻¹π_bit_reversed,
+          pool);
     }
   }
   return estimate;
@@ -196,7 +229,8 @@ ClenshawCurtisImplementation(
     Argument const& lower_bound,
     Argument const& upper_bound,
     std::vector<std::invoke_result_t<Function, Argument>>&
-        f_cos_N⁻¹π_bit_reversed) {
+        f_cos_N⁻¹π_bit_reversed,
+    ThreadPool<void>* const pool) {
   // We follow the notation from [Gen72b] and [Gen72c].
   using Value = std::invoke_result_t<Function, Argument>;
 
@@ -207,7 +241,7 @@ ClenshawCurtisImplementation(
   constexpr Angle N⁻¹π = π * Radian / N;
 
   FillClenshawCurtisCache<points>(
-      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
+      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed, pool);
 
   // TODO(phl): If might be possible to avoid copies since
   // f_cos_N⁻¹π_bit_reversed is tantalizing close to the order needed for the
@@ -268,19 +302,21 @@ AutomaticClenshawCurtis(
     Argument const& lower_bound,
     Argument const& upper_bound,
     std::optional<double> const max_relative_error,
-    std::optional<int> const max_points) {
+    std::optional<int> const max_points,
+    ThreadPool<void>* const pool) {
   using Result = Primitive<std::invoke_result_t<Function, Argument>, Argument>;
   using Value = std::invoke_result_t<Function, Argument>;
   std::vector<Value> f_cos_N⁻¹π_bit_reversed;
   f_cos_N⁻¹π_bit_reversed.reserve(2 * initial_points - 1);
   Result const estimate = ClenshawCurtisImplementation<initial_points>(
-      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
+      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed, pool);
   return AutomaticClenshawCurtisImplementation<2 * initial_points - 1>(
       f,
       lower_bound, upper_bound,
       max_relative_error, max_points,
       estimate,
-      f_cos_N⁻¹π_bit_reversed);
+      f_cos_N⁻¹π_bit_reversed,
+      pool);
 }
 
 template<int points, typename Argument, typename Function>
@@ -292,7 +328,7 @@ Primitive<std::invoke_result_t<Function, Argument>, Argument> ClenshawCurtis(
   std::vector<Value> f_cos_N⁻¹π_bit_reversed;
   f_cos_N⁻¹π_bit_reversed.reserve(points);
   return ClenshawCurtisImplementation<points>(
-      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
+      f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed, /*pool=*/nullptr);
 }
 
 inline std::optional<int> MaxPointsHeuristicsForAutomaticClenshawCurtis(
@@ -1,5 +1,6 @@
 #include "numerics/quadrature.hpp"
 
+#include <atomic>
 #include <limits>
 
 #include "gmock/gmock.h"
@@ -18,6 +19,7 @@ namespace quadrature {
 
 using ::testing::AnyOf;
 using ::testing::Eq;
+using namespace principia::base::_thread_pool;
 using namespace principia::numerics::_quadrature;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_quantities;
@@ -133,6 +135,35 @@ TEST_F(QuadratureTest, Sin10) {
               AnyOf(Eq(32769), Eq(65537), Eq(262145), Eq(524289), Eq(1048577)));
 }
 
+TEST_F(QuadratureTest, ParallelClenshawCurtis) {
+  std::atomic<int> evaluations = 0;
+  auto const f = [&evaluations](Angle const x) {
+    ++evaluations;
+    return Sin(2 * x);
+  };
+  auto const sequential = AutomaticClenshawCurtis(
+      f,
+      -2.0 * Radian,
+      5.0 * Radian,
+      /*max_relative_error=*/std::numeric_limits<double>::epsilon(),
+      /*max_points=*/std::nullopt);
+  int const sequential_evaluations = evaluations;
+
+  ThreadPool<void> pool(/*pool_size=*/4);
+  evaluations = 0;
+  auto const parallel = AutomaticClenshawCurtis(
+      f,
+      -2.0 * Radian,
+      5.0 * Radian,
+      /*max_relative_error=*/std::numeric_limits<double>::epsilon(),
+      /*max_points=*/std::nullopt,
+      &pool);
+
+  // The values are stored in the same order, so the results are identical.
+  EXPECT_THAT(parallel, AlmostEquals(sequential, 0));
+  EXPECT_EQ(sequential_evaluations, evaluations);
+}
+
 }  // namespace quadrature
 }  // namespace numerics
 }  // namespace principia
@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "base/tags.hpp"
 #include "numerics/fixed_arrays.hpp"
 #include "numerics/transposed_view.hpp"
@@ -31,6 +32,13 @@ class uninitialized_allocator : public std::allocator<T> {
   void construct(U* p, Args&&... args);
 };
 
+// The storage of the following classes.  The arrays used by the matrix
+// computations are generally small, so their entries are stored inline to
+// avoid a heap allocation for each temporary.
+template<typename Scalar>
+using UnboundedStorage =
+    absl::InlinedVector<Scalar, /*N=*/16, uninitialized_allocator<Scalar>>;
+
 template<typename Scalar>
 class UnboundedMatrix;
 template<typename Scalar>
@@ -61,8 +69,8 @@ class UnboundedVector final {
 
   int size() const;
 
-  typename std::vector<Scalar>::const_iterator begin() const;
-  typename std::vector<Scalar>::const_iterator end() const;
+  typename UnboundedStorage<Scalar>::const_iterator begin() const;
+  typename UnboundedStorage<Scalar>::const_iterator end() const;
 
   Scalar& operator[](int index);
   Scalar const& operator[](int index) const;
@@ -79,7 +87,7 @@ class UnboundedVector final {
   }
 
  private:
-  std::vector<Scalar, uninitialized_allocator<Scalar>> data_;
+  UnboundedStorage<Scalar> data_;
 };
 
 template<typename Scalar_>
@@ -124,7 +132,7 @@ class UnboundedMatrix final {
  private:
   int rows_;
   int columns_;
-  std::vector<Scalar, uninitialized_allocator<Scalar>> data_;
+  UnboundedStorage<Scalar> data_;
 
   template<typename S>
   friend std::ostream& operator<<(std::ostream& out,
@@ -167,7 +175,7 @@ class UnboundedLowerTriangularMatrix final {
 
  private:
   int rows_;
-  std::vector<Scalar, uninitialized_allocator<Scalar>> data_;
+  UnboundedStorage<Scalar> data_;
 
   template<typename S>
   friend std::ostream& operator<<(
@@ -212,7 +220,7 @@ class UnboundedUpperTriangularMatrix final {
  private:
   // For ease of writing matrices in tests, the input data is received in row-
   // major format.  This translates a trapezoidal slice to make it column-major.
-  static std::vector<Scalar, uninitialized_allocator<Scalar>> Transpose(
+  static UnboundedStorage<Scalar> Transpose(
       std::initializer_list<Scalar> const& data,
       int current_columns,
       int extra_columns);
@@ -220,7 +228,7 @@ class UnboundedUpperTriangularMatrix final {
   int columns_;
   // Stored in column-major format, so the data passed the public API must be
   // transposed.
-  std::vector<Scalar, uninitialized_allocator<Scalar>> data_;
+  UnboundedStorage<Scalar> data_;
 
   template<typename S>
   friend std::ostream& operator<<(
@@ -279,6 +287,32 @@ UnboundedMatrix<Difference<LScalar, RScalar>> operator-(
     UnboundedMatrix<LScalar> const& left,
     UnboundedMatrix<RScalar> const& right);
 
+// The following operators reuse the storage of their rvalue argument.
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator-(UnboundedVector<Scalar>&& right);
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator-(UnboundedMatrix<Scalar>&& right);
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator+(UnboundedVector<Scalar>&& left,
+                                  UnboundedVector<Scalar> const& right);
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator+(UnboundedMatrix<Scalar>&& left,
+                                  UnboundedMatrix<Scalar> const& right);
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator-(UnboundedVector<Scalar>&& left,
+                                  UnboundedVector<Scalar> const& right);
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator-(UnboundedMatrix<Scalar>&& left,
+                                  UnboundedMatrix<Scalar> const& right);
+
+// The compound assignments operate in place.
+
 template<typename Scalar>
 UnboundedVector<Scalar>& operator+=(
     UnboundedVector<Scalar>& left,
@@ -331,6 +365,34 @@ UnboundedMatrix<Quotient<LScalar, RScalar>>
 operator/(UnboundedMatrix<LScalar> const& left,
           RScalar const& right);
 
+// The following operators reuse the storage of their rvalue argument.
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator*(double left,
+                                  UnboundedVector<Scalar>&& right);
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator*(UnboundedVector<Scalar>&& left,
+                                  double right);
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator*(double left,
+                                  UnboundedMatrix<Scalar>&& right);
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator*(UnboundedMatrix<Scalar>&& left,
+                                  double right);
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator/(UnboundedVector<Scalar>&& left,
+                                  double right);
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator/(UnboundedMatrix<Scalar>&& left,
+                                  double right);
+
+// The compound assignments operate in place.
+
 template<typename Scalar>
 UnboundedVector<Scalar>& operator*=(
     UnboundedVector<Scalar>& left,
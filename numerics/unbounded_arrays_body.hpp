@@ -81,14 +81,14 @@ int UnboundedVector<Scalar_>::size() const {
 }
 
 template<typename Scalar_>
-typename std::vector<Scalar_>::const_iterator UnboundedVector<Scalar_>::begin()
-    const {
+typename UnboundedStorage<Scalar_>::const_iterator
+UnboundedVector<Scalar_>::begin() const {
   return data_.cbegin();
 }
 
 template<typename Scalar_>
-typename std::vector<Scalar_>::const_iterator UnboundedVector<Scalar_>::end()
-    const {
+typename UnboundedStorage<Scalar_>::const_iterator
+UnboundedVector<Scalar_>::end() const {
   return data_.cend();
 }
 
@@ -463,12 +463,12 @@ UnboundedUpperTriangularMatrix<Scalar_>::Transpose(
     std::initializer_list<Scalar> const& data,
     int const current_columns,
     int const extra_columns) ->
-  std::vector<Scalar, uninitialized_allocator<Scalar>> {
+  UnboundedStorage<Scalar> {
   // |data| is a trapezoidal slice at the end of the matrix.  This is
   // inconvenient to index, so we start by constructing a rectangular array with
   // |extra_columns| columns and |current_columns + extra_columns| rows padded
   // with junk.
-  std::vector<Scalar, uninitialized_allocator<Scalar>> padded;
+  UnboundedStorage<Scalar> padded;
   {
     padded.reserve(2 * data.size());  // An overestimate.
     int row = 0;
@@ -490,7 +490,7 @@ UnboundedUpperTriangularMatrix<Scalar_>::Transpose(
 
   // Scan the padded array by column and append the part above the diagonal to
   // the result.
-  std::vector<Scalar, uninitialized_allocator<Scalar>> result;
+  UnboundedStorage<Scalar> result;
   result.reserve(data.size());
   int const number_of_rows = current_columns + extra_columns;
   for (int column = 0; column < extra_columns; ++column) {
@@ -551,12 +551,11 @@ UnboundedMatrix<Square<Scalar>> SymmetricSquare(
 
 template<typename Scalar>
 UnboundedVector<Scalar> operator-(UnboundedVector<Scalar> const& right) {
-  std::vector<Scalar> result;
-  result.reserve(right.size());
+  UnboundedVector<Scalar> result(right.size(), uninitialized);
   for (int i = 0; i < right.size(); ++i) {
     result[i] = -right[i];
   }
-  return UnboundedVector<Scalar>(std::move(result));
+  return result;
 }
 
 template<typename Scalar>
@@ -575,12 +574,11 @@ UnboundedVector<Sum<LScalar, RScalar>> operator+(
     UnboundedVector<LScalar> const& left,
     UnboundedVector<RScalar> const& right) {
   CHECK_EQ(left.size(), right.size());
-  std::vector<Sum<LScalar, RScalar>> result;
-  result.resize(right.size());
+  UnboundedVector<Sum<LScalar, RScalar>> result(right.size(), uninitialized);
   for (int i = 0; i < right.size(); ++i) {
     result[i] = left[i] + right[i];
   }
-  return UnboundedVector<Sum<LScalar, RScalar>>(std::move(result));
+  return result;
 }
 
 template<typename LScalar, typename RScalar>
@@ -604,12 +602,12 @@ UnboundedVector<Difference<LScalar, RScalar>> operator-(
     UnboundedVector<LScalar> const& left,
     UnboundedVector<RScalar> const& right) {
   CHECK_EQ(left.size(), right.size());
-  std::vector<Sum<LScalar, RScalar>> result;
-  result.resize(right.size());
+  UnboundedVector<Difference<LScalar, RScalar>> result(right.size(),
+                                                       uninitialized);
   for (int i = 0; i < right.size(); ++i) {
     result[i] = left[i] - right[i];
   }
-  return UnboundedVector<Difference<LScalar, RScalar>>(std::move(result));
+  return result;
 }
 
 template<typename LScalar, typename RScalar>
@@ -618,42 +616,110 @@ UnboundedMatrix<Difference<LScalar, RScalar>> operator-(
     UnboundedMatrix<RScalar> const& right) {
   CHECK_EQ(left.rows(), right.rows());
   CHECK_EQ(left.columns(), right.columns());
-  UnboundedMatrix<Sum<LScalar, RScalar>> result(
+  UnboundedMatrix<Difference<LScalar, RScalar>> result(
       right.rows(), right.columns(), uninitialized);
   for (int i = 0; i < right.rows(); ++i) {
     for (int j = 0; j < right.columns(); ++j) {
-      result(i, j) = left(i, j) + right(i, j);
+      result(i, j) = left(i, j) - right(i, j);
     }
   }
   return result;
 }
 
+template<typename Scalar>
+UnboundedVector<Scalar> operator-(UnboundedVector<Scalar>&& right) {
+  for (int i = 0; i < right.size(); ++i) {
+    right[i] = -right[i];
+  }
+  return std::move(right);
+}
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator-(UnboundedMatrix<Scalar>&& right) {
+  for (int i = 0; i < right.rows(); ++i) {
+    for (int j = 0; j < right.columns(); ++j) {
+      right(i, j) = -right(i, j);
+    }
+  }
+  return std::move(right);
+}
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator+(UnboundedVector<Scalar>&& left,
+                                  UnboundedVector<Scalar> const& right) {
+  left += right;
+  return std::move(left);
+}
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator+(UnboundedMatrix<Scalar>&& left,
+                                  UnboundedMatrix<Scalar> const& right) {
+  left += right;
+  return std::move(left);
+}
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator-(UnboundedVector<Scalar>&& left,
+                                  UnboundedVector<Scalar> const& right) {
+  left -= right;
+  return std::move(left);
+}
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator-(UnboundedMatrix<Scalar>&& left,
+                                  UnboundedMatrix<Scalar> const& right) {
+  left -= right;
+  return std::move(left);
+}
+
 template<typename Scalar>
 UnboundedVector<Scalar>& operator+=(
     UnboundedVector<Scalar>& left,
     UnboundedVector<Scalar> const& right) {
-  return left = left + right;
+  CHECK_EQ(left.size(), right.size());
+  for (int i = 0; i < right.size(); ++i) {
+    left[i] += right[i];
+  }
+  return left;
 }
 
 template<typename Scalar>
 UnboundedMatrix<Scalar>& operator+=(
     UnboundedMatrix<Scalar>& left,
     UnboundedMatrix<Scalar> const& right) {
-  return left = left + right;
+  CHECK_EQ(left.rows(), right.rows());
+  CHECK_EQ(left.columns(), right.columns());
+  for (int i = 0; i < right.rows(); ++i) {
+    for (int j = 0; j < right.columns(); ++j) {
+      left(i, j) += right(i, j);
+    }
+  }
+  return left;
 }
 
 template<typename Scalar>
 UnboundedVector<Scalar>& operator-=(
     UnboundedVector<Scalar>& left,
     UnboundedVector<Scalar> const& right) {
-  return left = left - right;
+  CHECK_EQ(left.size(), right.size());
+  for (int i = 0; i < right.size(); ++i) {
+    left[i] -= right[i];
+  }
+  return left;
 }
 
 template<typename Scalar>
 UnboundedMatrix<Scalar>& operator-=(
     UnboundedMatrix<Scalar>& left,
     UnboundedMatrix<Scalar> const& right) {
-  return left = left - right;
+  CHECK_EQ(left.rows(), right.rows());
+  CHECK_EQ(left.columns(), right.columns());
+  for (int i = 0; i < right.rows(); ++i) {
+    for (int j = 0; j < right.columns(); ++j) {
+      left(i, j) -= right(i, j);
+    }
+  }
+  return left;
 }
 
 template<typename LScalar, typename RScalar>
@@ -737,28 +803,92 @@ UnboundedMatrix<Quotient<LScalar, RScalar>> operator/(
   return result;
 }
 
+template<typename Scalar>
+UnboundedVector<Scalar> operator*(double const left,
+                                  UnboundedVector<Scalar>&& right) {
+  for (int i = 0; i < right.size(); ++i) {
+    right[i] = left * right[i];
+  }
+  return std::move(right);
+}
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator*(UnboundedVector<Scalar>&& left,
+                                  double const right) {
+  left *= right;
+  return std::move(left);
+}
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator*(double const left,
+                                  UnboundedMatrix<Scalar>&& right) {
+  for (int i = 0; i < right.rows(); ++i) {
+    for (int j = 0; j < right.columns(); ++j) {
+      right(i, j) = left * right(i, j);
+    }
+  }
+  return std::move(right);
+}
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator*(UnboundedMatrix<Scalar>&& left,
+                                  double const right) {
+  left *= right;
+  return std::move(left);
+}
+
+template<typename Scalar>
+UnboundedVector<Scalar> operator/(UnboundedVector<Scalar>&& left,
+                                  double const right) {
+  left /= right;
+  return std::move(left);
+}
+
+template<typename Scalar>
+UnboundedMatrix<Scalar> operator/(UnboundedMatrix<Scalar>&& left,
+                                  double const right) {
+  left /= right;
+  return std::move(left);
+}
+
 template<typename Scalar>
 UnboundedVector<Scalar>& operator*=(UnboundedVector<Scalar>& left,
                                     double const right) {
-  return left = left * right;
+  for (int i = 0; i < left.size(); ++i) {
+    left[i] *= right;
+  }
+  return left;
 }
 
 template<typename Scalar>
 UnboundedMatrix<Scalar>& operator*=(UnboundedMatrix<Scalar>& left,
                                     double const right) {
-  return left = left * right;
+  for (int i = 0; i < left.rows(); ++i) {
+    for (int j = 0; j < left.columns(); ++j) {
+      left(i, j) *= right;
+    }
+  }
+  return left;
 }
 
 template<typename Scalar>
 UnboundedVector<Scalar>& operator/=(UnboundedVector<Scalar>& left,
                                     double const right) {
-  return left = left / right;
+  for (int i = 0; i < left.size(); ++i) {
+    left[i] /= right;
+  }
+  return left;
 }
 
 template<typename Scalar>
 UnboundedMatrix<Scalar>& operator/=(UnboundedMatrix<Scalar>& left,
                                     double const right) {
-  return left = left / right;
+  for (int i = 0; i < left.rows(); ++i) {
+    for (int j = 0; j < left.columns(); ++j) {
+      left(i, j) /= right;
+    }
+  }
+  return left;
 }
 
 template<typename LScalar, typename RScalar>
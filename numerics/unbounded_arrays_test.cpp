@@ -110,6 +110,51 @@ TEST_F(UnboundedArraysTest, MultiplicationDivision) {
                  661611, 1070697, 1732308, 2803005}), m4_ * m4_);
 }
 
+TEST_F(UnboundedArraysTest, AdditiveGroups) {
+  UnboundedVector<double> const w4({1, 2, 3, 4});
+  EXPECT_EQ(UnboundedVector<double>({3, 3, -1, -4}), -v4_);
+  EXPECT_EQ(UnboundedVector<double>({-2, -1, 4, 8}), v4_ + w4);
+  EXPECT_EQ(UnboundedVector<double>({-4, -5, -2, 0}), v4_ - w4);
+  EXPECT_EQ(UnboundedMatrix<double>({  0,   0,   0,    0,
+                                       0,   0,   0,    0,
+                                       0,   0,   0,    0,
+                                       0,   0,   0,    0}), m4_ - m4_);
+
+  // The operators taking rvalues reuse their storage.
+  EXPECT_EQ(UnboundedVector<double>({3, 3, -1, -4}),
+            -UnboundedVector<double>(v4_));
+  EXPECT_EQ(UnboundedVector<double>({-2, -1, 4, 8}),
+            UnboundedVector<double>(v4_) + w4);
+  EXPECT_EQ(UnboundedVector<double>({-4, -5, -2, 0}),
+            UnboundedVector<double>(v4_) - w4);
+  EXPECT_EQ(UnboundedVector<double>({-6, -6, 2, 8}),
+            2.0 * UnboundedVector<double>(v4_));
+  EXPECT_EQ(UnboundedVector<double>({-1.5, -1.5, 0.5, 2.0}),
+            UnboundedVector<double>(v4_) / 2.0);
+  EXPECT_EQ(2.0 * m4_, UnboundedMatrix<double>(m4_) * 2.0);
+  EXPECT_EQ(m4_ + m4_, UnboundedMatrix<double>(m4_) + m4_);
+
+  UnboundedVector<double> u4 = v4_;
+  u4 += w4;
+  EXPECT_EQ(v4_ + w4, u4);
+  u4 -= w4;
+  EXPECT_EQ(v4_, u4);
+  u4 *= 4.0;
+  EXPECT_EQ(4.0 * v4_, u4);
+  u4 /= 2.0;
+  EXPECT_EQ(v4_ * 2.0, u4);
+
+  UnboundedMatrix<double> n4 = m4_;
+  n4 += m4_;
+  EXPECT_EQ(2.0 * m4_, n4);
+  n4 -= m4_;
+  EXPECT_EQ(m4_, n4);
+  n4 *= 3.0;
+  EXPECT_EQ(m4_ * 3.0, n4);
+  n4 /= 3.0;
+  EXPECT_EQ(m4_, n4);
+}
+
 TEST_F(UnboundedArraysTest, Algebra) {
   EXPECT_EQ(3270, TransposedView{v3_} * v3_);  // NOLINT
 }
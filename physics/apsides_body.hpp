@@ -6,6 +6,7 @@
 #include <optional>
 #include <vector>
 
+#include "absl/container/btree_map.h"
 #include "base/array.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/r3_element.hpp"
@@ -59,9 +60,12 @@ void ComputeApsides(Trajectory<Frame> const& reference,
                     int const max_points,
                     DiscreteTrajectory<Frame>& apoapsides,
                     DiscreteTrajectory<Frame>& periapsides) {
+  // The state of the previous point is only used when the derivative of the
+  // squared distance changes sign, i.e., a couple of times per revolution, so
+  // we only keep the cheap quantities and compute the squared distances
+  // lazily.
   std::optional<Instant> previous_time;
-  std::optional<DegreesOfFreedom<Frame>> previous_degrees_of_freedom;
-  std::optional<Square<Length>> previous_squared_distance;
+  std::optional<Displacement<Frame>> previous_displacement;
   std::optional<Variation<Square<Length>>>
       previous_squared_distance_derivative;
 
@@ -79,7 +83,6 @@ void ComputeApsides(Trajectory<Frame> const& reference,
         reference.EvaluateDegreesOfFreedom(time);
     RelativeDegreesOfFreedom<Frame> const relative =
         degrees_of_freedom - body_degrees_of_freedom;
-    Square<Length> const squared_distance = relative.displacement().Norm²();
     // This is the derivative of |squared_distance|.
     Variation<Square<Length>> const squared_distance_derivative =
         2.0 * InnerProduct(relative.displacement(), relative.velocity());
@@ -87,16 +90,17 @@ void ComputeApsides(Trajectory<Frame> const& reference,
     if (previous_squared_distance_derivative &&
         Sign(squared_distance_derivative) !=
             Sign(*previous_squared_distance_derivative)) {
-      CHECK(previous_time &&
-            previous_degrees_of_freedom &&
-            previous_squared_distance);
+      CHECK(previous_time && previous_displacement);
+      Square<Length> const previous_squared_distance =
+          previous_displacement->Norm²();
+      Square<Length> const squared_distance = relative.displacement().Norm²();
 
       // The derivative of |squared_distance| changed sign.  Construct a Hermite
       // approximation of |squared_distance| and find its extrema.
       Hermite3<Instant, Square<Length>> const
           squared_distance_approximation(
               {*previous_time, time},
-              {*previous_squared_distance, squared_distance},
+              {previous_squared_distance, squared_distance},
               {*previous_squared_distance_derivative,
                squared_distance_derivative});
       BoundedArray<Instant, 2> const extrema =
@@ -149,8 +153,7 @@ void ComputeApsides(Trajectory<Frame> const& reference,
     }
 
     previous_time = time;
-    previous_degrees_of_freedom = degrees_of_freedom;
-    previous_squared_distance = squared_distance;
+    previous_displacement = relative.displacement();
     previous_squared_distance_derivative = squared_distance_derivative;
   }
 }
@@ -176,14 +179,24 @@ std::vector<Interval<Instant>> ComputeCollisionIntervals(
   auto const max_radius² = Pow<2>(reference_body.max_radius());
 
   // Construct the set of all extrema times (apsides and extremities).  In this
-  // set, apoapsides and periapsides alternate.
-  absl::btree_set<Instant> apsides_times{trajectory.t_min(),
-                                         trajectory.t_max()};
+  // set, apoapsides and periapsides alternate.  Each time is mapped to the
+  // squared distance at that time, which is computed exactly once: the loops
+  // below examine most apsides twice, once when looking for the beginning of
+  // an interval and once when looking for its end.
+  absl::btree_map<Instant, Square<Length>> apsides_times;
+  auto const insert = [&apsides_times,
+                       &squared_distance_from_centre](Instant const& time) {
+    if (!apsides_times.contains(time)) {
+      apsides_times.emplace(time, squared_distance_from_centre(time));
+    }
+  };
+  insert(trajectory.t_min());
+  insert(trajectory.t_max());
   for (auto const& [time, _] : apoapsides) {
-    apsides_times.insert(time);
+    insert(time);
   }
   for (auto const& [time, _] : periapsides) {
-    apsides_times.insert(time);
+    insert(time);
   }
   if (apsides_times.size() < 2) {
     return {};
@@ -192,13 +205,12 @@ std::vector<Interval<Instant>> ComputeCollisionIntervals(
   // Initialize the iterators.  After this block |it| designates the first
   // periapsis and |previous_it| designates the previous apoapsis, if there is
   // one, or is past the end.
-  absl::btree_set<Instant>::const_iterator it;
-  absl::btree_set<Instant>::const_iterator previous_it;
+  absl::btree_map<Instant, Square<Length>>::const_iterator it;
+  absl::btree_map<Instant, Square<Length>>::const_iterator previous_it;
   {
     auto const first_it = apsides_times.begin();
     auto const second_it = std::next(first_it);
-    if (squared_distance_from_centre(*first_it) <
-        squared_distance_from_centre(*second_it)) {
+    if (first_it->second < second_it->second) {
       previous_it = apsides_times.end();
       it = first_it;
     } else {
@@ -211,10 +223,10 @@ std::vector<Interval<Instant>> ComputeCollisionIntervals(
   for (; it != apsides_times.end(); previous_it = it, ++it) {
     // Here |it| designates a periapsis, and |previous_it| the previous
     // apoapsis, if any.
-    Instant const periapsis_time = *it;
+    Instant const periapsis_time = it->first;
 
     // No collision is possible if the periapsis is above |max_radius|.
-    if (squared_distance_from_centre(periapsis_time) < max_radius²) {
+    if (it->second < max_radius²) {
       Interval<Instant> interval;
       if (previous_it == apsides_times.end()) {
         // No previous periapsis can only happen the first time through the
@@ -222,10 +234,10 @@ std::vector<Interval<Instant>> ComputeCollisionIntervals(
         CHECK_EQ(periapsis_time, trajectory.t_min());
         interval.min = periapsis_time;
       } else {
-        Instant const apoapsis_time = *previous_it;
+        Instant const apoapsis_time = previous_it->first;
         CHECK_LE(apoapsis_time, periapsis_time);
 
-        if (squared_distance_from_centre(apoapsis_time) > max_radius²) {
+        if (previous_it->second > max_radius²) {
           // The periapsis is below |max_radius| and the preceding apoapsis is
           // above.  Find the intersection point.
           interval.min = Brent(
@@ -248,7 +260,7 @@ std::vector<Interval<Instant>> ComputeCollisionIntervals(
       // of |apsides_time|.  When entering this loop |it| denotes a periapsis
       // and |previous_it| the preceding apoapsis, if any.
       do {
-        Instant const periapsis_time = *it;
+        Instant const periapsis_time = it->first;
         previous_it = it;
         ++it;
         if (it == apsides_times.end()) {
@@ -257,10 +269,10 @@ std::vector<Interval<Instant>> ComputeCollisionIntervals(
         }
         // Here |it| designates an apoapsis, and |previous_it| the previous
         // periapsis.
-        Instant const apoapsis_time = *it;
+        Instant const apoapsis_time = it->first;
         CHECK_LE(periapsis_time, apoapsis_time);
 
-        if (squared_distance_from_centre(apoapsis_time) > max_radius²) {
+        if (it->second > max_radius²) {
           // The periapsis is below |max_radius| and the following apoapsis is
           // above.  Find the intersection point.
           interval.max = Brent(
@@ -325,11 +337,22 @@ ComputeFirstCollision(
 
   std::int64_t number_of_evaluations = 0;
 
-  auto height_above_terrain_at_time = [&number_of_evaluations,
+  // Each call to |radius| is normally a round trip to the managed code, which
+  // is costly.  When an interval is subdivided, the interpolation evaluates the
+  // height again at the ends of the subintervals, so we remember the heights
+  // that have already been computed.
+  absl::btree_map<Instant, Length> heights_above_terrain;
+
+  auto height_above_terrain_at_time = [&heights_above_terrain,
+                                       &number_of_evaluations,
                                        &radius,
                                        &reference,
                                        &reference_body,
                                        &trajectory](Instant const& t) {
+    if (auto const it = heights_above_terrain.find(t);
+        it != heights_above_terrain.end()) {
+      return it->second;
+    }
     ++number_of_evaluations;
     auto const reference_position = reference.EvaluatePosition(t);
     auto const trajectory_position = trajectory.EvaluatePosition(t);
@@ -344,9 +367,12 @@ ComputeFirstCollision(
     SphericalCoordinates<Length> const spherical_coordinates =
         displacement_in_surface.coordinates().ToSpherical();
 
-    return spherical_coordinates.radius -
-           radius(spherical_coordinates.latitude,
-                  spherical_coordinates.longitude);
+    Length const height_above_terrain =
+        spherical_coordinates.radius -
+        radius(spherical_coordinates.latitude,
+               spherical_coordinates.longitude);
+    heights_above_terrain.emplace(t, height_above_terrain);
+    return height_above_terrain;
   };
 
   // Subdivide the interpolant if it could have real roots given the current
@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -230,7 +231,13 @@ TEST_F(ApsidesTest, ComputeFirstCollision) {
 
   // The celestial is infinite in the z direction and has four lobes in the x-y
   // plane.  Think of a LEGO® axle.
-  auto radius = [](Angle const& latitude, Angle const& longitude) {
+  std::set<std::pair<Angle, Angle>> queried_coordinates;
+  int repeated_queries = 0;
+  auto radius = [&queried_coordinates, &repeated_queries](
+                    Angle const& latitude, Angle const& longitude) {
+    if (!queried_coordinates.emplace(latitude, longitude).second) {
+      ++repeated_queries;
+    }
     return (Cos(4 * longitude) + 2) * Metre;
   };
 
@@ -267,6 +274,8 @@ TEST_F(ApsidesTest, ComputeFirstCollision) {
                             /*max_error=*/2e-4 * Metre,
                             radius);
   auto const& collision = maybe_collision.value();
+  // The radius is never requested twice for the same point.
+  EXPECT_EQ(0, repeated_queries);
 
   EXPECT_THAT(collision.time - t0,
               IsNear(-1.43862_(1) * Second));
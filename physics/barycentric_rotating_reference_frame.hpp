@@ -124,6 +124,7 @@ class BarycentricRotatingReferenceFrame
       Position<InertialFrame> const& q) const override;
   AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const override;
+  bool MotionIsCacheable() const override;
 
   // Implementation helper that avoids evaluating the degrees of freedom and the
   // accelerations multiple times.
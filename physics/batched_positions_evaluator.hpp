@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "numerics/polynomial.hpp"
+#include "physics/continuous_trajectory.hpp"
+
+namespace principia {
+namespace physics {
+namespace _batched_positions_evaluator {
+namespace internal {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::numerics::_polynomial;
+using namespace principia::physics::_continuous_trajectory;
+
+// Evaluates the positions of a collection of trajectories at the same instant.
+// The polynomials of the trajectories that apply at that instant are packed in
+// a structure of arrays, padded to a common degree, and evaluated in a single
+// loop over the trajectories, which the compiler may vectorize.  The packed
+// coefficients are reused as long as the polynomials don't change, which is
+// efficient when the trajectories are appended to at the same times, as is the
+// case for an |Ephemeris|.  The results may differ from those of
+// |ContinuousTrajectory::EvaluatePosition| in the last bits, because the
+// polynomials are evaluated using Horner's scheme.  This class is not
+// thread-safe, and is intended to be used as a |thread_local|.
+template<typename Frame>
+class BatchedPositionsEvaluator {
+ public:
+  // Sets |positions| to the positions of the |trajectories| at |time|, which
+  // must be in the range of all the trajectories.
+  void EvaluatePositions(
+      std::vector<not_null<ContinuousTrajectory<Frame>*>> const& trajectories,
+      Instant const& time,
+      std::vector<Position<Frame>>& positions);
+
+ private:
+  using Polynomial = numerics::_polynomial::Polynomial<Position<Frame>,
+                                                       Instant>;
+
+  // Packs the coefficients of the polynomials of |polynomials_|.
+  void Pack();
+
+  // Tries to pack the given polynomial, for the trajectory at index |b|,
+  // assuming that it's in the monomial basis with the given |degree|.
+  // Returns false if it's not.
+  template<int degree>
+  bool PackIfDegree(Polynomial const& polynomial, std::size_t b);
+
+  // The polynomials whose coefficients are packed.  We hold them to make sure
+  // that they are not destroyed, and their addresses reused, while packed.
+  std::vector<std::shared_ptr<Polynomial const>> polynomials_;
+
+  // The common degree of the packed polynomials.
+  int degree_ = 0;
+
+  // The origins of the polynomials, and whether they were packed.  The
+  // polynomials that cannot be packed (e.g., because they come from an old
+  // save) are evaluated separately.
+  std::vector<Instant> origins_;
+  std::vector<bool> packed_;
+
+  // The coefficient of degree k of the coordinate c (x, y, or z) of the
+  // polynomial b is at index (3 * k + c) * polynomials_.size() + b, in SI
+  // units.  The coefficients beyond the degree of a polynomial are zero.
+  std::vector<double> coefficients_;
+
+  // Buffers used during the evaluation.
+  std::vector<double> Δt_;
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> z_;
+};
+
+}  // namespace internal
+
+using internal::BatchedPositionsEvaluator;
+
+}  // namespace _batched_positions_evaluator
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/batched_positions_evaluator_body.hpp"
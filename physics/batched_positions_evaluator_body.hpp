@@ -0,0 +1,157 @@
+#pragma once
+
+#include "physics/batched_positions_evaluator.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "geometry/grassmann.hpp"
+#include "geometry/r3_element.hpp"
+#include "numerics/polynomial_evaluators.hpp"
+#include "numerics/polynomial_in_monomial_basis.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace physics {
+namespace _batched_positions_evaluator {
+namespace internal {
+
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_r3_element;
+using namespace principia::numerics::_polynomial_evaluators;
+using namespace principia::numerics::_polynomial_in_monomial_basis;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+
+// The highest degree of the polynomials that we know how to pack.  This is the
+// highest degree produced by |ContinuousTrajectory|.
+constexpr int max_packed_degree = 17;
+
+template<typename Scalar, typename Frame>
+R3Element<double> CoordinatesInSIUnits(Vector<Scalar, Frame> const& vector) {
+  return vector.coordinates() / si::Unit<Scalar>;
+}
+
+template<typename Frame>
+R3Element<double> CoordinatesInSIUnits(Position<Frame> const& position) {
+  return CoordinatesInSIUnits(position - Frame::origin);
+}
+
+template<typename Frame>
+void BatchedPositionsEvaluator<Frame>::EvaluatePositions(
+    std::vector<not_null<ContinuousTrajectory<Frame>*>> const& trajectories,
+    Instant const& time,
+    std::vector<Position<Frame>>& positions) {
+  std::size_t const n = trajectories.size();
+
+  // Check if the packed polynomials are still applicable.  The lookups are
+  // cheap because the trajectories keep track of the last polynomial accessed.
+  bool must_pack = polynomials_.size() != n;
+  polynomials_.resize(n);
+  for (std::size_t b = 0; b < n; ++b) {
+    auto polynomial = trajectories[b]->PolynomialForInstant(time);
+    if (polynomials_[b] != polynomial) {
+      polynomials_[b] = std::move(polynomial);
+      must_pack = true;
+    }
+  }
+  if (must_pack) {
+    Pack();
+  }
+
+  // Evaluate all the polynomials using Horner's scheme.  The innermost loops
+  // have no dependencies between iterations.
+  Δt_.resize(n);
+  for (std::size_t b = 0; b < n; ++b) {
+    Δt_[b] = (time - origins_[b]) / si::Unit<Time>;
+  }
+  double const* const c = coefficients_.data();
+  std::size_t const stride = n;
+  x_.assign(c + 3 * degree_ * stride, c + (3 * degree_ + 1) * stride);
+  y_.assign(c + (3 * degree_ + 1) * stride, c + (3 * degree_ + 2) * stride);
+  z_.assign(c + (3 * degree_ + 2) * stride, c + (3 * degree_ + 3) * stride);
+  for (int k = degree_ - 1; k >= 0; --k) {
+    double const* const cx = c + (3 * k) * stride;
+    double const* const cy = c + (3 * k + 1) * stride;
+    double const* const cz = c + (3 * k + 2) * stride;
+    for (std::size_t b = 0; b < n; ++b) {
+      x_[b] = x_[b] * Δt_[b] + cx[b];
+      y_[b] = y_[b] * Δt_[b] + cy[b];
+      z_[b] = z_[b] * Δt_[b] + cz[b];
+    }
+  }
+
+  positions.clear();
+  positions.reserve(n);
+  for (std::size_t b = 0; b < n; ++b) {
+    if (packed_[b]) {
+      positions.push_back(
+          Frame::origin +
+          Displacement<Frame>({x_[b] * Metre, y_[b] * Metre, z_[b] * Metre}));
+    } else {
+      positions.push_back((*polynomials_[b])(time));
+    }
+  }
+}
+
+template<typename Frame>
+void BatchedPositionsEvaluator<Frame>::Pack() {
+  std::size_t const n = polynomials_.size();
+  degree_ = 0;
+  for (auto const& polynomial : polynomials_) {
+    if (polynomial->degree() <= max_packed_degree) {
+      degree_ = std::max(degree_, polynomial->degree());
+    }
+  }
+  origins_.assign(n, Instant());
+  packed_.assign(n, false);
+  coefficients_.assign(3 * (degree_ + 1) * n, 0.0);
+  for (std::size_t b = 0; b < n; ++b) {
+    auto const& polynomial = *polynomials_[b];
+    packed_[b] = [this, &polynomial, b]<int... degrees>(
+        std::integer_sequence<int, degrees...>) {
+      return (this->template PackIfDegree<degrees>(polynomial, b) || ...);
+    }(std::make_integer_sequence<int, max_packed_degree + 1>());
+  }
+}
+
+template<typename Frame>
+template<int degree>
+bool BatchedPositionsEvaluator<Frame>::PackIfDegree(
+    Polynomial const& polynomial,
+    std::size_t const b) {
+  using PolynomialOfDegree = PolynomialInMonomialBasis<Position<Frame>,
+                                                       Instant,
+                                                       degree,
+                                                       EstrinEvaluator>;
+  if (polynomial.degree() != degree) {
+    return false;
+  }
+  auto const* const polynomial_of_degree =
+      dynamic_cast<PolynomialOfDegree const*>(&polynomial);
+  if (polynomial_of_degree == nullptr) {
+    return false;
+  }
+
+  origins_[b] = polynomial_of_degree->origin();
+  std::size_t const n = polynomials_.size();
+  auto const& coefficients = polynomial_of_degree->coefficients();
+  [this, b, n, &coefficients]<std::size_t... k>(std::index_sequence<k...>) {
+    ((coefficients_[(3 * k) * n + b] =
+          CoordinatesInSIUnits(std::get<k>(coefficients)).x,
+      coefficients_[(3 * k + 1) * n + b] =
+          CoordinatesInSIUnits(std::get<k>(coefficients)).y,
+      coefficients_[(3 * k + 2) * n + b] =
+          CoordinatesInSIUnits(std::get<k>(coefficients)).z),
+     ...);
+  }(std::make_index_sequence<degree + 1>());
+  return true;
+}
+
+}  // namespace internal
+}  // namespace _batched_positions_evaluator
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,120 @@
+#include "physics/batched_positions_evaluator.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "geometry/frame.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "gtest/gtest.h"
+#include "physics/continuous_trajectory.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "serialization/geometry.pb.h"
+#include "testing_utilities/matchers.hpp"
+
+namespace principia {
+namespace physics {
+
+using namespace principia::base::_not_null;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::physics::_batched_positions_evaluator;
+using namespace principia::physics::_continuous_trajectory;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+
+class BatchedPositionsEvaluatorTest : public ::testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      Inertial,
+                      Handedness::Right,
+                      serialization::Frame::TEST>;
+
+  BatchedPositionsEvaluatorTest() {
+    for (int i = 1; i <= 5; ++i) {
+      Length const radius = i * 1e9 * Metre;
+      Time const period = i * i * 1e6 * Second;
+      AngularFrequency const ω = 2 * π * Radian / period;
+      auto& trajectory = owned_trajectories_.emplace_back(
+          std::make_unique<ContinuousTrajectory<World>>(
+              step_, /*tolerance=*/1 * Milli(Metre)));
+      for (int j = 1; j <= number_of_steps_; ++j) {
+        Instant const t = t0_ + j * step_;
+        Angle const angle = ω * (t - t0_);
+        EXPECT_OK(trajectory->Append(
+            t,
+            DegreesOfFreedom<World>(
+                World::origin + Displacement<World>({radius * Cos(angle),
+                                                     radius * Sin(angle),
+                                                     0 * Metre}),
+                Velocity<World>({-radius * ω * Sin(angle) / Radian,
+                                 radius * ω * Cos(angle) / Radian,
+                                 0 * Metre / Second}))));
+      }
+      trajectories_.push_back(trajectory.get());
+    }
+  }
+
+  Instant const t0_;
+  Time const step_ = 1000 * Second;
+  int const number_of_steps_ = 801;
+  std::vector<not_null<std::unique_ptr<ContinuousTrajectory<World>>>>
+      owned_trajectories_;
+  std::vector<not_null<ContinuousTrajectory<World>*>> trajectories_;
+};
+
+TEST_F(BatchedPositionsEvaluatorTest, MatchesTrajectories) {
+  BatchedPositionsEvaluator<World> evaluator;
+  std::vector<Position<World>> positions;
+  Instant const t_min = trajectories_.front()->t_min();
+  Instant const t_max = trajectories_.front()->t_max();
+  // Use a step that is not commensurate with the step of the trajectories to
+  // hit each polynomial multiple times at different places.
+  for (Instant t = t_min; t <= t_max; t += 0.37 * step_) {
+    evaluator.EvaluatePositions(trajectories_, t, positions);
+    ASSERT_EQ(trajectories_.size(), positions.size());
+    for (int i = 0; i < trajectories_.size(); ++i) {
+      Position<World> const expected = trajectories_[i]->EvaluatePosition(t);
+      // The evaluation schemes differ, so the results are not bit-identical.
+      EXPECT_LT((positions[i] - expected).Norm(),
+                1e-13 * (expected - World::origin).Norm())
+          << i << " " << t;
+    }
+  }
+}
+
+TEST_F(BatchedPositionsEvaluatorTest, ChangingTrajectories) {
+  BatchedPositionsEvaluator<World> evaluator;
+  std::vector<Position<World>> positions;
+  Instant const t = trajectories_.front()->t_min() + 10.5 * step_;
+
+  evaluator.EvaluatePositions(trajectories_, t, positions);
+  EXPECT_EQ(5, positions.size());
+
+  // The evaluator must notice that the trajectories are different.
+  std::vector<not_null<ContinuousTrajectory<World>*>> const reversed(
+      trajectories_.rbegin(), trajectories_.rend());
+  evaluator.EvaluatePositions(reversed, t, positions);
+  for (int i = 0; i < reversed.size(); ++i) {
+    Position<World> const expected = reversed[i]->EvaluatePosition(t);
+    EXPECT_LT((positions[i] - expected).Norm(),
+              1e-13 * (expected - World::origin).Norm()) << i;
+  }
+
+  std::vector<not_null<ContinuousTrajectory<World>*>> const first_two(
+      trajectories_.begin(), trajectories_.begin() + 2);
+  evaluator.EvaluatePositions(first_two, t, positions);
+  EXPECT_EQ(2, positions.size());
+}
+
+}  // namespace physics
+}  // namespace principia
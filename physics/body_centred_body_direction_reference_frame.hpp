@@ -94,6 +94,7 @@ class BodyCentredBodyDirectionReferenceFrame
       Position<InertialFrame> const& q) const override;
   AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const override;
+  bool MotionIsCacheable() const override;
 
   // Implementation helper that avoids evaluating the degrees of freedom and the
   // accelerations multiple times.
@@ -252,6 +252,14 @@ BodyCentredBodyDirectionReferenceFrame<InertialFrame, ThisFrame>::ToThisFrame(
              primary_degrees_of_freedom.velocity());
 }
 
+template<typename InertialFrame, typename ThisFrame>
+bool BodyCentredBodyDirectionReferenceFrame<InertialFrame, ThisFrame>::
+MotionIsCacheable() const {
+  // The primary trajectory, if not that of a body, may be rewritten (e.g.,
+  // it may be the prediction of a vessel).
+  return primary_ != nullptr;
+}
+
 }  // namespace internal
 }  // namespace _body_centred_body_direction_reference_frame
 }  // namespace physics
@@ -282,5 +282,61 @@ TEST_F(BodyCentredBodyDirectionReferenceFrameTest, ConstructFromOneBody) {
   }
 }
 
+// The motion of a frame defined by a trajectory that gets rewritten must not be
+// reused from the per-thread cache.
+TEST_F(BodyCentredBodyDirectionReferenceFrameTest, MutatedTrajectory) {
+  DiscreteTrajectory<ICRS> big_trajectory;
+  auto const append_big_points = [this, &big_trajectory](
+                                     Displacement<ICRS> const& offset) {
+    for (Time t; t <= period_; t += period_ / 16) {
+      auto const big_dof =
+          ephemeris_->trajectory(big_)->EvaluateDegreesOfFreedom(t0_ + t);
+      EXPECT_OK(big_trajectory.Append(
+          t0_ + t,
+          DegreesOfFreedom<ICRS>(big_dof.position() + offset,
+                                 big_dof.velocity())));
+    }
+  };
+  append_big_points(Displacement<ICRS>());
+  BodyCentredBodyDirectionReferenceFrame<ICRS, BigSmallFrame> const
+      big_small_from_discrete{
+          ephemeris_.get(),
+          [&t = big_trajectory]() -> auto& { return t; },
+          small_};
+
+  Instant const t = t0_ + period_ / 2;
+  DegreesOfFreedom<BigSmallFrame> const point_dof =
+      {Displacement<BigSmallFrame>({10 * Metre, 20 * Metre, 30 * Metre}) +
+           BigSmallFrame::origin,
+       Velocity<BigSmallFrame>({3 * Metre / Second,
+                                2 * Metre / Second,
+                                1 * Metre / Second})};
+  auto const acceleration_before =
+      big_small_from_discrete.GeometricAcceleration(t, point_dof);
+  auto const potential_before =
+      big_small_from_discrete.GeometricPotential(t, point_dof.position());
+
+  big_trajectory.clear();
+  append_big_points(Displacement<ICRS>({1 * Kilo(Metre),
+                                        2 * Kilo(Metre),
+                                        3 * Kilo(Metre)}));
+  BodyCentredBodyDirectionReferenceFrame<ICRS, BigSmallFrame> const
+      big_small_from_mutated{
+          ephemeris_.get(),
+          [&t = big_trajectory]() -> auto& { return t; },
+          small_};
+  auto const acceleration_after =
+      big_small_from_discrete.GeometricAcceleration(t, point_dof);
+  auto const potential_after =
+      big_small_from_discrete.GeometricPotential(t, point_dof.position());
+  EXPECT_NE(acceleration_before, acceleration_after);
+  EXPECT_NE(potential_before, potential_after);
+  EXPECT_EQ(big_small_from_mutated.GeometricAcceleration(t, point_dof),
+            acceleration_after);
+  EXPECT_EQ(
+      big_small_from_mutated.GeometricPotential(t, point_dof.position()),
+      potential_after);
+}
+
 }  // namespace physics
 }  // namespace principia
@@ -89,10 +89,14 @@ class BodyCentredNonRotatingReferenceFrame
       Position<InertialFrame> const& q) const override;
   AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const override;
+  bool MotionIsCacheable() const override;
 
   not_null<Ephemeris<InertialFrame> const*> const ephemeris_;
   not_null<MassiveBody const*> const centre_;
   not_null<ContinuousTrajectory<InertialFrame> const*> const centre_trajectory_;
+  // The motion of this frame is a translation followed by this constant map.
+  // It is only the identity for a non-rotating body, so the transforms cannot
+  // in general be reduced to translations.
   OrthogonalMap<InertialFrame, ThisFrame> const orthogonal_map_;
 };
 
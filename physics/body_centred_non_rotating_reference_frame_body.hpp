@@ -123,6 +123,12 @@ MotionOfThisFrame(Instant const& t) const {
                  ComputeGravitationalAccelerationOnMassiveBody(centre_, t));
 }
 
+template<typename InertialFrame, typename ThisFrame>
+bool BodyCentredNonRotatingReferenceFrame<InertialFrame, ThisFrame>::
+MotionIsCacheable() const {
+  return true;
+}
+
 }  // namespace internal
 }  // namespace _body_centred_non_rotating_reference_frame
 }  // namespace physics
@@ -76,6 +76,7 @@ class BodySurfaceReferenceFrame : public RigidReferenceFrame<InertialFrame,
       Position<InertialFrame> const& q) const override;
   AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const override;
+  bool MotionIsCacheable() const override;
 
   not_null<Ephemeris<InertialFrame> const*> const ephemeris_;
   not_null<RotatingBody<InertialFrame> const*> const centre_;
@@ -2,7 +2,9 @@
 
 #include "physics/body_surface_reference_frame.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "geometry/orthogonal_map.hpp"
@@ -51,6 +53,21 @@ template<typename InertialFrame, typename ThisFrame>
 RigidMotion<InertialFrame, ThisFrame>
 BodySurfaceReferenceFrame<InertialFrame, ThisFrame>::ToThisFrameAtTime(
     Instant const& t) const {
+  // The plugin queries this frame many times at the current time (navball,
+  // surface-relative velocities, etc.), so we keep the last result of each
+  // thread.
+  struct CachedMotion {
+    std::uint64_t id;
+    Instant t;
+    std::optional<RigidMotion<InertialFrame, ThisFrame>> motion;
+  };
+  thread_local CachedMotion cached_motion;
+  if (cached_motion.motion.has_value() &&
+      cached_motion.id == this->cache_id() &&
+      cached_motion.t == t) {
+    return *cached_motion.motion;
+  }
+
   DegreesOfFreedom<InertialFrame> const centre_degrees_of_freedom =
       centre_trajectory_->EvaluateDegreesOfFreedom(t);
 
@@ -61,10 +78,12 @@ BodySurfaceReferenceFrame<InertialFrame, ThisFrame>::ToThisFrameAtTime(
       rigid_transformation(centre_degrees_of_freedom.position(),
                            ThisFrame::origin,
                            rotation.template Forget<OrthogonalMap>());
-  return RigidMotion<InertialFrame, ThisFrame>(
-             rigid_transformation,
-             angular_velocity,
-             centre_degrees_of_freedom.velocity());
+  cached_motion.motion.emplace(rigid_transformation,
+                              angular_velocity,
+                              centre_degrees_of_freedom.velocity());
+  cached_motion.id = this->cache_id();
+  cached_motion.t = t;
+  return *cached_motion.motion;
 }
 
 template<typename InertialFrame, typename ThisFrame>
@@ -123,6 +142,12 @@ BodySurfaceReferenceFrame<InertialFrame, ThisFrame>::MotionOfThisFrame(
              acceleration_of_to_frame_origin);
 }
 
+template<typename InertialFrame, typename ThisFrame>
+bool BodySurfaceReferenceFrame<InertialFrame, ThisFrame>::
+MotionIsCacheable() const {
+  return true;
+}
+
 }  // namespace internal
 }  // namespace _body_surface_reference_frame
 }  // namespace physics
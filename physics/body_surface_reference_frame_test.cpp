@@ -187,6 +187,29 @@ TEST_F(BodySurfaceReferenceFrameTest, Inverse) {
   }
 }
 
+TEST_F(BodySurfaceReferenceFrameTest, CachedMotion) {
+  BodySurfaceReferenceFrame<ICRS, BigSmallFrame> const other_frame(
+      ephemeris_.get(), big_);
+  Instant const t1 = t0_ + period_ / 3;
+  Instant const t2 = t0_ + period_ / 2;
+  auto const small_at_t1 = big_frame_->ToThisFrameAtTime(t1)(
+      small_initial_state_);
+  auto const small_at_t2 = big_frame_->ToThisFrameAtTime(t2)(
+      small_initial_state_);
+  EXPECT_NE(small_at_t1, small_at_t2);
+
+  // Interleaved evaluations at different times or for different frames return
+  // the same results as the first evaluations.
+  EXPECT_EQ(small_at_t1,
+            other_frame.ToThisFrameAtTime(t1)(small_initial_state_));
+  EXPECT_EQ(small_at_t2,
+            big_frame_->ToThisFrameAtTime(t2)(small_initial_state_));
+  EXPECT_EQ(small_at_t1,
+            big_frame_->ToThisFrameAtTime(t1)(small_initial_state_));
+  EXPECT_EQ(small_at_t1,
+            big_frame_->ToThisFrameAtTime(t1)(small_initial_state_));
+}
+
 TEST_F(BodySurfaceReferenceFrameTest, GeometricAcceleration) {
   Instant const t = t0_ + period_;
   DegreesOfFreedom<BigSmallFrame> const point_dof =
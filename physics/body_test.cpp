@@ -1,6 +1,7 @@
 #include "physics/body.hpp"
 
 #include <memory>
+#include <vector>
 
 #include "astronomy/epoch.hpp"
 #include "astronomy/frames.hpp"
@@ -10,6 +11,7 @@
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/r3_element.hpp"
+#include "geometry/rotation.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "integrators/methods.hpp"
@@ -43,6 +45,7 @@ using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_r3_element;
+using namespace principia::geometry::_rotation;
 using namespace principia::integrators::_methods;
 using namespace principia::integrators::_symmetric_linear_multistep_integrator;
 using namespace principia::numerics::_legendre_normalization_factor;
@@ -346,6 +349,28 @@ TEST_F(BodyTest, AllFrames) {
   TestRotatingBody<serialization::Frame::TestTag, serialization::Frame::TO>();
 }
 
+TEST_F(BodyTest, SurfaceFrame) {
+  using SurfaceFrame = Frame<struct SurfaceFrameTag>;
+  std::vector<Instant> times;
+  for (int i = -5; i <= 5; ++i) {
+    times.push_back(Instant() + i * 1e7 * Second);
+  }
+  auto const from_surface_frames =
+      rotating_body_.FromSurfaceFrame<SurfaceFrame>(times);
+  ASSERT_EQ(times.size(), from_surface_frames.size());
+  for (int i = 0; i < times.size(); ++i) {
+    Rotation<SurfaceFrame, World> const expected(
+        π / 2 * Radian + right_ascension_of_pole_,
+        π / 2 * Radian - declination_of_pole_,
+        rotating_body_.AngleAt(times[i]),
+        EulerAngles::ZXZ,
+        DefinesFrame<SurfaceFrame>{});
+    EXPECT_EQ(expected,
+              rotating_body_.FromSurfaceFrame<SurfaceFrame>(times[i]));
+    EXPECT_EQ(expected, from_surface_frames[i]);
+  }
+}
+
 #if !defined(_DEBUG)
 
 // Check that the rotation of the Earth gives the right solar noon.
@@ -1,13 +1,15 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 
-#include "absl/container/btree_map.h"
 #include "absl/container/btree_set.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/instant.hpp"
 #include "google/protobuf/repeated_field.h"
 #include "quantities/quantities.hpp"
@@ -18,6 +20,7 @@ namespace _checkpointer {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_instant;
 using namespace principia::quantities::_quantities;
 
@@ -49,8 +52,30 @@ class Checkpointer {
   using Reader =
       std::function<absl::Status(typename Message::Checkpoint const&)>;
 
+  // A function that captures the state of an object and returns a |Writer|
+  // that writes that state to a checkpoint.  The capture is expected to be
+  // cheap, and the resulting |Writer| must not access the object, as it runs
+  // asynchronously.
+  using Snapshotter = std::function<Writer()>;
+
+  // Specifies how the old checkpoints are thinned by |ThinnableCheckpoints|.
+  // The age of a checkpoint is measured from a reference time.  The
+  // checkpoints whose age is at most |dense_span| are all retained.  The
+  // checkpoints whose age is in (2ᵏ⁻¹ |dense_span|, 2ᵏ |dense_span|] are only
+  // retained if they are at least 2ᵏ |spacing| older than the next retained
+  // checkpoint.  If |spacing| is the spacing of the dense checkpoints, this
+  // retains about 1 in 2ᵏ checkpoints, so the number of checkpoints grows
+  // logarithmically with the age of the oldest one.
+  struct RetentionPolicy {
+    Time dense_span;
+    Time spacing;
+  };
+
   Checkpointer(Writer writer, Reader reader);
 
+  // Waits for the checkpoints being written asynchronously.
+  ~Checkpointer();
+
   // Returns the oldest checkpoint in this object, or +∞ if no checkpoint was
   // ever created.
   Instant oldest_checkpoint() const EXCLUDES(lock_);
@@ -91,6 +116,30 @@ class Checkpointer {
                                  Time const& max_time_between_checkpoints)
       EXCLUDES(lock_);
 
+  // Same as above, but the checkpoint is written asynchronously: |snapshotter|
+  // is called synchronously and the |Writer| that it returns is run on a
+  // background thread.  The functions of this class that observe the
+  // checkpoints wait until the pending ones have been written, so the
+  // asynchrony is not observable by the clients, except that this function
+  // returns faster.
+  bool WriteToCheckpointIfNeeded(Instant const& t,
+                                 Time const& max_time_between_checkpoints,
+                                 Snapshotter const& snapshotter)
+      EXCLUDES(lock_);
+
+  // Returns the checkpoints strictly between the oldest checkpoint and |t| that
+  // are not retained by |policy|, the age of a checkpoint being its distance to
+  // |t|.  The oldest checkpoint and the checkpoints at or after |t| are always
+  // retained.
+  absl::btree_set<Instant> ThinnableCheckpoints(
+      Instant const& t,
+      RetentionPolicy const& policy) const EXCLUDES(lock_);
+
+  // Removes the checkpoints at |times|, if they exist.  The caller must ensure
+  // that these checkpoints are not being read concurrently.
+  void RemoveCheckpoints(absl::btree_set<Instant> const& times)
+      EXCLUDES(lock_);
+
   // Calls the |Reader| passed at construction to reconstruct an object using
   // the oldest checkpoint.  Returns an error if this object contains no
   // checkpoint or if the |Reader| returns one.
@@ -115,6 +164,10 @@ class Checkpointer {
   // Same as above, but uses the reader passed at construction.
   absl::Status ReadFromCheckpointAt(Instant const& t) const EXCLUDES(lock_);
 
+  // Returns an estimate of the number of bytes used by this object, including
+  // the checkpoints.
+  std::int64_t MemoryFootprint() const EXCLUDES(lock_);
+
   void WriteToMessage(not_null<google::protobuf::RepeatedPtrField<
                           typename Message::Checkpoint>*> message) const
       EXCLUDES(lock_);
@@ -125,12 +178,26 @@ class Checkpointer {
           message);
 
  private:
-  using CheckpointsByTime =
-      absl::btree_map<Instant, typename Message::Checkpoint>;
+  // A node-based map because the checkpoints are accessed outside of the lock
+  // while other checkpoints may be inserted asynchronously.
+  using CheckpointsByTime = std::map<Instant, typename Message::Checkpoint>;
 
   void WriteToCheckpointLocked(Instant const& t)
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // Returns true if the newest checkpoint, written or pending, is older than
+  // |t| by more than |max_time_between_checkpoints|.
+  bool IsCheckpointNeededLocked(Instant const& t,
+                                Time const& max_time_between_checkpoints) const
+      SHARED_LOCKS_REQUIRED(lock_);
+
+  // Blocks until all the checkpoints written asynchronously have been added to
+  // |checkpoints_|.
+  void AwaitPendingCheckpointsLocked() const SHARED_LOCKS_REQUIRED(lock_);
+
+  // The pool on which the checkpoints are written asynchronously.
+  static ThreadPool<void>& thread_pool();
+
   mutable absl::Mutex lock_;
   Writer const writer_;
   Reader const reader_;
@@ -138,11 +205,24 @@ class Checkpointer {
   // The time field of the Checkpoint message may or may not be set.  The map
   // key is the source of truth.
   CheckpointsByTime checkpoints_;
+
+  // The times of the checkpoints being written asynchronously.  They are not
+  // in |checkpoints_| yet.
+  absl::btree_set<Instant> pending_checkpoints_ GUARDED_BY(lock_);
 };
 
+// The pool on which the reanimators of all the ephemerides and vessels
+// integrate the intervals between checkpoints.  It is shared so that the number
+// of threads doesn't grow with the number of objects being reanimated, and it
+// leaves some of the hardware concurrency to the rest of the plugin.  The
+// reanimations are background work, so they are added with
+// |Priority::Normal|.
+ThreadPool<void>& ReanimationThreadPool();
+
 }  // namespace internal
 
 using internal::Checkpointer;
+using internal::ReanimationThreadPool;
 
 }  // namespace _checkpointer
 }  // namespace physics
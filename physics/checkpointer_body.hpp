@@ -2,7 +2,10 @@
 
 #include "physics/checkpointer.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include "absl/container/btree_set.h"
@@ -17,9 +20,16 @@ Checkpointer<Message>::Checkpointer(Writer writer, Reader reader)
     : writer_(std::move(writer)),
       reader_(std::move(reader)) {}
 
+template<typename Message>
+Checkpointer<Message>::~Checkpointer() {
+  absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
+}
+
 template<typename Message>
 Instant Checkpointer<Message>::oldest_checkpoint() const {
   absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
   if (checkpoints_.empty()) {
     return InfiniteFuture;
   }
@@ -29,6 +39,7 @@ Instant Checkpointer<Message>::oldest_checkpoint() const {
 template<typename Message>
 Instant Checkpointer<Message>::newest_checkpoint() const {
   absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
   if (checkpoints_.empty()) {
     return InfinitePast;
   }
@@ -38,6 +49,7 @@ Instant Checkpointer<Message>::newest_checkpoint() const {
 template<typename Message>
 Instant Checkpointer<Message>::checkpoint_at_or_after(Instant const& t) const {
   absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
   // |it| denotes an entry equal to or greater than |t| (or end).
   auto const it = checkpoints_.lower_bound(t);
   if (it == checkpoints_.cend()) {
@@ -49,6 +61,7 @@ Instant Checkpointer<Message>::checkpoint_at_or_after(Instant const& t) const {
 template<typename Message>
 Instant Checkpointer<Message>::checkpoint_at_or_before(Instant const& t) const {
   absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
   // |it| denotes an entry strictly greater than |t| (or end).
   auto const it = checkpoints_.upper_bound(t);
   if (it == checkpoints_.cbegin()) {
@@ -60,6 +73,7 @@ Instant Checkpointer<Message>::checkpoint_at_or_before(Instant const& t) const {
 template<typename Message>
 absl::btree_set<Instant> Checkpointer<Message>::all_checkpoints() const {
   absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
   absl::btree_set<Instant> result;
   std::transform(
       checkpoints_.cbegin(),
@@ -75,6 +89,7 @@ template<typename Message>
 absl::btree_set<Instant> Checkpointer<Message>::all_checkpoints_at_or_before(
     Instant const& t) const {
   absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
   // |it| denotes an entry strictly greater than |t| (or end).
   auto const it = checkpoints_.upper_bound(t);
   absl::btree_set<Instant> result;
@@ -97,6 +112,7 @@ absl::btree_set<Instant> Checkpointer<Message>::all_checkpoints_between(
   }
 
   absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
   // |it1| denotes an entry greater or equal to |t1| (or end).
   auto const it1 = checkpoints_.lower_bound(t1);
   // |it2| denotes an entry strictly greater than |t2| (or end).
@@ -123,19 +139,90 @@ bool Checkpointer<Message>::WriteToCheckpointIfNeeded(
     Instant const& t,
     Time const& max_time_between_checkpoints) {
   absl::MutexLock l(&lock_);
-  if (checkpoints_.empty() ||
-      max_time_between_checkpoints < t - checkpoints_.crbegin()->first) {
+  if (IsCheckpointNeededLocked(t, max_time_between_checkpoints)) {
     WriteToCheckpointLocked(t);
     return true;
   }
   return false;
 }
 
+template<typename Message>
+bool Checkpointer<Message>::WriteToCheckpointIfNeeded(
+    Instant const& t,
+    Time const& max_time_between_checkpoints,
+    Snapshotter const& snapshotter) {
+  {
+    absl::MutexLock l(&lock_);
+    if (!IsCheckpointNeededLocked(t, max_time_between_checkpoints)) {
+      return false;
+    }
+    CHECK(!checkpoints_.contains(t) && !pending_checkpoints_.contains(t)) << t;
+    pending_checkpoints_.insert(t);
+  }
+  thread_pool().Add([this, t, writer = snapshotter()]() {
+    typename Message::Checkpoint checkpoint;
+    writer(&checkpoint);
+    absl::MutexLock l(&lock_);
+    checkpoints_.emplace(t, std::move(checkpoint));
+    pending_checkpoints_.erase(t);
+  });
+  return true;
+}
+
+template<typename Message>
+absl::btree_set<Instant> Checkpointer<Message>::ThinnableCheckpoints(
+    Instant const& t,
+    RetentionPolicy const& policy) const {
+  absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
+  absl::btree_set<Instant> result;
+  if (checkpoints_.empty()) {
+    return result;
+  }
+  // |it| denotes an entry greater or equal to |t| (or end).
+  auto it = checkpoints_.lower_bound(t);
+  Instant last_retained = t;
+  Time generation_span = policy.dense_span;
+  Time generation_spacing = policy.spacing;
+  // Walk backwards, skipping the oldest checkpoint.
+  while (it != checkpoints_.cbegin() &&
+         std::prev(it) != checkpoints_.cbegin()) {
+    --it;
+    Instant const& checkpoint = it->first;
+    Time const age = t - checkpoint;
+    if (age <= policy.dense_span) {
+      last_retained = checkpoint;
+      continue;
+    }
+    while (age > generation_span) {
+      generation_span *= 2;
+      generation_spacing *= 2;
+    }
+    if (last_retained - checkpoint >= generation_spacing) {
+      last_retained = checkpoint;
+    } else {
+      result.insert(result.begin(), checkpoint);
+    }
+  }
+  return result;
+}
+
+template<typename Message>
+void Checkpointer<Message>::RemoveCheckpoints(
+    absl::btree_set<Instant> const& times) {
+  absl::MutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
+  for (Instant const& time : times) {
+    checkpoints_.erase(time);
+  }
+}
+
 template<typename Message>
 absl::Status Checkpointer<Message>::ReadFromOldestCheckpoint() const {
   typename Message::Checkpoint const* checkpoint = nullptr;
   {
     absl::ReaderMutexLock l(&lock_);
+    AwaitPendingCheckpointsLocked();
     if (checkpoints_.empty()) {
       return absl::NotFoundError("No checkpoint");
     }
@@ -149,6 +236,7 @@ absl::Status Checkpointer<Message>::ReadFromNewestCheckpoint() const {
   typename Message::Checkpoint const* checkpoint = nullptr;
   {
     absl::ReaderMutexLock l(&lock_);
+    AwaitPendingCheckpointsLocked();
     if (checkpoints_.empty()) {
       return absl::NotFoundError("No checkpoint");
     }
@@ -163,6 +251,7 @@ absl::Status Checkpointer<Message>::ReadFromCheckpointAtOrBefore(
   typename Message::Checkpoint const* checkpoint = nullptr;
   {
     absl::ReaderMutexLock l(&lock_);
+    AwaitPendingCheckpointsLocked();
     // |it| denotes an entry strictly greater than |t| (or end).
     auto const it = checkpoints_.upper_bound(t);
     if (it == checkpoints_.cbegin()) {
@@ -180,6 +269,7 @@ absl::Status Checkpointer<Message>::ReadFromCheckpointAt(
   typename CheckpointsByTime::const_iterator it;
   {
     absl::ReaderMutexLock l(&lock_);
+    AwaitPendingCheckpointsLocked();
     it = checkpoints_.find(t);
     if (it == checkpoints_.end()) {
       return absl::NotFoundError("No checkpoint found");
@@ -194,11 +284,23 @@ absl::Status Checkpointer<Message>::ReadFromCheckpointAt(
   return ReadFromCheckpointAt(t, reader_);
 }
 
+template<typename Message>
+std::int64_t Checkpointer<Message>::MemoryFootprint() const {
+  absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
+  std::int64_t footprint = sizeof(*this);
+  for (auto const& [_, checkpoint] : checkpoints_) {
+    footprint += sizeof(Instant) + checkpoint.SpaceUsedLong();
+  }
+  return footprint;
+}
+
 template<typename Message>
 void Checkpointer<Message>::WriteToMessage(
     not_null<google::protobuf::RepeatedPtrField<typename Message::Checkpoint>*>
         message) const {
   absl::ReaderMutexLock l(&lock_);
+  AwaitPendingCheckpointsLocked();
   for (const auto [time, checkpoint] : checkpoints_) {
     typename Message::Checkpoint* const message_checkpoint = message->Add();
     *message_checkpoint = checkpoint;
@@ -225,7 +327,7 @@ Checkpointer<Message>::ReadFromMessage(
 template<typename Message>
 void Checkpointer<Message>::WriteToCheckpointLocked(Instant const& t) {
   lock_.AssertHeld();
-  CHECK(!checkpoints_.contains(t)) << t;
+  CHECK(!checkpoints_.contains(t) && !pending_checkpoints_.contains(t)) << t;
   auto const it = checkpoints_.emplace_hint(
       checkpoints_.end(), t, typename Message::Checkpoint());
   lock_.Unlock();
@@ -233,6 +335,44 @@ void Checkpointer<Message>::WriteToCheckpointLocked(Instant const& t) {
   lock_.Lock();
 }
 
+template<typename Message>
+bool Checkpointer<Message>::IsCheckpointNeededLocked(
+    Instant const& t,
+    Time const& max_time_between_checkpoints) const {
+  lock_.AssertReaderHeld();
+  Instant newest_checkpoint = InfinitePast;
+  if (!checkpoints_.empty()) {
+    newest_checkpoint = checkpoints_.crbegin()->first;
+  }
+  if (!pending_checkpoints_.empty()) {
+    newest_checkpoint =
+        std::max(newest_checkpoint, *pending_checkpoints_.crbegin());
+  }
+  return newest_checkpoint == InfinitePast ||
+         max_time_between_checkpoints < t - newest_checkpoint;
+}
+
+template<typename Message>
+void Checkpointer<Message>::AwaitPendingCheckpointsLocked() const {
+  auto const no_pending_checkpoints = [this]() {
+    lock_.AssertReaderHeld();
+    return pending_checkpoints_.empty();
+  };
+  lock_.Await(absl::Condition(&no_pending_checkpoints));
+}
+
+template<typename Message>
+ThreadPool<void>& Checkpointer<Message>::thread_pool() {
+  static auto* const pool = new ThreadPool<void>(/*pool_size=*/1);
+  return *pool;
+}
+
+inline ThreadPool<void>& ReanimationThreadPool() {
+  static auto* const pool = new ThreadPool<void>(
+      /*pool_size=*/std::max(1u, std::thread::hardware_concurrency() / 2));
+  return *pool;
+}
+
 }  // namespace internal
 }  // namespace _checkpointer
 }  // namespace physics
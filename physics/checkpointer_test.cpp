@@ -1,5 +1,7 @@
 #include "physics/checkpointer.hpp"
 
+#include <vector>
+
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "gmock/gmock.h"
@@ -11,6 +13,7 @@ namespace principia {
 namespace physics {
 
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::Field;
 using ::testing::InSequence;
 using ::testing::IsEmpty;
@@ -37,6 +40,9 @@ struct Message {
     const serialization::Point& time() const {
       return time_;
     }
+    std::size_t SpaceUsedLong() const {
+      return sizeof(*this) + 1000;
+    }
 
     int payload = 0;
 
@@ -90,6 +96,47 @@ TEST_F(CheckpointerTest, WriteToCheckpointIfNeeded) {
   EXPECT_THAT(checkpointer_.all_checkpoints(), ElementsAre(t1, t3));
 }
 
+TEST_F(CheckpointerTest, WriteToCheckpointIfNeededAsynchronously) {
+  MockFunction<Checkpointer<Message>::Writer()> snapshotter;
+  auto const writer_with_payload = [](int const payload) {
+    return [payload](not_null<Message::Checkpoint*> const checkpoint) {
+      checkpoint->payload = payload;
+    };
+  };
+
+  Instant const t1 = Instant() + 10 * Second;
+  EXPECT_CALL(writer_, Call(_)).Times(0);
+  EXPECT_CALL(snapshotter, Call()).WillOnce(Return(writer_with_payload(1)));
+  EXPECT_TRUE(checkpointer_.WriteToCheckpointIfNeeded(
+      t1,
+      /*max_time_between_checkpoints=*/10 * Second,
+      snapshotter.AsStdFunction()));
+
+  // The pending checkpoint is taken into account even if it's not yet written.
+  Instant const t2 = t1 + 8 * Second;
+  EXPECT_CALL(snapshotter, Call()).Times(0);
+  EXPECT_FALSE(checkpointer_.WriteToCheckpointIfNeeded(
+      t2,
+      /*max_time_between_checkpoints=*/10 * Second,
+      snapshotter.AsStdFunction()));
+
+  Instant const t3 = t2 + 3 * Second;
+  EXPECT_CALL(snapshotter, Call()).WillOnce(Return(writer_with_payload(3)));
+  EXPECT_TRUE(checkpointer_.WriteToCheckpointIfNeeded(
+      t3,
+      /*max_time_between_checkpoints=*/10 * Second,
+      snapshotter.AsStdFunction()));
+
+  // The observers wait for the checkpoints to be written.
+  EXPECT_THAT(checkpointer_.all_checkpoints(), ElementsAre(t1, t3));
+  EXPECT_CALL(reader_, Call(Field(&Message::Checkpoint::payload, 1)))
+      .WillOnce(Return(absl::OkStatus()));
+  EXPECT_OK(checkpointer_.ReadFromCheckpointAt(t1));
+  EXPECT_CALL(reader_, Call(Field(&Message::Checkpoint::payload, 3)))
+      .WillOnce(Return(absl::OkStatus()));
+  EXPECT_OK(checkpointer_.ReadFromCheckpointAt(t3));
+}
+
 TEST_F(CheckpointerTest, ReadFromOldestCheckpoint) {
   EXPECT_THAT(checkpointer_.ReadFromOldestCheckpoint(),
               StatusIs(absl::StatusCode::kNotFound));
@@ -217,6 +264,60 @@ TEST_F(CheckpointerTest, ReadFromCheckpointAt) {
               StatusIs(absl::StatusCode::kCancelled));
 }
 
+TEST_F(CheckpointerTest, Thinning) {
+  EXPECT_CALL(writer_, Call(_)).Times(101);
+  for (int i = 0; i <= 100; ++i) {
+    checkpointer_.WriteToCheckpoint(Instant() + i * Second);
+  }
+
+  // Nothing is thinned before the oldest checkpoint.
+  EXPECT_THAT(checkpointer_.ThinnableCheckpoints(
+                  Instant() - 1 * Second,
+                  {.dense_span = 10 * Second, .spacing = 1 * Second}),
+              IsEmpty());
+
+  Instant const t = Instant() + 100 * Second;
+  auto const thinnable = checkpointer_.ThinnableCheckpoints(
+      t, {.dense_span = 10 * Second, .spacing = 1 * Second});
+  checkpointer_.RemoveCheckpoints(thinnable);
+  std::vector<Instant> expected_retained;
+  // Oldest checkpoint.
+  expected_retained.push_back(Instant());
+  // Age in (80 s, 160 s], spacing 16 s.
+  expected_retained.push_back(Instant() + 4 * Second);
+  // Age in (40 s, 80 s], spacing 8 s.
+  for (int i = 20; i <= 52; i += 8) {
+    expected_retained.push_back(Instant() + i * Second);
+  }
+  // Age in (20 s, 40 s], spacing 4 s.
+  for (int i = 60; i <= 76; i += 4) {
+    expected_retained.push_back(Instant() + i * Second);
+  }
+  // Age in (10 s, 20 s], spacing 2 s.
+  for (int i = 80; i <= 88; i += 2) {
+    expected_retained.push_back(Instant() + i * Second);
+  }
+  // Age at most 10 s and checkpoints at or after |t|.
+  for (int i = 90; i <= 100; ++i) {
+    expected_retained.push_back(Instant() + i * Second);
+  }
+  EXPECT_THAT(checkpointer_.all_checkpoints(),
+              ElementsAreArray(expected_retained));
+
+  // Thinning again at the same time is a no-op.
+  EXPECT_THAT(checkpointer_.ThinnableCheckpoints(
+                  t, {.dense_span = 10 * Second, .spacing = 1 * Second}),
+              IsEmpty());
+}
+
+TEST_F(CheckpointerTest, MemoryFootprint) {
+  std::int64_t const empty_footprint = checkpointer_.MemoryFootprint();
+  EXPECT_CALL(writer_, Call(_)).Times(2);
+  checkpointer_.WriteToCheckpoint(Instant() + 10 * Second);
+  checkpointer_.WriteToCheckpoint(Instant() + 23 * Second);
+  EXPECT_LE(empty_footprint + 2 * 1000, checkpointer_.MemoryFootprint());
+}
+
 TEST_F(CheckpointerTest, Serialization) {
   Instant t = Instant() + 10 * Second;
   EXPECT_CALL(writer_, Call(_)).Times(2);
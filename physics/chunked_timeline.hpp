@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "geometry/instant.hpp"
+
+namespace principia {
+namespace physics {
+namespace _chunked_timeline {
+namespace internal {
+
+using namespace principia::geometry::_instant;
+
+// A set of |Value|s ordered by their |time| field, which must be an |Instant|.
+// The values are stored contiguously in chunks of at most |chunk_capacity|
+// elements, so that iteration is mostly a linear walk through memory, and
+// lookups are a binary search on the (few) chunks followed by a binary search
+// in a chunk.  This class implements the subset of the interface of
+// |absl::btree_set| that is needed by |DiscreteTrajectorySegment|, with the
+// same semantics.  In particular, an insertion or an erasure invalidates all
+// the iterators.  It is optimized for insertions and erasures at the ends.
+// Copying a timeline is cheap: the copy shares the chunks with the original,
+// and a chunk is only duplicated when one of the timelines that share it is
+// modified.
+template<typename Value>
+class ChunkedTimeline {
+ public:
+  class const_iterator;
+
+  using key_type = Value;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  static constexpr std::int64_t chunk_capacity = 64;
+
+  ChunkedTimeline() = default;
+  ChunkedTimeline(ChunkedTimeline const& other) = default;
+  ChunkedTimeline& operator=(ChunkedTimeline const& other) = default;
+  // A moved-from timeline is empty.
+  ChunkedTimeline(ChunkedTimeline&& other);
+  ChunkedTimeline& operator=(ChunkedTimeline&& other);
+
+  class const_iterator final {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value const*;
+    using reference = Value const&;
+
+    const_iterator() = default;
+
+    reference operator*() const;
+    pointer operator->() const;
+
+    const_iterator& operator++();
+    const_iterator& operator--();
+    const_iterator operator++(int);
+    const_iterator operator--(int);
+
+    bool operator==(const_iterator const& other) const;
+    bool operator!=(const_iterator const& other) const;
+
+   private:
+    // |point| is null for the end iterator.
+    const_iterator(ChunkedTimeline const* timeline,
+                   std::int64_t chunk,
+                   Value const* point);
+
+    ChunkedTimeline const* timeline_ = nullptr;
+    std::int64_t chunk_ = 0;
+    Value const* point_ = nullptr;
+
+    friend class ChunkedTimeline;
+  };
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+  const_reverse_iterator rbegin() const;
+  const_reverse_iterator rend() const;
+  const_reverse_iterator crbegin() const;
+  const_reverse_iterator crend() const;
+
+  bool empty() const;
+  size_type size() const;
+
+  void clear();
+
+  const_iterator find(Instant const& t) const;
+  const_iterator lower_bound(Instant const& t) const;
+  const_iterator upper_bound(Instant const& t) const;
+
+  // If a value with the same time exists, does nothing and returns an iterator
+  // to it.  The insertion is fastest if |hint| is the position of the new
+  // value.
+  template<typename... Args>
+  std::pair<const_iterator, bool> emplace(Args&&... args);
+  template<typename... Args>
+  const_iterator emplace_hint(const_iterator hint, Args&&... args);
+
+  // Returns an iterator to the value that followed the erased range.
+  const_iterator erase(const_iterator first, const_iterator last);
+
+  // Moves the values of |other| into this object, except for those whose time
+  // is already present, which stay in |other|.  This is fastest if the times of
+  // |other| are all after or all before those of this object.
+  void merge(ChunkedTimeline& other);
+
+ private:
+  using Chunk = std::vector<Value>;
+
+  // Returns an iterator to the value at position |index| of the chunk at index
+  // |chunk|, or to the beginning of the next chunk if |index| is the size of
+  // that chunk.  |chunk| may be |chunks_.size()|, in which case the result is
+  // |end()|.
+  const_iterator MakeIterator(std::int64_t chunk, std::int64_t index) const;
+
+  // Inserts |value| before the position |index| of the chunk at index |chunk|.
+  // |chunk| may be |chunks_.size()| to insert at the end.
+  const_iterator Insert(std::int64_t chunk, std::int64_t index, Value value);
+
+  // Merges the chunks at |left| and |left + 1|, if they exist and if their
+  // values fit in a single chunk.  Returns true iff the chunks were merged.
+  bool Coalesce(std::int64_t left);
+
+  // Returns the chunk at |index|, after duplicating it if it is shared with
+  // another timeline.  Must be called before modifying a chunk.
+  Chunk& MutableChunk(std::int64_t index);
+
+  // Ensures that |chunk| has room for |size| values, growing geometrically up
+  // to |chunk_capacity|.
+  static void Reserve(Chunk& chunk, std::int64_t size);
+
+  // The chunks are never empty, and none of them has more than
+  // |chunk_capacity| values.  They are shared by the copies of this object.
+  std::vector<std::shared_ptr<Chunk>> chunks_;
+  std::int64_t size_ = 0;
+};
+
+}  // namespace internal
+
+using internal::ChunkedTimeline;
+
+}  // namespace _chunked_timeline
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/chunked_timeline_body.hpp"
@@ -0,0 +1,490 @@
+#pragma once
+
+#include "physics/chunked_timeline.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace physics {
+namespace _chunked_timeline {
+namespace internal {
+
+template<typename Value>
+auto ChunkedTimeline<Value>::const_iterator::operator*() const -> reference {
+  DCHECK(point_ != nullptr);
+  return *point_;
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::const_iterator::operator->() const -> pointer {
+  DCHECK(point_ != nullptr);
+  return point_;
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::const_iterator::operator++() -> const_iterator& {
+  DCHECK(point_ != nullptr);
+  auto const& chunks = timeline_->chunks_;
+  ++point_;
+  if (point_ == chunks[chunk_]->data() + chunks[chunk_]->size()) {
+    ++chunk_;
+    point_ = chunk_ == chunks.size() ? nullptr : chunks[chunk_]->data();
+  }
+  return *this;
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::const_iterator::operator--() -> const_iterator& {
+  auto const& chunks = timeline_->chunks_;
+  if (point_ == nullptr) {
+    DCHECK(!chunks.empty());
+    chunk_ = chunks.size() - 1;
+    point_ = &chunks[chunk_]->back();
+  } else if (point_ == chunks[chunk_]->data()) {
+    DCHECK_LT(0, chunk_);
+    --chunk_;
+    point_ = &chunks[chunk_]->back();
+  } else {
+    --point_;
+  }
+  return *this;
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::const_iterator::operator++(int)
+    -> const_iterator {
+  const_iterator const initial = *this;
+  ++*this;
+  return initial;
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::const_iterator::operator--(int)
+    -> const_iterator {
+  const_iterator const initial = *this;
+  --*this;
+  return initial;
+}
+
+template<typename Value>
+bool ChunkedTimeline<Value>::const_iterator::operator==(
+    const_iterator const& other) const {
+  DCHECK_EQ(timeline_, other.timeline_);
+  return point_ == other.point_;
+}
+
+template<typename Value>
+bool ChunkedTimeline<Value>::const_iterator::operator!=(
+    const_iterator const& other) const {
+  return !operator==(other);
+}
+
+template<typename Value>
+ChunkedTimeline<Value>::const_iterator::const_iterator(
+    ChunkedTimeline const* const timeline,
+    std::int64_t const chunk,
+    Value const* const point)
+    : timeline_(timeline),
+      chunk_(chunk),
+      point_(point) {}
+
+template<typename Value>
+ChunkedTimeline<Value>::ChunkedTimeline(ChunkedTimeline&& other)
+    : chunks_(std::move(other.chunks_)),
+      size_(std::exchange(other.size_, 0)) {
+  other.chunks_.clear();
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::operator=(ChunkedTimeline&& other)
+    -> ChunkedTimeline& {
+  if (this != &other) {
+    chunks_ = std::move(other.chunks_);
+    size_ = std::exchange(other.size_, 0);
+    other.chunks_.clear();
+  }
+  return *this;
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::begin() const -> const_iterator {
+  return MakeIterator(0, 0);
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::end() const -> const_iterator {
+  return const_iterator(this, chunks_.size(), nullptr);
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::cbegin() const -> const_iterator {
+  return begin();
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::cend() const -> const_iterator {
+  return end();
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::rbegin() const -> const_reverse_iterator {
+  return const_reverse_iterator(end());
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::rend() const -> const_reverse_iterator {
+  return const_reverse_iterator(begin());
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::crbegin() const -> const_reverse_iterator {
+  return rbegin();
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::crend() const -> const_reverse_iterator {
+  return rend();
+}
+
+template<typename Value>
+bool ChunkedTimeline<Value>::empty() const {
+  return size_ == 0;
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::size() const -> size_type {
+  return size_;
+}
+
+template<typename Value>
+void ChunkedTimeline<Value>::clear() {
+  chunks_.clear();
+  size_ = 0;
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::find(Instant const& t) const -> const_iterator {
+  auto const it = lower_bound(t);
+  if (it == end() || it->time != t) {
+    return end();
+  } else {
+    return it;
+  }
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::lower_bound(Instant const& t) const
+    -> const_iterator {
+  // The first chunk whose last value is at or after |t| contains the result.
+  auto const chunk = std::partition_point(
+      chunks_.begin(),
+      chunks_.end(),
+      [&t](std::shared_ptr<Chunk> const& chunk) {
+        return chunk->back().time < t;
+      });
+  if (chunk == chunks_.end()) {
+    return end();
+  }
+  auto const point = std::partition_point(
+      (*chunk)->begin(), (*chunk)->end(), [&t](Value const& value) {
+        return value.time < t;
+      });
+  return const_iterator(this, chunk - chunks_.begin(), &*point);
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::upper_bound(Instant const& t) const
+    -> const_iterator {
+  // The first chunk whose last value is after |t| contains the result.
+  auto const chunk = std::partition_point(
+      chunks_.begin(),
+      chunks_.end(),
+      [&t](std::shared_ptr<Chunk> const& chunk) {
+        return chunk->back().time <= t;
+      });
+  if (chunk == chunks_.end()) {
+    return end();
+  }
+  auto const point = std::partition_point(
+      (*chunk)->begin(), (*chunk)->end(), [&t](Value const& value) {
+        return value.time <= t;
+      });
+  return const_iterator(this, chunk - chunks_.begin(), &*point);
+}
+
+template<typename Value>
+template<typename... Args>
+auto ChunkedTimeline<Value>::emplace(Args&&... args)
+    -> std::pair<const_iterator, bool> {
+  Value value(std::forward<Args>(args)...);
+  auto const it = lower_bound(value.time);
+  if (it != end() && it->time == value.time) {
+    return {it, false};
+  }
+  if (it == end()) {
+    return {Insert(chunks_.size(), 0, std::move(value)), true};
+  } else {
+    return {Insert(it.chunk_, it.point_ - chunks_[it.chunk_]->data(),
+                   std::move(value)),
+            true};
+  }
+}
+
+template<typename Value>
+template<typename... Args>
+auto ChunkedTimeline<Value>::emplace_hint(const_iterator const hint,
+                                          Args&&... args) -> const_iterator {
+  // Handle the common cases of insertions at the ends without a lookup.
+  Value value(std::forward<Args>(args)...);
+  if (empty()) {
+    return Insert(0, 0, std::move(value));
+  } else if (hint == end() && chunks_.back()->back().time < value.time) {
+    return Insert(chunks_.size(), 0, std::move(value));
+  } else if (hint == begin() && value.time < chunks_.front()->front().time) {
+    return Insert(0, 0, std::move(value));
+  } else {
+    return emplace(std::move(value)).first;
+  }
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::erase(const_iterator const first,
+                                   const_iterator const last)
+    -> const_iterator {
+  if (first == last) {
+    return last;
+  }
+  std::int64_t const first_chunk = first.chunk_;
+  std::int64_t const first_index =
+      first.point_ - chunks_[first_chunk]->data();
+  std::int64_t last_chunk;
+  std::int64_t last_index;
+  if (last == end()) {
+    last_chunk = chunks_.size();
+    last_index = 0;
+  } else {
+    last_chunk = last.chunk_;
+    last_index = last.point_ - chunks_[last_chunk]->data();
+  }
+
+  if (first_chunk == last_chunk) {
+    auto& chunk = MutableChunk(first_chunk);
+    chunk.erase(chunk.begin() + first_index, chunk.begin() + last_index);
+    size_ -= last_index - first_index;
+  } else {
+    auto& chunk = MutableChunk(first_chunk);
+    size_ -= chunk.size() - first_index;
+    chunk.erase(chunk.begin() + first_index, chunk.end());
+    for (std::int64_t c = first_chunk + 1; c < last_chunk; ++c) {
+      size_ -= chunks_[c]->size();
+    }
+    if (last_chunk < chunks_.size()) {
+      auto& chunk = MutableChunk(last_chunk);
+      size_ -= last_index;
+      chunk.erase(chunk.begin(), chunk.begin() + last_index);
+    }
+    chunks_.erase(chunks_.begin() + first_chunk + 1,
+                  chunks_.begin() + last_chunk);
+  }
+
+  // Find the position of the value that followed the erased range, removing the
+  // first chunk if it became empty.  No other chunk may be empty at this point.
+  std::int64_t chunk = first_chunk;
+  std::int64_t index = first_index;
+  if (chunks_[chunk]->empty()) {
+    chunks_.erase(chunks_.begin() + chunk);
+    index = 0;
+  } else if (index == chunks_[chunk]->size()) {
+    ++chunk;
+    index = 0;
+  }
+
+  // Coalesce the chunks around the erased range to avoid accumulating small
+  // chunks, e.g., when downsampling.
+  if (chunk == chunks_.size()) {
+    Coalesce(chunk - 2);
+    chunk = chunks_.size();
+  } else {
+    std::int64_t const previous_size =
+        chunk > 0 ? chunks_[chunk - 1]->size() : 0;
+    if (Coalesce(chunk - 1)) {
+      --chunk;
+      index += previous_size;
+    }
+    Coalesce(chunk);
+  }
+  return MakeIterator(chunk, index);
+}
+
+template<typename Value>
+void ChunkedTimeline<Value>::merge(ChunkedTimeline& other) {
+  if (other.empty()) {
+    return;
+  } else if (empty()) {
+    chunks_.swap(other.chunks_);
+    std::swap(size_, other.size_);
+    return;
+  }
+
+  Instant const& this_front = chunks_.front()->front().time;
+  Instant const& this_back = chunks_.back()->back().time;
+  Instant const& other_front = other.chunks_.front()->front().time;
+  Instant const& other_back = other.chunks_.back()->back().time;
+  if (this_back <= other_front || other_back <= this_front) {
+    // The values of |other| go at one end of this object, except possibly for
+    // one duplicate, which must be left in |other|.
+    bool const append = this_back <= other_front;
+    std::optional<Value> duplicate;
+    if (append && this_back == other_front) {
+      duplicate.emplace(other.chunks_.front()->front());
+      other.erase(other.begin(), std::next(other.begin()));
+    } else if (!append && other_back == this_front) {
+      duplicate.emplace(other.chunks_.back()->back());
+      other.erase(std::prev(other.end()), other.end());
+    }
+    if (append) {
+      std::int64_t const junction = chunks_.size() - 1;
+      std::move(other.chunks_.begin(),
+                other.chunks_.end(),
+                std::back_inserter(chunks_));
+      Coalesce(junction);
+    } else {
+      std::int64_t const junction = other.chunks_.size() - 1;
+      chunks_.insert(chunks_.begin(),
+                     std::make_move_iterator(other.chunks_.begin()),
+                     std::make_move_iterator(other.chunks_.end()));
+      Coalesce(junction);
+    }
+    size_ += other.size_;
+    other.clear();
+    if (duplicate.has_value()) {
+      other.emplace(std::move(*duplicate));
+    }
+  } else {
+    // The general case, which is not expected to be frequent.
+    ChunkedTimeline duplicates;
+    for (auto const& chunk : other.chunks_) {
+      for (auto const& value : *chunk) {
+        if (find(value.time) == end()) {
+          emplace(value);
+        } else {
+          duplicates.emplace_hint(duplicates.end(), value);
+        }
+      }
+    }
+    other = std::move(duplicates);
+  }
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::MakeIterator(std::int64_t const chunk,
+                                          std::int64_t const index) const
+    -> const_iterator {
+  if (chunk == chunks_.size()) {
+    return end();
+  } else if (index == chunks_[chunk]->size()) {
+    return MakeIterator(chunk + 1, 0);
+  } else {
+    return const_iterator(this, chunk, chunks_[chunk]->data() + index);
+  }
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::Insert(std::int64_t chunk,
+                                    std::int64_t index,
+                                    Value value) -> const_iterator {
+  if (chunks_.empty()) {
+    chunks_.push_back(std::make_shared<Chunk>());
+    chunk = 0;
+    index = 0;
+  } else if (chunk == chunks_.size()) {
+    // Insert at the end of the last chunk.
+    chunk = chunks_.size() - 1;
+    index = chunks_[chunk]->size();
+  } else if (index == 0 && chunk > 0 &&
+             chunks_[chunk - 1]->size() < chunk_capacity) {
+    // Insert at the end of the previous chunk, which has room.
+    --chunk;
+    index = chunks_[chunk]->size();
+  }
+
+  if (chunks_[chunk]->size() == chunk_capacity) {
+    if (index == chunk_capacity) {
+      // Start a new chunk after the full one.
+      chunks_.insert(chunks_.begin() + chunk + 1, std::make_shared<Chunk>());
+      ++chunk;
+      index = 0;
+    } else if (index == 0) {
+      // Start a new chunk before the full one.
+      chunks_.insert(chunks_.begin() + chunk, std::make_shared<Chunk>());
+    } else {
+      // Split the full chunk in two halves.
+      constexpr std::int64_t half = chunk_capacity / 2;
+      Chunk upper;
+      Reserve(upper, chunk_capacity - half);
+      auto& lower = MutableChunk(chunk);
+      std::move(lower.begin() + half, lower.end(), std::back_inserter(upper));
+      lower.erase(lower.begin() + half, lower.end());
+      chunks_.insert(chunks_.begin() + chunk + 1,
+                     std::make_shared<Chunk>(std::move(upper)));
+      if (index > half) {
+        ++chunk;
+        index -= half;
+      }
+    }
+  }
+
+  auto& destination = MutableChunk(chunk);
+  Reserve(destination, destination.size() + 1);
+  destination.insert(destination.begin() + index, std::move(value));
+  ++size_;
+  return const_iterator(this, chunk, destination.data() + index);
+}
+
+template<typename Value>
+bool ChunkedTimeline<Value>::Coalesce(std::int64_t const left) {
+  if (left < 0 || left + 1 >= chunks_.size()) {
+    return false;
+  }
+  std::int64_t const size = chunks_[left]->size() + chunks_[left + 1]->size();
+  if (size > chunk_capacity) {
+    return false;
+  }
+  // The right chunk may be shared, so its values are copied, not moved.
+  auto& left_chunk = MutableChunk(left);
+  auto const& right_chunk = *chunks_[left + 1];
+  Reserve(left_chunk, size);
+  std::copy(right_chunk.begin(),
+            right_chunk.end(),
+            std::back_inserter(left_chunk));
+  chunks_.erase(chunks_.begin() + left + 1);
+  return true;
+}
+
+template<typename Value>
+auto ChunkedTimeline<Value>::MutableChunk(std::int64_t const index) -> Chunk& {
+  auto& chunk = chunks_[index];
+  if (chunk.use_count() > 1) {
+    chunk = std::make_shared<Chunk>(std::as_const(*chunk));
+  }
+  return *chunk;
+}
+
+template<typename Value>
+void ChunkedTimeline<Value>::Reserve(Chunk& chunk, std::int64_t const size) {
+  DCHECK_LE(size, chunk_capacity);
+  if (size > chunk.capacity()) {
+    chunk.reserve(std::min<std::int64_t>(
+        std::max<std::int64_t>(size, 2 * chunk.capacity()), chunk_capacity));
+  }
+}
+
+}  // namespace internal
+}  // namespace _chunked_timeline
+}  // namespace physics
+}  // namespace principia
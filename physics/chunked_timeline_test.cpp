@@ -0,0 +1,287 @@
+#include "physics/chunked_timeline.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "geometry/instant.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace physics {
+
+using namespace principia::geometry::_instant;
+using namespace principia::physics::_chunked_timeline;
+using namespace principia::quantities::_si;
+
+class ChunkedTimelineTest : public ::testing::Test {
+ protected:
+  struct Point {
+    Point(Instant const& time, int const payload)
+        : time(time), payload(payload) {}
+    Instant time;
+    int payload;
+  };
+
+  using Timeline = ChunkedTimeline<Point>;
+  static constexpr std::int64_t capacity = Timeline::chunk_capacity;
+
+  Instant Time(int const i) const {
+    return t0_ + i * Second;
+  }
+
+  // Checks that |timeline| contains exactly the payloads |expected|, in order,
+  // both forward and backward, and that the lookups are consistent.
+  void ExpectContents(Timeline const& timeline,
+                      std::vector<int> const& expected) const {
+    ASSERT_EQ(expected.size(), timeline.size());
+    EXPECT_EQ(expected.empty(), timeline.empty());
+    std::vector<int> forward;
+    for (auto const& point : timeline) {
+      EXPECT_EQ(Time(point.payload), point.time);
+      forward.push_back(point.payload);
+    }
+    EXPECT_THAT(forward, ::testing::ElementsAreArray(expected));
+    std::vector<int> backward;
+    for (auto it = timeline.rbegin(); it != timeline.rend(); ++it) {
+      backward.push_back(it->payload);
+    }
+    std::reverse(backward.begin(), backward.end());
+    EXPECT_THAT(backward, ::testing::ElementsAreArray(expected));
+    for (int const payload : expected) {
+      auto const it = timeline.find(Time(payload));
+      ASSERT_TRUE(it != timeline.end());
+      EXPECT_EQ(payload, it->payload);
+      EXPECT_TRUE(timeline.lower_bound(Time(payload)) == it);
+      EXPECT_TRUE(timeline.upper_bound(Time(payload)) == std::next(it));
+    }
+  }
+
+  Instant const t0_;
+};
+
+TEST_F(ChunkedTimelineTest, Empty) {
+  Timeline timeline;
+  ExpectContents(timeline, {});
+  EXPECT_TRUE(timeline.begin() == timeline.end());
+  EXPECT_TRUE(timeline.find(t0_) == timeline.end());
+  EXPECT_TRUE(timeline.lower_bound(t0_) == timeline.end());
+  EXPECT_TRUE(timeline.upper_bound(t0_) == timeline.end());
+}
+
+TEST_F(ChunkedTimelineTest, Append) {
+  Timeline timeline;
+  std::vector<int> expected;
+  for (int i = 0; i < 5 * capacity + 3; ++i) {
+    auto const it = timeline.emplace_hint(timeline.end(), Time(i), i);
+    EXPECT_EQ(i, it->payload);
+    expected.push_back(i);
+  }
+  ExpectContents(timeline, expected);
+  EXPECT_TRUE(timeline.find(Time(-1)) == timeline.end());
+  EXPECT_EQ(0, timeline.lower_bound(Time(-1))->payload);
+  EXPECT_TRUE(timeline.lower_bound(Time(1000)) == timeline.end());
+  EXPECT_EQ(capacity,
+            timeline.lower_bound(Time(capacity) - 0.5 * Second)->payload);
+  EXPECT_EQ(capacity,
+            timeline.upper_bound(Time(capacity) - 0.5 * Second)->payload);
+}
+
+TEST_F(ChunkedTimelineTest, Prepend) {
+  Timeline timeline;
+  std::vector<int> expected;
+  for (int i = 3 * capacity; i > 0; --i) {
+    auto const it = timeline.emplace_hint(timeline.begin(), Time(i), i);
+    EXPECT_TRUE(it == timeline.begin());
+    expected.insert(expected.begin(), i);
+  }
+  ExpectContents(timeline, expected);
+}
+
+TEST_F(ChunkedTimelineTest, Duplicate) {
+  Timeline timeline;
+  EXPECT_TRUE(timeline.emplace(Time(1), 1).second);
+  EXPECT_TRUE(timeline.emplace(Time(2), 2).second);
+  auto const [it, inserted] = timeline.emplace(Time(1), 1);
+  EXPECT_FALSE(inserted);
+  EXPECT_TRUE(it == timeline.begin());
+  EXPECT_TRUE(timeline.emplace_hint(timeline.end(), Time(2), 2) ==
+              std::next(timeline.begin()));
+  ExpectContents(timeline, {1, 2});
+}
+
+TEST_F(ChunkedTimelineTest, RandomInsertions) {
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<int> distribution(0, 1000);
+  Timeline timeline;
+  std::set<int> reference;
+  for (int i = 0; i < 2000; ++i) {
+    int const payload = distribution(random);
+    auto const [it, inserted] = timeline.emplace(Time(payload), payload);
+    EXPECT_EQ(reference.insert(payload).second, inserted);
+    EXPECT_EQ(payload, it->payload);
+  }
+  ExpectContents(timeline, std::vector<int>(reference.begin(),
+                                            reference.end()));
+}
+
+TEST_F(ChunkedTimelineTest, Erase) {
+  Timeline timeline;
+  std::vector<int> expected;
+  int const n = 6 * capacity;
+  for (int i = 0; i < n; ++i) {
+    timeline.emplace_hint(timeline.end(), Time(i), i);
+    expected.push_back(i);
+  }
+
+  // Erasing within a chunk.
+  auto it = timeline.erase(timeline.find(Time(3)), timeline.find(Time(7)));
+  expected.erase(expected.begin() + 3, expected.begin() + 7);
+  EXPECT_EQ(7, it->payload);
+  ExpectContents(timeline, expected);
+
+  // Erasing across chunks.
+  it = timeline.erase(timeline.find(Time(capacity - 2)),
+                      timeline.find(Time(3 * capacity + 5)));
+  expected.erase(
+      std::find(expected.begin(), expected.end(), capacity - 2),
+      std::find(expected.begin(), expected.end(), 3 * capacity + 5));
+  EXPECT_EQ(3 * capacity + 5, it->payload);
+  ExpectContents(timeline, expected);
+
+  // Erasing every other point, like downsampling does.
+  it = timeline.begin();
+  while (it != timeline.end() && std::next(it) != timeline.end()) {
+    it = timeline.erase(std::next(it), std::next(it, 2));
+  }
+  std::vector<int> every_other;
+  for (int i = 0; i < expected.size(); i += 2) {
+    every_other.push_back(expected[i]);
+  }
+  if (expected.size() % 2 == 0) {
+    every_other.push_back(expected.back());
+  }
+  expected = every_other;
+  ExpectContents(timeline, expected);
+
+  // Erasing the ends.
+  it = timeline.erase(std::next(timeline.begin(), 10), timeline.end());
+  expected.erase(expected.begin() + 10, expected.end());
+  EXPECT_TRUE(it == timeline.end());
+  ExpectContents(timeline, expected);
+  it = timeline.erase(timeline.begin(), std::next(timeline.begin(), 4));
+  expected.erase(expected.begin(), expected.begin() + 4);
+  EXPECT_TRUE(it == timeline.begin());
+  ExpectContents(timeline, expected);
+  it = timeline.erase(timeline.begin(), timeline.end());
+  EXPECT_TRUE(it == timeline.end());
+  ExpectContents(timeline, {});
+}
+
+TEST_F(ChunkedTimelineTest, MergeDisjoint) {
+  Timeline timeline1;
+  Timeline timeline2;
+  Timeline timeline3;
+  std::vector<int> expected;
+  for (int i = 0; i < 2 * capacity; ++i) {
+    timeline1.emplace_hint(timeline1.end(), Time(i), i);
+  }
+  // The first point of |timeline2| duplicates the last of |timeline1|.
+  for (int i = 2 * capacity - 1; i < 3 * capacity + 7; ++i) {
+    timeline2.emplace_hint(timeline2.end(), Time(i), i);
+  }
+  for (int i = -capacity; i < 0; ++i) {
+    timeline3.emplace_hint(timeline3.end(), Time(i), i);
+  }
+  for (int i = -capacity; i < 3 * capacity + 7; ++i) {
+    expected.push_back(i);
+  }
+
+  timeline1.merge(timeline2);
+  ExpectContents(timeline2, {2 * capacity - 1});
+  timeline1.merge(timeline3);
+  ExpectContents(timeline3, {});
+  ExpectContents(timeline1, expected);
+
+  Timeline empty;
+  empty.merge(timeline1);
+  ExpectContents(timeline1, {});
+  ExpectContents(empty, expected);
+}
+
+TEST_F(ChunkedTimelineTest, MergeInterleaved) {
+  Timeline timeline1;
+  Timeline timeline2;
+  std::vector<int> expected;
+  for (int i = 0; i < 3 * capacity; ++i) {
+    if (i % 3 == 0) {
+      timeline2.emplace_hint(timeline2.end(), Time(i), i);
+    } else {
+      timeline1.emplace_hint(timeline1.end(), Time(i), i);
+    }
+    expected.push_back(i);
+  }
+  timeline2.emplace(Time(1), 1);
+
+  timeline1.merge(timeline2);
+  ExpectContents(timeline1, expected);
+  ExpectContents(timeline2, {1});
+}
+
+TEST_F(ChunkedTimelineTest, Copy) {
+  Timeline original;
+  std::vector<int> expected;
+  for (int i = 0; i < 4 * capacity; ++i) {
+    original.emplace_hint(original.end(), Time(i), i);
+    expected.push_back(i);
+  }
+
+  // The copies share the chunks, but modifying one doesn't affect the others.
+  Timeline appended = original;
+  Timeline erased = original;
+  Timeline inserted = original;
+  ExpectContents(appended, expected);
+  EXPECT_EQ(&*original.begin(), &*appended.begin());
+
+  appended.emplace_hint(appended.end(), Time(4 * capacity), 4 * capacity);
+  erased.erase(erased.find(Time(capacity - 3)),
+               erased.find(Time(2 * capacity + 3)));
+  inserted.emplace(Time(-1), -1);
+  inserted.erase(inserted.find(Time(3 * capacity)), inserted.end());
+  ExpectContents(original, expected);
+
+  std::vector<int> expected_appended = expected;
+  expected_appended.push_back(4 * capacity);
+  ExpectContents(appended, expected_appended);
+  std::vector<int> expected_erased = expected;
+  expected_erased.erase(expected_erased.begin() + capacity - 3,
+                        expected_erased.begin() + 2 * capacity + 3);
+  ExpectContents(erased, expected_erased);
+  std::vector<int> expected_inserted(expected.begin(),
+                                     expected.begin() + 3 * capacity);
+  expected_inserted.insert(expected_inserted.begin(), -1);
+  ExpectContents(inserted, expected_inserted);
+
+  // Moving leaves an empty timeline.
+  Timeline moved = std::move(appended);
+  ExpectContents(moved, expected_appended);
+  ExpectContents(appended, {});
+  appended = std::move(moved);
+  ExpectContents(moved, {});
+  ExpectContents(appended, expected_appended);
+
+  // Merging copies.
+  Timeline merged = erased;
+  Timeline source = original;
+  merged.merge(source);
+  ExpectContents(merged, expected);
+  ExpectContents(original, expected);
+  ExpectContents(erased, expected_erased);
+}
+
+}  // namespace physics
+}  // namespace principia
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
 
+#include "absl/container/btree_set.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "base/not_null.hpp"
@@ -17,6 +20,7 @@
 #include "physics/checkpointer.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/trajectory.hpp"
+#include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 #include "serialization/physics.pb.h"
 
@@ -39,6 +43,7 @@ using namespace principia::numerics::_polynomial_evaluators;
 using namespace principia::physics::_checkpointer;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_trajectory;
+using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 
 // This class is thread-safe, but the client must be aware that if, for
@@ -52,9 +57,13 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // truncating the infinite Чебышёв series to a finite degree are a small
   // multiple of the coefficient of highest degree (assuming that the series
   // converges reasonably well).  Thus, we pick the degree of the series so that
-  // the coefficient of highest degree is less than |tolerance|.
+  // the coefficient of highest degree is less than |tolerance|.  If
+  // |minimize_storage| is true, the degree is also lowered whenever the
+  // tolerance can be met with fewer coefficients, at the cost of an extra error
+  // estimate per polynomial; otherwise it is only lowered periodically.
   ContinuousTrajectory(Time const& step,
-                       Length const& tolerance);
+                       Length const& tolerance,
+                       bool minimize_storage = false);
 
   ContinuousTrajectory(ContinuousTrajectory const&) = delete;
   ContinuousTrajectory(ContinuousTrajectory&&) = delete;
@@ -68,6 +77,14 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // benchmarking or analyzing performance.  Do not use in real code.
   double average_degree() const EXCLUDES(lock_);
 
+  // The number of coefficients of the polynomials for the trajectory per unit
+  // of time covered.  Like |average_degree|, only useful for benchmarking.
+  Frequency coefficients_per_unit_time() const EXCLUDES(lock_);
+
+  // Returns an estimate of the number of bytes used by this trajectory,
+  // including its polynomials and its checkpoints.
+  std::int64_t MemoryFootprint() const EXCLUDES(lock_);
+
   // Appends one point to the trajectory.  |time| must be after the last time
   // passed to |Append| if the trajectory is not empty.  The |time|s passed to
   // successive calls to |Append| must be equally spaced with the |step| given
@@ -103,6 +120,14 @@ class ContinuousTrajectory : public Trajectory<Frame> {
 
   // End of the implementation of the interface.
 
+  // Returns the polynomial applicable at |time|, which must be in
+  // [t_min(), t_max()].  Doesn't take |lock_|.  The caller shares the ownership
+  // of the polynomial, which remains valid even if this trajectory is changed.
+  // This is used for evaluating many trajectories at once, see
+  // |BatchedPositionsEvaluator|.
+  std::shared_ptr<Polynomial<Position<Frame>, Instant> const>
+  PolynomialForInstant(Instant const& time) const;
+
 #if PRINCIPIA_CONTINUOUS_TRAJECTORY_SUPPORTS_PIECEWISE_POISSON_SERIES
   // Returns the degree for a piecewise Poisson series covering the given time
   // interval.
@@ -133,6 +158,7 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // These members call the corresponding functions of the internal
   // checkpointer.
   void WriteToCheckpoint(Instant const& t) const;
+  void RemoveCheckpoints(absl::btree_set<Instant> const& times) const;
   absl::Status ReadFromCheckpointAt(
       Instant const& t,
       Checkpointer<serialization::ContinuousTrajectory>::Reader const& reader)
@@ -176,11 +202,54 @@ class ContinuousTrajectory : public Trajectory<Frame> {
         not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
             polynomial);
     Instant t_max;
-    not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
+    // Shared with the |PublishedPolynomials| below.
+    not_null<std::shared_ptr<Polynomial<Position<Frame>, Instant>>>
         polynomial;
   };
   using InstantPolynomialPairs = std::vector<InstantPolynomialPair>;
 
+  // An immutable copy of (a prefix of) |polynomials_| that can be read without
+  // taking |lock_|.  Only the entries below |size| may be read, and they are
+  // never modified once |size| has been published.  New polynomials are
+  // appended in place, up to the |capacity|; when the capacity is exhausted, or
+  // when the polynomials change other than by appending (e.g., |Prepend| or a
+  // restoration from a checkpoint), a new object is published.  Readers may
+  // still be using the old objects, so these are retired, and destroyed by the
+  // next publication that finds no readers, see |PublishedPolynomialsReader|.
+  struct PublishedPolynomials {
+    struct Entry {
+      Instant t_max;
+      std::shared_ptr<Polynomial<Position<Frame>, Instant> const> polynomial;
+    };
+
+    PublishedPolynomials(Instant const& t_min, std::int64_t capacity);
+
+    Instant const t_min;
+    std::int64_t const capacity;
+    std::unique_ptr<Entry[]> const entries;
+    std::atomic<std::int64_t> size = 0;
+  };
+
+  // The number of threads reading the published polynomials without taking
+  // |lock_|.  Padded to avoid false sharing between the threads.
+  struct alignas(64) ReaderCount {
+    std::atomic<std::int64_t> count = 0;
+  };
+  static constexpr int number_of_reader_counts = 8;
+
+  // Registers the current thread as a reader of the published polynomials for
+  // the lifetime of this object.  The |PublishedPolynomials| objects, and the
+  // pointers into them, must not be used outside of that lifetime.
+  class PublishedPolynomialsReader {
+   public:
+    explicit PublishedPolynomialsReader(
+        ContinuousTrajectory const& trajectory);
+    ~PublishedPolynomialsReader();
+
+   private:
+    std::atomic<std::int64_t>& count_;
+  };
+
   // Really a static method, but may be overridden for testing.
   virtual not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
   NewhallApproximationInMonomialBasis(
@@ -191,6 +260,16 @@ class ContinuousTrajectory : public Trajectory<Frame> {
       Instant const& t_max,
       Displacement<Frame>& error_estimate) const;
 
+  // Returns the |error_estimate| that |NewhallApproximationInMonomialBasis|
+  // would produce, at a fraction of the cost.  Really a static method, but may
+  // be overridden for testing.
+  virtual Displacement<Frame> NewhallApproximationErrorEstimate(
+      int degree,
+      std::vector<Position<Frame>> const& q,
+      std::vector<Velocity<Frame>> const& v,
+      Instant const& t_min,
+      Instant const& t_max) const;
+
   // Computes the best Newhall approximation based on the desired tolerance.
   // Adjust the |degree_| and other member variables to stay within the
   // tolerance while minimizing the computational cost and avoiding numerical
@@ -203,14 +282,30 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // Returns an iterator to the polynomial applicable for the given |time|, or
   // |begin| if |time| is before the first polynomial or |end| if |time| is
   // after the last polynomial.  If |time| is the |t_max| of some polynomial,
-  // that polynomial is returned.  Time complexity is O(N Log N).
+  // that polynomial is returned.  Time complexity is O(1) for uniformly-spaced
+  // polynomials, O(Log N) otherwise.
   typename InstantPolynomialPairs::const_iterator
   FindPolynomialForInstantLocked(Instant const& time) const
       REQUIRES_SHARED(lock_);
 
+  // Returns the published entry applicable for the given |time|, or null if
+  // there is none, in which case the caller must take |lock_| and use the
+  // functions above.  Doesn't take |lock_|.  The caller must be registered as a
+  // |PublishedPolynomialsReader|.
+  typename PublishedPolynomials::Entry const* FindPublishedEntryForInstant(
+      Instant const& time) const;
+
+  // Makes the polynomials visible to the readers that don't take |lock_|.  If
+  // |appended_only| is true, the caller guarantees that the polynomials have
+  // not changed since the last publication, except for the addition of new
+  // polynomials at the end.  Destroys the retired |PublishedPolynomials| if
+  // there are no readers.
+  void PublishPolynomialsLocked(bool appended_only) REQUIRES(lock_);
+
   // Construction parameters;
   Time const step_;
   Length const tolerance_;
+  bool const minimize_storage_ = false;
   not_null<
       std::unique_ptr<Checkpointer<serialization::ContinuousTrajectory>>>
       checkpointer_;
@@ -242,8 +337,18 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // multithreading it may be that different threads would want to access
   // polynomials at different indices, but by and large the threads progress in
   // parallel, and benchmarks show that there is no adverse performance effects.
-  // Any value in the range of |polynomials_| or 0 is correct.
-  mutable std::int64_t last_accessed_polynomial_ GUARDED_BY(lock_) = 0;
+  // This member is atomic because it is written by readers holding |lock_|
+  // shared.  Any value in the range of |polynomials_| or 0 is correct.
+  mutable std::atomic<std::int64_t> last_accessed_polynomial_ = 0;
+
+  // The objects published and not yet destroyed, the last one being the
+  // current one.
+  std::vector<not_null<std::unique_ptr<PublishedPolynomials>>>
+      all_published_polynomials_ GUARDED_BY(lock_);
+  // Indexed by a hash of the reading thread.
+  mutable std::array<ReaderCount, number_of_reader_counts> reader_counts_;
+  // Null if nothing was ever published.
+  std::atomic<PublishedPolynomials const*> published_polynomials_ = nullptr;
 
   // The time at which this trajectory starts.  Set for a nonempty trajectory.
   std::optional<Instant> first_time_ GUARDED_BY(lock_);
@@ -3,10 +3,12 @@
 #include "physics/continuous_trajectory.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -36,12 +38,62 @@ int const max_degree_age = 100;
 
 // Only supports 8 divisions for now.
 int const divisions = 8;
+// The minimal capacity of a |PublishedPolynomials| object.
+constexpr std::int64_t min_published_polynomials_capacity = 16;
+
+// Returns the index of the first element |p| of |pairs[0, size[| such that
+// |time <= p.t_max|, or |size| if there is none.  Except in old saves, the
+// polynomials start at |t_min| and each of them covers the same |duration|.
+// |hint| is the index of the last polynomial accessed, and is updated by this
+// function.
+template<typename Pair>
+std::int64_t IndexOfPolynomialForInstant(Pair const* const pairs,
+                                         std::int64_t const size,
+                                         Instant const& t_min,
+                                         Time const& duration,
+                                         Instant const& time,
+                                         std::atomic<std::int64_t>& hint) {
+  auto const is_polynomial_for_instant =
+      [pairs, size, &time](std::int64_t const index) {
+        return index < size && time <= pairs[index].t_max &&
+               (index == 0 || pairs[index - 1].t_max < time);
+      };
+  if (std::int64_t const index = hint.load(std::memory_order_relaxed);
+      is_polynomial_for_instant(index)) {
+    return index;
+  }
+  // When the polynomials are uniform, the index may be computed directly from
+  // |time|.  The polynomial for |time| is the one that ends at or after |time|,
+  // hence the ceiling.  Rounding may cause us to miss a neighbour, in which
+  // case we fall back to a binary search.
+  if (size > 0 && t_min <= time && time <= pairs[size - 1].t_max) {
+    std::int64_t const index = std::max<std::int64_t>(
+        0,
+        static_cast<std::int64_t>(std::ceil((time - t_min) / duration)) - 1);
+    if (is_polynomial_for_instant(index)) {
+      hint.store(index, std::memory_order_relaxed);
+      return index;
+    }
+  }
+  std::int64_t const index =
+      std::lower_bound(pairs,
+                       pairs + size,
+                       time,
+                       [](Pair const& left, Instant const& right) {
+                         return left.t_max < right;
+                       }) -
+      pairs;
+  hint.store(index, std::memory_order_relaxed);
+  return index;
+}
 
 template<typename Frame>
 ContinuousTrajectory<Frame>::ContinuousTrajectory(Time const& step,
-                                                  Length const& tolerance)
+                                                  Length const& tolerance,
+                                                  bool const minimize_storage)
     : step_(step),
       tolerance_(tolerance),
+      minimize_storage_(minimize_storage),
       checkpointer_(
           make_not_null_unique<
               Checkpointer<serialization::ContinuousTrajectory>>(
@@ -74,6 +126,40 @@ double ContinuousTrajectory<Frame>::average_degree() const {
   }
 }
 
+template<typename Frame>
+Frequency ContinuousTrajectory<Frame>::coefficients_per_unit_time() const {
+  absl::ReaderMutexLock l(&lock_);
+  if (polynomials_.empty()) {
+    return Frequency{};
+  } else {
+    double total = 0;
+    for (auto const& pair : polynomials_) {
+      total += pair.polynomial->degree() + 1;
+    }
+    return total / (polynomials_.back().t_max - *first_time_);
+  }
+}
+
+template<typename Frame>
+std::int64_t ContinuousTrajectory<Frame>::MemoryFootprint() const {
+  absl::ReaderMutexLock l(&lock_);
+  std::int64_t footprint = sizeof(*this) + checkpointer_->MemoryFootprint();
+  footprint += polynomials_.capacity() * sizeof(InstantPolynomialPair);
+  for (auto const& pair : polynomials_) {
+    // The coefficients, plus the virtual table pointer and the control block of
+    // the shared pointer.
+    footprint += (pair.polynomial->degree() + 1) * sizeof(Position<Frame>) +
+                 3 * sizeof(void*);
+  }
+  for (auto const& published_polynomials : all_published_polynomials_) {
+    footprint += sizeof(PublishedPolynomials) +
+                 published_polynomials->capacity *
+                     sizeof(typename PublishedPolynomials::Entry);
+  }
+  footprint += last_points_.capacity() * sizeof(last_points_.front());
+  return footprint;
+}
+
 template<typename Frame>
 absl::Status ContinuousTrajectory<Frame>::Append(
     Instant const& time,
@@ -111,6 +197,7 @@ absl::Status ContinuousTrajectory<Frame>::Append(
     v.push_back(degrees_of_freedom.velocity());
 
     status = ComputeBestNewhallApproximation(time, q, v);
+    PublishPolynomialsLocked(/*appended_only=*/true);
 
     // Wipe-out the points that have just been incorporated in a polynomial.
     last_points_.clear();
@@ -142,9 +229,10 @@ void ContinuousTrajectory<Frame>::Prepend(ContinuousTrajectory&& prefix) {
     degree_ = prefix.degree_;
     degree_age_ = prefix.degree_age_;
     polynomials_ = std::move(prefix.polynomials_);
-    last_accessed_polynomial_ = prefix.last_accessed_polynomial_;
+    last_accessed_polynomial_ = prefix.last_accessed_polynomial_.load();
     first_time_ = prefix.first_time_;
     last_points_ = prefix.last_points_;
+    PublishPolynomialsLocked(/*appended_only=*/false);
   } else {
     // The polynomials must be aligned, because the time computations only use
     // basic arithmetic and are platform-independent.  The space computations,
@@ -161,6 +249,7 @@ void ContinuousTrajectory<Frame>::Prepend(ContinuousTrajectory&& prefix) {
     // Note that any |last_points_| in |prefix| are irrelevant because they
     // correspond to a time interval covered by the first polynomial of this
     // object.
+    PublishPolynomialsLocked(/*appended_only=*/false);
   }
 }
 
@@ -179,6 +268,13 @@ Instant ContinuousTrajectory<Frame>::t_max() const {
 template<typename Frame>
 Position<Frame> ContinuousTrajectory<Frame>::EvaluatePosition(
     Instant const& time) const {
+  {
+    PublishedPolynomialsReader const reader(*this);
+    if (auto const* const entry = FindPublishedEntryForInstant(time);
+        entry != nullptr) {
+      return (*entry->polynomial)(time);
+    }
+  }
   absl::ReaderMutexLock l(&lock_);
   return EvaluatePositionLocked(time);
 }
@@ -186,6 +282,13 @@ Position<Frame> ContinuousTrajectory<Frame>::EvaluatePosition(
 template<typename Frame>
 Velocity<Frame> ContinuousTrajectory<Frame>::EvaluateVelocity(
     Instant const& time) const {
+  {
+    PublishedPolynomialsReader const reader(*this);
+    if (auto const* const entry = FindPublishedEntryForInstant(time);
+        entry != nullptr) {
+      return entry->polynomial->EvaluateDerivative(time);
+    }
+  }
   absl::ReaderMutexLock l(&lock_);
   return EvaluateVelocityLocked(time);
 }
@@ -193,10 +296,30 @@ Velocity<Frame> ContinuousTrajectory<Frame>::EvaluateVelocity(
 template<typename Frame>
 DegreesOfFreedom<Frame> ContinuousTrajectory<Frame>::EvaluateDegreesOfFreedom(
     Instant const& time) const {
+  {
+    PublishedPolynomialsReader const reader(*this);
+    if (auto const* const entry = FindPublishedEntryForInstant(time);
+        entry != nullptr) {
+      auto const& polynomial = *entry->polynomial;
+      return DegreesOfFreedom<Frame>(polynomial(time),
+                                     polynomial.EvaluateDerivative(time));
+    }
+  }
   absl::ReaderMutexLock l(&lock_);
   return EvaluateDegreesOfFreedomLocked(time);
 }
 
+template<typename Frame>
+std::shared_ptr<Polynomial<Position<Frame>, Instant> const>
+ContinuousTrajectory<Frame>::PolynomialForInstant(Instant const& time) const {
+  // All the polynomials are published when |lock_| is released, so if |time|
+  // is in range the entry must exist.
+  PublishedPolynomialsReader const reader(*this);
+  auto const* const entry = FindPublishedEntryForInstant(time);
+  CHECK(entry != nullptr) << time << " is not in the range of " << this;
+  return entry->polynomial;
+}
+
 #if PRINCIPIA_CONTINUOUS_TRAJECTORY_SUPPORTS_PIECEWISE_POISSON_SERIES
 
 template<typename Frame>
@@ -333,6 +456,9 @@ void ContinuousTrajectory<Frame>::WriteToMessage(
   checkpointer_->WriteToMessage(message->mutable_checkpoint());
   step_.WriteToMessage(message->mutable_step());
   tolerance_.WriteToMessage(message->mutable_tolerance());
+  if (minimize_storage_) {
+    message->set_minimize_storage(true);
+  }
 
   // There should be no polynomials before the oldest checkpoint in recent
   // saves, see Ephemeris::AppendMassiveBodiesState.  This has probably been
@@ -383,7 +509,8 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
   not_null<std::unique_ptr<ContinuousTrajectory<Frame>>> continuous_trajectory =
       std::make_unique<ContinuousTrajectory<Frame>>(
           Time::ReadFromMessage(message.step()),
-          Length::ReadFromMessage(message.tolerance()));
+          Length::ReadFromMessage(message.tolerance()),
+          message.minimize_storage());
   if (is_pre_cohen) {
     for (auto const& s : message.series()) {
       // Read the series, evaluate it and use the resulting values to build a
@@ -438,6 +565,10 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
     continuous_trajectory->first_time_ =
         Instant::ReadFromMessage(message.first_time());
   }
+  {
+    absl::MutexLock l(&continuous_trajectory->lock_);
+    continuous_trajectory->PublishPolynomialsLocked(/*appended_only=*/false);
+  }
 
   if (is_pre_grassmann) {
     serialization::ContinuousTrajectory serialized_continuous_trajectory;
@@ -489,6 +620,12 @@ void ContinuousTrajectory<Frame>::WriteToCheckpoint(Instant const& t) const {
   checkpointer_->WriteToCheckpoint(t);
 }
 
+template<typename Frame>
+void ContinuousTrajectory<Frame>::RemoveCheckpoints(
+    absl::btree_set<Instant> const& times) const {
+  checkpointer_->RemoveCheckpoints(times);
+}
+
 template<typename Frame>
 absl::Status ContinuousTrajectory<Frame>::ReadFromCheckpointAt(
     Instant const& t,
@@ -509,14 +646,22 @@ ContinuousTrajectory<Frame>::MakeCheckpointerWriter() {
       message->set_is_unstable(is_unstable_);
       message->set_degree(degree_);
       message->set_degree_age(degree_age_);
+      // The conversions below are exact, so the packed form round-trips.
+      auto* const packed_last_points = message->mutable_packed_last_points();
+      int const size = last_points_.size();
+      packed_last_points->mutable_time()->Reserve(size);
+      packed_last_points->mutable_position()->Reserve(3 * size);
+      packed_last_points->mutable_velocity()->Reserve(3 * size);
       for (auto const& [instant, degrees_of_freedom] : last_points_) {
-        not_null<serialization::ContinuousTrajectory::
-                     InstantaneousDegreesOfFreedom*> const
-            instantaneous_degrees_of_freedom = message->add_last_point();
-        instant.WriteToMessage(
-            instantaneous_degrees_of_freedom->mutable_instant());
-        degrees_of_freedom.WriteToMessage(
-            instantaneous_degrees_of_freedom->mutable_degrees_of_freedom());
+        auto const q = degrees_of_freedom.position() - Frame::origin;
+        auto const p = degrees_of_freedom.velocity();
+        packed_last_points->add_time((instant - Instant{}) / Second);
+        packed_last_points->add_position(q.coordinates().x / Metre);
+        packed_last_points->add_position(q.coordinates().y / Metre);
+        packed_last_points->add_position(q.coordinates().z / Metre);
+        packed_last_points->add_velocity(p.coordinates().x / (Metre / Second));
+        packed_last_points->add_velocity(p.coordinates().y / (Metre / Second));
+        packed_last_points->add_velocity(p.coordinates().z / (Metre / Second));
       }
     };
   } else {
@@ -539,10 +684,31 @@ ContinuousTrajectory<Frame>::MakeCheckpointerReader() {
       degree_ = message.degree();
       degree_age_ = message.degree_age();
       last_points_.clear();
-      for (auto const& l : message.last_point()) {
-        last_points_.push_back(
-            {Instant::ReadFromMessage(l.instant()),
-             DegreesOfFreedom<Frame>::ReadFromMessage(l.degrees_of_freedom())});
+      if (message.has_packed_last_points()) {
+        auto const& t = message.packed_last_points().time();
+        auto const& q = message.packed_last_points().position();
+        auto const& p = message.packed_last_points().velocity();
+        CHECK_EQ(3 * t.size(), q.size());
+        CHECK_EQ(3 * t.size(), p.size());
+        last_points_.reserve(t.size());
+        for (int i = 0; i < t.size(); ++i) {
+          last_points_.push_back(
+              {Instant() + t[i] * Second,
+               DegreesOfFreedom<Frame>(
+                   Frame::origin + Displacement<Frame>({q[3 * i] * Metre,
+                                                        q[3 * i + 1] * Metre,
+                                                        q[3 * i + 2] * Metre}),
+                   Velocity<Frame>({p[3 * i] * (Metre / Second),
+                                    p[3 * i + 1] * (Metre / Second),
+                                    p[3 * i + 2] * (Metre / Second)}))});
+        }
+      } else {
+        for (auto const& l : message.last_point()) {
+          last_points_.push_back(
+              {Instant::ReadFromMessage(l.instant()),
+               DegreesOfFreedom<Frame>::ReadFromMessage(
+                   l.degrees_of_freedom())});
+        }
       }
 
       // Restore the other members to their state at the time of the checkpoint.
@@ -570,6 +736,7 @@ ContinuousTrajectory<Frame>::MakeCheckpointerReader() {
         }
       }
       last_accessed_polynomial_ = 0;  // Always a valid value.
+      PublishPolynomialsLocked(/*appended_only=*/false);
 
       return absl::OkStatus();
     };
@@ -637,6 +804,34 @@ ContinuousTrajectory<Frame>::ContinuousTrajectory()
           /*reader=*/nullptr,
           /*writer=*/nullptr)) {}
 
+template<typename Frame>
+ContinuousTrajectory<Frame>::PublishedPolynomials::PublishedPolynomials(
+    Instant const& t_min,
+    std::int64_t const capacity)
+    : t_min(t_min),
+      capacity(capacity),
+      entries(std::make_unique<Entry[]>(capacity)) {}
+
+template<typename Frame>
+ContinuousTrajectory<Frame>::PublishedPolynomialsReader::
+PublishedPolynomialsReader(ContinuousTrajectory const& trajectory)
+    : count_([&trajectory]() -> std::atomic<std::int64_t>& {
+        thread_local std::size_t const index =
+            std::hash<std::thread::id>()(std::this_thread::get_id()) %
+            number_of_reader_counts;
+        return trajectory.reader_counts_[index].count;
+      }()) {
+  // Sequentially consistent, so that a publication that doesn't see this
+  // increment is seen by the subsequent loads of |published_polynomials_|.
+  count_.fetch_add(1, std::memory_order_seq_cst);
+}
+
+template<typename Frame>
+ContinuousTrajectory<Frame>::PublishedPolynomialsReader::
+~PublishedPolynomialsReader() {
+  count_.fetch_sub(1, std::memory_order_release);
+}
+
 template<typename Frame>
 ContinuousTrajectory<Frame>::InstantPolynomialPair::InstantPolynomialPair(
     Instant const t_max,
@@ -661,6 +856,18 @@ ContinuousTrajectory<Frame>::NewhallApproximationInMonomialBasis(
                                                error_estimate);
 }
 
+template<typename Frame>
+Displacement<Frame>
+ContinuousTrajectory<Frame>::NewhallApproximationErrorEstimate(
+    int const degree,
+    std::vector<Position<Frame>> const& q,
+    std::vector<Velocity<Frame>> const& v,
+    Instant const& t_min,
+    Instant const& t_max) const {
+  return numerics::_newhall::NewhallApproximationErrorEstimate(
+      degree, q, v, t_min, t_max);
+}
+
 template<typename Frame>
 absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     Instant const& time,
@@ -680,20 +887,35 @@ absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     degree_age_ = 0;
   }
 
-  // Compute the approximation with the current degree.
-  Displacement<Frame> displacement_error_estimate;
-  polynomials_.emplace_back(time,
-                            NewhallApproximationInMonomialBasis(
-                                degree_,
-                                q, v,
-                                last_points_.cbegin()->first, time,
-                                displacement_error_estimate));
+  // The degree is selected using only the error estimates, which are much
+  // cheaper than the approximations.  The approximation is only computed once
+  // at the end, for the last degree for which an estimate was computed.
+  Instant const& t_min = last_points_.cbegin()->first;
+  int fitted_degree = degree_;
 
-  // Estimate the error.  For initializing |previous_error_estimate|, any value
-  // greater than |error_estimate| will do.
-  Length error_estimate = displacement_error_estimate.Norm();
+  // Estimate the error with the current degree.  For initializing
+  // |previous_error_estimate|, any value greater than |error_estimate| will do.
+  Length error_estimate =
+      NewhallApproximationErrorEstimate(degree_, q, v, t_min, time).Norm();
   Length previous_error_estimate = error_estimate + error_estimate;
 
+  // When minimizing storage, try to do with one coefficient less.  In the zone
+  // of numerical instabilities the estimates are not reliable enough for that.
+  if (minimize_storage_ && !is_unstable_ &&
+      degree_ > min_degree && error_estimate <= adjusted_tolerance_) {
+    Length const lower_error_estimate =
+        NewhallApproximationErrorEstimate(degree_ - 1, q, v, t_min, time)
+            .Norm();
+    if (lower_error_estimate <= adjusted_tolerance_) {
+      --degree_;
+      VLOG(1) << "Lowering degree for " << this << " to " << degree_
+              << " because error estimate is " << lower_error_estimate;
+      fitted_degree = degree_;
+      error_estimate = lower_error_estimate;
+      previous_error_estimate = error_estimate + error_estimate;
+    }
+  }
+
   // If we are in the zone of numerical instabilities and we exceeded the
   // tolerance, restart from the lowest degree.
   if (is_unstable_ && error_estimate > adjusted_tolerance_) {
@@ -719,13 +941,10 @@ absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     ++degree_;
     VLOG(1) << "Increasing degree for " << this << " to " <<degree_
             << " because error estimate was " << error_estimate;
-    polynomials_.back().polynomial = NewhallApproximationInMonomialBasis(
-                                         degree_,
-                                         q, v,
-                                         last_points_.cbegin()->first, time,
-                                         displacement_error_estimate);
+    fitted_degree = degree_;
     previous_error_estimate = error_estimate;
-    error_estimate = displacement_error_estimate.Norm();
+    error_estimate =
+        NewhallApproximationErrorEstimate(degree_, q, v, t_min, time).Norm();
   }
 
   // If we have entered the zone of numerical instability, go back to the
@@ -746,6 +965,14 @@ absl::Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
             << " with error estimate " << error_estimate;
   }
 
+  Displacement<Frame> displacement_error_estimate;
+  polynomials_.emplace_back(time,
+                            NewhallApproximationInMonomialBasis(
+                                fitted_degree,
+                                q, v,
+                                t_min, time,
+                                displacement_error_estimate));
+
   ++degree_age_;
 
   // Check that the tolerance did not explode.
@@ -769,25 +996,84 @@ typename ContinuousTrajectory<Frame>::InstantPolynomialPairs::const_iterator
 ContinuousTrajectory<Frame>::FindPolynomialForInstantLocked(
     Instant const& time) const {
   // This returns the first polynomial |p| such that |time <= p.t_max|.
-  {
-    auto const begin = polynomials_.begin();
-    auto const it = begin + last_accessed_polynomial_;
-    if (it != polynomials_.end() && time <= it->t_max &&
-        (it == begin || std::prev(it)->t_max < time)) {
-      return it;
-    }
+  return polynomials_.begin() +
+         IndexOfPolynomialForInstant(polynomials_.data(),
+                                     polynomials_.size(),
+                                     first_time_.value_or(Instant()),
+                                     divisions * step_,
+                                     time,
+                                     last_accessed_polynomial_);
+}
+
+template<typename Frame>
+typename ContinuousTrajectory<Frame>::PublishedPolynomials::Entry const*
+ContinuousTrajectory<Frame>::FindPublishedEntryForInstant(
+    Instant const& time) const {
+  PublishedPolynomials const* const published =
+      published_polynomials_.load(std::memory_order_seq_cst);
+  if (published == nullptr) {
+    return nullptr;
   }
-  {
-    auto const it =
-        std::lower_bound(polynomials_.begin(),
-                         polynomials_.end(),
-                         time,
-                         [](InstantPolynomialPair const& left,
-                            Instant const& right) {
-                           return left.t_max < right;
-                         });
-    last_accessed_polynomial_ = it - polynomials_.begin();
-    return it;
+  std::int64_t const size = published->size.load(std::memory_order_acquire);
+  auto const* const entries = published->entries.get();
+  if (size == 0 || time < published->t_min || time > entries[size - 1].t_max) {
+    return nullptr;
+  }
+  // Note that the hint may be shared with |FindPolynomialForInstantLocked|:
+  // any value is correct.
+  std::int64_t const index =
+      IndexOfPolynomialForInstant(entries,
+                                  size,
+                                  published->t_min,
+                                  divisions * step_,
+                                  time,
+                                  last_accessed_polynomial_);
+  return &entries[index];
+}
+
+template<typename Frame>
+void ContinuousTrajectory<Frame>::PublishPolynomialsLocked(
+    bool const appended_only) {
+  lock_.AssertHeld();
+  std::int64_t const size = polynomials_.size();
+  PublishedPolynomials* published =
+      all_published_polynomials_.empty()
+          ? nullptr
+          : all_published_polynomials_.back().get();
+  std::int64_t first_unpublished = 0;
+  if (appended_only && published != nullptr && size <= published->capacity) {
+    first_unpublished = published->size.load(std::memory_order_relaxed);
+  } else if (published == nullptr && size == 0) {
+    return;
+  } else {
+    published = all_published_polynomials_
+                    .emplace_back(make_not_null_unique<PublishedPolynomials>(
+                        t_min_locked(),
+                        std::max(min_published_polynomials_capacity,
+                                 2 * size)))
+                    .get();
+  }
+  for (std::int64_t i = first_unpublished; i < size; ++i) {
+    auto& entry = published->entries[i];
+    entry.t_max = polynomials_[i].t_max;
+    entry.polynomial = polynomials_[i].polynomial;
+  }
+  published->size.store(size, std::memory_order_release);
+  published_polynomials_.store(published, std::memory_order_seq_cst);
+
+  // The readers register before loading |published_polynomials_|, so if none
+  // is registered now, those that come later can only see |published|, and
+  // the retired objects may be destroyed.  Otherwise they are left for a later
+  // publication.
+  if (all_published_polynomials_.size() > 1 &&
+      std::all_of(reader_counts_.begin(),
+                  reader_counts_.end(),
+                  [](ReaderCount const& reader_count) {
+                    return reader_count.count.load(std::memory_order_seq_cst) ==
+                           0;
+                  })) {
+    all_published_polynomials_.erase(all_published_polynomials_.begin(),
+                                     all_published_polynomials_.end() - 1);
   }
 }
 
@@ -4,6 +4,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -70,6 +71,15 @@ class TestableContinuousTrajectory : public ContinuousTrajectory<Frame> {
       Instant const& t_max,
       Displacement<Frame>& error_estimate) const override;
 
+  // Fake the Newhall error estimate.  The degree selection only uses the error
+  // estimates, so this is where the mock is called.
+  Displacement<Frame> NewhallApproximationErrorEstimate(
+      int degree,
+      std::vector<Position<Frame>> const& q,
+      std::vector<Velocity<Frame>> const& v,
+      Instant const& t_min,
+      Instant const& t_max) const override;
+
   MOCK_METHOD(
       void,
       FillNewhallApproximationInMonomialBasis,
@@ -108,14 +118,27 @@ TestableContinuousTrajectory<Frame>::NewhallApproximationInMonomialBasis(
                 Position<Frame>, Instant, /*degree=*/1, HornerEvaluator>;
   typename P::Coefficients const coefficients = {Position<Frame>(),
                                                  Velocity<Frame>()};
-  not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
-      polynomial = make_not_null_unique<P>(coefficients, Instant());
+  return make_not_null_unique<P>(coefficients, Instant());
+}
+
+template<typename Frame>
+Displacement<Frame>
+TestableContinuousTrajectory<Frame>::NewhallApproximationErrorEstimate(
+    int const degree,
+    std::vector<Position<Frame>> const& q,
+    std::vector<Velocity<Frame>> const& v,
+    Instant const& t_min,
+    Instant const& t_max) const {
+  Displacement<Frame> error_estimate;
+  not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>> polynomial =
+      NewhallApproximationInMonomialBasis(
+          degree, q, v, t_min, t_max, error_estimate);
   FillNewhallApproximationInMonomialBasis(degree,
                                           q, v,
                                           t_min, t_max,
                                           error_estimate,
                                           polynomial);
-  return polynomial;
+  return error_estimate;
 }
 
 template<typename Frame>
@@ -186,7 +209,23 @@ class ContinuousTrajectoryTest : public testing::Test {
     pre_grassmann.set_is_unstable(checkpoint.is_unstable());
     pre_grassmann.set_degree(checkpoint.degree());
     pre_grassmann.set_degree_age(checkpoint.degree_age());
-    pre_grassmann.mutable_last_point()->Swap(checkpoint.mutable_last_point());
+    // The packed last points didn't exist before Grassmann.
+    auto const& t = checkpoint.packed_last_points().time();
+    auto const& q = checkpoint.packed_last_points().position();
+    auto const& p = checkpoint.packed_last_points().velocity();
+    for (int i = 0; i < t.size(); ++i) {
+      auto* const last_point = pre_grassmann.add_last_point();
+      (Instant() + t[i] * Second).WriteToMessage(
+          last_point->mutable_instant());
+      DegreesOfFreedom<World>(
+          World::origin + Displacement<World>({q[3 * i] * Metre,
+                                               q[3 * i + 1] * Metre,
+                                               q[3 * i + 2] * Metre}),
+          Velocity<World>({p[3 * i] * (Metre / Second),
+                           p[3 * i + 1] * (Metre / Second),
+                           p[3 * i + 2] * (Metre / Second)}))
+          .WriteToMessage(last_point->mutable_degrees_of_freedom());
+    }
     if (checkpoint_time.has_value()) {
       // This is post-Fatou.
       checkpoint_time->WriteToMessage(pre_grassmann.mutable_checkpoint_time());
@@ -424,6 +463,89 @@ TEST_F(ContinuousTrajectoryTest, BestNewhallApproximation) {
   }
 }
 
+TEST_F(ContinuousTrajectoryTest, BestNewhallApproximationMinimizeStorage) {
+  Time const step = 1 * Second;
+  Length const tolerance = 1 * Metre;
+  Instant t = t0_;
+  std::vector<Position<World>> const q;
+  std::vector<Velocity<World>> const v;
+
+  auto const trajectory = std::make_unique<TestableContinuousTrajectory<World>>(
+                              step,
+                              tolerance,
+                              /*minimize_storage=*/true);
+  EXPECT_OK(trajectory->Append(
+      Instant(), DegreesOfFreedom<World>(World::origin, World::unmoving)));
+
+  // The degree increases as usual.
+  {
+    Sequence s;
+    EXPECT_CALL(*trajectory,
+                FillNewhallApproximationInMonomialBasis(3, _, _, _, _, _, _))
+        .WillOnce(SetArgReferee<5>(
+            Displacement<World>({2 * Metre, 2 * Metre, 2 * Metre})));
+    EXPECT_CALL(*trajectory,
+                FillNewhallApproximationInMonomialBasis(4, _, _, _, _, _, _))
+        .WillOnce(SetArgReferee<5>(
+            Displacement<World>({0.2 * Metre, 0.2 * Metre, 0.2 * Metre})));
+    t += step;
+    EXPECT_OK(trajectory->LockAndComputeBestNewhallApproximation(t, q, v));
+    EXPECT_EQ(4, trajectory->degree());
+  }
+
+  // The lower degree is tried, and it is good enough.
+  {
+    Sequence s;
+    EXPECT_CALL(*trajectory,
+                FillNewhallApproximationInMonomialBasis(4, _, _, _, _, _, _))
+        .WillOnce(SetArgReferee<5>(
+            Displacement<World>({0.2 * Metre, 0.2 * Metre, 0.2 * Metre})));
+    EXPECT_CALL(*trajectory,
+                FillNewhallApproximationInMonomialBasis(3, _, _, _, _, _, _))
+        .WillOnce(SetArgReferee<5>(
+            Displacement<World>({0.5 * Metre, 0.5 * Metre, 0.5 * Metre})));
+    t += step;
+    EXPECT_OK(trajectory->LockAndComputeBestNewhallApproximation(t, q, v));
+    EXPECT_EQ(3, trajectory->degree());
+    EXPECT_EQ(tolerance, trajectory->adjusted_tolerance());
+    EXPECT_FALSE(trajectory->is_unstable());
+  }
+
+  // Back to degree 4...
+  {
+    Sequence s;
+    EXPECT_CALL(*trajectory,
+                FillNewhallApproximationInMonomialBasis(3, _, _, _, _, _, _))
+        .WillOnce(SetArgReferee<5>(
+            Displacement<World>({2 * Metre, 2 * Metre, 2 * Metre})));
+    EXPECT_CALL(*trajectory,
+                FillNewhallApproximationInMonomialBasis(4, _, _, _, _, _, _))
+        .WillOnce(SetArgReferee<5>(
+            Displacement<World>({0.2 * Metre, 0.2 * Metre, 0.2 * Metre})));
+    t += step;
+    EXPECT_OK(trajectory->LockAndComputeBestNewhallApproximation(t, q, v));
+    EXPECT_EQ(4, trajectory->degree());
+  }
+
+  // ...where we stay because the lower degree is not good enough.
+  {
+    Sequence s;
+    EXPECT_CALL(*trajectory,
+                FillNewhallApproximationInMonomialBasis(4, _, _, _, _, _, _))
+        .WillOnce(SetArgReferee<5>(
+            Displacement<World>({0.2 * Metre, 0.2 * Metre, 0.2 * Metre})));
+    EXPECT_CALL(*trajectory,
+                FillNewhallApproximationInMonomialBasis(3, _, _, _, _, _, _))
+        .WillOnce(SetArgReferee<5>(
+            Displacement<World>({2 * Metre, 2 * Metre, 2 * Metre})));
+    t += step;
+    EXPECT_OK(trajectory->LockAndComputeBestNewhallApproximation(t, q, v));
+    EXPECT_EQ(4, trajectory->degree());
+    EXPECT_EQ(tolerance, trajectory->adjusted_tolerance());
+    EXPECT_FALSE(trajectory->is_unstable());
+  }
+}
+
 // A trajectory defined by a degree-1 polynomial.
 TEST_F(ContinuousTrajectoryTest, Polynomial) {
   int const number_of_steps = 20;
@@ -449,6 +571,7 @@ TEST_F(ContinuousTrajectoryTest, Polynomial) {
                               /*tolerance=*/0.1 * Metre);
 
   EXPECT_TRUE(trajectory->empty());
+  std::int64_t const empty_footprint = trajectory->MemoryFootprint();
   FillTrajectory(number_of_steps,
                  step,
                  position_function,
@@ -459,6 +582,9 @@ TEST_F(ContinuousTrajectoryTest, Polynomial) {
   EXPECT_EQ(t0_ + step, trajectory->t_min());
   EXPECT_EQ(t0_ + (((number_of_steps - 1) / 8) * 8 + 1) * step,
             trajectory->t_max());
+  EXPECT_LT(empty_footprint, trajectory->MemoryFootprint());
+  EXPECT_THAT(trajectory->coefficients_per_unit_time(),
+              AlmostEquals((3 + 1) / (8 * step), 0, 4));
 
   // Check that the positions and velocities match the ones given by the
   // functions above.
@@ -491,6 +617,124 @@ TEST_F(ContinuousTrajectoryTest, Polynomial) {
 #endif
 }
 
+// Checks that the lookup of the polynomials gives the same results
+// irrespective of the order in which the times are accessed.
+TEST_F(ContinuousTrajectoryTest, LookupOrder) {
+  int const number_of_steps = 801;
+  Time const step = 10 * Second;
+  Time const period = 1000 * Second;
+
+  auto position_function =
+      [this, period](Instant const t) {
+        Angle const angle = 2 * π * Radian * (t - t0_) / period;
+        return World::origin +
+            Displacement<World>({Cos(angle) * Metre,
+                                 Sin(angle) * Metre,
+                                 0 * Metre});
+      };
+  auto velocity_function =
+      [this, period](Instant const t) {
+        AngularFrequency const ω = 2 * π * Radian / period;
+        Angle const angle = ω * (t - t0_);
+        return Velocity<World>({-ω * Sin(angle) * Metre / Radian,
+                                ω * Cos(angle) * Metre / Radian,
+                                0 * Metre / Second});
+      };
+
+  auto const forward = std::make_unique<ContinuousTrajectory<World>>(
+                           step,
+                           /*tolerance=*/1 * Micro(Metre));
+  auto const backward = std::make_unique<ContinuousTrajectory<World>>(
+                            step,
+                            /*tolerance=*/1 * Micro(Metre));
+  FillTrajectory(number_of_steps,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_,
+                 *forward);
+  FillTrajectory(number_of_steps,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_,
+                 *backward);
+
+  // Include the boundaries between polynomials, where an off-by-one error in
+  // the lookup would be detected.
+  std::vector<Instant> times;
+  for (Instant time = forward->t_min();
+       time <= forward->t_max();
+       time += step / 2) {
+    times.push_back(time);
+  }
+  std::vector<Position<World>> forward_positions;
+  for (Instant const& time : times) {
+    forward_positions.push_back(forward->EvaluatePosition(time));
+  }
+  for (int i = times.size() - 1; i >= 0; --i) {
+    EXPECT_EQ(forward_positions[i], backward->EvaluatePosition(times[i]))
+        << times[i];
+  }
+}
+
+// Checks that the trajectory may be evaluated while it is being appended to.
+TEST_F(ContinuousTrajectoryTest, ConcurrentEvaluation) {
+  int const number_of_steps = 8001;
+  Time const step = 10 * Second;
+  Time const period = 1000 * Second;
+
+  auto position_function =
+      [this, period](Instant const t) {
+        Angle const angle = 2 * π * Radian * (t - t0_) / period;
+        return World::origin +
+            Displacement<World>({Cos(angle) * Metre,
+                                 Sin(angle) * Metre,
+                                 0 * Metre});
+      };
+  auto velocity_function =
+      [this, period](Instant const t) {
+        AngularFrequency const ω = 2 * π * Radian / period;
+        Angle const angle = ω * (t - t0_);
+        return Velocity<World>({-ω * Sin(angle) * Metre / Radian,
+                                ω * Cos(angle) * Metre / Radian,
+                                0 * Metre / Second});
+      };
+
+  auto const trajectory = std::make_unique<ContinuousTrajectory<World>>(
+                              step,
+                              /*tolerance=*/1 * Micro(Metre));
+  std::thread writer([this,
+                      number_of_steps,
+                      step,
+                      &position_function,
+                      &velocity_function,
+                      &trajectory]() {
+    FillTrajectory(number_of_steps,
+                   step,
+                   position_function,
+                   velocity_function,
+                   t0_,
+                   *trajectory);
+  });
+  while (trajectory->empty()) {}
+  Instant const t_final = t0_ + number_of_steps * step;
+  std::vector<std::pair<Instant, Position<World>>> evaluations;
+  for (Instant t_max = trajectory->t_max();
+       t_max + 8 * step < t_final;
+       t_max = trajectory->t_max()) {
+    Instant const t = trajectory->t_min() + (t_max - trajectory->t_min()) / 3;
+    evaluations.emplace_back(t, trajectory->EvaluatePosition(t));
+    evaluations.emplace_back(t_max, trajectory->EvaluatePosition(t_max));
+  }
+  writer.join();
+
+  // The polynomials don't change once they have been appended.
+  for (auto const& [t, position] : evaluations) {
+    EXPECT_EQ(position, trajectory->EvaluatePosition(t)) << t;
+  }
+}
+
 // An approximation to the trajectory of Io.
 TEST_F(ContinuousTrajectoryTest, Io) {
   int const number_of_steps = 200;
@@ -709,6 +953,70 @@ TEST_F(ContinuousTrajectoryTest, Prepend) {
   }
 }
 
+// Checks that the objects published for the readers don't accumulate when the
+// trajectory is repeatedly prepended to.
+TEST_F(ContinuousTrajectoryTest, RepeatedPrepend) {
+  int const number_of_segments = 20;
+  int const number_of_steps = 4 * 8;
+  // A step that makes the computations on the times exact, so that the
+  // segments can be joined.
+  Time const step = 1 * Second;
+  Length const tolerance = 0.1 * Metre;
+
+  auto position_function =
+      [this](Instant const t) {
+        return World::origin +
+            Displacement<World>({(t - t0_) * 3 * Metre / Second,
+                                 (t - t0_) * 5 * Metre / Second,
+                                 (t - t0_) * (-2) * Metre / Second});
+      };
+  auto velocity_function =
+      [](Instant const t) {
+        return Velocity<World>({3 * Metre / Second,
+                                5 * Metre / Second,
+                                -2 * Metre / Second});
+      };
+
+  // Consecutive segments, each starting at the |t_max| of the previous one.
+  std::vector<std::unique_ptr<ContinuousTrajectory<World>>> segments;
+  Instant t_min = t0_;
+  for (int i = 0; i < number_of_segments; ++i) {
+    auto& segment = segments.emplace_back(
+        std::make_unique<ContinuousTrajectory<World>>(step, tolerance));
+    FillTrajectory(number_of_steps + 1,
+                   step,
+                   position_function,
+                   velocity_function,
+                   t_min - step,  // First point at t_min.
+                   *segment);
+    t_min = segment->t_max();
+  }
+
+  // The same points, appended to a single trajectory.
+  auto const appended =
+      std::make_unique<ContinuousTrajectory<World>>(step, tolerance);
+  FillTrajectory(number_of_segments * number_of_steps + 1,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_ - step,
+                 *appended);
+
+  // Build the trajectory backwards, evaluating it after each prepending.
+  auto const prepended = std::move(segments.back());
+  for (int i = number_of_segments - 2; i >= 0; --i) {
+    prepended->Prepend(std::move(*segments[i]));
+    Instant const t = prepended->t_min() + number_of_steps / 2 * step;
+    EXPECT_LT((prepended->EvaluatePosition(t) - position_function(t)).Norm(),
+              tolerance);
+  }
+  EXPECT_EQ(appended->t_min(), prepended->t_min());
+
+  // If the objects published by each prepending were kept, the footprint would
+  // be about three times that of the appended trajectory.
+  EXPECT_LT(prepended->MemoryFootprint(), 1.5 * appended->MemoryFootprint());
+}
+
 TEST_F(ContinuousTrajectoryTest, Serialization) {
   int const number_of_steps = 20;
   int const number_of_substeps = 50;
@@ -763,7 +1071,8 @@ TEST_F(ContinuousTrajectoryTest, Serialization) {
   EXPECT_TRUE(checkpoint.has_is_unstable());
   EXPECT_EQ(3, checkpoint.degree());
   EXPECT_GE(100, checkpoint.degree_age());
-  EXPECT_EQ(4, checkpoint.last_point_size());
+  EXPECT_EQ(0, checkpoint.last_point_size());
+  EXPECT_EQ(4, checkpoint.packed_last_points().time_size());
 
   auto const trajectory_read = ContinuousTrajectory<World>::ReadFromMessage(
       /*desired_t_min=*/InfiniteFuture,
@@ -1019,7 +1328,8 @@ TEST_F(ContinuousTrajectoryTest, Checkpoint) {
   EXPECT_TRUE(checkpoint.has_is_unstable());
   EXPECT_EQ(3, checkpoint.degree());
   EXPECT_GE(100, checkpoint.degree_age());
-  EXPECT_EQ(6, checkpoint.last_point_size());
+  EXPECT_EQ(0, checkpoint.last_point_size());
+  EXPECT_EQ(6, checkpoint.packed_last_points().time_size());
 
   // Read the trajectory and check that everything is identical up to the
   // checkpoint.
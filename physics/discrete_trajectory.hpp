@@ -80,12 +80,25 @@ class DiscreteTrajectory : public Trajectory<Frame> {
   iterator lower_bound(Instant const& t) const;
   iterator upper_bound(Instant const& t) const;
 
+  // Same as |lower_bound(t)|, but the search starts at |hint|, which may be any
+  // valid iterator, including |end()|.  This only takes a few steps if the
+  // result is close to |hint|, e.g., when the trajectory is queried repeatedly
+  // at nearby times; otherwise it falls back to a binary search.
+  iterator lower_bound(iterator hint, Instant const& t) const;
+
   SegmentRange segments() const;
   // TODO(phl): In C++20 this should be a reverse_view on segments.
   ReverseSegmentRange rsegments() const;
 
   SegmentIterator NewSegment();
 
+  // Returns a copy of this trajectory, with the same segments, points, and
+  // downsampling state.  This is faster than appending the points one by one.
+  // Furthermore, with the chunked timeline, the chunks of points are shared
+  // between the copy and this trajectory until either is modified, so the copy
+  // is proportional to the number of chunks, not of points.
+  DiscreteTrajectory MakeCopy() const;
+
   DiscreteTrajectory DetachSegments(SegmentIterator begin);
   SegmentIterator AttachSegments(DiscreteTrajectory trajectory);
   void DeleteSegments(SegmentIterator& begin);
@@ -125,6 +138,18 @@ class DiscreteTrajectory : public Trajectory<Frame> {
   DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(
       Instant const& t) const override;
 
+  // Same as above, but the bracketing interval is found using
+  // |lower_bound(hint, t)|, and |hint| is updated for the next call.  A caller
+  // that evaluates the trajectory at nearby times should keep its own |hint|,
+  // initially |begin()|, and pass it to each call: the evaluation is then O(1)
+  // amortized.  |hint| must not be shared across threads.
+  DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(Instant const& t,
+                                                   iterator& hint) const;
+
+  // Returns an estimate of the number of bytes used by this trajectory and its
+  // segments.
+  std::int64_t MemoryFootprint() const;
+
   // The segments in |tracked| are restored at deserialization.  The points
   // denoted by |exact| are written and re-read exactly and are not affected by
   // any errors introduced by zfp compression.  The endpoints of each segment
@@ -139,6 +139,38 @@ DiscreteTrajectory<Frame>::upper_bound(Instant const& t) const {
   return it.has_value() ? *it : end();
 }
 
+template<typename Frame>
+typename DiscreteTrajectory<Frame>::iterator
+DiscreteTrajectory<Frame>::lower_bound(iterator hint, Instant const& t) const {
+  // The number of points that we are willing to walk before falling back to a
+  // binary search.
+  constexpr int max_steps = 8;
+  auto const begin = this->begin();
+  auto const end = this->end();
+  if (hint != end && hint->time < t) {
+    // Walk forward until reaching a point at or after |t|.
+    for (int step = 0; step < max_steps; ++step) {
+      ++hint;
+      if (hint == end || hint->time >= t) {
+        return hint;
+      }
+    }
+  } else {
+    // Walk backward while the previous point is at or after |t|.
+    for (int step = 0; step < max_steps; ++step) {
+      if (hint == begin) {
+        return hint;
+      }
+      auto const previous = std::prev(hint);
+      if (previous->time < t) {
+        return hint;
+      }
+      hint = previous;
+    }
+  }
+  return lower_bound(t);
+}
+
 template<typename Frame>
 typename DiscreteTrajectory<Frame>::SegmentRange
 DiscreteTrajectory<Frame>::segments() const {
@@ -188,6 +220,37 @@ DiscreteTrajectory<Frame>::NewSegment() {
   return new_self;
 }
 
+template<typename Frame>
+DiscreteTrajectory<Frame> DiscreteTrajectory<Frame>::MakeCopy() const {
+  DiscreteTrajectory copy(uninitialized);
+  for (auto const& segment : *segments_) {
+    copy.segments_->emplace_back();
+    auto const sit = --copy.segments_->end();
+    auto const self = SegmentIterator(copy.segments_.get(), sit);
+    *sit = DiscreteTrajectorySegment<Frame>(self);
+    sit->downsampling_parameters_ = segment.downsampling_parameters_;
+    sit->number_of_dense_points_ = segment.number_of_dense_points_;
+    sit->was_downsampled_ = segment.was_downsampled_;
+    sit->timeline_ = segment.timeline_;
+    sit->serialized_ = segment.serialized_;
+  }
+
+  // The left endpoints are in the order of the segments.
+  auto sit = segments_->cbegin();
+  auto copy_sit = copy.segments_->begin();
+  for (auto const& [t, leit] : segment_by_left_endpoint_) {
+    while (sit != leit) {
+      ++sit;
+      ++copy_sit;
+    }
+    copy.segment_by_left_endpoint_.insert_or_assign(
+        copy.segment_by_left_endpoint_.end(), t, copy_sit);
+  }
+
+  CHECK_OK(copy.ConsistencyStatus());
+  return copy;
+}
+
 template<typename Frame>
 DiscreteTrajectory<Frame>
 DiscreteTrajectory<Frame>::DetachSegments(SegmentIterator const begin) {
@@ -495,6 +558,41 @@ DegreesOfFreedom<Frame> DiscreteTrajectory<Frame>::EvaluateDegreesOfFreedom(
   return FindSegment(t)->second->EvaluateDegreesOfFreedom(t);
 }
 
+template<typename Frame>
+DegreesOfFreedom<Frame> DiscreteTrajectory<Frame>::EvaluateDegreesOfFreedom(
+    Instant const& t,
+    iterator& hint) const {
+  hint = lower_bound(hint, t);
+  CHECK(hint != end()) << "Time " << t << " is after " << t_max();
+  if (hint->time == t) {
+    return hint->degrees_of_freedom;
+  }
+  auto const& segment = *hint.segment_;
+  auto const& upper = iterator::iterator(hint.point_);
+  if (upper == segment.timeline_begin()) {
+    // The interval bracketing |t| is not within a segment: this happens if |t|
+    // precedes the beginning of the trajectory, or if the segments are not
+    // contiguous.  Let the general code deal with it.
+    return EvaluateDegreesOfFreedom(t);
+  }
+  auto const interpolation = segment.GetInterpolation(upper);
+  return {interpolation.Evaluate(t), interpolation.EvaluateDerivative(t)};
+}
+
+template<typename Frame>
+std::int64_t DiscreteTrajectory<Frame>::MemoryFootprint() const {
+  // The list of segments and the map of left endpoints store one node per
+  // segment, each with a couple of pointers of overhead.
+  std::int64_t footprint = sizeof(*this);
+  for (auto const& segment : *segments_) {
+    footprint += segment.MemoryFootprint() + 2 * sizeof(void*);
+  }
+  footprint += segment_by_left_endpoint_.size() *
+               (sizeof(typename SegmentByLeftEndpoint::value_type) +
+                2 * sizeof(void*));
+  return footprint;
+}
+
 template<typename Frame>
 void DiscreteTrajectory<Frame>::WriteToMessage(
     not_null<serialization::DiscreteTrajectory*> message,
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -129,6 +130,10 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
   // not to depend on the actual structure of the timeline.
   bool was_downsampled() const;
 
+  // Returns an estimate of the number of bytes used by this segment.  The
+  // overhead of the timeline's nodes is not accounted for.
+  std::int64_t MemoryFootprint() const;
+
   // The points denoted by |exact| are written and re-read exactly and are not
   // affected by any errors introduced by zfp compression.  The endpoints of a
   // segment are always exact.
@@ -191,7 +196,8 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
 
   // Called by |Append| after appending a point to this segment.  If
   // appropriate, performs downsampling and deletes some of the points of the
-  // segment.
+  // segment.  The amount of work is bounded if the downsampling parameters
+  // specify |max_fits_per_append|.
   absl::Status DownsampleIfNeeded();
 
   // Returns the Hermite interpolation for the left-open, right-closed
@@ -217,6 +223,11 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
       std::int64_t number_of_points_to_skip_at_end,
       std::vector<iterator> const& exact) const;
 
+  // Writes the entire segment without additional exact points, reusing
+  // |serialized_| if it is available.
+  void WriteEntireSegmentToMessage(
+      not_null<serialization::DiscreteTrajectorySegment*> message) const;
+
   std::optional<DownsamplingParameters> downsampling_parameters_;
 
   // The number of points at the end of the segment that are part of a "dense"
@@ -228,6 +239,15 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
   DiscreteTrajectorySegmentIterator<Frame> self_;
   Timeline timeline_;
 
+  // The serialization of the entire segment, computed lazily and reset by all
+  // the operations that change the segment.  This avoids recompressing the
+  // segments that don't change between saves, which are the bulk of the
+  // history of a vessel.  Shared between a segment and its copies, as it is
+  // immutable.  Note that, like the rest of the serialization, this is not
+  // safe if the same segment is serialized concurrently by multiple threads.
+  mutable std::shared_ptr<
+      serialization::DiscreteTrajectorySegment const> serialized_;
+
   template<typename F>
   friend class _discrete_trajectory::internal::DiscreteTrajectory;
   template<typename F>
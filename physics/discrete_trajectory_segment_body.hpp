@@ -4,7 +4,7 @@
 
 #include <algorithm>
 #include <iterator>
-#include <list>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -35,6 +35,7 @@ template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::SetDownsamplingUnconditionally(
     DownsamplingParameters const& downsampling_parameters) {
   downsampling_parameters_ = downsampling_parameters;
+  serialized_.reset();
 }
 
 template<typename Frame>
@@ -98,6 +99,7 @@ void DiscreteTrajectorySegment<Frame>::clear() {
   number_of_dense_points_ = 0;
   was_downsampled_ = false;
   timeline_.clear();
+  serialized_.reset();
 }
 
 template<typename Frame>
@@ -178,11 +180,13 @@ void DiscreteTrajectorySegment<Frame>::SetDownsampling(
   CHECK(!was_downsampled_);
   downsampling_parameters_ = downsampling_parameters;
   number_of_dense_points_ = timeline_.empty() ? 0 : 1;
+  serialized_.reset();
 }
 
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::ClearDownsampling() {
   downsampling_parameters_ = std::nullopt;
+  serialized_.reset();
 }
 
 template<typename Frame>
@@ -190,10 +194,20 @@ bool DiscreteTrajectorySegment<Frame>::was_downsampled() const {
   return was_downsampled_;
 }
 
+template<typename Frame>
+std::int64_t DiscreteTrajectorySegment<Frame>::MemoryFootprint() const {
+  return sizeof(*this) +
+         timeline_.size() * sizeof(typename Timeline::value_type);
+}
+
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::WriteToMessage(
     not_null<serialization::DiscreteTrajectorySegment*> message,
     std::vector<iterator> const& exact) const {
+  if (exact.empty()) {
+    WriteEntireSegmentToMessage(message);
+    return;
+  }
   WriteToMessage(message,
                  timeline_.begin(),
                  timeline_.end(),
@@ -219,6 +233,10 @@ void DiscreteTrajectorySegment<Frame>::WriteToMessage(
   std::int64_t const timeline_size =
       covers_entire_segment ? timeline_.size()
                             : std::distance(timeline_begin, timeline_end);
+  if (covers_entire_segment && exact.empty()) {
+    WriteEntireSegmentToMessage(message);
+    return;
+  }
   std::int64_t const number_of_points_to_skip_at_end =
       covers_entire_segment ? 0 : std::distance(timeline_end, timeline_.end());
   WriteToMessage(message,
@@ -314,11 +332,15 @@ DiscreteTrajectorySegment<Frame>::ReadFromMessage(
     segment.was_downsampled_ = message.was_downsampled();
   }
   if (message.has_downsampling_parameters()) {
+    auto const& downsampling_parameters = message.downsampling_parameters();
     segment.downsampling_parameters_ = DownsamplingParameters{
-        .max_dense_intervals =
-            message.downsampling_parameters().max_dense_intervals(),
-        .tolerance = Length::ReadFromMessage(
-            message.downsampling_parameters().tolerance())};
+        .max_dense_intervals = downsampling_parameters.max_dense_intervals(),
+        .tolerance =
+            Length::ReadFromMessage(downsampling_parameters.tolerance())};
+    if (downsampling_parameters.has_max_fits_per_append()) {
+      segment.downsampling_parameters_->max_fits_per_append =
+          downsampling_parameters.max_fits_per_append();
+    }
     CHECK(message.has_number_of_dense_points());
     segment.number_of_dense_points_ = message.number_of_dense_points();
   }
@@ -373,6 +395,7 @@ void DiscreteTrajectorySegment<Frame>::Prepend(
       << "Prepend out of order at " << t << ", first time is "
       << timeline_.cbegin()->time;
   timeline_.emplace_hint(timeline_.cbegin(), t, degrees_of_freedom);
+  serialized_.reset();
 }
 
 template<typename Frame>
@@ -390,6 +413,7 @@ void DiscreteTrajectorySegment<Frame>::ForgetAfter(
           0, number_of_dense_points_ - number_of_points_to_remove);
 
   timeline_.erase(begin, timeline_.cend());
+  serialized_.reset();
 }
 
 template<typename Frame>
@@ -408,6 +432,7 @@ void DiscreteTrajectorySegment<Frame>::ForgetBefore(
   number_of_dense_points_ -= number_of_dense_points_to_remove;
 
   timeline_.erase(timeline_.cbegin(), end);
+  serialized_.reset();
 }
 
 template<typename Frame>
@@ -420,6 +445,7 @@ absl::Status DiscreteTrajectorySegment<Frame>::Append(
                  << timeline_.crbegin()->time << "]";
     return absl::OkStatus();
   }
+  serialized_.reset();
   auto it = timeline_.emplace_hint(timeline_.cend(),
                                    t,
                                    degrees_of_freedom);
@@ -446,7 +472,9 @@ void DiscreteTrajectorySegment<Frame>::Merge(
     DiscreteTrajectorySegment<Frame> segment) {
   if (segment.timeline_.empty()) {
     return;
-  } else if (timeline_.empty()) {
+  }
+  serialized_.reset();
+  if (timeline_.empty()) {
     downsampling_parameters_ = segment.downsampling_parameters_;
     timeline_ = std::move(segment.timeline_);
     number_of_dense_points_ = segment.number_of_dense_points_;
@@ -502,6 +530,7 @@ void DiscreteTrajectorySegment<Frame>::SetStartOfDenseTimeline(
   auto const it = find(t);
   CHECK(it != end()) << "Cannot find time " << t << " in timeline";
   number_of_dense_points_ = std::distance(it, end());
+  serialized_.reset();
 }
 
 template<typename Frame>
@@ -510,10 +539,12 @@ void DiscreteTrajectorySegment<Frame>::SetForkPoint(value_type const& point) {
       timeline_.begin(), point.time, point.degrees_of_freedom);
   CHECK(it == timeline_.begin())
       << "Inconsistent fork point at time " << point.time;
+  serialized_.reset();
 }
 
 template<typename Frame>
 absl::Status DiscreteTrajectorySegment<Frame>::DownsampleIfNeeded() {
+  serialized_.reset();
   ++number_of_dense_points_;
   // Points, hence one more than intervals.
   if (number_of_dense_points_ >
@@ -528,7 +559,7 @@ absl::Status DiscreteTrajectorySegment<Frame>::DownsampleIfNeeded() {
       ++it;
     }
 
-    absl::StatusOr<std::list<typename ConstIterators::const_iterator>>
+    absl::StatusOr<std::vector<typename ConstIterators::const_iterator>>
         right_endpoints = FitHermiteSpline<Instant, Position<Frame>>(
             dense_iterators,
             [](auto&& it) -> auto&& { return it->time; },
@@ -538,7 +569,8 @@ absl::Status DiscreteTrajectorySegment<Frame>::DownsampleIfNeeded() {
             [](auto&& it) -> auto&& {
               return it->degrees_of_freedom.velocity();
             },
-            downsampling_parameters_->tolerance);
+            downsampling_parameters_->tolerance,
+            downsampling_parameters_->max_fits_per_append);
     if (!right_endpoints.ok()) {
       // Note that the actual appending took place; the propagated status only
       // reflects a lack of downsampling.
@@ -566,6 +598,9 @@ absl::Status DiscreteTrajectorySegment<Frame>::DownsampleIfNeeded() {
       auto const right_it = timeline_.find(right);
       left_it = timeline_.erase(left_it, right_it);
     }
+    // If the fit was interrupted because of |max_fits_per_append|, the points
+    // that were not processed remain dense, and are downsampled by the next
+    // |Append|s.
     number_of_dense_points_ = std::distance(left_it, timeline_.cend());
     was_downsampled_ = true;
   }
@@ -610,6 +645,23 @@ std::int64_t DiscreteTrajectorySegment<Frame>::timeline_size() const {
   return timeline_.size();
 }
 
+template<typename Frame>
+void DiscreteTrajectorySegment<Frame>::WriteEntireSegmentToMessage(
+    not_null<serialization::DiscreteTrajectorySegment*> const message) const {
+  if (serialized_ == nullptr) {
+    auto serialized =
+        std::make_shared<serialization::DiscreteTrajectorySegment>();
+    WriteToMessage(serialized.get(),
+                   timeline_.cbegin(),
+                   timeline_.cend(),
+                   timeline_.size(),
+                   /*number_of_points_to_skip_at_end=*/0,
+                   /*exact=*/{});
+    serialized_ = std::move(serialized);
+  }
+  message->CopyFrom(*serialized_);
+}
+
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::WriteToMessage(
     not_null<serialization::DiscreteTrajectorySegment*> message,
@@ -625,6 +677,10 @@ void DiscreteTrajectorySegment<Frame>::WriteToMessage(
         downsampling_parameters_->max_dense_intervals);
     downsampling_parameters_->tolerance.WriteToMessage(
         serialized_downsampling_parameters->mutable_tolerance());
+    if (downsampling_parameters_->max_fits_per_append.has_value()) {
+      serialized_downsampling_parameters->set_max_fits_per_append(
+          *downsampling_parameters_->max_fits_per_append);
+    }
     message->set_number_of_dense_points(std::min(
         timeline_size,
         std::max<std::int64_t>(
@@ -699,26 +755,28 @@ void DiscreteTrajectorySegment<Frame>::WriteToMessage(
   }
 
   // Times are exact.
-  ZfpCompressor time_compressor(0);
+  ZfpCompressor const time_compressor(0);
   // Lengths are approximated to the downsampling tolerance if downsampling is
   // enabled, otherwise they are exact.
   Length const length_tolerance = downsampling_parameters_.has_value()
                                       ? downsampling_parameters_->tolerance
                                       : Length();
-  ZfpCompressor length_compressor(length_tolerance / Metre);
+  ZfpCompressor const length_compressor(length_tolerance / Metre);
   // Speeds are approximated based on the length tolerance and the maximum
   // step in the timeline.
   ZfpCompressor const speed_compressor((length_tolerance / max_Δt) /
                                         (Metre / Second));
 
   ZfpCompressor::WriteVersion(message);
-  time_compressor.WriteToMessageMultidimensional<2>(t, zfp_timeline);
-  length_compressor.WriteToMessageMultidimensional<2>(qx, zfp_timeline);
-  length_compressor.WriteToMessageMultidimensional<2>(qy, zfp_timeline);
-  length_compressor.WriteToMessageMultidimensional<2>(qz, zfp_timeline);
-  speed_compressor.WriteToMessageMultidimensional<2>(px, zfp_timeline);
-  speed_compressor.WriteToMessageMultidimensional<2>(py, zfp_timeline);
-  speed_compressor.WriteToMessageMultidimensional<2>(pz, zfp_timeline);
+  ZfpCompressor::WriteToMessageMultidimensionalInParallel<2>(
+      {{&time_compressor, &t},
+       {&length_compressor, &qx},
+       {&length_compressor, &qy},
+       {&length_compressor, &qz},
+       {&speed_compressor, &px},
+       {&speed_compressor, &py},
+       {&speed_compressor, &pz}},
+      zfp_timeline);
 }
 
 }  // namespace internal
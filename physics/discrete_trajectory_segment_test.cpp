@@ -86,6 +86,17 @@ class DiscreteTrajectorySegmentTest : public ::testing::Test {
     segment.ForgetBefore(t);
   }
 
+  absl::Status Append(Instant const& t,
+                      DegreesOfFreedom<World> const& degrees_of_freedom,
+                      DiscreteTrajectorySegment<World>& segment) {
+    return segment.Append(t, degrees_of_freedom);
+  }
+
+  static std::int64_t NumberOfDensePoints(
+      DiscreteTrajectorySegment<World> const& segment) {
+    return segment.number_of_dense_points_;
+  }
+
   static DiscreteTrajectorySegmentIterator<World> MakeIterator(
       not_null<Segments*> const segments,
       typename Segments::iterator iterator) {
@@ -177,6 +188,13 @@ TEST_F(DiscreteTrajectorySegmentTest, EmptySize) {
   EXPECT_EQ(5, segment_->size());
 }
 
+TEST_F(DiscreteTrajectorySegmentTest, MemoryFootprint) {
+  std::int64_t const footprint = segment_->MemoryFootprint();
+  EXPECT_THAT(footprint, Lt(sizeof(*segment_) + 5 * 100));
+  ForgetBefore(t0_ + 5 * Second);
+  EXPECT_THAT(segment_->MemoryFootprint(), Lt(footprint));
+}
+
 TEST_F(DiscreteTrajectorySegmentTest, ForgetAfterExisting) {
   ForgetAfter(t0_ + 5 * Second);
   EXPECT_EQ(t0_ + 3 * Second, segment_->rbegin()->time);
@@ -274,6 +292,50 @@ TEST_F(DiscreteTrajectorySegmentTest, DownsamplingCircle) {
               IsNear(14_(1) * Milli(Metre / Second)));
 }
 
+TEST_F(DiscreteTrajectorySegmentTest, DownsamplingCircleAmortized) {
+  auto const circle_segments = MakeSegments(1);
+  auto const downsampled_circle_segments = MakeSegments(1);
+  auto& circle = *circle_segments->begin();
+  auto& downsampled_circle = *downsampled_circle_segments->begin();
+  downsampled_circle.SetDownsampling({.max_dense_intervals = 50,
+                                      .tolerance = 1 * Milli(Metre),
+                                      .max_fits_per_append = 1});
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Time const Δt = 10 * Milli(Second);
+  Instant const t1 = t0_;
+  Instant const t2 = t0_ + 10 * Second;
+  AppendTrajectoryTimeline(
+      NewCircularTrajectoryTimeline<World>(ω, r, Δt, t1, t2),
+      /*to=*/circle);
+
+  // Each append fits at most one cubic, so the dense span never grows much
+  // beyond |max_dense_intervals|.
+  for (auto const& [time, degrees_of_freedom] :
+       NewCircularTrajectoryTimeline<World>(ω, r, Δt, t1, t2)) {
+    EXPECT_OK(Append(time, degrees_of_freedom, downsampled_circle));
+    EXPECT_THAT(NumberOfDensePoints(downsampled_circle), Le(51));
+  }
+
+  EXPECT_THAT(circle.size(), Eq(1001));
+  EXPECT_THAT(downsampled_circle.size(), Eq(77));
+  EXPECT_TRUE(downsampled_circle.was_downsampled());
+  std::vector<Length> position_errors;
+  std::vector<Speed> velocity_errors;
+  for (auto const& [time, degrees_of_freedom] : circle) {
+    position_errors.push_back(
+        (downsampled_circle.EvaluatePosition(time) -
+         degrees_of_freedom.position()).Norm());
+    velocity_errors.push_back(
+        (downsampled_circle.EvaluateVelocity(time) -
+         degrees_of_freedom.velocity()).Norm());
+  }
+  EXPECT_THAT(*std::max_element(position_errors.begin(), position_errors.end()),
+              IsNear(0.98_(1) * Milli(Metre)));
+  EXPECT_THAT(*std::max_element(velocity_errors.begin(), velocity_errors.end()),
+              IsNear(14_(1) * Milli(Metre / Second)));
+}
+
 TEST_F(DiscreteTrajectorySegmentTest, DownsamplingStraightLine) {
   auto const line_segments = MakeSegments(1);
   auto const downsampled_line_segments = MakeSegments(1);
@@ -538,5 +600,30 @@ TEST_F(DiscreteTrajectorySegmentTest, SerializationRange) {
   EXPECT_THAT(message1, EqualsProto(message2));
 }
 
+TEST_F(DiscreteTrajectorySegmentTest, SerializationReuse) {
+  serialization::DiscreteTrajectorySegment message1;
+  segment_->WriteToMessage(&message1, /*exact=*/{});
+  EXPECT_EQ(5, message1.zfp().timeline_size());
+
+  // The second serialization reuses the first one.
+  serialization::DiscreteTrajectorySegment message2;
+  segment_->WriteToMessage(&message2,
+                           /*begin=*/segment_->begin(),
+                           /*end=*/segment_->end(),
+                           /*exact=*/{});
+  EXPECT_THAT(message2, EqualsProto(message1));
+
+  // Changing the segment invalidates the serialization.
+  EXPECT_OK(Append(t0_ + 13 * Second, unmoving_origin_, *segment_));
+  serialization::DiscreteTrajectorySegment message3;
+  segment_->WriteToMessage(&message3, /*exact=*/{});
+  EXPECT_EQ(6, message3.zfp().timeline_size());
+
+  ForgetAfter(t0_ + 13 * Second);
+  serialization::DiscreteTrajectorySegment message4;
+  segment_->WriteToMessage(&message4, /*exact=*/{});
+  EXPECT_THAT(message4, EqualsProto(message1));
+}
+
 }  // namespace physics
 }  // namespace principia
@@ -290,6 +290,28 @@ TEST_F(DiscreteTrajectoryTest, LowerBound) {
   }
 }
 
+TEST_F(DiscreteTrajectoryTest, LowerBoundWithHint) {
+  auto const trajectory = MakeTrajectory();
+  std::vector<DiscreteTrajectory<World>::iterator> const hints{
+      trajectory.begin(),
+      trajectory.find(t0_ + 5 * Second),
+      trajectory.find(t0_ + 7 * Second),
+      trajectory.end()};
+  for (auto const& hint : hints) {
+    for (Instant t = t0_ - 2 * Second; t < t0_ + 16 * Second;
+         t += 0.25 * Second) {
+      auto const expected = trajectory.lower_bound(t);
+      auto const actual = trajectory.lower_bound(hint, t);
+      if (expected == trajectory.end()) {
+        EXPECT_TRUE(actual == trajectory.end()) << t;
+      } else {
+        ASSERT_TRUE(actual != trajectory.end()) << t;
+        EXPECT_EQ(expected->time, actual->time) << t;
+      }
+    }
+  }
+}
+
 TEST_F(DiscreteTrajectoryTest, UpperBound) {
   auto const trajectory = MakeTrajectory();
   {
@@ -371,6 +393,30 @@ TEST_F(DiscreteTrajectoryTest, RSegments) {
       ElementsAre(t0_ + 14 * Second, t0_ + 9 * Second, t0_ + 4 * Second));
 }
 
+TEST_F(DiscreteTrajectoryTest, MakeCopy) {
+  auto trajectory = MakeTrajectory();
+  auto copy = trajectory.MakeCopy();
+  EXPECT_EQ(3, copy.segments().size());
+  EXPECT_EQ(trajectory.size(), copy.size());
+  for (auto it1 = trajectory.begin(), it2 = copy.begin();
+       it1 != trajectory.end();
+       ++it1, ++it2) {
+    EXPECT_EQ(it1->time, it2->time);
+    EXPECT_EQ(it1->degrees_of_freedom, it2->degrees_of_freedom);
+  }
+  EXPECT_EQ(trajectory.EvaluateDegreesOfFreedom(t0_ + 7.5 * Second),
+            copy.EvaluateDegreesOfFreedom(t0_ + 7.5 * Second));
+
+  // The copy is independent from the original.
+  copy.ForgetAfter(t0_ + 7 * Second);
+  EXPECT_OK(trajectory.Append(t0_ + 15 * Second,
+                              trajectory.back().degrees_of_freedom));
+  EXPECT_EQ(2, copy.segments().size());
+  EXPECT_EQ(t0_ + 6 * Second, copy.back().time);
+  EXPECT_EQ(t0_ + 15 * Second, trajectory.back().time);
+  EXPECT_EQ(3, trajectory.segments().size());
+}
+
 TEST_F(DiscreteTrajectoryTest, DetachSegments) {
   auto trajectory1 = MakeTrajectory();
   auto const first_segment = trajectory1.segments().begin();
@@ -703,6 +749,23 @@ TEST_F(DiscreteTrajectoryTest, TMinTMaxEvaluate) {
                                         0 * Metre / Second}), 0)));
 }
 
+TEST_F(DiscreteTrajectoryTest, EvaluateWithHint) {
+  auto const trajectory = MakeTrajectory();
+  // Forward, then backward, with the same hint.
+  auto hint = trajectory.begin();
+  for (Instant t = t0_; t <= t0_ + 14 * Second; t += 0.1 * Second) {
+    EXPECT_EQ(trajectory.EvaluateDegreesOfFreedom(t),
+              trajectory.EvaluateDegreesOfFreedom(t, hint)) << t;
+  }
+  for (Instant t = t0_ + 14 * Second; t >= t0_; t -= 0.3 * Second) {
+    EXPECT_EQ(trajectory.EvaluateDegreesOfFreedom(t),
+              trajectory.EvaluateDegreesOfFreedom(t, hint)) << t;
+  }
+  // Jumping far from the hint.
+  EXPECT_EQ(trajectory.EvaluateDegreesOfFreedom(t0_ + 13.5 * Second),
+            trajectory.EvaluateDegreesOfFreedom(t0_ + 13.5 * Second, hint));
+}
+
 TEST_F(DiscreteTrajectoryTest, SerializationRoundTrip) {
   auto const trajectory = MakeTrajectory();
   auto const trajectory_first_segment = trajectory.segments().begin();
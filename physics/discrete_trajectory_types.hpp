@@ -1,10 +1,13 @@
 #pragma once
 
 #include <list>
+#include <optional>
 
 #include "absl/container/btree_set.h"
 #include "base/macros.hpp"  // 🧙 For forward declarations.
+#include "base/pooling_allocator.hpp"
 #include "geometry/instant.hpp"
+#include "physics/chunked_timeline.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "quantities/quantities.hpp"
 
@@ -21,16 +24,22 @@ FORWARD_DECLARE(TEMPLATE(typename Frame) class,
 namespace _discrete_trajectory_types {
 namespace internal {
 
+using namespace principia::base::_pooling_allocator;
 using namespace principia::geometry::_instant;
+using namespace principia::physics::_chunked_timeline;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::quantities::_quantities;
 
 // |max_dense_intervals| is the maximal number of dense intervals before
 // downsampling occurs.  |tolerance| is the tolerance for downsampling with
-// |FitHermiteSpline|.
+// |FitHermiteSpline|.  If |max_fits_per_append| is set, downsampling is
+// amortized: each append fits at most that many Hermite cubics, and the rest of
+// the dense span is downsampled by the subsequent appends.  This bounds the
+// cost of an individual append.
 struct DownsamplingParameters {
   std::int64_t max_dense_intervals;
   Length tolerance;
+  std::optional<std::int64_t> max_fits_per_append = std::nullopt;
 };
 
 template<typename Frame>
@@ -58,8 +67,30 @@ struct Earlier {
 template<typename Frame>
 using Segments = std::list<DiscreteTrajectorySegment<Frame>>;
 
+// The timelines are pooled btree sets unless PRINCIPIA_CHUNKED_TIMELINE is set
+// or PRINCIPIA_POOLED_TIMELINE is explicitly cleared.  The Makefile builds the
+// other configurations with TIMELINE=chunked and TIMELINE=btree.
+#if !defined(PRINCIPIA_POOLED_TIMELINE)
+#define PRINCIPIA_POOLED_TIMELINE 1
+#endif
+
+// The chunked timeline stores the points contiguously, which makes iteration
+// and appending cheaper, at the cost of insertions in the middle.
+#if PRINCIPIA_CHUNKED_TIMELINE
+template<typename Frame>
+using Timeline = ChunkedTimeline<value_type<Frame>>;
+#elif PRINCIPIA_POOLED_TIMELINE
+// The nodes of the timelines are recycled through process-wide pools instead of
+// going back to the heap.  This reduces the contention for the heap when
+// predictions and flight plans are repeatedly rebuilt on separate threads.
+template<typename Frame>
+using Timeline = absl::btree_set<value_type<Frame>,
+                                 Earlier,
+                                 PoolingAllocator<value_type<Frame>>>;
+#else
 template<typename Frame>
 using Timeline = absl::btree_set<value_type<Frame>, Earlier>;
+#endif
 
 }  // namespace internal
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <functional>
 #include <limits>
 #include <map>
@@ -11,9 +12,11 @@
 #include "absl/synchronization/mutex.h"
 #include "base/not_null.hpp"
 #include "base/recurring_thread.hpp"
+#include "base/thread_pool.hpp"
 #include "base/traits.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
+#include "geometry/r3x3_matrix.hpp"
 #include "geometry/space.hpp"
 #include "google/protobuf/repeated_field.h"
 #include "integrators/integrators.hpp"
@@ -40,9 +43,11 @@ namespace internal {
 
 using namespace principia::base::_not_null;
 using namespace principia::base::_recurring_thread;
+using namespace principia::base::_thread_pool;
 using namespace principia::base::_traits;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
+using namespace principia::geometry::_r3x3_matrix;
 using namespace principia::geometry::_space;
 using namespace principia::integrators::_integrators;
 using namespace principia::integrators::_ordinary_differential_equations;
@@ -92,10 +97,24 @@ class Ephemeris {
       _integration_parameters::AdaptiveStepParameters<
           GeneralizedNewtonianMotionEquation>;
 
+  // The derivatives of the degrees of freedom of a massless body at some time
+  // with respect to its degrees of freedom at an initial time, in the
+  // coordinates of |Frame|.
+  struct StateTransitionMatrix {
+    R3x3Matrix<double> dq_dq₀;
+    R3x3Matrix<Time> dq_dv₀;
+    R3x3Matrix<Inverse<Time>> dv_dq₀;
+    R3x3Matrix<double> dv_dv₀;
+  };
+
   class AccuracyParameters final {
    public:
+    // If |minimize_polynomial_storage| is true, the trajectories of the bodies
+    // use the lowest degree that meets |fitting_tolerance| for each polynomial,
+    // which makes them smaller but slightly slower to compute.
     AccuracyParameters(Length const& fitting_tolerance,
-                       double geopotential_tolerance);
+                       double geopotential_tolerance,
+                       bool minimize_polynomial_storage = false);
 
     void WriteToMessage(
         not_null<serialization::Ephemeris::AccuracyParameters*> message) const;
@@ -105,6 +124,7 @@ class Ephemeris {
    private:
     Length fitting_tolerance_;
     double geopotential_tolerance_ = 0;
+    bool minimize_polynomial_storage_ = false;
     friend class Ephemeris<Frame>;
   };
 
@@ -138,6 +158,10 @@ class Ephemeris {
 
   virtual absl::Status last_severe_integration_status() const;
 
+  // Returns an estimate of the number of bytes used by the trajectories of the
+  // massive bodies and by the checkpoints.
+  virtual std::int64_t MemoryFootprint() const;
+
   // Prolongs the ephemeris up to at least |t|.  Returns an error iff the thread
   // is stopped.  After a successful call with the second parameter defaulted,
   // |t_max() >= t|.
@@ -146,6 +170,40 @@ class Ephemeris {
       std::int64_t max_ephemeris_steps = unlimited_max_ephemeris_steps)
       EXCLUDES(lock_);
 
+  // Prolongs the ephemeris up to at least |t| using the parareal algorithm of
+  // Lions, Maday and Turinici.  The interval is split into |number_of_slices|
+  // slices.  A cheap integration with |coarse_parameters| predicts the states
+  // at the boundaries of the slices, and these predictions are corrected by
+  // integrating each slice with the fixed-step parameters of the ephemeris, in
+  // parallel.  The iteration stops when the largest correction of a position
+  // at a boundary is below |tolerance|.  The result differs from that of
+  // |Prolong| by an amount commensurate with |tolerance|, and all the states of
+  // the fine integrations are kept in memory until the iteration completes.  If
+  // the iteration has not converged after |max_iterations|, a warning is
+  // logged and the ephemeris is prolonged sequentially as by |Prolong|.  The
+  // slices are integrated on at most one thread per core.  Returns an error iff
+  // the thread is stopped.  Experimental.
+  absl::Status ProlongWithParareal(Instant const& t,
+                                   FixedStepParameters const& coarse_parameters,
+                                   int number_of_slices,
+                                   Length const& tolerance,
+                                   int max_iterations) EXCLUDES(lock_);
+
+  // Computes the accelerations between the massive bodies on a pool of
+  // |pool_size| threads during the integration of the ephemeris.  The results
+  // are deterministic and independent of |pool_size|, but may differ in the
+  // last bits from those of the sequential computation.  This is only
+  // beneficial for systems with many bodies.  Must be called at most once,
+  // before any integration or reanimation takes place.
+  void EnableParallelMassiveBodiesIntegration(std::int64_t pool_size);
+
+  // Evaluates the positions of the massive bodies, when computing the
+  // accelerations on massless bodies, using a |BatchedPositionsEvaluator|.
+  // The results may differ in the last bits from those of the default
+  // evaluation.  This is only beneficial for systems with many bodies.  Must be
+  // called before any integration of massless bodies takes place.
+  void EnableBatchedPositionsEvaluation();
+
   // Asks the reanimator thread to asynchronously reconstruct the past so that
   // the |t_min()| of the ephemeris ultimately ends up at or before
   // |desired_t_min|.
@@ -155,6 +213,14 @@ class Ephemeris {
   // the |t_min()| of the ephemeris is at or before |desired_t_min|.
   void AwaitReanimation(Instant const& desired_t_min);
 
+  // Asks the prolongator thread to asynchronously prolong the ephemeris so that
+  // its |t_max()| ultimately ends up at or after |desired_t_max|.  This is the
+  // counterpart of |RequestReanimation| for the future: clients that call it
+  // sufficiently ahead of time find that |Prolong| has little or no work to do.
+  // The lock is released periodically during the prolongation so that readers
+  // are not blocked for long.
+  void RequestProlongation(Instant const& desired_t_max);
+
   // Creates an instance suitable for integrating the given |trajectories| with
   // their |intrinsic_accelerations| using a fixed-step integrator parameterized
   // by |parameters|.
@@ -177,22 +243,44 @@ class Ephemeris {
   // |trajectory| followed by a massless body in the gravitational potential
   // described by |*this|.  If |t > t_max()|, calls |Prolong(t)| beforehand.
   // Prolongs the ephemeris by at most |max_ephemeris_steps|.  Returns OK if and
-  // only if |*trajectory| was integrated until |t|.
+  // only if |*trajectory| was integrated until |t|.  If |statistics| is not
+  // null, the work performed by the integrator is added to it.
   virtual absl::Status FlowWithAdaptiveStep(
       not_null<DiscreteTrajectory<Frame>*> trajectory,
       IntrinsicAcceleration intrinsic_acceleration,
       Instant const& t,
       AdaptiveStepParameters const& parameters,
-      std::int64_t max_ephemeris_steps = unlimited_max_ephemeris_steps)
+      std::int64_t max_ephemeris_steps = unlimited_max_ephemeris_steps,
+      IntegrationStatistics<Time>* statistics = nullptr)
+      EXCLUDES(lock_);
+
+  // Same as above, but also integrates the variational equations of the motion
+  // of the massless body.  For each of the |times|, which must be increasing,
+  // appends to |state_transition_matrices| the state transition matrix from
+  // the last point of |*trajectory| at the time of the call to that time.
+  // Stops at the first of the |times| that is not covered by the integration.
+  // The |intrinsic_acceleration| doesn't depend on the state, so it doesn't
+  // contribute to the variational equations.  The step size is controlled by
+  // the error on |*trajectory| only.
+  absl::Status FlowWithAdaptiveStepAndStateTransitionMatrices(
+      not_null<DiscreteTrajectory<Frame>*> trajectory,
+      IntrinsicAcceleration intrinsic_acceleration,
+      Instant const& t,
+      AdaptiveStepParameters const& parameters,
+      std::vector<Instant> const& times,
+      not_null<std::vector<StateTransitionMatrix>*> state_transition_matrices,
+      std::int64_t max_ephemeris_steps = unlimited_max_ephemeris_steps,
+      IntegrationStatistics<Time>* statistics = nullptr)
       EXCLUDES(lock_);
 
-  // Same as above, but uses a generalized integrator.
+  // Same as the first function above, but uses a generalized integrator.
   virtual absl::Status FlowWithAdaptiveStep(
       not_null<DiscreteTrajectory<Frame>*> trajectory,
       GeneralizedIntrinsicAcceleration intrinsic_acceleration,
       Instant const& t,
       GeneralizedAdaptiveStepParameters const& parameters,
-      std::int64_t max_ephemeris_steps = unlimited_max_ephemeris_steps)
+      std::int64_t max_ephemeris_steps = unlimited_max_ephemeris_steps,
+      IntegrationStatistics<Time>* statistics = nullptr)
       EXCLUDES(lock_);
 
   // Integrates, until at most |t|, the trajectories followed by massless
@@ -210,6 +298,12 @@ class Ephemeris {
       not_null<MassiveBody const*> body,
       Instant const& t) const EXCLUDES(lock_);
 
+  // Returns the Jacobian of the acceleration field exerted on a massless body
+  // located at the given |position| at time |t|.
+  JacobianOfAcceleration<Frame> ComputeJacobianOnMasslessBody(
+      Position<Frame> const& position,
+      Instant const& t) const EXCLUDES(lock_);
+
   // Returns the gravitational jerk on a massless body with the given
   // |degrees_of_freedom| at time |t|.
   Vector<Jerk, Frame> ComputeGravitationalJerkOnMasslessBody(
@@ -222,6 +316,18 @@ class Ephemeris {
       not_null<MassiveBody const*> body,
       Instant const& t) const EXCLUDES(lock_);
 
+  // Computes the Jacobians of the acceleration field and the gravitational
+  // jerks on all the massive bodies at time |t|, in the order of |bodies()|.
+  // This is equivalent to calling |ComputeJacobianOnMassiveBody| and
+  // |ComputeGravitationalJerkOnMassiveBody| for each body, but each pair of
+  // bodies is only visited once.  The vectors are resized as needed; reusing
+  // them across calls avoids allocations.
+  void ComputeJacobiansAndJerksOnMassiveBodies(
+      Instant const& t,
+      not_null<std::vector<JacobianOfAcceleration<Frame>>*> jacobians,
+      not_null<std::vector<Vector<Jerk, Frame>>*> jerks) const
+      EXCLUDES(lock_);
+
   // Returns the gravitational acceleration on a massless body located at the
   // given |position| at time |t|.
   virtual Vector<Acceleration, Frame>
@@ -237,6 +343,19 @@ class Ephemeris {
       not_null<DiscreteTrajectory<Frame>*> trajectory,
       Instant const& t) const EXCLUDES(lock_);
 
+  // Computes the gravitational |accelerations| on massless bodies located at
+  // the given |positions| at time |t|.  This is cheaper than calling
+  // |ComputeGravitationalAccelerationOnMasslessBody| for each position because
+  // the positions of the massive bodies are only evaluated once for the entire
+  // batch.  The |accelerations| are resized as needed.  Returns an error iff
+  // one of the |positions| is inside one of the massive bodies, in which case
+  // the |accelerations| are still computed.
+  absl::Status ComputeGravitationalAccelerationsOnMasslessBodies(
+      std::vector<Position<Frame>> const& positions,
+      Instant const& t,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const
+      EXCLUDES(lock_);
+
   // Returns the gravitational acceleration on the massive |body| at time |t|.
   // |body| must be one of the bodies of this object.
   virtual Vector<Acceleration, Frame>
@@ -287,11 +406,40 @@ class Ephemeris {
                          Frame>::NewtonianMotionEquation> const& integrator);
 
  private:
+  // The right-hand side of the equation of the massive bodies.  It is a
+  // concrete functor rather than a |std::function| so that the integrators can
+  // inline it in their |Solve| loop.
+  struct MassiveBodiesGravitationalAccelerations {
+    absl::Status operator()(
+        Instant const& t,
+        std::vector<Position<Frame>> const& positions,
+        std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
+    Ephemeris const* ephemeris = nullptr;
+  };
+
+  // The equation used to integrate the |bodies_|.  Its |State| is that of
+  // |NewtonianMotionEquation|.
+  using MassiveBodiesNewtonianMotionEquation =
+      SpecialSecondOrderDifferentialEquation<
+          Position<Frame>,
+          MassiveBodiesGravitationalAccelerations>;
+
+  // Returns the integrator for the |bodies_| that uses the same method as
+  // |integrator|.
+  static FixedStepSizeIntegrator<MassiveBodiesNewtonianMotionEquation> const&
+  MassiveBodiesIntegrator(
+      FixedStepSizeIntegrator<NewtonianMotionEquation> const& integrator);
+
   // Checkpointing support.
   void WriteToCheckpointIfNeeded(Instant const& time) const
       SHARED_LOCKS_REQUIRED(lock_);
   Checkpointer<serialization::Ephemeris>::Writer MakeCheckpointerWriter();
   Checkpointer<serialization::Ephemeris>::Reader MakeCheckpointerReader();
+  // Returns a snapshotter that clones the integrator instance, so that its
+  // serialization may happen asynchronously, away from the prolongation.
+  Checkpointer<serialization::Ephemeris>::Snapshotter
+  MakeCheckpointerSnapshotter() const;
 
   // Called on a stoppable thread to reconstruct the past state of the ephemeris
   // and its trajectories starting in such a way that |t_min()| is at or before
@@ -299,13 +447,26 @@ class Ephemeris {
   // the reanimator where to stop.
   absl::Status Reanimate(Instant const desired_t_min) EXCLUDES(lock_);
 
+  // The trajectories reconstructed by reanimating one checkpoint, in the order
+  // of |trajectories_|.
+  using ReanimatedTrajectories =
+      std::vector<not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>>;
+
   // Reconstructs the past state of the ephemeris between |t_initial| and
-  // |t_final| using the given checkpoint |message|.
-  absl::Status ReanimateOneCheckpoint(
+  // |t_final| using the given checkpoint |message|.  The result is not stitched
+  // to the trajectories of this object, so this function may be called
+  // concurrently for distinct checkpoints.
+  absl::StatusOr<ReanimatedTrajectories> ReanimateOneCheckpoint(
       serialization::Ephemeris::Checkpoint const& message,
       Instant const& t_initial,
       Instant const& t_final) EXCLUDES(lock_);
 
+  // Called on a stoppable thread to prolong the ephemeris until |t_max()| is at
+  // or after |desired_t_max|, by chunks of at most
+  // |max_ephemeris_steps_per_prolongation| steps.
+  absl::Status ProlongAsynchronously(Instant const desired_t_max)
+      EXCLUDES(lock_);
+
   // Callbacks for the integrators.
   void AppendMassiveBodiesState(
       typename NewtonianMotionEquation::State const& state)
@@ -320,7 +481,8 @@ class Ephemeris {
 
   // Returns an equation suitable for the massive bodies contained in this
   // ephemeris.
-  NewtonianMotionEquation MakeMassiveBodiesNewtonianMotionEquation();
+  MassiveBodiesNewtonianMotionEquation
+  MakeMassiveBodiesNewtonianMotionEquation();
 
   Instant instance_time_locked() const REQUIRES_SHARED(lock_);
 
@@ -357,6 +519,21 @@ class Ephemeris {
       std::vector<DegreesOfFreedom<Frame>> const& degrees_of_freedom,
       std::vector<Vector<Jerk, Frame>>& jerks);
 
+  // Computes both the Jacobian of the acceleration field and the jerk between
+  // one body, |body1|, and the bodies |bodies2|, with the same conventions as
+  // the two functions above.  The tensor that they have in common is only
+  // computed once per pair.
+  template<typename MassiveBodyConstPtr>
+  static void ComputeJacobianAndJerkByMassiveBodyOnMassiveBodies(
+      MassiveBody const& body1,
+      std::size_t b1,
+      std::vector<not_null<MassiveBodyConstPtr>> const& bodies2,
+      std::size_t b2_begin,
+      std::size_t b2_end,
+      std::vector<DegreesOfFreedom<Frame>> const& degrees_of_freedom,
+      std::vector<JacobianOfAcceleration<Frame>>& jacobians,
+      std::vector<Vector<Jerk, Frame>>& jerks);
+
   // Computes the accelerations between one body, |body1| (with index |b1| in
   // the |positions| and |accelerations| arrays) and the bodies |bodies2| (with
   // indices [b2_begin, b2_end[ in the |bodies2|, |positions| and
@@ -379,19 +556,19 @@ class Ephemeris {
       std::vector<Geopotential<Frame>> const& geopotentials);
 
   // Computes the accelerations due to one body, |body1| (with index |b1| in the
-  // |bodies_| and |trajectories_| arrays) on massless bodies at the given
-  // |positions|.  The template parameter specifies what we know about the
-  // massive body, and therefore what forces apply.  Returns an integer for
-  // efficiency.
+  // |bodies_| and |trajectories_| arrays, and located at |position1|) on
+  // massless bodies at the given |positions|.  The template parameter specifies
+  // what we know about the massive body, and therefore what forces apply.
+  // Returns an integer for efficiency.
   template<bool body1_is_oblate>
   std::underlying_type_t<absl::StatusCode>
   ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
       Instant const& t,
       MassiveBody const& body1,
       std::size_t b1,
+      Position<Frame> const& position1,
       std::vector<Position<Frame>> const& positions,
-      std::vector<Vector<Acceleration, Frame>>& accelerations) const
-      REQUIRES_SHARED(lock_);
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
 
   // Computes the potential resulting from one body, |body1| (with index |b1| in
   // the |bodies_| and |trajectories_| arrays) at the given |positions|.  The
@@ -412,6 +589,39 @@ class Ephemeris {
       std::vector<Position<Frame>> const& positions,
       std::vector<Vector<Acceleration, Frame>>& accelerations) const;
 
+  // Adds to |accelerations| the accelerations between the bodies with indices
+  // in [b1_begin, b1_end[ in |bodies_| and the bodies that follow them.
+  void ComputeGravitationalAccelerationBetweenMassiveBodiesInRows(
+      Instant const& t,
+      std::size_t b1_begin,
+      std::size_t b1_end,
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
+  // Same as |ComputeGravitationalAccelerationBetweenAllMassiveBodies|, but
+  // distributes the blocks of |massive_bodies_row_blocks_| over
+  // |massive_bodies_thread_pool_|, and reduces the results in a fixed order.
+  void ComputeGravitationalAccelerationBetweenAllMassiveBodiesInParallel(
+      Instant const& t,
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
+  // Adds to |accelerations| the accelerations between the spherical bodies in
+  // |bodies_|, using a vectorized kernel operating on a structure of arrays.
+  // Must only be called if |CanUseVectorizedPointMassAccelerations()| is true.
+  void ComputeGravitationalAccelerationBetweenSphericalBodiesVectorized(
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
+  // Sets |positions| to the positions of the |bodies_| at time |t|, in the
+  // order of |bodies_|.  The most recent evaluations are cached, so that the
+  // massless integrations that happen to evaluate the same times share the cost
+  // of evaluating the |trajectories_|.
+  void EvaluateMassiveBodiesPositionsLocked(
+      Instant const& t,
+      std::vector<Position<Frame>>& positions) const REQUIRES_SHARED(lock_)
+      EXCLUDES(massive_bodies_positions_cache_lock_);
+
   // Computes the acceleration exerted by the massive bodies in |bodies_| on
   // massless bodies.  The massless bodies are at the given |positions|.
   // Returns an error iff a collision occurred, i.e., the massless body is
@@ -431,16 +641,20 @@ class Ephemeris {
       std::vector<SpecificEnergy>& potentials) const
       EXCLUDES(lock_);
 
-  // Flows the given ODE with an adaptive step integrator.
+  // Flows the given ODE with an adaptive step integrator.  The first of the
+  // |trajectories| is that of a massless body.  The others, if any, are
+  // integrated along with it but don't participate in the step size control.
   template<typename ODE>
   absl::Status FlowODEWithAdaptiveStep(
       typename ODE::RightHandSideComputation compute_acceleration,
-      not_null<DiscreteTrajectory<Frame>*> trajectory,
+      std::vector<not_null<DiscreteTrajectory<Frame>*>> const& trajectories,
       Instant const& t,
       _integration_parameters::AdaptiveStepParameters<ODE> const& parameters,
-      std::int64_t max_ephemeris_steps) EXCLUDES(lock_);
+      std::int64_t max_ephemeris_steps,
+      IntegrationStatistics<Time>* statistics) EXCLUDES(lock_);
 
-  // Computes an estimate of the ratio |tolerance / error|.
+  // Computes an estimate of the ratio |tolerance / error| for the first body of
+  // the |state|.
   static double ToleranceToErrorRatio(
       Length const& length_integration_tolerance,
       Speed const& speed_integration_tolerance,
@@ -487,6 +701,17 @@ class Ephemeris {
   RecurringThread<Instant> reanimator_;
   Clientele<Instant> reanimator_clientele_;
 
+  RecurringThread<Instant> prolongator_;
+
+  // Set by |EnableParallelMassiveBodiesIntegration|.  If the pool is not null,
+  // the block |i| of rows covers the indices [massive_bodies_row_blocks_[i],
+  // massive_bodies_row_blocks_[i + 1][ of |bodies_|.
+  std::unique_ptr<ThreadPool<void>> massive_bodies_thread_pool_;
+  std::vector<std::size_t> massive_bodies_row_blocks_;
+
+  // Set by |EnableBatchedPositionsEvaluation|.
+  bool batched_positions_evaluation_ = false;
+
   // The fields above this line are fixed at construction and therefore not
   // protected.  Note that |ContinuousTrajectory| is thread-safe.  |lock_| is
   // also used to protect sections where the trajectories are not mutually
@@ -496,9 +721,28 @@ class Ephemeris {
   // Parameter passed to the last call to |RequestReanimation|, if any.
   std::optional<Instant> last_desired_t_min_ GUARDED_BY(lock_);
 
-  std::unique_ptr<typename Integrator<NewtonianMotionEquation>::Instance>
+  std::unique_ptr<
+      typename Integrator<MassiveBodiesNewtonianMotionEquation>::Instance>
       instance_ GUARDED_BY(lock_);
 
+  // A small cache of the positions of the |bodies_| at the times most recently
+  // passed to |EvaluateMassiveBodiesPositionsLocked|, used in a round-robin
+  // manner.  An entry is empty if its |positions| are empty.  The positions at
+  // a given time never change once the trajectories cover that time, so the
+  // cache never needs to be invalidated.
+  struct MassiveBodiesPositions {
+    Instant time;
+    std::vector<Position<Frame>> positions;
+  };
+  static constexpr int massive_bodies_positions_cache_size = 8;
+  mutable absl::Mutex massive_bodies_positions_cache_lock_;
+  mutable std::array<MassiveBodiesPositions,
+                     massive_bodies_positions_cache_size>
+      massive_bodies_positions_cache_
+          GUARDED_BY(massive_bodies_positions_cache_lock_);
+  mutable int massive_bodies_positions_cache_next_
+      GUARDED_BY(massive_bodies_positions_cache_lock_) = 0;
+
   absl::Status last_severe_integration_status_ GUARDED_BY(lock_);
 };
 
@@ -3,10 +3,13 @@
 #include "physics/ephemeris.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <future>
 #include <limits>
 #include <memory>
 #include <optional>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -15,6 +18,7 @@
 #include "astronomy/epoch.hpp"
 #include "base/jthread.hpp"
 #include "base/map_util.hpp"
+#include "base/tracing.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/r3_element.hpp"
 #include "geometry/sign.hpp"
@@ -24,7 +28,9 @@
 #include "numerics/double_precision.hpp"
 #include "numerics/hermite3.hpp"
 #include "numerics/root_finders.hpp"
+#include "physics/batched_positions_evaluator.hpp"
 #include "physics/oblate_body.hpp"
+#include "physics/point_mass_accelerations.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/si.hpp"
 
@@ -39,6 +45,7 @@ using ::std::placeholders::_3;
 using namespace principia::astronomy::_epoch;
 using namespace principia::base::_jthread;
 using namespace principia::base::_map_util;
+using namespace principia::base::_tracing;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_sign;
@@ -48,7 +55,9 @@ using namespace principia::integrators::_methods;
 using namespace principia::numerics::_double_precision;
 using namespace principia::numerics::_hermite3;
 using namespace principia::numerics::_root_finders;
+using namespace principia::physics::_batched_positions_evaluator;
 using namespace principia::physics::_oblate_body;
+using namespace principia::physics::_point_mass_accelerations;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_si;
 
@@ -57,9 +66,26 @@ using namespace std::chrono_literals;
 constexpr Length pre_ἐρατοσθένης_default_ephemeris_fitting_tolerance =
     1 * Milli(Metre);
 constexpr Time max_time_between_checkpoints = 180 * Day;
+// The checkpoints that have not been reanimated are thinned when an ephemeris
+// is deserialized: those less than 8 years older than the restored checkpoint
+// are retained, the older ones become exponentially sparser.  Reanimation then
+// integrates over longer intervals.
+constexpr Checkpointer<serialization::Ephemeris>::RetentionPolicy
+    checkpoint_retention_policy{
+        .dense_span = 16 * max_time_between_checkpoints,
+        .spacing = max_time_between_checkpoints};
 // Below this threshold detect a collision to prevent the integrator and the
 // downsampling from going postal.
 constexpr double min_radius_tolerance = 0.99;
+// Below this number of spherical bodies the cost of staging the positions in a
+// structure of arrays exceeds the benefit of vectorization.
+constexpr int min_spherical_bodies_for_vectorization = 8;
+// The maximum number of blocks of rows into which the computation of the
+// accelerations between the massive bodies is split when it is parallelized.
+constexpr std::int64_t max_massive_bodies_row_blocks = 16;
+// The number of steps that the prolongator performs before releasing the lock
+// to give the readers a chance to proceed.
+constexpr std::int64_t max_ephemeris_steps_per_prolongation = 100;
 
 inline absl::Status CollisionDetected() {
   return absl::OutOfRangeError("Collision detected");
@@ -68,9 +94,11 @@ inline absl::Status CollisionDetected() {
 template<typename Frame>
 Ephemeris<Frame>::AccuracyParameters::AccuracyParameters(
     Length const& fitting_tolerance,
-    double const geopotential_tolerance)
+    double const geopotential_tolerance,
+    bool const minimize_polynomial_storage)
     : fitting_tolerance_(fitting_tolerance),
-      geopotential_tolerance_(geopotential_tolerance) {}
+      geopotential_tolerance_(geopotential_tolerance),
+      minimize_polynomial_storage_(minimize_polynomial_storage) {}
 
 template<typename Frame>
 void Ephemeris<Frame>::AccuracyParameters::WriteToMessage(
@@ -78,6 +106,9 @@ void Ephemeris<Frame>::AccuracyParameters::WriteToMessage(
     const {
   fitting_tolerance_.WriteToMessage(message->mutable_fitting_tolerance());
   message->set_geopotential_tolerance(geopotential_tolerance_);
+  if (minimize_polynomial_storage_) {
+    message->set_minimize_polynomial_storage(true);
+  }
 }
 
 template<typename Frame>
@@ -86,7 +117,8 @@ Ephemeris<Frame>::AccuracyParameters::ReadFromMessage(
     serialization::Ephemeris::AccuracyParameters const& message) {
   return AccuracyParameters(
       Length::ReadFromMessage(message.fitting_tolerance()),
-      message.geopotential_tolerance());
+      message.geopotential_tolerance(),
+      message.minimize_polynomial_storage());
 }
 
 template<typename Frame>
@@ -107,14 +139,20 @@ Ephemeris<Frame>::Ephemeris(
             return Reanimate(desired_t_min);
           },
           20ms),  // 50 Hz.
-      reanimator_clientele_(/*default_value=*/InfiniteFuture) {
+      reanimator_clientele_(/*default_value=*/InfiniteFuture),
+      prolongator_(
+          [this](Instant const& desired_t_max) {
+            return ProlongAsynchronously(desired_t_max);
+          },
+          20ms) {  // 50 Hz.
   CHECK(!bodies.empty());
   CHECK_EQ(bodies.size(), initial_state.size());
 
-  InitialValueProblem<NewtonianMotionEquation> problem;
+  InitialValueProblem<MassiveBodiesNewtonianMotionEquation> problem;
   problem.equation = MakeMassiveBodiesNewtonianMotionEquation();
 
-  typename NewtonianMotionEquation::State& state = problem.initial_state;
+  typename MassiveBodiesNewtonianMotionEquation::State& state =
+      problem.initial_state;
   state.time = DoublePrecision<Instant>(initial_time);
 
   for (int i = 0; i < bodies.size(); ++i) {
@@ -128,7 +166,8 @@ Ephemeris<Frame>::Ephemeris(
         body.get(),
         std::make_unique<ContinuousTrajectory<Frame>>(
             fixed_step_parameters_.step(),
-            accuracy_parameters_.fitting_tolerance_));
+            accuracy_parameters_.fitting_tolerance_,
+            accuracy_parameters_.minimize_polynomial_storage_));
     CHECK(inserted);
     ContinuousTrajectory<Frame>* const trajectory = it->second.get();
     CHECK_OK(trajectory->Append(initial_time, degrees_of_freedom));
@@ -157,15 +196,17 @@ Ephemeris<Frame>::Ephemeris(
   }
 
   absl::ReaderMutexLock l(&lock_);  // For locking checks.
-  instance_ = fixed_step_parameters_.integrator().NewInstance(
-      problem,
-      /*append_state=*/std::bind(
-          &Ephemeris::AppendMassiveBodiesState, this, _1),
-      fixed_step_parameters_.step());
+  instance_ =
+      MassiveBodiesIntegrator(fixed_step_parameters_.integrator()).NewInstance(
+          problem,
+          /*append_state=*/std::bind(
+              &Ephemeris::AppendMassiveBodiesState, this, _1),
+          fixed_step_parameters_.step());
 }
 
 template<typename Frame>
 Ephemeris<Frame>::~Ephemeris() {
+  prolongator_.Stop();
   reanimator_.Stop();
 }
 
@@ -216,6 +257,52 @@ absl::Status Ephemeris<Frame>::last_severe_integration_status() const {
   return last_severe_integration_status_;
 }
 
+template<typename Frame>
+std::int64_t Ephemeris<Frame>::MemoryFootprint() const {
+  std::int64_t footprint = sizeof(*this) + checkpointer_->MemoryFootprint();
+  for (auto const trajectory : trajectories_) {
+    footprint += trajectory->MemoryFootprint();
+  }
+  return footprint;
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::EnableParallelMassiveBodiesIntegration(
+    std::int64_t const pool_size) {
+  CHECK_LT(0, pool_size);
+  CHECK(massive_bodies_thread_pool_ == nullptr);
+
+  // Split the rows of the triangular loop over the pairs of bodies into blocks
+  // having roughly the same number of pairs.  The blocks only depend on the
+  // number of bodies, not on |pool_size|, so that the order of the summations,
+  // and therefore the result, is the same for all pool sizes.
+  std::int64_t const number_of_bodies =
+      number_of_oblate_bodies_ + number_of_spherical_bodies_;
+  std::int64_t const number_of_pairs =
+      number_of_bodies * (number_of_bodies - 1) / 2;
+  std::int64_t const number_of_blocks =
+      std::min(max_massive_bodies_row_blocks, number_of_bodies);
+  massive_bodies_row_blocks_.push_back(0);
+  std::int64_t pairs_so_far = 0;
+  for (std::int64_t b1 = 0; b1 < number_of_bodies; ++b1) {
+    pairs_so_far += number_of_bodies - 1 - b1;
+    std::int64_t const blocks_so_far = massive_bodies_row_blocks_.size();
+    if (b1 + 1 < number_of_bodies && blocks_so_far < number_of_blocks &&
+        pairs_so_far * number_of_blocks >= blocks_so_far * number_of_pairs) {
+      massive_bodies_row_blocks_.push_back(b1 + 1);
+    }
+  }
+  massive_bodies_row_blocks_.push_back(number_of_bodies);
+
+  massive_bodies_thread_pool_ =
+      std::make_unique<ThreadPool<void>>(pool_size);
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::EnableBatchedPositionsEvaluation() {
+  batched_positions_evaluation_ = true;
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::RequestReanimation(Instant const& desired_t_min) {
   reanimator_.Start();
@@ -263,9 +350,16 @@ void Ephemeris<Frame>::AwaitReanimation(Instant const& desired_t_min) {
   lock_.Await(absl::Condition(&desired_t_min_reached));
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::RequestProlongation(Instant const& desired_t_max) {
+  prolongator_.Start();
+  prolongator_.Put(desired_t_max);
+}
+
 template<typename Frame>
 absl::Status Ephemeris<Frame>::Prolong(Instant const& t,
                                        std::int64_t const max_ephemeris_steps) {
+  TracingScope tracing_scope("Ephemeris::Prolong");
   absl::MutexLock l(&lock_);
   Instant const instance_time = this->instance_time_locked();
 
@@ -297,6 +391,209 @@ absl::Status Ephemeris<Frame>::Prolong(Instant const& t,
   return absl::OkStatus();
 }
 
+template<typename Frame>
+absl::Status Ephemeris<Frame>::ProlongWithParareal(
+    Instant const& t,
+    FixedStepParameters const& coarse_parameters,
+    int const number_of_slices,
+    Length const& tolerance,
+    int const max_iterations) {
+  using State = typename NewtonianMotionEquation::State;
+  CHECK_LT(0, number_of_slices);
+  CHECK_LT(0, max_iterations);
+
+  absl::MutexLock l(&lock_);
+  Time const& step = fixed_step_parameters_.step();
+  State const initial_state = instance_->state();
+  std::int64_t const number_of_steps =
+      std::max<std::int64_t>(
+          0, std::ceil((t - initial_state.time.value) / step));
+
+  if (number_of_steps > 0) {
+    std::int64_t const steps_per_slice =
+        (number_of_steps + number_of_slices - 1) / number_of_slices;
+    int const slices =
+        (number_of_steps + steps_per_slice - 1) / steps_per_slice;
+
+    // The boundaries of the slices are on the grid of the fine integrator.
+    // They are computed in the same way as the times of the integrator, so
+    // that the equal spacing of the points of the trajectories is preserved.
+    std::vector<DoublePrecision<Instant>> boundaries;
+    boundaries.reserve(slices + 1);
+    {
+      DoublePrecision<Instant> time = initial_state.time;
+      for (std::int64_t s = 0; s < number_of_steps; ++s) {
+        if (s % steps_per_slice == 0) {
+          boundaries.push_back(time);
+        }
+        time.Increment(step);
+      }
+      boundaries.push_back(time);
+    }
+    CHECK_EQ(slices + 1, boundaries.size());
+
+    auto const& coarse_integrator =
+        MassiveBodiesIntegrator(coarse_parameters.integrator());
+    auto const& fine_integrator =
+        MassiveBodiesIntegrator(fixed_step_parameters_.integrator());
+
+    // Integrates the slice |n| from |start| with the coarse integrator and
+    // returns the state at the end of the slice.  The coarse step is adjusted
+    // to divide the slice.
+    auto const coarse = [this,
+                         &boundaries,
+                         &coarse_integrator,
+                         &coarse_parameters](int const n, State const& start) {
+      Time const slice_length = boundaries[n + 1].value - boundaries[n].value;
+      Time const coarse_step =
+          slice_length / std::ceil(slice_length / coarse_parameters.step());
+      InitialValueProblem<MassiveBodiesNewtonianMotionEquation> problem;
+      problem.equation = MakeMassiveBodiesNewtonianMotionEquation();
+      problem.initial_state = start;
+      auto const instance = coarse_integrator.NewInstance(
+          problem,
+          /*append_state=*/[](State const&) {},
+          coarse_step);
+      instance->Solve(boundaries[n + 1].value + coarse_step / 2).IgnoreError();
+      State end = instance->state();
+      end.time = boundaries[n + 1];
+      return end;
+    };
+
+    // Integrates the slice |n| from |start| with the fine integrator and
+    // stores all the states in |states|.
+    auto const fine = [this, &boundaries, &fine_integrator, &step](
+                          int const n,
+                          State const& start,
+                          std::vector<State>& states) {
+      states.clear();
+      InitialValueProblem<MassiveBodiesNewtonianMotionEquation> problem;
+      problem.equation = MakeMassiveBodiesNewtonianMotionEquation();
+      problem.initial_state = start;
+      auto const instance = fine_integrator.NewInstance(
+          problem,
+          /*append_state=*/[&states](State const& state) {
+            states.push_back(state);
+          },
+          step);
+      instance->Solve(boundaries[n + 1].value + step / 2).IgnoreError();
+    };
+
+    // |starts[n]| is the current approximation of the state at the beginning
+    // of the slice |n|, and |coarse_ends[n]| is the result of the coarse
+    // integration of the slice |n| from |starts[n]|.
+    std::vector<State> starts(slices + 1);
+    std::vector<State> coarse_ends(slices);
+    starts[0] = initial_state;
+    for (int n = 0; n < slices; ++n) {
+      coarse_ends[n] = coarse(n, starts[n]);
+      starts[n + 1] = coarse_ends[n];
+      RETURN_IF_STOPPED;
+    }
+
+    // The slices are integrated on at most one thread per core: with more
+    // slices than cores the threads would just compete for the same cores.
+    std::vector<std::vector<State>> fine_states(slices);
+    ThreadPool<void> pool(/*pool_size=*/std::min<int>(
+        slices, std::max(1u, std::thread::hardware_concurrency())));
+    bool converged = false;
+    for (int k = 0; k < max_iterations; ++k) {
+      // After |k| iterations the starting states of the first |k| slices are
+      // those of the sequential integration, so there is no need to integrate
+      // these slices again.
+      std::vector<std::future<void>> futures;
+      for (int n = k; n < slices; ++n) {
+        futures.push_back(pool.Add([n,
+                                    &fine,
+                                    &start = std::as_const(starts[n]),
+                                    &states = fine_states[n]]() {
+          fine(n, start, states);
+        }));
+      }
+      for (auto& future : futures) {
+        future.wait();
+      }
+      RETURN_IF_STOPPED;
+
+      // The sequential correction.  For the slice |k| the starting state has
+      // not changed, so the result of the fine integration is exact.
+      Length largest_correction;
+      for (int n = k; n < slices; ++n) {
+        State const& fine_end = fine_states[n].back();
+        State coarse_end = n == k ? coarse_ends[n] : coarse(n, starts[n]);
+        State corrected = fine_end;
+        for (int i = 0; i < corrected.positions.size(); ++i) {
+          corrected.positions[i].Increment(coarse_end.positions[i].value -
+                                           coarse_ends[n].positions[i].value);
+          corrected.velocities[i].Increment(
+              coarse_end.velocities[i].value -
+              coarse_ends[n].velocities[i].value);
+          largest_correction = std::max(
+              largest_correction,
+              (corrected.positions[i].value - starts[n + 1].positions[i].value)
+                  .Norm());
+        }
+        corrected.time = boundaries[n + 1];
+        starts[n + 1] = std::move(corrected);
+        coarse_ends[n] = std::move(coarse_end);
+      }
+      VLOG(1) << "Parareal iteration " << k << ": largest correction "
+              << largest_correction;
+      // After as many iterations as there are slices, all the starting states
+      // are those of the sequential integration.
+      if (largest_correction <= tolerance || k + 1 == slices) {
+        converged = true;
+        break;
+      }
+      RETURN_IF_STOPPED;
+    }
+
+    if (converged) {
+      // Extend the trajectories with the results of the last fine
+      // integrations.  Note that they start from the states of the previous
+      // iteration, which differ from the corrected ones by at most
+      // |tolerance|.
+      DoublePrecision<Instant> time = initial_state.time;
+      for (auto& states : fine_states) {
+        for (auto& state : states) {
+          time.Increment(step);
+          state.time = time;
+          AppendMassiveBodiesState(state);
+        }
+      }
+      CHECK_EQ(boundaries.back(), time);
+
+      // Continue the integration from the last state.
+      InitialValueProblem<MassiveBodiesNewtonianMotionEquation> problem;
+      problem.equation = MakeMassiveBodiesNewtonianMotionEquation();
+      problem.initial_state = fine_states.back().back();
+      instance_ = fine_integrator.NewInstance(
+          problem,
+          /*append_state=*/std::bind(
+              &Ephemeris::AppendMassiveBodiesState, this, _1),
+          step);
+    } else {
+      // The results of the fine integrations are not accurate enough, drop
+      // them and let |instance_| do the sequential integration below.
+      LOG(WARNING) << "Parareal iteration did not converge to " << tolerance
+                   << " after " << max_iterations
+                   << " iterations, falling back to a sequential integration";
+    }
+  }
+
+  // As in |Prolong|, the last series may not be fully determined yet.  This
+  // integrates sequentially if the parareal iteration did not converge.
+  Instant const instance_time = this->instance_time_locked();
+  Instant t_final = t <= instance_time ? instance_time + step : t;
+  while (t_max_locked() < t) {
+    instance_->Solve(t_final).IgnoreError();
+    RETURN_IF_STOPPED;
+    t_final += step;
+  }
+
+  return absl::OkStatus();
+}
+
 template<typename Frame>
 not_null<std::unique_ptr<typename Integrator<
     typename Ephemeris<Frame>::NewtonianMotionEquation>::Instance>>
@@ -372,7 +669,8 @@ absl::Status Ephemeris<Frame>::FlowWithAdaptiveStep(
     IntrinsicAcceleration intrinsic_acceleration,
     Instant const& t,
     AdaptiveStepParameters const& parameters,
-    std::int64_t const max_ephemeris_steps) {
+    std::int64_t const max_ephemeris_steps,
+    IntegrationStatistics<Time>* const statistics) {
   auto compute_acceleration = [this, &intrinsic_acceleration](
       Instant const& t,
       std::vector<Position<Frame>> const& positions,
@@ -391,10 +689,116 @@ absl::Status Ephemeris<Frame>::FlowWithAdaptiveStep(
 
   return FlowODEWithAdaptiveStep<NewtonianMotionEquation>(
              std::move(compute_acceleration),
-             trajectory,
+             {trajectory},
              t,
              parameters,
-             max_ephemeris_steps);
+             max_ephemeris_steps,
+             statistics);
+}
+
+template<typename Frame>
+absl::Status Ephemeris<Frame>::FlowWithAdaptiveStepAndStateTransitionMatrices(
+    not_null<DiscreteTrajectory<Frame>*> const trajectory,
+    IntrinsicAcceleration intrinsic_acceleration,
+    Instant const& t,
+    AdaptiveStepParameters const& parameters,
+    std::vector<Instant> const& times,
+    not_null<std::vector<StateTransitionMatrix>*> const
+        state_transition_matrices,
+    std::int64_t const max_ephemeris_steps,
+    IntegrationStatistics<Time>* const statistics) {
+  // The variational equations are integrated as 6 additional bodies whose
+  // displacements from the origin (resp. velocities) are the columns of the
+  // state transition matrix, scaled by the following factors.  The first 3
+  // correspond to an initial position perturbation, the last 3 to an initial
+  // velocity perturbation.  Since the variational equations are linear, the
+  // scaling factors don't affect the results.
+  static constexpr Length δq₀ = 1 * Metre;
+  static constexpr Speed δv₀ = 1 * Metre / Second;
+
+  Instant const t₀ = trajectory->back().time;
+  std::array<DiscreteTrajectory<Frame>, 6> variations;
+  std::vector<not_null<DiscreteTrajectory<Frame>*>> trajectories = {
+      trajectory};
+  for (int i = 0; i < 6; ++i) {
+    R3Element<double> unit;
+    unit[i % 3] = 1;
+    Vector<double, Frame> const e(unit);
+    CHECK_OK(variations[i].Append(
+        t₀,
+        i < 3 ? DegreesOfFreedom<Frame>(Frame::origin + e * δq₀,
+                                        Velocity<Frame>())
+              : DegreesOfFreedom<Frame>(Frame::origin, e * δv₀)));
+    trajectories.push_back(&variations[i]);
+  }
+
+  // Only the first body is attracted by the massive bodies.
+  auto compute_acceleration =
+      [this,
+       &intrinsic_acceleration,
+       massless_positions = std::vector<Position<Frame>>(1),
+       massless_accelerations =
+           std::vector<Vector<Acceleration, Frame>>(1)](
+          Instant const& t,
+          std::vector<Position<Frame>> const& positions,
+          std::vector<Vector<Acceleration, Frame>>& accelerations) mutable {
+    massless_positions[0] = positions[0];
+    auto const error =
+        ComputeGravitationalAccelerationByAllMassiveBodiesOnMasslessBodies(
+            t,
+            massless_positions,
+            massless_accelerations);
+    accelerations[0] = massless_accelerations[0];
+    if (intrinsic_acceleration != nullptr) {
+      accelerations[0] += intrinsic_acceleration(t);
+    }
+    JacobianOfAcceleration<Frame> const jacobian =
+        ComputeJacobianOnMasslessBody(positions[0], t);
+    for (int i = 1; i < positions.size(); ++i) {
+      accelerations[i] = jacobian * (positions[i] - Frame::origin);
+    }
+    return error == absl::StatusCode::kOk ? absl::OkStatus() :
+                    CollisionDetected();
+  };
+
+  auto const status = FlowODEWithAdaptiveStep<NewtonianMotionEquation>(
+      std::move(compute_acceleration),
+      trajectories,
+      t,
+      parameters,
+      max_ephemeris_steps,
+      statistics);
+
+  Instant const t_final = trajectory->back().time;
+  for (Instant const& time : times) {
+    if (time < t₀ || time > t_final) {
+      break;
+    }
+    std::vector<DegreesOfFreedom<Frame>> columns;
+    columns.reserve(variations.size());
+    for (auto const& variation : variations) {
+      columns.push_back(variation.EvaluateDegreesOfFreedom(time));
+    }
+    // The matrix whose columns are given by |f| applied to |columns[offset]|,
+    // |columns[offset + 1]|, and |columns[offset + 2]|.
+    auto const matrix = [&columns](int const offset, auto const f) {
+      return R3x3Matrix(f(columns[offset]).coordinates(),
+                        f(columns[offset + 1]).coordinates(),
+                        f(columns[offset + 2]).coordinates()).Transpose();
+    };
+    auto const δq = [](DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+      return degrees_of_freedom.position() - Frame::origin;
+    };
+    auto const δv = [](DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+      return degrees_of_freedom.velocity();
+    };
+    state_transition_matrices->push_back(
+        {.dq_dq₀ = matrix(0, δq) / δq₀,
+         .dq_dv₀ = matrix(3, δq) / δv₀,
+         .dv_dq₀ = matrix(0, δv) / δq₀,
+         .dv_dv₀ = matrix(3, δv) / δv₀});
+  }
+  return status;
 }
 
 template<typename Frame>
@@ -403,7 +807,8 @@ absl::Status Ephemeris<Frame>::FlowWithAdaptiveStep(
     GeneralizedIntrinsicAcceleration intrinsic_acceleration,
     Instant const& t,
     GeneralizedAdaptiveStepParameters const& parameters,
-    std::int64_t max_ephemeris_steps) {
+    std::int64_t max_ephemeris_steps,
+    IntegrationStatistics<Time>* const statistics) {
   auto compute_acceleration =
       [this, &intrinsic_acceleration](
           Instant const& t,
@@ -425,10 +830,11 @@ absl::Status Ephemeris<Frame>::FlowWithAdaptiveStep(
 
   return FlowODEWithAdaptiveStep<GeneralizedNewtonianMotionEquation>(
              std::move(compute_acceleration),
-             trajectory,
+             {trajectory},
              t,
              parameters,
-             max_ephemeris_steps);
+             max_ephemeris_steps,
+             statistics);
 }
 
 template<typename Frame>
@@ -488,6 +894,39 @@ JacobianOfAcceleration<Frame> Ephemeris<Frame>::ComputeJacobianOnMassiveBody(
   return jacobians[b1];
 }
 
+template<typename Frame>
+JacobianOfAcceleration<Frame> Ephemeris<Frame>::ComputeJacobianOnMasslessBody(
+    Position<Frame> const& position,
+    Instant const& t) const {
+  // NOTE(phl): This doesn't take high-order geopotential into account.
+  JacobianOfAcceleration<Frame> jacobian;
+
+  // Locking ensures that we see a consistent state of all the trajectories.
+  absl::ReaderMutexLock l(&lock_);
+  for (std::size_t b2 = 0;
+       b2 < number_of_oblate_bodies_ + number_of_spherical_bodies_;
+       ++b2) {
+    MassiveBody const& body2 = *bodies_[b2];
+    GravitationalParameter const& μ2 = body2.gravitational_parameter();
+
+    // A vector from the center of |b2| to the massless body.
+    Displacement<Frame> const Δq =
+        position - trajectories_[b2]->EvaluatePositionLocked(t);
+
+    Square<Length> const Δq² = Δq.Norm²();
+    Length const Δq_norm = Sqrt(Δq²);
+    Cube<Length> const Δq_norm³ = Δq² * Δq_norm;
+    auto const Δq_norm⁵ = Δq_norm³ * Δq²;
+
+    auto const form = -InnerProductForm<Frame, Vector>() / Δq_norm³ +
+                      3 * SymmetricSquare(Δq) / Δq_norm⁵;
+
+    jacobian += μ2 * form;
+  }
+
+  return jacobian;
+}
+
 template<typename Frame>
 Vector<Jerk, Frame> Ephemeris<Frame>::ComputeGravitationalJerkOnMasslessBody(
     DegreesOfFreedom<Frame> const& degrees_of_freedom,
@@ -570,6 +1009,40 @@ ComputeGravitationalJerkOnMassiveBody(not_null<MassiveBody const*> body,
   return jerks[b1];
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::ComputeJacobiansAndJerksOnMassiveBodies(
+    Instant const& t,
+    not_null<std::vector<JacobianOfAcceleration<Frame>>*> const jacobians,
+    not_null<std::vector<Vector<Jerk, Frame>>*> const jerks) const {
+  // NOTE(phl): This doesn't take high-order geopotential into account.
+
+  // Reused across calls to avoid allocations.
+  thread_local std::vector<DegreesOfFreedom<Frame>> degrees_of_freedom;
+
+  // Evaluate the |degrees_of_freedom|.  Locking is necessary to be able to call
+  // the "locked" method of each trajectory.
+  {
+    absl::ReaderMutexLock l(&lock_);
+    degrees_of_freedom.clear();
+    degrees_of_freedom.reserve(bodies_.size());
+    for (auto const& trajectory : trajectories_) {
+      degrees_of_freedom.push_back(
+          trajectory->EvaluateDegreesOfFreedomLocked(t));
+    }
+  }
+
+  jacobians->assign(bodies_.size(), JacobianOfAcceleration<Frame>());
+  jerks->assign(bodies_.size(), Vector<Jerk, Frame>());
+  for (std::size_t b1 = 0; b1 < bodies_.size(); ++b1) {
+    ComputeJacobianAndJerkByMassiveBodyOnMassiveBodies(
+        /*body1=*/*bodies_[b1], b1,
+        /*bodies2=*/bodies_,
+        /*b2_begin=*/b1 + 1,
+        /*b2_end=*/bodies_.size(),
+        degrees_of_freedom, *jacobians, *jerks);
+  }
+}
+
 template<typename Frame>
 Vector<Acceleration, Frame>
 Ephemeris<Frame>::ComputeGravitationalAccelerationOnMasslessBody(
@@ -595,6 +1068,21 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationOnMasslessBody(
              degrees_of_freedom.position(), t);
 }
 
+template<typename Frame>
+absl::Status Ephemeris<Frame>::ComputeGravitationalAccelerationsOnMasslessBodies(
+    std::vector<Position<Frame>> const& positions,
+    Instant const& t,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  accelerations.resize(positions.size());
+  auto const error =
+      ComputeGravitationalAccelerationByAllMassiveBodiesOnMasslessBodies(
+          t,
+          positions,
+          accelerations);
+  return error == absl::StatusCode::kOk ? absl::OkStatus() :
+                  CollisionDetected();
+}
+
 template<typename Frame>
 Vector<Acceleration, Frame>
 Ephemeris<Frame>::ComputeGravitationalAccelerationOnMassiveBody(
@@ -894,6 +1382,21 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
               << ephemeris->oldest_reanimated_checkpoint_;
     CHECK_OK(ephemeris->checkpointer_->ReadFromCheckpointAt(
         ephemeris->oldest_reanimated_checkpoint_));
+
+    // This must happen before the reanimator starts reading the checkpoints.
+    // The trajectories have checkpoints at the same times as the ephemeris.
+    auto const thinnable_checkpoints =
+        ephemeris->checkpointer_->ThinnableCheckpoints(
+            ephemeris->oldest_reanimated_checkpoint_,
+            checkpoint_retention_policy);
+    if (!thinnable_checkpoints.empty()) {
+      LOG(INFO) << "Thinning " << thinnable_checkpoints.size()
+                << " checkpoints";
+      ephemeris->checkpointer_->RemoveCheckpoints(thinnable_checkpoints);
+      for (auto const trajectory : ephemeris->trajectories_) {
+        trajectory->RemoveCheckpoints(thinnable_checkpoints);
+      }
+    }
   }
 
   // The ephemeris will need to be prolonged and reanimated as needed when
@@ -912,14 +1415,17 @@ Ephemeris<Frame>::Ephemeris(
           make_not_null_unique<Checkpointer<serialization::Ephemeris>>(
               /*reader=*/nullptr, /*writer=*/nullptr)),
       reanimator_(/*action=*/nullptr, 0ms),
-      reanimator_clientele_(InfiniteFuture) {}
+      reanimator_clientele_(InfiniteFuture),
+      prolongator_(/*action=*/nullptr, 0ms) {}
 
 template<typename Frame>
 void Ephemeris<Frame>::WriteToCheckpointIfNeeded(Instant const& time) const {
   if constexpr (is_serializable_v<Frame>) {
     lock_.AssertReaderHeld();
     if (checkpointer_->WriteToCheckpointIfNeeded(
-            time, max_time_between_checkpoints)) {
+            time,
+            max_time_between_checkpoints,
+            MakeCheckpointerSnapshotter())) {
       for (auto const& trajectory : trajectories_) {
         trajectory->WriteToCheckpoint(time);
       }
@@ -941,14 +1447,36 @@ Ephemeris<Frame>::MakeCheckpointerWriter() {
   }
 }
 
+template<typename Frame>
+Checkpointer<serialization::Ephemeris>::Snapshotter
+Ephemeris<Frame>::MakeCheckpointerSnapshotter() const {
+  if constexpr (is_serializable_v<Frame>) {
+    return [this]() -> Checkpointer<serialization::Ephemeris>::Writer {
+      lock_.AssertReaderHeld();
+      std::shared_ptr<typename Integrator<
+          MassiveBodiesNewtonianMotionEquation>::Instance const> const
+          instance = std::unique_ptr<typename Integrator<
+              MassiveBodiesNewtonianMotionEquation>::Instance>(
+                  instance_->Clone());
+      return [instance](
+                 not_null<serialization::Ephemeris::Checkpoint*> const
+                     message) {
+        instance->WriteToMessage(message->mutable_instance());
+      };
+    };
+  } else {
+    return nullptr;
+  }
+}
+
 template<typename Frame>
 Checkpointer<serialization::Ephemeris>::Reader
 Ephemeris<Frame>::MakeCheckpointerReader() {
   if constexpr (is_serializable_v<Frame>) {
     return [this](serialization::Ephemeris::Checkpoint const& message) {
       absl::MutexLock l(&lock_);
-      instance_ = FixedStepSizeIntegrator<NewtonianMotionEquation>::Instance::
-          ReadFromMessage(
+      instance_ = FixedStepSizeIntegrator<MassiveBodiesNewtonianMotionEquation>::
+          Instance::ReadFromMessage(
               message.instance(),
               MakeMassiveBodiesNewtonianMotionEquation(),
               /*append_state=*/
@@ -977,34 +1505,95 @@ absl::Status Ephemeris<Frame>::Reanimate(Instant const desired_t_min) {
         oldest_checkpoint_to_reanimate, oldest_reanimated_checkpoint_);
   }
 
-  // This loop integrates all the segments defined by the checkpoints, going
-  // backwards in time.  The last checkpoint is not restored, it just serves as
-  // a limit.
-  std::optional<Instant> following_checkpoint;
-  for (auto it = checkpoints.crbegin(); it != checkpoints.crend(); ++it) {
-    Instant const& checkpoint = *it;
-    if (following_checkpoint.has_value()) {
-      RETURN_IF_ERROR(checkpointer_->ReadFromCheckpointAt(
-          checkpoint,
-          [this,
-           t_final = following_checkpoint.value(),
-           t_initial = checkpoint](
-              serialization::Ephemeris::Checkpoint const& message) {
-            if constexpr (is_serializable_v<Frame>) {
-              return ReanimateOneCheckpoint(message, t_initial, t_final);
-            } else {
-              return absl::UnknownError(
-                  "No reanimation for non-serializable frames");
-            }
-          }));
+  // The intervals defined by the checkpoints are independent, so they are
+  // integrated in parallel.  |times| goes backwards in time, and the last
+  // checkpoint is not restored, it just serves as a limit.
+  std::vector<Instant> const times(checkpoints.crbegin(), checkpoints.crend());
+  if (times.size() < 2) {
+    return absl::OkStatus();
+  }
+  std::int64_t const number_of_intervals = times.size() - 1;
+  std::vector<absl::StatusOr<ReanimatedTrajectories>> reanimated_trajectories(
+      number_of_intervals);
+  ThreadPool<void>& pool = ReanimationThreadPool();
+  std::vector<std::unique_ptr<StoppableTask>> tasks;
+  std::vector<std::future<void>> futures;
+  for (std::int64_t i = 0; i < number_of_intervals; ++i) {
+    auto const& task = tasks.emplace_back(std::make_unique<StoppableTask>());
+    futures.push_back(pool.Add([this,
+                                &task = *task,
+                                &result = reanimated_trajectories[i],
+                                t_initial = times[i + 1],
+                                t_final = times[i]]() {
+      task.Run([&]() {
+        absl::Status const status = checkpointer_->ReadFromCheckpointAt(
+            t_initial,
+            [&](serialization::Ephemeris::Checkpoint const& message) {
+              if constexpr (is_serializable_v<Frame>) {
+                result = ReanimateOneCheckpoint(message, t_initial, t_final);
+                return result.status();
+              } else {
+                return absl::UnknownError(
+                    "No reanimation for non-serializable frames");
+              }
+            });
+        if (!status.ok()) {
+          result = status;
+        }
+      });
+    }));
+  }
+
+  // Stitch the intervals to the trajectories of this ephemeris as they become
+  // available, and record that we will not reanimate them again.  We must not
+  // stitch past an error, we would run into a gap.  Stop requests are
+  // propagated to the tasks.
+  absl::Status status;
+  bool stopped = false;
+  for (std::int64_t i = 0; i < number_of_intervals; ++i) {
+    while (futures[i].wait_for(20ms) != std::future_status::ready) {
+      if (!stopped &&
+          this_stoppable_thread::get_stop_token().stop_requested()) {
+        stopped = true;
+        for (auto const& task : tasks) {
+          task->request_stop();
+        }
+      }
+    }
+    if (!status.ok()) {
+      continue;
     }
-    following_checkpoint = checkpoint;
+    if (!reanimated_trajectories[i].ok()) {
+      status = reanimated_trajectories[i].status();
+      continue;
+    }
+    auto& trajectories = reanimated_trajectories[i].value();
+    absl::MutexLock l(&lock_);
+    for (int j = 0; j < trajectories_.size(); ++j) {
+      trajectories_[j]->Prepend(std::move(*trajectories[j]));
+    }
+    oldest_reanimated_checkpoint_ = times[i + 1];
+  }
+  return status;
+}
+
+template<typename Frame>
+absl::Status Ephemeris<Frame>::ProlongAsynchronously(
+    Instant const desired_t_max) {
+  // Each call to |Prolong| holds the lock for a bounded number of steps, so
+  // clients evaluating the trajectories are not starved.  Note that a
+  // synchronous call to |Prolong| may be interleaved between the chunks, which
+  // is harmless.
+  while (t_max() < desired_t_max) {
+    RETURN_IF_ERROR(Prolong(desired_t_max,
+                            max_ephemeris_steps_per_prolongation));
   }
   return absl::OkStatus();
 }
 
 template<typename Frame>
-absl::Status Ephemeris<Frame>::ReanimateOneCheckpoint(
+absl::StatusOr<typename Ephemeris<Frame>::ReanimatedTrajectories>
+Ephemeris<Frame>::ReanimateOneCheckpoint(
     serialization::Ephemeris::Checkpoint const& message,
     Instant const& t_initial,
     Instant const& t_final) {
@@ -1012,12 +1601,12 @@ absl::Status Ephemeris<Frame>::ReanimateOneCheckpoint(
 
   // Create new trajectories and initialize them from the checkpoint at
   // t_initial.
-  std::vector<not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>>
-      trajectories;
+  ReanimatedTrajectories trajectories;
   for (int i = 0; i < trajectories_.size(); ++i) {
     trajectories.emplace_back(std::make_unique<ContinuousTrajectory<Frame>>(
         fixed_step_parameters_.step(),
-        accuracy_parameters_.fitting_tolerance_));
+        accuracy_parameters_.fitting_tolerance_,
+        accuracy_parameters_.minimize_polynomial_storage_));
 
     // This statement is subtle: it restores the checkpoints of the trajectories
     // of this ephemeris, but thanks to the newly-created reader, it restores
@@ -1032,10 +1621,11 @@ absl::Status Ephemeris<Frame>::ReanimateOneCheckpoint(
           typename NewtonianMotionEquation::State const& state) {
         AppendMassiveBodiesStateToTrajectories(state, trajectories);
       };
-  auto const instance = FixedStepSizeIntegrator<NewtonianMotionEquation>::
-      Instance::ReadFromMessage(message.instance(),
-                                MakeMassiveBodiesNewtonianMotionEquation(),
-                                append_massive_bodies_state);
+  auto const instance =
+      FixedStepSizeIntegrator<MassiveBodiesNewtonianMotionEquation>::Instance::
+          ReadFromMessage(message.instance(),
+                          MakeMassiveBodiesNewtonianMotionEquation(),
+                          append_massive_bodies_state);
 
   // Do the integration.  After this step the t_max() of the trajectories may
   // be before t_final because there may be last_points_ that haven't been put
@@ -1043,17 +1633,7 @@ absl::Status Ephemeris<Frame>::ReanimateOneCheckpoint(
   // trying to stitch the trajectories.
   RETURN_IF_ERROR(instance->Solve(t_final));
 
-  // Stitch the local trajectories to the ones in this ephemeris and record that
-  // we will not reanimate this checkpoint again.
-  {
-    absl::MutexLock l(&lock_);
-    for (int i = 0; i < trajectories_.size(); ++i) {
-      trajectories_[i]->Prepend(std::move(*trajectories[i]));
-    }
-    oldest_reanimated_checkpoint_ = t_initial;
-  }
-
-  return absl::OkStatus();
+  return std::move(trajectories);
 }
 
 template<typename Frame>
@@ -1119,21 +1699,25 @@ void Ephemeris<Frame>::AppendMasslessBodiesStateToTrajectories(
 }
 
 template<typename Frame>
-typename Ephemeris<Frame>::NewtonianMotionEquation
+typename Ephemeris<Frame>::MassiveBodiesNewtonianMotionEquation
 Ephemeris<Frame>::MakeMassiveBodiesNewtonianMotionEquation() {
-  NewtonianMotionEquation equation;
-  equation.compute_acceleration =
-      [this](Instant const& t,
-             std::vector<Position<Frame>> const& positions,
-             std::vector<Vector<Acceleration, Frame>>& accelerations) {
-        return ComputeGravitationalAccelerationBetweenAllMassiveBodies(
-                   t,
-                   positions,
-                   accelerations);
-      };
+  MassiveBodiesNewtonianMotionEquation equation;
+  equation.compute_acceleration.ephemeris = this;
   return equation;
 }
 
+template<typename Frame>
+FixedStepSizeIntegrator<
+    typename Ephemeris<Frame>::MassiveBodiesNewtonianMotionEquation> const&
+Ephemeris<Frame>::MassiveBodiesIntegrator(
+    FixedStepSizeIntegrator<NewtonianMotionEquation> const& integrator) {
+  // The integrators are singletons identified by their kind.
+  serialization::FixedStepSizeIntegrator message;
+  integrator.WriteToMessage(&message);
+  return FixedStepSizeIntegrator<
+      MassiveBodiesNewtonianMotionEquation>::ReadFromMessage(message);
+}
+
 template<typename Frame>
 Instant Ephemeris<Frame>::instance_time_locked() const {
   return instance_->time().value;
@@ -1234,6 +1818,51 @@ void Ephemeris<Frame>::ComputeGravitationalJerkByMassiveBodyOnMassiveBodies(
   }
 }
 
+template<typename Frame>
+template<typename MassiveBodyConstPtr>
+void Ephemeris<Frame>::ComputeJacobianAndJerkByMassiveBodyOnMassiveBodies(
+    MassiveBody const& body1,
+    std::size_t b1,
+    std::vector<not_null<MassiveBodyConstPtr>> const& bodies2,
+    std::size_t b2_begin,
+    std::size_t b2_end,
+    std::vector<DegreesOfFreedom<Frame>> const& degrees_of_freedom,
+    std::vector<JacobianOfAcceleration<Frame>>& jacobians,
+    std::vector<Vector<Jerk, Frame>>& jerks) {
+  DegreesOfFreedom<Frame> const& degrees_of_freedom_of_b1 =
+      degrees_of_freedom[b1];
+  JacobianOfAcceleration<Frame>& jacobian_on_b1 = jacobians[b1];
+  Vector<Jerk, Frame>& jerk_on_b1 = jerks[b1];
+  GravitationalParameter const& μ1 = body1.gravitational_parameter();
+  for (std::size_t b2 = b2_begin; b2 < b2_end; ++b2) {
+    JacobianOfAcceleration<Frame>& jacobian_on_b2 = jacobians[b2];
+    Vector<Jerk, Frame>& jerk_on_b2 = jerks[b2];
+    MassiveBody const& body2 = *bodies2[b2];
+    GravitationalParameter const& μ2 = body2.gravitational_parameter();
+
+    // A vector from the center of |b2| to the center of |b1|.
+    RelativeDegreesOfFreedom<Frame> const Δqv =
+        degrees_of_freedom_of_b1 - degrees_of_freedom[b2];
+    Displacement<Frame> const Δq = Δqv.displacement();
+    Velocity<Frame> const Δv = Δqv.velocity();
+
+    Square<Length> const Δq² = Δq.Norm²();
+    Length const Δq_norm = Sqrt(Δq²);
+    Cube<Length> const Δq_norm³ = Δq² * Δq_norm;
+    auto const Δq_norm⁵ = Δq_norm³ * Δq²;
+
+    auto const form = -InnerProductForm<Frame, Vector>() / Δq_norm³ +
+                      3 * SymmetricSquare(Δq) / Δq_norm⁵;
+    auto const vector = form * Δv;
+
+    // The Jacobian is independent from the sign of Δq, the jerk is not.
+    jacobian_on_b2 += μ1 * form;
+    jacobian_on_b1 += μ2 * form;
+    jerk_on_b2 -= μ1 * vector;
+    jerk_on_b1 += μ2 * vector;
+  }
+}
+
 template<typename Frame>
 template<bool body1_is_oblate,
          bool body2_is_oblate,
@@ -1311,18 +1940,32 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
     Instant const& t,
     MassiveBody const& body1,
     std::size_t const b1,
+    Position<Frame> const& position1,
     std::vector<Position<Frame>> const& positions,
     std::vector<Vector<Acceleration, Frame>>& accelerations) const {
-  lock_.AssertReaderHeld();
   GravitationalParameter const& μ1 = body1.gravitational_parameter();
-  auto const& trajectory1 = *trajectories_[b1];
-  Position<Frame> const position1 = trajectory1.EvaluatePositionLocked(t);
   Length const body1_collision_radius =
       min_radius_tolerance * body1.min_radius();
   // TODO(phl): Use std::to_underlying when we have C++23.
   auto error = static_cast<std::underlying_type_t<absl::StatusCode>>(
       absl::StatusCode::kOk);
 
+  // For an oblate body, the data needed by the geopotential are collected in
+  // these buffers, so that it may be evaluated for all the bodies at once.
+  thread_local std::vector<Displacement<Frame>> minus_Δqs;
+  thread_local std::vector<Length> Δq_norms;
+  thread_local std::vector<Square<Length>> Δq²s;
+  thread_local std::vector<Exponentiation<Length, -3>> one_over_Δq³s;
+  thread_local std::vector<Vector<Quotient<Acceleration,
+                                           GravitationalParameter>, Frame>>
+      spherical_harmonics_effects;
+  if constexpr (body1_is_oblate) {
+    minus_Δqs.clear();
+    Δq_norms.clear();
+    Δq²s.clear();
+    one_over_Δq³s.clear();
+  }
+
   for (std::size_t b2 = 0; b2 < positions.size(); ++b2) {
     // A vector from the center of |b2| to the center of |b1|.
     Displacement<Frame> const Δq = position1 - positions[b2];
@@ -1340,17 +1983,24 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
     auto const μ1_over_Δq³ = μ1 * one_over_Δq³;
     accelerations[b2] += Δq * μ1_over_Δq³;
 
-    if (body1_is_oblate) {
-      Vector<Quotient<Acceleration,
-                      GravitationalParameter>, Frame> const
-          spherical_harmonics_effect =
-              geopotentials_[b1].GeneralSphericalHarmonicsAcceleration(
-                  t,
-                  -Δq,
-                  Δq_norm,
-                  Δq²,
-                  one_over_Δq³);
-      accelerations[b2] += μ1 * spherical_harmonics_effect;
+    if constexpr (body1_is_oblate) {
+      minus_Δqs.push_back(-Δq);
+      Δq_norms.push_back(Δq_norm);
+      Δq²s.push_back(Δq²);
+      one_over_Δq³s.push_back(one_over_Δq³);
+    }
+  }
+
+  if constexpr (body1_is_oblate) {
+    geopotentials_[b1].GeneralSphericalHarmonicsAccelerations(
+        t,
+        minus_Δqs,
+        Δq_norms,
+        Δq²s,
+        one_over_Δq³s,
+        spherical_harmonics_effects);
+    for (std::size_t b2 = 0; b2 < positions.size(); ++b2) {
+      accelerations[b2] += μ1 * spherical_harmonics_effects[b2];
     }
   }
   return error;
@@ -1395,6 +2045,16 @@ void Ephemeris<Frame>::ComputeGravitationalPotentialsOfMassiveBody(
   }
 }
 
+template<typename Frame>
+absl::Status
+Ephemeris<Frame>::MassiveBodiesGravitationalAccelerations::operator()(
+    Instant const& t,
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  return ephemeris->ComputeGravitationalAccelerationBetweenAllMassiveBodies(
+      t, positions, accelerations);
+}
+
 template<typename Frame>
 absl::Status
 Ephemeris<Frame>::ComputeGravitationalAccelerationBetweenAllMassiveBodies(
@@ -1404,9 +2064,49 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationBetweenAllMassiveBodies(
   // Do not RETURN_IF_STOPPED here, it's too hard to undo the state changes made
   // half way through the loop of the integrator.
 
+  if (massive_bodies_thread_pool_ != nullptr) {
+    ComputeGravitationalAccelerationBetweenAllMassiveBodiesInParallel(
+        t, positions, accelerations);
+    return absl::OkStatus();
+  }
+
   accelerations.assign(accelerations.size(), Vector<Acceleration, Frame>());
 
-  for (std::size_t b1 = 0; b1 < number_of_oblate_bodies_; ++b1) {
+  std::size_t const number_of_bodies =
+      number_of_oblate_bodies_ + number_of_spherical_bodies_;
+  if (CanUseVectorizedPointMassAccelerations() &&
+      number_of_spherical_bodies_ >= min_spherical_bodies_for_vectorization) {
+    ComputeGravitationalAccelerationBetweenMassiveBodiesInRows(
+        t,
+        /*b1_begin=*/0,
+        /*b1_end=*/number_of_oblate_bodies_,
+        positions, accelerations);
+    ComputeGravitationalAccelerationBetweenSphericalBodiesVectorized(
+        positions, accelerations);
+  } else {
+    ComputeGravitationalAccelerationBetweenMassiveBodiesInRows(
+        t,
+        /*b1_begin=*/0,
+        /*b1_end=*/number_of_bodies,
+        positions, accelerations);
+  }
+
+  return absl::OkStatus();
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::
+ComputeGravitationalAccelerationBetweenMassiveBodiesInRows(
+    Instant const& t,
+    std::size_t const b1_begin,
+    std::size_t const b1_end,
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  std::size_t const number_of_bodies =
+      number_of_oblate_bodies_ + number_of_spherical_bodies_;
+  for (std::size_t b1 = b1_begin;
+       b1 < std::min<std::size_t>(b1_end, number_of_oblate_bodies_);
+       ++b1) {
     MassiveBody const& body1 = *bodies_[b1];
     ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies<
         /*body1_is_oblate=*/true,
@@ -1424,12 +2124,12 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationBetweenAllMassiveBodies(
         body1, b1,
         /*bodies2=*/bodies_,
         /*b2_begin=*/number_of_oblate_bodies_,
-        /*b2_end=*/number_of_oblate_bodies_ + number_of_spherical_bodies_,
+        /*b2_end=*/number_of_bodies,
         positions, accelerations, geopotentials_);
   }
-  for (std::size_t b1 = number_of_oblate_bodies_;
-       b1 < number_of_oblate_bodies_ +
-            number_of_spherical_bodies_;
+  for (std::size_t b1 =
+           std::max<std::size_t>(b1_begin, number_of_oblate_bodies_);
+       b1 < b1_end;
        ++b1) {
     MassiveBody const& body1 = *bodies_[b1];
     ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies<
@@ -1439,11 +2139,102 @@ Ephemeris<Frame>::ComputeGravitationalAccelerationBetweenAllMassiveBodies(
         body1, b1,
         /*bodies2=*/bodies_,
         /*b2_begin=*/b1 + 1,
-        /*b2_end=*/number_of_oblate_bodies_ + number_of_spherical_bodies_,
+        /*b2_end=*/number_of_bodies,
         positions, accelerations, geopotentials_);
   }
+}
 
-  return absl::OkStatus();
+template<typename Frame>
+void Ephemeris<Frame>::
+ComputeGravitationalAccelerationBetweenAllMassiveBodiesInParallel(
+    Instant const& t,
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  // This function may be called concurrently by the integrator of |Prolong|
+  // and by the reanimator, so the accumulators must be per calling thread.
+  // Note that the tasks executing on the pool must not name these variables,
+  // as they would get the instances of their own thread.
+  thread_local std::vector<std::vector<Vector<Acceleration, Frame>>>
+      block_accelerations;
+  thread_local std::vector<std::future<void>> futures;
+
+  std::size_t const number_of_blocks = massive_bodies_row_blocks_.size() - 1;
+  block_accelerations.resize(number_of_blocks);
+  futures.clear();
+
+  auto compute_block = [this, &t, &positions](
+                           std::size_t const block,
+                           std::vector<Vector<Acceleration, Frame>>&
+                               accelerations_of_block) {
+    accelerations_of_block.assign(positions.size(),
+                                  Vector<Acceleration, Frame>());
+    ComputeGravitationalAccelerationBetweenMassiveBodiesInRows(
+        t,
+        /*b1_begin=*/massive_bodies_row_blocks_[block],
+        /*b1_end=*/massive_bodies_row_blocks_[block + 1],
+        positions, accelerations_of_block);
+  };
+
+  for (std::size_t block = 1; block < number_of_blocks; ++block) {
+    futures.push_back(massive_bodies_thread_pool_->Add(
+        [block,
+         &accelerations_of_block = block_accelerations[block],
+         &compute_block]() {
+          compute_block(block, accelerations_of_block);
+        }));
+  }
+  // The calling thread does its share of the work instead of idling.
+  compute_block(/*block=*/0, block_accelerations[0]);
+  for (auto& future : futures) {
+    future.wait();
+  }
+
+  // Reduce the accumulators in a fixed order, independent of the scheduling
+  // of the tasks, so that the result is reproducible.
+  accelerations = block_accelerations[0];
+  for (std::size_t block = 1; block < number_of_blocks; ++block) {
+    auto const& accelerations_of_block = block_accelerations[block];
+    for (std::size_t b = 0; b < accelerations.size(); ++b) {
+      accelerations[b] += accelerations_of_block[b];
+    }
+  }
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::
+ComputeGravitationalAccelerationBetweenSphericalBodiesVectorized(
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  // This function may be called concurrently by the integrator of |Prolong|
+  // and by the reanimator, hence the buffer per thread.  The conversion to and
+  // from a structure of arrays is linear in the number of bodies while the
+  // kernel is quadratic, so the integrator state need not be kept in that form.
+  thread_local PointMasses spherical_bodies;
+  spherical_bodies.resize(number_of_spherical_bodies_);
+
+  for (int i = 0; i < number_of_spherical_bodies_; ++i) {
+    std::size_t const b = number_of_oblate_bodies_ + i;
+    auto const q = (positions[b] - Frame::origin).coordinates();
+    auto const a = accelerations[b].coordinates();
+    spherical_bodies.x[i] = q.x / Metre;
+    spherical_bodies.y[i] = q.y / Metre;
+    spherical_bodies.z[i] = q.z / Metre;
+    spherical_bodies.μ[i] = bodies_[b]->gravitational_parameter() /
+                            si::Unit<GravitationalParameter>;
+    spherical_bodies.ax[i] = a.x / si::Unit<Acceleration>;
+    spherical_bodies.ay[i] = a.y / si::Unit<Acceleration>;
+    spherical_bodies.az[i] = a.z / si::Unit<Acceleration>;
+  }
+
+  ComputePointMassAccelerationsVectorized(spherical_bodies);
+
+  for (int i = 0; i < number_of_spherical_bodies_; ++i) {
+    std::size_t const b = number_of_oblate_bodies_ + i;
+    accelerations[b] = Vector<Acceleration, Frame>(
+        {spherical_bodies.ax[i] * si::Unit<Acceleration>,
+         spherical_bodies.ay[i] * si::Unit<Acceleration>,
+         spherical_bodies.az[i] * si::Unit<Acceleration>});
+  }
 }
 
 template<typename Frame>
@@ -1459,14 +2250,20 @@ ComputeGravitationalAccelerationByAllMassiveBodiesOnMasslessBodies(
   auto error = static_cast<std::underlying_type_t<absl::StatusCode>>(
       absl::StatusCode::kOk);
 
+  // This function is called for each stage of each massless integration, so
+  // avoid allocating the positions of the massive bodies each time.
+  thread_local std::vector<Position<Frame>> massive_bodies_positions;
+
   // Locking ensures that we see a consistent state of all the trajectories.
   absl::ReaderMutexLock l(&lock_);
+  EvaluateMassiveBodiesPositionsLocked(t, massive_bodies_positions);
   for (std::size_t b1 = 0; b1 < number_of_oblate_bodies_; ++b1) {
     MassiveBody const& body1 = *bodies_[b1];
     error |= ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies<
                  /*body1_is_oblate=*/true>(
                  t,
                  body1, b1,
+                 /*position1=*/massive_bodies_positions[b1],
                  positions,
                  accelerations);
   }
@@ -1479,12 +2276,53 @@ ComputeGravitationalAccelerationByAllMassiveBodiesOnMasslessBodies(
                  /*body1_is_oblate=*/false>(
                  t,
                  body1, b1,
+                 /*position1=*/massive_bodies_positions[b1],
                  positions,
                  accelerations);
   }
   return static_cast<absl::StatusCode>(error);
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::EvaluateMassiveBodiesPositionsLocked(
+    Instant const& t,
+    std::vector<Position<Frame>>& positions) const {
+  lock_.AssertReaderHeld();
+  {
+    absl::ReaderMutexLock l(&massive_bodies_positions_cache_lock_);
+    for (auto const& entry : massive_bodies_positions_cache_) {
+      if (!entry.positions.empty() && entry.time == t) {
+        positions = entry.positions;
+        return;
+      }
+    }
+  }
+
+  // Evaluate the trajectories without holding the cache lock, so that threads
+  // integrating at different times don't serialize on the cache.
+  if (batched_positions_evaluation_) {
+    // Note that this evaluator may be shared by multiple ephemerides on the
+    // same thread; it detects the change of trajectories.
+    thread_local BatchedPositionsEvaluator<Frame> evaluator;
+    evaluator.EvaluatePositions(trajectories_, t, positions);
+  } else {
+    positions.clear();
+    positions.reserve(trajectories_.size());
+    for (auto const trajectory : trajectories_) {
+      positions.push_back(trajectory->EvaluatePositionLocked(t));
+    }
+  }
+
+  absl::MutexLock l(&massive_bodies_positions_cache_lock_);
+  auto& entry =
+      massive_bodies_positions_cache_[massive_bodies_positions_cache_next_];
+  entry.time = t;
+  entry.positions = positions;
+  massive_bodies_positions_cache_next_ =
+      (massive_bodies_positions_cache_next_ + 1) %
+      massive_bodies_positions_cache_size;
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::ComputeGravitationalPotentialsOfAllMassiveBodies(
     Instant const& t,
@@ -1520,18 +2358,16 @@ template<typename Frame>
 template<typename ODE>
 absl::Status Ephemeris<Frame>::FlowODEWithAdaptiveStep(
     typename ODE::RightHandSideComputation compute_acceleration,
-    not_null<DiscreteTrajectory<Frame>*> trajectory,
+    std::vector<not_null<DiscreteTrajectory<Frame>*>> const& trajectories,
     Instant const& t,
     _integration_parameters::AdaptiveStepParameters<ODE> const& parameters,
-    std::int64_t max_ephemeris_steps) {
-  auto const& [trajectory_last_time,
-               trajectory_last_degrees_of_freedom] = trajectory->back();
+    std::int64_t max_ephemeris_steps,
+    IntegrationStatistics<Time>* const statistics) {
+  Instant const& trajectory_last_time = trajectories.front()->back().time;
   if (trajectory_last_time == t) {
     return absl::OkStatus();
   }
 
-  std::vector<not_null<DiscreteTrajectory<Frame>*>> const trajectories =
-      {trajectory};
   Prolong(t, max_ephemeris_steps).IgnoreError();
   RETURN_IF_STOPPED;
   Instant const t_final = std::min(t, t_max());
@@ -1539,9 +2375,15 @@ absl::Status Ephemeris<Frame>::FlowODEWithAdaptiveStep(
   InitialValueProblem<ODE> problem;
   problem.equation.compute_acceleration = std::move(compute_acceleration);
 
-  problem.initial_state = {trajectory_last_time,
-                           {trajectory_last_degrees_of_freedom.position()},
-                           {trajectory_last_degrees_of_freedom.velocity()}};
+  problem.initial_state.time = DoublePrecision<Instant>(trajectory_last_time);
+  for (auto const trajectory : trajectories) {
+    auto const& [last_time, last_degrees_of_freedom] = trajectory->back();
+    CHECK_EQ(trajectory_last_time, last_time);
+    problem.initial_state.positions.emplace_back(
+        last_degrees_of_freedom.position());
+    problem.initial_state.velocities.emplace_back(
+        last_degrees_of_freedom.velocity());
+  }
 
   typename AdaptiveStepSizeIntegrator<ODE>::Parameters const
       integrator_parameters(
@@ -1568,6 +2410,9 @@ absl::Status Ephemeris<Frame>::FlowODEWithAdaptiveStep(
                                           tolerance_to_error_ratio,
                                           integrator_parameters);
   auto status = instance->Solve(t_final);
+  if (statistics != nullptr) {
+    *statistics += instance->statistics();
+  }
 
   // We probably don't care if the vessel gets too close to the singularity, as
   // we only use this integrator for the future.  So we swallow the error.  Note
@@ -1597,18 +2442,9 @@ double Ephemeris<Frame>::ToleranceToErrorRatio(
     Time const& current_step_size,
     typename NewtonianMotionEquation::State const& /*state*/,
     typename NewtonianMotionEquation::State::Error const& error) {
-  Length max_length_error;
-  Speed max_speed_error;
-  for (auto const& position_error : error.position_error) {
-    max_length_error = std::max(max_length_error,
-                                position_error.Norm());
-  }
-  for (auto const& velocity_error : error.velocity_error) {
-    max_speed_error = std::max(max_speed_error,
-                               velocity_error.Norm());
-  }
-  return std::min(length_integration_tolerance / max_length_error,
-                  speed_integration_tolerance / max_speed_error);
+  return std::min(
+      length_integration_tolerance / error.position_error.front().Norm(),
+      speed_integration_tolerance / error.velocity_error.front().Norm());
 }
 
 template<typename Frame>
@@ -6,6 +6,7 @@
 #include <random>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -15,6 +16,7 @@
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
+#include "geometry/r3_element.hpp"
 #include "geometry/r3x3_matrix.hpp"
 #include "geometry/space.hpp"
 #include "gipfeli/gipfeli.h"
@@ -36,6 +38,7 @@
 #include "physics/oblate_body.hpp"
 #include "physics/rotating_body.hpp"
 #include "physics/solar_system.hpp"
+#include "physics/tensors.hpp"
 #include "quantities/astronomy.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
@@ -66,6 +69,7 @@ using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
+using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_r3x3_matrix;
 using namespace principia::geometry::_space;
 using namespace principia::integrators::_embedded_explicit_generalized_runge_kutta_nyström_integrator;  // NOLINT
@@ -85,6 +89,7 @@ using namespace principia::physics::_massless_body;
 using namespace principia::physics::_oblate_body;
 using namespace principia::physics::_rotating_body;
 using namespace principia::physics::_solar_system;
+using namespace principia::physics::_tensors;
 using namespace principia::quantities::_astronomy;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
@@ -609,6 +614,122 @@ TEST_P(EphemerisTest, EarthTwoProbes) {
               Eq(q_probe2));
 }
 
+TEST_P(EphemerisTest, StateTransitionMatrices) {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<ICRS>> initial_state;
+  Position<ICRS> centre_of_mass;
+  Time period;
+  SetUpEarthMoonSystem(bodies, initial_state, centre_of_mass, period);
+
+  bodies.erase(bodies.begin() + 1);
+  initial_state.erase(initial_state.begin() + 1);
+
+  GravitationalParameter const μ = bodies[0]->gravitational_parameter();
+  DegreesOfFreedom<ICRS> const earth_degrees_of_freedom = initial_state[0];
+
+  Ephemeris<ICRS> ephemeris(
+      std::move(bodies),
+      initial_state,
+      t0_,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/5 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<ICRS>::FixedStepParameters(integrator(), period / 100));
+
+  // An eccentric, inclined orbit.
+  Length const r = 1e7 * Metre;
+  Speed const v = 1.1 * Sqrt(μ / r);
+  RelativeDegreesOfFreedom<ICRS> const probe_relative_degrees_of_freedom(
+      Displacement<ICRS>({r, 0 * Metre, 0 * Metre}),
+      Velocity<ICRS>({0 * Metre / Second, 0.8 * v, 0.6 * v}));
+  Time const probe_period = 2 * π * Sqrt(Pow<3>(r) / μ);
+
+  Ephemeris<ICRS>::AdaptiveStepParameters const parameters(
+      EmbeddedExplicitRungeKuttaNyströmIntegrator<
+          DormandالمكاوىPrince1986RKN434FM,
+          Ephemeris<ICRS>::NewtonianMotionEquation>(),
+      max_steps,
+      /*length_integration_tolerance=*/1e-6 * Metre,
+      /*speed_integration_tolerance=*/1e-9 * Metre / Second);
+  Instant const t_final = t0_ + probe_period;
+  std::vector<Instant> const times = {
+      t0_, t0_ + probe_period / 3, t0_ + probe_period / 2, t_final};
+
+  auto const flow = [&](RelativeDegreesOfFreedom<ICRS> const& perturbation) {
+    DiscreteTrajectory<ICRS> trajectory;
+    EXPECT_OK(trajectory.Append(t0_,
+                                earth_degrees_of_freedom +
+                                    probe_relative_degrees_of_freedom +
+                                    perturbation));
+    EXPECT_OK(ephemeris.FlowWithAdaptiveStep(
+        &trajectory,
+        Ephemeris<ICRS>::NoIntrinsicAcceleration,
+        t_final,
+        parameters,
+        Ephemeris<ICRS>::unlimited_max_ephemeris_steps));
+    return trajectory;
+  };
+
+  DiscreteTrajectory<ICRS> trajectory;
+  EXPECT_OK(trajectory.Append(
+      t0_, earth_degrees_of_freedom + probe_relative_degrees_of_freedom));
+  std::vector<Ephemeris<ICRS>::StateTransitionMatrix>
+      state_transition_matrices;
+  EXPECT_OK(ephemeris.FlowWithAdaptiveStepAndStateTransitionMatrices(
+      &trajectory,
+      Ephemeris<ICRS>::NoIntrinsicAcceleration,
+      t_final,
+      parameters,
+      times,
+      &state_transition_matrices,
+      Ephemeris<ICRS>::unlimited_max_ephemeris_steps));
+  EXPECT_EQ(t_final, trajectory.back().time);
+  ASSERT_EQ(times.size(), state_transition_matrices.size());
+  EXPECT_EQ(R3x3Matrix<double>::Identity(),
+            state_transition_matrices.front().dq_dq₀);
+  EXPECT_EQ(R3x3Matrix<Time>(), state_transition_matrices.front().dq_dv₀);
+  EXPECT_EQ(R3x3Matrix<Inverse<Time>>(),
+            state_transition_matrices.front().dv_dq₀);
+  EXPECT_EQ(R3x3Matrix<double>::Identity(),
+            state_transition_matrices.front().dv_dv₀);
+
+  // Compare with central differences.
+  Length const δq = 1 * Kilo(Metre);
+  Speed const δv = 1 * Metre / Second;
+  for (int j = 0; j < 3; ++j) {
+    R3Element<double> unit;
+    unit[j] = 1;
+    Displacement<ICRS> const Δq(δq * unit);
+    Velocity<ICRS> const Δv(δv * unit);
+    auto const q_plus = flow({Δq, Velocity<ICRS>()});
+    auto const q_minus = flow({-Δq, Velocity<ICRS>()});
+    auto const v_plus = flow({Displacement<ICRS>(), Δv});
+    auto const v_minus = flow({Displacement<ICRS>(), -Δv});
+    for (int i = 1; i < times.size(); ++i) {
+      auto const& matrix = state_transition_matrices[i];
+      RelativeDegreesOfFreedom<ICRS> const q_difference = q_plus.EvaluateDegreesOfFreedom(times[i]) -
+                                q_minus.EvaluateDegreesOfFreedom(times[i]);
+      RelativeDegreesOfFreedom<ICRS> const v_difference = v_plus.EvaluateDegreesOfFreedom(times[i]) -
+                                v_minus.EvaluateDegreesOfFreedom(times[i]);
+      EXPECT_THAT(matrix.dq_dq₀ * unit,
+                  RelativeErrorFrom(
+                      q_difference.displacement().coordinates() / (2 * δq),
+                      Lt(1e-5))) << i << " " << j;
+      EXPECT_THAT(matrix.dv_dq₀ * unit,
+                  RelativeErrorFrom(
+                      q_difference.velocity().coordinates() / (2 * δq),
+                      Lt(1e-5))) << i << " " << j;
+      EXPECT_THAT(matrix.dq_dv₀ * unit,
+                  RelativeErrorFrom(
+                      v_difference.displacement().coordinates() / (2 * δv),
+                      Lt(1e-5))) << i << " " << j;
+      EXPECT_THAT(matrix.dv_dv₀ * unit,
+                  RelativeErrorFrom(
+                      v_difference.velocity().coordinates() / (2 * δv),
+                      Lt(1e-5))) << i << " " << j;
+    }
+  }
+}
+
 TEST_P(EphemerisTest, Serialization) {
   std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
   std::vector<DegreesOfFreedom<ICRS>> initial_state;
@@ -748,6 +869,61 @@ TEST_P(EphemerisTest, ComputeGravitationalAccelerationMasslessBody) {
                           -9.832 * si::Unit<Acceleration>), 6.7e-6);
 }
 
+TEST_P(EphemerisTest, ComputeGravitationalAccelerationsMasslessBodies) {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<ICRS>> initial_state;
+  Position<ICRS> centre_of_mass;
+  Time period;
+  SetUpEarthMoonSystem(bodies, initial_state, centre_of_mass, period);
+
+  Ephemeris<ICRS> ephemeris(
+      std::move(bodies),
+      initial_state,
+      t0_,
+      /*accuracy_parameters=*/{/*fitting_tolerance=*/5 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<ICRS>::FixedStepParameters(integrator(), period / 100));
+  EXPECT_OK(ephemeris.Prolong(t0_ + period));
+
+  std::vector<Position<ICRS>> const positions = {
+      centre_of_mass + Displacement<ICRS>({1e8 * Metre, 0 * Metre, 0 * Metre}),
+      centre_of_mass + Displacement<ICRS>({0 * Metre, 2e8 * Metre, 0 * Metre}),
+      centre_of_mass + Displacement<ICRS>({0 * Metre, 0 * Metre, 3e8 * Metre})};
+
+  // Evaluate twice at each time to exercise the cache of the positions of the
+  // massive bodies.
+  std::vector<Vector<Acceleration, ICRS>> accelerations;
+  for (int i = 0; i <= 10; ++i) {
+    Instant const t = t0_ + i * period / 10;
+    for (int j = 0; j < 2; ++j) {
+      EXPECT_OK(ephemeris.ComputeGravitationalAccelerationsOnMasslessBodies(
+          positions, t, accelerations));
+      ASSERT_THAT(accelerations.size(), Eq(positions.size()));
+      for (int k = 0; k < positions.size(); ++k) {
+        EXPECT_THAT(accelerations[k],
+                    Eq(ephemeris.ComputeGravitationalAccelerationOnMasslessBody(
+                        positions[k], t)));
+      }
+    }
+  }
+
+  // A position at the centre of a massive body is a collision, but the other
+  // accelerations are still computed.
+  Instant const t = t0_ + period / 2;
+  std::vector<Position<ICRS>> colliding_positions = positions;
+  colliding_positions.push_back(
+      ephemeris.trajectory(ephemeris.bodies().front())->EvaluatePosition(t));
+  EXPECT_THAT(ephemeris.ComputeGravitationalAccelerationsOnMasslessBodies(
+                  colliding_positions, t, accelerations),
+              StatusIs(absl::StatusCode::kOutOfRange));
+  ASSERT_THAT(accelerations.size(), Eq(colliding_positions.size()));
+  for (int k = 0; k < positions.size(); ++k) {
+    EXPECT_THAT(accelerations[k],
+                Eq(ephemeris.ComputeGravitationalAccelerationOnMasslessBody(
+                    positions[k], t)));
+  }
+}
+
 #if !defined(_DEBUG)
 // An apple located a bit above the pole collides with the ground.
 TEST_P(EphemerisTest, CollisionDetection) {
@@ -1029,6 +1205,43 @@ TEST_P(EphemerisTest, ComputeGravitationalJerkOnMassiveBody) {
   }
 }
 
+TEST_P(EphemerisTest, ComputeJacobiansAndJerksOnMassiveBodies) {
+  SolarSystem<ICRS> const solar_system_2000(
+            SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+            SOLUTION_DIR / "astronomy" /
+                "sol_initial_state_jd_2451545_000000000.proto.txt");
+  Instant const j2000 = solar_system_2000.epoch();
+
+  auto ephemeris = solar_system_2000.MakeEphemeris(
+      /*accuracy_parameters=*/{/*fitting_tolerance-*/1 * Milli(Metre),
+                               /*geopotential_tolerance=*/0x1p-24},
+      Ephemeris<ICRS>::FixedStepParameters(
+          SymplecticRungeKuttaNyströmIntegrator<
+              McLachlanAtela1992Order4Optimal,
+              Ephemeris<ICRS>::NewtonianMotionEquation>(),
+          /*step=*/10 * Minute));
+  Instant const t = j2000 + 1 * Day;
+  CHECK_OK(ephemeris->Prolong(t));
+
+  std::vector<JacobianOfAcceleration<ICRS>> jacobians;
+  std::vector<Vector<Jerk, ICRS>> jerks;
+  // Call twice to check that the vectors are properly reset.
+  ephemeris->ComputeJacobiansAndJerksOnMassiveBodies(j2000, &jacobians, &jerks);
+  ephemeris->ComputeJacobiansAndJerksOnMassiveBodies(t, &jacobians, &jerks);
+  ASSERT_EQ(ephemeris->bodies().size(), jacobians.size());
+  ASSERT_EQ(ephemeris->bodies().size(), jerks.size());
+  // The contributions are summed in the same order, so the results are
+  // identical.
+  for (int b = 0; b < ephemeris->bodies().size(); ++b) {
+    auto const body = ephemeris->bodies()[b];
+    EXPECT_EQ(ephemeris->ComputeJacobianOnMassiveBody(body, t), jacobians[b])
+        << body->name();
+    EXPECT_EQ(ephemeris->ComputeGravitationalJerkOnMassiveBody(body, t),
+              jerks[b])
+        << body->name();
+  }
+}
+
 TEST_P(EphemerisTest, ComputeGravitationalAccelerationOnMassiveBody) {
   Time const duration = 1 * Second;
   double const j2 = 1e6;
@@ -1463,6 +1676,226 @@ TEST(EphemerisTestNoFixture, Reanimator) {
     }
   }
 }
+
+TEST(EphemerisTestNoFixture, ParallelMassiveBodiesIntegration) {
+  Instant const t_initial;
+  Instant const t_final = t_initial + 1 * JulianYear;
+
+  SolarSystem<ICRS> solar_system(
+      SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+      SOLUTION_DIR / "astronomy" /
+          "sol_initial_state_jd_2451545_000000000.proto.txt");
+  auto make_ephemeris = [&solar_system]() {
+    return solar_system.MakeEphemeris(
+        /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                                 /*geopotential_tolerance=*/0x1p-24},
+        /*fixed_step_parameters=*/{
+            SymmetricLinearMultistepIntegrator<
+                QuinlanTremaine1990Order12,
+                Ephemeris<ICRS>::NewtonianMotionEquation>(),
+            /*step=*/10 * Minute});
+  };
+
+  auto const sequential = make_ephemeris();
+  auto const parallel1 = make_ephemeris();
+  auto const parallel4 = make_ephemeris();
+  parallel1->EnableParallelMassiveBodiesIntegration(/*pool_size=*/1);
+  parallel4->EnableParallelMassiveBodiesIntegration(/*pool_size=*/4);
+  EXPECT_OK(sequential->Prolong(t_final));
+  EXPECT_OK(parallel1->Prolong(t_final));
+  EXPECT_OK(parallel4->Prolong(t_final));
+
+  for (int i = 0; i < sequential->bodies().size(); ++i) {
+    auto const sequential_trajectory =
+        sequential->trajectory(sequential->bodies()[i]);
+    auto const parallel1_trajectory =
+        parallel1->trajectory(parallel1->bodies()[i]);
+    auto const parallel4_trajectory =
+        parallel4->trajectory(parallel4->bodies()[i]);
+    for (Instant t = t_initial;
+         t <= t_final;
+         t += (t_final - t_initial) / 100) {
+      // The result doesn't depend on the size of the pool.
+      EXPECT_EQ(parallel1_trajectory->EvaluateDegreesOfFreedom(t),
+                parallel4_trajectory->EvaluateDegreesOfFreedom(t));
+      // It only differs from the sequential one by the order of the
+      // summations.
+      EXPECT_LT((parallel4_trajectory->EvaluatePosition(t) -
+                 sequential_trajectory->EvaluatePosition(t)).Norm(),
+                1 * Metre)
+          << sequential->bodies()[i]->name();
+    }
+  }
+}
+
+TEST(EphemerisTestNoFixture, AsynchronousProlongation) {
+  Instant const t_initial;
+  Instant const t_final = t_initial + 1 * JulianYear;
+
+  SolarSystem<ICRS> solar_system(
+      SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+      SOLUTION_DIR / "astronomy" /
+          "sol_initial_state_jd_2451545_000000000.proto.txt");
+  auto make_ephemeris = [&solar_system]() {
+    return solar_system.MakeEphemeris(
+        /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                                 /*geopotential_tolerance=*/0x1p-24},
+        /*fixed_step_parameters=*/{
+            SymmetricLinearMultistepIntegrator<
+                QuinlanTremaine1990Order12,
+                Ephemeris<ICRS>::NewtonianMotionEquation>(),
+            /*step=*/10 * Minute});
+  };
+
+  auto const synchronous = make_ephemeris();
+  auto const asynchronous = make_ephemeris();
+  EXPECT_OK(synchronous->Prolong(t_final));
+  asynchronous->RequestProlongation(t_final);
+  while (asynchronous->t_max() < t_final) {
+    std::this_thread::sleep_for(10ms);
+  }
+
+  // The asynchronous prolongation proceeds by chunks, but it integrates the
+  // same steps, so the trajectories are identical.
+  for (int i = 0; i < synchronous->bodies().size(); ++i) {
+    auto const synchronous_trajectory =
+        synchronous->trajectory(synchronous->bodies()[i]);
+    auto const asynchronous_trajectory =
+        asynchronous->trajectory(asynchronous->bodies()[i]);
+    for (Instant t = t_initial;
+         t <= t_final;
+         t += (t_final - t_initial) / 100) {
+      EXPECT_EQ(synchronous_trajectory->EvaluateDegreesOfFreedom(t),
+                asynchronous_trajectory->EvaluateDegreesOfFreedom(t));
+    }
+  }
+}
+
+TEST(EphemerisTestNoFixture, PararealProlongation) {
+  Instant const t_initial;
+  Instant const t_final = t_initial + 1 * JulianYear;
+
+  SolarSystem<ICRS> solar_system(
+      SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+      SOLUTION_DIR / "astronomy" /
+          "sol_initial_state_jd_2451545_000000000.proto.txt");
+  // The parareal iteration only converges if the coarse integrator is
+  // reasonably accurate, so we remove the bodies with short periods.
+  std::set<std::string> const retained_names = {"Sun",
+                                                "Mercury",
+                                                "Venus",
+                                                "Earth",
+                                                "Moon",
+                                                "Mars",
+                                                "Jupiter",
+                                                "Saturn",
+                                                "Uranus",
+                                                "Neptune"};
+  for (std::string const& name :
+       std::vector<std::string>(solar_system.names())) {
+    if (!retained_names.contains(name)) {
+      solar_system.RemoveMassiveBody(name);
+    }
+  }
+  auto make_ephemeris = [&solar_system]() {
+    return solar_system.MakeEphemeris(
+        /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                                 /*geopotential_tolerance=*/0x1p-24},
+        /*fixed_step_parameters=*/{
+            SymmetricLinearMultistepIntegrator<
+                QuinlanTremaine1990Order12,
+                Ephemeris<ICRS>::NewtonianMotionEquation>(),
+            /*step=*/10 * Minute});
+  };
+
+  auto const sequential = make_ephemeris();
+  auto const parareal = make_ephemeris();
+  EXPECT_OK(sequential->Prolong(t_final));
+  EXPECT_OK(parareal->ProlongWithParareal(
+      t_final,
+      /*coarse_parameters=*/{
+          SymplecticRungeKuttaNyströmIntegrator<
+              McLachlanAtela1992Order4Optimal,
+              Ephemeris<ICRS>::NewtonianMotionEquation>(),
+          /*step=*/1 * Hour},
+      /*number_of_slices=*/8,
+      /*tolerance=*/1 * Metre,
+      /*max_iterations=*/8));
+  EXPECT_LE(t_final, parareal->t_max());
+
+  for (int i = 0; i < sequential->bodies().size(); ++i) {
+    auto const sequential_trajectory =
+        sequential->trajectory(sequential->bodies()[i]);
+    auto const parareal_trajectory =
+        parareal->trajectory(parareal->bodies()[i]);
+    for (Instant t = t_initial;
+         t <= t_final;
+         t += (t_final - t_initial) / 100) {
+      EXPECT_LT((parareal_trajectory->EvaluatePosition(t) -
+                 sequential_trajectory->EvaluatePosition(t)).Norm(),
+                1 * Centi(Metre))
+          << sequential->bodies()[i]->name();
+    }
+  }
+}
+
+TEST(EphemerisTestNoFixture, PararealFallback) {
+  Instant const t_initial;
+  Instant const t_final = t_initial + 30 * Day;
+
+  SolarSystem<ICRS> solar_system(
+      SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
+      SOLUTION_DIR / "astronomy" /
+          "sol_initial_state_jd_2451545_000000000.proto.txt");
+  std::set<std::string> const retained_names = {"Sun", "Earth", "Jupiter"};
+  for (std::string const& name :
+       std::vector<std::string>(solar_system.names())) {
+    if (!retained_names.contains(name)) {
+      solar_system.RemoveMassiveBody(name);
+    }
+  }
+  auto make_ephemeris = [&solar_system]() {
+    return solar_system.MakeEphemeris(
+        /*accuracy_parameters=*/{/*fitting_tolerance=*/1 * Milli(Metre),
+                                 /*geopotential_tolerance=*/0x1p-24},
+        /*fixed_step_parameters=*/{
+            SymmetricLinearMultistepIntegrator<
+                QuinlanTremaine1990Order12,
+                Ephemeris<ICRS>::NewtonianMotionEquation>(),
+            /*step=*/10 * Minute});
+  };
+
+  // A single iteration cannot reach this tolerance, so the ephemeris is
+  // integrated sequentially and matches the result of |Prolong| exactly.
+  auto const sequential = make_ephemeris();
+  auto const parareal = make_ephemeris();
+  EXPECT_OK(sequential->Prolong(t_final));
+  EXPECT_OK(parareal->ProlongWithParareal(
+      t_final,
+      /*coarse_parameters=*/{
+          SymplecticRungeKuttaNyströmIntegrator<
+              McLachlanAtela1992Order4Optimal,
+              Ephemeris<ICRS>::NewtonianMotionEquation>(),
+          /*step=*/1 * Day},
+      /*number_of_slices=*/4,
+      /*tolerance=*/1 * Nano(Metre),
+      /*max_iterations=*/1));
+  EXPECT_LE(t_final, parareal->t_max());
+
+  for (int i = 0; i < sequential->bodies().size(); ++i) {
+    auto const sequential_trajectory =
+        sequential->trajectory(sequential->bodies()[i]);
+    auto const parareal_trajectory =
+        parareal->trajectory(parareal->bodies()[i]);
+    for (Instant t = t_initial;
+         t <= t_final;
+         t += (t_final - t_initial) / 100) {
+      EXPECT_EQ(parareal_trajectory->EvaluatePosition(t),
+                sequential_trajectory->EvaluatePosition(t))
+          << sequential->bodies()[i]->name();
+    }
+  }
+}
 #endif
 
 INSTANTIATE_TEST_SUITE_P(
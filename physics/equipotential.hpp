@@ -5,6 +5,7 @@
 
 #include "absl/status/status.h"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/plane.hpp"
@@ -24,6 +25,7 @@ namespace _equipotential {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_plane;
@@ -86,13 +88,19 @@ class Equipotential {
   // a position, |towards_infinity| should return a position far away where the
   // potential is lower, in a direction where not much happens, e.g., away from
   // the centre in a rotating frame.
+  // The lines are not independent: each of them determines which delineations
+  // remain to be done.  If |pool| is not null, the first line of each peak is
+  // computed speculatively on |pool|, in which case |towards_infinity| must be
+  // thread-safe.  The speculative lines that turn out to be needed are used,
+  // the others are discarded, so the result doesn't depend on |pool|.
   Lines ComputeLines(
       Plane<Frame> const& plane,
       Instant const& t,
       std::vector<Position<Frame>> const& peaks,
       std::vector<Well> const& wells,
       std::function<Position<Frame>(Position<Frame>)> towards_infinity,
-      SpecificEnergy const& energy) const;
+      SpecificEnergy const& energy,
+      ThreadPool<void>* pool = nullptr) const;
 
  private:
   using IndependentVariableDifference =
@@ -3,6 +3,7 @@
 #include "physics/equipotential.hpp"
 
 #include <functional>
+#include <future>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -99,7 +100,8 @@ auto Equipotential<InertialFrame, Frame>::ComputeLines(
     std::vector<Position<Frame>> const& peaks,
     std::vector<Well> const& wells,
     std::function<Position<Frame>(Position<Frame>)> towards_infinity,
-    SpecificEnergy const& energy) const -> Lines {
+    SpecificEnergy const& energy,
+    ThreadPool<void>* const pool) const -> Lines {
   using WellIterator = typename std::vector<Well>::const_iterator;
 
   // A |PeakDelineation| represents:
@@ -111,6 +113,71 @@ auto Equipotential<InertialFrame, Frame>::ComputeLines(
     bool delineated_from_infinity = false;
   };
 
+  // Returns a line that delineates |peak| from |well|, or from the well at
+  // infinity if |well| is null, or nullopt if we must give up on this
+  // delineation.  This function only depends on its arguments.
+  auto const delineating_line =
+      [this, &plane, &t, &towards_infinity, &energy](
+          Position<Frame> const& peak,
+          std::optional<WellIterator> const& well) -> std::optional<Line> {
+    if (well.has_value()) {
+      Well const& w = **well;
+      Length const r = (peak - w.position).Norm();
+      if (reference_frame_->GeometricPotential(
+              t,
+              Barycentre(std::pair(peak, w.position),
+                         std::pair(w.radius, r - w.radius))) >= energy) {
+        // The point at the edge of the well in the direction of the peak is
+        // above the energy; this should not happen (the edge of the well
+        // should be close enough to the singularity to be below any
+        // interesting energy).
+        // Give up on separating the peak from the well.
+        // TODO(phl): This happens when we find the peak at the centre of the
+        // Earth.
+        return std::nullopt;
+      }
+      // Look for a point on the equipotential along the line between the peak
+      // and the edge of the well.
+      Length const x = Brent(
+          [&](Length const& x) {
+            return reference_frame_->GeometricPotential(
+                       t,
+                       Barycentre(std::pair(peak, w.position),
+                                  std::pair(x, r - x))) -
+                   energy;
+          },
+          w.radius,
+          r);
+      Position<Frame> const equipotential_position =
+          Barycentre(std::pair(peak, w.position), std::pair(x, r - x));
+      return ComputeLine(plane, t, equipotential_position);
+    } else {
+      // Try to delineate |peak| from the well at infinity; this works as for an
+      // actual well, but instead of picking the point on the edge of the well
+      // in the direction of the peak we generate a far away point based on the
+      // peak (corresponding to a point on the edge of the well at infinity).
+      Position<Frame> const far_away = towards_infinity(peak);
+      if (reference_frame_->GeometricPotential(t, far_away) >= energy) {
+        // The far away point is too high in the potential, presumably not far
+        // enough.  Give up on separating this peak from infinity.
+        return std::nullopt;
+      }
+      double const x = Brent(
+          [&](double const& x) {
+            return reference_frame_->GeometricPotential(
+                       t,
+                       Barycentre(std::pair(peak, far_away),
+                                  std::pair(x, 1 - x))) -
+                   energy;
+          },
+          0.0,
+          1.0);
+      Position<Frame> const equipotential_position =
+          Barycentre(std::pair(peak, far_away), std::pair(x, 1 - x));
+      return ComputeLine(plane, t, equipotential_position);
+    }
+  };
+
   // |peak_delineations[i]| corresponds to |peaks[i]|.
   std::vector<PeakDelineation> peak_delineations(peaks.size());
   for (auto& delineation : peak_delineations) {
@@ -119,6 +186,25 @@ auto Equipotential<InertialFrame, Frame>::ComputeLines(
     }
   }
 
+  // The first delineation attempted for each peak, computed speculatively if
+  // there is a |pool|.  |speculative_lines[i]| is consumed at most once, when
+  // the serial algorithm below attempts the same delineation for |peaks[i]|.
+  std::optional<WellIterator> const first_well =
+      wells.empty() ? std::nullopt : std::make_optional(wells.begin());
+  std::vector<std::optional<Line>> speculative_lines(peaks.size());
+  std::vector<std::future<void>> speculative_futures(peaks.size());
+  if (pool != nullptr) {
+    for (int i = 0; i < peaks.size(); ++i) {
+      if (reference_frame_->GeometricPotential(t, peaks[i]) < energy) {
+        continue;
+      }
+      speculative_futures[i] = pool->Add(
+          [&delineating_line, &speculative_lines, &peaks, &first_well, i]() {
+            speculative_lines[i] = delineating_line(peaks[i], first_well);
+          });
+    }
+  }
+
   Lines lines;
   for (int i = 0; i < peaks.size(); ++i) {
     auto const& delineation = peak_delineations[i];
@@ -136,67 +222,28 @@ auto Equipotential<InertialFrame, Frame>::ComputeLines(
       if (!delineation.indistinct_wells.empty()) {
         // Try to delineate |peak| from the first of its |indistinct_wells|.
         expected_delineated_well = *delineation.indistinct_wells.begin();
-        Well const well = **expected_delineated_well;
-        Length const r = (peak - well.position).Norm();
-        if (reference_frame_->GeometricPotential(
-                t,
-                Barycentre(std::pair(peak, well.position),
-                           std::pair(well.radius, r - well.radius))) >=
-            energy) {
-          // The point at the edge of the well in the direction of the peak is
-          // above the energy; this should not happen (the edge of the well
-          // should be close enough to the singularity to be below any
-          // interesting energy).
-          // Give up on separating the peak from the well.
-          // TODO(phl): This happens when we find the peak at the centre of the
-          // Earth.
-          peak_delineations[i].indistinct_wells.erase(
-              *expected_delineated_well);
-          continue;
-        }
-        // Look for a point on the equipotential along the line between the peak
-        // and the edge of the well.
-        Length const x = Brent(
-            [&](Length const& x) {
-              return reference_frame_->GeometricPotential(
-                         t,
-                         Barycentre(std::pair(peak, well.position),
-                                    std::pair(x, r - x))) -
-                     energy;
-            },
-            well.radius,
-            r);
-        Position<Frame> const equipotential_position =
-            Barycentre(std::pair(peak, well.position), std::pair(x, r - x));
-        lines.push_back(ComputeLine(plane, t, equipotential_position));
       } else {
-        // Try to delineate |peak| from the well at infinity; this works as for
-        // an actual well, but instead of picking the point on the edge of the
-        // well in the direction of the peak we generate a far away point based
-        // on the peak (corresponding to a point on the edge of the well at
-        // infinity).
         expect_delineation_from_infinity = true;
-        Position<Frame> const far_away = towards_infinity(peak);
-        if (reference_frame_->GeometricPotential(t, far_away) >= energy) {
-          // The far away point is too high in the potential, presumably not far
-          // enough.  Give up on separating this peak from infinity.
+      }
+
+      std::optional<Line> line;
+      if (speculative_futures[i].valid() &&
+          expected_delineated_well == first_well) {
+        speculative_futures[i].get();
+        line = std::move(speculative_lines[i]);
+      } else {
+        line = delineating_line(peak, expected_delineated_well);
+      }
+      if (!line.has_value()) {
+        if (expect_delineation_from_infinity) {
           peak_delineations[i].delineated_from_infinity = true;
-          continue;
+        } else {
+          peak_delineations[i].indistinct_wells.erase(
+              *expected_delineated_well);
         }
-        double const x = Brent(
-            [&](double const& x) {
-              return reference_frame_->GeometricPotential(
-                         t,
-                         Barycentre(std::pair(peak, far_away),
-                                    std::pair(x, 1 - x))) -
-                     energy;
-            },
-            0.0,
-            1.0);
-        Position<Frame> const equipotential_position =
-            Barycentre(std::pair(peak, far_away), std::pair(x, 1 - x));
-        lines.push_back(ComputeLine(plane, t, equipotential_position));
+        continue;
       }
+      lines.push_back(std::move(*line));
       std::vector<Position<Frame>> positions;
       for (auto const& [s, dof] : lines.back()) {
         positions.push_back(dof.position());
@@ -239,6 +286,14 @@ auto Equipotential<InertialFrame, Frame>::ComputeLines(
     }
   }
 
+  // Wait for the speculative lines that were not needed, they refer to our
+  // local variables.
+  for (auto& future : speculative_futures) {
+    if (future.valid()) {
+      future.wait();
+    }
+  }
+
   return lines;
 }
 
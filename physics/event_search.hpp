@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+
+#include "base/thread_pool.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/interval.hpp"
+#include "physics/trajectory.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace physics {
+namespace _event_search {
+namespace internal {
+
+using namespace principia::base::_thread_pool;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_interval;
+using namespace principia::physics::_trajectory;
+using namespace principia::quantities::_quantities;
+
+// A time at which the function given to |SearchEvents| changes sign.
+struct Event {
+  Instant time;
+  // True if the function goes from negative to positive at |time|.
+  bool rising;
+};
+
+// Returns, in increasing order of time, the sign changes of |f| over
+// |interval|.  |f| is sampled every |bracketing_step| and each sign change
+// between successive samples is located by Brent's method.  Sign changes that
+// are closer to each other than |bracketing_step| may be missed: when |f| is
+// built from the trajectories of an ephemeris, the step of the ephemeris is a
+// good choice.  If |thread_pool| is not null, |interval| is split into chunks
+// that are searched in parallel, and |f| must be thread-safe.
+template<typename Function>
+std::vector<Event> SearchEvents(Function const& f,
+                                Interval<Instant> const& interval,
+                                Time const& bracketing_step,
+                                ThreadPool<void>* thread_pool = nullptr);
+
+// Returns the times of the closest approaches between |trajectory1| and
+// |trajectory2| over |interval|, i.e., the local minima of their distance.
+template<typename Frame>
+std::vector<Instant> ComputeClosestApproaches(
+    Trajectory<Frame> const& trajectory1,
+    Trajectory<Frame> const& trajectory2,
+    Interval<Instant> const& interval,
+    Time const& bracketing_step,
+    ThreadPool<void>* thread_pool = nullptr);
+
+// Returns the times of the conjunctions of |trajectory1| and |trajectory2| as
+// seen from |observer| over |interval|, i.e., the local minima of the angle
+// between their directions.
+template<typename Frame>
+std::vector<Instant> ComputeConjunctions(
+    Trajectory<Frame> const& observer,
+    Trajectory<Frame> const& trajectory1,
+    Trajectory<Frame> const& trajectory2,
+    Interval<Instant> const& interval,
+    Time const& bracketing_step,
+    ThreadPool<void>* thread_pool = nullptr);
+
+}  // namespace internal
+
+using internal::ComputeClosestApproaches;
+using internal::ComputeConjunctions;
+using internal::Event;
+using internal::SearchEvents;
+
+}  // namespace _event_search
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/event_search_body.hpp"
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "physics/event_search.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <vector>
+
+#include "geometry/grassmann.hpp"
+#include "geometry/sign.hpp"
+#include "geometry/space.hpp"
+#include "numerics/root_finders.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "quantities/named_quantities.hpp"
+
+namespace principia {
+namespace physics {
+namespace _event_search {
+namespace internal {
+
+using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_sign;
+using namespace principia::geometry::_space;
+using namespace principia::numerics::_root_finders;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::quantities::_named_quantities;
+
+// The number of chunks in which the interval is split for a parallel search.
+// Large enough to balance the load among the threads even if the cost of the
+// function varies over the interval.
+constexpr std::int64_t max_chunks = 64;
+
+template<typename Function>
+std::vector<Event> SearchEvents(Function const& f,
+                                Interval<Instant> const& interval,
+                                Time const& bracketing_step,
+                                ThreadPool<void>* const thread_pool) {
+  CHECK_LT(Time{}, bracketing_step);
+  std::vector<Event> events;
+  if (interval.min >= interval.max) {
+    return events;
+  }
+
+  std::int64_t const number_of_steps =
+      std::ceil(interval.measure() / bracketing_step);
+  auto const sample_time = [&interval, &bracketing_step, number_of_steps](
+                               std::int64_t const i) {
+    return i == number_of_steps ? interval.max
+                                : interval.min + i * bracketing_step;
+  };
+
+  // Appends to |chunk_events| the sign changes between the samples |first| and
+  // |last|.
+  auto const search_samples = [&f, &sample_time](
+                                  std::int64_t const first,
+                                  std::int64_t const last,
+                                  std::vector<Event>& chunk_events) {
+    Instant previous_time = sample_time(first);
+    auto previous_value = f(previous_time);
+    for (std::int64_t i = first + 1; i <= last; ++i) {
+      Instant const time = sample_time(i);
+      auto const value = f(time);
+      if (Sign(value) != Sign(previous_value)) {
+        chunk_events.push_back({.time = Brent(f, previous_time, time),
+                                .rising = Sign(value).is_positive()});
+      }
+      previous_time = time;
+      previous_value = value;
+    }
+  };
+
+  if (thread_pool == nullptr) {
+    search_samples(0, number_of_steps, events);
+    return events;
+  }
+
+  // The chunks share their extremal samples, so that no sign change is lost at
+  // their boundaries.
+  std::int64_t const number_of_chunks = std::min(number_of_steps, max_chunks);
+  std::vector<std::vector<Event>> chunk_events(number_of_chunks);
+  std::vector<std::future<void>> futures;
+  futures.reserve(number_of_chunks);
+  for (std::int64_t c = 0; c < number_of_chunks; ++c) {
+    std::int64_t const first = c * number_of_steps / number_of_chunks;
+    std::int64_t const last = (c + 1) * number_of_steps / number_of_chunks;
+    futures.push_back(thread_pool->Add(
+        [&search_samples, &chunk_events, c, first, last]() {
+          search_samples(first, last, chunk_events[c]);
+        }));
+  }
+  for (auto& future : futures) {
+    future.wait();
+  }
+  for (auto const& e : chunk_events) {
+    events.insert(events.end(), e.begin(), e.end());
+  }
+  return events;
+}
+
+template<typename Frame>
+std::vector<Instant> ComputeClosestApproaches(
+    Trajectory<Frame> const& trajectory1,
+    Trajectory<Frame> const& trajectory2,
+    Interval<Instant> const& interval,
+    Time const& bracketing_step,
+    ThreadPool<void>* const thread_pool) {
+  // The derivative of the squared distance, up to a factor 2.
+  auto const squared_distance_derivative =
+      [&trajectory1, &trajectory2](Instant const& t) {
+        RelativeDegreesOfFreedom<Frame> const relative =
+            trajectory1.EvaluateDegreesOfFreedom(t) -
+            trajectory2.EvaluateDegreesOfFreedom(t);
+        return InnerProduct(relative.displacement(), relative.velocity());
+      };
+
+  std::vector<Instant> closest_approaches;
+  for (auto const& event : SearchEvents(squared_distance_derivative,
+                                        interval,
+                                        bracketing_step,
+                                        thread_pool)) {
+    if (event.rising) {
+      closest_approaches.push_back(event.time);
+    }
+  }
+  return closest_approaches;
+}
+
+template<typename Frame>
+std::vector<Instant> ComputeConjunctions(
+    Trajectory<Frame> const& observer,
+    Trajectory<Frame> const& trajectory1,
+    Trajectory<Frame> const& trajectory2,
+    Interval<Instant> const& interval,
+    Time const& bracketing_step,
+    ThreadPool<void>* const thread_pool) {
+  // The derivative of the cosine of the angle between the directions.
+  auto const cosine_derivative =
+      [&observer, &trajectory1, &trajectory2](Instant const& t) {
+        DegreesOfFreedom<Frame> const observer_degrees_of_freedom =
+            observer.EvaluateDegreesOfFreedom(t);
+        RelativeDegreesOfFreedom<Frame> const relative1 =
+            trajectory1.EvaluateDegreesOfFreedom(t) -
+            observer_degrees_of_freedom;
+        RelativeDegreesOfFreedom<Frame> const relative2 =
+            trajectory2.EvaluateDegreesOfFreedom(t) -
+            observer_degrees_of_freedom;
+        Displacement<Frame> const& u = relative1.displacement();
+        Displacement<Frame> const& v = relative2.displacement();
+        Velocity<Frame> const& u̇ = relative1.velocity();
+        Velocity<Frame> const& v̇ = relative2.velocity();
+        Length const u_norm = u.Norm();
+        Length const v_norm = v.Norm();
+        double const cosine = InnerProduct(u, v) / (u_norm * v_norm);
+        return (InnerProduct(u̇, v) + InnerProduct(u, v̇)) / (u_norm * v_norm) -
+               cosine * (InnerProduct(u, u̇) / (u_norm * u_norm) +
+                         InnerProduct(v, v̇) / (v_norm * v_norm));
+      };
+
+  std::vector<Instant> conjunctions;
+  for (auto const& event : SearchEvents(cosine_derivative,
+                                        interval,
+                                        bracketing_step,
+                                        thread_pool)) {
+    if (!event.rising) {
+      conjunctions.push_back(event.time);
+    }
+  }
+  return conjunctions;
+}
+
+}  // namespace internal
+}  // namespace _event_search
+}  // namespace physics
+}  // namespace principia
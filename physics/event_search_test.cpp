@@ -0,0 +1,113 @@
+#include "physics/event_search.hpp"
+
+#include <vector>
+
+#include "base/thread_pool.hpp"
+#include "geometry/frame.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/interval.hpp"
+#include "geometry/space.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "physics/discrete_trajectory.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/discrete_trajectory_factories.hpp"
+
+namespace principia {
+namespace physics {
+
+using ::testing::Lt;
+using ::testing::SizeIs;
+using namespace principia::base::_thread_pool;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_interval;
+using namespace principia::geometry::_space;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_event_search;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_discrete_trajectory_factories;
+
+class EventSearchTest : public ::testing::Test {
+ protected:
+  using World = Frame<struct WorldTag, Inertial>;
+
+  Instant const t0_;
+  Time const period_ = 1 * Day;
+};
+
+TEST_F(EventSearchTest, SignChanges) {
+  auto const f = [this](Instant const& t) {
+    return Sin(2 * π * Radian * (t - t0_) / period_);
+  };
+  Interval<Instant> const interval{.min = t0_ + 0.25 * period_,
+                                   .max = t0_ + 10.25 * period_};
+
+  auto const events = SearchEvents(f, interval, period_ / 10);
+  ASSERT_THAT(events, SizeIs(20));
+  for (int i = 0; i < events.size(); ++i) {
+    EXPECT_THAT(Abs(events[i].time - (t0_ + (i + 1) * period_ / 2)),
+                Lt(1 * Micro(Second)));
+    EXPECT_EQ(i % 2 == 1, events[i].rising);
+  }
+
+  // The parallel search brackets the sign changes with the same samples, so it
+  // finds exactly the same events.
+  ThreadPool<void> thread_pool(/*pool_size=*/4);
+  auto const parallel_events =
+      SearchEvents(f, interval, period_ / 10, &thread_pool);
+  ASSERT_THAT(parallel_events, SizeIs(events.size()));
+  for (int i = 0; i < events.size(); ++i) {
+    EXPECT_EQ(events[i].time, parallel_events[i].time);
+    EXPECT_EQ(events[i].rising, parallel_events[i].rising);
+  }
+
+  // Events closer than the bracketing step are missed.
+  EXPECT_THAT(SearchEvents(f, interval, period_), SizeIs(0));
+}
+
+TEST_F(EventSearchTest, ClosestApproachesAndConjunctions) {
+  Length const r = 1 * Metre;
+  Time const Δt = period_ / 100;
+  Instant const t_max = t0_ + 4 * period_;
+  DiscreteTrajectory<World> observer;
+  DiscreteTrajectory<World> fixed;
+  DiscreteTrajectory<World> circular;
+  AppendTrajectoryTimeline(
+      NewMotionlessTrajectoryTimeline(World::origin, Δt, t0_, t_max),
+      observer);
+  AppendTrajectoryTimeline(
+      NewMotionlessTrajectoryTimeline(
+          World::origin + Displacement<World>({2 * r, 0 * Metre, 0 * Metre}),
+          Δt, t0_, t_max),
+      fixed);
+  AppendTrajectoryTimeline(
+      NewCircularTrajectoryTimeline<World>(period_, r, Δt, t0_, t_max),
+      circular);
+  Interval<Instant> const interval{.min = t0_ + 0.25 * period_,
+                                   .max = t0_ + 3.25 * period_};
+  ThreadPool<void> thread_pool(/*pool_size=*/4);
+
+  auto const closest_approaches = ComputeClosestApproaches(
+      fixed, circular, interval, Δt, &thread_pool);
+  ASSERT_THAT(closest_approaches, SizeIs(3));
+  for (int i = 0; i < closest_approaches.size(); ++i) {
+    EXPECT_THAT(Abs(closest_approaches[i] - (t0_ + (i + 1) * period_)),
+                Lt(1 * Second));
+  }
+
+  auto const conjunctions = ComputeConjunctions(
+      observer, fixed, circular, interval, Δt, &thread_pool);
+  ASSERT_THAT(conjunctions, SizeIs(3));
+  for (int i = 0; i < conjunctions.size(); ++i) {
+    EXPECT_THAT(Abs(conjunctions[i] - (t0_ + (i + 1) * period_)),
+                Lt(1 * Second));
+  }
+}
+
+}  // namespace physics
+}  // namespace principia
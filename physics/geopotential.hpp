@@ -46,6 +46,19 @@ class Geopotential {
       Square<Length> const& r²,
       Exponentiation<Length, -3> const& one_over_r³) const;
 
+  // Same as above, but for a batch of displacements at the same instant |t|.
+  // The orientation of the body, which is independent from the displacements,
+  // is only computed once.  On return, |accelerations[i]| is the acceleration
+  // corresponding to |r[i]|.
+  void GeneralSphericalHarmonicsAccelerations(
+      Instant const& t,
+      std::vector<Displacement<Frame>> const& r,
+      std::vector<Length> const& r_norm,
+      std::vector<Square<Length>> const& r²,
+      std::vector<Exponentiation<Length, -3>> const& one_over_r³,
+      std::vector<Vector<Quotient<Acceleration, GravitationalParameter>,
+                         Frame>>& accelerations) const;
+
   Quotient<SpecificEnergy, GravitationalParameter>
   GeneralSphericalHarmonicsPotential(
       Instant const& t,
@@ -79,6 +92,12 @@ class Geopotential {
   // Holds precomputed data for one evaluation of the acceleration.
   struct Precomputations;
 
+  // The images of the x and y axes of the surface frame at some instant.
+  struct SurfaceAxes {
+    UnitVector x̂;
+    UnitVector ŷ;
+  };
+
   // Helper templates for iterating over the degrees/orders of the geopotential.
   template<int degree, int order>
   class DegreeNOrderM;
@@ -94,6 +113,45 @@ class Geopotential {
   // |degree_damping_[1].outer_threshold()| are infinite, |limiting_degree > 1|.
   int LimitingDegree(Length const& r_norm) const;
 
+  // Returns true if only the zonal harmonics contribute at distance |r_norm|,
+  // in which case the rotation of the body is of no importance.
+  bool IsZonal(Length const& r_norm) const;
+
+  SurfaceAxes ComputeSurfaceAxes(Instant const& t) const;
+
+  // The type of the functions that compute the contributions of the harmonics
+  // up to some degree, i.e., of |AllDegrees<...>::Acceleration| and
+  // |AllDegrees<...>::Potential|.
+  using AccelerationFunction = Vector<ReducedAcceleration, Frame> (*)(
+      Geopotential const& geopotential,
+      SurfaceAxes const* surface_axes,
+      Displacement<Frame> const& r,
+      Length const& r_norm,
+      Square<Length> const& r²,
+      Exponentiation<Length, -3> const& one_over_r³);
+  using PotentialFunction = ReducedPotential (*)(
+      Geopotential const& geopotential,
+      SurfaceAxes const* surface_axes,
+      Displacement<Frame> const& r,
+      Length const& r_norm,
+      Square<Length> const& r²,
+      Exponentiation<Length, -3> const& one_over_r³);
+
+  // Return the functions for the harmonics of degree at most |max_degree|,
+  // which must be at least 2.  These are looked up in tables instead of being
+  // selected by a switch.
+  static AccelerationFunction AccelerationFunctionForDegree(int max_degree);
+  static PotentialFunction PotentialFunctionForDegree(int max_degree);
+
+  // |surface_axes| must be nonnull unless |IsZonal(r_norm)|.
+  Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
+  GeneralSphericalHarmonicsAcceleration(
+      SurfaceAxes const* surface_axes,
+      Displacement<Frame> const& r,
+      Length const& r_norm,
+      Square<Length> const& r²,
+      Exponentiation<Length, -3> const& one_over_r³) const;
+
   not_null<OblateBody<Frame> const*> body_;
 
   // The contribution from the harmonics of degree n is damped by
@@ -109,6 +167,11 @@ class Geopotential {
   //   degree_damping[2] ≼ sectoral_damping_ ≼ degree_damping[3]
   // holds, where ≼ denotes the ordering of the thresholds.
   HarmonicDamping sectoral_damping_;
+
+  // None of the harmonics contribute beyond this distance, so only the central
+  // force needs to be computed there.  This is the outer threshold of
+  // |degree_damping_[2]|, if it exists.
+  Length central_threshold_;
 };
 
 }  // namespace internal
@@ -3,8 +3,11 @@
 #include "physics/geopotential.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <optional>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #include "base/tags.hpp"
@@ -28,6 +31,14 @@ using namespace principia::quantities::_elementary_functions;
 
 // The notation in this file follows documentation/Geopotential.pdf.
 
+// The highest degree for which the geopotential is compiled.  The bodies are
+// truncated to this degree when the solar system is loaded.
+#if PRINCIPIA_GEOPOTENTIAL_MAX_DEGREE_50
+constexpr int max_compiled_degree = 50;
+#else
+constexpr int max_compiled_degree = 30;
+#endif
+
 template<typename Frame>
 struct Geopotential<Frame>::Precomputations {
   // Allocate the maximum size to cover all possible degrees.  Making |size| a
@@ -101,7 +112,7 @@ template<int... degrees>
 class Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>> {
  public:
   static auto Acceleration(Geopotential<Frame> const& geopotential,
-                           Instant const& t,
+                           SurfaceAxes const* surface_axes,
                            Displacement<Frame> const& r,
                            Length const& r_norm,
                            Square<Length> const& r²,
@@ -109,7 +120,7 @@ class Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>> {
       -> Vector<ReducedAcceleration, Frame>;
 
   static auto Potential(Geopotential<Frame> const& geopotential,
-                        Instant const& t,
+                        SurfaceAxes const* surface_axes,
                         Displacement<Frame> const& r,
                         Length const& r_norm,
                         Square<Length> const& r²,
@@ -119,7 +130,7 @@ class Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>> {
  private:
   static void InitializePrecomputations(
       Geopotential<Frame> const& geopotential,
-      Instant const& t,
+      SurfaceAxes const* surface_axes,
       Displacement<Frame> const& r,
       Length const& r_norm,
       Square<Length> const& r²,
@@ -502,21 +513,18 @@ template<typename Frame>
 template<int... degrees>
 auto Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>>::
 Acceleration(Geopotential<Frame> const& geopotential,
-             Instant const& t,
+             SurfaceAxes const* const surface_axes,
              Displacement<Frame> const& r,
              Length const& r_norm,
              Square<Length> const& r²,
              Exponentiation<Length, -3> const& one_over_r³)
     -> Vector<ReducedAcceleration, Frame> {
   constexpr int size = sizeof...(degrees);
-  OblateBody<Frame> const& body = *geopotential.body_;
-  const bool is_zonal =
-      body.is_zonal() ||
-      r_norm > geopotential.sectoral_damping_.outer_threshold();
+  const bool is_zonal = geopotential.IsZonal(r_norm);
 
   Precomputations precomputations;
   InitializePrecomputations(
-      geopotential, t, r, r_norm, r², one_over_r³, precomputations);
+      geopotential, surface_axes, r, r_norm, r², one_over_r³, precomputations);
 
   // Force the evaluation by increasing degree using an initializer list.  In
   // the zonal case, no point in going beyond order 0.
@@ -539,21 +547,18 @@ template<typename Frame>
 template<int... degrees>
 auto Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>>::
 Potential(Geopotential<Frame> const& geopotential,
-          Instant const& t,
+          SurfaceAxes const* const surface_axes,
           Displacement<Frame> const& r,
           Length const& r_norm,
           Square<Length> const& r²,
           Exponentiation<Length, -3> const& one_over_r³)
     -> ReducedPotential {
   constexpr int size = sizeof...(degrees);
-  OblateBody<Frame> const& body = *geopotential.body_;
-  const bool is_zonal =
-      body.is_zonal() ||
-      r_norm > geopotential.sectoral_damping_.outer_threshold();
+  const bool is_zonal = geopotential.IsZonal(r_norm);
 
   Precomputations precomputations;
   InitializePrecomputations(
-      geopotential, t, r, r_norm, r², one_over_r³, precomputations);
+      geopotential, surface_axes, r, r_norm, r², one_over_r³, precomputations);
 
   // Force the evaluation by increasing degree using an initializer list.  In
   // the zonal case, no point in going beyond order 0.
@@ -576,16 +581,14 @@ template<typename Frame>
 template<int... degrees>
 void Geopotential<Frame>::AllDegrees<std::integer_sequence<int, degrees...>>::
 InitializePrecomputations(Geopotential<Frame> const& geopotential,
-                          Instant const& t,
+                          SurfaceAxes const* const surface_axes,
                           Displacement<Frame> const& r,
                           Length const& r_norm,
                           Square<Length> const& r²,
                           Exponentiation<Length, -3> const& one_over_r³,
                           Precomputations& precomputations) {
   OblateBody<Frame> const& body = *geopotential.body_;
-  const bool is_zonal =
-      body.is_zonal() ||
-      r_norm > geopotential.sectoral_damping_.outer_threshold();
+  const bool is_zonal = geopotential.IsZonal(r_norm);
 
   precomputations.r_norm = r_norm;
   precomputations.r² = r²;
@@ -618,10 +621,8 @@ InitializePrecomputations(Geopotential<Frame> const& geopotential,
     x̂ = body.equatorial();
     ŷ = body.biequatorial();
   } else {
-    auto const from_surface_frame =
-      body.template FromSurfaceFrame<SurfaceFrame>(t);
-    x̂ = from_surface_frame(x_);
-    ŷ = from_surface_frame(y_);
+    x̂ = surface_axes->x̂;
+    ŷ = surface_axes->ŷ;
   }
 
   Length const x = InnerProduct(r, x̂);
@@ -689,9 +690,10 @@ Geopotential<Frame>::Geopotential(not_null<OblateBody<Frame> const*> body,
            (left.r == right.r &&
             (left.m < right.m || (left.m == right.m && left.n < right.n)));
   };
-  std::priority_queue<Threshold, std::vector<Threshold>, decltype(after)>
-      harmonic_thresholds(after);
-  for (int n = 2; n <= body_->geopotential_degree(); ++n) {
+  int const degree = body_->geopotential_degree();
+  std::vector<Threshold> thresholds;
+  thresholds.reserve((degree + 1) * (degree + 2) / 2);
+  for (int n = 2; n <= degree; ++n) {
     for (int m = 0; m <= n; ++m) {
       double const max_abs_Pnm =
           MaxAbsNormalizedAssociatedLegendreFunction(n, m);
@@ -705,12 +707,15 @@ Geopotential<Frame>::Geopotential(not_null<OblateBody<Frame> const*> body,
                                            Sqrt(Pow<2>(Cnm) + Pow<2>(Snm))) /
                                               ε,
                                           1.0 / n);
-      harmonic_thresholds.push({r, n, m});
+      thresholds.push_back({r, n, m});
     }
   }
+  thresholds.push_back({Infinity<Length>, 0, 0});
+  thresholds.push_back({Infinity<Length>, 1, 0});
 
-  harmonic_thresholds.push({Infinity<Length>, 0, 0});
-  harmonic_thresholds.push({Infinity<Length>, 1, 0});
+  // Heapify all the thresholds at once, which is linear in their number.
+  std::priority_queue<Threshold, std::vector<Threshold>, decltype(after)>
+      harmonic_thresholds(after, std::move(thresholds));
 
   while (!harmonic_thresholds.empty()) {
     auto const& threshold = harmonic_thresholds.top();
@@ -730,12 +735,12 @@ Geopotential<Frame>::Geopotential(not_null<OblateBody<Frame> const*> body,
     }
     harmonic_thresholds.pop();
   }
-}
 
-#define PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(d)                     \
-  case (d):                                                                    \
-    return AllDegrees<std::make_integer_sequence<int, (d) + 1>>::Acceleration( \
-        *this, t, r, r_norm, r², one_over_r³)
+  // Beyond the threshold of J2 none of the harmonics contribute.
+  central_threshold_ = degree_damping_.size() > 2
+                           ? degree_damping_[2].outer_threshold()
+                           : Length{};
+}
 
 template<typename Frame>
 Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
@@ -745,80 +750,65 @@ Geopotential<Frame>::GeneralSphericalHarmonicsAcceleration(
     Length const& r_norm,
     Square<Length> const& r²,
     Exponentiation<Length, -3> const& one_over_r³) const {
+  if (IsZonal(r_norm)) {
+    return GeneralSphericalHarmonicsAcceleration(
+        /*surface_axes=*/nullptr, r, r_norm, r², one_over_r³);
+  } else {
+    SurfaceAxes const surface_axes = ComputeSurfaceAxes(t);
+    return GeneralSphericalHarmonicsAcceleration(
+        &surface_axes, r, r_norm, r², one_over_r³);
+  }
+}
+
+template<typename Frame>
+void Geopotential<Frame>::GeneralSphericalHarmonicsAccelerations(
+    Instant const& t,
+    std::vector<Displacement<Frame>> const& r,
+    std::vector<Length> const& r_norm,
+    std::vector<Square<Length>> const& r²,
+    std::vector<Exponentiation<Length, -3>> const& one_over_r³,
+    std::vector<Vector<Quotient<Acceleration, GravitationalParameter>,
+                       Frame>>& accelerations) const {
+  std::size_t const size = r.size();
+  CHECK_EQ(size, r_norm.size());
+  CHECK_EQ(size, r².size());
+  CHECK_EQ(size, one_over_r³.size());
+  accelerations.resize(size);
+
+  // Only compute the orientation of the body if some displacement needs it.
+  std::optional<SurfaceAxes> surface_axes;
+  for (std::size_t i = 0; i < size; ++i) {
+    if (!surface_axes.has_value() && !IsZonal(r_norm[i])) {
+      surface_axes = ComputeSurfaceAxes(t);
+    }
+    accelerations[i] = GeneralSphericalHarmonicsAcceleration(
+        surface_axes.has_value() ? &*surface_axes : nullptr,
+        r[i], r_norm[i], r²[i], one_over_r³[i]);
+  }
+}
+
+template<typename Frame>
+Vector<Quotient<Acceleration, GravitationalParameter>, Frame>
+Geopotential<Frame>::GeneralSphericalHarmonicsAcceleration(
+    SurfaceAxes const* const surface_axes,
+    Displacement<Frame> const& r,
+    Length const& r_norm,
+    Square<Length> const& r²,
+    Exponentiation<Length, -3> const& one_over_r³) const {
   if (r_norm != r_norm) {
     // Short-circuit NaN, to avoid having to deal with an unordered
     // |r_norm| when finding the partition point below.
     return NaN<ReducedAcceleration> * Vector<double, Frame>{};
   }
-  // We have |max_degree > 0|.
-  int const max_degree = LimitingDegree(r_norm) - 1;
-  switch (max_degree) {
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(2);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(3);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(4);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(5);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(6);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(7);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(8);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(9);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(10);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(11);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(12);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(13);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(14);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(15);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(16);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(17);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(18);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(19);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(20);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(21);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(22);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(23);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(24);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(25);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(26);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(27);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(28);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(29);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(30);
-#if PRINCIPIA_GEOPOTENTIAL_MAX_DEGREE_50
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(31);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(32);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(33);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(34);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(35);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(36);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(37);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(38);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(39);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(40);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(41);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(42);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(43);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(44);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(45);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(46);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(47);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(48);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(49);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION(50);
-#endif
-    case 1:
-      return Vector<ReducedAcceleration, Frame>{};
-    default:
-      LOG(FATAL) << "Unexpected degree " << max_degree << " " << body_->name();
-      base::noreturn();
+  if (r_norm >= central_threshold_) {
+    return Vector<ReducedAcceleration, Frame>{};
   }
+  // We have |max_degree > 1|.
+  int const max_degree = LimitingDegree(r_norm) - 1;
+  return AccelerationFunctionForDegree(max_degree)(
+      *this, surface_axes, r, r_norm, r², one_over_r³);
 }
 
-#undef PRINCIPIA_CASE_SPHERICAL_HARMONICS_ACCELERATION
-
-#define PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(d)                     \
-  case (d):                                                                 \
-    return AllDegrees<std::make_integer_sequence<int, (d) + 1>>::Potential( \
-        *this, t, r, r_norm, r², one_over_r³)
-
 template<typename Frame>
 Quotient<SpecificEnergy, GravitationalParameter>
 Geopotential<Frame>::GeneralSphericalHarmonicsPotential(
@@ -832,70 +822,21 @@ Geopotential<Frame>::GeneralSphericalHarmonicsPotential(
     // |r_norm| when finding the partition point below.
     return NaN<ReducedPotential>;
   }
-  // We have |max_degree > 0|.
-  int const max_degree = LimitingDegree(r_norm) - 1;
-  switch (max_degree) {
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(2);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(3);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(4);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(5);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(6);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(7);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(8);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(9);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(10);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(11);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(12);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(13);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(14);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(15);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(16);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(17);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(18);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(19);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(20);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(21);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(22);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(23);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(24);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(25);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(26);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(27);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(28);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(29);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(30);
-#if PRINCIPIA_GEOPOTENTIAL_MAX_DEGREE_50
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(31);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(32);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(33);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(34);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(35);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(36);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(37);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(38);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(39);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(40);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(41);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(42);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(43);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(44);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(45);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(46);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(47);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(48);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(49);
-    PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL(50);
-#endif
-    case 1:
-      return ReducedPotential{};
-    default:
-      LOG(FATAL) << "Unexpected degree " << max_degree << " " << body_->name();
-      base::noreturn();
+  if (r_norm >= central_threshold_) {
+    return ReducedPotential{};
   }
+  SurfaceAxes nonzonal_surface_axes;
+  SurfaceAxes const* surface_axes = nullptr;
+  if (!IsZonal(r_norm)) {
+    nonzonal_surface_axes = ComputeSurfaceAxes(t);
+    surface_axes = &nonzonal_surface_axes;
+  }
+  // We have |max_degree > 1|.
+  int const max_degree = LimitingDegree(r_norm) - 1;
+  return PotentialFunctionForDegree(max_degree)(
+      *this, surface_axes, r, r_norm, r², one_over_r³);
 }
 
-#undef PRINCIPIA_CASE_SPHERICAL_HARMONICS_POTENTIAL
-
 template<typename Frame>
 std::vector<HarmonicDamping> const& Geopotential<Frame>::degree_damping()
     const {
@@ -921,6 +862,49 @@ int Geopotential<Frame>::LimitingDegree(Length const& r_norm) const {
          degree_damping_.begin();
 }
 
+template<typename Frame>
+auto Geopotential<Frame>::AccelerationFunctionForDegree(int const max_degree)
+    -> AccelerationFunction {
+  // A table indexed by |max_degree - 2|, built at compile time.
+  static constexpr auto functions =
+      []<int... degrees>(std::integer_sequence<int, degrees...>) {
+        return std::array<AccelerationFunction, sizeof...(degrees)>{
+            &AllDegrees<std::make_integer_sequence<int, degrees + 3>>::
+                Acceleration...};
+      }(std::make_integer_sequence<int, max_compiled_degree - 1>());
+  CHECK_LE(2, max_degree);
+  CHECK_LE(max_degree, max_compiled_degree) << "Unexpected degree";
+  return functions[max_degree - 2];
+}
+
+template<typename Frame>
+auto Geopotential<Frame>::PotentialFunctionForDegree(int const max_degree)
+    -> PotentialFunction {
+  // A table indexed by |max_degree - 2|, built at compile time.
+  static constexpr auto functions =
+      []<int... degrees>(std::integer_sequence<int, degrees...>) {
+        return std::array<PotentialFunction, sizeof...(degrees)>{
+            &AllDegrees<std::make_integer_sequence<int, degrees + 3>>::
+                Potential...};
+      }(std::make_integer_sequence<int, max_compiled_degree - 1>());
+  CHECK_LE(2, max_degree);
+  CHECK_LE(max_degree, max_compiled_degree) << "Unexpected degree";
+  return functions[max_degree - 2];
+}
+
+template<typename Frame>
+bool Geopotential<Frame>::IsZonal(Length const& r_norm) const {
+  return body_->is_zonal() || r_norm > sectoral_damping_.outer_threshold();
+}
+
+template<typename Frame>
+auto Geopotential<Frame>::ComputeSurfaceAxes(Instant const& t) const
+    -> SurfaceAxes {
+  auto const from_surface_frame =
+      body_->template FromSurfaceFrame<SurfaceFrame>(t);
+  return {.x̂ = from_surface_frame(x_), .ŷ = from_surface_frame(y_)};
+}
+
 template<typename Frame>
 const Vector<double, typename Geopotential<Frame>::SurfaceFrame>
     Geopotential<Frame>::x_({1, 0, 0});
@@ -214,6 +214,32 @@ TEST_F(GeopotentialTest, J2) {
   }
 }
 
+TEST_F(GeopotentialTest, CentralThreshold) {
+  OblateBody<World> const body =
+      OblateBody<World>(massive_body_parameters_,
+                        rotating_body_parameters_,
+                        OblateBody<World>::Parameters(/*j2=*/6, 1 * Metre));
+  Geopotential<World> const geopotential(&body, /*tolerance=*/0x1p-24);
+  Length const threshold = geopotential.degree_damping()[2].outer_threshold();
+
+  // Just inside the threshold of J2 there is a (damped) contribution, just
+  // outside there is none.
+  Displacement<World> const inside({0 * Metre, 0.99 * threshold, 0 * Metre});
+  Displacement<World> const outside({0 * Metre, 1.01 * threshold, 0 * Metre});
+  EXPECT_THAT(GeneralSphericalHarmonicsAcceleration(
+                  geopotential, Instant(), inside).Norm(),
+              Gt(0 * Pow<-2>(Metre)));
+  EXPECT_EQ((Vector<Exponentiation<Length, -2>, World>{}),
+            GeneralSphericalHarmonicsAcceleration(
+                geopotential, Instant(), outside));
+  EXPECT_THAT(GeneralSphericalHarmonicsPotential(
+                  geopotential, Instant(), inside),
+              Lt(0 * Pow<-1>(Metre)));
+  EXPECT_EQ(Inverse<Length>{},
+            GeneralSphericalHarmonicsPotential(
+                geopotential, Instant(), outside));
+}
+
 TEST_F(GeopotentialTest, C22S22) {
   serialization::OblateBody::Geopotential message;
   {
@@ -262,6 +288,65 @@ TEST_F(GeopotentialTest, C22S22) {
   }
 }
 
+TEST_F(GeopotentialTest, Batched) {
+  serialization::OblateBody::Geopotential message;
+  {
+    auto* const degree2 = message.add_row();
+    degree2->set_degree(2);
+    auto* const order0 = degree2->add_column();
+    order0->set_order(0);
+    order0->set_cos(-6 / LegendreNormalizationFactor(2, 0));
+    order0->set_sin(0);
+    auto* const order2 = degree2->add_column();
+    order2->set_order(2);
+    order2->set_cos(10 / LegendreNormalizationFactor(2, 2));
+    order2->set_sin(-13 / LegendreNormalizationFactor(2, 2));
+  }
+  {
+    auto* const degree3 = message.add_row();
+    degree3->set_degree(3);
+    auto* const order1 = degree3->add_column();
+    order1->set_order(1);
+    order1->set_cos(3 / LegendreNormalizationFactor(3, 1));
+    order1->set_sin(7 / LegendreNormalizationFactor(3, 1));
+  }
+  OblateBody<World> const body =
+      OblateBody<World>(massive_body_parameters_,
+                        rotating_body_parameters_,
+                        OblateBody<World>::Parameters::ReadFromMessage(
+                            message, 1 * Metre));
+  // A nonzero tolerance to have displacements on both sides of the sectoral
+  // threshold.
+  Geopotential<World> const geopotential(&body, /*tolerance=*/0x1p-24);
+
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1e4, 1e4);
+  std::vector<Displacement<World>> r;
+  std::vector<Length> r_norm;
+  std::vector<Square<Length>> r²;
+  std::vector<Exponentiation<Length, -3>> one_over_r³;
+  for (int i = 0; i < 100; ++i) {
+    double const scale = std::pow(10.0, i % 5 - 3);
+    r.push_back(Displacement<World>({scale * distribution(random) * Metre,
+                                     scale * distribution(random) * Metre,
+                                     scale * distribution(random) * Metre}));
+    r².push_back(r.back().Norm²());
+    r_norm.push_back(Sqrt(r².back()));
+    one_over_r³.push_back(r_norm.back() / (r².back() * r².back()));
+  }
+
+  Instant const t = Instant() + 17 * Second;
+  std::vector<Vector<Quotient<Acceleration, GravitationalParameter>, World>>
+      accelerations;
+  geopotential.GeneralSphericalHarmonicsAccelerations(
+      t, r, r_norm, r², one_over_r³, accelerations);
+  ASSERT_EQ(r.size(), accelerations.size());
+  for (int i = 0; i < r.size(); ++i) {
+    EXPECT_EQ(GeneralSphericalHarmonicsAcceleration(geopotential, t, r[i]),
+              accelerations[i]) << i;
+  }
+}
+
 TEST_F(GeopotentialTest, J3) {
   serialization::OblateBody::Geopotential message;
   {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "geometry/grassmann.hpp"
 #include "numerics/polynomial_evaluators.hpp"
 #include "numerics/polynomial_in_monomial_basis.hpp"
@@ -50,6 +52,16 @@ class HarmonicDamping final {
                                      Inverse<Square<Length>> const& ℜ_over_r,
                                      Inverse<Square<Length>>& σℜ_over_r) const;
 
+  // Computes σ(r) and r σ′(r) for each of the radii in |r_norm|.  Unlike the
+  // functions above, this function accepts radii above the outer threshold, for
+  // which σ = 0.  The radii are not classified by branching but by selecting the
+  // appropriate result, so that the loop may be vectorized; the values for radii
+  // below the inner threshold (resp. above the outer threshold) are exactly
+  // those of the functions above.  |σ| and |σʹr| are resized as needed.
+  void ComputeSigmoids(std::vector<Length> const& r_norm,
+                       std::vector<double>& σ,
+                       std::vector<double>& σʹr) const;
+
  private:
   Length outer_threshold_ = Infinity<Length>;
   Length inner_threshold_ = Infinity<Length>;
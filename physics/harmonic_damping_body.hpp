@@ -2,6 +2,9 @@
 
 #include "physics/harmonic_damping.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include "quantities/elementary_functions.hpp"
 
 namespace principia {
@@ -86,6 +89,35 @@ inline void HarmonicDamping::ComputeDampedRadialQuantities(
   }
 }
 
+inline void HarmonicDamping::ComputeSigmoids(
+    std::vector<Length> const& r_norm,
+    std::vector<double>& σ,
+    std::vector<double>& σʹr) const {
+  σ.resize(r_norm.size());
+  σʹr.resize(r_norm.size());
+  Length const& s0 = inner_threshold_;
+  Length const& s1 = outer_threshold_;
+  auto const& c = sigmoid_coefficients_;
+  Derivative<double, Length> const c1 = std::get<1>(c);
+  Derivative<double, Length, 2> const c2 = std::get<2>(c);
+  Derivative<double, Length, 3> const c3 = std::get<3>(c);
+  for (std::size_t i = 0; i < r_norm.size(); ++i) {
+    Length const r = r_norm[i];
+    // In the transition region, same computation as above.  Outside of it, the
+    // result is discarded; clamping avoids computing infinities.
+    Length const clamped_r = std::clamp(r, s0, s1);
+    Square<Length> const r² = clamped_r * clamped_r;
+    auto const r³ = r² * clamped_r;
+    double const c3r³ = c3 * r³;
+    double const c2r² = c2 * r²;
+    double const c1r = c1 * clamped_r;
+    double const transition_σ = c3r³ + c2r² + c1r;
+    double const transition_σʹr = 3 * c3r³ + 2 * c2r² + c1r;
+    σ[i] = r <= s0 ? 1 : r >= s1 ? 0 : transition_σ;
+    σʹr[i] = r <= s0 || r >= s1 ? 0 : transition_σʹr;
+  }
+}
+
 }  // namespace internal
 }  // namespace _harmonic_damping
 }  // namespace physics
@@ -1,5 +1,7 @@
 #include "physics/harmonic_damping.hpp"
 
+#include <vector>
+
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "gmock/gmock.h"
@@ -72,5 +74,41 @@ TEST_F(HarmonicDampingTest, AccelerationQuantities) {
   }
 }
 
+TEST_F(HarmonicDampingTest, Sigmoids) {
+  HarmonicDamping σ(1 * Metre);
+  Vector<double, World> x({1, 0, 0});
+  Inverse<Square<Length>> const ℜ_over_r = 1 / Pow<2>(Metre);
+  Inverse<Square<Length>> const ℜʹ = 0 / Pow<2>(Metre);
+  std::vector<Length> const radii = {0.5 * Metre,
+                                     1 * Metre,
+                                     1.5 * Metre,
+                                     2 * Metre,
+                                     2.9 * Metre,
+                                     3 * Metre,
+                                     10 * Metre};
+  std::vector<double> σs;
+  std::vector<double> σʹrs;
+  σ.ComputeSigmoids(radii, σs, σʹrs);
+  ASSERT_EQ(radii.size(), σs.size());
+  ASSERT_EQ(radii.size(), σʹrs.size());
+  for (int i = 0; i < radii.size(); ++i) {
+    Length const& r = radii[i];
+    if (r >= σ.outer_threshold()) {
+      EXPECT_THAT(σs[i], Eq(0));
+      EXPECT_THAT(σʹrs[i], Eq(0));
+      continue;
+    }
+    // With ℜ = r and ℜʹ = 0, the scalar function returns σ and σʹ r.
+    Inverse<Square<Length>> σℜ_over_r;
+    Vector<Inverse<Square<Length>>, World> grad_σℜ;
+    σ.ComputeDampedRadialQuantities(
+        r, r * r, x, ℜ_over_r, ℜʹ, σℜ_over_r, grad_σℜ);
+    EXPECT_THAT(σs[i], Eq(σℜ_over_r * Pow<2>(Metre))) << r;
+    EXPECT_THAT(σʹrs[i], Eq(grad_σℜ.coordinates().x * Pow<2>(Metre))) << r;
+  }
+  EXPECT_THAT(σs[1], Eq(1));
+  EXPECT_THAT(σs[3], Eq(0.5));
+}
+
 }  // namespace physics
 }  // namespace principia
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -50,9 +51,29 @@ class LagrangeEquipotentials {
     std::map<SpecificEnergy, Position<RotatingPulsating>> maxima;
   };
 
-  absl::StatusOr<Equipotentials> ComputeLines(Parameters const& parameters);
+  using Lines = typename Equipotential<Inertial, RotatingPulsating>::Lines;
+  using LinesCallback =
+      std::function<void(SpecificEnergy const& energy, Lines lines)>;
+
+  // The lines for the different energy levels are computed in parallel.  If
+  // |lines_callback| is not null, it is called with the lines of each energy
+  // level as soon as they have been computed, in no particular order, and the
+  // |lines| of the result are empty.  The calls may happen on other threads,
+  // but they are never concurrent.
+  absl::StatusOr<Equipotentials> ComputeLines(
+      Parameters const& parameters,
+      LinesCallback const& lines_callback = nullptr);
 
  private:
+  // Samples |potential| on a regular grid covering the box where the maxima
+  // are looked for, and returns the nodes where it is maximal among their
+  // neighbours, each refined by a few levels of quadtree subdivision around
+  // it.  These are coarse candidates for the maxima of |potential|, suitable as
+  // starting points for local searches.
+  static std::vector<Position<RotatingPulsating>> CoarseMaxima(
+      std::function<SpecificEnergy(Position<RotatingPulsating> const&)> const&
+          potential);
+
   not_null<Ephemeris<Inertial> const*> const ephemeris_;
 };
 
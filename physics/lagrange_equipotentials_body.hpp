@@ -1,17 +1,25 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
+#include <future>
+#include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "physics/lagrange_equipotentials.hpp"
+#include "absl/synchronization/mutex.h"
+#include "base/jthread.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/plane.hpp"
 #include "integrators/embedded_explicit_runge_kutta_integrator.hpp"
 #include "integrators/methods.hpp"
 #include "numerics/global_optimization.hpp"
+#include "numerics/gradient_descent.hpp"
 #include "numerics/root_finders.hpp"
 #include "physics/rotating_pulsating_reference_frame.hpp"
 #include "quantities/elementary_functions.hpp"
@@ -23,12 +31,15 @@ namespace physics {
 namespace _lagrange_equipotentials {
 namespace internal {
 
+using namespace principia::base::_jthread;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_barycentre_calculator;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_plane;
 using namespace principia::integrators::_embedded_explicit_runge_kutta_integrator;  // NOLINT
 using namespace principia::integrators::_methods;
 using namespace principia::numerics::_global_optimization;
+using namespace principia::numerics::_gradient_descent;
 using namespace principia::numerics::_root_finders;
 using namespace principia::physics::_rotating_pulsating_reference_frame;
 using namespace principia::quantities::_elementary_functions;
@@ -46,6 +57,11 @@ constexpr Length characteristic_length = 1 * Nano(Metre);
 constexpr std::int64_t max_steps = 1000;
 constexpr std::int64_t points_per_round = 1000;
 constexpr Length local_search_tolerance = 1e-3 * Metre;
+// The coarse grid has a spacing of about 0.09 m, which resolves the ridge of
+// L₄/L₅ well; the refinements bring the candidate maxima within about 6 mm of
+// the actual ones.
+constexpr int grid_divisions = 64;
+constexpr int grid_refinements = 4;
 
 template<typename Inertial, typename RotatingPulsating>
 LagrangeEquipotentials<Inertial, RotatingPulsating>::LagrangeEquipotentials(
@@ -56,7 +72,9 @@ template<typename Inertial, typename RotatingPulsating>
 absl::StatusOr<typename LagrangeEquipotentials<Inertial, RotatingPulsating>::
                    Equipotentials>
 LagrangeEquipotentials<Inertial, RotatingPulsating>::ComputeLines(
-    Parameters const& parameters) {
+    Parameters const& parameters,
+    LinesCallback const& lines_callback) {
+  using namespace std::chrono_literals;
   Equipotentials result;
   Instant const& t = parameters.time;
 
@@ -98,14 +116,50 @@ LagrangeEquipotentials<Inertial, RotatingPulsating>::ComputeLines(
       &reference_frame,
       characteristic_length);
 
+  // At time |t| the potential is a static field in the plane.  A coarse
+  // sampling of that field yields candidate maxima, and the exact potential and
+  // its gradient are then only evaluated by local searches started from these
+  // candidates.  If that fails, we fall back to a global optimization.
   // TODO(phl): Make this interruptible.
-  auto const arg_maximorum =
-      MultiLevelSingleLinkage<SpecificEnergy, Position<RotatingPulsating>, 2>(
-          box, potential, gradient)
-          .FindGlobalMaxima(
-              points_per_round,
-              /*number_of_rounds=*/std::nullopt,
-              local_search_tolerance);
+  auto const minus_potential =
+      [&potential](Position<RotatingPulsating> const& position) {
+    return -potential(position);
+  };
+  auto const minus_gradient =
+      [&gradient](Position<RotatingPulsating> const& position) {
+    return -gradient(position);
+  };
+  std::vector<Position<RotatingPulsating>> arg_maximorum;
+  for (auto const& candidate : CoarseMaxima(potential)) {
+    auto const arg_maximum =
+        BroydenFletcherGoldfarbShanno<SpecificEnergy,
+                                      Position<RotatingPulsating>>(
+            candidate,
+            minus_potential,
+            minus_gradient,
+            local_search_tolerance,
+            /*radius=*/2 * box_side / grid_divisions);
+    if (!arg_maximum.ok()) {
+      continue;
+    }
+    if (std::none_of(arg_maximorum.begin(),
+                     arg_maximorum.end(),
+                     [&arg_maximum](Position<RotatingPulsating> const& q) {
+                       return (*arg_maximum - q).Norm() <=
+                              local_search_tolerance;
+                     })) {
+      arg_maximorum.push_back(*arg_maximum);
+    }
+  }
+  if (arg_maximorum.empty()) {
+    arg_maximorum =
+        MultiLevelSingleLinkage<SpecificEnergy, Position<RotatingPulsating>, 2>(
+            box, potential, gradient)
+            .FindGlobalMaxima(
+                points_per_round,
+                /*number_of_rounds=*/std::nullopt,
+                local_search_tolerance);
+  }
   SpecificEnergy maximum_maximorum = -Infinity<SpecificEnergy>;
   for (auto const& arg_maximum : arg_maximorum) {
     auto const maximum = potential(arg_maximum);
@@ -224,21 +278,137 @@ LagrangeEquipotentials<Inertial, RotatingPulsating>::ComputeLines(
     return RotatingPulsating::origin +
            Normalize(q - RotatingPulsating::origin) * box_side;
   };
+  std::vector<SpecificEnergy> energies;
   for (int i = 1; i <= parameters.levels; ++i) {
-    RETURN_IF_STOPPED;
-    SpecificEnergy const energy =
-        maximum_maximorum - i * (1.0 / parameters.l1_level *
-                                 (maximum_maximorum - approx_l1_energy));
-    // TODO(phl): Make this interruptible.
-    auto lines = equipotential.ComputeLines(
-        plane, t, arg_maximorum, wells, towards_infinity, energy);
-    result.lines.emplace(energy, std::move(lines));
+    energies.push_back(maximum_maximorum -
+                       i * (1.0 / parameters.l1_level *
+                            (maximum_maximorum - approx_l1_energy)));
   }
   if (parameters.show_l245_level) {
-    for (SpecificEnergy const energy : {approx_l2_energy, l45_separator}) {
-      auto lines = equipotential.ComputeLines(
-          plane, t, arg_maximorum, wells, towards_infinity, energy);
-      result.lines.emplace(energy, std::move(lines));
+    energies.push_back(approx_l2_energy);
+    energies.push_back(l45_separator);
+  }
+
+  // The lines for the different energies are independent, so they are
+  // computed in parallel.  Each of them is an integration that takes a while,
+  // so we don't mind creating a pool for each call.
+  absl::Mutex lock;
+  std::int64_t const concurrency =
+      std::max(1u, std::thread::hardware_concurrency());
+  ThreadPool<void> pool(std::min<std::int64_t>(energies.size(), concurrency));
+  // If there are fewer energies than cores, the remaining cores are used to
+  // speculatively compute lines within each energy.  This must be a separate
+  // pool as the tasks of |pool| wait for those of |line_pool|.
+  std::unique_ptr<ThreadPool<void>> const line_pool =
+      energies.size() < concurrency
+          ? std::make_unique<ThreadPool<void>>(concurrency - energies.size())
+          : nullptr;
+  std::vector<std::unique_ptr<StoppableTask>> tasks;
+  std::vector<std::future<void>> futures;
+  for (SpecificEnergy const& energy : energies) {
+    auto const& task = tasks.emplace_back(std::make_unique<StoppableTask>());
+    futures.push_back(pool.Add([&, &task = *task, energy]() {
+      task.Run([&]() {
+        if (this_stoppable_thread::get_stop_token().stop_requested()) {
+          return;
+        }
+        // TODO(phl): Make this interruptible.
+        auto lines = equipotential.ComputeLines(plane,
+                                                t,
+                                                arg_maximorum,
+                                                wells,
+                                                towards_infinity,
+                                                energy,
+                                                line_pool.get());
+        absl::MutexLock l(&lock);
+        if (lines_callback == nullptr) {
+          result.lines.emplace(energy, std::move(lines));
+        } else {
+          lines_callback(energy, std::move(lines));
+        }
+      });
+    }));
+  }
+
+  // Wait for the tasks, propagating a stop request to them.
+  bool stopped = false;
+  for (auto& future : futures) {
+    while (future.wait_for(20ms) != std::future_status::ready) {
+      if (!stopped &&
+          this_stoppable_thread::get_stop_token().stop_requested()) {
+        stopped = true;
+        for (auto const& task : tasks) {
+          task->request_stop();
+        }
+      }
+    }
+  }
+  RETURN_IF_STOPPED;
+  return result;
+}
+
+template<typename Inertial, typename RotatingPulsating>
+std::vector<Position<RotatingPulsating>>
+LagrangeEquipotentials<Inertial, RotatingPulsating>::CoarseMaxima(
+    std::function<SpecificEnergy(Position<RotatingPulsating> const&)> const&
+        potential) {
+  // The grid covers the same square as the |box| of |ComputeLines|.
+  Length const spacing = 2 * box_side / grid_divisions;
+  auto const node = [spacing](int const i, int const j) {
+    return RotatingPulsating::origin +
+           Displacement<RotatingPulsating>({-box_side + i * spacing,
+                                            -box_side + j * spacing,
+                                            0 * Metre});
+  };
+  std::vector<std::vector<SpecificEnergy>> values(
+      grid_divisions + 1, std::vector<SpecificEnergy>(grid_divisions + 1));
+  for (int i = 0; i <= grid_divisions; ++i) {
+    for (int j = 0; j <= grid_divisions; ++j) {
+      values[i][j] = potential(node(i, j));
+    }
+  }
+
+  std::vector<Position<RotatingPulsating>> result;
+  for (int i = 1; i < grid_divisions; ++i) {
+    for (int j = 1; j < grid_divisions; ++j) {
+      SpecificEnergy const& value = values[i][j];
+      if (!IsFinite(value)) {
+        continue;
+      }
+      bool is_maximum = true;
+      for (int di = -1; di <= 1; ++di) {
+        for (int dj = -1; dj <= 1; ++dj) {
+          is_maximum &= values[i + di][j + dj] <= value;
+        }
+      }
+      if (!is_maximum) {
+        continue;
+      }
+      // Subdivide the cells around the candidate, moving it to the best of the
+      // nodes of the finer grid at each level.
+      Position<RotatingPulsating> arg_maximum = node(i, j);
+      SpecificEnergy maximum = value;
+      Length h = spacing;
+      for (int level = 0; level < grid_refinements; ++level) {
+        h /= 2;
+        Position<RotatingPulsating> const centre = arg_maximum;
+        for (int di = -1; di <= 1; ++di) {
+          for (int dj = -1; dj <= 1; ++dj) {
+            if (di == 0 && dj == 0) {
+              continue;
+            }
+            Position<RotatingPulsating> const q =
+                centre +
+                Displacement<RotatingPulsating>({di * h, dj * h, 0 * Metre});
+            SpecificEnergy const potential_q = potential(q);
+            if (potential_q > maximum) {
+              maximum = potential_q;
+              arg_maximum = q;
+            }
+          }
+        }
+      }
+      result.push_back(arg_maximum);
     }
   }
   return result;
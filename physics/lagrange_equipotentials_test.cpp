@@ -1,5 +1,6 @@
 #include "physics/lagrange_equipotentials.hpp"
 
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -33,6 +34,7 @@ namespace physics {
 using ::testing::AllOf;
 using ::testing::Ge;
 using ::testing::Gt;
+using ::testing::IsEmpty;
 using ::testing::Le;
 using ::testing::Lt;
 using ::testing::SizeIs;
@@ -86,6 +88,43 @@ class LagrangeEquipotentialsTest : public ::testing::Test {
 };
 
 #if !_DEBUG
+TEST_F(LagrangeEquipotentialsTest, LinesCallback) {
+  auto const earth = solar_system_->massive_body(
+      *ephemeris_, SolarSystemFactory::name(SolarSystemFactory::Earth));
+  auto const moon = solar_system_->massive_body(
+      *ephemeris_, SolarSystemFactory::name(SolarSystemFactory::Moon));
+  CHECK_OK(ephemeris_->Prolong(t0_));
+  LagrangeEquipotentials<Barycentric, World>::Parameters const parameters{
+      .primaries = {earth}, .secondaries = {moon}, .time = t0_};
+
+  auto const equipotentials =
+      LagrangeEquipotentials<Barycentric, World>(ephemeris_.get())
+          .ComputeLines(parameters);
+  CHECK_OK(equipotentials.status());
+
+  // The callback receives the same lines, and the result doesn't contain them.
+  std::map<SpecificEnergy, std::size_t> number_of_lines;
+  auto const equipotentials_with_callback =
+      LagrangeEquipotentials<Barycentric, World>(ephemeris_.get())
+          .ComputeLines(
+              parameters,
+              [&number_of_lines](
+                  SpecificEnergy const& energy,
+                  LagrangeEquipotentials<Barycentric, World>::Lines lines) {
+                number_of_lines.emplace(energy, lines.size());
+              });
+  CHECK_OK(equipotentials_with_callback.status());
+  EXPECT_THAT(equipotentials_with_callback->lines, IsEmpty());
+  EXPECT_EQ(equipotentials->maxima.size(),
+            equipotentials_with_callback->maxima.size());
+
+  EXPECT_THAT(equipotentials->lines, SizeIs(10));
+  EXPECT_THAT(number_of_lines, SizeIs(10));
+  for (auto const& [energy, lines] : equipotentials->lines) {
+    EXPECT_EQ(lines.size(), number_of_lines[energy]) << energy;
+  }
+}
+
 TEST_F(LagrangeEquipotentialsTest,
        DISABLED_RotatingPulsating_GlobalOptimization) {
   Logger logger(TEMP_DIR / "equipotential_rp_global.wl",
@@ -85,11 +85,13 @@ MechanicalSystem<InertialFrame, SystemFrame>::InertiaTensor() const {
       LinearMotion().Inverse();
   SymmetricBilinearForm<MomentOfInertia, SystemFrame, Vector> result =
       to_system_frame.orthogonal_map()(sum_of_inertia_tensors_);
+  // Only the positions matter here, so don't transform the velocities.
+  RigidTransformation<InertialFrame, SystemFrame> const&
+      to_system_frame_positions = to_system_frame.rigid_transformation();
   for (auto const& [degrees_of_freedom, m] : body_linear_motions_) {
-    DegreesOfFreedom<SystemFrame> const degrees_of_freedom_in_system_frame =
-        to_system_frame(degrees_of_freedom);
     Displacement<SystemFrame> const r =
-        degrees_of_freedom_in_system_frame.position() - SystemFrame::origin;
+        to_system_frame_positions(degrees_of_freedom.position()) -
+        SystemFrame::origin;
     result += m * SymmetricSquare(r);
   }
   return result.Anticommutator();
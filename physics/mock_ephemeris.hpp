@@ -62,7 +62,8 @@ class MockEphemeris : public Ephemeris<Frame> {
                IntrinsicAcceleration intrinsic_acceleration,
                Instant const& t,
                AdaptiveStepParameters const& parameters,
-               std::int64_t max_ephemeris_steps),
+               std::int64_t max_ephemeris_steps,
+               IntegrationStatistics<Time>* statistics),
               (override));
   MOCK_METHOD(
       absl::Status,
@@ -46,6 +46,12 @@ class MockRigidReferenceFrame : public RigidReferenceFrame<InertialFrame,
               MotionOfThisFrame,
               (Instant const& t),
               (const, override));
+
+  // The expectations on |MotionOfThisFrame| don't change for a given time, so
+  // the motion may be cached as it is for the frames defined by celestials.
+  bool MotionIsCacheable() const override {
+    return true;
+  }
 };
 
 }  // namespace internal
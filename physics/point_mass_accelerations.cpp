@@ -0,0 +1,151 @@
+#include "physics/point_mass_accelerations.hpp"
+
+#include <immintrin.h>
+
+#include <cmath>
+
+#include "base/cpu_dispatch.hpp"
+#include "base/macros.hpp"  // 🧙 For PRINCIPIA_COMPILER_MSVC.
+#include "glog/logging.h"
+#include "numerics/fma.hpp"
+
+namespace principia {
+namespace physics {
+namespace _point_mass_accelerations {
+namespace internal {
+
+using namespace principia::base::_cpu_dispatch;
+using namespace principia::numerics::_fma;
+
+// The vectorized kernel uses 256-bit AVX instructions, which are subject to the
+// same VEX-encoding constraints as FMA, see #3019.
+bool CanUseVectorizedPointMassAccelerations() {
+  return CanEmitFMAInstructions &&
+         DispatchedInstructionSet() >= InstructionSet::AVX_FMA;
+}
+
+namespace {
+
+// Adds the accelerations between the point mass |b1| and the point masses
+// [b2_begin, b2_end[ of |point_masses|, performing the same operations in the
+// same order as the |Ephemeris|.
+void AddAccelerationsScalar(std::size_t const b1,
+                            std::size_t const b2_begin,
+                            std::size_t const b2_end,
+                            PointMasses& point_masses) {
+  auto& [x, y, z, μ, ax, ay, az] = point_masses;
+  double const x1 = x[b1];
+  double const y1 = y[b1];
+  double const z1 = z[b1];
+  double const μ1 = μ[b1];
+  for (std::size_t b2 = b2_begin; b2 < b2_end; ++b2) {
+    // A vector from the center of |b2| to the center of |b1|.
+    double const Δx = x1 - x[b2];
+    double const Δy = y1 - y[b2];
+    double const Δz = z1 - z[b2];
+
+    double const Δq² = Δx * Δx + Δy * Δy + Δz * Δz;
+    double const Δq_norm = std::sqrt(Δq²);
+    double const one_over_Δq³ = Δq_norm / (Δq² * Δq²);
+
+    double const μ1_over_Δq³ = μ1 * one_over_Δq³;
+    ax[b2] += Δx * μ1_over_Δq³;
+    ay[b2] += Δy * μ1_over_Δq³;
+    az[b2] += Δz * μ1_over_Δq³;
+
+    double const μ2_over_Δq³ = μ[b2] * one_over_Δq³;
+    ax[b1] -= Δx * μ2_over_Δq³;
+    ay[b1] -= Δy * μ2_over_Δq³;
+    az[b1] -= Δz * μ2_over_Δq³;
+  }
+}
+
+#if PRINCIPIA_COMPILER_MSVC
+double HorizontalSum(__m256d const v) {
+  __m128d const low = _mm_add_pd(_mm256_castpd256_pd128(v),
+                                 _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+}
+#endif
+
+}  // namespace
+
+void PointMasses::resize(std::size_t const size) {
+  x.resize(size);
+  y.resize(size);
+  z.resize(size);
+  μ.resize(size);
+  ax.resize(size);
+  ay.resize(size);
+  az.resize(size);
+}
+
+std::size_t PointMasses::size() const {
+  return x.size();
+}
+
+void ComputePointMassAccelerationsScalar(PointMasses& point_masses) {
+  std::size_t const n = point_masses.size();
+  for (std::size_t b1 = 0; b1 < n; ++b1) {
+    AddAccelerationsScalar(b1, /*b2_begin=*/b1 + 1, /*b2_end=*/n, point_masses);
+  }
+}
+
+void ComputePointMassAccelerationsVectorized(PointMasses& point_masses) {
+  CHECK(CanUseVectorizedPointMassAccelerations());
+#if PRINCIPIA_COMPILER_MSVC
+  auto& [x, y, z, μ, ax, ay, az] = point_masses;
+  std::size_t const n = point_masses.size();
+  for (std::size_t b1 = 0; b1 < n; ++b1) {
+    __m256d const x1 = _mm256_set1_pd(x[b1]);
+    __m256d const y1 = _mm256_set1_pd(y[b1]);
+    __m256d const z1 = _mm256_set1_pd(z[b1]);
+    __m256d const μ1 = _mm256_set1_pd(μ[b1]);
+    __m256d ax1 = _mm256_setzero_pd();
+    __m256d ay1 = _mm256_setzero_pd();
+    __m256d az1 = _mm256_setzero_pd();
+
+    std::size_t b2 = b1 + 1;
+    for (; b2 + 4 <= n; b2 += 4) {
+      __m256d const Δx = _mm256_sub_pd(x1, _mm256_loadu_pd(&x[b2]));
+      __m256d const Δy = _mm256_sub_pd(y1, _mm256_loadu_pd(&y[b2]));
+      __m256d const Δz = _mm256_sub_pd(z1, _mm256_loadu_pd(&z[b2]));
+
+      __m256d const Δq² = _mm256_fmadd_pd(
+          Δz, Δz, _mm256_fmadd_pd(Δy, Δy, _mm256_mul_pd(Δx, Δx)));
+      __m256d const Δq_norm = _mm256_sqrt_pd(Δq²);
+      __m256d const one_over_Δq³ =
+          _mm256_div_pd(Δq_norm, _mm256_mul_pd(Δq², Δq²));
+
+      __m256d const μ1_over_Δq³ = _mm256_mul_pd(μ1, one_over_Δq³);
+      _mm256_storeu_pd(
+          &ax[b2],
+          _mm256_fmadd_pd(Δx, μ1_over_Δq³, _mm256_loadu_pd(&ax[b2])));
+      _mm256_storeu_pd(
+          &ay[b2],
+          _mm256_fmadd_pd(Δy, μ1_over_Δq³, _mm256_loadu_pd(&ay[b2])));
+      _mm256_storeu_pd(
+          &az[b2],
+          _mm256_fmadd_pd(Δz, μ1_over_Δq³, _mm256_loadu_pd(&az[b2])));
+
+      __m256d const μ2_over_Δq³ =
+          _mm256_mul_pd(_mm256_loadu_pd(&μ[b2]), one_over_Δq³);
+      ax1 = _mm256_fnmadd_pd(Δx, μ2_over_Δq³, ax1);
+      ay1 = _mm256_fnmadd_pd(Δy, μ2_over_Δq³, ay1);
+      az1 = _mm256_fnmadd_pd(Δz, μ2_over_Δq³, az1);
+    }
+
+    // The accelerations on |b1| must be accumulated before processing the
+    // remainder, which updates them in place.
+    ax[b1] += HorizontalSum(ax1);
+    ay[b1] += HorizontalSum(ay1);
+    az[b1] += HorizontalSum(az1);
+    AddAccelerationsScalar(b1, /*b2_begin=*/b2, /*b2_end=*/n, point_masses);
+  }
+#endif
+}
+
+}  // namespace internal
+}  // namespace _point_mass_accelerations
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace principia {
+namespace physics {
+namespace _point_mass_accelerations {
+namespace internal {
+
+// A structure-of-arrays staging buffer for the mutual accelerations of point
+// masses.  The quantities are expressed in SI units, and stripped of their
+// dimensions and frames, so that they may be processed by vector instructions.
+// The accelerations are outputs, the other fields are inputs.
+struct PointMasses {
+  // Resizes all the arrays to |size| elements.  The contents of the arrays are
+  // unspecified after this call.
+  void resize(std::size_t size);
+  std::size_t size() const;
+
+  std::vector<double> x;   // Metre.
+  std::vector<double> y;   // Metre.
+  std::vector<double> z;   // Metre.
+  std::vector<double> μ;   // Metre³ / Second².
+  std::vector<double> ax;  // Metre / Second².
+  std::vector<double> ay;  // Metre / Second².
+  std::vector<double> az;  // Metre / Second².
+};
+
+// True if this processor and compiler support the vectorized kernel below, and
+// if the flag |max_instruction_set| doesn't prevent its use.
+bool CanUseVectorizedPointMassAccelerations();
+
+// Adds to the accelerations of |point_masses| the Newtonian accelerations
+// exerted on each point mass by all the others.  The scalar version performs
+// the same operations as
+// |Ephemeris::ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies| and
+// is bit-for-bit identical to it.  The vectorized version uses AVX and FMA
+// and processes 4 pairs at a time; its results may differ in the last bits
+// because of the fused operations and of the order of the summations.  It may
+// only be called if |CanUseVectorizedPointMassAccelerations()| is true.
+void ComputePointMassAccelerationsScalar(PointMasses& point_masses);
+void ComputePointMassAccelerationsVectorized(PointMasses& point_masses);
+
+}  // namespace internal
+
+using internal::CanUseVectorizedPointMassAccelerations;
+using internal::ComputePointMassAccelerationsScalar;
+using internal::ComputePointMassAccelerationsVectorized;
+using internal::PointMasses;
+
+}  // namespace _point_mass_accelerations
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,75 @@
+#include "physics/point_mass_accelerations.hpp"
+
+#include <cmath>
+#include <random>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace physics {
+
+using namespace principia::physics::_point_mass_accelerations;
+
+class PointMassAccelerationsTest : public ::testing::Test {
+ protected:
+  static PointMasses RandomPointMasses(int const size) {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> position_distribution(-1e12, 1e12);
+    std::uniform_real_distribution<double> μ_distribution(1e9, 1e20);
+    PointMasses point_masses;
+    point_masses.resize(size);
+    for (int i = 0; i < size; ++i) {
+      point_masses.x[i] = position_distribution(random);
+      point_masses.y[i] = position_distribution(random);
+      point_masses.z[i] = position_distribution(random);
+      point_masses.μ[i] = μ_distribution(random);
+      point_masses.ax[i] = 0;
+      point_masses.ay[i] = 0;
+      point_masses.az[i] = 0;
+    }
+    return point_masses;
+  }
+};
+
+TEST_F(PointMassAccelerationsTest, TwoBodies) {
+  PointMasses point_masses;
+  point_masses.resize(2);
+  point_masses.x = {0, 2};
+  point_masses.y = {0, 0};
+  point_masses.z = {0, 0};
+  point_masses.μ = {4, 8};
+  point_masses.ax = {1, 0};
+  point_masses.ay = {0, 0};
+  point_masses.az = {0, 0};
+  ComputePointMassAccelerationsScalar(point_masses);
+  // The initial accelerations are preserved.
+  EXPECT_EQ(1 + 2, point_masses.ax[0]);
+  EXPECT_EQ(-1, point_masses.ax[1]);
+  EXPECT_EQ(0, point_masses.ay[0]);
+  EXPECT_EQ(0, point_masses.az[1]);
+}
+
+TEST_F(PointMassAccelerationsTest, VectorizedMatchesScalar) {
+  if (!CanUseVectorizedPointMassAccelerations()) {
+    GTEST_SKIP() << "Vectorized kernel not available";
+  }
+  // An odd number of bodies to exercise the remainder loop.
+  PointMasses scalar = RandomPointMasses(43);
+  PointMasses vectorized = scalar;
+  ComputePointMassAccelerationsScalar(scalar);
+  ComputePointMassAccelerationsVectorized(vectorized);
+  for (int i = 0; i < scalar.size(); ++i) {
+    // The components may suffer from cancellations, so compare them to the
+    // norm of the acceleration.
+    double const norm = std::sqrt(scalar.ax[i] * scalar.ax[i] +
+                                  scalar.ay[i] * scalar.ay[i] +
+                                  scalar.az[i] * scalar.az[i]);
+    EXPECT_NEAR(vectorized.ax[i], scalar.ax[i], 1e-10 * norm) << i;
+    EXPECT_NEAR(vectorized.ay[i], scalar.ay[i], 1e-10 * norm) << i;
+    EXPECT_NEAR(vectorized.az[i], scalar.az[i], 1e-10 * norm) << i;
+  }
+}
+
+}  // namespace physics
+}  // namespace principia
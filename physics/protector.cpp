@@ -1,56 +1,132 @@
 #include "physics/protector.hpp"
 
-#include <optional>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "glog/logging.h"
+#include "quantities/si.hpp"
+
 namespace principia {
 namespace physics {
 namespace _protector {
 namespace internal {
 
+using namespace principia::quantities::_si;
+
+namespace {
+
+constexpr double free_slot = std::numeric_limits<double>::infinity();
+
+double ToSeconds(Instant const& t) {
+  return (t - Instant()) / Second;
+}
+
+}  // namespace
+
+Protector::Protector() {
+  for (auto& slot : slots_) {
+    slot.protection_start_time = free_slot;
+  }
+}
+
 bool Protector::RunWhenUnprotected(Instant const& t, Callback callback) {
   {
     absl::MutexLock l(&lock_);
-    if (!protection_start_times_.empty() &&
-        *protection_start_times_.begin() < t) {
+    // This store must come before the scan of the slots, see |Unprotect|.
+    has_callbacks_ = true;
+    if (FirstProtectionStartTime() < t) {
       callbacks_.emplace(t, std::move(callback));
       return false;
     }
+    if (callbacks_.empty()) {
+      has_callbacks_ = false;
+    }
   }
   callback();
   return true;
 }
 
 void Protector::Protect(Instant const& t_min) {
+  double const t_min_in_seconds = ToSeconds(t_min);
+  if (t_min_in_seconds == free_slot) {
+    // Protecting [+∞, +∞[ has no effect.
+    return;
+  }
+  int const first_slot_index = FirstSlotIndex();
+  for (int i = 0; i < number_of_slots; ++i) {
+    auto& slot = slots_[(first_slot_index + i) % number_of_slots];
+    double expected = free_slot;
+    if (slot.protection_start_time.compare_exchange_strong(expected,
+                                                           t_min_in_seconds)) {
+      return;
+    }
+  }
   absl::MutexLock l(&lock_);
-  protection_start_times_.insert(t_min);
+  overflow_protection_start_times_.insert(t_min);
 }
 
 void Protector::Unprotect(Instant const& t_min) {
+  double const t_min_in_seconds = ToSeconds(t_min);
+  if (t_min_in_seconds != free_slot) {
+    // Another thread may concurrently release a slot holding the same time
+    // (which is fine, protections are interchangeable) after we have scanned
+    // the slot holding its own protection, hence the retries.
+    constexpr int max_attempts = 3;
+    bool found = false;
+    for (int attempt = 0; !found && attempt < max_attempts; ++attempt) {
+      int const first_slot_index = FirstSlotIndex();
+      for (int i = 0; i < number_of_slots; ++i) {
+        auto& slot = slots_[(first_slot_index + i) % number_of_slots];
+        double expected = t_min_in_seconds;
+        if (slot.protection_start_time.compare_exchange_strong(expected,
+                                                               free_slot)) {
+          found = true;
+          break;
+        }
+      }
+      if (!found) {
+        absl::MutexLock l(&lock_);
+        auto const it = overflow_protection_start_times_.find(t_min);
+        if (it != overflow_protection_start_times_.end()) {
+          overflow_protection_start_times_.erase(it);
+          found = true;
+        }
+      }
+    }
+    CHECK(found) << t_min;
+  }
+
+  // The slot was released before this load, and |RunWhenUnprotected| sets
+  // |has_callbacks_| before scanning the slots.  Both operations are
+  // sequentially consistent, so either |RunWhenUnprotected| sees the slot
+  // released and runs its callback immediately, or we see its callback here.
+  if (!has_callbacks_) {
+    return;
+  }
+
   std::vector<Callback> callbacks_to_run;
   {
     absl::MutexLock l(&lock_);
-    auto const it = protection_start_times_.find(t_min);
-    CHECK(it != protection_start_times_.end());
-    protection_start_times_.erase(it);
-
     // Find all the callbacks that are now unprotected and remove them from the
     // multimap.
-    std::optional<Instant> const first_guard_start_time =
-        protection_start_times_.empty()
-            ? std::nullopt
-            : std::make_optional(*protection_start_times_.begin());
+    Instant const first_protection_start_time = FirstProtectionStartTime();
     for (auto it = callbacks_.begin(); it != callbacks_.end();) {
       auto const& t = it->first;
       auto& callback = it->second;
-      if (!first_guard_start_time || t <= *first_guard_start_time) {
+      if (t <= first_protection_start_time) {
         callbacks_to_run.emplace_back(std::move(callback));
         it = callbacks_.erase(it);
       } else {
         ++it;
       }
     }
+    if (callbacks_.empty()) {
+      has_callbacks_ = false;
+    }
   }
 
   // Run the callbacks without holding the lock.
@@ -59,6 +135,29 @@ void Protector::Unprotect(Instant const& t_min) {
   }
 }
 
+Instant Protector::FirstProtectionStartTime() const {
+  double first_protection_start_time = free_slot;
+  for (auto const& slot : slots_) {
+    first_protection_start_time = std::min(first_protection_start_time,
+                                           slot.protection_start_time.load());
+  }
+  Instant const first_slot_protection_start_time =
+      Instant() + first_protection_start_time * Second;
+  if (overflow_protection_start_times_.empty()) {
+    return first_slot_protection_start_time;
+  } else {
+    return std::min(first_slot_protection_start_time,
+                    *overflow_protection_start_times_.begin());
+  }
+}
+
+int Protector::FirstSlotIndex() {
+  thread_local int const first_slot_index =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) %
+      number_of_slots;
+  return first_slot_index;
+}
+
 }  // namespace internal
 }  // namespace _protector
 }  // namespace physics
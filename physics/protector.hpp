@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <functional>
 #include <set>
 #include <map>
@@ -21,12 +23,20 @@ using namespace principia::geometry::_instant;
 // would want to touch the time range ]-∞, t[ should do so through
 // RunWhenUnprotected, and the change will be delayed until ]-∞, t[ becomes
 // unprotected.  This class is thread-safe.
+// Protecting and unprotecting are frequent and normally don't take a lock: the
+// protections are stored in a fixed array of atomic slots, each thread starting
+// its search for a free slot at a different position.  The slots are only
+// scanned as a whole by the (rare) calls that need to know the earliest
+// protection.  If all the slots are taken, the protections overflow into a
+// locked multiset.
 class Protector {
  public:
   // A callback that may be run immediately or in a delayed manner when the
   // state of the protector permits it.
   using Callback = std::function<void()>;
 
+  Protector();
+
   // If the range ]-∞, t[ is unprotected, |callback| is run immediately and this
   // function returns true.  Otherwise |callback| is delayed and will be run as
   // soon as ]-∞, t[ becomes unprotected; returns false in this case.  The
@@ -38,9 +48,30 @@ class Protector {
   void Unprotect(Instant const& t_min);
 
  private:
-  absl::Mutex lock_;
+  static constexpr int number_of_slots = 64;
+
+  // A protection start time, in seconds since |Instant()|, or +∞ if the slot is
+  // free.  Padded to avoid false sharing between the threads.
+  struct alignas(64) Slot {
+    std::atomic<double> protection_start_time;
+  };
+
+  // Returns the start of the earliest protection, or |InfiniteFuture| if there
+  // is none.
+  Instant FirstProtectionStartTime() const EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Returns the index of the slot where the current thread starts its search.
+  static int FirstSlotIndex();
+
+  std::array<Slot, number_of_slots> slots_;
+
+  // True if there may be callbacks in |callbacks_|.  Read without the lock by
+  // |Unprotect| to decide whether it needs to run any callbacks.
+  std::atomic<bool> has_callbacks_ = false;
+
+  mutable absl::Mutex lock_;
   std::multimap<Instant, Callback> callbacks_ GUARDED_BY(lock_);
-  std::multiset<Instant> protection_start_times_ GUARDED_BY(lock_);
+  std::multiset<Instant> overflow_protection_start_times_ GUARDED_BY(lock_);
 };
 
 }  // namespace internal
@@ -1,5 +1,9 @@
 #include "physics/protector.hpp"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "geometry/instant.hpp"
 #include "glog/logging.h"
 #include "gmock/gmock.h"
@@ -39,5 +43,51 @@ TEST_F(ProtectorTest, DelayedExecution) {
   protector_.Unprotect(Instant() + 10 * Second);
 }
 
+TEST_F(ProtectorTest, Overflow) {
+  // More protections than there are slots.
+  constexpr int protections = 100;
+  for (int i = 0; i < protections; ++i) {
+    protector_.Protect(Instant() + (10 + i) * Second);
+  }
+  EXPECT_CALL(callback_, Call()).Times(0);
+  CHECK(!protector_.RunWhenUnprotected(Instant() + 50 * Second,
+                                       callback_.AsStdFunction()));
+  for (int i = protections - 1; i > 40; --i) {
+    protector_.Unprotect(Instant() + (10 + i) * Second);
+  }
+
+  EXPECT_CALL(callback_, Call()).Times(1);
+  for (int i = 40; i >= 0; --i) {
+    protector_.Unprotect(Instant() + (10 + i) * Second);
+  }
+}
+
+TEST_F(ProtectorTest, Concurrency) {
+  protector_.Protect(Instant() + 10 * Second);
+  std::atomic<int> calls = 0;
+  CHECK(!protector_.RunWhenUnprotected(Instant() + 15 * Second,
+                                       [&calls]() { ++calls; }));
+
+  // Many threads protecting and unprotecting the same times, with at least one
+  // protection before the time of the callback at all times.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([this]() {
+      for (int j = 0; j < 10'000; ++j) {
+        Instant const t = Instant() + (j % 2 == 0 ? 5 : 20) * Second;
+        protector_.Protect(t);
+        protector_.Unprotect(t);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0, calls);
+
+  protector_.Unprotect(Instant() + 10 * Second);
+  EXPECT_EQ(1, calls);
+}
+
 }  // namespace physics
 }  // namespace principia
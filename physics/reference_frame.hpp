@@ -1,6 +1,8 @@
 #ifndef PRINCIPIA_PHYSICS_REFERENCE_FRAME_HPP_
 #define PRINCIPIA_PHYSICS_REFERENCE_FRAME_HPP_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 #include "base/not_null.hpp"
@@ -107,6 +109,18 @@ class ReferenceFrame {
   static not_null<std::unique_ptr<ReferenceFrame>>
       ReadFromMessage(serialization::ReferenceFrame const& message,
                       not_null<Ephemeris<InertialFrame> const*> ephemeris);
+
+ protected:
+  // An identifier used to key the per-thread caches of the motion of this
+  // frame at a given time.  Unlike the address of this object, it is not
+  // reused when the object is destroyed.  Copies share the identifier, which
+  // is fine since they have the same motion.
+  std::uint64_t cache_id() const;
+
+ private:
+  static inline std::atomic<std::uint64_t> next_cache_id_ = 0;
+  std::uint64_t cache_id_ =
+      next_cache_id_.fetch_add(1, std::memory_order_relaxed);
 };
 
 }  // namespace internal
@@ -2,6 +2,7 @@
 
 #include "physics/reference_frame.hpp"
 
+#include <cstdint>
 #include <memory>
 
 #include "geometry/r3x3_matrix.hpp"
@@ -53,6 +54,11 @@ ReferenceFrame<InertialFrame, ThisFrame>::FrenetFrame(
   return Rotation<Frenet<ThisFrame>, ThisFrame>(tangent, normal, binormal);
 }
 
+template<typename InertialFrame, typename ThisFrame>
+std::uint64_t ReferenceFrame<InertialFrame, ThisFrame>::cache_id() const {
+  return cache_id_;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 not_null<std::unique_ptr<ReferenceFrame<InertialFrame, ThisFrame>>>
 ReferenceFrame<InertialFrame, ThisFrame>::ReadFromMessage(
@@ -64,6 +64,13 @@ class RigidReferenceFrame : public ReferenceFrame<InertialFrame, ThisFrame> {
   virtual RigidMotion<ThisFrame, InertialFrame> FromThisFrameAtTime(
       Instant const& t) const;
 
+  // Same as |ToThisFrameAtTime|, but goes through the per-thread cache of the
+  // motion of |ThisFrame| used by |GeometricAcceleration|.  A client that
+  // needs both the motion and the geometric acceleration at the same |t| (e.g.,
+  // to compute a Frenet frame) only pays for one evaluation of the motion.
+  RigidMotion<InertialFrame, ThisFrame> CachedToThisFrameAtTime(
+      Instant const& t) const;
+
   // The acceleration due to the non-inertial motion of |ThisFrame| and gravity.
   // A particle in free fall follows a trajectory whose second derivative
   // is |GeometricAcceleration|.
@@ -169,6 +176,15 @@ class RigidReferenceFrame : public ReferenceFrame<InertialFrame, ThisFrame> {
                              Trihedron<double, double, 2> const& 𝛛²orthonormal);
 
  private:
+  // Returns |MotionOfThisFrame(t)|, reusing the result of the previous call on
+  // this thread if it was for the same frame and the same |t| and the motion
+  // of the frame is cacheable.  Computing the
+  // motion requires evaluating trajectories and trihedra, and clients such as
+  // the equipotential computations evaluate the geometric acceleration and
+  // potential at many positions for a single |t|.
+  AcceleratedRigidMotion<InertialFrame, ThisFrame> CachedMotionOfThisFrame(
+      Instant const& t) const;
+
   void ComputeGeometricAccelerations(
       Instant const& t,
       DegreesOfFreedom<ThisFrame> const& degrees_of_freedom,
@@ -186,6 +202,13 @@ class RigidReferenceFrame : public ReferenceFrame<InertialFrame, ThisFrame> {
       Position<InertialFrame> const& q) const = 0;
   virtual AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const = 0;
+
+  // Whether the motion of this frame at a given time never changes, so that
+  // |CachedMotionOfThisFrame| may reuse it.  This is the case for the frames
+  // defined by celestials, whose trajectories are only ever prolonged, but not
+  // for those defined by a trajectory that may be rewritten, such as the
+  // prediction of a vessel.  The default implementation returns false.
+  virtual bool MotionIsCacheable() const;
 };
 
 }  // namespace internal
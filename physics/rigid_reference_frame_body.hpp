@@ -2,7 +2,9 @@
 
 #include "physics/rigid_reference_frame.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "geometry/r3x3_matrix.hpp"
@@ -54,6 +56,13 @@ RigidReferenceFrame<InertialFrame, ThisFrame>::FromThisFrameAtTime(
   return ToThisFrameAtTime(t).Inverse();
 }
 
+template<typename InertialFrame, typename ThisFrame>
+RigidMotion<InertialFrame, ThisFrame>
+RigidReferenceFrame<InertialFrame, ThisFrame>::CachedToThisFrameAtTime(
+    Instant const& t) const {
+  return CachedMotionOfThisFrame(t).rigid_motion();
+}
+
 template<typename InertialFrame, typename ThisFrame>
 Vector<Acceleration, ThisFrame>
 RigidReferenceFrame<InertialFrame, ThisFrame>::GeometricAcceleration(
@@ -107,7 +116,7 @@ RigidReferenceFrame<InertialFrame, ThisFrame>::GeometricPotential(
     Instant const& t,
     Position<ThisFrame> const& position) const {
   AcceleratedRigidMotion<InertialFrame, ThisFrame> const motion =
-      MotionOfThisFrame(t);
+      CachedMotionOfThisFrame(t);
   RigidMotion<InertialFrame, ThisFrame> const& to_this_frame =
       motion.rigid_motion();
   RigidMotion<ThisFrame, InertialFrame> const from_this_frame =
@@ -359,6 +368,38 @@ RigidReferenceFrame<InertialFrame, ThisFrame>::ComputeAngularAcceleration(
       (InnerProduct(f̈, n) + InnerProduct(ḟ, ṅ)) * b + InnerProduct(ḟ, n) * ḃ);
 }
 
+template<typename InertialFrame, typename ThisFrame>
+AcceleratedRigidMotion<InertialFrame, ThisFrame>
+RigidReferenceFrame<InertialFrame, ThisFrame>::CachedMotionOfThisFrame(
+    Instant const& t) const {
+  struct CachedMotion {
+    std::uint64_t id;
+    Instant t;
+    std::optional<AcceleratedRigidMotion<InertialFrame, ThisFrame>> motion;
+  };
+  if (!MotionIsCacheable()) {
+    return MotionOfThisFrame(t);
+  }
+  thread_local CachedMotion cached_motion;
+  if (!cached_motion.motion.has_value() ||
+      cached_motion.id != this->cache_id() ||
+      cached_motion.t != t) {
+    // Compute the motion before updating the cache, in case the computation
+    // itself goes through the cache.
+    auto motion = MotionOfThisFrame(t);
+    cached_motion.motion.reset();
+    cached_motion.motion.emplace(std::move(motion));
+    cached_motion.id = this->cache_id();
+    cached_motion.t = t;
+  }
+  return *cached_motion.motion;
+}
+
+template<typename InertialFrame, typename ThisFrame>
+bool RigidReferenceFrame<InertialFrame, ThisFrame>::MotionIsCacheable() const {
+  return false;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 void RigidReferenceFrame<InertialFrame, ThisFrame>::
 ComputeGeometricAccelerations(
@@ -370,7 +411,7 @@ ComputeGeometricAccelerations(
     Vector<Acceleration, ThisFrame>& centrifugal_acceleration,
     Vector<Acceleration, ThisFrame>& euler_acceleration) const {
   AcceleratedRigidMotion<InertialFrame, ThisFrame> const motion =
-      MotionOfThisFrame(t);
+      CachedMotionOfThisFrame(t);
   RigidMotion<InertialFrame, ThisFrame> const& to_this_frame =
       motion.rigid_motion();
   RigidMotion<ThisFrame, InertialFrame> const from_this_frame =
@@ -12,8 +12,11 @@
 #include "base/not_null.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
+#include "geometry/quaternion.hpp"
+#include "geometry/r3_element.hpp"
 #include "geometry/rotation.hpp"
 #include "geometry/space.hpp"
+#include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
@@ -26,13 +29,24 @@ namespace internal {
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
+using namespace principia::geometry::_quaternion;
+using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_rotation;
 using namespace principia::geometry::_space;
 using namespace principia::physics::_massive_body;
+using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
+// Returns a rotation of |angle| around |axis|, computed like the factors of the
+// Euler angle constructors of |Rotation|.
+inline Quaternion AngleAxisQuaternion(Angle const& angle,
+                                      R3Element<double> const& axis) {
+  Angle const half_angle = 0.5 * angle;
+  return Quaternion(Cos(half_angle), Sin(half_angle) * axis);
+}
+
 template<typename Frame>
 class RotatingBody : public MassiveBody {
   static_assert(Frame::is_inertial, "Frame must be inertial");
@@ -131,6 +145,13 @@ class RotatingBody : public MassiveBody {
   template<typename SurfaceFrame>
   Rotation<Frame, SurfaceFrame> ToSurfaceFrame(Instant const& t) const;
 
+  // Same as above for all the instants in |times|, in the same order.  Faster
+  // than repeated calls for bulk queries, e.g., when plotting or computing
+  // ground tracks.
+  template<typename SurfaceFrame>
+  std::vector<Rotation<SurfaceFrame, Frame>> FromSurfaceFrame(
+      std::vector<Instant> const& times) const;
+
   // Returns the rotation relating the celestial reference frame of this
   // body to |Frame|.  The celestial reference frame is defined as follows:
   //   - the z axis is the |polar_axis|;
@@ -161,6 +182,12 @@ class RotatingBody : public MassiveBody {
   Vector<double, Frame> const biequatorial_;
   Vector<double, Frame> const equatorial_;
   AngularVelocity<Frame> const angular_velocity_;
+  // The product of the first two factors of the Euler rotation of
+  // |FromSurfaceFrame|, which only depend on the pole, so that only the
+  // rotation around the pole needs to be computed for each instant.  The
+  // quaternion product is evaluated in the same order as in the Euler angle
+  // constructor of |Rotation|, so the result is the same.
+  Quaternion const pole_orientation_;
 };
 
 // Define template member functions even when importing: these are not
@@ -171,11 +198,20 @@ template<typename SurfaceFrame>
 Rotation<SurfaceFrame, Frame> RotatingBody<Frame>::FromSurfaceFrame(
     Instant const& t) const {
   return Rotation<SurfaceFrame, Frame>(
-      π / 2 * Radian + right_ascension_of_pole(),
-      π / 2 * Radian - declination_of_pole(),
-      AngleAt(t),
-      EulerAngles::ZXZ,
-      DefinesFrame<SurfaceFrame>{});
+      pole_orientation_ *
+      AngleAxisQuaternion(AngleAt(t), R3Element<double>(0, 0, 1)));
+}
+
+template<typename Frame>
+template<typename SurfaceFrame>
+std::vector<Rotation<SurfaceFrame, Frame>>
+RotatingBody<Frame>::FromSurfaceFrame(std::vector<Instant> const& times) const {
+  std::vector<Rotation<SurfaceFrame, Frame>> result;
+  result.reserve(times.size());
+  for (Instant const& t : times) {
+    result.push_back(FromSurfaceFrame<SurfaceFrame>(t));
+  }
+  return result;
 }
 
 template<typename Frame>
@@ -72,7 +72,14 @@ RotatingBody<Frame>::RotatingBody(
                             parameters.right_ascension_of_pole_).ToCartesian()),
       equatorial_(Wedge(biequatorial_, polar_axis_).coordinates()),
       angular_velocity_(polar_axis_.coordinates() *
-                        parameters.angular_frequency_) {}
+                        parameters.angular_frequency_),
+      pole_orientation_(
+          AngleAxisQuaternion(
+              π / 2 * Radian + parameters.right_ascension_of_pole_,
+              R3Element<double>(0, 0, 1)) *
+          AngleAxisQuaternion(
+              π / 2 * Radian - parameters.declination_of_pole_,
+              R3Element<double>(1, 0, 0))) {}
 
 template<typename Frame>
 Length RotatingBody<Frame>::min_radius() const {
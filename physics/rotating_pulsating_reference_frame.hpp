@@ -101,6 +101,12 @@ class RotatingPulsatingReferenceFrame
   Derivatives<Length, Instant, degree + 1> r_derivatives(
       Instant const& t) const;
 
+  // Returns |r_derivatives<2>(t)|, reusing the result of the previous call on
+  // this thread if it was for the same frame and the same |t|.  The geometric
+  // accelerations and potentials are evaluated at many positions for a single
+  // |t| when computing equipotentials.
+  Derivatives<Length, Instant, 3> CachedRDerivatives(Instant const& t) const;
+
   SimilarMotion<ThisFrame, RotatingFrame> ToRotatingFrame(
       Derivatives<Length, Instant, 2> const& r_derivatives_1) const;
 
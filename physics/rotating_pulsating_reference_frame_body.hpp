@@ -2,7 +2,9 @@
 
 #include "physics/rotating_pulsating_reference_frame.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -104,7 +106,7 @@ Vector<Acceleration, ThisFrame> RotatingPulsatingReferenceFrame<
     ThisFrame>::GeometricAcceleration(Instant const& t,
                                       DegreesOfFreedom<ThisFrame> const&
                                           degrees_of_freedom) const {
-  auto const [r, ṙ, r̈] = r_derivatives<2>(t);
+  auto const [r, ṙ, r̈] = CachedRDerivatives(t);
   SimilarMotion<ThisFrame, RotatingFrame> const to_rotating_frame =
       ToRotatingFrame({r, ṙ});
   SimilarMotion<RotatingFrame, ThisFrame> const from_rotating_frame =
@@ -125,7 +127,7 @@ RotatingPulsatingReferenceFrame<InertialFrame, ThisFrame>::
     RotationFreeGeometricAccelerationAtRest(
         Instant const& t,
         Position<ThisFrame> const& position) const {
-  auto const [r, ṙ, r̈] = r_derivatives<2>(t);
+  auto const [r, ṙ, r̈] = CachedRDerivatives(t);
   SimilarMotion<ThisFrame, RotatingFrame> const to_rotating_frame =
       ToRotatingFrame({r, ṙ});
   SimilarMotion<RotatingFrame, ThisFrame> const from_rotating_frame =
@@ -143,7 +145,7 @@ SpecificEnergy
 RotatingPulsatingReferenceFrame<InertialFrame, ThisFrame>::GeometricPotential(
     Instant const& t,
     Position<ThisFrame> const& position) const {
-  auto const [r, ṙ, r̈] = r_derivatives<2>(t);
+  auto const [r, ṙ, r̈] = CachedRDerivatives(t);
   SimilarMotion<ThisFrame, RotatingFrame> const to_rotating_frame =
       ToRotatingFrame({r, ṙ});
   SimilarMotion<RotatingFrame, ThisFrame> const from_rotating_frame =
@@ -220,6 +222,26 @@ RotatingPulsatingReferenceFrame<InertialFrame, ThisFrame>::r_derivatives(
   }
 }
 
+template<typename InertialFrame, typename ThisFrame>
+Derivatives<Length, Instant, 3>
+RotatingPulsatingReferenceFrame<InertialFrame, ThisFrame>::CachedRDerivatives(
+    Instant const& t) const {
+  struct CachedDerivatives {
+    std::uint64_t id;
+    Instant t;
+    std::optional<Derivatives<Length, Instant, 3>> derivatives;
+  };
+  thread_local CachedDerivatives cached_derivatives;
+  if (!cached_derivatives.derivatives.has_value() ||
+      cached_derivatives.id != this->cache_id() ||
+      cached_derivatives.t != t) {
+    cached_derivatives.derivatives.emplace(r_derivatives<2>(t));
+    cached_derivatives.id = this->cache_id();
+    cached_derivatives.t = t;
+  }
+  return *cached_derivatives.derivatives;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 auto RotatingPulsatingReferenceFrame<InertialFrame, ThisFrame>::ToRotatingFrame(
     Derivatives<Length, Instant, 2> const& r_derivatives_1) const
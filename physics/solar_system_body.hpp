@@ -6,11 +6,13 @@
 #include <fstream>
 #include <map>
 #include <memory>
-#include <set>
+#include <random>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
+#include "absl/synchronization/mutex.h"
 #include "astronomy/epoch.hpp"
 #include "astronomy/time_scales.hpp"
 #include "base/fingerprint2011.hpp"
@@ -46,28 +48,88 @@ using namespace principia::geometry::_space;
 using namespace principia::quantities::_parser;
 using namespace principia::quantities::_si;
 
+// Returns the |SolarSystemFile| in the text file |filename|.  Parsing the text
+// format is slow for the large gravity models, so the message is also written
+// in binary next to the text file, e.g., |foo.proto.bin| for |foo.proto.txt|,
+// and that binary file is read instead of the text file if it is at least as
+// recent.  The messages are also cached in memory, since tests and tools
+// construct solar systems from the same files many times.
+inline serialization::SolarSystemFile ReadSolarSystemFile(
+    std::filesystem::path const& filename) {
+  struct CachedFile {
+    std::filesystem::file_time_type last_write_time;
+    serialization::SolarSystemFile message;
+  };
+  static absl::Mutex lock;
+  static auto* const cache =
+      new std::map<std::filesystem::path, CachedFile>();
+
+  auto const last_write_time = std::filesystem::last_write_time(filename);
+  {
+    absl::MutexLock l(&lock);
+    if (auto const it = cache->find(filename);
+        it != cache->end() && it->second.last_write_time == last_write_time) {
+      return it->second.message;
+    }
+  }
+
+  serialization::SolarSystemFile message;
+  auto const binary_filename =
+      std::filesystem::path(filename).replace_extension("bin");
+  bool parsed = false;
+  std::error_code error;
+  auto const binary_last_write_time =
+      std::filesystem::last_write_time(binary_filename, error);
+  if (!error && binary_last_write_time >= last_write_time) {
+    std::ifstream binary_ifstream(binary_filename, std::ios::binary);
+    parsed = binary_ifstream.good() &&
+             message.ParseFromIstream(&binary_ifstream);
+  }
+
+  if (!parsed) {
+    message.Clear();
+    std::ifstream text_ifstream(filename);
+    CHECK(text_ifstream.good()) << filename;
+    google::protobuf::io::IstreamInputStream text_zcs(&text_ifstream);
+    CHECK(google::protobuf::TextFormat::Parse(&text_zcs, &message))
+        << filename;
+
+    // The binary file is only an optimization, so it's fine if it cannot be
+    // written, e.g., because the directory is read-only.  It is written under a
+    // temporary name and then renamed so that concurrent readers never see a
+    // partial file.
+    auto temporary_filename = binary_filename;
+    temporary_filename += "." + std::to_string(std::random_device()());
+    {
+      std::ofstream binary_ofstream(temporary_filename, std::ios::binary);
+      parsed = binary_ofstream.good() &&
+               message.SerializeToOstream(&binary_ofstream);
+    }
+    if (parsed) {
+      std::filesystem::rename(temporary_filename, binary_filename, error);
+    }
+    if (!parsed || error) {
+      std::filesystem::remove(temporary_filename, error);
+    }
+  }
+
+  absl::MutexLock l(&lock);
+  cache->insert_or_assign(filename, CachedFile{last_write_time, message});
+  return message;
+}
+
 inline serialization::GravityModel ParseGravityModel(
     std::filesystem::path const& gravity_model_filename) {
-  serialization::SolarSystemFile gravity_model;
-  std::ifstream gravity_model_ifstream(gravity_model_filename);
-  CHECK(gravity_model_ifstream.good());
-  google::protobuf::io::IstreamInputStream gravity_model_zcs(
-                                               &gravity_model_ifstream);
-  CHECK(google::protobuf::TextFormat::Parse(&gravity_model_zcs,
-                                            &gravity_model));
+  serialization::SolarSystemFile const gravity_model =
+      ReadSolarSystemFile(gravity_model_filename);
   CHECK(gravity_model.has_gravity_model());
   return gravity_model.gravity_model();
 }
 
 inline serialization::InitialState ParseInitialState(
     std::filesystem::path const& initial_state_filename) {
-  serialization::SolarSystemFile initial_state;
-  std::ifstream initial_state_ifstream(initial_state_filename);
-  CHECK(initial_state_ifstream.good());
-  google::protobuf::io::IstreamInputStream initial_state_zcs(
-                                               &initial_state_ifstream);
-  CHECK(google::protobuf::TextFormat::Parse(&initial_state_zcs,
-                                            &initial_state));
+  serialization::SolarSystemFile const initial_state =
+      ReadSolarSystemFile(initial_state_filename);
   CHECK(initial_state.has_initial_state());
   return initial_state.initial_state();
 }
@@ -424,14 +486,18 @@ SolarSystem<Frame>::MakeOblateBody(
 template<typename Frame>
 not_null<std::unique_ptr<HierarchicalSystem<Frame>>>
 SolarSystem<Frame>::MakeHierarchicalSystem() const {
-  // First, construct all the bodies and find the primary body of the system.
+  // First, construct all the bodies, find the primary body of the system, and
+  // the satellites of each body, in name order.
   std::string primary;
   std::map<std::string,
             not_null<std::unique_ptr<MassiveBody const>>> owned_bodies;
   std::map<std::string, not_null<MassiveBody const*>> unowned_bodies;
+  std::map<std::string, std::vector<std::string>> satellites;
   for (auto const& [name, body] : keplerian_initial_state_map_) {
     CHECK_EQ(body->has_parent(), body->has_elements()) << name;
-    if (!body->has_parent()) {
+    if (body->has_parent()) {
+      satellites[body->parent()].push_back(name);
+    } else {
       CHECK(primary.empty()) << name;
       primary = name;
     }
@@ -441,25 +507,27 @@ SolarSystem<Frame>::MakeHierarchicalSystem() const {
   }
 
   // Construct a hierarchical system rooted at the primary and add the other
-  // bodies layer by layer.
+  // bodies in a single pass from the primary down, each after its parent.  The
+  // satellites of a body are added in name order.
   auto hierarchical_system = make_not_null_unique<HierarchicalSystem<Frame>>(
       std::move(FindOrDie(owned_bodies, primary)));
-  std::set<std::string> previous_layer = {primary};
-  std::set<std::string> current_layer;
-  do {
-    for (auto const& [name, body] : keplerian_initial_state_map_) {
-      if (Contains(previous_layer, body->parent())) {
-        current_layer.insert(name);
-        KeplerianElements<Frame> const elements =
-            MakeKeplerianElements(body->elements());
-        hierarchical_system->Add(std::move(FindOrDie(owned_bodies, name)),
-                                 FindOrDie(unowned_bodies, body->parent()),
-                                 elements);
-      }
+  std::vector<std::string const*> parents = {&primary};
+  while (!parents.empty()) {
+    std::string const& parent = *parents.back();
+    parents.pop_back();
+    auto const it = satellites.find(parent);
+    if (it == satellites.end()) {
+      continue;
     }
-    previous_layer = current_layer;
-    current_layer.clear();
-  } while (!previous_layer.empty());
+    for (std::string const& name : it->second) {
+      KeplerianElements<Frame> const elements = MakeKeplerianElements(
+          keplerian_initial_state_map_.at(name)->elements());
+      hierarchical_system->Add(std::move(FindOrDie(owned_bodies, name)),
+                               FindOrDie(unowned_bodies, parent),
+                               elements);
+      parents.push_back(&name);
+    }
+  }
 
   return hierarchical_system;
 }
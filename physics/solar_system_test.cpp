@@ -1,5 +1,8 @@
 #include "physics/solar_system.hpp"
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <utility>
 
 #include "absl/strings/str_replace.h"
@@ -205,6 +208,39 @@ TEST_F(SolarSystemTest, Clear) {
   EXPECT_FALSE(sun_gravity_model.has_reference_radius());
 }
 
+TEST_F(SolarSystemTest, BinaryFile) {
+  std::filesystem::path const text_filename =
+      TEMP_DIR / "solar_system_test_initial_state.proto.txt";
+  std::filesystem::path const binary_filename =
+      TEMP_DIR / "solar_system_test_initial_state.proto.bin";
+  std::filesystem::copy_file(
+      SOLUTION_DIR / "astronomy" / "kerbol_initial_state_0_0.proto.txt",
+      text_filename,
+      std::filesystem::copy_options::overwrite_existing);
+  std::filesystem::remove(binary_filename);
+
+  // The binary file is written when parsing the text file.
+  auto const initial_state1 = ParseInitialState(text_filename);
+  EXPECT_TRUE(std::filesystem::exists(binary_filename));
+  serialization::SolarSystemFile binary;
+  std::ifstream binary_ifstream(binary_filename, std::ios::binary);
+  ASSERT_TRUE(binary.ParseFromIstream(&binary_ifstream));
+  EXPECT_EQ(initial_state1.SerializeAsString(),
+            binary.initial_state().SerializeAsString());
+
+  // A stale binary file is ignored.
+  std::ofstream(text_filename, std::ios::app) << "# A comment.\n";
+  std::filesystem::last_write_time(
+      binary_filename,
+      std::filesystem::last_write_time(text_filename) -
+          std::chrono::seconds(1));
+  auto const initial_state2 = ParseInitialState(text_filename);
+  EXPECT_EQ(initial_state1.SerializeAsString(),
+            initial_state2.SerializeAsString());
+  EXPECT_LE(std::filesystem::last_write_time(text_filename),
+            std::filesystem::last_write_time(binary_filename));
+}
+
 TEST_F(SolarSystemTest, FingerprintCartesian) {
   auto gravity_model =
       ParseGravityModel(SOLUTION_DIR / "astronomy" /
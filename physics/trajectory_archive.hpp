@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/trajectory.hpp"
+
+namespace principia {
+namespace physics {
+namespace _trajectory_archive {
+namespace internal {
+
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_trajectory;
+
+// An append-only file holding the old parts of a trajectory, to avoid keeping
+// a long history in memory.  The points are stored in chunks, each of which
+// is a serialized |DiscreteTrajectory| (and is therefore compressed with zfp).
+// The chunks are read back on demand, one at a time.  Consecutive chunks share
+// their extremity, so that the archive may be evaluated at any time between
+// its |t_min| and its |t_max|.
+// The format of the file is specific to the machine that wrote it; it is meant
+// to be used as a cache, not as a save.
+// This class is thread-safe: the file and the cached chunk are shared by all
+// the evaluations, so they are accessed under a lock.
+template<typename Frame>
+class TrajectoryArchive : public Trajectory<Frame> {
+ public:
+  // Opens the archive at |path|, creating it if it doesn't exist.  The chunks
+  // already present in the file are made available.
+  explicit TrajectoryArchive(std::filesystem::path const& path);
+
+  // Moves the points of |trajectory| that are strictly before |t| to the end
+  // of this archive.  The first point at or after |t| is also written to the
+  // archive, but stays in |trajectory|, to make the evaluation continuous.  The
+  // points must be after those of the archive.  Does nothing if there are no
+  // points before |t|, or no points at or after |t|.
+  void Archive(DiscreteTrajectory<Frame>& trajectory, Instant const& t)
+      EXCLUDES(lock_);
+
+  std::int64_t number_of_chunks() const EXCLUDES(lock_);
+
+  // Reads the chunk at |index| from the file.  Iterating over the points of
+  // the archive is done by reading the chunks successively.
+  DiscreteTrajectory<Frame> ReadChunk(std::int64_t index) const
+      EXCLUDES(lock_);
+
+  Instant t_min() const override EXCLUDES(lock_);
+  Instant t_max() const override EXCLUDES(lock_);
+
+  // The chunk containing |t| is cached, so evaluating at times that are close
+  // to each other only reads the file once.
+  Position<Frame> EvaluatePosition(Instant const& t) const override
+      EXCLUDES(lock_);
+  Velocity<Frame> EvaluateVelocity(Instant const& t) const override
+      EXCLUDES(lock_);
+  DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(
+      Instant const& t) const override EXCLUDES(lock_);
+
+ private:
+  // The fixed-size header that precedes each serialized chunk in the file.
+  struct Header {
+    std::int64_t size;
+    double t_min;
+    double t_max;
+  };
+
+  struct Chunk {
+    Instant t_min;
+    Instant t_max;
+    // The position of the serialized chunk in the file, after its |Header|.
+    std::int64_t offset;
+    std::int64_t size;
+  };
+
+  DiscreteTrajectory<Frame> ReadChunkLocked(std::int64_t index) const
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Returns the chunk that contains |t|, which must be in [t_min, t_max].  The
+  // result is only valid while |lock_| is held.
+  DiscreteTrajectory<Frame> const& ChunkForInstant(Instant const& t) const
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  std::filesystem::path const path_;
+
+  // Even the const member functions seek in the |file_| and update the cache,
+  // so all the accesses are exclusive.
+  mutable absl::Mutex lock_;
+  mutable std::fstream file_ GUARDED_BY(lock_);
+  std::vector<Chunk> chunks_ GUARDED_BY(lock_);
+  // The position in the file where the next chunk will be written.
+  std::int64_t end_offset_ GUARDED_BY(lock_) = 0;
+
+  // The last chunk read by |ChunkForInstant|.
+  mutable std::optional<std::int64_t> cached_index_ GUARDED_BY(lock_);
+  mutable DiscreteTrajectory<Frame> cached_chunk_ GUARDED_BY(lock_);
+};
+
+}  // namespace internal
+
+using internal::TrajectoryArchive;
+
+}  // namespace _trajectory_archive
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/trajectory_archive_body.hpp"
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "physics/trajectory_archive.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include "glog/logging.h"
+#include "quantities/si.hpp"
+#include "serialization/physics.pb.h"
+
+namespace principia {
+namespace physics {
+namespace _trajectory_archive {
+namespace internal {
+
+using namespace principia::quantities::_si;
+
+template<typename Frame>
+TrajectoryArchive<Frame>::TrajectoryArchive(std::filesystem::path const& path)
+    : path_(path) {
+  absl::MutexLock l(&lock_);
+  // Create the file if needed, so that it can be opened for reading and
+  // writing.
+  { std::ofstream(path_, std::ios::app | std::ios::binary); }
+  file_.open(path_, std::ios::in | std::ios::out | std::ios::binary);
+  CHECK(file_.good()) << path_;
+
+  // Rebuild the index of the chunks from their headers.
+  file_.seekg(0, std::ios::end);
+  std::int64_t const file_size = file_.tellg();
+  while (end_offset_ < file_size) {
+    Header header;
+    file_.seekg(end_offset_);
+    file_.read(reinterpret_cast<char*>(&header), sizeof(header));
+    std::int64_t const offset = end_offset_ + sizeof(header);
+    if (!file_.good() || offset + header.size > file_size) {
+      // This happens if the process died while writing the last chunk.  It
+      // will be overwritten by the next call to |Archive|.
+      LOG(WARNING) << "Ignoring incomplete chunk at offset " << end_offset_
+                   << " of " << path_;
+      file_.clear();
+      break;
+    }
+    chunks_.push_back({.t_min = Instant() + header.t_min * Second,
+                       .t_max = Instant() + header.t_max * Second,
+                       .offset = offset,
+                       .size = header.size});
+    end_offset_ = offset + header.size;
+  }
+}
+
+template<typename Frame>
+void TrajectoryArchive<Frame>::Archive(DiscreteTrajectory<Frame>& trajectory,
+                                       Instant const& t) {
+  auto const last = trajectory.lower_bound(t);
+  if (last == trajectory.begin() || last == trajectory.end()) {
+    return;
+  }
+  absl::MutexLock l(&lock_);
+  CHECK(chunks_.empty() || chunks_.back().t_max <= trajectory.front().time)
+      << "Archiving out of order at " << trajectory.front().time
+      << ", last time is " << chunks_.back().t_max;
+
+  serialization::DiscreteTrajectory message;
+  trajectory.WriteToMessage(&message,
+                            trajectory.begin(),
+                            std::next(last),
+                            /*tracked=*/{},
+                            /*exact=*/{});
+  std::string serialized;
+  CHECK(message.SerializeToString(&serialized));
+
+  Chunk const chunk{.t_min = trajectory.front().time,
+                    .t_max = last->time,
+                    .offset = end_offset_ +
+                              static_cast<std::int64_t>(sizeof(Header)),
+                    .size = static_cast<std::int64_t>(serialized.size())};
+  Header const header{.size = chunk.size,
+                      .t_min = (chunk.t_min - Instant()) / Second,
+                      .t_max = (chunk.t_max - Instant()) / Second};
+  file_.seekp(end_offset_);
+  file_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  file_.write(serialized.data(), serialized.size());
+  file_.flush();
+  CHECK(file_.good()) << path_;
+
+  chunks_.push_back(chunk);
+  end_offset_ = chunk.offset + chunk.size;
+  trajectory.ForgetBefore(last);
+}
+
+template<typename Frame>
+std::int64_t TrajectoryArchive<Frame>::number_of_chunks() const {
+  absl::MutexLock l(&lock_);
+  return chunks_.size();
+}
+
+template<typename Frame>
+DiscreteTrajectory<Frame> TrajectoryArchive<Frame>::ReadChunk(
+    std::int64_t const index) const {
+  absl::MutexLock l(&lock_);
+  return ReadChunkLocked(index);
+}
+
+template<typename Frame>
+Instant TrajectoryArchive<Frame>::t_min() const {
+  absl::MutexLock l(&lock_);
+  return chunks_.empty() ? InfiniteFuture : chunks_.front().t_min;
+}
+
+template<typename Frame>
+Instant TrajectoryArchive<Frame>::t_max() const {
+  absl::MutexLock l(&lock_);
+  return chunks_.empty() ? InfinitePast : chunks_.back().t_max;
+}
+
+template<typename Frame>
+Position<Frame> TrajectoryArchive<Frame>::EvaluatePosition(
+    Instant const& t) const {
+  absl::MutexLock l(&lock_);
+  return ChunkForInstant(t).EvaluatePosition(t);
+}
+
+template<typename Frame>
+Velocity<Frame> TrajectoryArchive<Frame>::EvaluateVelocity(
+    Instant const& t) const {
+  absl::MutexLock l(&lock_);
+  return ChunkForInstant(t).EvaluateVelocity(t);
+}
+
+template<typename Frame>
+DegreesOfFreedom<Frame> TrajectoryArchive<Frame>::EvaluateDegreesOfFreedom(
+    Instant const& t) const {
+  absl::MutexLock l(&lock_);
+  return ChunkForInstant(t).EvaluateDegreesOfFreedom(t);
+}
+
+template<typename Frame>
+DiscreteTrajectory<Frame> TrajectoryArchive<Frame>::ReadChunkLocked(
+    std::int64_t const index) const {
+  CHECK_LE(0, index);
+  CHECK_LT(index, chunks_.size());
+  Chunk const& chunk = chunks_[index];
+  std::string serialized(chunk.size, '\0');
+  file_.seekg(chunk.offset);
+  file_.read(serialized.data(), serialized.size());
+  CHECK(file_.good()) << path_;
+
+  serialization::DiscreteTrajectory message;
+  CHECK(message.ParseFromString(serialized)) << path_;
+  return DiscreteTrajectory<Frame>::ReadFromMessage(message, /*tracked=*/{});
+}
+
+template<typename Frame>
+DiscreteTrajectory<Frame> const& TrajectoryArchive<Frame>::ChunkForInstant(
+    Instant const& t) const {
+  auto const it = std::partition_point(
+      chunks_.begin(), chunks_.end(), [&t](Chunk const& chunk) {
+        return chunk.t_max < t;
+      });
+  CHECK(it != chunks_.end() && it->t_min <= t)
+      << "Time " << t << " not in archive";
+  std::int64_t const index = it - chunks_.begin();
+  if (cached_index_ != index) {
+    cached_chunk_ = ReadChunkLocked(index);
+    cached_index_ = index;
+  }
+  return cached_chunk_;
+}
+
+}  // namespace internal
+}  // namespace _trajectory_archive
+}  // namespace physics
+}  // namespace principia
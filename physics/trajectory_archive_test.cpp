@@ -0,0 +1,145 @@
+#include "physics/trajectory_archive.hpp"
+
+#include <filesystem>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "geometry/frame.hpp"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "physics/discrete_trajectory.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "serialization/geometry.pb.h"
+#include "testing_utilities/discrete_trajectory_factories.hpp"
+
+namespace principia {
+namespace physics {
+
+using ::testing::Eq;
+using ::testing::Lt;
+using namespace principia::geometry::_frame;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_trajectory_archive;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_discrete_trajectory_factories;
+
+class TrajectoryArchiveTest : public ::testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      Inertial,
+                      Handedness::Right,
+                      serialization::Frame::TEST>;
+
+  TrajectoryArchiveTest()
+      : path_(TEMP_DIR / "trajectory_archive_test.bin") {
+    std::filesystem::remove(path_);
+    for (auto* const trajectory : {&trajectory_, &reference_trajectory_}) {
+      AppendTrajectoryTimeline(
+          NewCircularTrajectoryTimeline<World>(ω_, r_, Δt_, t0_, t0_ + 10 * s_),
+          *trajectory);
+    }
+  }
+
+  ~TrajectoryArchiveTest() override {
+    std::filesystem::remove(path_);
+  }
+
+  std::filesystem::path const path_;
+  Instant const t0_;
+  Time const s_ = 1 * Second;
+  AngularFrequency const ω_ = 3 * Radian / Second;
+  Length const r_ = 2 * Metre;
+  Time const Δt_ = 1.0 / 64 * Second;
+  DiscreteTrajectory<World> trajectory_;
+  DiscreteTrajectory<World> reference_trajectory_;
+};
+
+TEST_F(TrajectoryArchiveTest, Empty) {
+  TrajectoryArchive<World> const archive(path_);
+  EXPECT_THAT(archive.number_of_chunks(), Eq(0));
+  EXPECT_THAT(archive.t_min(), Eq(InfiniteFuture));
+  EXPECT_THAT(archive.t_max(), Eq(InfinitePast));
+}
+
+TEST_F(TrajectoryArchiveTest, ArchiveAndEvaluate) {
+  {
+    TrajectoryArchive<World> archive(path_);
+    archive.Archive(trajectory_, t0_ + 3 * s_);
+    archive.Archive(trajectory_, t0_ + 7 * s_);
+    // Nothing to archive.
+    archive.Archive(trajectory_, t0_ + 5 * s_);
+    archive.Archive(trajectory_, t0_ + 20 * s_);
+
+    EXPECT_THAT(archive.number_of_chunks(), Eq(2));
+    EXPECT_THAT(archive.t_min(), Eq(t0_));
+    EXPECT_THAT(archive.t_max(), Eq(t0_ + 7 * s_));
+    EXPECT_THAT(trajectory_.t_min(), Eq(t0_ + 7 * s_));
+    EXPECT_THAT(trajectory_.size(), Eq(192));
+
+    // Evaluate at the points and between them.  The error is only due to the
+    // zfp compression.
+    for (Instant t = t0_; t <= t0_ + 7 * s_; t += 0.37 * Δt_) {
+      EXPECT_THAT((archive.EvaluatePosition(t) -
+                   reference_trajectory_.EvaluatePosition(t)).Norm(),
+                  Lt(1 * Milli(Metre))) << t;
+    }
+  }
+
+  // Reopening the archive restores its chunks, and archiving resumes at the
+  // end.
+  TrajectoryArchive<World> archive(path_);
+  EXPECT_THAT(archive.number_of_chunks(), Eq(2));
+  EXPECT_THAT(archive.t_max(), Eq(t0_ + 7 * s_));
+  archive.Archive(trajectory_, t0_ + 9 * s_);
+  EXPECT_THAT(archive.number_of_chunks(), Eq(3));
+  EXPECT_THAT(archive.t_max(), Eq(t0_ + 9 * s_));
+
+  // Iterating over the chunks yields the points of the original trajectory,
+  // with the extremities of the chunks shared.
+  std::int64_t number_of_points = 0;
+  for (std::int64_t i = 0; i < archive.number_of_chunks(); ++i) {
+    auto const chunk = archive.ReadChunk(i);
+    number_of_points += chunk.size() - 1;
+  }
+  EXPECT_THAT(number_of_points + 1,
+              Eq(std::distance(reference_trajectory_.begin(),
+                               reference_trajectory_.find(t0_ + 9 * s_)) + 1));
+  EXPECT_THAT((archive.EvaluatePosition(t0_ + 8.5 * s_) -
+               reference_trajectory_.EvaluatePosition(t0_ + 8.5 * s_)).Norm(),
+              Lt(1 * Milli(Metre)));
+}
+
+TEST_F(TrajectoryArchiveTest, ConcurrentEvaluation) {
+  TrajectoryArchive<World> archive(path_);
+  archive.Archive(trajectory_, t0_ + 3 * s_);
+  archive.Archive(trajectory_, t0_ + 7 * s_);
+
+  // The threads evaluate in different chunks, so they keep replacing the
+  // cached chunk of each other.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([this, &archive, i]() {
+      for (int j = 0; j < 100; ++j) {
+        Instant const t = t0_ + (i % 2 == 0 ? 1 : 5) * s_ + j * Δt_;
+        EXPECT_THAT((archive.EvaluatePosition(t) -
+                     reference_trajectory_.EvaluatePosition(t)).Norm(),
+                    Lt(1 * Milli(Metre))) << t;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace physics
+}  // namespace principia
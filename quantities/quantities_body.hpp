@@ -203,20 +203,25 @@ std::string Format() {
 }
 
 inline std::string DebugString(double const number, int const precision) {
-  std::string result;
-  result.resize(50);
-  int const size = snprintf(result.data(), result.size(),
-                            ("%+." + std::to_string(precision) + "e").c_str(),
-                            number);
+  // The precision is passed as an argument to avoid building a format string.
+  char result[50];
+  int const size =
+      snprintf(result, sizeof(result), "%+.*e", precision, number);
   CHECK_LE(0, size);
-  result.resize(size);
-  return result;
+  CHECK_LT(size, sizeof(result));
+  return std::string(result, size);
 }
 
 template<typename D>
 std::string DebugString(Quantity<D> const& quantity, int const precision) {
-  return DebugString(quantity / SIUnit<Quantity<D>>(), precision) + " " +
-         Format<D>();
+  // The units only depend on |D|, so they are only formatted once.
+  static std::string const format = Format<D>();
+  std::string result =
+      DebugString(quantity / SIUnit<Quantity<D>>(), precision);
+  result.reserve(result.size() + 1 + format.size());
+  result += ' ';
+  result += format;
+  return result;
 }
 
 template<typename D>
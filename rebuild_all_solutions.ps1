@@ -9,7 +9,9 @@ $dependencies = @(".\Google\glog\msvc\glog.sln",
                   ".\Google\benchmark\msvc\google-benchmark.sln",
                   ".\Google\gipfeli\msvc\gipfeli.sln",
                   ".\Google\abseil-cpp\msvc\abseil-cpp.sln",
-                  ".\Third Party\zfp\msvc\zfp.sln")
+                  ".\Third Party\zfp\msvc\zfp.sln",
+                  ".\Third Party\zstd\msvc\zstd.sln",
+                  ".\Third Party\lz4\msvc\lz4.sln")
 
 New-Item -ItemType Directory -Force -Path "Google"
 New-Item -ItemType Directory -Force -Path "Third Party"
@@ -38,7 +40,7 @@ foreach ($repository in @("glog", "googletest", "protobuf", "benchmark",
 pop-location
 
 push-location -path "Third Party"
-foreach ($repository in @("zfp")) {
+foreach ($repository in @("zfp", "zstd", "lz4")) {
   if (!(test-path -path $repository)) {
     git clone ("https://github.com/mockingbirdnest/" + $repository + ".git")
   }
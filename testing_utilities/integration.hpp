@@ -37,6 +37,16 @@ absl::Status ComputeHarmonicOscillatorAcceleration1D(
     std::vector<Acceleration>& result,
     int* evaluations);
 
+// Same as above, as a functor for use as the |RightHandSideComputation| of a
+// |SpecialSecondOrderDifferentialEquation|.
+struct HarmonicOscillatorAcceleration1D {
+  absl::Status operator()(Instant const& t,
+                          std::vector<Length> const& q,
+                          std::vector<Acceleration>& result) const;
+
+  int* evaluations = nullptr;
+};
+
 template<typename Frame>
 absl::Status ComputeHarmonicOscillatorAcceleration3D(
     Instant const& t,
@@ -95,6 +105,7 @@ using internal::ComputeHarmonicOscillatorAcceleration3D;
 using internal::ComputeHarmonicOscillatorDerivatives1D;
 using internal::ComputeKeplerAcceleration;
 using internal::ComputeLegendrePolynomialSecondDerivative;
+using internal::HarmonicOscillatorAcceleration1D;
 
 }  // namespace _integration
 }  // namespace testing_utilities
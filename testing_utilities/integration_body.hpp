@@ -30,6 +30,13 @@ inline absl::Status ComputeHarmonicOscillatorAcceleration1D(
   return absl::OkStatus();
 }
 
+inline absl::Status HarmonicOscillatorAcceleration1D::operator()(
+    Instant const& t,
+    std::vector<Length> const& q,
+    std::vector<Acceleration>& result) const {
+  return ComputeHarmonicOscillatorAcceleration1D(t, q, result, evaluations);
+}
+
 template<typename Frame>
 absl::Status ComputeHarmonicOscillatorAcceleration3D(
     Instant const& t,
@@ -7,6 +7,7 @@
 #include "astronomy/frames.hpp"
 #include "base/not_constructible.hpp"
 #include "base/not_null.hpp"
+#include "geometry/instant.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/solar_system.hpp"
 #include "quantities/quantities.hpp"
@@ -20,6 +21,7 @@ namespace internal {
 using namespace principia::astronomy::_frames;
 using namespace principia::base::_not_constructible;
 using namespace principia::base::_not_null;
+using namespace principia::geometry::_instant;
 using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_solar_system;
 using namespace principia::quantities::_quantities;
@@ -100,6 +102,21 @@ class SolarSystemFactory : not_constructible {
   static not_null<std::unique_ptr<SolarSystem<ICRS>>>
   AtСпутник2Launch(Accuracy accuracy);
 
+  // Returns an ephemeris for |solar_system| constructed with the given
+  // parameters and prolonged to |t_max|.  The first call for a given system,
+  // parameters, horizon and version of Principia integrates the ephemeris and
+  // serializes it in |TEMP_DIR|, in a file named after a fingerprint of these
+  // inputs.  Later calls, possibly in other processes, deserialize it and
+  // reanimate its past, which integrates the intervals between checkpoints in
+  // parallel and is therefore much faster than the original integration.
+  template<typename Frame>
+  static not_null<std::unique_ptr<Ephemeris<Frame>>> MakeCachedEphemeris(
+      SolarSystem<Frame> const& solar_system,
+      typename Ephemeris<Frame>::AccuracyParameters const& accuracy_parameters,
+      typename Ephemeris<Frame>::FixedStepParameters const&
+          fixed_step_parameters,
+      Instant const& t_max);
+
   // Returns the index of the parent of the body with the given |index|.
   // Because enums are broken in C++ we use ints.  Sigh.
   static int parent(int index);
@@ -1,12 +1,23 @@
 #pragma once
 
 #include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <memory>
+#include <random>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "absl/strings/str_cat.h"
+#include "base/fingerprint2011.hpp"
 #include "base/map_util.hpp"
+#include "base/serialization.hpp"
+#include "base/status_utilities.hpp"  // 🧙 For CHECK_OK.
+#include "base/version.hpp"
+#include "glog/logging.h"
+#include "testing_utilities/serialization.hpp"
 
 #include "testing_utilities/solar_system_factory.hpp"
 
@@ -15,7 +26,11 @@ namespace testing_utilities {
 namespace _solar_system_factory {
 namespace internal {
 
+using namespace principia::base::_fingerprint2011;
 using namespace principia::base::_map_util;
+using namespace principia::base::_serialization;
+using namespace principia::base::_version;
+using namespace principia::testing_utilities::_serialization;
 
 template<typename Frame>
 void SolarSystemFactory::AdjustAccuracy(
@@ -131,6 +146,65 @@ SolarSystemFactory::AtСпутник2Launch(Accuracy const accuracy) {
   return solar_system;
 }
 
+template<typename Frame>
+not_null<std::unique_ptr<Ephemeris<Frame>>>
+SolarSystemFactory::MakeCachedEphemeris(
+    SolarSystem<Frame> const& solar_system,
+    typename Ephemeris<Frame>::AccuracyParameters const& accuracy_parameters,
+    typename Ephemeris<Frame>::FixedStepParameters const&
+        fixed_step_parameters,
+    Instant const& t_max) {
+  // The version is part of the fingerprint because the serialized checkpoints
+  // depend on the code that produced them.
+  std::uint64_t fingerprint =
+      FingerprintCat2011(solar_system.Fingerprint(),
+                         Fingerprint2011(Version, std::strlen(Version)));
+  {
+    serialization::Ephemeris message;
+    accuracy_parameters.WriteToMessage(message.mutable_accuracy_parameters());
+    fixed_step_parameters.WriteToMessage(
+        message.mutable_fixed_step_parameters());
+    fingerprint = FingerprintCat2011(
+        fingerprint, Fingerprint2011(SerializeAsBytes(message).get()));
+  }
+  {
+    serialization::Point message;
+    t_max.WriteToMessage(&message);
+    fingerprint = FingerprintCat2011(
+        fingerprint, Fingerprint2011(SerializeAsBytes(message).get()));
+  }
+  std::filesystem::path const path =
+      TEMP_DIR / absl::StrCat("ephemeris_",
+                              absl::Hex(fingerprint, absl::kZeroPad16),
+                              ".proto.bin");
+
+  if (std::filesystem::exists(path)) {
+    LOG(INFO) << "Reading cached ephemeris from " << path;
+    std::vector<std::uint8_t> const bytes = ReadFromBinaryFile(path);
+    serialization::Ephemeris message;
+    CHECK(message.ParseFromArray(bytes.data(), bytes.size())) << path;
+    auto ephemeris =
+        Ephemeris<Frame>::ReadFromMessage(/*desired_t_min=*/t_max, message);
+    CHECK_OK(ephemeris->Prolong(t_max));
+    ephemeris->AwaitReanimation(solar_system.epoch());
+    return ephemeris;
+  }
+
+  auto ephemeris =
+      solar_system.MakeEphemeris(accuracy_parameters, fixed_step_parameters);
+  CHECK_OK(ephemeris->Prolong(t_max));
+  serialization::Ephemeris message;
+  ephemeris->WriteToMessage(&message);
+  // Write to a temporary file and rename it, so that a process running
+  // concurrently never reads a partial file.
+  std::filesystem::path temporary_path = path;
+  temporary_path += absl::StrCat(".", std::random_device()(), ".tmp");
+  WriteToBinaryFile(temporary_path, SerializeAsBytes(message).get());
+  std::filesystem::rename(temporary_path, path);
+  LOG(INFO) << "Wrote cached ephemeris to " << path;
+  return ephemeris;
+}
+
 inline int SolarSystemFactory::parent(int const index) {
   switch (index) {
     case Sun:
@@ -8,17 +8,23 @@
 #include "astronomy/epoch.hpp"
 #include "astronomy/frames.hpp"
 #include "geometry/grassmann.hpp"
+#include "geometry/instant.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "integrators/methods.hpp"
+#include "integrators/symmetric_linear_multistep_integrator.hpp"
 #include "physics/body.hpp"
 #include "physics/degrees_of_freedom.hpp"
+#include "physics/ephemeris.hpp"
 #include "physics/kepler_orbit.hpp"
 #include "physics/massive_body.hpp"
 #include "physics/solar_system.hpp"
+#include "quantities/astronomy.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
+#include "testing_utilities/matchers.hpp"  // 🧙 For EXPECT_OK.
 #include "testing_utilities/numerics.hpp"
 
 namespace principia {
@@ -31,11 +37,16 @@ using ::testing::UnorderedElementsAreArray;
 using namespace principia::astronomy::_epoch;
 using namespace principia::astronomy::_frames;
 using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_instant;
+using namespace principia::integrators::_methods;
+using namespace principia::integrators::_symmetric_linear_multistep_integrator;
 using namespace principia::physics::_body;
 using namespace principia::physics::_degrees_of_freedom;
+using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_kepler_orbit;
 using namespace principia::physics::_massive_body;
 using namespace principia::physics::_solar_system;
+using namespace principia::quantities::_astronomy;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
@@ -577,5 +588,45 @@ TEST_F(SolarSystemFactoryTest, HierarchyAtСпутник2Launch) {
                          "charon");
 }
 
+TEST_F(SolarSystemFactoryTest, CachedEphemeris) {
+  auto const solar_system = SolarSystemFactory::AtСпутник1Launch(
+      SolarSystemFactory::Accuracy::MajorBodiesOnly);
+  Ephemeris<ICRS>::AccuracyParameters const accuracy_parameters(
+      /*fitting_tolerance=*/1 * Milli(Metre),
+      /*geopotential_tolerance=*/0x1p-24);
+  Ephemeris<ICRS>::FixedStepParameters const fixed_step_parameters(
+      SymmetricLinearMultistepIntegrator<
+          QuinlanTremaine1990Order12,
+          Ephemeris<ICRS>::NewtonianMotionEquation>(),
+      /*step=*/10 * Minute);
+  Instant const t_min = solar_system->epoch();
+  Instant const t_max = t_min + 1 * JulianYear;
+
+  auto const ephemeris = solar_system->MakeEphemeris(accuracy_parameters,
+                                                     fixed_step_parameters);
+  EXPECT_OK(ephemeris->Prolong(t_max));
+  // The first call may integrate or read a file written by an earlier run, the
+  // second call reads the file.
+  SolarSystemFactory::MakeCachedEphemeris(
+      *solar_system, accuracy_parameters, fixed_step_parameters, t_max);
+  auto const cached_ephemeris = SolarSystemFactory::MakeCachedEphemeris(
+      *solar_system, accuracy_parameters, fixed_step_parameters, t_max);
+
+  EXPECT_EQ(ephemeris->t_min(), cached_ephemeris->t_min());
+  EXPECT_EQ(ephemeris->t_max(), cached_ephemeris->t_max());
+  ASSERT_EQ(ephemeris->bodies().size(), cached_ephemeris->bodies().size());
+  for (int i = 0; i < ephemeris->bodies().size(); ++i) {
+    EXPECT_EQ(ephemeris->bodies()[i]->name(),
+              cached_ephemeris->bodies()[i]->name());
+    auto const trajectory = ephemeris->trajectory(ephemeris->bodies()[i]);
+    auto const cached_trajectory =
+        cached_ephemeris->trajectory(cached_ephemeris->bodies()[i]);
+    for (Instant t = t_min; t <= t_max; t += (t_max - t_min) / 10) {
+      EXPECT_EQ(trajectory->EvaluateDegreesOfFreedom(t),
+                cached_trajectory->EvaluateDegreesOfFreedom(t));
+    }
+  }
+}
+
 }  // namespace testing_utilities
 }  // namespace principia
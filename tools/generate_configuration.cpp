@@ -1,14 +1,19 @@
 #include "tools/generate_configuration.hpp"
 
 #include <filesystem>
+#include <future>
 #include <iomanip>
 #include <limits>
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "astronomy/epoch.hpp"
 #include "astronomy/frames.hpp"
 #include "base/fingerprint2011.hpp"
 #include "base/serialization.hpp"
+#include "base/thread_pool.hpp"
 #include "glog/logging.h"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/solar_system.hpp"
@@ -29,6 +34,7 @@ using namespace principia::astronomy::_epoch;
 using namespace principia::astronomy::_frames;
 using namespace principia::base::_fingerprint2011;
 using namespace principia::base::_serialization;
+using namespace principia::base::_thread_pool;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_solar_system;
 using namespace principia::quantities::_constants;
@@ -58,127 +64,102 @@ std::string NormalizeLength(std::string const& s) {
   }
 }
 
-void GenerateConfiguration(std::string const& game_epoch,
-                           std::string const& gravity_model_stem,
-                           std::string const& initial_state_stem,
-                           std::string const& numerics_blueprint_stem,
-                           std::string const& needs) {
-  std::filesystem::path const directory =
-      SOLUTION_DIR / "astronomy";
-  SolarSystem<ICRS> solar_system(
-      (directory / gravity_model_stem).replace_extension(proto_txt),
-      (directory / initial_state_stem).replace_extension(proto_txt),
-      /*ignore_frame=*/true);
-
-  std::ofstream gravity_model_cfg(
-      (directory / gravity_model_stem).replace_extension(cfg));
-  CHECK(gravity_model_cfg.good());
-  gravity_model_cfg << "principia_gravity_model:NEEDS[" << needs << "] {\n";
+namespace {
 
-  // Find the star.  This is needed to construct Kepler orbits below.
-  std::optional<serialization::GravityModel::Body> star;
-  for (std::string const& name : solar_system.names()) {
-    serialization::GravityModel::Body const& body =
-        solar_system.gravity_model_message(name);
-    if (solar_system.has_keplerian_initial_state_message(name)) {
-      bool const is_star =
-          !solar_system.keplerian_initial_state_message(name).has_parent();
-      if (is_star) {
-        star = body;
-      }
-    }
+// Returns the block of the gravity model configuration for |body|, which is
+// named |configuration_name| in the configuration.
+std::string GravityModelBodyConfiguration(
+    serialization::GravityModel::Body const& body,
+    std::string const& configuration_name) {
+  LOG(INFO) << "Fingerprint " << std::setw(16) << std::hex << std::uppercase
+            << Fingerprint2011(SerializeAsBytes(body).get())
+            << " for " << body.name();
+  std::ostringstream out;
+  out << "  body {\n";
+  out << "    name                    = " << configuration_name << "\n";
+  if (body.has_gravitational_parameter()) {
+    out << "    gravitational_parameter = "
+        << body.gravitational_parameter() << "\n";
+  } else {
+    // If the mass was provided, convert to a gravitational parameter.
+    Mass const mass = ParseQuantity<Mass>(body.mass());
+    GravitationalParameter const gravitational_parameter =
+        GravitationalConstant * mass;
+    out << "    gravitational_parameter = "
+        << std::scientific
+        << std::setprecision(std::numeric_limits<double>::max_digits10)
+        << gravitational_parameter /
+               (Pow<3>(Kilo(Metre)) / Pow<2>(Second))
+        << " km^3/s^2\n";
   }
-
-  for (std::string const& name : solar_system.names()) {
-    serialization::GravityModel::Body const& body =
-        solar_system.gravity_model_message(name);
-    LOG(INFO) << "Fingerprint " << std::setw(16) << std::hex << std::uppercase
-              << Fingerprint2011(SerializeAsBytes(body).get())
-              << " for " << name;
-    gravity_model_cfg << "  body {\n";
-    gravity_model_cfg << "    name                    = "
-                      << (star.has_value() && name == star->name() ? "Sun"
-                                                                   : name)
-                      << "\n";
-    if (body.has_gravitational_parameter()) {
-      gravity_model_cfg << "    gravitational_parameter = "
-                        << body.gravitational_parameter() << "\n";
-    } else {
-      // If the mass was provided, convert to a gravitational parameter.
-      Mass const mass = ParseQuantity<Mass>(body.mass());
-      GravitationalParameter const gravitational_parameter =
-          GravitationalConstant * mass;
-      gravity_model_cfg << "    gravitational_parameter = "
-                        << std::scientific
-                        << std::setprecision(
-                               std::numeric_limits<double>::max_digits10)
-                        << gravitational_parameter /
-                               (Pow<3>(Kilo(Metre)) / Pow<2>(Second))
-                        << " km^3/s^2\n";
-    }
-    if (body.has_reference_instant()) {
-      gravity_model_cfg << "    reference_instant       = "
-                        << body.reference_instant() << "\n";
-    }
-    // The fields min_radius, mean_radius and max_radius come from the game and
-    // are not copied from the proto to the configuration.
-    if (body.has_axis_right_ascension()) {
-      gravity_model_cfg << "    axis_right_ascension    = "
-                        << body.axis_right_ascension() << "\n";
-    }
-    if (body.has_axis_declination()) {
-      gravity_model_cfg << "    axis_declination        = "
-                        << body.axis_declination() << "\n";
-    }
-    if (body.has_reference_angle()) {
-      gravity_model_cfg << "    reference_angle         = "
-                        << body.reference_angle() << "\n";
-    }
-    if (body.has_angular_frequency()) {
-      gravity_model_cfg << "    angular_frequency       = "
-                        << body.angular_frequency() << "\n";
-    }
-    if (body.has_reference_radius()) {
-      gravity_model_cfg << "    reference_radius        = "
-                        << NormalizeLength(body.reference_radius()) << "\n";
-    }
-    switch (body.oblateness_case()) {
-      case serialization::GravityModel::Body::kJ2:
-        gravity_model_cfg << "    j2                      = "
-                          << std::scientific
-                          << std::setprecision(
-                                 std::numeric_limits<double>::max_digits10)
-                          << body.j2() << "\n";
-        break;
-      case serialization::GravityModel::Body::kGeopotential:
-        for (auto const& row : body.geopotential().row()) {
-          gravity_model_cfg << "    geopotential_row {\n"
-                            << "      degree = " << row.degree() << "\n";
-          for (auto const& column : row.column()) {
-            gravity_model_cfg << "      geopotential_column {\n"
-                              << "        order = " << column.order() << "\n"
-                              << std::scientific
-                              << std::setprecision(
-                                     std::numeric_limits<double>::max_digits10);
-            if (column.has_j()) {
-              gravity_model_cfg << "        j     = " << column.j() << "\n";
-            }
-            if (column.has_cos()) {
-              gravity_model_cfg << "        cos   = " << column.cos() << "\n";
-            }
-            gravity_model_cfg << "        sin   = " << column.sin() << "\n"
-                              << "      }\n";
+  if (body.has_reference_instant()) {
+    out << "    reference_instant       = "
+        << body.reference_instant() << "\n";
+  }
+  // The fields min_radius, mean_radius and max_radius come from the game and
+  // are not copied from the proto to the configuration.
+  if (body.has_axis_right_ascension()) {
+    out << "    axis_right_ascension    = "
+        << body.axis_right_ascension() << "\n";
+  }
+  if (body.has_axis_declination()) {
+    out << "    axis_declination        = "
+        << body.axis_declination() << "\n";
+  }
+  if (body.has_reference_angle()) {
+    out << "    reference_angle         = "
+        << body.reference_angle() << "\n";
+  }
+  if (body.has_angular_frequency()) {
+    out << "    angular_frequency       = "
+        << body.angular_frequency() << "\n";
+  }
+  if (body.has_reference_radius()) {
+    out << "    reference_radius        = "
+        << NormalizeLength(body.reference_radius()) << "\n";
+  }
+  switch (body.oblateness_case()) {
+    case serialization::GravityModel::Body::kJ2:
+      out << "    j2                      = "
+          << std::scientific
+          << std::setprecision(std::numeric_limits<double>::max_digits10)
+          << body.j2() << "\n";
+      break;
+    case serialization::GravityModel::Body::kGeopotential:
+      for (auto const& row : body.geopotential().row()) {
+        out << "    geopotential_row {\n"
+            << "      degree = " << row.degree() << "\n";
+        for (auto const& column : row.column()) {
+          out << "      geopotential_column {\n"
+              << "        order = " << column.order() << "\n"
+              << std::scientific
+              << std::setprecision(std::numeric_limits<double>::max_digits10);
+          if (column.has_j()) {
+            out << "        j     = " << column.j() << "\n";
           }
-          gravity_model_cfg << "    }\n";
+          if (column.has_cos()) {
+            out << "        cos   = " << column.cos() << "\n";
+          }
+          out << "        sin   = " << column.sin() << "\n"
+              << "      }\n";
         }
-        break;
-      case serialization::GravityModel::Body::OBLATENESS_NOT_SET:
-        break;
-    }
-    gravity_model_cfg << "  }\n";
+        out << "    }\n";
+      }
+      break;
+    case serialization::GravityModel::Body::OBLATENESS_NOT_SET:
+      break;
   }
-  gravity_model_cfg << "}\n";
+  out << "  }\n";
+  return out.str();
+}
 
+void WriteInitialStateConfiguration(
+    SolarSystem<ICRS> const& solar_system,
+    std::optional<serialization::GravityModel::Body> const& star,
+    std::string const& game_epoch,
+    std::filesystem::path const& directory,
+    std::string const& initial_state_stem,
+    std::string const& needs) {
   std::ofstream initial_state_cfg(
       (directory / initial_state_stem).replace_extension(cfg));
   CHECK(initial_state_cfg.good());
@@ -236,7 +217,12 @@ void GenerateConfiguration(std::string const& game_epoch,
     }
   }
   initial_state_cfg << "}\n";
+}
 
+void WriteNumericsBlueprintConfiguration(
+    std::filesystem::path const& directory,
+    std::string const& numerics_blueprint_stem,
+    std::string const& needs) {
   // Parse the numerics blueprint file here, it doesn't belong in class
   // SolarSystem.
   std::filesystem::path numerics_blueprint_filename =
@@ -309,6 +295,78 @@ void GenerateConfiguration(std::string const& game_epoch,
   numerics_blueprint_cfg << "}\n";
 }
 
+}  // namespace
+
+void GenerateConfiguration(std::string const& game_epoch,
+                           std::string const& gravity_model_stem,
+                           std::string const& initial_state_stem,
+                           std::string const& numerics_blueprint_stem,
+                           std::string const& needs) {
+  std::filesystem::path const directory =
+      SOLUTION_DIR / "astronomy";
+  SolarSystem<ICRS> solar_system(
+      (directory / gravity_model_stem).replace_extension(proto_txt),
+      (directory / initial_state_stem).replace_extension(proto_txt),
+      /*ignore_frame=*/true);
+
+  // Find the star.  This is needed to construct Kepler orbits below.
+  std::optional<serialization::GravityModel::Body> star;
+  for (std::string const& name : solar_system.names()) {
+    serialization::GravityModel::Body const& body =
+        solar_system.gravity_model_message(name);
+    if (solar_system.has_keplerian_initial_state_message(name)) {
+      bool const is_star =
+          !solar_system.keplerian_initial_state_message(name).has_parent();
+      if (is_star) {
+        star = body;
+      }
+    }
+  }
+
+  // The configuration files, as well as the blocks for the bodies in the
+  // gravity model, are produced in parallel.  The blocks are written in order
+  // as soon as they are available.
+  ThreadPool<void> pool(std::thread::hardware_concurrency());
+  std::future<void> const initial_state = pool.Add([&]() {
+    WriteInitialStateConfiguration(solar_system,
+                                   star,
+                                   game_epoch,
+                                   directory,
+                                   initial_state_stem,
+                                   needs);
+  });
+  std::future<void> const numerics_blueprint = pool.Add([&]() {
+    WriteNumericsBlueprintConfiguration(
+        directory, numerics_blueprint_stem, needs);
+  });
+
+  std::vector<std::string> const& names = solar_system.names();
+  std::vector<std::string> body_configurations(names.size());
+  std::vector<std::future<void>> body_configurations_done;
+  for (int i = 0; i < names.size(); ++i) {
+    body_configurations_done.push_back(pool.Add([&, i]() {
+      std::string const& name = names[i];
+      body_configurations[i] = GravityModelBodyConfiguration(
+          solar_system.gravity_model_message(name),
+          star.has_value() && name == star->name() ? "Sun" : name);
+    }));
+  }
+
+  std::ofstream gravity_model_cfg(
+      (directory / gravity_model_stem).replace_extension(cfg));
+  CHECK(gravity_model_cfg.good());
+  gravity_model_cfg << "principia_gravity_model:NEEDS[" << needs << "] {\n";
+
+  for (int i = 0; i < names.size(); ++i) {
+    body_configurations_done[i].wait();
+    gravity_model_cfg << body_configurations[i];
+  }
+  gravity_model_cfg << "}\n";
+
+  initial_state.wait();
+  numerics_blueprint.wait();
+}
+
 }  // namespace internal
 }  // namespace _generate_configuration
 }  // namespace tools
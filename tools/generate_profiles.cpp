@@ -2,6 +2,8 @@
 
 #include <filesystem>
 #include <fstream>
+#include <sstream>
+#include <string>
 
 #include "glog/logging.h"
 #include "google/protobuf/descriptor.h"
@@ -21,6 +23,31 @@ const char warning[] = "// Warning!  This file was generated by running a "
                        "// If you change it, the changes will be lost the next "
                        "time the generator is\n"
                        "// run.  You should change the generator instead.\n\n";
+
+// Writes |contents| to the file at |path| unless that file already has exactly
+// these contents.  Leaving an up-to-date file untouched preserves its
+// timestamp, so that regenerating the profiles (which happens whenever the
+// tools are rebuilt) doesn't cause all the translation units that include the
+// generated code to be recompiled.
+void WriteIfChanged(std::filesystem::path const& path,
+                    std::string const& contents) {
+  {
+    std::ifstream existing(path);
+    if (existing.good()) {
+      std::stringstream existing_contents;
+      existing_contents << existing.rdbuf();
+      if (existing_contents.str() == contents) {
+        LOG(INFO) << path << " is up to date";
+        return;
+      }
+    }
+  }
+  std::ofstream file(path);
+  CHECK(file.good()) << path;
+  file << contents;
+  CHECK(file.good()) << path;
+}
+
 }  // namespace
 
 void GenerateProfiles() {
@@ -33,15 +60,15 @@ void GenerateProfiles() {
   std::filesystem::path const ksp_plugin_adapter =
       SOLUTION_DIR / "ksp_plugin_adapter";
 
-  std::ofstream profiles_generated_h(journal / "profiles.generated.h");
-  CHECK(profiles_generated_h.good());
+  std::ostringstream profiles_generated_h;
   profiles_generated_h << warning;
   for (auto const& cxx_method_type : processor.GetCxxMethodTypes()) {
     profiles_generated_h << cxx_method_type;
   }
+  WriteIfChanged(journal / "profiles.generated.h",
+                 profiles_generated_h.str());
 
-  std::ofstream profiles_generated_cc(journal / "profiles.generated.cc");
-  CHECK(profiles_generated_cc.good());
+  std::ostringstream profiles_generated_cc;
   profiles_generated_cc << warning;
   for (auto const& cxx_interchange_implementation :
            processor.GetCxxInterchangeImplementations()) {
@@ -51,17 +78,18 @@ void GenerateProfiles() {
            processor.GetCxxMethodImplementations()) {
     profiles_generated_cc << cxx_method_implementation;
   }
+  WriteIfChanged(journal / "profiles.generated.cc",
+                 profiles_generated_cc.str());
 
-  std::ofstream player_generated_cc(journal / "player.generated.cc");
-  CHECK(player_generated_cc.good());
+  std::ostringstream player_generated_cc;
   player_generated_cc << warning;
   for (auto const& cxx_play_statement :
            processor.GetCxxPlayStatements()) {
     player_generated_cc << cxx_play_statement;
   }
+  WriteIfChanged(journal / "player.generated.cc", player_generated_cc.str());
 
-  std::ofstream interface_generated_h(ksp_plugin / "interface.generated.h");
-  CHECK(interface_generated_h.good());
+  std::ostringstream interface_generated_h;
   interface_generated_h << warning;
   for (auto const& cxx_interface_type_declaration :
            processor.GetCxxInterchangeTypeDeclarations()) {
@@ -71,10 +99,10 @@ void GenerateProfiles() {
            processor.GetCxxInterfaceMethodDeclarations()) {
     interface_generated_h << cxx_interface_method_declaration;
   }
+  WriteIfChanged(ksp_plugin / "interface.generated.h",
+                 interface_generated_h.str());
 
-  std::ofstream interface_generated_cs(ksp_plugin_adapter /
-                                      "interface.generated.cs");
-  CHECK(interface_generated_cs.good());
+  std::ostringstream interface_generated_cs;
   interface_generated_cs << warning;
   interface_generated_cs << "using System;\n";
   interface_generated_cs << "using System.Runtime.InteropServices;\n\n";
@@ -92,10 +120,10 @@ void GenerateProfiles() {
   interface_generated_cs << "}\n\n";
   interface_generated_cs << "}  // namespace ksp_plugin_adapter\n";
   interface_generated_cs << "}  // namespace principia\n";
+  WriteIfChanged(ksp_plugin_adapter / "interface.generated.cs",
+                 interface_generated_cs.str());
 
-  std::ofstream marshalers_generated_cs(ksp_plugin_adapter /
-                                      "marshalers.generated.cs");
-  CHECK(marshalers_generated_cs.good());
+  std::ostringstream marshalers_generated_cs;
   marshalers_generated_cs << warning;
   marshalers_generated_cs << "using System;\n";
   marshalers_generated_cs << "using System.Runtime.InteropServices;\n\n";
@@ -107,6 +135,8 @@ void GenerateProfiles() {
   }
   marshalers_generated_cs << "}  // namespace ksp_plugin_adapter\n";
   marshalers_generated_cs << "}  // namespace principia\n";
+  WriteIfChanged(ksp_plugin_adapter / "marshalers.generated.cs",
+                 marshalers_generated_cs.str());
 }
 
 }  // namespace internal